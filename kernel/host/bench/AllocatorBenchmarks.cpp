@@ -0,0 +1,94 @@
+#include "Benchmarks.hpp"
+
+#include <Utils/Kdlsym.hpp>
+#include <Utils/MemoryTracker.hpp>
+#include <Utils/ObjectPool.hpp>
+#include <Utils/Arena.hpp>
+
+extern "C"
+{
+    #include <sys/malloc.h>
+};
+
+using namespace Mira::Utils;
+
+enum
+{
+    // Roughly the size of the small rpc/hook objects these allocators are used for
+    AllocatorBenchmarks_ObjectSize = 0x40,
+
+    // Allocations per Arena reset, about what a large getdents request does
+    AllocatorBenchmarks_ArenaBatch = 64,
+};
+
+static ObjectPool s_BenchPool("BenchPool", AllocatorBenchmarks_ObjectSize);
+
+uint64_t Mira::Host::Bench_KernelMallocFree(uint64_t p_Iterations)
+{
+    auto malloc = (void*(*)(unsigned long size, struct malloc_type* type, int flags))kdlsym(malloc);
+    auto free = (void(*)(void* addr, struct malloc_type* type))kdlsym(free);
+    auto M_TEMP = (struct malloc_type*)kdlsym(M_TEMP);
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Data = malloc(AllocatorBenchmarks_ObjectSize, M_TEMP, M_ZERO | M_NOWAIT);
+        DoNotOptimize(l_Data);
+        free(l_Data, M_TEMP);
+    }
+
+    return MiraHost_GetNanoseconds() - s_Start;
+}
+
+uint64_t Mira::Host::Bench_MemoryTrackerAllocateFree(uint64_t p_Iterations)
+{
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Data = MemoryTracker::Allocate(AllocatorBenchmarks_ObjectSize, MemoryTag_Default);
+        DoNotOptimize(l_Data);
+        MemoryTracker::Free(l_Data);
+    }
+
+    return MiraHost_GetNanoseconds() - s_Start;
+}
+
+uint64_t Mira::Host::Bench_ObjectPoolAllocateFree(uint64_t p_Iterations)
+{
+    // Warm the pool so slab growth is not part of the measurement
+    s_BenchPool.Free(s_BenchPool.Allocate());
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Data = s_BenchPool.Allocate();
+        DoNotOptimize(l_Data);
+        s_BenchPool.Free(l_Data);
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    s_BenchPool.Destroy();
+
+    return s_Elapsed;
+}
+
+uint64_t Mira::Host::Bench_ArenaAllocateReset(uint64_t p_Iterations)
+{
+    Arena s_Arena(MemoryTag_Default);
+
+    // One iteration is a single allocation, Reset() is amortized over the batch
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Data = s_Arena.Allocate(AllocatorBenchmarks_ObjectSize);
+        DoNotOptimize(l_Data);
+
+        if ((l_Index % AllocatorBenchmarks_ArenaBatch) == (AllocatorBenchmarks_ArenaBatch - 1))
+            s_Arena.Reset();
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    s_Arena.Destroy();
+
+    return s_Elapsed;
+}
@@ -0,0 +1,31 @@
+/*
+    Bench.h
+
+    Interface between the benchmarks (built like the rest of Mira) and the runner (built against
+    the host libc). Only plain C types cross this boundary, include stdint.h or sys/types.h first.
+*/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Runs the measured region p_Iterations times and returns the elapsed nanoseconds, setup
+// and teardown are left out of the measurement
+typedef uint64_t (*MiraBenchmarkFunction)(uint64_t p_Iterations);
+
+struct MiraBenchmark
+{
+    const char* Name;
+    MiraBenchmarkFunction Run;
+};
+
+extern const struct MiraBenchmark g_MiraBenchmarks[];
+extern const uint32_t g_MiraBenchmarkCount;
+
+// Monotonic clock, implemented by the runner
+uint64_t MiraHost_GetNanoseconds(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,60 @@
+#include "Benchmarks.hpp"
+
+using namespace Mira::Host;
+
+// Names are the keys of the baseline, renaming one drops its history
+extern "C" const struct MiraBenchmark g_MiraBenchmarks[] =
+{
+    { "alloc/kernel_malloc_free", Bench_KernelMallocFree },
+    { "alloc/memory_tracker_allocate_free", Bench_MemoryTrackerAllocateFree },
+    { "alloc/object_pool_allocate_free", Bench_ObjectPoolAllocateFree },
+    { "alloc/arena_allocate_reset", Bench_ArenaAllocateReset },
+
+    { "containers/vector_push_back", Bench_VectorPushBack },
+    { "containers/ring_buffer_put_get", Bench_RingBufferPutGet },
+    { "containers/span_walk", Bench_SpanWalk },
+    { "containers/hash_map_find", Bench_HashMapFind },
+    { "containers/hash_map_insert_remove", Bench_HashMapInsertRemove },
+    { "containers/concurrent_hash_map_find", Bench_ConcurrentHashMapFind },
+    { "containers/linear_scan_find", Bench_LinearScanFind },
+
+    { "hook/hde64_disasm", Bench_Hde64Disasm },
+    { "hook/relocate_near", Bench_HookRelocateNear },
+    { "hook/relocate_far", Bench_HookRelocateFar },
+
+    { "messaging/dispatch_oldest_listener", Bench_MessageManagerDispatchOldest },
+    { "messaging/dispatch_newest_listener", Bench_MessageManagerDispatchNewest },
+    { "messaging/rpc_transport_pack_unpack", Bench_RpcTransportPackUnpack },
+
+    { "substitute/jmpslot_find_linear", Bench_JmpslotFindLinear },
+    { "substitute/jmpslot_find_indexed", Bench_JmpslotFindIndexed },
+    { "substitute/nid_name_to_nids", Bench_NidNameToNids },
+    { "substitute/nid_database_table", Bench_NidDatabaseTable },
+    { "substitute/nid_database_cache", Bench_NidDatabaseCache },
+
+    { "sbl/gpu_va_find_list_walk", Bench_SblGpuVaFindListWalk },
+    { "sbl/gpu_va_find_indexed", Bench_SblGpuVaFindIndexed },
+    { "sbl/gpu_va_index_map_unmap", Bench_SblGpuVaIndexMapUnmap },
+
+    { "process/find_by_name_list_walk", Bench_ProcessFindListWalk },
+    { "process/find_by_name_indexed", Bench_ProcessFindIndexed },
+    { "process/index_fork_exec_exit", Bench_ProcessIndexLifecycle },
+
+    { "vm_map/copy_and_scan", Bench_VmMapCopyAndScan },
+    { "vm_map/collect_containing", Bench_VmMapCollectContaining },
+
+    { "patch/patch_set_apply", Bench_PatchSetApply },
+    { "patch/patch_set_reapply", Bench_PatchSetReapply },
+
+    { "filemanager/get_dents_pack", Bench_FmGetDentsPack },
+    { "filemanager/get_dents_unpack_system", Bench_FmGetDentsUnpackSystem },
+    { "filemanager/get_dents_unpack_arena", Bench_FmGetDentsUnpackArena },
+    { "filemanager/self_plan_parse", Bench_FmSelfPlanParse },
+    { "filemanager/self_copy_whole_file", Bench_FmSelfCopyWholeFile },
+    { "filemanager/self_copy_streamed", Bench_FmSelfCopyStreamed },
+    { "filemanager/path_filter_match", Bench_FmPathFilterMatch },
+
+    { "tools/kdlsym_scan_30mb", Bench_KdlsymScan },
+};
+
+extern "C" const uint32_t g_MiraBenchmarkCount = ARRAYSIZE(g_MiraBenchmarks);
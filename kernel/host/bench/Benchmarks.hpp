@@ -0,0 +1,87 @@
+#pragma once
+#include <Utils/Types.hpp>
+#include "Bench.h"
+
+namespace Mira
+{
+    namespace Host
+    {
+        // Keeps the compiler from discarding a result that is otherwise unused
+        template <typename T>
+        inline void DoNotOptimize(const T& p_Value)
+        {
+            __asm__ __volatile__("" : : "r,m"(p_Value) : "memory");
+        }
+
+        // Cheap deterministic generator so every run measures the same key sequence
+        inline uint64_t NextRandom(uint64_t& p_State)
+        {
+            p_State ^= p_State << 13;
+            p_State ^= p_State >> 7;
+            p_State ^= p_State << 17;
+            return p_State;
+        }
+
+        // AllocatorBenchmarks.cpp
+        uint64_t Bench_KernelMallocFree(uint64_t p_Iterations);
+        uint64_t Bench_MemoryTrackerAllocateFree(uint64_t p_Iterations);
+        uint64_t Bench_ObjectPoolAllocateFree(uint64_t p_Iterations);
+        uint64_t Bench_ArenaAllocateReset(uint64_t p_Iterations);
+
+        // ContainerBenchmarks.cpp
+        uint64_t Bench_VectorPushBack(uint64_t p_Iterations);
+        uint64_t Bench_RingBufferPutGet(uint64_t p_Iterations);
+        uint64_t Bench_SpanWalk(uint64_t p_Iterations);
+        uint64_t Bench_HashMapFind(uint64_t p_Iterations);
+        uint64_t Bench_HashMapInsertRemove(uint64_t p_Iterations);
+        uint64_t Bench_ConcurrentHashMapFind(uint64_t p_Iterations);
+        uint64_t Bench_LinearScanFind(uint64_t p_Iterations);
+
+        // HookBenchmarks.cpp
+        uint64_t Bench_Hde64Disasm(uint64_t p_Iterations);
+        uint64_t Bench_HookRelocateNear(uint64_t p_Iterations);
+        uint64_t Bench_HookRelocateFar(uint64_t p_Iterations);
+
+        // MessagingBenchmarks.cpp
+        uint64_t Bench_MessageManagerDispatchOldest(uint64_t p_Iterations);
+        uint64_t Bench_MessageManagerDispatchNewest(uint64_t p_Iterations);
+        uint64_t Bench_RpcTransportPackUnpack(uint64_t p_Iterations);
+
+        // SubstituteBenchmarks.cpp
+        uint64_t Bench_JmpslotFindLinear(uint64_t p_Iterations);
+        uint64_t Bench_JmpslotFindIndexed(uint64_t p_Iterations);
+        uint64_t Bench_NidNameToNids(uint64_t p_Iterations);
+        uint64_t Bench_NidDatabaseTable(uint64_t p_Iterations);
+        uint64_t Bench_NidDatabaseCache(uint64_t p_Iterations);
+
+        // SblBenchmarks.cpp
+        uint64_t Bench_SblGpuVaFindListWalk(uint64_t p_Iterations);
+        uint64_t Bench_SblGpuVaFindIndexed(uint64_t p_Iterations);
+        uint64_t Bench_SblGpuVaIndexMapUnmap(uint64_t p_Iterations);
+
+        // ProcessBenchmarks.cpp
+        uint64_t Bench_ProcessFindListWalk(uint64_t p_Iterations);
+        uint64_t Bench_ProcessFindIndexed(uint64_t p_Iterations);
+        uint64_t Bench_ProcessIndexLifecycle(uint64_t p_Iterations);
+
+        // VmMapBenchmarks.cpp
+        uint64_t Bench_VmMapCopyAndScan(uint64_t p_Iterations);
+        uint64_t Bench_VmMapCollectContaining(uint64_t p_Iterations);
+
+        // PatchBenchmarks.cpp
+        uint64_t Bench_PatchSetApply(uint64_t p_Iterations);
+        uint64_t Bench_PatchSetReapply(uint64_t p_Iterations);
+
+        // FileManagerBenchmarks.cpp
+        uint64_t Bench_FmGetDentsPack(uint64_t p_Iterations);
+        uint64_t Bench_FmGetDentsUnpackSystem(uint64_t p_Iterations);
+        uint64_t Bench_FmGetDentsUnpackArena(uint64_t p_Iterations);
+        uint64_t Bench_FmSelfPlanParse(uint64_t p_Iterations);
+        uint64_t Bench_FmSelfCopyWholeFile(uint64_t p_Iterations);
+        uint64_t Bench_FmSelfCopyStreamed(uint64_t p_Iterations);
+        uint64_t Bench_FmPathFilterMatch(uint64_t p_Iterations);
+
+        // ToolBenchmarks.cpp
+        uint64_t Bench_KdlsymScan(uint64_t p_Iterations);
+    }
+}
@@ -0,0 +1,217 @@
+#include "Benchmarks.hpp"
+
+#include <Utils/Vector.hpp>
+#include <Utils/RingBuffer.hpp>
+#include <Utils/Span.hpp>
+#include <Utils/HashMap.hpp>
+#include <Utils/ConcurrentHashMap.hpp>
+
+using namespace Mira::Utils;
+
+enum
+{
+    // Elements pushed before a Vector is thrown away
+    ContainerBenchmarks_VectorBatch = 256,
+
+    ContainerBenchmarks_RingBufferSize = 128,
+
+    // Same as MessageManager_MaxListeners, the size most of our lookup tables are today
+    ContainerBenchmarks_KeyCount = 64,
+
+    // Large enough to be a walk rather than a handful of reads
+    ContainerBenchmarks_SpanSize = 0x1000,
+};
+
+struct BenchRecord
+{
+    uint32_t Type;
+    uint32_t Length;
+    uint64_t Value;
+};
+
+struct BenchEntry
+{
+    uint64_t Key;
+    uint64_t Value;
+};
+
+static uint64_t GetBenchKey(uint32_t p_Index)
+{
+    // Spread out like the rpc message types are
+    return (static_cast<uint64_t>(p_Index) * 0x9E3779B97F4A7C15ull) | 1;
+}
+
+uint64_t Mira::Host::Bench_VectorPushBack(uint64_t p_Iterations)
+{
+    uint64_t s_Elapsed = 0;
+    uint64_t s_Remaining = p_Iterations;
+
+    // One iteration is one push_back, a new vector is started every batch so growth is included
+    while (s_Remaining > 0)
+    {
+        auto l_Count = s_Remaining < ContainerBenchmarks_VectorBatch ? s_Remaining : ContainerBenchmarks_VectorBatch;
+
+        auto l_Start = MiraHost_GetNanoseconds();
+        {
+            Vector<uint64_t> l_Vector;
+            for (uint64_t l_Index = 0; l_Index < l_Count; ++l_Index)
+                l_Vector.push_back(l_Index);
+
+            DoNotOptimize(l_Vector.size());
+        }
+        s_Elapsed += MiraHost_GetNanoseconds() - l_Start;
+
+        s_Remaining -= l_Count;
+    }
+
+    return s_Elapsed;
+}
+
+uint64_t Mira::Host::Bench_RingBufferPutGet(uint64_t p_Iterations)
+{
+    ::Utils::RingBuffer<uint64_t> s_Buffer(ContainerBenchmarks_RingBufferSize);
+
+    // Keep it half full so put and get both touch a live slot
+    for (uint32_t l_Index = 0; l_Index < ContainerBenchmarks_RingBufferSize / 2; ++l_Index)
+        s_Buffer.put(l_Index);
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        s_Buffer.put(l_Index);
+        DoNotOptimize(s_Buffer.get());
+    }
+
+    return MiraHost_GetNanoseconds() - s_Start;
+}
+
+uint64_t Mira::Host::Bench_SpanWalk(uint64_t p_Iterations)
+{
+    static uint8_t s_Data[ContainerBenchmarks_SpanSize];
+    for (uint32_t l_Offset = 0; l_Offset + sizeof(BenchRecord) <= sizeof(s_Data); l_Offset += sizeof(BenchRecord))
+    {
+        auto l_Record = reinterpret_cast<BenchRecord*>(s_Data + l_Offset);
+        l_Record->Type = l_Offset;
+        l_Record->Length = sizeof(BenchRecord);
+        l_Record->Value = l_Offset;
+    }
+
+    // One iteration is one record read through get_struct, the walk restarts at the end
+    uint64_t s_Sum = 0;
+    Span<uint8_t> s_Span(s_Data, sizeof(s_Data));
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Record = s_Span.get_struct<BenchRecord>();
+        if (l_Record == nullptr)
+        {
+            s_Span.setOffset(0);
+            l_Record = s_Span.get_struct<BenchRecord>();
+        }
+
+        s_Sum += l_Record->Value;
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_Sum);
+
+    return s_Elapsed;
+}
+
+uint64_t Mira::Host::Bench_HashMapFind(uint64_t p_Iterations)
+{
+    HashMap<uint64_t, uint64_t> s_Map;
+    for (uint32_t l_Index = 0; l_Index < ContainerBenchmarks_KeyCount; ++l_Index)
+        s_Map.Insert(GetBenchKey(l_Index), l_Index);
+
+    uint64_t s_Random = 0x2545F4914F6CDD1Dull;
+    uint64_t s_Sum = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Value = s_Map.Find(GetBenchKey(NextRandom(s_Random) % ContainerBenchmarks_KeyCount));
+        if (l_Value != nullptr)
+            s_Sum += *l_Value;
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_Sum);
+
+    return s_Elapsed;
+}
+
+uint64_t Mira::Host::Bench_HashMapInsertRemove(uint64_t p_Iterations)
+{
+    HashMap<uint64_t, uint64_t> s_Map;
+    for (uint32_t l_Index = 0; l_Index < ContainerBenchmarks_KeyCount; ++l_Index)
+        s_Map.Insert(GetBenchKey(l_Index), l_Index);
+
+    // Keys past the preloaded set, so every insert is a new entry and every remove shifts
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Key = GetBenchKey(ContainerBenchmarks_KeyCount + static_cast<uint32_t>(l_Index & 0xFF));
+        s_Map.Insert(l_Key, l_Index);
+        s_Map.Remove(l_Key);
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_Map.Size());
+
+    return s_Elapsed;
+}
+
+uint64_t Mira::Host::Bench_ConcurrentHashMapFind(uint64_t p_Iterations)
+{
+    ConcurrentHashMap<uint64_t, uint64_t> s_Map("BenchMap");
+    for (uint32_t l_Index = 0; l_Index < ContainerBenchmarks_KeyCount; ++l_Index)
+        s_Map.Insert(GetBenchKey(l_Index), l_Index);
+
+    uint64_t s_Random = 0x2545F4914F6CDD1Dull;
+    uint64_t s_Sum = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        uint64_t l_Value = 0;
+        if (s_Map.Find(GetBenchKey(NextRandom(s_Random) % ContainerBenchmarks_KeyCount), l_Value))
+            s_Sum += l_Value;
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_Sum);
+
+    return s_Elapsed;
+}
+
+uint64_t Mira::Host::Bench_LinearScanFind(uint64_t p_Iterations)
+{
+    // The fixed array scan used by MessageManager and the plugin tables, as a reference point
+    BenchEntry s_Entries[ContainerBenchmarks_KeyCount];
+    for (uint32_t l_Index = 0; l_Index < ContainerBenchmarks_KeyCount; ++l_Index)
+        s_Entries[l_Index] = { GetBenchKey(l_Index), l_Index };
+
+    uint64_t s_Random = 0x2545F4914F6CDD1Dull;
+    uint64_t s_Sum = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Key = GetBenchKey(NextRandom(s_Random) % ContainerBenchmarks_KeyCount);
+        for (uint32_t l_EntryIndex = 0; l_EntryIndex < ContainerBenchmarks_KeyCount; ++l_EntryIndex)
+        {
+            if (s_Entries[l_EntryIndex].Key != l_Key)
+                continue;
+
+            s_Sum += s_Entries[l_EntryIndex].Value;
+            break;
+        }
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_Sum);
+
+    return s_Elapsed;
+}
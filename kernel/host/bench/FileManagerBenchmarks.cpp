@@ -0,0 +1,300 @@
+#include "Benchmarks.hpp"
+#include "../shim/SelfFixture.hpp"
+
+#include <Utils/Arena.hpp>
+#include <Utils/Kernel.hpp>
+#include <Utils/New.hpp>
+
+#include <Plugins/FileManager/SelfDecryptPlan.hpp>
+#include <Plugins/FileManager/PathFilter.hpp>
+#include <Plugins/FileManager/FileManagerSelf.hpp>
+
+#include <sys/param.h>
+#include <sys/elf64.h>
+
+extern "C"
+{
+    #include <Plugins/FileManager/filemanager.pb-c.h>
+};
+
+enum
+{
+    // A typical /system/common/lib listing
+    FileManagerBenchmarks_DentCount = 64,
+
+    FileManagerBenchmarks_NameSize = 32,
+
+    FileManagerBenchmarks_PackedSize = 0x2000,
+};
+
+using namespace Mira::Host;
+using namespace Mira::Plugins::FileManagerExtent;
+
+struct BenchDents
+{
+    char Names[FileManagerBenchmarks_DentCount][FileManagerBenchmarks_NameSize];
+    FmDent Dents[FileManagerBenchmarks_DentCount];
+    FmDent* DentList[FileManagerBenchmarks_DentCount];
+    FmGetDentsResponse Response;
+
+    uint8_t Packed[FileManagerBenchmarks_PackedSize];
+    size_t PackedSize;
+};
+
+static void InitializeBenchDents(BenchDents& p_Dents)
+{
+    static const char s_Prefix[] = "libSceModule";
+
+    for (uint32_t l_Index = 0; l_Index < FileManagerBenchmarks_DentCount; ++l_Index)
+    {
+        auto l_Name = p_Dents.Names[l_Index];
+        memset(l_Name, 0, FileManagerBenchmarks_NameSize);
+        memcpy(l_Name, s_Prefix, sizeof(s_Prefix) - 1);
+
+        // libSceModuleXX.sprx
+        auto l_Suffix = l_Name + sizeof(s_Prefix) - 1;
+        l_Suffix[0] = static_cast<char>('A' + (l_Index / 26) % 26);
+        l_Suffix[1] = static_cast<char>('A' + l_Index % 26);
+        memcpy(l_Suffix + 2, ".sprx", 5);
+
+        auto& l_Dent = p_Dents.Dents[l_Index];
+        l_Dent = FM_DENT__INIT;
+        l_Dent.fileno = 0x1000 + l_Index;
+        l_Dent.reclen = 0x20;
+        l_Dent.type = 8;
+        l_Dent.name = l_Name;
+
+        p_Dents.DentList[l_Index] = &l_Dent;
+    }
+
+    p_Dents.Response = FM_GET_DENTS_RESPONSE__INIT;
+    p_Dents.Response.n_dents = FileManagerBenchmarks_DentCount;
+    p_Dents.Response.dents = p_Dents.DentList;
+
+    p_Dents.PackedSize = fm_get_dents_response__pack(&p_Dents.Response, p_Dents.Packed);
+}
+
+uint64_t Mira::Host::Bench_FmGetDentsPack(uint64_t p_Iterations)
+{
+    static BenchDents s_Dents;
+    InitializeBenchDents(s_Dents);
+
+    // Matches FileManager::OnGetDents, the size is computed before packing into a buffer
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Size = fm_get_dents_response__get_packed_size(&s_Dents.Response);
+        if (l_Size > sizeof(s_Dents.Packed))
+            break;
+
+        DoNotOptimize(fm_get_dents_response__pack(&s_Dents.Response, s_Dents.Packed));
+    }
+
+    return MiraHost_GetNanoseconds() - s_Start;
+}
+
+uint64_t Mira::Host::Bench_FmGetDentsUnpackSystem(uint64_t p_Iterations)
+{
+    static BenchDents s_Dents;
+    InitializeBenchDents(s_Dents);
+
+    // Every field is a separate malloc/free through the default protobuf-c allocator
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Response = fm_get_dents_response__unpack(nullptr, s_Dents.PackedSize, s_Dents.Packed);
+        DoNotOptimize(l_Response);
+
+        if (l_Response != nullptr)
+            fm_get_dents_response__free_unpacked(l_Response, nullptr);
+    }
+
+    return MiraHost_GetNanoseconds() - s_Start;
+}
+
+uint64_t Mira::Host::Bench_FmGetDentsUnpackArena(uint64_t p_Iterations)
+{
+    static BenchDents s_Dents;
+    InitializeBenchDents(s_Dents);
+
+    Mira::Utils::Arena s_Arena(Mira::Utils::MemoryTag_FileManager);
+
+    // What a connection does per request since the arena was introduced
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Response = fm_get_dents_response__unpack(s_Arena.GetProtobufAllocator(), s_Dents.PackedSize, s_Dents.Packed);
+        DoNotOptimize(l_Response);
+
+        s_Arena.Reset();
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    s_Arena.Destroy();
+
+    return s_Elapsed;
+}
+
+struct BenchSelf : SelfFixture
+{
+    // Stands in for the packed rpc response every chunk is copied into
+    uint8_t Packet[SelfDecryptPlan_WindowSize];
+};
+
+static void SendBenchSelfChunk(BenchSelf& p_Self, const uint8_t* p_Data, uint64_t p_Size)
+{
+    memcpy(p_Self.Packet, p_Data, p_Size);
+    DoNotOptimize(p_Self.Packet[0]);
+}
+
+static bool OnBenchSelfChunk(void* p_Context, uint64_t p_Offset, const uint8_t* p_Data, uint32_t p_Size, uint64_t p_ElfSize)
+{
+    SendBenchSelfChunk(*static_cast<BenchSelf*>(p_Context), p_Data, p_Size);
+    return true;
+}
+
+uint64_t Mira::Host::Bench_FmSelfPlanParse(uint64_t p_Iterations)
+{
+    static BenchSelf s_Self;
+    InitializeSelfFixture(s_Self);
+
+    uint8_t s_Header[SelfFixture_HeaderSize];
+    SelfDecryptPlan s_Plan;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        // Parse clears the section headers in place, start from the file every time
+        memcpy(s_Header, s_Self.File, sizeof(s_Header));
+        DoNotOptimize(s_Plan.Parse(s_Header, sizeof(s_Header), SelfFixture_FileSize));
+    }
+
+    return MiraHost_GetNanoseconds() - s_Start;
+}
+
+// Copy overhead and peak memory of what FileManager::DecryptSelfFd did before streaming: read the whole file,
+// build the whole ELF byte by byte, then send it. The decrypted bytes are already in memory, the per-segment
+// MAP_SELF mapping both versions pay is not modelled, so this does not time decryption
+uint64_t Mira::Host::Bench_FmSelfCopyWholeFile(uint64_t p_Iterations)
+{
+    static BenchSelf s_Self;
+    InitializeSelfFixture(s_Self);
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_SelfData = new (Mira::Utils::MemoryTag_FileManager) uint8_t[SelfFixture_FileSize];
+        if (l_SelfData == nullptr)
+            break;
+
+        memcpy(l_SelfData, s_Self.File, SelfFixture_FileSize);
+
+        auto l_Ehdr = reinterpret_cast<Elf64_Ehdr*>(l_SelfData + SelfFixture_ElfOffset);
+        auto l_Phdr = reinterpret_cast<Elf64_Phdr*>(reinterpret_cast<uint8_t*>(l_Ehdr) + l_Ehdr->e_phoff);
+        l_Ehdr->e_shoff = 0;
+        l_Ehdr->e_shnum = 0;
+
+        uint64_t l_ElfSize = l_Ehdr->e_phoff + l_Ehdr->e_phnum * l_Ehdr->e_phentsize;
+        for (auto i = 0; i < l_Ehdr->e_phnum; ++i)
+        {
+            if (l_Phdr[i].p_type == PT_LOAD || l_Phdr[i].p_type == PT_SCE_DYNLIBDATA || l_Phdr[i].p_type == PT_DYNAMIC)
+                l_ElfSize = MAX(l_ElfSize, l_Phdr[i].p_offset + l_Phdr[i].p_filesz);
+        }
+
+        auto l_ElfData = new (Mira::Utils::MemoryTag_FileManager) uint8_t[l_ElfSize];
+        if (l_ElfData == nullptr)
+        {
+            delete [] l_SelfData;
+            break;
+        }
+        memset(l_ElfData, 0, l_ElfSize);
+
+        for (uint64_t i = 0; i < l_Ehdr->e_phoff + l_Ehdr->e_phnum * l_Ehdr->e_phentsize; ++i)
+            l_ElfData[i] = reinterpret_cast<uint8_t*>(l_Ehdr)[i];
+
+        for (auto l_PhIndex = 0; l_PhIndex < l_Ehdr->e_phnum; ++l_PhIndex)
+        {
+            if (l_Phdr[l_PhIndex].p_type != PT_LOAD && l_Phdr[l_PhIndex].p_type != PT_SCE_DYNLIBDATA)
+                continue;
+
+            for (uint64_t l_FileIndex = 0; l_FileIndex < l_Phdr[l_PhIndex].p_filesz; ++l_FileIndex)
+                l_ElfData[l_Phdr[l_PhIndex].p_offset + l_FileIndex] = s_Self.Decrypted[l_Phdr[l_PhIndex].p_offset + l_FileIndex];
+        }
+
+        for (uint64_t l_Offset = 0; l_Offset < l_ElfSize; l_Offset += SelfDecryptPlan_WindowSize)
+            SendBenchSelfChunk(s_Self, l_ElfData + l_Offset, MIN(static_cast<uint64_t>(SelfDecryptPlan_WindowSize), l_ElfSize - l_Offset));
+
+        delete [] l_ElfData;
+        delete [] l_SelfData;
+    }
+
+    return MiraHost_GetNanoseconds() - s_Start;
+}
+
+// The same for FileManager::DecryptSelfStream: read the headers, then hand out each segment a window at a time.
+// Only the header and one window are held at once instead of the whole SELF and ELF
+uint64_t Mira::Host::Bench_FmSelfCopyStreamed(uint64_t p_Iterations)
+{
+    static BenchSelf s_Self;
+    InitializeSelfFixture(s_Self);
+
+    SelfDecryptPlan s_Plan;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Header = new (Mira::Utils::MemoryTag_FileManager) uint8_t[SelfDecryptPlan_InitialHeaderSize];
+        if (l_Header == nullptr)
+            break;
+
+        memcpy(l_Header, s_Self.File, SelfDecryptPlan_InitialHeaderSize);
+        if (s_Plan.Parse(l_Header, SelfDecryptPlan_InitialHeaderSize, SelfFixture_FileSize) != SelfDecryptPlan::Status::Ok)
+        {
+            delete [] l_Header;
+            break;
+        }
+
+        OnBenchSelfChunk(&s_Self, 0, l_Header + s_Plan.GetElfOffset(), static_cast<uint32_t>(s_Plan.GetHeaderSize()), s_Plan.GetElfSize());
+        delete [] l_Header;
+
+        for (uint32_t l_SegmentIndex = 0; l_SegmentIndex < s_Plan.GetSegmentCount(); ++l_SegmentIndex)
+        {
+            auto l_Segment = s_Plan.GetSegment(l_SegmentIndex);
+            auto l_Mapping = s_Self.Decrypted + l_Segment->Offset;
+
+            for (uint64_t l_Offset = 0; l_Offset < l_Segment->Size; l_Offset += SelfDecryptPlan_WindowSize)
+                OnBenchSelfChunk(&s_Self, l_Segment->Offset + l_Offset, l_Mapping + l_Offset, static_cast<uint32_t>(MIN(static_cast<uint64_t>(SelfDecryptPlan_WindowSize), l_Segment->Size - l_Offset)), s_Plan.GetElfSize());
+        }
+    }
+
+    return MiraHost_GetNanoseconds() - s_Start;
+}
+
+// Every directory entry of a batch decrypt goes through the filter, most of them do not match
+uint64_t Mira::Host::Bench_FmPathFilterMatch(uint64_t p_Iterations)
+{
+    static const char* s_Names[] =
+    {
+        "eboot.bin",
+        "libSceFios2.sprx",
+        "param.sfo",
+        "icon0.png",
+        "right.sprx",
+        "trophy00.trp",
+        "libc.prx",
+        "data_00012.pak",
+    };
+
+    static const char s_Filter[] = "eboot.bin|*.sprx|*.prx|*.self";
+
+    uint64_t s_Matches = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+        s_Matches += PathFilter::Matches(s_Filter, s_Names[l_Index % ARRAYSIZE(s_Names)]) ? 1 : 0;
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_Matches);
+
+    return s_Elapsed;
+}
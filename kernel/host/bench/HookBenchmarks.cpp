@@ -0,0 +1,108 @@
+#include "Benchmarks.hpp"
+
+#include <Utils/HookRelocator.hpp>
+
+extern "C"
+{
+    #include <hde64/hde64.h>
+};
+
+using namespace Mira::Host;
+
+enum
+{
+    HookBenchmarks_PrologueSize = 32,
+
+    // Same as HOOK_LENGTH, the size of the absolute jmp that gets written over the target
+    HookBenchmarks_HookLength = 14,
+
+    HookBenchmarks_TrampolineSize = 64,
+};
+
+// Function prologues in the shapes the kernel and shellcore targets start with
+static const uint8_t s_Prologues[][HookBenchmarks_PrologueSize] =
+{
+    // push rbp; mov rbp, rsp; push r15; push r14; push r13; push r12; push rbx; sub rsp, 0x28
+    { 0x55, 0x48, 0x89, 0xE5, 0x41, 0x57, 0x41, 0x56, 0x41, 0x55, 0x41, 0x54, 0x53, 0x48, 0x83, 0xEC, 0x28, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC },
+
+    // push rbp; mov rbp, rsp; sub rsp, 0x1A0; mov rax, [rip+0x12345678]
+    { 0x55, 0x48, 0x89, 0xE5, 0x48, 0x81, 0xEC, 0xA0, 0x01, 0x00, 0x00, 0x48, 0x8B, 0x05, 0x78, 0x56, 0x34, 0x12, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC },
+
+    // mov eax, [rdi+0x10]; test eax, eax; je +0x20; lea rcx, [rip+0x1000]; ...
+    { 0x8B, 0x47, 0x10, 0x85, 0xC0, 0x74, 0x20, 0x48, 0x8D, 0x0D, 0x00, 0x10, 0x00, 0x00, 0x48, 0x89, 0xC8, 0xC3, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC },
+
+    // movabs rax, imm64; jmp rax
+    { 0x48, 0xB8, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0xFF, 0xE0, 0x90, 0x90, 0x90, 0x90, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC },
+};
+
+uint64_t Mira::Host::Bench_Hde64Disasm(uint64_t p_Iterations)
+{
+    uint64_t s_TotalLength = 0;
+
+    // One iteration sizes one hook, decoding until the jmp fits like Hook does
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Prologue = s_Prologues[l_Index % ARRAYSIZE(s_Prologues)];
+
+        uint32_t l_Length = 0;
+        while (l_Length < HookBenchmarks_HookLength)
+        {
+            hde64s l_Instruction;
+            auto l_InstructionLength = hde64_disasm(l_Prologue + l_Length, &l_Instruction);
+            if (l_InstructionLength == 0 || (l_Instruction.flags & F_ERROR))
+                break;
+
+            l_Length += l_InstructionLength;
+        }
+
+        s_TotalLength += l_Length;
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_TotalLength);
+
+    return s_Elapsed;
+}
+
+// Builds one trampoline per iteration the way Hook::CreateTrampoline does
+static uint64_t BenchRelocate(uint64_t p_Iterations, uint64_t p_Distance)
+{
+    uint8_t s_Trampoline[HookBenchmarks_TrampolineSize];
+    uint64_t s_TotalSize = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Prologue = s_Prologues[l_Index % ARRAYSIZE(s_Prologues)];
+        auto l_Address = reinterpret_cast<uint64_t>(l_Prologue);
+
+        auto l_Length = Mira::Utils::HookRelocator::GetMinimumLength(l_Prologue, HookBenchmarks_HookLength);
+        if (l_Length < 0)
+            continue;
+
+        auto l_MaximumSize = Mira::Utils::HookRelocator::GetMaximumSize(l_Prologue, l_Address, l_Length);
+        if (l_MaximumSize < 0 || l_MaximumSize > HookBenchmarks_TrampolineSize)
+            continue;
+
+        s_TotalSize += Mira::Utils::HookRelocator::Relocate(l_Prologue, l_Address, l_Length, s_Trampoline, l_Address + p_Distance, sizeof(s_Trampoline));
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_TotalSize);
+    DoNotOptimize(s_Trampoline);
+
+    return s_Elapsed;
+}
+
+// Trampoline within rel32 reach of the target, branches and rip operands keep their encoding
+uint64_t Mira::Host::Bench_HookRelocateNear(uint64_t p_Iterations)
+{
+    return BenchRelocate(p_Iterations, 0x1000);
+}
+
+// Trampoline out of rel32 reach, everything is rewritten to absolute forms
+uint64_t Mira::Host::Bench_HookRelocateFar(uint64_t p_Iterations)
+{
+    return BenchRelocate(p_Iterations, 0x100000000ull);
+}
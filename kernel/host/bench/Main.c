@@ -0,0 +1,155 @@
+/*
+    Main.c
+
+    Benchmark runner, built against the host libc. Each benchmark is calibrated until one run
+    takes at least the minimum time, then measured MIRA_BENCH_REPETITIONS times. The fastest run
+    is reported, noise on a shared CI machine only ever makes a run slower.
+
+    Usage: MiraBench [-f filter] [-o results.json] [-t min_time_ms] [-l]
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Bench.h"
+
+#define MIRA_BENCH_REPETITIONS 7
+#define MIRA_BENCH_MAX_ITERATIONS (1ull << 34)
+
+struct MiraBenchResult
+{
+    const char* Name;
+    uint64_t Iterations;
+    double NanosecondsPerOp;
+};
+
+uint64_t MiraHost_GetNanoseconds(void)
+{
+    struct timespec s_Time;
+    clock_gettime(CLOCK_MONOTONIC, &s_Time);
+
+    return (uint64_t)s_Time.tv_sec * 1000000000ull + (uint64_t)s_Time.tv_nsec;
+}
+
+static struct MiraBenchResult RunBenchmark(const struct MiraBenchmark* p_Benchmark, uint64_t p_MinimumNanoseconds)
+{
+    struct MiraBenchResult s_Result = { p_Benchmark->Name, 1, 0.0 };
+
+    // Grow the iteration count until a single run is long enough to time reliably
+    uint64_t s_Elapsed = p_Benchmark->Run(s_Result.Iterations);
+    while (s_Elapsed < p_MinimumNanoseconds && s_Result.Iterations < MIRA_BENCH_MAX_ITERATIONS)
+    {
+        uint64_t s_Scale = s_Elapsed == 0 ? 100 : (p_MinimumNanoseconds * 12 / 10) / s_Elapsed + 1;
+        if (s_Scale > 100)
+            s_Scale = 100;
+        if (s_Scale < 2)
+            s_Scale = 2;
+
+        s_Result.Iterations *= s_Scale;
+        s_Elapsed = p_Benchmark->Run(s_Result.Iterations);
+    }
+
+    uint64_t s_Fastest = UINT64_MAX;
+    for (int l_Index = 0; l_Index < MIRA_BENCH_REPETITIONS; ++l_Index)
+    {
+        uint64_t l_Elapsed = p_Benchmark->Run(s_Result.Iterations);
+        if (l_Elapsed < s_Fastest)
+            s_Fastest = l_Elapsed;
+    }
+
+    s_Result.NanosecondsPerOp = (double)s_Fastest / (double)s_Result.Iterations;
+
+    return s_Result;
+}
+
+static int WriteResults(const char* p_Path, const struct MiraBenchResult* p_Results, uint32_t p_Count)
+{
+    FILE* s_File = fopen(p_Path, "w");
+    if (s_File == NULL)
+    {
+        fprintf(stderr, "could not open (%s) for writing\n", p_Path);
+        return -1;
+    }
+
+    fprintf(s_File, "{\n  \"benchmarks\": [\n");
+    for (uint32_t l_Index = 0; l_Index < p_Count; ++l_Index)
+    {
+        fprintf(s_File, "    { \"name\": \"%s\", \"ns_per_op\": %.3f, \"iterations\": %llu }%s\n",
+            p_Results[l_Index].Name,
+            p_Results[l_Index].NanosecondsPerOp,
+            (unsigned long long)p_Results[l_Index].Iterations,
+            (l_Index + 1 < p_Count) ? "," : "");
+    }
+    fprintf(s_File, "  ]\n}\n");
+
+    fclose(s_File);
+    return 0;
+}
+
+int main(int p_ArgumentCount, char** p_Arguments)
+{
+    const char* s_Filter = NULL;
+    const char* s_OutputPath = NULL;
+    uint64_t s_MinimumMilliseconds = 100;
+    int s_ListOnly = 0;
+
+    int s_Option;
+    while ((s_Option = getopt(p_ArgumentCount, p_Arguments, "f:o:t:l")) != -1)
+    {
+        switch (s_Option)
+        {
+        case 'f':
+            s_Filter = optarg;
+            break;
+        case 'o':
+            s_OutputPath = optarg;
+            break;
+        case 't':
+            s_MinimumMilliseconds = strtoull(optarg, NULL, 0);
+            break;
+        case 'l':
+            s_ListOnly = 1;
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-f filter] [-o results.json] [-t min_time_ms] [-l]\n", p_Arguments[0]);
+            return 2;
+        }
+    }
+
+    struct MiraBenchResult* s_Results = calloc(g_MiraBenchmarkCount, sizeof(*s_Results));
+    if (s_Results == NULL)
+        return 1;
+
+    uint32_t s_ResultCount = 0;
+    for (uint32_t l_Index = 0; l_Index < g_MiraBenchmarkCount; ++l_Index)
+    {
+        const struct MiraBenchmark* l_Benchmark = &g_MiraBenchmarks[l_Index];
+        if (s_Filter != NULL && strstr(l_Benchmark->Name, s_Filter) == NULL)
+            continue;
+
+        if (s_ListOnly)
+        {
+            printf("%s\n", l_Benchmark->Name);
+            continue;
+        }
+
+        s_Results[s_ResultCount] = RunBenchmark(l_Benchmark, s_MinimumMilliseconds * 1000000ull);
+        printf("%-48s %12.2f ns/op %14llu iterations\n",
+            s_Results[s_ResultCount].Name,
+            s_Results[s_ResultCount].NanosecondsPerOp,
+            (unsigned long long)s_Results[s_ResultCount].Iterations);
+        fflush(stdout);
+
+        s_ResultCount++;
+    }
+
+    int s_Ret = 0;
+    if (s_OutputPath != NULL && !s_ListOnly)
+        s_Ret = WriteResults(s_OutputPath, s_Results, s_ResultCount) == 0 ? 0 : 1;
+
+    free(s_Results);
+    return s_Ret;
+}
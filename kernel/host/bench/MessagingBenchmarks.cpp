@@ -0,0 +1,123 @@
+#include "Benchmarks.hpp"
+
+#include <Messaging/MessageManager.hpp>
+#include <Utils/Arena.hpp>
+
+extern "C"
+{
+    #include <Messaging/Rpc/rpc.pb-c.h>
+};
+
+using namespace Mira::Messaging;
+using namespace Mira::Host;
+
+enum
+{
+    // About what is registered once every plugin is loaded
+    MessagingBenchmarks_ListenerCount = 48,
+
+    MessagingBenchmarks_PayloadSize = 0x100,
+};
+
+static uint64_t s_DispatchCount;
+
+static void OnBenchRequest(Rpc::Connection* p_Connection, const RpcTransport* p_Message)
+{
+    s_DispatchCount++;
+}
+
+static RpcCategory GetBenchCategory(uint32_t p_Index)
+{
+    return static_cast<RpcCategory>(RPC_CATEGORY__SYSTEM + (p_Index % (RPC_CATEGORY__MAX - RPC_CATEGORY__SYSTEM)));
+}
+
+static int32_t GetBenchType(uint32_t p_Index)
+{
+    return static_cast<int32_t>(0x10000 + p_Index);
+}
+
+static uint64_t BenchDispatch(uint64_t p_Iterations, uint32_t p_ListenerIndex)
+{
+    auto s_Manager = new MessageManager();
+    if (s_Manager == nullptr)
+        return 0;
+
+    for (uint32_t l_Index = 0; l_Index < MessagingBenchmarks_ListenerCount; ++l_Index)
+        s_Manager->RegisterCallback(GetBenchCategory(l_Index), GetBenchType(l_Index), OnBenchRequest);
+
+    RpcHeader s_Header = RPC_HEADER__INIT;
+    s_Header.category = GetBenchCategory(p_ListenerIndex);
+    s_Header.type = GetBenchType(p_ListenerIndex);
+    s_Header.isrequest = true;
+    s_Header.magic = 2;
+
+    RpcTransport s_Message = RPC_TRANSPORT__INIT;
+    s_Message.header = &s_Header;
+
+    // OnRequest only hands the connection to the callback
+    uint64_t s_Placeholder = 0;
+    auto s_Connection = reinterpret_cast<Rpc::Connection*>(&s_Placeholder);
+
+    s_DispatchCount = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+        s_Manager->OnRequest(s_Connection, &s_Message);
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_DispatchCount);
+
+    delete s_Manager;
+
+    return s_Elapsed;
+}
+
+// RegisterCallback fills slots from the back, so the oldest listener is the last one scanned
+uint64_t Mira::Host::Bench_MessageManagerDispatchOldest(uint64_t p_Iterations)
+{
+    return BenchDispatch(p_Iterations, 0);
+}
+
+uint64_t Mira::Host::Bench_MessageManagerDispatchNewest(uint64_t p_Iterations)
+{
+    return BenchDispatch(p_Iterations, MessagingBenchmarks_ListenerCount - 1);
+}
+
+uint64_t Mira::Host::Bench_RpcTransportPackUnpack(uint64_t p_Iterations)
+{
+    uint8_t s_Payload[MessagingBenchmarks_PayloadSize];
+    for (uint32_t l_Index = 0; l_Index < sizeof(s_Payload); ++l_Index)
+        s_Payload[l_Index] = static_cast<uint8_t>(l_Index);
+
+    RpcHeader s_Header = RPC_HEADER__INIT;
+    s_Header.category = RPC_CATEGORY__FILE;
+    s_Header.type = GetBenchType(0);
+    s_Header.isrequest = true;
+    s_Header.magic = 2;
+
+    RpcTransport s_Message = RPC_TRANSPORT__INIT;
+    s_Message.header = &s_Header;
+    s_Message.data.data = s_Payload;
+    s_Message.data.len = sizeof(s_Payload);
+
+    uint8_t s_Packed[MessagingBenchmarks_PayloadSize * 2];
+    Mira::Utils::Arena s_Arena(Mira::Utils::MemoryTag_Messaging);
+
+    // Same round trip a request takes through Connection and MessageManager::SendResponse
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_PackedSize = rpc_transport__get_packed_size(&s_Message);
+        rpc_transport__pack(&s_Message, s_Packed);
+
+        auto l_Unpacked = rpc_transport__unpack(s_Arena.GetProtobufAllocator(), l_PackedSize, s_Packed);
+        DoNotOptimize(l_Unpacked);
+
+        s_Arena.Reset();
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    s_Arena.Destroy();
+
+    return s_Elapsed;
+}
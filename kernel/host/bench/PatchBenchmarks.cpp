@@ -0,0 +1,114 @@
+#include "Benchmarks.hpp"
+
+#include <OrbisOS/PatchSet.hpp>
+
+extern "C"
+{
+    #include <sys/mman.h>
+};
+
+using namespace Mira::Host;
+using namespace Mira::OrbisOS;
+
+enum
+{
+    // Mappings of a system process, SceShellUI has a few hundred
+    PatchBenchmarks_MapCount = 256,
+
+    PatchBenchmarks_TextSize = 0x1000,
+};
+
+static uint8_t s_Text[PatchBenchmarks_TextSize];
+static uint8_t s_Module[PatchBenchmarks_TextSize];
+static ProcVmMapEntry s_Map[PatchBenchmarks_MapCount];
+
+static const uint8_t s_XorEaxEax[] = { 0x31, 0xC0, 0x90, 0x90, 0x90 };
+static const uint8_t s_MovEax1Ret[] = { 0xB8, 0x01, 0x00, 0x00, 0x00, 0xC3 };
+static const uint8_t s_Original[] = { 0xE8, 0x10, 0x20, 0x30, 0x40, 0x90 };
+
+// Laid out like the SceShellCore set of FakePkgManager plus a module patch
+static const PatchSetEntry s_Patches[] =
+{
+    { "patchA", nullptr, 0x100, s_Original, s_XorEaxEax, sizeof(s_XorEaxEax) },
+    { "patchB", nullptr, 0x200, s_Original, s_XorEaxEax, sizeof(s_XorEaxEax) },
+    { "patchC", nullptr, 0x300, s_Original, s_XorEaxEax, sizeof(s_XorEaxEax) },
+    { "patchD", nullptr, 0x400, s_Original, s_XorEaxEax, sizeof(s_XorEaxEax) },
+    { "patchE", nullptr, 0x500, s_Original, s_XorEaxEax, sizeof(s_XorEaxEax) },
+    { "patchF", nullptr, 0x600, s_Original, s_XorEaxEax, sizeof(s_XorEaxEax) },
+    { "patchG", nullptr, 0x700, s_Original, s_XorEaxEax, sizeof(s_XorEaxEax) },
+    { "patchH", nullptr, 0x800, s_Original, s_XorEaxEax, sizeof(s_XorEaxEax) },
+    { "module", "libkernel_sys.sprx", 0x80, s_Original, s_MovEax1Ret, sizeof(s_MovEax1Ret) },
+};
+
+static void SetupBenchMap()
+{
+    // Data and anonymous mappings first, the module near the end of the map
+    for (uint32_t l_Index = 0; l_Index < PatchBenchmarks_MapCount; ++l_Index)
+    {
+        auto& l_Map = s_Map[l_Index];
+        memset(&l_Map, 0, sizeof(l_Map));
+        l_Map.start = 0x1000000ull + static_cast<uint64_t>(l_Index) * 0x10000;
+        l_Map.end = l_Map.start + 0x10000;
+        l_Map.prot = PROT_READ | PROT_WRITE;
+    }
+
+    s_Map[PatchBenchmarks_MapCount / 4].start = reinterpret_cast<uint64_t>(s_Text);
+    s_Map[PatchBenchmarks_MapCount / 4].prot = PROT_READ | PROT_EXEC;
+    memcpy(s_Map[PatchBenchmarks_MapCount / 4].name, "executable", sizeof("executable"));
+
+    s_Map[PatchBenchmarks_MapCount - 8].start = reinterpret_cast<uint64_t>(s_Module);
+    s_Map[PatchBenchmarks_MapCount - 8].prot = PROT_READ | PROT_EXEC;
+    memcpy(s_Map[PatchBenchmarks_MapCount - 8].name, "libkernel_sys.sprx", sizeof("libkernel_sys.sprx"));
+}
+
+static void RestoreBenchText()
+{
+    for (auto& l_Patch : s_Patches)
+        memcpy((l_Patch.Module == nullptr ? s_Text : s_Module) + l_Patch.Offset, s_Original, l_Patch.Size);
+}
+
+// Resolving, verifying and writing a set into an unpatched process
+uint64_t Mira::Host::Bench_PatchSetApply(uint64_t p_Iterations)
+{
+    SetupBenchMap();
+
+    uint64_t s_Sum = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        RestoreBenchText();
+
+        PatchSet l_PatchSet("bench", s_Patches, ARRAYSIZE(s_Patches));
+        auto l_Ret = l_PatchSet.Apply(nullptr, s_Map, PatchBenchmarks_MapCount);
+        s_Sum += l_Ret == 0 ? l_PatchSet.GetAppliedMask() : 0;
+    }
+    auto s_End = MiraHost_GetNanoseconds();
+
+    DoNotOptimize(s_Sum);
+    return s_End - s_Start;
+}
+
+// The same set again after a resume, everything is found in place and nothing is written
+uint64_t Mira::Host::Bench_PatchSetReapply(uint64_t p_Iterations)
+{
+    SetupBenchMap();
+    RestoreBenchText();
+
+    PatchSet s_First("bench", s_Patches, ARRAYSIZE(s_Patches));
+    s_First.Apply(nullptr, s_Map, PatchBenchmarks_MapCount);
+
+    uint64_t s_Sum = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        PatchSet l_PatchSet("bench", s_Patches, ARRAYSIZE(s_Patches));
+        auto l_Ret = l_PatchSet.Apply(nullptr, s_Map, PatchBenchmarks_MapCount);
+        s_Sum += l_Ret == 0 ? l_PatchSet.GetAppliedMask() : 0;
+    }
+    auto s_End = MiraHost_GetNanoseconds();
+
+    DoNotOptimize(s_Sum);
+    return s_End - s_Start;
+}
@@ -0,0 +1,126 @@
+#include "Benchmarks.hpp"
+
+#include <OrbisOS/ProcessIndex.hpp>
+#include <Utils/Kernel.hpp>
+
+using namespace Mira::Host;
+using namespace Mira::OrbisOS;
+
+enum
+{
+    // Processes of a console running a game, daemons and the game's helpers included
+    ProcessBenchmarks_ProcessCount = 96,
+};
+
+// Just what the allproc walk reads
+struct BenchProcess
+{
+    BenchProcess* Next;
+    int32_t ProcessId;
+    char Name[ProcessIndex_NameLength];
+};
+
+static BenchProcess s_Processes[ProcessBenchmarks_ProcessCount];
+static ProcessIndex s_Index;
+
+// What the patching plugins look up, started early in boot so they sit at the end of allproc
+static const char* s_LookupNames[] = { "SceShellCore", "SceShellUI", "SceRemotePlay", "SceSysCore" };
+
+static BenchProcess* SetupBenchProcesses()
+{
+    s_Index.Clear();
+
+    // Newest first like allproc, the looked up system processes are the oldest
+    for (uint32_t l_Index = 0; l_Index < ProcessBenchmarks_ProcessCount; ++l_Index)
+    {
+        auto& l_Process = s_Processes[l_Index];
+        l_Process.Next = l_Index + 1 < ProcessBenchmarks_ProcessCount ? &s_Processes[l_Index + 1] : nullptr;
+        l_Process.ProcessId = 100 + static_cast<int32_t>(ProcessBenchmarks_ProcessCount - l_Index) * 3;
+        memset(l_Process.Name, 0, sizeof(l_Process.Name));
+
+        auto l_SystemIndex = ProcessBenchmarks_ProcessCount - 1 - l_Index;
+        if (l_SystemIndex < ARRAYSIZE(s_LookupNames))
+        {
+            memcpy(l_Process.Name, s_LookupNames[l_SystemIndex], strlen(s_LookupNames[l_SystemIndex]));
+        }
+        else
+        {
+            // "SceDaemonNN", they all share the prefix the compare has to get through
+            memcpy(l_Process.Name, "SceDaemon", 9);
+            l_Process.Name[9] = static_cast<char>('0' + (l_Index / 10) % 10);
+            l_Process.Name[10] = static_cast<char>('0' + l_Index % 10);
+        }
+
+        s_Index.Insert(reinterpret_cast<struct proc*>(&l_Process), l_Process.ProcessId, l_Process.Name, false);
+    }
+
+    return &s_Processes[0];
+}
+
+// FindProcessByName before the index, a strcmp per process from the head of allproc
+uint64_t Mira::Host::Bench_ProcessFindListWalk(uint64_t p_Iterations)
+{
+    auto s_Head = SetupBenchProcesses();
+
+    uint64_t s_Sum = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Name = s_LookupNames[l_Index % ARRAYSIZE(s_LookupNames)];
+
+        for (auto l_Process = s_Head; l_Process != nullptr; l_Process = l_Process->Next)
+        {
+            if (strcmp(l_Process->Name, l_Name) == 0)
+            {
+                s_Sum += l_Process->ProcessId;
+                break;
+            }
+        }
+    }
+    auto s_End = MiraHost_GetNanoseconds();
+
+    DoNotOptimize(s_Sum);
+    return s_End - s_Start;
+}
+
+uint64_t Mira::Host::Bench_ProcessFindIndexed(uint64_t p_Iterations)
+{
+    SetupBenchProcesses();
+
+    uint64_t s_Sum = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Process = reinterpret_cast<BenchProcess*>(s_Index.FindByName(s_LookupNames[l_Index % ARRAYSIZE(s_LookupNames)]));
+        s_Sum += l_Process != nullptr ? l_Process->ProcessId : 0;
+    }
+    auto s_End = MiraHost_GetNanoseconds();
+
+    DoNotOptimize(s_Sum);
+    return s_End - s_Start;
+}
+
+// A short lived process going through fork, exec and exit, what every event costs the index
+uint64_t Mira::Host::Bench_ProcessIndexLifecycle(uint64_t p_Iterations)
+{
+    SetupBenchProcesses();
+
+    BenchProcess s_Process = { nullptr, 0, "SceShellCore" };
+    uint64_t s_Sum = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        s_Process.ProcessId = 1000 + static_cast<int32_t>(l_Index & 0xFFFF);
+
+        s_Index.Insert(reinterpret_cast<struct proc*>(&s_Process), s_Process.ProcessId, "SceShellCore", false);
+        s_Index.Insert(reinterpret_cast<struct proc*>(&s_Process), s_Process.ProcessId, "eboot.bin", true);
+        s_Sum += s_Index.Remove(reinterpret_cast<struct proc*>(&s_Process), s_Process.ProcessId);
+    }
+    auto s_End = MiraHost_GetNanoseconds();
+
+    DoNotOptimize(s_Sum);
+    return s_End - s_Start;
+}
@@ -0,0 +1,168 @@
+#include "Benchmarks.hpp"
+
+#include <OrbisOS/GpuVaIndex.hpp>
+#include <Utils/Kdlsym.hpp>
+
+extern "C"
+{
+    #include <sys/param.h>
+    #include <sys/lock.h>
+    #include <sys/mutex.h>
+};
+
+using namespace Mira::Host;
+
+enum
+{
+    // Mappings alive while a title boots, every segment and header being decrypted has some
+    SblBenchmarks_MappingCount = 128,
+
+    // Gap between two GPU VAs, the SBL hands them out page aligned
+    SblBenchmarks_GpuVaStride = 0x10000,
+
+    SblBenchmarks_GpuVaBase = 0x100000000,
+};
+
+static Mira::OrbisOS::SblMapListEntry s_Entries[SblBenchmarks_MappingCount];
+
+// sbl_drv_msg_mtx for the walk, the index's own mutex for a lookup, both are taken per GPU VA
+static struct mtx s_BenchMutex;
+static bool s_BenchMutexInitialized = false;
+
+static struct mtx* GetBenchMutex()
+{
+    auto mtx_init = (void(*)(struct mtx *m, const char *name, const char *type, int opts))kdlsym(mtx_init);
+
+    if (!s_BenchMutexInitialized)
+    {
+        mtx_init(&s_BenchMutex, "BenchSblMap", nullptr, MTX_DEF);
+        s_BenchMutexInitialized = true;
+    }
+
+    return &s_BenchMutex;
+}
+
+static Mira::OrbisOS::SblMapListEntry* SetupBenchPageList()
+{
+    // Newest mapping at the head, like the driver links them
+    for (uint32_t l_Index = 0; l_Index < SblBenchmarks_MappingCount; ++l_Index)
+    {
+        auto& l_Entry = s_Entries[l_Index];
+        l_Entry.next = l_Index + 1 < SblBenchmarks_MappingCount ? &s_Entries[l_Index + 1] : nullptr;
+        l_Entry.prev = l_Index > 0 ? &s_Entries[l_Index - 1] : nullptr;
+        l_Entry.gpuVa = SblBenchmarks_GpuVaBase + static_cast<uint64_t>(SblBenchmarks_MappingCount - l_Index) * SblBenchmarks_GpuVaStride;
+        l_Entry.cpuVa = 0xFFFFFF8000000000ull + l_Entry.gpuVa;
+        l_Entry.numPages = 1 + (l_Index % 4);
+    }
+
+    return &s_Entries[0];
+}
+
+static uint64_t GetBenchGpuVa(uint64_t& p_Random)
+{
+    return SblBenchmarks_GpuVaBase + (1 + NextRandom(p_Random) % SblBenchmarks_MappingCount) * SblBenchmarks_GpuVaStride;
+}
+
+// What SceSblDriverFindMappedPageListByGpuVa did for every GPU VA of a mailbox message before the index,
+// and still does for mappings made before the hooks went in
+uint64_t Mira::Host::Bench_SblGpuVaFindListWalk(uint64_t p_Iterations)
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_unlock_flags);
+
+    auto s_Mutex = GetBenchMutex();
+    auto s_Head = SetupBenchPageList();
+
+    uint64_t s_Random = 0x2545F4914F6CDD1Dull;
+    uint64_t s_Sum = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_GpuVa = GetBenchGpuVa(s_Random);
+
+        _mtx_lock_flags(s_Mutex, 0, __FILE__, __LINE__);
+        for (auto l_Entry = s_Head; l_Entry != nullptr; l_Entry = l_Entry->next)
+        {
+            if (l_Entry->gpuVa == l_GpuVa)
+            {
+                s_Sum += l_Entry->cpuVa;
+                break;
+            }
+        }
+        _mtx_unlock_flags(s_Mutex, 0, __FILE__, __LINE__);
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_Sum);
+
+    return s_Elapsed;
+}
+
+// SblMapIndex::Find on a hit, the index is authoritative so nothing else is read
+uint64_t Mira::Host::Bench_SblGpuVaFindIndexed(uint64_t p_Iterations)
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_unlock_flags);
+
+    auto s_Mutex = GetBenchMutex();
+    SetupBenchPageList();
+
+    Mira::OrbisOS::GpuVaIndex s_Index;
+    for (uint32_t l_Index = 0; l_Index < SblBenchmarks_MappingCount; ++l_Index)
+    {
+        auto& l_Entry = s_Entries[l_Index];
+        s_Index.Insert(l_Entry.gpuVa, static_cast<uint64_t>(l_Entry.numPages) * PAGE_SIZE, l_Index, &l_Entry);
+    }
+
+    uint64_t s_Random = 0x2545F4914F6CDD1Dull;
+    uint64_t s_Sum = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_GpuVa = GetBenchGpuVa(s_Random);
+
+        _mtx_lock_flags(s_Mutex, 0, __FILE__, __LINE__);
+        auto l_Entry = s_Index.Find(l_GpuVa);
+        _mtx_unlock_flags(s_Mutex, 0, __FILE__, __LINE__);
+
+        if (l_Entry != nullptr)
+            s_Sum += l_Entry->cpuVa;
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_Sum);
+
+    return s_Elapsed;
+}
+
+// One map and one unmap per iteration, the cost the hooks add to every sceSblDriverMapPages pair
+uint64_t Mira::Host::Bench_SblGpuVaIndexMapUnmap(uint64_t p_Iterations)
+{
+    SetupBenchPageList();
+
+    Mira::OrbisOS::GpuVaIndex s_Index;
+    for (uint32_t l_Index = 0; l_Index < SblBenchmarks_MappingCount; ++l_Index)
+    {
+        auto& l_Entry = s_Entries[l_Index];
+        s_Index.Insert(l_Entry.gpuVa, static_cast<uint64_t>(l_Entry.numPages) * PAGE_SIZE, l_Index, &l_Entry);
+    }
+
+    uint64_t s_Random = 0x2545F4914F6CDD1Dull;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Slot = NextRandom(s_Random) % SblBenchmarks_MappingCount;
+        auto& l_Entry = s_Entries[l_Slot];
+
+        s_Index.RemoveDescriptor(l_Slot);
+        s_Index.Insert(l_Entry.gpuVa, static_cast<uint64_t>(l_Entry.numPages) * PAGE_SIZE, l_Slot, &l_Entry);
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_Index.GetCount());
+
+    return s_Elapsed;
+}
@@ -0,0 +1,235 @@
+#include "Benchmarks.hpp"
+
+#include <Plugins/Substitute/JmpslotCache.hpp>
+#include <Plugins/Substitute/NidDatabase.hpp>
+
+using namespace Mira::Host;
+
+enum
+{
+    // Imports of a large system module (libkernel/libSceGnmDriver sized)
+    SubstituteBenchmarks_ImportCount = 1024,
+
+    // "XXXXXXXXXXX#A#B" plus the terminator
+    SubstituteBenchmarks_NameSize = 16,
+};
+
+// Just the fields of a dynlib object and its relocation info that the lookup reads
+struct BenchModule
+{
+    uint8_t Object[0x160];
+    uint8_t Info[0x60];
+    uint8_t Symbols[24 * SubstituteBenchmarks_ImportCount];
+    uint64_t Relocations[3 * SubstituteBenchmarks_ImportCount];
+    char Strings[SubstituteBenchmarks_NameSize * SubstituteBenchmarks_ImportCount];
+};
+
+static BenchModule s_Module;
+
+static void GetBenchNid(uint32_t p_Index, char* p_OutNid)
+{
+    static const char s_Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+-";
+
+    // Real NIDs are base64 of a hash, spread the bits the same way
+    uint64_t s_Value = Mira::Utils::HashMix64(p_Index + 1);
+    for (auto l_Index = 0; l_Index < Mira::Plugins::JmpslotCache_NidLength; ++l_Index)
+    {
+        p_OutNid[l_Index] = s_Alphabet[s_Value & 63];
+        s_Value >>= 6;
+        if (l_Index == 9)
+            s_Value = Mira::Utils::HashMix64(s_Value ^ p_Index);
+    }
+    p_OutNid[Mira::Plugins::JmpslotCache_NidLength] = '\0';
+}
+
+static uint64_t SetupBenchModule()
+{
+    auto s_Object = reinterpret_cast<uint64_t>(s_Module.Object);
+    auto s_Info = reinterpret_cast<uint64_t>(s_Module.Info);
+
+    for (uint32_t l_Index = 0; l_Index < SubstituteBenchmarks_ImportCount; ++l_Index)
+    {
+        auto l_Name = &s_Module.Strings[l_Index * SubstituteBenchmarks_NameSize];
+        GetBenchNid(l_Index, l_Name);
+        l_Name[11] = '#';
+        l_Name[12] = 'A';
+        l_Name[13] = '#';
+        l_Name[14] = 'A';
+
+        *reinterpret_cast<uint32_t*>(&s_Module.Symbols[l_Index * 24]) = l_Index * SubstituteBenchmarks_NameSize;
+
+        s_Module.Relocations[l_Index * 3] = 0x10000 + l_Index * sizeof(uint64_t);
+        s_Module.Relocations[l_Index * 3 + 1] = (static_cast<uint64_t>(l_Index) << 32) | 7;
+        s_Module.Relocations[l_Index * 3 + 2] = 0;
+    }
+
+    *reinterpret_cast<uint64_t*>(s_Object + 0x70) = 0x400000;
+    *reinterpret_cast<uint64_t*>(s_Object + 0x150) = s_Info;
+    *reinterpret_cast<uint64_t*>(s_Info + 0x28) = reinterpret_cast<uint64_t>(s_Module.Symbols);
+    *reinterpret_cast<uint64_t*>(s_Info + 0x30) = sizeof(s_Module.Symbols);
+    *reinterpret_cast<uint64_t*>(s_Info + 0x38) = reinterpret_cast<uint64_t>(s_Module.Strings);
+    *reinterpret_cast<uint64_t*>(s_Info + 0x40) = sizeof(s_Module.Strings);
+    *reinterpret_cast<uint64_t*>(s_Info + 0x48) = reinterpret_cast<uint64_t>(s_Module.Relocations);
+    *reinterpret_cast<uint64_t*>(s_Info + 0x50) = sizeof(s_Module.Relocations);
+
+    return s_Object;
+}
+
+// The relocation walk FindJmpslotAddress did for every IAT hook before the index, as a reference point
+uint64_t Mira::Host::Bench_JmpslotFindLinear(uint64_t p_Iterations)
+{
+    auto s_Object = SetupBenchModule();
+    auto s_Info = *reinterpret_cast<uint64_t*>(s_Object + 0x150);
+
+    uint64_t s_Random = 0x2545F4914F6CDD1Dull;
+    uint64_t s_Sum = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        char l_Nid[Mira::Plugins::JmpslotCache_NidLength + 1];
+        GetBenchNid(NextRandom(s_Random) % SubstituteBenchmarks_ImportCount, l_Nid);
+
+        auto l_Relocations = *reinterpret_cast<uint64_t*>(s_Info + 0x48);
+        auto l_End = l_Relocations + *reinterpret_cast<uint64_t*>(s_Info + 0x50);
+        for (auto l_Current = l_Relocations; l_Current < l_End; l_Current += 0x18)
+        {
+            auto l_SymbolOffset = ((*reinterpret_cast<uint64_t*>(l_Current + 0x8)) >> 32) * 24;
+            auto l_NameOffset = *reinterpret_cast<uint32_t*>(*reinterpret_cast<uint64_t*>(s_Info + 0x28) + l_SymbolOffset);
+            auto l_Name = reinterpret_cast<const char*>(*reinterpret_cast<uint64_t*>(s_Info + 0x38) + l_NameOffset);
+
+            auto l_CharIndex = 0;
+            while (l_CharIndex < Mira::Plugins::JmpslotCache_NidLength && l_Name[l_CharIndex] == l_Nid[l_CharIndex] && l_Nid[l_CharIndex] != '\0')
+                ++l_CharIndex;
+
+            if (l_CharIndex == Mira::Plugins::JmpslotCache_NidLength)
+            {
+                s_Sum += *reinterpret_cast<uint64_t*>(l_Current);
+                break;
+            }
+        }
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_Sum);
+
+    return s_Elapsed;
+}
+
+uint64_t Mira::Host::Bench_JmpslotFindIndexed(uint64_t p_Iterations)
+{
+    auto s_Object = SetupBenchModule();
+    auto s_Cache = new Mira::Plugins::JmpslotCache();
+    if (s_Cache == nullptr)
+        return 0;
+
+    // Any non-null pointer works as the process key
+    auto s_Process = reinterpret_cast<struct proc*>(&s_Module);
+
+    uint64_t s_Random = 0x2545F4914F6CDD1Dull;
+    uint64_t s_Sum = 0;
+
+    // The index gets built by the first lookup, which is included like it is on the first hook
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        char l_Nid[Mira::Plugins::JmpslotCache_NidLength + 1];
+        GetBenchNid(NextRandom(s_Random) % SubstituteBenchmarks_ImportCount, l_Nid);
+
+        s_Sum += s_Cache->Find(s_Process, s_Object, l_Nid);
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_Sum);
+
+    delete s_Cache;
+
+    return s_Elapsed;
+}
+
+// Names mods commonly hook by name, all of them are in the generated table
+static const char* s_TableNames[] =
+{
+    "malloc", "free", "memcpy", "printf", "sceKernelLoadStartModule", "sceKernelOpen", "sceKernelRead",
+    "scePthreadCreate", "scePthreadMutexLock", "sceKernelUsleep", "pthread_mutex_lock", "strlen",
+};
+
+// Game specific names, these are not in the table and end up in the cache
+static const char* s_UncachedNames[] =
+{
+    "sceGnmSubmitCommandBuffers", "sceVideoOutSubmitFlip", "scePadReadState", "sceAudioOutOutput",
+    "sceNpTrophyUnlockTrophy", "sceSaveDataMount2", "sceUserServiceGetInitialUser", "sceSystemServiceHideSplashScreen",
+};
+
+// What every name based hook paid before the table
+uint64_t Mira::Host::Bench_NidNameToNids(uint64_t p_Iterations)
+{
+    auto name_to_nids = (void(*)(const char *name, const char *nids_out))kdlsym(name_to_nids);
+
+    uint64_t s_Random = 0x2545F4914F6CDD1Dull;
+    uint64_t s_Sum = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        char l_Nid[Mira::Plugins::NidDatabase_NidSize + 1] = { 0 };
+        name_to_nids(s_TableNames[NextRandom(s_Random) % ARRAYSIZE(s_TableNames)], l_Nid);
+        s_Sum += static_cast<uint8_t>(l_Nid[0]);
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_Sum);
+
+    return s_Elapsed;
+}
+
+uint64_t Mira::Host::Bench_NidDatabaseTable(uint64_t p_Iterations)
+{
+    auto s_Database = new Mira::Plugins::NidDatabase();
+    if (s_Database == nullptr)
+        return 0;
+
+    uint64_t s_Random = 0x2545F4914F6CDD1Dull;
+    uint64_t s_Sum = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        char l_Nid[Mira::Plugins::NidDatabase_NidSize];
+        s_Database->GetNid(s_TableNames[NextRandom(s_Random) % ARRAYSIZE(s_TableNames)], l_Nid);
+        s_Sum += static_cast<uint8_t>(l_Nid[0]);
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_Sum);
+
+    delete s_Database;
+
+    return s_Elapsed;
+}
+
+uint64_t Mira::Host::Bench_NidDatabaseCache(uint64_t p_Iterations)
+{
+    auto s_Database = new Mira::Plugins::NidDatabase();
+    if (s_Database == nullptr)
+        return 0;
+
+    uint64_t s_Random = 0x2545F4914F6CDD1Dull;
+    uint64_t s_Sum = 0;
+
+    // The first lookup of each name hashes it like before, everything after is a cache hit
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        char l_Nid[Mira::Plugins::NidDatabase_NidSize];
+        s_Database->GetNid(s_UncachedNames[NextRandom(s_Random) % ARRAYSIZE(s_UncachedNames)], l_Nid);
+        s_Sum += static_cast<uint8_t>(l_Nid[0]);
+    }
+    auto s_Elapsed = MiraHost_GetNanoseconds() - s_Start;
+
+    DoNotOptimize(s_Sum);
+
+    delete s_Database;
+
+    return s_Elapsed;
+}
@@ -0,0 +1,80 @@
+#include "Benchmarks.hpp"
+
+#include <Utils/Kernel.hpp>
+
+#include "../tools/SignatureScanner.h"
+
+using namespace Mira::Host;
+
+enum
+{
+    // Size of a full 6.xx kernel dump, text and data
+    ToolBenchmarks_ImageSize = 30 * 1024 * 1024,
+
+    // Roughly one signature per kdlsym of a firmware header
+    ToolBenchmarks_SignatureCount = 320,
+    ToolBenchmarks_SignatureLength = 24,
+};
+
+static uint8_t s_Image[ToolBenchmarks_ImageSize];
+static uint8_t s_Bytes[ToolBenchmarks_SignatureCount][ToolBenchmarks_SignatureLength];
+static uint8_t s_Mask[ToolBenchmarks_SignatureCount][ToolBenchmarks_SignatureLength];
+static MiraSignature s_Signatures[ToolBenchmarks_SignatureCount];
+
+// Prologue and padding bytes, frequent enough in a kernel that anchors start matching a lot
+static const uint8_t s_CommonBytes[] = { 0x55, 0x48, 0x89, 0xE5, 0x41, 0x57, 0x56, 0x53, 0x8B, 0x0F, 0xE8, 0xC3, 0xCC, 0x00, 0x90, 0xFF };
+
+static void SetupBenchImage()
+{
+    uint64_t s_Random = 0x9E3779B97F4A7C15ull;
+
+    for (uint32_t l_Index = 0; l_Index < ToolBenchmarks_ImageSize; ++l_Index)
+    {
+        auto l_Value = NextRandom(s_Random);
+        s_Image[l_Index] = (l_Value & 3) != 0 ? s_CommonBytes[(l_Value >> 8) & 0xF] : static_cast<uint8_t>(l_Value >> 16);
+    }
+
+    // Signatures start like functions and wildcard a call target, each planted once
+    for (uint32_t l_Index = 0; l_Index < ToolBenchmarks_SignatureCount; ++l_Index)
+    {
+        auto l_Offset = NextRandom(s_Random) % (ToolBenchmarks_ImageSize - ToolBenchmarks_SignatureLength);
+
+        for (uint32_t l_Byte = 0; l_Byte < ToolBenchmarks_SignatureLength; ++l_Byte)
+        {
+            s_Bytes[l_Index][l_Byte] = l_Byte < 4 ? s_CommonBytes[l_Byte] : static_cast<uint8_t>(NextRandom(s_Random));
+            s_Mask[l_Index][l_Byte] = (l_Byte >= 10 && l_Byte < 14) ? 0x00 : 0xFF;
+        }
+
+        memcpy(&s_Image[l_Offset], s_Bytes[l_Index], ToolBenchmarks_SignatureLength);
+
+        auto& l_Signature = s_Signatures[l_Index];
+        memset(&l_Signature, 0, sizeof(l_Signature));
+        l_Signature.Name = "bench";
+        l_Signature.Bytes = s_Bytes[l_Index];
+        l_Signature.Mask = s_Mask[l_Index];
+        l_Signature.Length = ToolBenchmarks_SignatureLength;
+    }
+}
+
+// One KdlsymScan pass over a kernel sized image, building the automaton included
+uint64_t Mira::Host::Bench_KdlsymScan(uint64_t p_Iterations)
+{
+    SetupBenchImage();
+
+    uint64_t s_Sum = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Scanner = MiraScanner_Create(s_Signatures, ToolBenchmarks_SignatureCount);
+        MiraScanner_Scan(l_Scanner, s_Image, ToolBenchmarks_ImageSize);
+        MiraScanner_Destroy(l_Scanner);
+
+        for (auto& l_Signature : s_Signatures)
+            s_Sum += l_Signature.MatchCount;
+    }
+    auto s_End = MiraHost_GetNanoseconds();
+
+    DoNotOptimize(s_Sum);
+    return s_End - s_Start;
+}
@@ -0,0 +1,120 @@
+#include "Benchmarks.hpp"
+
+#include <OrbisOS/VmMapQuery.hpp>
+#include <Utils/Kernel.hpp>
+
+extern "C"
+{
+    #include <sys/param.h>
+    #include <sys/lock.h>
+    #include <sys/mutex.h>
+    #include <vm/vm.h>
+    #include <vm/pmap.h>
+    #include <vm/vm_map.h>
+};
+
+using namespace Mira::Host;
+using namespace Mira::OrbisOS;
+
+enum
+{
+    // Mappings of a system process, SceShellUI has a few hundred
+    VmMapBenchmarks_EntryCount = 256,
+
+    // Text, data and bss of every module
+    VmMapBenchmarks_EntriesPerModule = 4,
+
+    VmMapBenchmarks_EntrySize = 0x4000,
+    VmMapBenchmarks_BaseAddress = 0x400000,
+};
+
+static struct vm_map s_Map;
+static struct vm_map_entry s_MapEntries[VmMapBenchmarks_EntryCount];
+
+static const char* s_ModuleNames[] = { "libkernel.sprx", "libSceLibcInternal.sprx", "libSceSysmodule.sprx", "libScePad.sprx", "SceShellUI" };
+
+static void SetupBenchMap()
+{
+    memset(&s_Map, 0, sizeof(s_Map));
+    memset(s_MapEntries, 0, sizeof(s_MapEntries));
+
+    // Sorted and circular through the header, like the entry list of a locked map
+    auto s_Previous = &s_Map.header;
+    for (uint32_t l_Index = 0; l_Index < VmMapBenchmarks_EntryCount; ++l_Index)
+    {
+        auto& l_Entry = s_MapEntries[l_Index];
+        l_Entry.start = VmMapBenchmarks_BaseAddress + static_cast<uint64_t>(l_Index) * VmMapBenchmarks_EntrySize;
+        l_Entry.end = l_Entry.start + VmMapBenchmarks_EntrySize;
+        l_Entry.protection = (l_Index % VmMapBenchmarks_EntriesPerModule) == 0 ? (VM_PROT_READ | VM_PROT_EXECUTE) : (VM_PROT_READ | VM_PROT_WRITE);
+
+        auto l_Name = s_ModuleNames[(l_Index / VmMapBenchmarks_EntriesPerModule) % ARRAYSIZE(s_ModuleNames)];
+        memcpy(l_Entry.name, l_Name, strlen(l_Name));
+
+        l_Entry.prev = s_Previous;
+        s_Previous->next = &l_Entry;
+        s_Previous = &l_Entry;
+    }
+
+    s_Previous->next = &s_Map.header;
+    s_Map.header.prev = s_Previous;
+    s_Map.nentries = VmMapBenchmarks_EntryCount;
+    s_Map.timestamp = 1;
+}
+
+static uint64_t GetLookupAddress(uint64_t p_Index)
+{
+    // Spread over the whole map, the entry a patcher or debugger looks for can be anywhere
+    auto s_Entry = (p_Index * 97) % VmMapBenchmarks_EntryCount;
+    return VmMapBenchmarks_BaseAddress + s_Entry * VmMapBenchmarks_EntrySize + 0x10;
+}
+
+// The address lookup before the query variants, GetProcessVmMap copied the whole map each time
+uint64_t Mira::Host::Bench_VmMapCopyAndScan(uint64_t p_Iterations)
+{
+    SetupBenchMap();
+
+    uint64_t s_Sum = 0;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Address = GetLookupAddress(l_Index);
+
+        auto l_Entries = new ProcVmMapEntry[s_Map.nentries];
+        auto l_Count = VmMapQuery::Collect(&s_Map, nullptr, l_Entries, s_Map.nentries);
+        for (size_t l_Entry = 0; l_Entry < l_Count; ++l_Entry)
+        {
+            if (l_Address >= l_Entries[l_Entry].start && l_Address < l_Entries[l_Entry].end)
+            {
+                s_Sum += l_Entries[l_Entry].start;
+                break;
+            }
+        }
+
+        delete [] l_Entries;
+    }
+    auto s_End = MiraHost_GetNanoseconds();
+
+    DoNotOptimize(s_Sum);
+    return s_End - s_Start;
+}
+
+uint64_t Mira::Host::Bench_VmMapCollectContaining(uint64_t p_Iterations)
+{
+    SetupBenchMap();
+
+    uint64_t s_Sum = 0;
+    ProcVmMapEntry s_Entry;
+
+    auto s_Start = MiraHost_GetNanoseconds();
+    for (uint64_t l_Index = 0; l_Index < p_Iterations; ++l_Index)
+    {
+        auto l_Filter = VmMapQuery::Containing(GetLookupAddress(l_Index));
+        if (VmMapQuery::Collect(&s_Map, &l_Filter, &s_Entry, 1) != 0)
+            s_Sum += s_Entry.start;
+    }
+    auto s_End = MiraHost_GetNanoseconds();
+
+    DoNotOptimize(s_Sum);
+    return s_End - s_Start;
+}
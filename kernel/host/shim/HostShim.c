@@ -0,0 +1,306 @@
+/*
+    HostShim.c
+
+    libc backed implementations of the kernel functions Mira resolves through kdlsym(), see
+    HostShim.hpp. This is the only translation unit besides the runner that is built against
+    the host headers.
+
+    The benchmarks are single threaded, so critical sections are no-ops and every caller is
+    reported as running on cpu 0.
+*/
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// sys/malloc.h
+#define MIRA_HOST_M_ZERO 0x0100
+
+#define MIRA_HOST_PAGE_SIZE 0x1000
+#define MIRA_HOST_MINIMUM_ALLOCATION 0x10
+
+// Mirrors struct mtx and struct sx, HostShim.hpp checks the offset on the Mira side
+struct MiraHostMutex
+{
+    const char* Name;
+    unsigned int Flags;
+    unsigned int Data;
+    void* Witness;
+    volatile uintptr_t Lock;
+};
+
+struct MiraHostMallocType
+{
+    uint8_t Reserved[0x40];
+};
+
+struct MiraHostMallocType MiraHost_M_TEMP;
+
+void* MiraHost_malloc(unsigned long p_Size, struct MiraHostMallocType* p_Type, int p_Flags)
+{
+    (void)p_Type;
+
+    // malloc(9) serves small requests from power of 2 zones and large ones in whole pages, so
+    // blocks are aligned to their size. MemoryTracker relies on that, glibc does not do it.
+    size_t s_Size = MIRA_HOST_MINIMUM_ALLOCATION;
+    while (s_Size < p_Size && s_Size < MIRA_HOST_PAGE_SIZE)
+        s_Size <<= 1;
+
+    size_t s_Alignment = s_Size;
+    if (p_Size > MIRA_HOST_PAGE_SIZE)
+    {
+        s_Size = (p_Size + MIRA_HOST_PAGE_SIZE - 1) & ~(size_t)(MIRA_HOST_PAGE_SIZE - 1);
+        s_Alignment = MIRA_HOST_PAGE_SIZE;
+    }
+
+    void* s_Address = aligned_alloc(s_Alignment, s_Size);
+    if (s_Address != NULL && (p_Flags & MIRA_HOST_M_ZERO))
+        memset(s_Address, 0, s_Size);
+
+    return s_Address;
+}
+
+void MiraHost_free(void* p_Address, struct MiraHostMallocType* p_Type)
+{
+    (void)p_Type;
+
+    free(p_Address);
+}
+
+int MiraHost_printf(const char* p_Format, ...)
+{
+    va_list s_Args;
+    va_start(s_Args, p_Format);
+    int s_Ret = vprintf(p_Format, s_Args);
+    va_end(s_Args);
+
+    return s_Ret;
+}
+
+int MiraHost_snprintf(char* p_Buffer, size_t p_Size, const char* p_Format, ...)
+{
+    va_list s_Args;
+    va_start(s_Args, p_Format);
+    int s_Ret = vsnprintf(p_Buffer, p_Size, p_Format, s_Args);
+    va_end(s_Args);
+
+    return s_Ret;
+}
+
+int MiraHost_vsnprintf(char* p_Buffer, size_t p_Size, const char* p_Format, va_list p_Args)
+{
+    return vsnprintf(p_Buffer, p_Size, p_Format, p_Args);
+}
+
+void* MiraHost_memset(void* p_Destination, int p_Value, size_t p_Size)
+{
+    return memset(p_Destination, p_Value, p_Size);
+}
+
+void* MiraHost_memmove(void* p_Destination, const void* p_Source, size_t p_Size)
+{
+    return memmove(p_Destination, p_Source, p_Size);
+}
+
+void MiraHost_mtx_init(struct MiraHostMutex* p_Mutex, const char* p_Name, const char* p_Type, int p_Options)
+{
+    (void)p_Type;
+
+    memset(p_Mutex, 0, sizeof(*p_Mutex));
+    p_Mutex->Name = p_Name;
+    p_Mutex->Flags = (unsigned int)p_Options;
+}
+
+void MiraHost_mtx_destroy(struct MiraHostMutex* p_Mutex)
+{
+    if (p_Mutex->Lock != 0)
+    {
+        fprintf(stderr, "mutex (%s) destroyed while held\n", p_Mutex->Name ? p_Mutex->Name : "");
+        abort();
+    }
+}
+
+void MiraHost__mtx_lock_flags(struct MiraHostMutex* p_Mutex, int p_Options)
+{
+    (void)p_Options;
+
+    // Uncontended in the benchmarks, this only has to be correct and cost about what an atomic does
+    uintptr_t s_Expected = 0;
+    while (!__atomic_compare_exchange_n(&p_Mutex->Lock, &s_Expected, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        s_Expected = 0;
+        __builtin_ia32_pause();
+    }
+}
+
+void MiraHost__mtx_unlock_flags(struct MiraHostMutex* p_Mutex, int p_Options)
+{
+    (void)p_Options;
+
+    if (p_Mutex->Lock == 0)
+    {
+        fprintf(stderr, "mutex (%s) unlocked while not held\n", p_Mutex->Name ? p_Mutex->Name : "");
+        abort();
+    }
+
+    __atomic_store_n(&p_Mutex->Lock, 0, __ATOMIC_RELEASE);
+}
+
+void MiraHost__mtx_lock_spin_flags(struct MiraHostMutex* p_Mutex, int p_Options)
+{
+    MiraHost__mtx_lock_flags(p_Mutex, p_Options);
+}
+
+void MiraHost__mtx_unlock_spin_flags(struct MiraHostMutex* p_Mutex, int p_Options)
+{
+    MiraHost__mtx_unlock_flags(p_Mutex, p_Options);
+}
+
+// Exclusive only, shared sx locking is not used by anything built for the host
+void MiraHost__sx_init_flags(struct MiraHostMutex* p_Lock, const char* p_Description, int p_Options)
+{
+    MiraHost_mtx_init(p_Lock, p_Description, NULL, p_Options);
+}
+
+int MiraHost__sx_xlock(struct MiraHostMutex* p_Lock, int p_Options, const char* p_File, int p_Line)
+{
+    (void)p_File;
+    (void)p_Line;
+
+    MiraHost__mtx_lock_flags(p_Lock, p_Options);
+    return 0;
+}
+
+void MiraHost__sx_xunlock(struct MiraHostMutex* p_Lock, const char* p_File, int p_Line)
+{
+    (void)p_File;
+    (void)p_Line;
+
+    MiraHost__mtx_unlock_flags(p_Lock, 0);
+}
+
+void MiraHost_critical_enter(void)
+{
+}
+
+void MiraHost_critical_exit(void)
+{
+}
+
+unsigned int MiraHost_GetCpuId(void)
+{
+    return 0;
+}
+
+// Same as the kernel's name_to_nids: sha1(name + suffix), first 8 bytes byte swapped and base64
+// encoded with '+' and '-'. Only used as the slow path the NID table is compared against.
+static uint32_t MiraHost_Rotl32(uint32_t p_Value, int p_Count)
+{
+    return (p_Value << p_Count) | (p_Value >> (32 - p_Count));
+}
+
+static void MiraHost_Sha1(const uint8_t* p_Data, size_t p_Size, uint8_t p_OutDigest[20])
+{
+    uint32_t s_State[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+    uint64_t s_BitCount = (uint64_t)p_Size * 8;
+
+    // Message, 0x80, zero padding and the big endian bit count, in 64 byte blocks
+    size_t s_PaddedSize = ((p_Size + 8) / 64 + 1) * 64;
+    uint8_t* s_Padded = (uint8_t*)calloc(1, s_PaddedSize);
+    if (s_Padded == NULL)
+    {
+        memset(p_OutDigest, 0, 20);
+        return;
+    }
+
+    memcpy(s_Padded, p_Data, p_Size);
+    s_Padded[p_Size] = 0x80;
+    for (int l_Index = 0; l_Index < 8; ++l_Index)
+        s_Padded[s_PaddedSize - 1 - l_Index] = (uint8_t)(s_BitCount >> (l_Index * 8));
+
+    for (size_t l_Block = 0; l_Block < s_PaddedSize; l_Block += 64)
+    {
+        uint32_t l_Words[80];
+        for (int l_Index = 0; l_Index < 16; ++l_Index)
+        {
+            const uint8_t* l_Bytes = &s_Padded[l_Block + l_Index * 4];
+            l_Words[l_Index] = ((uint32_t)l_Bytes[0] << 24) | ((uint32_t)l_Bytes[1] << 16) | ((uint32_t)l_Bytes[2] << 8) | l_Bytes[3];
+        }
+
+        for (int l_Index = 16; l_Index < 80; ++l_Index)
+            l_Words[l_Index] = MiraHost_Rotl32(l_Words[l_Index - 3] ^ l_Words[l_Index - 8] ^ l_Words[l_Index - 14] ^ l_Words[l_Index - 16], 1);
+
+        uint32_t a = s_State[0], b = s_State[1], c = s_State[2], d = s_State[3], e = s_State[4];
+        for (int l_Index = 0; l_Index < 80; ++l_Index)
+        {
+            uint32_t l_F, l_K;
+            if (l_Index < 20)
+            {
+                l_F = (b & c) | (~b & d);
+                l_K = 0x5A827999;
+            }
+            else if (l_Index < 40)
+            {
+                l_F = b ^ c ^ d;
+                l_K = 0x6ED9EBA1;
+            }
+            else if (l_Index < 60)
+            {
+                l_F = (b & c) | (b & d) | (c & d);
+                l_K = 0x8F1BBCDC;
+            }
+            else
+            {
+                l_F = b ^ c ^ d;
+                l_K = 0xCA62C1D6;
+            }
+
+            uint32_t l_Temp = MiraHost_Rotl32(a, 5) + l_F + e + l_K + l_Words[l_Index];
+            e = d;
+            d = c;
+            c = MiraHost_Rotl32(b, 30);
+            b = a;
+            a = l_Temp;
+        }
+
+        s_State[0] += a;
+        s_State[1] += b;
+        s_State[2] += c;
+        s_State[3] += d;
+        s_State[4] += e;
+    }
+
+    free(s_Padded);
+
+    for (int l_Index = 0; l_Index < 20; ++l_Index)
+        p_OutDigest[l_Index] = (uint8_t)(s_State[l_Index / 4] >> (24 - (l_Index % 4) * 8));
+}
+
+void MiraHost_name_to_nids(const char* p_Name, char* p_OutNid)
+{
+    static const uint8_t s_Suffix[16] = { 0x51, 0x8D, 0x64, 0xA6, 0x35, 0xDE, 0xD8, 0xC1, 0xE6, 0xB0, 0x39, 0xB1, 0xC3, 0xE5, 0x52, 0x30 };
+    static const char s_Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+-";
+
+    size_t s_NameLength = strlen(p_Name);
+    uint8_t* s_Message = (uint8_t*)malloc(s_NameLength + sizeof(s_Suffix));
+    if (s_Message == NULL)
+        return;
+
+    memcpy(s_Message, p_Name, s_NameLength);
+    memcpy(s_Message + s_NameLength, s_Suffix, sizeof(s_Suffix));
+
+    uint8_t s_Digest[20];
+    MiraHost_Sha1(s_Message, s_NameLength + sizeof(s_Suffix), s_Digest);
+    free(s_Message);
+
+    // 64 bits are 10 full base64 characters and 4 bits left over for the 11th
+    uint64_t s_Value = 0;
+    for (int l_Index = 7; l_Index >= 0; --l_Index)
+        s_Value = (s_Value << 8) | s_Digest[l_Index];
+
+    for (int l_Index = 0; l_Index < 10; ++l_Index)
+        p_OutNid[l_Index] = s_Alphabet[(s_Value >> (58 - l_Index * 6)) & 0x3F];
+
+    p_OutNid[10] = s_Alphabet[(s_Value << 2) & 0x3C];
+}
@@ -0,0 +1,60 @@
+/*
+    HostShim.hpp
+
+    Force included (-include) into every Mira source that is built for the host. Each kdlsym()
+    resolves to a MiraHost_* symbol implemented against libc in HostShim.c instead of an offset
+    into the kernel image, so the code under test stays exactly as it ships.
+
+    Mira sources keep building against the FreeBSD headers with -nostdinc, only HostShim.c and
+    the benchmark runner see the Linux headers.
+*/
+#pragma once
+
+#define kdlsym(x) ((void*)&MiraHost_ ## x)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <sys/param.h>
+#include <sys/lock.h>
+#include <sys/mutex.h>
+#include <sys/sx.h>
+#include <sys/pcpu.h>
+
+// Kernel functions and objects, the declared type does not matter since only the address is taken
+extern char MiraHost_malloc;
+extern char MiraHost_free;
+extern char MiraHost_M_TEMP;
+extern char MiraHost_printf;
+extern char MiraHost_snprintf;
+extern char MiraHost_vsnprintf;
+extern char MiraHost_memset;
+extern char MiraHost_memmove;
+extern char MiraHost_mtx_init;
+extern char MiraHost_mtx_destroy;
+extern char MiraHost__mtx_lock_flags;
+extern char MiraHost__mtx_unlock_flags;
+extern char MiraHost__mtx_lock_spin_flags;
+extern char MiraHost__mtx_unlock_spin_flags;
+extern char MiraHost__sx_init_flags;
+extern char MiraHost__sx_xlock;
+extern char MiraHost__sx_xunlock;
+extern char MiraHost_critical_enter;
+extern char MiraHost_critical_exit;
+extern char MiraHost_name_to_nids;
+
+// The pcpu accessors read %gs, which is not set up for user mode processes
+u_int MiraHost_GetCpuId(void);
+
+#undef PCPU_GET
+#define PCPU_GET(member) MiraHost_PcpuGet_ ## member()
+#define MiraHost_PcpuGet_cpuid() MiraHost_GetCpuId()
+
+#ifdef __cplusplus
+}
+
+// HostShim.c has its own copy of the lock layout
+static_assert(__offsetof(struct mtx, mtx_lock) == 24, "struct mtx layout changed, update HostShim.c");
+static_assert(__offsetof(struct sx, sx_lock) == 24, "struct sx layout changed, update HostShim.c");
+#endif
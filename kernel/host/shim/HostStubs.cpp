@@ -0,0 +1,107 @@
+/*
+    HostStubs.cpp
+
+    Link time stand-ins for the parts of Mira that only make sense on the console. Nothing in the
+    benchmarks reaches these, they exist so MessageManager.cpp can be linked without pulling in
+    the whole framework. The exception is process memory access, the host has only its own
+    address space so PatchSet reads and writes go straight to it, and the tests can make them fail.
+    Vm map queries are answered from a map the tests set.
+*/
+#include "HostStubs.hpp"
+
+#include <Mira.hpp>
+#include <Utils/SysWrappers.hpp>
+#include <OrbisOS/Utilities.hpp>
+#include <OrbisOS/VmMapQuery.hpp>
+
+extern "C"
+{
+    #include <sys/errno.h>
+};
+
+Mira::Framework* Mira::Framework::GetFramework()
+{
+    return nullptr;
+}
+
+struct thread* Mira::Framework::GetMainThread()
+{
+    return nullptr;
+}
+
+ssize_t kwrite_t(int d, const void* buf, size_t nbytes, struct thread* td)
+{
+    return -EIO;
+}
+
+static uint64_t s_WriteFault = 0;
+
+void Mira::Host::SetProcessWriteFault(uint64_t p_Address)
+{
+    s_WriteFault = p_Address;
+}
+
+int Mira::OrbisOS::Utilities::ProcessReadWriteMemory(struct ::proc* p_Process, void* p_DestAddress, size_t p_Size, void* p_ToReadWriteAddress, size_t* p_ReadWriteSize, bool p_Write)
+{
+    if (p_DestAddress == nullptr || p_ToReadWriteAddress == nullptr)
+        return -EINVAL;
+
+    auto s_Start = reinterpret_cast<uint64_t>(p_DestAddress);
+    if (p_Write && s_WriteFault != 0 && s_WriteFault >= s_Start && s_WriteFault < s_Start + p_Size)
+        return -EFAULT;
+
+    if (p_Write)
+        memcpy(p_DestAddress, p_ToReadWriteAddress, p_Size);
+    else
+        memcpy(p_ToReadWriteAddress, p_DestAddress, p_Size);
+
+    if (p_ReadWriteSize)
+        *p_ReadWriteSize = p_Size;
+
+    return 0;
+}
+
+static const ProcVmMapEntry* s_VmMap = nullptr;
+static size_t s_VmMapCount = 0;
+static uint32_t s_VmMapQueries = 0;
+
+void Mira::Host::SetProcessVmMap(const ProcVmMapEntry* p_Map, size_t p_Count)
+{
+    s_VmMap = p_Map;
+    s_VmMapCount = p_Map == nullptr ? 0 : p_Count;
+    s_VmMapQueries = 0;
+}
+
+uint32_t Mira::Host::GetProcessVmMapQueries()
+{
+    return s_VmMapQueries;
+}
+
+int Mira::OrbisOS::Utilities::QueryProcessVmMap(struct ::proc* p_Process, const VmMapFilter& p_Filter, ProcVmMapEntry* p_Entries, size_t p_MaxEntries, size_t* p_Count)
+{
+    if (p_Count == nullptr || (p_Entries == nullptr && p_MaxEntries != 0))
+        return -EINVAL;
+
+    *p_Count = 0;
+    s_VmMapQueries++;
+
+    if (s_VmMap == nullptr)
+        return -ESRCH;
+
+    // Same walk as VmMapQuery::Collect over the entries instead of a vm_map
+    for (size_t l_Index = 0; l_Index < s_VmMapCount; ++l_Index)
+    {
+        if (p_Filter.End != 0 && s_VmMap[l_Index].start >= p_Filter.End)
+            break;
+
+        if (!VmMapQuery::Matches(&p_Filter, s_VmMap[l_Index]))
+            continue;
+
+        if (*p_Count < p_MaxEntries)
+            p_Entries[*p_Count] = s_VmMap[l_Index];
+
+        (*p_Count)++;
+    }
+
+    return 0;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <Utils/Types.hpp>
+#include <Utils/Kernel.hpp>
+
+namespace Mira
+{
+    namespace Host
+    {
+        // Makes every process memory write covering p_Address fail with EFAULT, 0 lets them all through.
+        // The host tests use it to fail one patch of a PatchSet half way through
+        void SetProcessWriteFault(uint64_t p_Address);
+
+        // The vm map every process has for QueryProcessVmMap, nullptr fails queries with ESRCH.
+        // Resets the number of queries made
+        void SetProcessVmMap(const ProcVmMapEntry* p_Map, size_t p_Count);
+        uint32_t GetProcessVmMapQueries();
+    }
+}
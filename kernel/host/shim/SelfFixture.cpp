@@ -0,0 +1,70 @@
+#include "SelfFixture.hpp"
+
+#include <Plugins/FileManager/SelfDecryptPlan.hpp>
+#include <Utils/Kernel.hpp>
+
+using namespace Mira::Host;
+using namespace Mira::Plugins::FileManagerExtent;
+
+void Mira::Host::InitializeSelfFixture(SelfFixture& p_Self)
+{
+    memset(p_Self.File, 0, sizeof(p_Self.File));
+
+    auto s_Header = GetSelfFixtureHeader(p_Self);
+    s_Header->magic = SelfDecryptPlan_SelfMagic;
+    s_Header->version = 0;
+    s_Header->mode = 1;
+    s_Header->endian = 1;
+    s_Header->attr = 0x12;
+    s_Header->key_type = 0x101;
+    s_Header->header_size = SelfFixture_HeaderSize;
+    s_Header->file_size = SelfFixture_FileSize;
+    s_Header->num_entries = SelfFixture_EntryCount;
+
+    auto s_Ehdr = GetSelfFixtureElfHeader(p_Self);
+    s_Ehdr->e_ident[EI_MAG0] = ELFMAG0;
+    s_Ehdr->e_ident[EI_MAG1] = ELFMAG1;
+    s_Ehdr->e_ident[EI_MAG2] = ELFMAG2;
+    s_Ehdr->e_ident[EI_MAG3] = ELFMAG3;
+    s_Ehdr->e_ident[EI_CLASS] = ELFCLASS64;
+    s_Ehdr->e_ident[EI_DATA] = ELFDATA2LSB;
+    s_Ehdr->e_ident[EI_VERSION] = EV_CURRENT;
+    s_Ehdr->e_type = ET_SCE_DYNAMIC;
+    s_Ehdr->e_machine = EM_X86_64;
+    s_Ehdr->e_phoff = sizeof(Elf64_Ehdr);
+    s_Ehdr->e_shoff = 0x1234000;
+    s_Ehdr->e_ehsize = sizeof(Elf64_Ehdr);
+    s_Ehdr->e_phentsize = sizeof(Elf64_Phdr);
+    s_Ehdr->e_phnum = SelfFixture_PhdrCount;
+    s_Ehdr->e_shentsize = sizeof(Elf64_Shdr);
+    s_Ehdr->e_shnum = 0x20;
+
+    static const struct
+    {
+        uint32_t Type;
+        uint64_t Offset;
+        uint64_t Size;
+    } s_Phdrs[SelfFixture_PhdrCount] =
+    {
+        { PT_LOAD, SelfFixture_TextOffset, SelfFixture_TextSize },
+        { PT_LOAD, SelfFixture_DataOffset, SelfFixture_DataSize },
+        { PT_SCE_RELRO, SelfFixture_DataOffset, 0x1000 },
+        { PT_DYNAMIC, SelfFixture_DynlibOffset, 0x400 },
+        { PT_INTERP, 0, 0 },
+        { PT_SCE_DYNLIBDATA, SelfFixture_DynlibOffset, SelfFixture_DynlibSize },
+        { PT_SCE_PROCPARAM, SelfFixture_DataOffset + 0x100, 0x80 },
+        { PT_GNU_EH_FRAME, SelfFixture_TextOffset + 0x100000, 0x1000 },
+    };
+
+    auto s_Phdr = GetSelfFixtureProgramHeaders(p_Self);
+    for (uint32_t l_Index = 0; l_Index < SelfFixture_PhdrCount; ++l_Index)
+    {
+        s_Phdr[l_Index].p_type = s_Phdrs[l_Index].Type;
+        s_Phdr[l_Index].p_offset = s_Phdrs[l_Index].Offset;
+        s_Phdr[l_Index].p_filesz = s_Phdrs[l_Index].Size;
+        s_Phdr[l_Index].p_memsz = s_Phdrs[l_Index].Size;
+    }
+
+    for (uint32_t l_Index = 0; l_Index < SelfFixture_ElfSize; ++l_Index)
+        p_Self.Decrypted[l_Index] = static_cast<uint8_t>(l_Index * 7);
+}
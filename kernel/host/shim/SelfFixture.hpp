@@ -0,0 +1,60 @@
+#pragma once
+#include <Utils/Types.hpp>
+#include <Plugins/FileManager/FileManagerSelf.hpp>
+
+#include <sys/param.h>
+#include <sys/elf64.h>
+
+namespace Mira
+{
+    namespace Host
+    {
+        enum
+        {
+            // A mid sized sprx: text, data and dynlib data, plus the headers in front of them
+            SelfFixture_TextSize = 0x180000,
+            SelfFixture_DataSize = 0x40000,
+            SelfFixture_DynlibSize = 0x20000,
+
+            SelfFixture_EntryCount = 6,
+            SelfFixture_PhdrCount = 8,
+            SelfFixture_ElfOffset = sizeof(self_header_t) + sizeof(self_entry_t) * SelfFixture_EntryCount,
+            SelfFixture_HeaderSize = 0x1000,
+
+            SelfFixture_TextOffset = 0x4000,
+            SelfFixture_DataOffset = SelfFixture_TextOffset + SelfFixture_TextSize,
+            SelfFixture_DynlibOffset = SelfFixture_DataOffset + SelfFixture_DataSize,
+            SelfFixture_ElfSize = SelfFixture_DynlibOffset + SelfFixture_DynlibSize,
+
+            // Encrypted segments follow the SELF headers, the file is about as large as the output
+            SelfFixture_FileSize = SelfFixture_HeaderSize + SelfFixture_ElfSize,
+
+            // Program header indices, the order is the one the fixture's headers come in
+            SelfFixture_TextPhdr = 0,
+            SelfFixture_DataPhdr = 1,
+            SelfFixture_DynamicPhdr = 3,
+            SelfFixture_DynlibPhdr = 5,
+        };
+
+        /*
+            SelfFixture
+
+            A synthetic SELF for the file manager benchmarks and the SelfDecryptPlan tests: the SELF
+            header and entries, an ELF header with section headers to be cleared, and program headers
+            of every type a sprx has, in file order except for a few that overlap the others.
+        */
+        struct SelfFixture
+        {
+            uint8_t File[SelfFixture_FileSize];
+
+            // Stands in for the MAP_SELF mappings, what the SBL hands back for each segment
+            uint8_t Decrypted[SelfFixture_ElfSize];
+        };
+
+        void InitializeSelfFixture(SelfFixture& p_Self);
+
+        inline self_header_t* GetSelfFixtureHeader(SelfFixture& p_Self) { return reinterpret_cast<self_header_t*>(p_Self.File); }
+        inline Elf64_Ehdr* GetSelfFixtureElfHeader(SelfFixture& p_Self) { return reinterpret_cast<Elf64_Ehdr*>(p_Self.File + SelfFixture_ElfOffset); }
+        inline Elf64_Phdr* GetSelfFixtureProgramHeaders(SelfFixture& p_Self) { return reinterpret_cast<Elf64_Phdr*>(p_Self.File + SelfFixture_ElfOffset + sizeof(Elf64_Ehdr)); }
+    }
+}
@@ -0,0 +1,328 @@
+#include "Tests.hpp"
+
+#include <Utils/HashMap.hpp>
+#include <Utils/ConcurrentHashMap.hpp>
+
+using namespace Mira::Host;
+using namespace Mira::Utils;
+
+enum
+{
+    // Keys of the randomized test, small enough that most operations hit an existing key
+    ContainerTests_RandomKeyCount = 512,
+    ContainerTests_RandomOperations = 200000,
+
+    ContainerTests_GrowthKeyCount = 5000,
+};
+
+// Every key has the same hash, so every entry sits in one probe chain
+struct SameHash
+{
+    uint64_t operator()(const uint64_t&) const { return 0x1234; }
+};
+
+// Home slot is the low nibble, keys that share it collide on purpose
+struct LowNibbleHash
+{
+    uint64_t operator()(const uint64_t& p_Key) const { return p_Key & 0xF; }
+};
+
+// Counts live instances, a slot that is destroyed twice or never shows up here
+struct TrackedValue
+{
+    static int32_t s_Live;
+
+    uint64_t Value;
+
+    explicit TrackedValue(uint64_t p_Value) : Value(p_Value) { s_Live++; }
+    TrackedValue(const TrackedValue& p_Other) : Value(p_Other.Value) { s_Live++; }
+    TrackedValue(TrackedValue&& p_Other) : Value(p_Other.Value) { s_Live++; }
+    ~TrackedValue() { s_Live--; }
+
+    TrackedValue& operator=(const TrackedValue& p_Other) { Value = p_Other.Value; return *this; }
+    TrackedValue& operator=(TrackedValue&& p_Other) { Value = p_Other.Value; return *this; }
+};
+
+int32_t TrackedValue::s_Live = 0;
+
+template <typename THash>
+static void CheckRandomOperations(uint64_t p_Seed)
+{
+    HashMap<uint64_t, uint64_t, THash> s_Map;
+
+    // Reference the map is checked against, indexed by key
+    bool s_Present[ContainerTests_RandomKeyCount] = { };
+    uint64_t s_Values[ContainerTests_RandomKeyCount] = { };
+    uint32_t s_Size = 0;
+
+    uint64_t s_State = p_Seed;
+    for (uint32_t l_Operation = 0; l_Operation < ContainerTests_RandomOperations; ++l_Operation)
+    {
+        auto l_Random = NextRandom(s_State);
+        auto l_Key = (l_Random >> 8) % ContainerTests_RandomKeyCount;
+
+        switch (l_Random & 3)
+        {
+        case 0:
+        case 1:
+        {
+            auto l_Value = l_Random >> 16;
+            MIRA_REQUIRE(s_Map.Insert(l_Key, l_Value));
+
+            if (!s_Present[l_Key])
+                s_Size++;
+
+            s_Present[l_Key] = true;
+            s_Values[l_Key] = l_Value;
+            break;
+        }
+        case 2:
+            MIRA_REQUIRE(s_Map.Remove(l_Key) == s_Present[l_Key]);
+
+            if (s_Present[l_Key])
+                s_Size--;
+
+            s_Present[l_Key] = false;
+            break;
+        default:
+        {
+            auto l_Value = s_Map.Find(l_Key);
+            MIRA_REQUIRE((l_Value != nullptr) == s_Present[l_Key]);
+            if (l_Value != nullptr)
+                MIRA_REQUIRE(*l_Value == s_Values[l_Key]);
+            break;
+        }
+        }
+
+        MIRA_REQUIRE(s_Map.Size() == s_Size);
+    }
+
+    for (uint64_t l_Key = 0; l_Key < ContainerTests_RandomKeyCount; ++l_Key)
+    {
+        auto l_Value = s_Map.Find(l_Key);
+        MIRA_CHECK((l_Value != nullptr) == s_Present[l_Key]);
+        if (l_Value != nullptr)
+            MIRA_CHECK_EQUAL(*l_Value, s_Values[l_Key]);
+    }
+}
+
+void Mira::Host::Test_HashMapCollisions()
+{
+    HashMap<uint64_t, uint64_t, SameHash> s_Map;
+
+    for (uint64_t l_Key = 0; l_Key < 100; ++l_Key)
+        MIRA_REQUIRE(s_Map.Insert(l_Key, l_Key * 3));
+
+    MIRA_CHECK_EQUAL(s_Map.Size(), 100);
+
+    for (uint64_t l_Key = 0; l_Key < 100; ++l_Key)
+    {
+        auto l_Value = s_Map.Find(l_Key);
+        MIRA_REQUIRE(l_Value != nullptr);
+        MIRA_CHECK_EQUAL(*l_Value, l_Key * 3);
+    }
+
+    // Same hash, so only the key compare tells these apart from the chain
+    MIRA_CHECK(s_Map.Find(100) == nullptr);
+    MIRA_CHECK(!s_Map.Remove(1000));
+
+    // Inserting an existing key replaces the value instead of adding a second entry
+    MIRA_CHECK(s_Map.Insert(42, 7));
+    MIRA_CHECK_EQUAL(s_Map.Size(), 100);
+    MIRA_CHECK_EQUAL(*s_Map.Find(42), 7);
+}
+
+void Mira::Host::Test_HashMapRemoveShiftsChain()
+{
+    // Homes 0, 0, 0, 1, 3 and a chain wrapping from slot 15 around to the start of the table
+    static const uint64_t s_Keys[] = { 0x00, 0x10, 0x20, 0x01, 0x03, 0x0F, 0x1F, 0x2F, 0x0E };
+
+    // Remove each key from a full chain once, every other key has to stay reachable
+    for (uint32_t l_Removed = 0; l_Removed < ARRAYSIZE(s_Keys); ++l_Removed)
+    {
+        HashMap<uint64_t, uint64_t, LowNibbleHash> l_Map;
+        MIRA_REQUIRE(l_Map.Reserve(12));
+        MIRA_REQUIRE(l_Map.Capacity() == 16);
+
+        for (uint32_t l_Index = 0; l_Index < ARRAYSIZE(s_Keys); ++l_Index)
+            MIRA_REQUIRE(l_Map.Insert(s_Keys[l_Index], l_Index));
+
+        MIRA_CHECK(l_Map.Remove(s_Keys[l_Removed]));
+        MIRA_CHECK(!l_Map.Remove(s_Keys[l_Removed]));
+        MIRA_CHECK_EQUAL(l_Map.Size(), ARRAYSIZE(s_Keys) - 1);
+
+        for (uint32_t l_Index = 0; l_Index < ARRAYSIZE(s_Keys); ++l_Index)
+        {
+            auto l_Value = l_Map.Find(s_Keys[l_Index]);
+            if (l_Index == l_Removed)
+            {
+                MIRA_CHECK(l_Value == nullptr);
+                continue;
+            }
+
+            MIRA_CHECK(l_Value != nullptr && *l_Value == l_Index);
+        }
+
+        // The slot freed by the shift is usable again
+        MIRA_CHECK(l_Map.Insert(s_Keys[l_Removed], 100));
+        MIRA_CHECK_EQUAL(*l_Map.Find(s_Keys[l_Removed]), 100);
+    }
+
+    // RemoveIf shifts entries into the slot it is looking at, none of them may be skipped
+    HashMap<uint64_t, uint64_t, LowNibbleHash> s_Map;
+    for (uint32_t l_Index = 0; l_Index < ARRAYSIZE(s_Keys); ++l_Index)
+        MIRA_REQUIRE(s_Map.Insert(s_Keys[l_Index], l_Index));
+
+    auto s_Removed = s_Map.RemoveIf([](const uint64_t& p_Key, uint64_t&) { return (p_Key & 0xF) != 0x3; });
+    MIRA_CHECK_EQUAL(s_Removed, ARRAYSIZE(s_Keys) - 1);
+    MIRA_CHECK_EQUAL(s_Map.Size(), 1);
+    MIRA_CHECK(s_Map.Contains(0x03));
+}
+
+void Mira::Host::Test_HashMapRandomOperations()
+{
+    CheckRandomOperations<Hash<uint64_t>>(0x9E3779B97F4A7C15ull);
+    CheckRandomOperations<LowNibbleHash>(0xD1B54A32D192ED03ull);
+}
+
+void Mira::Host::Test_HashMapGrowth()
+{
+    HashMap<uint64_t, uint64_t> s_Map;
+
+    uint32_t s_Capacity = 0;
+    uint32_t s_Grows = 0;
+    for (uint64_t l_Key = 0; l_Key < ContainerTests_GrowthKeyCount; ++l_Key)
+    {
+        MIRA_REQUIRE(s_Map.Insert(l_Key * 0x1000, l_Key));
+
+        // Power of two and never more than 7/8 full
+        auto l_Capacity = s_Map.Capacity();
+        MIRA_REQUIRE((l_Capacity & (l_Capacity - 1)) == 0);
+        MIRA_REQUIRE(static_cast<uint64_t>(s_Map.Size()) * 8 <= static_cast<uint64_t>(l_Capacity) * 7);
+
+        if (l_Capacity != s_Capacity)
+            s_Grows++;
+        s_Capacity = l_Capacity;
+    }
+
+    // Doubling, not a rehash per insert
+    MIRA_CHECK(s_Grows < 16);
+
+    for (uint64_t l_Key = 0; l_Key < ContainerTests_GrowthKeyCount; ++l_Key)
+    {
+        auto l_Value = s_Map.Find(l_Key * 0x1000);
+        MIRA_REQUIRE(l_Value != nullptr);
+        MIRA_CHECK_EQUAL(*l_Value, l_Key);
+    }
+
+    // Reserved room is used without another rehash
+    HashMap<uint64_t, uint64_t> s_Reserved;
+    MIRA_REQUIRE(s_Reserved.Reserve(1000));
+    auto s_ReservedCapacity = s_Reserved.Capacity();
+
+    for (uint64_t l_Key = 0; l_Key < 1000; ++l_Key)
+        MIRA_REQUIRE(s_Reserved.Insert(l_Key, l_Key));
+
+    MIRA_CHECK_EQUAL(s_Reserved.Capacity(), s_ReservedCapacity);
+}
+
+void Mira::Host::Test_HashMapClear()
+{
+    TrackedValue::s_Live = 0;
+
+    {
+        HashMap<uint64_t, TrackedValue> s_Map;
+        for (uint64_t l_Key = 0; l_Key < 200; ++l_Key)
+            MIRA_REQUIRE(s_Map.Insert(l_Key, TrackedValue(l_Key)));
+
+        MIRA_CHECK_EQUAL(TrackedValue::s_Live, 200);
+
+        MIRA_CHECK(s_Map.Remove(7));
+        MIRA_CHECK_EQUAL(TrackedValue::s_Live, 199);
+
+        // Clear destroys every value but keeps the storage
+        auto s_Capacity = s_Map.Capacity();
+        s_Map.Clear();
+
+        MIRA_CHECK_EQUAL(TrackedValue::s_Live, 0);
+        MIRA_CHECK_EQUAL(s_Map.Size(), 0);
+        MIRA_CHECK(s_Map.IsEmpty());
+        MIRA_CHECK_EQUAL(s_Map.Capacity(), s_Capacity);
+
+        for (uint64_t l_Key = 0; l_Key < 200; ++l_Key)
+            MIRA_CHECK(s_Map.Find(l_Key) == nullptr);
+
+        // Usable after a clear, the destructor cleans up whatever is left
+        for (uint64_t l_Key = 0; l_Key < 50; ++l_Key)
+            MIRA_REQUIRE(s_Map.Insert(l_Key + 1000, TrackedValue(l_Key)));
+
+        MIRA_CHECK_EQUAL(s_Map.Size(), 50);
+        MIRA_CHECK_EQUAL(s_Map.Find(1010)->Value, 10);
+        MIRA_CHECK_EQUAL(TrackedValue::s_Live, 50);
+    }
+
+    MIRA_CHECK_EQUAL(TrackedValue::s_Live, 0);
+}
+
+void Mira::Host::Test_HashMapStringKeys()
+{
+    HashMap<const char*, uint32_t, StringHash, StringEqualTo> s_Map;
+
+    MIRA_REQUIRE(s_Map.Insert("libkernel.sprx", 1));
+    MIRA_REQUIRE(s_Map.Insert("libSceLibcInternal.sprx", 2));
+
+    // Keys compare by contents, not by pointer
+    char s_Name[] = "libkernel.sprx";
+    MIRA_CHECK(s_Map.Find(s_Name) != nullptr && *s_Map.Find(s_Name) == 1);
+    MIRA_CHECK(s_Map.Find("libkernel") == nullptr);
+    MIRA_CHECK(s_Map.Find(nullptr) == nullptr);
+
+    MIRA_CHECK(s_Map.Insert(s_Name, 3));
+    MIRA_CHECK_EQUAL(s_Map.Size(), 2);
+    MIRA_CHECK_EQUAL(*s_Map.Find("libkernel.sprx"), 3);
+}
+
+void Mira::Host::Test_ConcurrentHashMap()
+{
+    ConcurrentHashMap<uint64_t, uint64_t> s_Map("MiraTestMap");
+
+    for (uint64_t l_Key = 0; l_Key < 1000; ++l_Key)
+        MIRA_REQUIRE(s_Map.Insert(l_Key, l_Key));
+
+    MIRA_CHECK_EQUAL(s_Map.Size(), 1000);
+
+    uint64_t s_Value = 0;
+    MIRA_CHECK(s_Map.Find(500, s_Value) && s_Value == 500);
+    MIRA_CHECK(!s_Map.Find(5000, s_Value));
+
+    MIRA_CHECK(s_Map.Update(500, [](uint64_t& p_Value) { p_Value += 1; }));
+    MIRA_CHECK(!s_Map.Update(5000, [](uint64_t& p_Value) { p_Value += 1; }));
+    MIRA_CHECK(s_Map.Find(500, s_Value) && s_Value == 501);
+
+    for (uint64_t l_Key = 0; l_Key < 1000; l_Key += 2)
+        MIRA_CHECK(s_Map.Remove(l_Key));
+
+    MIRA_CHECK(!s_Map.Contains(0));
+    MIRA_CHECK(s_Map.Contains(1));
+    MIRA_CHECK_EQUAL(s_Map.Size(), 500);
+
+    // Every stripe is visited, and each key once
+    uint64_t s_Sum = 0;
+    uint32_t s_Count = 0;
+    s_Map.ForEach([&](const uint64_t& p_Key, uint64_t&)
+    {
+        s_Sum += p_Key;
+        s_Count++;
+        return true;
+    });
+
+    MIRA_CHECK_EQUAL(s_Count, 500);
+    MIRA_CHECK_EQUAL(s_Sum, 250000);
+
+    MIRA_CHECK_EQUAL(s_Map.RemoveIf([](const uint64_t& p_Key, uint64_t&) { return p_Key < 100; }), 50);
+    MIRA_CHECK_EQUAL(s_Map.Size(), 450);
+
+    s_Map.Clear();
+    MIRA_CHECK_EQUAL(s_Map.Size(), 0);
+    MIRA_CHECK(!s_Map.Contains(501));
+}
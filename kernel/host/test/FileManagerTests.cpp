@@ -0,0 +1,241 @@
+#include "Tests.hpp"
+#include "../shim/SelfFixture.hpp"
+
+#include <Plugins/FileManager/PathFilter.hpp>
+#include <Plugins/FileManager/SelfDecryptPlan.hpp>
+#include <Utils/Kernel.hpp>
+
+using namespace Mira::Host;
+using namespace Mira::Plugins::FileManagerExtent;
+
+static SelfFixture s_Self;
+
+// Parse changes the header in place, every parse starts from a copy of the file's first bytes
+static uint8_t s_Header[SelfDecryptPlan_MaxHeaderSize];
+
+static SelfDecryptPlan::Status ParseFixture(SelfDecryptPlan& p_Plan, uint64_t p_DataSize, uint64_t p_FileSize)
+{
+    memcpy(s_Header, s_Self.File, p_DataSize);
+    return p_Plan.Parse(s_Header, p_DataSize, p_FileSize);
+}
+
+void Mira::Host::Test_SelfPlanSegments()
+{
+    InitializeSelfFixture(s_Self);
+
+    SelfDecryptPlan s_Plan;
+    MIRA_REQUIRE(ParseFixture(s_Plan, SelfDecryptPlan_InitialHeaderSize, SelfFixture_FileSize) == SelfDecryptPlan::Status::Ok);
+
+    MIRA_CHECK(s_Plan.IsSelf());
+    MIRA_CHECK_EQUAL(s_Plan.GetElfOffset(), SelfFixture_ElfOffset);
+    MIRA_CHECK_EQUAL(s_Plan.GetHeaderSize(), sizeof(Elf64_Ehdr) + sizeof(Elf64_Phdr) * SelfFixture_PhdrCount);
+    MIRA_CHECK_EQUAL(s_Plan.GetElfSize(), SelfFixture_ElfSize);
+
+    // PT_LOAD and PT_SCE_DYNLIBDATA are mapped, PT_DYNAMIC sits inside the dynlib data and everything else is skipped
+    static const struct
+    {
+        uint32_t ProgramHeaderIndex;
+        uint64_t Offset;
+        uint64_t Size;
+    } s_Expected[] =
+    {
+        { SelfFixture_TextPhdr, SelfFixture_TextOffset, SelfFixture_TextSize },
+        { SelfFixture_DataPhdr, SelfFixture_DataOffset, SelfFixture_DataSize },
+        { SelfFixture_DynlibPhdr, SelfFixture_DynlibOffset, SelfFixture_DynlibSize },
+    };
+
+    MIRA_REQUIRE(s_Plan.GetSegmentCount() == ARRAYSIZE(s_Expected));
+    for (uint32_t l_Index = 0; l_Index < ARRAYSIZE(s_Expected); ++l_Index)
+    {
+        auto l_Segment = s_Plan.GetSegment(l_Index);
+        MIRA_CHECK_EQUAL(l_Segment->ProgramHeaderIndex, s_Expected[l_Index].ProgramHeaderIndex);
+        MIRA_CHECK_EQUAL(l_Segment->Offset, s_Expected[l_Index].Offset);
+        MIRA_CHECK_EQUAL(l_Segment->Size, s_Expected[l_Index].Size);
+    }
+
+    MIRA_CHECK(s_Plan.GetSegment(ARRAYSIZE(s_Expected)) == nullptr);
+
+    // The header chunk goes out without section headers
+    auto s_Ehdr = reinterpret_cast<const Elf64_Ehdr*>(s_Header + s_Plan.GetElfOffset());
+    MIRA_CHECK_EQUAL(s_Ehdr->e_shoff, 0);
+    MIRA_CHECK_EQUAL(s_Ehdr->e_shnum, 0);
+    MIRA_CHECK_EQUAL(s_Ehdr->e_phnum, SelfFixture_PhdrCount);
+}
+
+void Mira::Host::Test_SelfPlanSegmentOrder()
+{
+    InitializeSelfFixture(s_Self);
+
+    // Dynlib data first and text last in the program headers, the plan still goes by output offset
+    auto s_Phdrs = GetSelfFixtureProgramHeaders(s_Self);
+    auto s_Text = s_Phdrs[SelfFixture_TextPhdr];
+    s_Phdrs[SelfFixture_TextPhdr] = s_Phdrs[SelfFixture_DynlibPhdr];
+    s_Phdrs[SelfFixture_DynlibPhdr] = s_Text;
+
+    // An empty PT_LOAD has nothing to map
+    s_Phdrs[4].p_type = PT_LOAD;
+    s_Phdrs[4].p_offset = SelfFixture_TextOffset;
+    s_Phdrs[4].p_filesz = 0;
+
+    SelfDecryptPlan s_Plan;
+    MIRA_REQUIRE(ParseFixture(s_Plan, SelfDecryptPlan_InitialHeaderSize, SelfFixture_FileSize) == SelfDecryptPlan::Status::Ok);
+    MIRA_REQUIRE(s_Plan.GetSegmentCount() == 3);
+
+    MIRA_CHECK_EQUAL(s_Plan.GetSegment(0)->ProgramHeaderIndex, SelfFixture_DynlibPhdr);
+    MIRA_CHECK_EQUAL(s_Plan.GetSegment(0)->Offset, SelfFixture_TextOffset);
+    MIRA_CHECK_EQUAL(s_Plan.GetSegment(1)->ProgramHeaderIndex, SelfFixture_DataPhdr);
+    MIRA_CHECK_EQUAL(s_Plan.GetSegment(2)->ProgramHeaderIndex, SelfFixture_TextPhdr);
+    MIRA_CHECK_EQUAL(s_Plan.GetSegment(2)->Offset, SelfFixture_DynlibOffset);
+
+    for (uint32_t l_Index = 1; l_Index < s_Plan.GetSegmentCount(); ++l_Index)
+        MIRA_CHECK(s_Plan.GetSegment(l_Index - 1)->Offset < s_Plan.GetSegment(l_Index)->Offset);
+}
+
+// PT_DYNAMIC is never mapped on its own, but the output has to be large enough to hold it
+void Mira::Host::Test_SelfPlanDynamic()
+{
+    InitializeSelfFixture(s_Self);
+
+    auto s_Phdrs = GetSelfFixtureProgramHeaders(s_Self);
+    s_Phdrs[SelfFixture_DynamicPhdr].p_offset = SelfFixture_ElfSize - 0x100;
+    s_Phdrs[SelfFixture_DynamicPhdr].p_filesz = 0x400;
+
+    SelfDecryptPlan s_Plan;
+    MIRA_REQUIRE(ParseFixture(s_Plan, SelfDecryptPlan_InitialHeaderSize, SelfFixture_FileSize) == SelfDecryptPlan::Status::Ok);
+    MIRA_CHECK_EQUAL(s_Plan.GetElfSize(), SelfFixture_ElfSize + 0x300);
+    MIRA_CHECK_EQUAL(s_Plan.GetSegmentCount(), 3);
+
+    for (uint32_t l_Index = 0; l_Index < s_Plan.GetSegmentCount(); ++l_Index)
+        MIRA_CHECK(s_Plan.GetSegment(l_Index)->ProgramHeaderIndex != SelfFixture_DynamicPhdr);
+
+    // Without the dynlib data the output ends with the data segment, PT_DYNAMIC still counts
+    InitializeSelfFixture(s_Self);
+    s_Phdrs[SelfFixture_DynlibPhdr].p_type = PT_NULL;
+
+    MIRA_REQUIRE(ParseFixture(s_Plan, SelfDecryptPlan_InitialHeaderSize, SelfFixture_FileSize) == SelfDecryptPlan::Status::Ok);
+    MIRA_CHECK_EQUAL(s_Plan.GetSegmentCount(), 2);
+    MIRA_CHECK_EQUAL(s_Plan.GetElfSize(), SelfFixture_DynlibOffset + 0x400);
+}
+
+// Starting from too few bytes, the plan asks for exactly what it is missing until it has the headers
+void Mira::Host::Test_SelfPlanNeedMoreData()
+{
+    InitializeSelfFixture(s_Self);
+
+    SelfDecryptPlan s_Plan;
+    uint64_t s_DataSize = 2;
+    uint32_t s_Reads = 0;
+
+    auto s_Status = ParseFixture(s_Plan, s_DataSize, SelfFixture_FileSize);
+    while (s_Status == SelfDecryptPlan::Status::NeedMoreData && s_Reads < 8)
+    {
+        MIRA_REQUIRE(s_Plan.GetRequiredSize() > s_DataSize);
+        s_DataSize = s_Plan.GetRequiredSize();
+        s_Status = ParseFixture(s_Plan, s_DataSize, SelfFixture_FileSize);
+        s_Reads++;
+    }
+
+    MIRA_REQUIRE(s_Status == SelfDecryptPlan::Status::Ok);
+    MIRA_CHECK_EQUAL(s_DataSize, SelfFixture_ElfOffset + sizeof(Elf64_Ehdr) + sizeof(Elf64_Phdr) * SelfFixture_PhdrCount);
+    MIRA_CHECK_EQUAL(s_Plan.GetSegmentCount(), 3);
+    MIRA_CHECK_EQUAL(s_Plan.GetElfSize(), SelfFixture_ElfSize);
+}
+
+void Mira::Host::Test_SelfPlanPlainElf()
+{
+    InitializeSelfFixture(s_Self);
+
+    // Just the ELF part of the fixture
+    memmove(s_Self.File, s_Self.File + SelfFixture_ElfOffset, SelfFixture_HeaderSize);
+
+    SelfDecryptPlan s_Plan;
+    MIRA_REQUIRE(ParseFixture(s_Plan, SelfDecryptPlan_InitialHeaderSize, SelfFixture_ElfSize) == SelfDecryptPlan::Status::Ok);
+    MIRA_CHECK(!s_Plan.IsSelf());
+    MIRA_CHECK_EQUAL(s_Plan.GetElfSize(), SelfFixture_ElfSize);
+    MIRA_CHECK_EQUAL(s_Plan.GetSegmentCount(), 0);
+}
+
+void Mira::Host::Test_SelfPlanRejects()
+{
+    SelfDecryptPlan s_Plan;
+    auto s_HeadersSize = SelfFixture_ElfOffset + sizeof(Elf64_Ehdr) + sizeof(Elf64_Phdr) * SelfFixture_PhdrCount;
+
+    // Files that end inside the headers
+    InitializeSelfFixture(s_Self);
+    MIRA_CHECK(ParseFixture(s_Plan, 2, 2) == SelfDecryptPlan::Status::Invalid);
+    MIRA_CHECK(ParseFixture(s_Plan, sizeof(self_header_t) - 1, sizeof(self_header_t) - 1) == SelfDecryptPlan::Status::Invalid);
+    MIRA_CHECK(ParseFixture(s_Plan, SelfFixture_ElfOffset + 8, SelfFixture_ElfOffset + 8) == SelfDecryptPlan::Status::Invalid);
+    MIRA_CHECK(ParseFixture(s_Plan, s_HeadersSize - 1, s_HeadersSize - 1) == SelfDecryptPlan::Status::Invalid);
+    MIRA_CHECK(ParseFixture(s_Plan, s_HeadersSize, s_HeadersSize) == SelfDecryptPlan::Status::Ok);
+
+    // More data than the file holds, or none at all
+    MIRA_CHECK(ParseFixture(s_Plan, SelfDecryptPlan_InitialHeaderSize, SelfDecryptPlan_InitialHeaderSize - 1) == SelfDecryptPlan::Status::Invalid);
+    MIRA_CHECK(s_Plan.Parse(nullptr, 0, SelfFixture_FileSize) == SelfDecryptPlan::Status::Invalid);
+
+    // Neither a SELF nor an ELF
+    GetSelfFixtureHeader(s_Self)->magic = 0x1D3D1540;
+    MIRA_CHECK(ParseFixture(s_Plan, SelfDecryptPlan_InitialHeaderSize, SelfFixture_FileSize) == SelfDecryptPlan::Status::Invalid);
+
+    // A SELF around something that is not a 64 bit ELF
+    InitializeSelfFixture(s_Self);
+    GetSelfFixtureElfHeader(s_Self)->e_ident[EI_MAG1] = 'F';
+    MIRA_CHECK(ParseFixture(s_Plan, SelfDecryptPlan_InitialHeaderSize, SelfFixture_FileSize) == SelfDecryptPlan::Status::Invalid);
+
+    InitializeSelfFixture(s_Self);
+    GetSelfFixtureElfHeader(s_Self)->e_ident[EI_CLASS] = ELFCLASS32;
+    MIRA_CHECK(ParseFixture(s_Plan, SelfDecryptPlan_InitialHeaderSize, SelfFixture_FileSize) == SelfDecryptPlan::Status::Invalid);
+
+    // Entries that put the ELF header past anything Parse reads
+    InitializeSelfFixture(s_Self);
+    GetSelfFixtureHeader(s_Self)->num_entries = 0xFFFF;
+    MIRA_CHECK(ParseFixture(s_Plan, SelfDecryptPlan_InitialHeaderSize, SelfFixture_FileSize) == SelfDecryptPlan::Status::Invalid);
+
+    // Program headers past the buffer, past the limit, or not program headers at all
+    InitializeSelfFixture(s_Self);
+    GetSelfFixtureElfHeader(s_Self)->e_phnum = SelfDecryptPlan_MaxProgramHeaders + 1;
+    MIRA_CHECK(ParseFixture(s_Plan, SelfDecryptPlan_InitialHeaderSize, SelfFixture_FileSize) == SelfDecryptPlan::Status::Invalid);
+
+    InitializeSelfFixture(s_Self);
+    GetSelfFixtureElfHeader(s_Self)->e_phnum = SelfDecryptPlan_MaxProgramHeaders;
+    MIRA_CHECK(ParseFixture(s_Plan, s_HeadersSize, s_HeadersSize) == SelfDecryptPlan::Status::Invalid);
+
+    InitializeSelfFixture(s_Self);
+    GetSelfFixtureElfHeader(s_Self)->e_phoff = SelfDecryptPlan_MaxHeaderSize + 1;
+    MIRA_CHECK(ParseFixture(s_Plan, SelfDecryptPlan_InitialHeaderSize, SelfFixture_FileSize) == SelfDecryptPlan::Status::Invalid);
+
+    InitializeSelfFixture(s_Self);
+    GetSelfFixtureElfHeader(s_Self)->e_phoff = 0;
+    MIRA_CHECK(ParseFixture(s_Plan, SelfDecryptPlan_InitialHeaderSize, SelfFixture_FileSize) == SelfDecryptPlan::Status::Invalid);
+
+    InitializeSelfFixture(s_Self);
+    GetSelfFixtureElfHeader(s_Self)->e_phentsize = sizeof(Elf64_Phdr) - 8;
+    MIRA_CHECK(ParseFixture(s_Plan, SelfDecryptPlan_InitialHeaderSize, SelfFixture_FileSize) == SelfDecryptPlan::Status::Invalid);
+
+    // A segment whose end wraps around
+    InitializeSelfFixture(s_Self);
+    GetSelfFixtureProgramHeaders(s_Self)[SelfFixture_DataPhdr].p_filesz = ~0ULL;
+    MIRA_CHECK(ParseFixture(s_Plan, SelfDecryptPlan_InitialHeaderSize, SelfFixture_FileSize) == SelfDecryptPlan::Status::Invalid);
+
+    // Nothing of a rejected parse is left behind
+    MIRA_CHECK(!s_Plan.IsSelf());
+    MIRA_CHECK_EQUAL(s_Plan.GetSegmentCount(), 0);
+    MIRA_CHECK_EQUAL(s_Plan.GetElfSize(), 0);
+}
+
+// Batch outputs are refused when they would land in the tree being walked
+void Mira::Host::Test_PathAtOrBelow()
+{
+    MIRA_CHECK(PathFilter::IsAtOrBelow("/data/dump", "/data/dump"));
+    MIRA_CHECK(PathFilter::IsAtOrBelow("/data/dump/", "/data/dump"));
+    MIRA_CHECK(PathFilter::IsAtOrBelow("/data/dump/out", "/data/dump"));
+    MIRA_CHECK(PathFilter::IsAtOrBelow("/data/dump/out", "/data/dump/"));
+    MIRA_CHECK(PathFilter::IsAtOrBelow("/data/dump", "/"));
+
+    // Sharing a prefix is not enough, the root has to end at a component boundary
+    MIRA_CHECK(!PathFilter::IsAtOrBelow("/data/dumps", "/data/dump"));
+    MIRA_CHECK(!PathFilter::IsAtOrBelow("/data/dump2/out", "/data/dump"));
+    MIRA_CHECK(!PathFilter::IsAtOrBelow("/data", "/data/dump"));
+    MIRA_CHECK(!PathFilter::IsAtOrBelow("/mnt/usb0/dump", "/data/dump"));
+    MIRA_CHECK(!PathFilter::IsAtOrBelow("/data/dump", ""));
+    MIRA_CHECK(!PathFilter::IsAtOrBelow(nullptr, "/data"));
+}
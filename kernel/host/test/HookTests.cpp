@@ -0,0 +1,298 @@
+#include "Tests.hpp"
+
+#include <Utils/HookRelocator.hpp>
+#include <Utils/Kernel.hpp>
+
+extern "C"
+{
+    #include <hde64/hde64.h>
+};
+
+using namespace Mira::Host;
+using namespace Mira::Utils;
+
+enum
+{
+    // Same as HOOK_LENGTH, the size of the absolute jmp that gets written over the target
+    HookTests_HookLength = 14,
+
+    HookTests_TrampolineSize = 128,
+
+    // Functions under test and whatever they reference, trampolines that stay within rel32
+    // reach go to the second half
+    HookTests_CodeSize = 0x20000,
+    HookTests_NearOffset = 0x10000,
+
+    // Trampolines out of rel32 reach, searched for in steps starting 4 GB past the code
+    HookTests_FarSize = 0x10000,
+    HookTests_FarDistance = 0x100000000ull,
+    HookTests_FarStep = 0x10000000ull,
+    HookTests_FarAttempts = 64,
+
+    HookTests_CallOffset = 0x0000,
+    HookTests_CalleeOffset = 0x0800,
+    HookTests_JumpOffset = 0x1000,
+    HookTests_JumpTargetOffset = 0x1800,
+    HookTests_ConditionalOffset = 0x2000,
+    HookTests_LoadOffset = 0x3000,
+    HookTests_LeaOffset = 0x3100,
+    HookTests_DataOffset = 0x3800,
+    HookTests_LoopOffset = 0x4000,
+};
+
+static const uint64_t c_DataValue = 0x1122334455667788ull;
+
+struct HookTestBuffers
+{
+    uint8_t* Code;
+    uint8_t* Far;
+};
+
+static void WriteCode(uint8_t* p_Destination, const uint8_t* p_Code, uint32_t p_Size)
+{
+    memcpy(p_Destination, p_Code, p_Size);
+}
+
+static void WriteRel32(uint8_t* p_Destination, uint64_t p_NextInstruction, uint64_t p_Target)
+{
+    auto s_Displacement = static_cast<int32_t>(static_cast<int64_t>(p_Target - p_NextInstruction));
+    memcpy(p_Destination, &s_Displacement, sizeof(s_Displacement));
+}
+
+// Functions with the prologue shapes the relocator rewrites, each returns its result in eax/rax
+static void WriteFunctions(uint8_t* p_Code)
+{
+    auto s_Base = reinterpret_cast<uint64_t>(p_Code);
+
+    // call callee; 9x nop; add eax, 1; ret. The callee returns 41
+    static const uint8_t s_Call[] = { 0xE8, 0, 0, 0, 0, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x83, 0xC0, 0x01, 0xC3 };
+    static const uint8_t s_Callee[] = { 0xB8, 0x29, 0x00, 0x00, 0x00, 0xC3 };
+    WriteCode(p_Code + HookTests_CallOffset, s_Call, sizeof(s_Call));
+    WriteRel32(p_Code + HookTests_CallOffset + 1, s_Base + HookTests_CallOffset + 5, s_Base + HookTests_CalleeOffset);
+    WriteCode(p_Code + HookTests_CalleeOffset, s_Callee, sizeof(s_Callee));
+
+    // mov eax, 7; 4x nop; jmp target. The target adds 35 and returns
+    static const uint8_t s_Jump[] = { 0xB8, 0x07, 0x00, 0x00, 0x00, 0x90, 0x90, 0x90, 0x90, 0xE9, 0, 0, 0, 0 };
+    static const uint8_t s_JumpTarget[] = { 0x83, 0xC0, 0x23, 0xC3 };
+    WriteCode(p_Code + HookTests_JumpOffset, s_Jump, sizeof(s_Jump));
+    WriteRel32(p_Code + HookTests_JumpOffset + 10, s_Base + HookTests_JumpOffset + 14, s_Base + HookTests_JumpTargetOffset);
+    WriteCode(p_Code + HookTests_JumpTargetOffset, s_JumpTarget, sizeof(s_JumpTarget));
+
+    // xor eax, eax; test edi, edi; je +0x20; mov eax, 1; 3x nop; ret ... +0x26: mov eax, 2; ret
+    static const uint8_t s_Conditional[] = { 0x31, 0xC0, 0x85, 0xFF, 0x74, 0x20, 0xB8, 0x01, 0x00, 0x00, 0x00, 0x90, 0x90, 0x90, 0xC3 };
+    static const uint8_t s_ConditionalTarget[] = { 0xB8, 0x02, 0x00, 0x00, 0x00, 0xC3 };
+    WriteCode(p_Code + HookTests_ConditionalOffset, s_Conditional, sizeof(s_Conditional));
+    WriteCode(p_Code + HookTests_ConditionalOffset + 0x26, s_ConditionalTarget, sizeof(s_ConditionalTarget));
+
+    // mov rax, [rip+data]; 7x nop; ret
+    static const uint8_t s_Load[] = { 0x48, 0x8B, 0x05, 0, 0, 0, 0, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0xC3 };
+    WriteCode(p_Code + HookTests_LoadOffset, s_Load, sizeof(s_Load));
+    WriteRel32(p_Code + HookTests_LoadOffset + 3, s_Base + HookTests_LoadOffset + 7, s_Base + HookTests_DataOffset);
+
+    // lea rax, [rip+data]; 7x nop; ret
+    static const uint8_t s_Lea[] = { 0x48, 0x8D, 0x05, 0, 0, 0, 0, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0xC3 };
+    WriteCode(p_Code + HookTests_LeaOffset, s_Lea, sizeof(s_Lea));
+    WriteRel32(p_Code + HookTests_LeaOffset + 3, s_Base + HookTests_LeaOffset + 7, s_Base + HookTests_DataOffset);
+
+    memcpy(p_Code + HookTests_DataOffset, &c_DataValue, sizeof(c_DataValue));
+
+    // mov ecx, 3; loop -2; 7x nop. loop has no rel32 form, it can not be moved
+    static const uint8_t s_Loop[] = { 0xB9, 0x03, 0x00, 0x00, 0x00, 0xE2, 0xFE, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0xC3 };
+    WriteCode(p_Code + HookTests_LoopOffset, s_Loop, sizeof(s_Loop));
+}
+
+static bool MapBuffers(HookTestBuffers& p_Buffers)
+{
+    p_Buffers.Code = static_cast<uint8_t*>(MiraHost_MapExecutable(0, HookTests_CodeSize));
+    p_Buffers.Far = nullptr;
+    if (p_Buffers.Code == nullptr)
+        return false;
+
+    // Above the code if there is room, below it otherwise
+    auto s_Base = reinterpret_cast<uint64_t>(p_Buffers.Code);
+    for (uint32_t l_Attempt = 0; l_Attempt < HookTests_FarAttempts && p_Buffers.Far == nullptr; ++l_Attempt)
+    {
+        auto l_Distance = HookTests_FarDistance + l_Attempt * HookTests_FarStep;
+        p_Buffers.Far = static_cast<uint8_t*>(MiraHost_MapExecutable(s_Base + l_Distance, HookTests_FarSize));
+        if (p_Buffers.Far == nullptr && s_Base > l_Distance + HookTests_FarSize)
+            p_Buffers.Far = static_cast<uint8_t*>(MiraHost_MapExecutable(s_Base - l_Distance, HookTests_FarSize));
+    }
+
+    if (p_Buffers.Far == nullptr)
+    {
+        MiraHost_Unmap(p_Buffers.Code, HookTests_CodeSize);
+        p_Buffers.Code = nullptr;
+        return false;
+    }
+
+    WriteFunctions(p_Buffers.Code);
+    return true;
+}
+
+static void UnmapBuffers(HookTestBuffers& p_Buffers)
+{
+    MiraHost_Unmap(p_Buffers.Code, HookTests_CodeSize);
+    MiraHost_Unmap(p_Buffers.Far, HookTests_FarSize);
+}
+
+// Moves the hooked prologue of p_Code to p_Trampoline the way Hook::CreateTrampoline does
+static int32_t RelocatePrologue(const uint8_t* p_Code, uint8_t* p_Trampoline)
+{
+    auto s_Length = HookRelocator::GetMinimumLength(p_Code, HookTests_HookLength);
+    if (s_Length < 0)
+        return -1;
+
+    auto s_MaximumSize = HookRelocator::GetMaximumSize(p_Code, reinterpret_cast<uint64_t>(p_Code), s_Length);
+    if (s_MaximumSize < 0 || s_MaximumSize > HookTests_TrampolineSize)
+        return -1;
+
+    memset(p_Trampoline, 0xCC, HookTests_TrampolineSize);
+
+    auto s_Size = HookRelocator::Relocate(p_Code, reinterpret_cast<uint64_t>(p_Code), s_Length, p_Trampoline, reinterpret_cast<uint64_t>(p_Trampoline), HookTests_TrampolineSize);
+
+    // The upper bound is what Hook sizes the trampoline allocation with
+    if (s_Size > s_MaximumSize)
+        return -1;
+
+    return s_Size;
+}
+
+// Target of the first relative branch in p_Code, 0 when there is none
+static uint64_t FindRelativeTarget(const uint8_t* p_Code, uint32_t p_Size, uint8_t& p_Opcode, uint8_t& p_Opcode2)
+{
+    uint32_t s_Offset = 0;
+    while (s_Offset < p_Size)
+    {
+        hde64s l_Info;
+        auto l_Length = hde64_disasm(p_Code + s_Offset, &l_Info);
+        if (l_Length == 0 || (l_Info.flags & F_ERROR))
+            return 0;
+
+        if (l_Info.flags & F_RELATIVE)
+        {
+            p_Opcode = l_Info.opcode;
+            p_Opcode2 = l_Info.opcode2;
+
+            int64_t l_Displacement = (l_Info.flags & F_IMM8) ? static_cast<int8_t>(l_Info.imm.imm8) : static_cast<int32_t>(l_Info.imm.imm32);
+            return reinterpret_cast<uint64_t>(p_Code) + s_Offset + l_Length + l_Displacement;
+        }
+
+        s_Offset += l_Length;
+    }
+
+    return 0;
+}
+
+static uint8_t* GetTrampolines(const HookTestBuffers& p_Buffers, bool p_Far)
+{
+    return p_Far ? p_Buffers.Far : p_Buffers.Code + HookTests_NearOffset;
+}
+
+void Mira::Host::Test_HookRelocateCall()
+{
+    HookTestBuffers s_Buffers;
+    MIRA_REQUIRE(MapBuffers(s_Buffers));
+
+    // Within rel32 reach, then out of it
+    for (uint32_t l_Pass = 0; l_Pass < 2; ++l_Pass)
+    {
+        auto l_Trampoline = GetTrampolines(s_Buffers, l_Pass != 0);
+        MIRA_CHECK(RelocatePrologue(s_Buffers.Code + HookTests_CallOffset, l_Trampoline) > 0);
+
+        // The callee still runs and the call returns into the trampoline, which continues at +14
+        auto l_Function = reinterpret_cast<int32_t(*)()>(l_Trampoline);
+        MIRA_CHECK_EQUAL(l_Function(), 42);
+    }
+
+    UnmapBuffers(s_Buffers);
+}
+
+void Mira::Host::Test_HookRelocateJump()
+{
+    HookTestBuffers s_Buffers;
+    MIRA_REQUIRE(MapBuffers(s_Buffers));
+
+    for (uint32_t l_Pass = 0; l_Pass < 2; ++l_Pass)
+    {
+        auto l_Trampoline = GetTrampolines(s_Buffers, l_Pass != 0);
+        MIRA_CHECK(RelocatePrologue(s_Buffers.Code + HookTests_JumpOffset, l_Trampoline) > 0);
+
+        auto l_Function = reinterpret_cast<int32_t(*)()>(l_Trampoline);
+        MIRA_CHECK_EQUAL(l_Function(), 42);
+    }
+
+    UnmapBuffers(s_Buffers);
+}
+
+void Mira::Host::Test_HookRelocateConditionalJump()
+{
+    HookTestBuffers s_Buffers;
+    MIRA_REQUIRE(MapBuffers(s_Buffers));
+
+    auto s_Code = s_Buffers.Code + HookTests_ConditionalOffset;
+    auto s_Target = reinterpret_cast<uint64_t>(s_Code) + 0x26;
+
+    // Within rel32 reach the je rel8 is widened to je rel32 (0F 84) at the original target
+    auto s_Near = GetTrampolines(s_Buffers, false);
+    auto s_NearSize = RelocatePrologue(s_Code, s_Near);
+    MIRA_REQUIRE(s_NearSize > 0);
+
+    uint8_t s_Opcode = 0;
+    uint8_t s_Opcode2 = 0;
+    MIRA_CHECK_EQUAL(FindRelativeTarget(s_Near, static_cast<uint32_t>(s_NearSize), s_Opcode, s_Opcode2), s_Target);
+    MIRA_CHECK_EQUAL(s_Opcode, 0x0F);
+    MIRA_CHECK_EQUAL(s_Opcode2, 0x84);
+
+    for (uint32_t l_Pass = 0; l_Pass < 2; ++l_Pass)
+    {
+        auto l_Trampoline = GetTrampolines(s_Buffers, l_Pass != 0);
+        MIRA_CHECK(RelocatePrologue(s_Code, l_Trampoline) > 0);
+
+        // Taken and not taken
+        auto l_Function = reinterpret_cast<int32_t(*)(int32_t)>(l_Trampoline);
+        MIRA_CHECK_EQUAL(l_Function(0), 2);
+        MIRA_CHECK_EQUAL(l_Function(1), 1);
+    }
+
+    UnmapBuffers(s_Buffers);
+}
+
+void Mira::Host::Test_HookRelocateRipRelative()
+{
+    HookTestBuffers s_Buffers;
+    MIRA_REQUIRE(MapBuffers(s_Buffers));
+
+    auto s_Data = reinterpret_cast<uint64_t>(s_Buffers.Code + HookTests_DataOffset);
+
+    // Out of disp32 reach the far trampoline only gets these right when the loads became movabs
+    for (uint32_t l_Pass = 0; l_Pass < 2; ++l_Pass)
+    {
+        auto l_Trampoline = GetTrampolines(s_Buffers, l_Pass != 0);
+
+        MIRA_CHECK(RelocatePrologue(s_Buffers.Code + HookTests_LoadOffset, l_Trampoline) > 0);
+        MIRA_CHECK_EQUAL(reinterpret_cast<uint64_t(*)()>(l_Trampoline)(), c_DataValue);
+
+        MIRA_CHECK(RelocatePrologue(s_Buffers.Code + HookTests_LeaOffset, l_Trampoline) > 0);
+        MIRA_CHECK_EQUAL(reinterpret_cast<uint64_t(*)()>(l_Trampoline)(), s_Data);
+    }
+
+    UnmapBuffers(s_Buffers);
+}
+
+void Mira::Host::Test_HookRelocateRejectsLoop()
+{
+    HookTestBuffers s_Buffers;
+    MIRA_REQUIRE(MapBuffers(s_Buffers));
+
+    auto s_Code = s_Buffers.Code + HookTests_LoopOffset;
+    auto s_Length = HookRelocator::GetMinimumLength(s_Code, HookTests_HookLength);
+    MIRA_REQUIRE(s_Length >= HookTests_HookLength);
+
+    uint8_t s_Trampoline[HookTests_TrampolineSize];
+    MIRA_CHECK(HookRelocator::Relocate(s_Code, reinterpret_cast<uint64_t>(s_Code), s_Length, s_Trampoline, reinterpret_cast<uint64_t>(s_Buffers.Far), sizeof(s_Trampoline)) < 0);
+
+    // A ret inside of the hooked range means the function is too short to hook
+    MIRA_CHECK(HookRelocator::GetMinimumLength(s_Buffers.Code + HookTests_CalleeOffset, HookTests_HookLength) < 0);
+
+    UnmapBuffers(s_Buffers);
+}
@@ -0,0 +1,111 @@
+/*
+    Main.c
+
+    Test runner, built against the host libc. Runs every test in g_MiraTests (or the ones whose
+    name contains the filter) and reports each failed check. The exit code is 1 when any test
+    failed, so `make test` can gate CI.
+
+    Usage: MiraTest [-f filter] [-l]
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "Test.h"
+
+static uint32_t s_CurrentFailures;
+
+void MiraHost_TestFailed(const char* p_File, int p_Line, const char* p_Expression)
+{
+    printf("    %s:%d: check failed: %s\n", p_File, p_Line, p_Expression);
+    s_CurrentFailures++;
+}
+
+void MiraHost_TestFailedEqual(const char* p_File, int p_Line, const char* p_Expression, unsigned long long p_Left, unsigned long long p_Right)
+{
+    printf("    %s:%d: check failed: %s (0x%llX != 0x%llX)\n", p_File, p_Line, p_Expression, p_Left, p_Right);
+    s_CurrentFailures++;
+}
+
+void* MiraHost_MapExecutable(uint64_t p_Address, uint64_t p_Size)
+{
+    int s_Flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_FIXED_NOREPLACE
+    if (p_Address != 0)
+        s_Flags |= MAP_FIXED_NOREPLACE;
+#endif
+
+    void* s_Address = mmap((void*)p_Address, p_Size, PROT_READ | PROT_WRITE | PROT_EXEC, s_Flags, -1, 0);
+    if (s_Address == MAP_FAILED)
+        return NULL;
+
+    // Older kernels treat the address as a hint only
+    if (p_Address != 0 && (uint64_t)s_Address != p_Address)
+    {
+        munmap(s_Address, p_Size);
+        return NULL;
+    }
+
+    return s_Address;
+}
+
+void MiraHost_Unmap(void* p_Address, uint64_t p_Size)
+{
+    if (p_Address != NULL)
+        munmap(p_Address, p_Size);
+}
+
+int main(int p_ArgumentCount, char** p_Arguments)
+{
+    const char* s_Filter = NULL;
+    int s_ListOnly = 0;
+
+    int s_Option;
+    while ((s_Option = getopt(p_ArgumentCount, p_Arguments, "f:l")) != -1)
+    {
+        switch (s_Option)
+        {
+        case 'f':
+            s_Filter = optarg;
+            break;
+        case 'l':
+            s_ListOnly = 1;
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-f filter] [-l]\n", p_Arguments[0]);
+            return 2;
+        }
+    }
+
+    uint32_t s_Run = 0;
+    uint32_t s_Failed = 0;
+    for (uint32_t l_Index = 0; l_Index < g_MiraTestCount; ++l_Index)
+    {
+        const struct MiraTest* l_Test = &g_MiraTests[l_Index];
+        if (s_Filter != NULL && strstr(l_Test->Name, s_Filter) == NULL)
+            continue;
+
+        if (s_ListOnly)
+        {
+            printf("%s\n", l_Test->Name);
+            continue;
+        }
+
+        s_CurrentFailures = 0;
+        l_Test->Run();
+
+        printf("%-6s %s\n", s_CurrentFailures == 0 ? "ok" : "FAIL", l_Test->Name);
+        fflush(stdout);
+
+        s_Run++;
+        if (s_CurrentFailures != 0)
+            s_Failed++;
+    }
+
+    if (!s_ListOnly)
+        printf("%u tests, %u failed\n", s_Run, s_Failed);
+
+    return s_Failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,322 @@
+#include "Tests.hpp"
+#include "../shim/HostStubs.hpp"
+
+#include <OrbisOS/PatchSet.hpp>
+#include <OrbisOS/Utilities.hpp>
+
+extern "C"
+{
+    #include <sys/errno.h>
+    #include <sys/mman.h>
+};
+
+using namespace Mira::Host;
+using namespace Mira::OrbisOS;
+
+enum
+{
+    PatchTests_MapCount = 6,
+    PatchTests_TextSize = 0x1000,
+    PatchTests_PatchCount = 4,
+};
+
+static uint8_t s_Text[PatchTests_TextSize];
+static uint8_t s_Module[PatchTests_TextSize];
+static ProcVmMapEntry s_Map[PatchTests_MapCount];
+
+static const uint8_t s_Original[] = { 0xE8, 0x10, 0x20, 0x30, 0x40, 0x90 };
+static const uint8_t s_Replacement[] = { 0xB8, 0x01, 0x00, 0x00, 0x00, 0xC3 };
+
+// Three patches of the executable around one of a module
+static const PatchSetEntry s_Patches[PatchTests_PatchCount] =
+{
+    { "first", nullptr, 0x100, s_Original, s_Replacement, sizeof(s_Replacement) },
+    { "second", nullptr, 0x200, s_Original, s_Replacement, sizeof(s_Replacement) },
+    { "module", "libkernel_sys.sprx", 0x80, s_Original, s_Replacement, sizeof(s_Replacement) },
+    { "last", nullptr, 0x300, s_Original, s_Replacement, sizeof(s_Replacement) },
+};
+
+static void SetMapEntry(uint32_t p_Index, uint64_t p_Start, int p_Prot, const char* p_Name)
+{
+    auto& s_Entry = s_Map[p_Index];
+    memset(&s_Entry, 0, sizeof(s_Entry));
+    s_Entry.start = p_Start;
+    s_Entry.end = p_Start + PatchTests_TextSize;
+    s_Entry.prot = p_Prot;
+    memcpy(s_Entry.name, p_Name, strlen(p_Name) + 1);
+}
+
+// The text of an unpatched process, the module's data mapped before its text like the loader does
+static void SetupPatchProcess()
+{
+    SetMapEntry(0, 0x1000000, PROT_READ | PROT_WRITE, "anon:00000001");
+    SetMapEntry(1, reinterpret_cast<uint64_t>(s_Text), PROT_READ | PROT_EXEC, "executable");
+    SetMapEntry(2, 0x2000000, PROT_READ | PROT_WRITE, "executable");
+    SetMapEntry(3, 0x3000000, PROT_READ | PROT_WRITE, "libkernel_sys.sprx");
+    SetMapEntry(4, reinterpret_cast<uint64_t>(s_Module), PROT_READ | PROT_EXEC, "libkernel_sys.sprx");
+    SetMapEntry(5, 0x4000000, PROT_READ | PROT_WRITE | PROT_EXEC, "libSceLibcInternal.sprx");
+
+    for (uint32_t l_Index = 0; l_Index < PatchTests_TextSize; ++l_Index)
+    {
+        s_Text[l_Index] = static_cast<uint8_t>(l_Index * 13);
+        s_Module[l_Index] = static_cast<uint8_t>(l_Index * 29);
+    }
+
+    for (auto& l_Patch : s_Patches)
+        memcpy((l_Patch.Module == nullptr ? s_Text : s_Module) + l_Patch.Offset, s_Original, sizeof(s_Original));
+
+    SetProcessWriteFault(0);
+}
+
+static uint8_t* GetPatchBytes(uint32_t p_Index)
+{
+    return (s_Patches[p_Index].Module == nullptr ? s_Text : s_Module) + s_Patches[p_Index].Offset;
+}
+
+void Mira::Host::Test_PatchSetFindModule()
+{
+    SetupPatchProcess();
+
+    // The main executable is the first mapping that is exactly r-x
+    MIRA_CHECK_EQUAL(PatchSet::FindModule(s_Map, PatchTests_MapCount, nullptr), reinterpret_cast<uint64_t>(s_Text));
+
+    // By prefix, the data mapping of the module comes first and is skipped
+    MIRA_CHECK_EQUAL(PatchSet::FindModule(s_Map, PatchTests_MapCount, "libkernel_sys.sprx"), reinterpret_cast<uint64_t>(s_Module));
+    MIRA_CHECK_EQUAL(PatchSet::FindModule(s_Map, PatchTests_MapCount, "libkernel"), reinterpret_cast<uint64_t>(s_Module));
+    MIRA_CHECK_EQUAL(PatchSet::FindModule(s_Map, PatchTests_MapCount, "libSceLibcInternal"), 0x4000000);
+
+    MIRA_CHECK_EQUAL(PatchSet::FindModule(s_Map, PatchTests_MapCount, "libSceNet.sprx"), 0);
+    MIRA_CHECK_EQUAL(PatchSet::FindModule(s_Map, PatchTests_MapCount, "anon"), 0);
+    MIRA_CHECK_EQUAL(PatchSet::FindModule(nullptr, PatchTests_MapCount, nullptr), 0);
+    MIRA_CHECK_EQUAL(PatchSet::FindModule(s_Map, 1, nullptr), 0);
+
+    // A module missing from the map fails the whole set before anything is read
+    static const PatchSetEntry s_Missing[] =
+    {
+        { "first", nullptr, 0x100, s_Original, s_Replacement, sizeof(s_Replacement) },
+        { "missing", "libSceNet.sprx", 0x80, s_Original, s_Replacement, sizeof(s_Replacement) },
+    };
+
+    PatchSet s_PatchSet("test", s_Missing, ARRAYSIZE(s_Missing));
+    MIRA_CHECK_EQUAL(s_PatchSet.Apply(nullptr, s_Map, PatchTests_MapCount), -ENOENT);
+    MIRA_CHECK(s_PatchSet.GetStatus(0) == PatchStatus::Pending);
+    MIRA_CHECK(s_PatchSet.GetStatus(1) == PatchStatus::ModuleNotFound);
+    MIRA_CHECK_EQUAL(s_PatchSet.GetAddress(1), 0);
+    MIRA_CHECK(memcmp(GetPatchBytes(0), s_Original, sizeof(s_Original)) == 0);
+}
+
+void Mira::Host::Test_PatchSetVerify()
+{
+    uint8_t s_Current[sizeof(s_Original)];
+
+    memcpy(s_Current, s_Original, sizeof(s_Current));
+    MIRA_CHECK(PatchSet::Verify(s_Patches[0], s_Current) == PatchStatus::Pending);
+
+    memcpy(s_Current, s_Replacement, sizeof(s_Current));
+    MIRA_CHECK(PatchSet::Verify(s_Patches[0], s_Current) == PatchStatus::AlreadyApplied);
+
+    // Only the patched bytes count, one byte off is something else
+    memcpy(s_Current, s_Original, sizeof(s_Current));
+    s_Current[sizeof(s_Current) - 1] ^= 1;
+    MIRA_CHECK(PatchSet::Verify(s_Patches[0], s_Current) == PatchStatus::Mismatch);
+
+    MIRA_CHECK(PatchSet::Verify(s_Patches[0], nullptr) == PatchStatus::Mismatch);
+
+    // Without expected bytes anything that is not the replacement gets written
+    PatchSetEntry s_Unknown = s_Patches[0];
+    s_Unknown.Expected = nullptr;
+    MIRA_CHECK(PatchSet::Verify(s_Unknown, s_Current) == PatchStatus::Pending);
+}
+
+// Every patch is read and checked first, one that does not match stops the set before any write
+void Mira::Host::Test_PatchSetMismatchWritesNothing()
+{
+    SetupPatchProcess();
+    GetPatchBytes(2)[0] = 0xCC;
+
+    static uint8_t s_TextBefore[PatchTests_TextSize];
+    static uint8_t s_ModuleBefore[PatchTests_TextSize];
+    memcpy(s_TextBefore, s_Text, sizeof(s_Text));
+    memcpy(s_ModuleBefore, s_Module, sizeof(s_Module));
+
+    PatchSet s_PatchSet("test", s_Patches, ARRAYSIZE(s_Patches));
+    MIRA_CHECK_EQUAL(s_PatchSet.Apply(nullptr, s_Map, PatchTests_MapCount), -EILSEQ);
+
+    MIRA_CHECK(s_PatchSet.GetStatus(0) == PatchStatus::Pending);
+    MIRA_CHECK(s_PatchSet.GetStatus(1) == PatchStatus::Pending);
+    MIRA_CHECK(s_PatchSet.GetStatus(2) == PatchStatus::Mismatch);
+    MIRA_CHECK(s_PatchSet.GetStatus(3) == PatchStatus::Pending);
+    MIRA_CHECK_EQUAL(s_PatchSet.GetAppliedMask(), 0);
+
+    MIRA_CHECK(memcmp(s_TextBefore, s_Text, sizeof(s_Text)) == 0);
+    MIRA_CHECK(memcmp(s_ModuleBefore, s_Module, sizeof(s_Module)) == 0);
+}
+
+// A write failing half way restores what the set wrote before it
+void Mira::Host::Test_PatchSetWriteFailureRollsBack()
+{
+    SetupPatchProcess();
+
+    static uint8_t s_TextBefore[PatchTests_TextSize];
+    static uint8_t s_ModuleBefore[PatchTests_TextSize];
+    memcpy(s_TextBefore, s_Text, sizeof(s_Text));
+    memcpy(s_ModuleBefore, s_Module, sizeof(s_Module));
+
+    SetProcessWriteFault(reinterpret_cast<uint64_t>(GetPatchBytes(2)) + 1);
+
+    PatchSet s_PatchSet("test", s_Patches, ARRAYSIZE(s_Patches));
+    MIRA_CHECK_EQUAL(s_PatchSet.Apply(nullptr, s_Map, PatchTests_MapCount), -EFAULT);
+
+    SetProcessWriteFault(0);
+
+    MIRA_CHECK(s_PatchSet.GetStatus(0) == PatchStatus::RolledBack);
+    MIRA_CHECK(s_PatchSet.GetStatus(1) == PatchStatus::RolledBack);
+    MIRA_CHECK(s_PatchSet.GetStatus(2) == PatchStatus::WriteFailed);
+    MIRA_CHECK(s_PatchSet.GetStatus(3) == PatchStatus::Pending);
+    MIRA_CHECK_EQUAL(s_PatchSet.GetAppliedMask(), 0);
+
+    MIRA_CHECK(memcmp(s_TextBefore, s_Text, sizeof(s_Text)) == 0);
+    MIRA_CHECK(memcmp(s_ModuleBefore, s_Module, sizeof(s_Module)) == 0);
+
+    // Nothing was left behind, the same set goes through once the write works
+    MIRA_CHECK_EQUAL(s_PatchSet.Apply(nullptr, s_Map, PatchTests_MapCount), 0);
+    MIRA_CHECK_EQUAL(s_PatchSet.GetAppliedMask(), (1u << PatchTests_PatchCount) - 1);
+}
+
+void Mira::Host::Test_PatchSetAppliedMask()
+{
+    SetupPatchProcess();
+
+    // Part of the set is in place from an earlier run, the rest is written
+    memcpy(GetPatchBytes(1), s_Replacement, sizeof(s_Replacement));
+
+    PatchSet s_PatchSet("test", s_Patches, ARRAYSIZE(s_Patches));
+    MIRA_CHECK_EQUAL(s_PatchSet.Apply(nullptr, s_Map, PatchTests_MapCount), 0);
+    MIRA_CHECK(s_PatchSet.GetStatus(0) == PatchStatus::Applied);
+    MIRA_CHECK(s_PatchSet.GetStatus(1) == PatchStatus::AlreadyApplied);
+    MIRA_CHECK(s_PatchSet.GetStatus(2) == PatchStatus::Applied);
+    MIRA_CHECK(s_PatchSet.GetStatus(3) == PatchStatus::Applied);
+    MIRA_CHECK_EQUAL(s_PatchSet.GetAppliedMask(), 0xFu);
+    MIRA_CHECK_EQUAL(s_PatchSet.GetAddress(2), reinterpret_cast<uint64_t>(s_Module) + 0x80);
+
+    for (uint32_t l_Index = 0; l_Index < PatchTests_PatchCount; ++l_Index)
+        MIRA_CHECK(memcmp(GetPatchBytes(l_Index), s_Replacement, sizeof(s_Replacement)) == 0);
+
+    // Again after a resume, everything is found in place
+    MIRA_CHECK_EQUAL(s_PatchSet.Apply(nullptr, s_Map, PatchTests_MapCount), 0);
+    for (uint32_t l_Index = 0; l_Index < PatchTests_PatchCount; ++l_Index)
+        MIRA_CHECK(s_PatchSet.GetStatus(l_Index) == PatchStatus::AlreadyApplied);
+
+    MIRA_CHECK_EQUAL(s_PatchSet.GetAppliedMask(), 0xFu);
+
+    // Only the patches in place count when the set stops part way
+    SetupPatchProcess();
+    memcpy(GetPatchBytes(0), s_Replacement, sizeof(s_Replacement));
+    memcpy(GetPatchBytes(3), s_Replacement, sizeof(s_Replacement));
+    GetPatchBytes(2)[0] = 0xCC;
+
+    MIRA_CHECK_EQUAL(s_PatchSet.Apply(nullptr, s_Map, PatchTests_MapCount), -EILSEQ);
+    MIRA_CHECK_EQUAL(s_PatchSet.GetAppliedMask(), (1u << 0) | (1u << 3));
+
+    MIRA_CHECK(s_PatchSet.GetStatus(PatchTests_PatchCount) == PatchStatus::Pending);
+    MIRA_CHECK_EQUAL(s_PatchSet.GetAddress(PatchTests_PatchCount), 0);
+}
+
+// A table without expected bytes records what it replaced, a restarted process is checked against it
+void Mira::Host::Test_PatchSetRecord()
+{
+    static const PatchSetEntry s_Unknown[] =
+    {
+        { "first", nullptr, 0x100, nullptr, s_Replacement, sizeof(s_Replacement) },
+        { "module", "libkernel_sys.sprx", 0x80, nullptr, s_Replacement, sizeof(s_Replacement) },
+    };
+
+    static PatchSetRecord s_Record;
+    memset(&s_Record, 0, sizeof(s_Record));
+
+    // A set that does not go in is not recorded
+    SetupPatchProcess();
+    SetProcessWriteFault(reinterpret_cast<uint64_t>(s_Module) + 0x80);
+
+    PatchSet s_PatchSet("test", s_Unknown, ARRAYSIZE(s_Unknown), &s_Record);
+    MIRA_CHECK_EQUAL(s_PatchSet.Apply(nullptr, s_Map, PatchTests_MapCount), -EFAULT);
+    MIRA_CHECK_EQUAL(s_Record.RecordedMask, 0);
+
+    SetProcessWriteFault(0);
+    MIRA_CHECK_EQUAL(s_PatchSet.Apply(nullptr, s_Map, PatchTests_MapCount), 0);
+    MIRA_CHECK_EQUAL(s_Record.RecordedMask, 0x3);
+    MIRA_CHECK(memcmp(s_Record.Bytes[0], s_Original, sizeof(s_Original)) == 0);
+    MIRA_CHECK(memcmp(s_Record.Bytes[1], s_Original, sizeof(s_Original)) == 0);
+
+    // Restarted with the same text, the record matches
+    SetupPatchProcess();
+    MIRA_CHECK_EQUAL(s_PatchSet.Apply(nullptr, s_Map, PatchTests_MapCount), 0);
+    MIRA_CHECK_EQUAL(s_PatchSet.GetAppliedMask(), 0x3);
+
+    // Restarted with something else at the module patch, nothing is written
+    SetupPatchProcess();
+    s_Module[0x80] = 0xCC;
+
+    MIRA_CHECK_EQUAL(s_PatchSet.Apply(nullptr, s_Map, PatchTests_MapCount), -EILSEQ);
+    MIRA_CHECK(s_PatchSet.GetStatus(1) == PatchStatus::Mismatch);
+    MIRA_CHECK(memcmp(s_Text + 0x100, s_Original, sizeof(s_Original)) == 0);
+    MIRA_CHECK_EQUAL(s_Module[0x80], 0xCC);
+
+    // Without a record the same bytes would have been overwritten
+    PatchSet s_Unrecorded("test", s_Unknown, ARRAYSIZE(s_Unknown));
+    MIRA_CHECK_EQUAL(s_Unrecorded.Apply(nullptr, s_Map, PatchTests_MapCount), 0);
+    MIRA_CHECK(memcmp(s_Module + 0x80, s_Replacement, sizeof(s_Replacement)) == 0);
+
+    // A recorded set found in place is still in place
+    MIRA_CHECK_EQUAL(s_PatchSet.Apply(nullptr, s_Map, PatchTests_MapCount), 0);
+    MIRA_CHECK(s_PatchSet.GetStatus(0) == PatchStatus::AlreadyApplied);
+    MIRA_CHECK(s_PatchSet.GetStatus(1) == PatchStatus::AlreadyApplied);
+}
+
+// Without a map at hand every module of the table is queried once, for its text only
+void Mira::Host::Test_PatchSetQueriesModules()
+{
+    auto s_Process = reinterpret_cast<struct proc*>(&s_Map);
+
+    SetupPatchProcess();
+    SetProcessVmMap(s_Map, PatchTests_MapCount);
+
+    PatchSet s_PatchSet("test", s_Patches, ARRAYSIZE(s_Patches));
+    MIRA_CHECK_EQUAL(s_PatchSet.Apply(s_Process), 0);
+    MIRA_CHECK_EQUAL(GetProcessVmMapQueries(), 2);
+    MIRA_CHECK_EQUAL(s_PatchSet.GetAppliedMask(), 0xFu);
+    MIRA_CHECK_EQUAL(s_PatchSet.GetAddress(0), reinterpret_cast<uint64_t>(s_Text) + 0x100);
+    MIRA_CHECK_EQUAL(s_PatchSet.GetAddress(2), reinterpret_cast<uint64_t>(s_Module) + 0x80);
+
+    for (uint32_t l_Index = 0; l_Index < PatchTests_PatchCount; ++l_Index)
+        MIRA_CHECK(memcmp(GetPatchBytes(l_Index), s_Replacement, sizeof(s_Replacement)) == 0);
+
+    // The filters pick what FindModule picks from the whole map
+    static const char* s_Modules[] = { nullptr, "libkernel_sys.sprx", "libkernel", "libSceLibcInternal", "libSceNet.sprx", "anon" };
+    for (auto l_Module : s_Modules)
+    {
+        ProcVmMapEntry l_Entry;
+        size_t l_Found = 0;
+
+        auto l_Filter = PatchSet::GetModuleFilter(l_Module);
+        MIRA_CHECK_EQUAL(Mira::OrbisOS::Utilities::QueryProcessVmMap(s_Process, l_Filter, &l_Entry, 1, &l_Found), 0);
+        MIRA_CHECK_EQUAL(l_Found > 0 ? l_Entry.start : 0, PatchSet::FindModule(s_Map, PatchTests_MapCount, l_Module));
+    }
+
+    // A module that is not mapped fails the set like it does with a map at hand
+    static const PatchSetEntry s_Missing[] =
+    {
+        { "first", nullptr, 0x100, s_Replacement, s_Replacement, sizeof(s_Replacement) },
+        { "missing", "libSceNet.sprx", 0x80, s_Original, s_Replacement, sizeof(s_Replacement) },
+        { "again", "libSceNet.sprx", 0x90, s_Original, s_Replacement, sizeof(s_Replacement) },
+    };
+
+    SetProcessVmMap(s_Map, PatchTests_MapCount);
+    PatchSet s_MissingSet("test", s_Missing, ARRAYSIZE(s_Missing));
+    MIRA_CHECK_EQUAL(s_MissingSet.Apply(s_Process), -ENOENT);
+    MIRA_CHECK_EQUAL(GetProcessVmMapQueries(), 2);
+    MIRA_CHECK(s_MissingSet.GetStatus(1) == PatchStatus::ModuleNotFound);
+
+    SetProcessVmMap(nullptr, 0);
+    MIRA_CHECK_EQUAL(s_PatchSet.Apply(s_Process), -ESRCH);
+}
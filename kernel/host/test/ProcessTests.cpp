@@ -0,0 +1,117 @@
+#include "Tests.hpp"
+
+#include <OrbisOS/ProcessIndex.hpp>
+#include <Utils/Kernel.hpp>
+
+using namespace Mira::Host;
+using namespace Mira::OrbisOS;
+
+enum
+{
+    ProcessTests_ProcessCount = 4,
+};
+
+// The index only compares the pointers, they are never dereferenced
+static uint8_t s_Processes[ProcessTests_ProcessCount];
+
+static struct proc* GetTestProcess(uint32_t p_Index)
+{
+    return reinterpret_cast<struct proc*>(&s_Processes[p_Index]);
+}
+
+// Every process with the name, in the order lookups try them
+static uint32_t GetNameOrder(ProcessIndex* p_Index, const char* p_Name, struct proc** p_Order, uint32_t p_MaxCount)
+{
+    uint32_t s_Count = 0;
+    for (auto l_Process = p_Index->FindByName(p_Name); l_Process != nullptr && s_Count < p_MaxCount; l_Process = p_Index->FindByName(p_Name, l_Process))
+        p_Order[s_Count++] = l_Process;
+
+    return s_Count;
+}
+
+void Mira::Host::Test_ProcessIndexSameName()
+{
+    auto s_Index = new ProcessIndex();
+    MIRA_REQUIRE(s_Index != nullptr);
+
+    struct proc* s_Order[ProcessTests_ProcessCount + 1];
+
+    // SceShellCore, a fork child that has not exec'd yet, then a newer SceShellCore exec
+    MIRA_CHECK(s_Index->Insert(GetTestProcess(0), 10, "SceShellCore", true));
+    MIRA_CHECK(s_Index->Insert(GetTestProcess(1), 11, "SceShellCore", false));
+    MIRA_CHECK(s_Index->Insert(GetTestProcess(2), 12, "SceShellCore", true));
+    MIRA_CHECK(s_Index->Insert(GetTestProcess(3), 13, "SceShellUI", true));
+
+    MIRA_CHECK_EQUAL(GetNameOrder(s_Index, "SceShellCore", s_Order, ARRAYSIZE(s_Order)), 3);
+    MIRA_CHECK(s_Order[0] == GetTestProcess(2));
+    MIRA_CHECK(s_Order[1] == GetTestProcess(0));
+    MIRA_CHECK(s_Order[2] == GetTestProcess(1));
+
+    MIRA_CHECK_EQUAL(GetNameOrder(s_Index, "SceShellUI", s_Order, ARRAYSIZE(s_Order)), 1);
+
+    // Continuing after a process that is not indexed under the name finds nothing
+    MIRA_CHECK(s_Index->FindByName("SceShellCore", GetTestProcess(3)) == nullptr);
+    MIRA_CHECK(s_Index->FindByName("SceShellUI", GetTestProcess(3)) == nullptr);
+
+    // The child execs something else and the first one exits
+    MIRA_CHECK(s_Index->Insert(GetTestProcess(1), 11, "eboot.bin", true));
+    MIRA_CHECK(s_Index->Remove(GetTestProcess(0), 10));
+
+    MIRA_CHECK_EQUAL(GetNameOrder(s_Index, "SceShellCore", s_Order, ARRAYSIZE(s_Order)), 1);
+    MIRA_CHECK(s_Order[0] == GetTestProcess(2));
+    MIRA_CHECK(s_Index->FindByName("eboot.bin") == GetTestProcess(1));
+    MIRA_CHECK(s_Index->FindById(11) == GetTestProcess(1));
+    MIRA_CHECK_EQUAL(s_Index->GetCount(), 3);
+
+    delete s_Index;
+}
+
+// Names sharing a bucket are chained together, continuing must skip the other names
+void Mira::Host::Test_ProcessIndexSharedBucket()
+{
+    auto s_Index = new ProcessIndex();
+    MIRA_REQUIRE(s_Index != nullptr);
+
+    // Every process here lands in the same name bucket
+    char s_Names[ProcessTests_ProcessCount][ProcessIndex_NameLength];
+    uint32_t s_NameCount = 0;
+
+    uint32_t s_Bucket = ProcessIndex_BucketCount;
+    for (uint32_t l_Candidate = 0; s_NameCount < 2 && l_Candidate < 26 * 26; ++l_Candidate)
+    {
+        auto& l_Name = s_Names[s_NameCount];
+        memset(l_Name, 0, sizeof(l_Name));
+        l_Name[0] = 'p';
+        l_Name[1] = static_cast<char>('a' + l_Candidate / 26);
+        l_Name[2] = static_cast<char>('a' + l_Candidate % 26);
+
+        // Same FNV-1a as the index
+        uint32_t l_Hash = 0x811C9DC5;
+        for (auto l_Char = l_Name; *l_Char != '\0'; ++l_Char)
+        {
+            l_Hash ^= static_cast<uint8_t>(*l_Char);
+            l_Hash *= 0x01000193;
+        }
+
+        auto l_Bucket = l_Hash & (ProcessIndex_BucketCount - 1);
+        if (s_Bucket == ProcessIndex_BucketCount)
+            s_Bucket = l_Bucket;
+
+        if (l_Bucket == s_Bucket)
+            s_NameCount++;
+    }
+    MIRA_REQUIRE(s_NameCount == 2);
+
+    // a, other, b in chain order
+    MIRA_CHECK(s_Index->Insert(GetTestProcess(0), 20, s_Names[0], false));
+    MIRA_CHECK(s_Index->Insert(GetTestProcess(1), 21, s_Names[1], false));
+    MIRA_CHECK(s_Index->Insert(GetTestProcess(2), 22, s_Names[0], false));
+
+    MIRA_CHECK(s_Index->FindByName(s_Names[0]) == GetTestProcess(0));
+    MIRA_CHECK(s_Index->FindByName(s_Names[0], GetTestProcess(0)) == GetTestProcess(2));
+    MIRA_CHECK(s_Index->FindByName(s_Names[0], GetTestProcess(2)) == nullptr);
+    MIRA_CHECK(s_Index->FindByName(s_Names[1]) == GetTestProcess(1));
+    MIRA_CHECK(s_Index->FindByName(s_Names[1], GetTestProcess(1)) == nullptr);
+
+    delete s_Index;
+}
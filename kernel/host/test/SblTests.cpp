@@ -0,0 +1,153 @@
+#include "Tests.hpp"
+
+#include <OrbisOS/GpuVaIndex.hpp>
+#include <Utils/Kernel.hpp>
+
+extern "C"
+{
+    #include <sys/param.h>
+};
+
+using namespace Mira::Host;
+using namespace Mira::OrbisOS;
+
+enum
+{
+    SblTests_EntryCount = 200,
+
+    SblTests_GpuVaStride = 0x10000,
+    SblTests_GpuVaBase = 0x100000000,
+
+    SblTests_RandomOperations = 100000,
+};
+
+static SblMapListEntry s_Entries[SblTests_EntryCount];
+
+static uint64_t GetTestGpuVa(uint32_t p_Index)
+{
+    return SblTests_GpuVaBase + static_cast<uint64_t>(p_Index) * SblTests_GpuVaStride;
+}
+
+void Mira::Host::Test_GpuVaIndexInsertFindRemove()
+{
+    GpuVaIndex s_Index;
+
+    MIRA_CHECK(s_Index.Find(GetTestGpuVa(1)) == nullptr);
+    MIRA_CHECK(!s_Index.Remove(GetTestGpuVa(1)));
+    MIRA_CHECK(!s_Index.Insert(0, PAGE_SIZE, 1, &s_Entries[0]));
+    MIRA_CHECK(!s_Index.Insert(GetTestGpuVa(1), PAGE_SIZE, 1, nullptr));
+
+    // Inserted out of order, the index sorts them
+    for (uint32_t l_Index = 0; l_Index < SblTests_EntryCount; ++l_Index)
+    {
+        auto l_Slot = (l_Index * 37) % SblTests_EntryCount;
+        MIRA_REQUIRE(s_Index.Insert(GetTestGpuVa(l_Slot + 1), PAGE_SIZE * 2, 1000 + l_Slot, &s_Entries[l_Slot]));
+    }
+
+    MIRA_CHECK_EQUAL(s_Index.GetCount(), SblTests_EntryCount);
+
+    for (uint32_t l_Index = 0; l_Index < SblTests_EntryCount; ++l_Index)
+    {
+        auto l_GpuVa = GetTestGpuVa(l_Index + 1);
+        MIRA_CHECK(s_Index.Find(l_GpuVa) == &s_Entries[l_Index]);
+
+        // Inside the mapping only FindContaining matches, past its end nothing does
+        MIRA_CHECK(s_Index.Find(l_GpuVa + PAGE_SIZE) == nullptr);
+        MIRA_CHECK(s_Index.FindContaining(l_GpuVa + PAGE_SIZE) == &s_Entries[l_Index]);
+        MIRA_CHECK(s_Index.FindContaining(l_GpuVa + PAGE_SIZE * 2) == nullptr);
+    }
+
+    MIRA_CHECK(s_Index.FindContaining(GetTestGpuVa(0)) == nullptr);
+
+    // Every other one by GPU VA, the rest by descriptor
+    for (uint32_t l_Index = 0; l_Index < SblTests_EntryCount; ++l_Index)
+    {
+        if ((l_Index % 2) == 0)
+            MIRA_CHECK(s_Index.Remove(GetTestGpuVa(l_Index + 1)));
+        else
+            MIRA_CHECK(s_Index.RemoveDescriptor(1000 + l_Index));
+
+        MIRA_CHECK(s_Index.Find(GetTestGpuVa(l_Index + 1)) == nullptr);
+        MIRA_CHECK_EQUAL(s_Index.GetCount(), SblTests_EntryCount - l_Index - 1);
+
+        if (l_Index + 1 < SblTests_EntryCount)
+            MIRA_CHECK(s_Index.Find(GetTestGpuVa(l_Index + 2)) == &s_Entries[l_Index + 1]);
+    }
+
+    MIRA_CHECK(!s_Index.RemoveDescriptor(1000));
+}
+
+// A GPU VA the SBL freed and handed out again, the new entry replaces the old one
+void Mira::Host::Test_GpuVaIndexReplace()
+{
+    GpuVaIndex s_Index;
+
+    MIRA_REQUIRE(s_Index.Insert(GetTestGpuVa(1), PAGE_SIZE, 1, &s_Entries[0]));
+    MIRA_REQUIRE(s_Index.Insert(GetTestGpuVa(2), PAGE_SIZE, 2, &s_Entries[1]));
+    MIRA_REQUIRE(s_Index.Insert(GetTestGpuVa(1), PAGE_SIZE * 4, 3, &s_Entries[2]));
+
+    MIRA_CHECK_EQUAL(s_Index.GetCount(), 2);
+    MIRA_CHECK(s_Index.Find(GetTestGpuVa(1)) == &s_Entries[2]);
+    MIRA_CHECK(s_Index.FindContaining(GetTestGpuVa(1) + PAGE_SIZE * 3) == &s_Entries[2]);
+
+    // The old descriptor is gone with the old mapping
+    MIRA_CHECK(!s_Index.RemoveDescriptor(1));
+    MIRA_CHECK(s_Index.RemoveDescriptor(3));
+    MIRA_CHECK(s_Index.Find(GetTestGpuVa(1)) == nullptr);
+    MIRA_CHECK(s_Index.Find(GetTestGpuVa(2)) == &s_Entries[1]);
+
+    s_Index.Clear();
+    MIRA_CHECK_EQUAL(s_Index.GetCount(), 0);
+    MIRA_CHECK(s_Index.Find(GetTestGpuVa(2)) == nullptr);
+
+    // Still usable after Clear
+    MIRA_CHECK(s_Index.Insert(GetTestGpuVa(2), PAGE_SIZE, 2, &s_Entries[1]));
+    MIRA_CHECK(s_Index.Find(GetTestGpuVa(2)) == &s_Entries[1]);
+}
+
+void Mira::Host::Test_GpuVaIndexRandomOperations()
+{
+    GpuVaIndex s_Index;
+
+    // Which entry each GPU VA maps to right now, the reference the index is checked against
+    SblMapListEntry* s_Reference[SblTests_EntryCount] = { nullptr };
+    uint32_t s_Count = 0;
+
+    uint64_t s_Random = 0x9E3779B97F4A7C15ull;
+    for (uint32_t l_Operation = 0; l_Operation < SblTests_RandomOperations; ++l_Operation)
+    {
+        auto l_Slot = static_cast<uint32_t>(NextRandom(s_Random) % SblTests_EntryCount);
+        auto l_GpuVa = GetTestGpuVa(l_Slot + 1);
+
+        switch (NextRandom(s_Random) % 3)
+        {
+        case 0:
+        {
+            auto l_Entry = &s_Entries[NextRandom(s_Random) % SblTests_EntryCount];
+            MIRA_REQUIRE(s_Index.Insert(l_GpuVa, PAGE_SIZE, l_Slot, l_Entry));
+
+            if (s_Reference[l_Slot] == nullptr)
+                s_Count++;
+
+            s_Reference[l_Slot] = l_Entry;
+            break;
+        }
+        case 1:
+            MIRA_CHECK_EQUAL(s_Index.Remove(l_GpuVa), s_Reference[l_Slot] != nullptr);
+            if (s_Reference[l_Slot] != nullptr)
+                s_Count--;
+
+            s_Reference[l_Slot] = nullptr;
+            break;
+        default:
+            MIRA_CHECK(s_Index.Find(l_GpuVa) == s_Reference[l_Slot]);
+            MIRA_CHECK(s_Index.FindContaining(l_GpuVa + PAGE_SIZE - 1) == s_Reference[l_Slot]);
+            break;
+        }
+
+        MIRA_REQUIRE(s_Index.GetCount() == s_Count);
+    }
+
+    for (uint32_t l_Slot = 0; l_Slot < SblTests_EntryCount; ++l_Slot)
+        MIRA_CHECK(s_Index.Find(GetTestGpuVa(l_Slot + 1)) == s_Reference[l_Slot]);
+}
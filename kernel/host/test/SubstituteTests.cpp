@@ -0,0 +1,93 @@
+#include "Tests.hpp"
+
+#include <Plugins/Substitute/NidDatabase.hpp>
+#include <Utils/Kdlsym.hpp>
+#include <Utils/Kernel.hpp>
+
+using namespace Mira::Host;
+using namespace Mira::Plugins;
+
+#include <Plugins/Substitute/NidDatabaseTable.hpp>
+
+static void GetReferenceNid(const char* p_Name, char* p_OutNid)
+{
+    auto name_to_nids = (void(*)(const char *name, const char *nids_out))kdlsym(name_to_nids);
+
+    memset(p_OutNid, 0, NidDatabase_NidSize);
+    name_to_nids(p_Name, p_OutNid);
+}
+
+// Every generated NID has to be what the kernel computes for its name, otherwise a regenerated
+// table with a bad generator would silently hook the wrong symbols
+void Mira::Host::Test_NidTableMatchesNameToNids()
+{
+    MIRA_REQUIRE(ARRAYSIZE(s_NidTableEntries) > 0);
+
+    for (size_t l_Index = 0; l_Index < ARRAYSIZE(s_NidTableEntries); ++l_Index)
+    {
+        auto& l_Entry = s_NidTableEntries[l_Index];
+        MIRA_REQUIRE(l_Entry.NameOffset < sizeof(s_NidTableNames));
+
+        auto l_Name = &s_NidTableNames[l_Entry.NameOffset];
+
+        char l_Nid[NidDatabase_NidSize];
+        GetReferenceNid(l_Name, l_Nid);
+
+        MIRA_CHECK_EQUAL(strlen(l_Entry.Nid), NidDatabase_NidSize - 1);
+        MIRA_CHECK(memcmp(l_Entry.Nid, l_Nid, NidDatabase_NidSize) == 0);
+    }
+}
+
+// FindInTable binary searches, so the names have to be unique and in byte order
+void Mira::Host::Test_NidTableSorted()
+{
+    for (size_t l_Index = 1; l_Index < ARRAYSIZE(s_NidTableEntries); ++l_Index)
+    {
+        auto l_Previous = reinterpret_cast<const uint8_t*>(&s_NidTableNames[s_NidTableEntries[l_Index - 1].NameOffset]);
+        auto l_Current = reinterpret_cast<const uint8_t*>(&s_NidTableNames[s_NidTableEntries[l_Index].NameOffset]);
+
+        while (*l_Previous != '\0' && *l_Previous == *l_Current)
+        {
+            ++l_Previous;
+            ++l_Current;
+        }
+
+        MIRA_CHECK(*l_Previous < *l_Current);
+    }
+
+    for (size_t l_Index = 0; l_Index < ARRAYSIZE(s_NidTableEntries); ++l_Index)
+    {
+        // The table is static, NidDatabase.cpp has its own copy of it
+        auto& l_Entry = s_NidTableEntries[l_Index];
+        auto l_Nid = NidDatabase::FindInTable(&s_NidTableNames[l_Entry.NameOffset]);
+
+        MIRA_REQUIRE(l_Nid != nullptr);
+        MIRA_CHECK(memcmp(l_Nid, l_Entry.Nid, NidDatabase_NidSize) == 0);
+    }
+}
+
+// Names missing from the table go through name_to_nids and the cache, both have to agree with it
+void Mira::Host::Test_NidDatabaseFallback()
+{
+    static const char* s_Names[] = { "sceKernelNotInTheTable", "_ZN3sce2Np9NotATable4NameEv", "x" };
+
+    auto s_Database = new NidDatabase();
+    MIRA_REQUIRE(s_Database != nullptr);
+
+    for (uint32_t l_Pass = 0; l_Pass < 2; ++l_Pass)
+    {
+        for (size_t l_Index = 0; l_Index < ARRAYSIZE(s_Names); ++l_Index)
+        {
+            MIRA_CHECK(NidDatabase::FindInTable(s_Names[l_Index]) == nullptr);
+
+            char l_Expected[NidDatabase_NidSize];
+            GetReferenceNid(s_Names[l_Index], l_Expected);
+
+            char l_Nid[NidDatabase_NidSize];
+            MIRA_CHECK(s_Database->GetNid(s_Names[l_Index], l_Nid));
+            MIRA_CHECK(memcmp(l_Nid, l_Expected, NidDatabase_NidSize) == 0);
+        }
+    }
+
+    delete s_Database;
+}
@@ -0,0 +1,53 @@
+/*
+    Test.h
+
+    Interface between the host tests and their runner, split like bench/Bench.h: tests of Mira
+    sources are built like the rest of Mira, tests of the tools against the host libc, and the
+    runner against the host libc. Only plain C types cross this boundary, include stdint.h or
+    sys/types.h first.
+*/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*MiraTestFunction)(void);
+
+struct MiraTest
+{
+    const char* Name;
+    MiraTestFunction Run;
+};
+
+extern const struct MiraTest g_MiraTests[];
+extern const uint32_t g_MiraTestCount;
+
+// Records a failed check against the running test, implemented by the runner
+void MiraHost_TestFailed(const char* p_File, int p_Line, const char* p_Expression);
+void MiraHost_TestFailedEqual(const char* p_File, int p_Line, const char* p_Expression, unsigned long long p_Left, unsigned long long p_Right);
+
+// Read, write and execute mapping at exactly p_Address (anywhere when 0), NULL when the range
+// is taken. Lets tests place code and trampolines a chosen distance apart
+void* MiraHost_MapExecutable(uint64_t p_Address, uint64_t p_Size);
+void MiraHost_Unmap(void* p_Address, uint64_t p_Size);
+
+#ifdef __cplusplus
+}
+#endif
+
+// Checks keep the test going so one run reports every broken expectation, requires return
+// from the test when the rest of it depends on the condition
+#define MIRA_CHECK(p_Expression) \
+    do { if (!(p_Expression)) MiraHost_TestFailed(__FILE__, __LINE__, #p_Expression); } while (0)
+
+#define MIRA_CHECK_EQUAL(p_Left, p_Right) \
+    do { \
+        unsigned long long l_CheckLeft = (unsigned long long)(p_Left); \
+        unsigned long long l_CheckRight = (unsigned long long)(p_Right); \
+        if (l_CheckLeft != l_CheckRight) \
+            MiraHost_TestFailedEqual(__FILE__, __LINE__, #p_Left " == " #p_Right, l_CheckLeft, l_CheckRight); \
+    } while (0)
+
+#define MIRA_REQUIRE(p_Expression) \
+    do { if (!(p_Expression)) { MiraHost_TestFailed(__FILE__, __LINE__, #p_Expression); return; } } while (0)
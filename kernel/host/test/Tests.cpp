@@ -0,0 +1,55 @@
+#include "Tests.hpp"
+
+using namespace Mira::Host;
+
+extern "C" const struct MiraTest g_MiraTests[] =
+{
+    { "containers/hash_map_collisions", Test_HashMapCollisions },
+    { "containers/hash_map_remove_shifts_chain", Test_HashMapRemoveShiftsChain },
+    { "containers/hash_map_random_operations", Test_HashMapRandomOperations },
+    { "containers/hash_map_growth", Test_HashMapGrowth },
+    { "containers/hash_map_clear", Test_HashMapClear },
+    { "containers/hash_map_string_keys", Test_HashMapStringKeys },
+    { "containers/concurrent_hash_map", Test_ConcurrentHashMap },
+
+    { "filemanager/self_plan_segments", Test_SelfPlanSegments },
+    { "filemanager/self_plan_segment_order", Test_SelfPlanSegmentOrder },
+    { "filemanager/self_plan_dynamic", Test_SelfPlanDynamic },
+    { "filemanager/self_plan_need_more_data", Test_SelfPlanNeedMoreData },
+    { "filemanager/self_plan_plain_elf", Test_SelfPlanPlainElf },
+    { "filemanager/self_plan_rejects", Test_SelfPlanRejects },
+    { "filemanager/path_at_or_below", Test_PathAtOrBelow },
+
+    { "hook/relocate_call", Test_HookRelocateCall },
+    { "hook/relocate_jump", Test_HookRelocateJump },
+    { "hook/relocate_conditional_jump", Test_HookRelocateConditionalJump },
+    { "hook/relocate_rip_relative", Test_HookRelocateRipRelative },
+    { "hook/relocate_rejects_loop", Test_HookRelocateRejectsLoop },
+
+    { "patch/patch_set_find_module", Test_PatchSetFindModule },
+    { "patch/patch_set_verify", Test_PatchSetVerify },
+    { "patch/patch_set_mismatch_writes_nothing", Test_PatchSetMismatchWritesNothing },
+    { "patch/patch_set_write_failure_rolls_back", Test_PatchSetWriteFailureRollsBack },
+    { "patch/patch_set_applied_mask", Test_PatchSetAppliedMask },
+    { "patch/patch_set_record", Test_PatchSetRecord },
+    { "patch/patch_set_queries_modules", Test_PatchSetQueriesModules },
+
+    { "process/index_same_name", Test_ProcessIndexSameName },
+    { "process/index_shared_bucket", Test_ProcessIndexSharedBucket },
+
+    { "sbl/gpu_va_index_insert_find_remove", Test_GpuVaIndexInsertFindRemove },
+    { "sbl/gpu_va_index_replace", Test_GpuVaIndexReplace },
+    { "sbl/gpu_va_index_random_operations", Test_GpuVaIndexRandomOperations },
+
+    { "substitute/nid_table_matches_name_to_nids", Test_NidTableMatchesNameToNids },
+    { "substitute/nid_table_sorted", Test_NidTableSorted },
+    { "substitute/nid_database_fallback", Test_NidDatabaseFallback },
+
+    { "tools/scanner_matches_naive_search", Test_ScannerMatchesNaiveSearch },
+    { "tools/scanner_shared_suffixes", Test_ScannerSharedSuffixes },
+    { "tools/scanner_parse_pattern", Test_ScannerParsePattern },
+    { "tools/kdlsym_resolve_match", Test_KdlsymResolveMatch },
+    { "tools/kdlsym_derive_scan_round_trip", Test_KdlsymDeriveScanRoundTrip },
+};
+
+extern "C" const uint32_t g_MiraTestCount = ARRAYSIZE(g_MiraTests);
@@ -0,0 +1,76 @@
+#pragma once
+#include <Utils/Types.hpp>
+#include "Test.h"
+
+namespace Mira
+{
+    namespace Host
+    {
+        // Cheap deterministic generator, every run checks the same sequence
+        inline uint64_t NextRandom(uint64_t& p_State)
+        {
+            p_State ^= p_State << 13;
+            p_State ^= p_State >> 7;
+            p_State ^= p_State << 17;
+            return p_State;
+        }
+
+        // ContainerTests.cpp
+        void Test_HashMapCollisions();
+        void Test_HashMapRemoveShiftsChain();
+        void Test_HashMapRandomOperations();
+        void Test_HashMapGrowth();
+        void Test_HashMapClear();
+        void Test_HashMapStringKeys();
+        void Test_ConcurrentHashMap();
+
+        // FileManagerTests.cpp
+        void Test_SelfPlanSegments();
+        void Test_SelfPlanSegmentOrder();
+        void Test_SelfPlanDynamic();
+        void Test_SelfPlanNeedMoreData();
+        void Test_SelfPlanPlainElf();
+        void Test_SelfPlanRejects();
+        void Test_PathAtOrBelow();
+
+        // HookTests.cpp
+        void Test_HookRelocateCall();
+        void Test_HookRelocateJump();
+        void Test_HookRelocateConditionalJump();
+        void Test_HookRelocateRipRelative();
+        void Test_HookRelocateRejectsLoop();
+
+        // PatchTests.cpp
+        void Test_PatchSetFindModule();
+        void Test_PatchSetVerify();
+        void Test_PatchSetMismatchWritesNothing();
+        void Test_PatchSetWriteFailureRollsBack();
+        void Test_PatchSetAppliedMask();
+        void Test_PatchSetRecord();
+        void Test_PatchSetQueriesModules();
+
+        // ProcessTests.cpp
+        void Test_ProcessIndexSameName();
+        void Test_ProcessIndexSharedBucket();
+
+        // SblTests.cpp
+        void Test_GpuVaIndexInsertFindRemove();
+        void Test_GpuVaIndexReplace();
+        void Test_GpuVaIndexRandomOperations();
+
+        // SubstituteTests.cpp
+        void Test_NidTableMatchesNameToNids();
+        void Test_NidTableSorted();
+        void Test_NidDatabaseFallback();
+    }
+}
+
+// ToolTests.c, built against the host libc
+extern "C"
+{
+    void Test_ScannerMatchesNaiveSearch(void);
+    void Test_ScannerSharedSuffixes(void);
+    void Test_ScannerParsePattern(void);
+    void Test_KdlsymResolveMatch(void);
+    void Test_KdlsymDeriveScanRoundTrip(void);
+}
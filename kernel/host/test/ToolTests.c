@@ -0,0 +1,399 @@
+/*
+    ToolTests.c
+
+    Tests of the host tools, built against the host libc like the tools themselves.
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Test.h"
+#include "../tools/KdlsymDatabase.h"
+#include "../tools/SignatureScanner.h"
+
+#define TOOL_TESTS_FUZZ_IMAGE_SIZE 0x10000
+#define TOOL_TESTS_FUZZ_ROUNDS 64
+#define TOOL_TESTS_FUZZ_SIGNATURES 32
+#define TOOL_TESTS_FUZZ_MAX_LENGTH 24
+
+#define TOOL_TESTS_IMAGE_SIZE 0x40000
+
+// Same generator as Tests.hpp, the C++ one is not visible from here
+static uint64_t NextRandom(uint64_t* p_State)
+{
+    *p_State ^= *p_State << 13;
+    *p_State ^= *p_State >> 7;
+    *p_State ^= *p_State << 17;
+    return *p_State;
+}
+
+static void FillRandom(uint8_t* p_Data, uint64_t p_Size, uint64_t p_Seed)
+{
+    for (uint64_t l_Index = 0; l_Index < p_Size; ++l_Index)
+        p_Data[l_Index] = (uint8_t)NextRandom(&p_Seed);
+}
+
+// What MiraScanner_Scan has to report, one masked compare at every position
+static void NaiveScan(struct MiraSignature* p_Signature, const uint8_t* p_Image, uint64_t p_ImageSize)
+{
+    p_Signature->MatchCount = 0;
+    p_Signature->FirstMatch = 0;
+    p_Signature->SecondMatch = 0;
+
+    for (uint64_t l_Start = 0; l_Start + p_Signature->Length <= p_ImageSize; ++l_Start)
+    {
+        uint32_t l_Index = 0;
+        for (; l_Index < p_Signature->Length; ++l_Index)
+        {
+            if ((p_Image[l_Start + l_Index] & p_Signature->Mask[l_Index]) != (p_Signature->Bytes[l_Index] & p_Signature->Mask[l_Index]))
+                break;
+        }
+
+        if (l_Index != p_Signature->Length)
+            continue;
+
+        if (p_Signature->MatchCount == 0)
+            p_Signature->FirstMatch = l_Start;
+        else if (p_Signature->MatchCount == 1)
+            p_Signature->SecondMatch = l_Start;
+
+        p_Signature->MatchCount++;
+    }
+}
+
+static void CheckAgainstNaiveScan(struct MiraSignature* p_Signatures, uint32_t p_Count, const uint8_t* p_Image, uint64_t p_ImageSize)
+{
+    struct MiraScanner* s_Scanner = MiraScanner_Create(p_Signatures, p_Count);
+    MIRA_REQUIRE(s_Scanner != NULL);
+
+    MiraScanner_Scan(s_Scanner, p_Image, p_ImageSize);
+
+    for (uint32_t l_Index = 0; l_Index < p_Count; ++l_Index)
+    {
+        struct MiraSignature l_Expected = p_Signatures[l_Index];
+        NaiveScan(&l_Expected, p_Image, p_ImageSize);
+
+        MIRA_CHECK_EQUAL(p_Signatures[l_Index].MatchCount, l_Expected.MatchCount);
+        MIRA_CHECK_EQUAL(p_Signatures[l_Index].FirstMatch, l_Expected.FirstMatch);
+        MIRA_CHECK_EQUAL(p_Signatures[l_Index].SecondMatch, l_Expected.SecondMatch);
+    }
+
+    MiraScanner_Destroy(s_Scanner);
+}
+
+void Test_ScannerMatchesNaiveSearch(void)
+{
+    static uint8_t s_Image[TOOL_TESTS_FUZZ_IMAGE_SIZE];
+    static uint8_t s_Bytes[TOOL_TESTS_FUZZ_SIGNATURES][TOOL_TESTS_FUZZ_MAX_LENGTH];
+    static uint8_t s_Mask[TOOL_TESTS_FUZZ_SIGNATURES][TOOL_TESTS_FUZZ_MAX_LENGTH];
+    struct MiraSignature s_Signatures[TOOL_TESTS_FUZZ_SIGNATURES];
+
+    // Four byte values only, so short signatures match many times and anchors share prefixes and suffixes
+    static const uint8_t s_Alphabet[] = { 0x00, 0x48, 0x8B, 0xE8 };
+
+    uint64_t s_Random = 0x9E3779B97F4A7C15ull;
+    for (uint32_t l_Index = 0; l_Index < TOOL_TESTS_FUZZ_IMAGE_SIZE; ++l_Index)
+        s_Image[l_Index] = s_Alphabet[NextRandom(&s_Random) % sizeof(s_Alphabet)];
+
+    for (uint32_t l_Round = 0; l_Round < TOOL_TESTS_FUZZ_ROUNDS; ++l_Round)
+    {
+        for (uint32_t l_Index = 0; l_Index < TOOL_TESTS_FUZZ_SIGNATURES; ++l_Index)
+        {
+            uint32_t l_Length = 1 + (uint32_t)(NextRandom(&s_Random) % TOOL_TESTS_FUZZ_MAX_LENGTH);
+
+            // Most are taken from the image so they match at least once, the rest are random
+            uint64_t l_Source = NextRandom(&s_Random) % (TOOL_TESTS_FUZZ_IMAGE_SIZE - TOOL_TESTS_FUZZ_MAX_LENGTH);
+            int l_FromImage = (NextRandom(&s_Random) % 4) != 0;
+
+            uint32_t l_Fixed = 0;
+            for (uint32_t l_Byte = 0; l_Byte < l_Length; ++l_Byte)
+            {
+                s_Bytes[l_Index][l_Byte] = l_FromImage ? s_Image[l_Source + l_Byte] : s_Alphabet[NextRandom(&s_Random) % sizeof(s_Alphabet)];
+                s_Mask[l_Index][l_Byte] = (NextRandom(&s_Random) % 4) == 0 ? 0x00 : 0xFF;
+                l_Fixed += s_Mask[l_Index][l_Byte] != 0;
+            }
+
+            // The scanner needs one fixed byte to anchor on
+            if (l_Fixed == 0)
+                s_Mask[l_Index][l_Length - 1] = 0xFF;
+
+            memset(&s_Signatures[l_Index], 0, sizeof(s_Signatures[l_Index]));
+            s_Signatures[l_Index].Name = "fuzz";
+            s_Signatures[l_Index].Bytes = s_Bytes[l_Index];
+            s_Signatures[l_Index].Mask = s_Mask[l_Index];
+            s_Signatures[l_Index].Length = l_Length;
+        }
+
+        CheckAgainstNaiveScan(s_Signatures, TOOL_TESTS_FUZZ_SIGNATURES, s_Image, TOOL_TESTS_FUZZ_IMAGE_SIZE);
+    }
+}
+
+// Anchors that end in the same bytes are reached through dictionary links, identical anchors share a node
+void Test_ScannerSharedSuffixes(void)
+{
+    static const uint8_t s_Image[] =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x03, 0x04, 0x07, 0x09,
+        0x02, 0x03, 0x04, 0x11, 0x09, 0x01, 0x02, 0x03, 0x04, 0x05,
+    };
+
+    static const uint8_t s_Full[] = { 0x00, 0x01, 0x02, 0x03, 0x04 };
+    static const uint8_t s_Long[] = { 0x01, 0x02, 0x03, 0x04 };
+    static const uint8_t s_Middle[] = { 0x02, 0x03, 0x04 };
+    static const uint8_t s_Short[] = { 0x03, 0x04 };
+    static const uint8_t s_Wildcard[] = { 0x03, 0x04, 0x00, 0x09 };
+    static const uint8_t s_WildcardMask[] = { 0xFF, 0xFF, 0x00, 0xFF };
+    static const uint8_t s_Fixed[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+
+    struct MiraSignature s_Signatures[] =
+    {
+        { "long", s_Long, s_Fixed, sizeof(s_Long), 0, 0, 0 },
+        { "middle", s_Middle, s_Fixed, sizeof(s_Middle), 0, 0, 0 },
+        { "short", s_Short, s_Fixed, sizeof(s_Short), 0, 0, 0 },
+        { "wildcard", s_Wildcard, s_WildcardMask, sizeof(s_Wildcard), 0, 0, 0 },
+        { "full", s_Full, s_Fixed, sizeof(s_Full), 0, 0, 0 },
+    };
+
+    CheckAgainstNaiveScan(s_Signatures, sizeof(s_Signatures) / sizeof(s_Signatures[0]), s_Image, sizeof(s_Image));
+
+    MIRA_CHECK_EQUAL(s_Signatures[0].MatchCount, 2);
+    MIRA_CHECK_EQUAL(s_Signatures[0].FirstMatch, 1);
+    MIRA_CHECK_EQUAL(s_Signatures[0].SecondMatch, 15);
+    MIRA_CHECK_EQUAL(s_Signatures[1].MatchCount, 3);
+    MIRA_CHECK_EQUAL(s_Signatures[2].MatchCount, 4);
+    MIRA_CHECK_EQUAL(s_Signatures[2].SecondMatch, 6);
+    MIRA_CHECK_EQUAL(s_Signatures[3].MatchCount, 2);
+    MIRA_CHECK_EQUAL(s_Signatures[3].FirstMatch, 6);
+    MIRA_CHECK_EQUAL(s_Signatures[3].SecondMatch, 11);
+    MIRA_CHECK_EQUAL(s_Signatures[4].MatchCount, 1);
+    MIRA_CHECK_EQUAL(s_Signatures[4].FirstMatch, 0);
+
+    // A match running into the end of the image does not count
+    CheckAgainstNaiveScan(s_Signatures, sizeof(s_Signatures) / sizeof(s_Signatures[0]), s_Image, 8);
+    MIRA_CHECK_EQUAL(s_Signatures[3].MatchCount, 0);
+}
+
+void Test_ScannerParsePattern(void)
+{
+    uint8_t s_Bytes[8];
+    uint8_t s_Mask[8];
+
+    MIRA_CHECK_EQUAL(MiraScanner_ParsePattern("48 8B ?? 05", s_Bytes, s_Mask, sizeof(s_Bytes)), 4);
+    MIRA_CHECK_EQUAL(s_Bytes[0], 0x48);
+    MIRA_CHECK_EQUAL(s_Bytes[1], 0x8B);
+    MIRA_CHECK_EQUAL(s_Bytes[3], 0x05);
+    MIRA_CHECK_EQUAL(s_Mask[0], 0xFF);
+    MIRA_CHECK_EQUAL(s_Mask[2], 0x00);
+    MIRA_CHECK_EQUAL(s_Mask[3], 0xFF);
+
+    // One and two question marks are both one wildcard byte
+    MIRA_CHECK_EQUAL(MiraScanner_ParsePattern("? ?? ?", s_Bytes, s_Mask, sizeof(s_Bytes)), 3);
+    MIRA_CHECK_EQUAL(s_Mask[0] | s_Mask[1] | s_Mask[2], 0x00);
+    MIRA_CHECK_EQUAL(MiraScanner_ParsePattern("48 ? 05", s_Bytes, s_Mask, sizeof(s_Bytes)), 3);
+    MIRA_CHECK_EQUAL(s_Mask[1], 0x00);
+    MIRA_CHECK_EQUAL(s_Bytes[2], 0x05);
+
+    // Bytes are pairs of nibbles, spaces and tabs between them are optional
+    MIRA_CHECK_EQUAL(MiraScanner_ParsePattern("\t488b\tE8  ", s_Bytes, s_Mask, sizeof(s_Bytes)), 3);
+    MIRA_CHECK_EQUAL(s_Bytes[1], 0x8B);
+    MIRA_CHECK_EQUAL(s_Bytes[2], 0xE8);
+
+    // Odd nibble counts and anything that is not hex
+    MIRA_CHECK_EQUAL(MiraScanner_ParsePattern("48 8", s_Bytes, s_Mask, sizeof(s_Bytes)), 0);
+    MIRA_CHECK_EQUAL(MiraScanner_ParsePattern("4 88", s_Bytes, s_Mask, sizeof(s_Bytes)), 0);
+    MIRA_CHECK_EQUAL(MiraScanner_ParsePattern("488", s_Bytes, s_Mask, sizeof(s_Bytes)), 0);
+    MIRA_CHECK_EQUAL(MiraScanner_ParsePattern("48 G8", s_Bytes, s_Mask, sizeof(s_Bytes)), 0);
+    MIRA_CHECK_EQUAL(MiraScanner_ParsePattern("48 ?8", s_Bytes, s_Mask, sizeof(s_Bytes)), 0);
+
+    MIRA_CHECK_EQUAL(MiraScanner_ParsePattern("", s_Bytes, s_Mask, sizeof(s_Bytes)), 0);
+    MIRA_CHECK_EQUAL(MiraScanner_ParsePattern("   ", s_Bytes, s_Mask, sizeof(s_Bytes)), 0);
+    MIRA_CHECK_EQUAL(MiraScanner_ParsePattern(NULL, s_Bytes, s_Mask, sizeof(s_Bytes)), 0);
+    MIRA_CHECK_EQUAL(MiraScanner_ParsePattern("48", NULL, s_Mask, sizeof(s_Bytes)), 0);
+
+    // Exactly the limit fits, one more byte is an invalid pattern rather than a cut off one
+    MIRA_CHECK_EQUAL(MiraScanner_ParsePattern("01 02 03 04", s_Bytes, s_Mask, 4), 4);
+    MIRA_CHECK_EQUAL(MiraScanner_ParsePattern("01 02 03 04 05", s_Bytes, s_Mask, 4), 0);
+    MIRA_CHECK_EQUAL(MiraScanner_ParsePattern("01 02 03 04 ??", s_Bytes, s_Mask, 4), 0);
+}
+
+void Test_KdlsymResolveMatch(void)
+{
+    static uint8_t s_Image[0x400];
+    memset(s_Image, 0xCC, sizeof(s_Image));
+
+    struct MiraKdlsymEntry s_Entry;
+    memset(&s_Entry, 0, sizeof(s_Entry));
+
+    uint64_t s_Offset = 0;
+
+    MIRA_REQUIRE(MiraKdlsym_ParseResolve("+5", &s_Entry));
+    MIRA_CHECK_EQUAL(s_Entry.Resolve, MiraKdlsymResolve_Offset);
+    MIRA_CHECK(MiraKdlsym_ResolveMatch(&s_Entry, s_Image, 0x100, &s_Offset));
+    MIRA_CHECK_EQUAL(s_Offset, 0x105);
+
+    MIRA_REQUIRE(MiraKdlsym_ParseResolve("-0x10", &s_Entry));
+    MIRA_CHECK_EQUAL(s_Entry.Adjust, -0x10);
+    MIRA_CHECK(MiraKdlsym_ResolveMatch(&s_Entry, s_Image, 0x100, &s_Offset));
+    MIRA_CHECK_EQUAL(s_Offset, 0xF0);
+
+    // In front of the image
+    s_Offset = 0x1234;
+    MIRA_CHECK(!MiraKdlsym_ResolveMatch(&s_Entry, s_Image, 0x8, &s_Offset));
+    MIRA_CHECK_EQUAL(s_Offset, 0x1234);
+
+    // mov rax, [rip + disp32], the target is relative to the end of the instruction
+    static const uint8_t s_Forward[] = { 0x48, 0x8B, 0x05, 0x00, 0x10, 0x00, 0x00 };
+    static const uint8_t s_Backward[] = { 0x48, 0x8B, 0x05, 0x00, 0xFF, 0xFF, 0xFF };
+    static const uint8_t s_BeforeImage[] = { 0x48, 0x8B, 0x05, 0x00, 0xFD, 0xFF, 0xFF };
+    memcpy(s_Image + 0x200, s_Forward, sizeof(s_Forward));
+    memcpy(s_Image + 0x300, s_Backward, sizeof(s_Backward));
+    memcpy(s_Image + 0x210, s_BeforeImage, sizeof(s_BeforeImage));
+
+    MIRA_REQUIRE(MiraKdlsym_ParseResolve("rip+3", &s_Entry));
+    MIRA_CHECK_EQUAL(s_Entry.Resolve, MiraKdlsymResolve_RipRelative);
+
+    // Past the end of the dump is fine, data is not part of it
+    MIRA_CHECK(MiraKdlsym_ResolveMatch(&s_Entry, s_Image, 0x200, &s_Offset));
+    MIRA_CHECK_EQUAL(s_Offset, 0x200 + 7 + 0x1000);
+    MIRA_CHECK(MiraKdlsym_ResolveMatch(&s_Entry, s_Image, 0x300, &s_Offset));
+    MIRA_CHECK_EQUAL(s_Offset, 0x300 + 7 - 0x100);
+    MIRA_CHECK(!MiraKdlsym_ResolveMatch(&s_Entry, s_Image, 0x210, &s_Offset));
+
+    MIRA_CHECK(!MiraKdlsym_ParseResolve("5", &s_Entry));
+    MIRA_CHECK(!MiraKdlsym_ParseResolve("+", &s_Entry));
+    MIRA_CHECK(!MiraKdlsym_ParseResolve("+5x", &s_Entry));
+    MIRA_CHECK(!MiraKdlsym_ParseResolve("rip+", &s_Entry));
+    MIRA_CHECK(!MiraKdlsym_ParseResolve("rip+-1", &s_Entry));
+    MIRA_CHECK(!MiraKdlsym_ParseResolve("rip-3", &s_Entry));
+}
+
+static const struct MiraKdlsymEntry* FindKdlsymEntry(const struct MiraKdlsymList* p_List, const char* p_Name)
+{
+    for (uint32_t l_Index = 0; l_Index < p_List->Count; ++l_Index)
+    {
+        if (p_List->Entries[l_Index].Name != NULL && strcmp(p_List->Entries[l_Index].Name, p_Name) == 0)
+            return &p_List->Entries[l_Index];
+    }
+
+    return NULL;
+}
+
+// Output of p_Write as one string, freed by the caller
+#define TOOL_TESTS_CAPTURE(p_Text, p_Ret, p_Write) \
+    do { \
+        size_t l_CaptureSize = 0; \
+        FILE* l_Capture = open_memstream(&(p_Text), &l_CaptureSize); \
+        MIRA_REQUIRE(l_Capture != NULL); \
+        FILE* p_Output = l_Capture; \
+        (p_Ret) = (p_Write); \
+        fclose(l_Capture); \
+        (void)p_Output; \
+    } while (0)
+
+static int ReadFromText(const char* p_Text, int p_Header, struct MiraKdlsymList* p_List)
+{
+    FILE* s_File = fmemopen((void*)p_Text, strlen(p_Text), "r");
+    if (s_File == NULL)
+        return -1;
+
+    int s_Ret = p_Header ? MiraKdlsym_ReadHeader(s_File, p_List) : MiraKdlsym_ReadSignatures(s_File, "test", p_List);
+    fclose(s_File);
+    return s_Ret;
+}
+
+// -d on a firmware with known offsets, then -s of what it derived on the next firmware
+void Test_KdlsymDeriveScanRoundTrip(void)
+{
+    static uint8_t s_Known[TOOL_TESTS_IMAGE_SIZE];
+    static uint8_t s_Next[TOOL_TESTS_IMAGE_SIZE];
+
+    FillRandom(s_Known, sizeof(s_Known), 0x1234);
+
+    // b needs more than the first round of bytes to be unique
+    memcpy(s_Known + 0x30000, s_Known + 0x2000, MIRA_KDLSYM_DERIVE_START);
+
+    // c calls something, the rel32 changes with the firmware
+    static const uint8_t s_Call[] = { 0x55, 0x48, 0x89, 0xE8, 0x10, 0x20, 0x30, 0x40 };
+    memcpy(s_Known + 0x3000, s_Call, sizeof(s_Call));
+
+    // dup is never unique
+    memcpy(s_Known + 0x38000, s_Known + 0x4000, MIRA_KDLSYM_MAX_PATTERN);
+
+    static const char s_KnownHeader[] =
+        "#pragma once\n"
+        "\n"
+        "// Functions\n"
+        "#define kdlsym_addr_a        0x00001000\n"
+        "#define kdlsym_addr_b        0x00002000\n"
+        "#define kdlsym_addr_c        0x00003000\n"
+        "#define kdlsym_addr_dup      0x00004000\n";
+
+    struct MiraKdlsymList s_Header = { 0 };
+    MIRA_REQUIRE(ReadFromText(s_KnownHeader, 1, &s_Header) == 0);
+    MIRA_CHECK_EQUAL(s_Header.Count, 5);
+
+    char* s_Database = NULL;
+    int s_Ret = 0;
+    TOOL_TESTS_CAPTURE(s_Database, s_Ret, MiraKdlsym_WriteSignatures(&s_Header, s_Known, sizeof(s_Known), "known.bin", "known.hpp", p_Output));
+    MiraKdlsym_FreeList(&s_Header);
+
+    MIRA_CHECK_EQUAL(s_Ret, 1);
+    MIRA_REQUIRE(s_Database != NULL);
+    MIRA_CHECK(strstr(s_Database, "# kdlsym_addr_dup not unique") != NULL);
+
+    struct MiraKdlsymList s_Signatures = { 0 };
+    MIRA_CHECK(ReadFromText(s_Database, 0, &s_Signatures) == 0);
+    free(s_Database);
+
+    const struct MiraKdlsymEntry* s_A = FindKdlsymEntry(&s_Signatures, "kdlsym_addr_a");
+    const struct MiraKdlsymEntry* s_B = FindKdlsymEntry(&s_Signatures, "kdlsym_addr_b");
+    const struct MiraKdlsymEntry* s_C = FindKdlsymEntry(&s_Signatures, "kdlsym_addr_c");
+    MIRA_REQUIRE(s_A != NULL && s_B != NULL && s_C != NULL);
+    MIRA_CHECK(FindKdlsymEntry(&s_Signatures, "kdlsym_addr_dup") == NULL);
+
+    MIRA_CHECK_EQUAL(s_A->Length, MIRA_KDLSYM_DERIVE_START);
+    MIRA_CHECK_EQUAL(s_B->Length, MIRA_KDLSYM_DERIVE_START + MIRA_KDLSYM_DERIVE_STEP);
+    MIRA_CHECK_EQUAL(s_C->Mask[3], 0xFF);
+    MIRA_CHECK_EQUAL(s_C->Mask[4] | s_C->Mask[5] | s_C->Mask[6] | s_C->Mask[7], 0x00);
+    MIRA_CHECK_EQUAL(s_C->Mask[8], 0xFF);
+
+    // The next firmware moved every function and c calls somewhere else
+    FillRandom(s_Next, sizeof(s_Next), 0x5678);
+    memcpy(s_Next + 0x1800, s_Known + 0x1000, MIRA_KDLSYM_MAX_PATTERN);
+    memcpy(s_Next + 0x2800, s_Known + 0x2000, MIRA_KDLSYM_MAX_PATTERN);
+    memcpy(s_Next + 0x3800, s_Known + 0x3000, MIRA_KDLSYM_MAX_PATTERN);
+    memset(s_Next + 0x3804, 0x77, 4);
+
+    char* s_Generated = NULL;
+    TOOL_TESTS_CAPTURE(s_Generated, s_Ret, MiraKdlsym_WriteHeader(&s_Signatures, s_Next, sizeof(s_Next), "700", "next.bin", "test.sig", p_Output));
+    MIRA_CHECK_EQUAL(s_Ret, 0);
+    MIRA_REQUIRE(s_Generated != NULL);
+    MIRA_CHECK(strstr(s_Generated, "#if MIRA_PLATFORM==MIRA_PLATFORM_ORBIS_BSD_700") != NULL);
+    MIRA_CHECK(strstr(s_Generated, "// Functions") != NULL);
+
+    struct MiraKdlsymList s_Offsets = { 0 };
+    MIRA_CHECK(ReadFromText(s_Generated, 1, &s_Offsets) == 0);
+    free(s_Generated);
+
+    s_A = FindKdlsymEntry(&s_Offsets, "kdlsym_addr_a");
+    s_B = FindKdlsymEntry(&s_Offsets, "kdlsym_addr_b");
+    s_C = FindKdlsymEntry(&s_Offsets, "kdlsym_addr_c");
+    MIRA_REQUIRE(s_A != NULL && s_B != NULL && s_C != NULL);
+    MIRA_CHECK_EQUAL(s_A->Offset, 0x1800);
+    MIRA_CHECK_EQUAL(s_B->Offset, 0x2800);
+    MIRA_CHECK_EQUAL(s_C->Offset, 0x3800);
+    MiraKdlsym_FreeList(&s_Offsets);
+
+    // A function that appears twice is left out of the header
+    memcpy(s_Next + 0x20000, s_Next + 0x1800, MIRA_KDLSYM_MAX_PATTERN);
+
+    TOOL_TESTS_CAPTURE(s_Generated, s_Ret, MiraKdlsym_WriteHeader(&s_Signatures, s_Next, sizeof(s_Next), "700", "next.bin", "test.sig", p_Output));
+    MIRA_CHECK_EQUAL(s_Ret, 1);
+    MIRA_REQUIRE(s_Generated != NULL);
+    MIRA_CHECK(strstr(s_Generated, "// kdlsym_addr_a ambiguous, 2 matches") != NULL);
+    MIRA_CHECK(strstr(s_Generated, "#define kdlsym_addr_b") != NULL);
+    free(s_Generated);
+
+    MiraKdlsym_FreeList(&s_Signatures);
+}
@@ -0,0 +1,396 @@
+/*
+    KdlsymDatabase.c
+
+    Reading and writing of signature databases and Kdlsym headers, the scanning itself is
+    SignatureScanner's.
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "KdlsymDatabase.h"
+#include "SignatureScanner.h"
+
+struct MiraKdlsymEntry* MiraKdlsym_AddEntry(struct MiraKdlsymList* p_List)
+{
+    if (p_List->Count == p_List->Capacity)
+    {
+        uint32_t s_Capacity = p_List->Capacity == 0 ? 256 : p_List->Capacity * 2;
+        struct MiraKdlsymEntry* s_Entries = realloc(p_List->Entries, s_Capacity * sizeof(*s_Entries));
+        if (s_Entries == NULL)
+            return NULL;
+
+        p_List->Entries = s_Entries;
+        p_List->Capacity = s_Capacity;
+    }
+
+    struct MiraKdlsymEntry* s_Entry = &p_List->Entries[p_List->Count++];
+    memset(s_Entry, 0, sizeof(*s_Entry));
+    return s_Entry;
+}
+
+void MiraKdlsym_FreeList(struct MiraKdlsymList* p_List)
+{
+    for (uint32_t l_Index = 0; l_Index < p_List->Count; ++l_Index)
+    {
+        free(p_List->Entries[l_Index].Comment);
+        free(p_List->Entries[l_Index].Name);
+    }
+
+    free(p_List->Entries);
+    memset(p_List, 0, sizeof(*p_List));
+}
+
+static char* TrimLine(char* p_Line)
+{
+    while (*p_Line == ' ' || *p_Line == '\t')
+        p_Line++;
+
+    size_t s_Length = strlen(p_Line);
+    while (s_Length > 0 && (p_Line[s_Length - 1] == '\n' || p_Line[s_Length - 1] == '\r' || p_Line[s_Length - 1] == ' ' || p_Line[s_Length - 1] == '\t'))
+        p_Line[--s_Length] = '\0';
+
+    return p_Line;
+}
+
+int MiraKdlsym_ParseResolve(const char* p_Text, struct MiraKdlsymEntry* p_Entry)
+{
+    char* s_End = NULL;
+
+    if (strncmp(p_Text, "rip+", 4) == 0)
+    {
+        p_Entry->Resolve = MiraKdlsymResolve_RipRelative;
+        p_Entry->Adjust = strtoll(p_Text + 4, &s_End, 0);
+        return *s_End == '\0' && s_End != p_Text + 4 && p_Entry->Adjust >= 0;
+    }
+
+    if (p_Text[0] != '+' && p_Text[0] != '-')
+        return 0;
+
+    p_Entry->Resolve = MiraKdlsymResolve_Offset;
+    p_Entry->Adjust = strtoll(p_Text, &s_End, 0);
+    return *s_End == '\0' && s_End != p_Text + 1;
+}
+
+int MiraKdlsym_ResolveMatch(const struct MiraKdlsymEntry* p_Entry, const uint8_t* p_Image, uint64_t p_Match, uint64_t* p_Offset)
+{
+    int64_t s_Offset = (int64_t)p_Match + p_Entry->Adjust;
+
+    if (p_Entry->Resolve == MiraKdlsymResolve_RipRelative)
+    {
+        int32_t s_Displacement = 0;
+        memcpy(&s_Displacement, p_Image + s_Offset, sizeof(s_Displacement));
+        s_Offset += (int64_t)sizeof(s_Displacement) + s_Displacement;
+    }
+
+    // Data symbols may sit past the end of a dump of the text, only negative offsets are wrong
+    if (s_Offset < 0)
+        return 0;
+
+    *p_Offset = (uint64_t)s_Offset;
+    return 1;
+}
+
+int MiraKdlsym_ReadSignatures(FILE* p_File, const char* p_Name, struct MiraKdlsymList* p_List)
+{
+    char s_Buffer[MIRA_KDLSYM_MAX_LINE];
+    uint32_t s_LineNumber = 0;
+
+    while (fgets(s_Buffer, sizeof(s_Buffer), p_File) != NULL)
+    {
+        s_LineNumber++;
+
+        char* l_Line = TrimLine(s_Buffer);
+        if (l_Line[0] == '\0' || l_Line[0] == '#')
+            continue;
+
+        struct MiraKdlsymEntry* l_Entry = MiraKdlsym_AddEntry(p_List);
+        if (l_Entry == NULL)
+            return -1;
+
+        if (strncmp(l_Line, "//", 2) == 0)
+        {
+            l_Entry->Comment = strdup(l_Line);
+            continue;
+        }
+
+        char* l_Name = strtok(l_Line, " \t");
+        char* l_Resolve = strtok(NULL, " \t");
+        char* l_Pattern = strtok(NULL, "");
+
+        if (l_Name == NULL || l_Resolve == NULL || l_Pattern == NULL || !MiraKdlsym_ParseResolve(l_Resolve, l_Entry))
+        {
+            fprintf(stderr, "%s:%u: expected <name> <resolve> <pattern>\n", p_Name, s_LineNumber);
+            return -1;
+        }
+
+        l_Entry->Name = strdup(l_Name);
+        l_Entry->Length = MiraScanner_ParsePattern(l_Pattern, l_Entry->Bytes, l_Entry->Mask, MIRA_KDLSYM_MAX_PATTERN);
+        if (l_Entry->Length == 0)
+        {
+            fprintf(stderr, "%s:%u: invalid pattern for (%s)\n", p_Name, s_LineNumber, l_Name);
+            return -1;
+        }
+
+        if (l_Entry->Resolve == MiraKdlsymResolve_RipRelative && l_Entry->Adjust + 4 > l_Entry->Length)
+        {
+            fprintf(stderr, "%s:%u: disp32 of (%s) is past the end of the pattern\n", p_Name, s_LineNumber, l_Name);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int MiraKdlsym_ReadHeader(FILE* p_File, struct MiraKdlsymList* p_List)
+{
+    char s_Buffer[MIRA_KDLSYM_MAX_LINE];
+    while (fgets(s_Buffer, sizeof(s_Buffer), p_File) != NULL)
+    {
+        char* l_Line = TrimLine(s_Buffer);
+        if (strncmp(l_Line, "//", 2) == 0 && strlen(l_Line) > 2)
+        {
+            struct MiraKdlsymEntry* l_Entry = MiraKdlsym_AddEntry(p_List);
+            if (l_Entry == NULL)
+                return -1;
+
+            l_Entry->Comment = strdup(l_Line);
+            continue;
+        }
+
+        if (strncmp(l_Line, "#define", 7) != 0)
+            continue;
+
+        char* l_Name = strtok(l_Line + 7, " \t");
+        char* l_Value = strtok(NULL, " \t()");
+        if (l_Name == NULL || l_Value == NULL)
+            continue;
+
+        char* l_End = NULL;
+        uint64_t l_Offset = strtoull(l_Value, &l_End, 0);
+        if (*l_End != '\0' || l_End == l_Value)
+            continue;
+
+        struct MiraKdlsymEntry* l_Entry = MiraKdlsym_AddEntry(p_List);
+        if (l_Entry == NULL)
+            return -1;
+
+        l_Entry->Name = strdup(l_Name);
+        l_Entry->Offset = l_Offset;
+        l_Entry->Resolve = MiraKdlsymResolve_Offset;
+    }
+
+    return 0;
+}
+
+// Signatures for every non comment entry of p_List, in order
+static struct MiraSignature* GetSignatures(const struct MiraKdlsymList* p_List, uint32_t* p_Count)
+{
+    struct MiraSignature* s_Signatures = calloc(p_List->Count + 1, sizeof(*s_Signatures));
+    if (s_Signatures == NULL)
+        return NULL;
+
+    uint32_t s_Count = 0;
+    for (uint32_t l_Index = 0; l_Index < p_List->Count; ++l_Index)
+    {
+        const struct MiraKdlsymEntry* l_Entry = &p_List->Entries[l_Index];
+        if (l_Entry->Name == NULL)
+            continue;
+
+        s_Signatures[s_Count].Name = l_Entry->Name;
+        s_Signatures[s_Count].Bytes = l_Entry->Bytes;
+        s_Signatures[s_Count].Mask = l_Entry->Mask;
+        s_Signatures[s_Count].Length = l_Entry->Length;
+        s_Count++;
+    }
+
+    *p_Count = s_Count;
+    return s_Signatures;
+}
+
+int MiraKdlsym_WriteHeader(const struct MiraKdlsymList* p_List, const uint8_t* p_Image, uint64_t p_ImageSize, const char* p_Platform, const char* p_ImageName, const char* p_DatabaseName, FILE* p_Output)
+{
+    uint32_t s_SignatureCount = 0;
+    struct MiraSignature* s_Signatures = GetSignatures(p_List, &s_SignatureCount);
+    if (s_Signatures == NULL || s_SignatureCount == 0)
+    {
+        fprintf(stderr, "no signatures in (%s)\n", p_DatabaseName);
+        free(s_Signatures);
+        return 2;
+    }
+
+    struct MiraScanner* s_Scanner = MiraScanner_Create(s_Signatures, s_SignatureCount);
+    if (s_Scanner == NULL)
+    {
+        fprintf(stderr, "could not build the scanner, every signature needs fixed bytes\n");
+        free(s_Signatures);
+        return 2;
+    }
+
+    MiraScanner_Scan(s_Scanner, p_Image, p_ImageSize);
+
+    fprintf(p_Output, "#pragma once\n\n#include <Boot/Config.hpp>\n\n");
+    fprintf(p_Output, "// Generated by KdlsymScan from %s with %s\n", p_ImageName, p_DatabaseName);
+    fprintf(p_Output, "#if MIRA_PLATFORM==MIRA_PLATFORM_ORBIS_BSD_%s\n", p_Platform);
+
+    uint32_t s_Found = 0;
+    uint32_t s_Missing = 0;
+    uint32_t s_Ambiguous = 0;
+
+    uint32_t s_Signature = 0;
+    for (uint32_t l_Index = 0; l_Index < p_List->Count; ++l_Index)
+    {
+        const struct MiraKdlsymEntry* l_Entry = &p_List->Entries[l_Index];
+        if (l_Entry->Name == NULL)
+        {
+            fprintf(p_Output, "\n%s\n", l_Entry->Comment);
+            continue;
+        }
+
+        struct MiraSignature* l_Signature = &s_Signatures[s_Signature++];
+
+        uint64_t l_Offset = 0;
+        if (l_Signature->MatchCount == 0 || !MiraKdlsym_ResolveMatch(l_Entry, p_Image, l_Signature->FirstMatch, &l_Offset))
+        {
+            fprintf(stderr, "missing: %s\n", l_Entry->Name);
+            fprintf(p_Output, "// %s not found\n", l_Entry->Name);
+            s_Missing++;
+            continue;
+        }
+
+        if (l_Signature->MatchCount > 1)
+        {
+            fprintf(stderr, "ambiguous: %s, %u matches (0x%llX, 0x%llX, ...)\n", l_Entry->Name, l_Signature->MatchCount,
+                (unsigned long long)l_Signature->FirstMatch, (unsigned long long)l_Signature->SecondMatch);
+            fprintf(p_Output, "// %s ambiguous, %u matches\n", l_Entry->Name, l_Signature->MatchCount);
+            s_Ambiguous++;
+            continue;
+        }
+
+        fprintf(p_Output, "#define %-50s 0x%08llX\n", l_Entry->Name, (unsigned long long)l_Offset);
+        s_Found++;
+    }
+
+    fprintf(p_Output, "\n#endif\n");
+
+    fprintf(stderr, "%u found, %u missing, %u ambiguous\n", s_Found, s_Missing, s_Ambiguous);
+
+    MiraScanner_Destroy(s_Scanner);
+    free(s_Signatures);
+
+    return (s_Missing + s_Ambiguous) == 0 ? 0 : 1;
+}
+
+// Copies p_Length bytes from the image, rel32 operands of call and jmp differ between builds
+static void FillDerivedPattern(struct MiraKdlsymEntry* p_Entry, const uint8_t* p_Image, uint32_t p_Length)
+{
+    memcpy(p_Entry->Bytes, p_Image + p_Entry->Offset, p_Length);
+    memset(p_Entry->Mask, 0xFF, p_Length);
+
+    for (uint32_t l_Index = 1; l_Index + 4 < p_Length; ++l_Index)
+    {
+        if (p_Entry->Bytes[l_Index] != 0xE8 && p_Entry->Bytes[l_Index] != 0xE9)
+            continue;
+
+        memset(&p_Entry->Mask[l_Index + 1], 0, 4);
+        l_Index += 4;
+    }
+
+    p_Entry->Length = p_Length;
+}
+
+int MiraKdlsym_WriteSignatures(struct MiraKdlsymList* p_List, const uint8_t* p_Image, uint64_t p_ImageSize, const char* p_ImageName, const char* p_HeaderName, FILE* p_Output)
+{
+    uint8_t* s_Done = calloc(p_List->Count + 1, 1);
+    struct MiraSignature* s_Signatures = calloc(p_List->Count + 1, sizeof(*s_Signatures));
+    uint32_t* s_Pending = calloc(p_List->Count + 1, sizeof(*s_Pending));
+    int s_Ret = 2;
+
+    do
+    {
+        if (s_Done == NULL || s_Signatures == NULL || s_Pending == NULL)
+            break;
+
+        // Every round scans once for the symbols that are not unique yet, each a bit longer
+        for (uint32_t l_Length = MIRA_KDLSYM_DERIVE_START; l_Length <= MIRA_KDLSYM_MAX_PATTERN; l_Length += MIRA_KDLSYM_DERIVE_STEP)
+        {
+            uint32_t l_PendingCount = 0;
+            for (uint32_t l_Index = 0; l_Index < p_List->Count; ++l_Index)
+            {
+                struct MiraKdlsymEntry* l_Entry = &p_List->Entries[l_Index];
+                if (l_Entry->Name == NULL || s_Done[l_Index] || l_Entry->Offset + l_Length > p_ImageSize)
+                    continue;
+
+                FillDerivedPattern(l_Entry, p_Image, l_Length);
+
+                struct MiraSignature* l_Signature = &s_Signatures[l_PendingCount];
+                memset(l_Signature, 0, sizeof(*l_Signature));
+                l_Signature->Name = l_Entry->Name;
+                l_Signature->Bytes = l_Entry->Bytes;
+                l_Signature->Mask = l_Entry->Mask;
+                l_Signature->Length = l_Entry->Length;
+
+                s_Pending[l_PendingCount++] = l_Index;
+            }
+
+            if (l_PendingCount == 0)
+                break;
+
+            struct MiraScanner* l_Scanner = MiraScanner_Create(s_Signatures, l_PendingCount);
+            if (l_Scanner == NULL)
+                break;
+
+            MiraScanner_Scan(l_Scanner, p_Image, p_ImageSize);
+            MiraScanner_Destroy(l_Scanner);
+
+            for (uint32_t l_Index = 0; l_Index < l_PendingCount; ++l_Index)
+            {
+                if (s_Signatures[l_Index].MatchCount == 1)
+                    s_Done[s_Pending[l_Index]] = 1;
+            }
+        }
+
+        fprintf(p_Output, "# Derived by KdlsymScan from %s and %s\n", p_ImageName, p_HeaderName);
+
+        uint32_t s_Derived = 0;
+        uint32_t s_Failed = 0;
+        for (uint32_t l_Index = 0; l_Index < p_List->Count; ++l_Index)
+        {
+            struct MiraKdlsymEntry* l_Entry = &p_List->Entries[l_Index];
+            if (l_Entry->Name == NULL)
+            {
+                fprintf(p_Output, "\n%s\n", l_Entry->Comment);
+                continue;
+            }
+
+            if (!s_Done[l_Index])
+            {
+                fprintf(stderr, "not unique: %s (0x%llX)\n", l_Entry->Name, (unsigned long long)l_Entry->Offset);
+                fprintf(p_Output, "# %s not unique within %u bytes\n", l_Entry->Name, MIRA_KDLSYM_MAX_PATTERN);
+                s_Failed++;
+                continue;
+            }
+
+            fprintf(p_Output, "%-50s +0 ", l_Entry->Name);
+            for (uint32_t l_Byte = 0; l_Byte < l_Entry->Length; ++l_Byte)
+            {
+                if (l_Entry->Mask[l_Byte] == 0)
+                    fprintf(p_Output, l_Byte == 0 ? "??" : " ??");
+                else
+                    fprintf(p_Output, l_Byte == 0 ? "%02X" : " %02X", l_Entry->Bytes[l_Byte]);
+            }
+            fprintf(p_Output, "\n");
+            s_Derived++;
+        }
+
+        fprintf(stderr, "%u derived, %u not unique\n", s_Derived, s_Failed);
+        s_Ret = s_Failed == 0 ? 0 : 1;
+    } while (0);
+
+    free(s_Pending);
+    free(s_Signatures);
+    free(s_Done);
+
+    return s_Ret;
+}
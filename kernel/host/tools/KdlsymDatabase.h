@@ -0,0 +1,81 @@
+/*
+    KdlsymDatabase.h
+
+    Signature databases and Kdlsym headers as KdlsymScan reads and writes them (the formats are
+    described at the top of KdlsymScan.c). Split from the tool so the host tests can run a
+    derive and scan round trip without files.
+
+    Plain C built against the host libc, include stdint.h and stdio.h first.
+*/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Longest signature in a database, and the length derived ones start at and grow by
+#define MIRA_KDLSYM_MAX_PATTERN 64
+#define MIRA_KDLSYM_DERIVE_START 16
+#define MIRA_KDLSYM_DERIVE_STEP 8
+
+#define MIRA_KDLSYM_MAX_LINE 1024
+
+enum MiraKdlsymResolve
+{
+    MiraKdlsymResolve_Offset,
+    MiraKdlsymResolve_RipRelative,
+};
+
+struct MiraKdlsymEntry
+{
+    // Set for `//` lines, which only carry text for the output
+    char* Comment;
+
+    char* Name;
+    enum MiraKdlsymResolve Resolve;
+    int64_t Adjust;
+
+    uint8_t Bytes[MIRA_KDLSYM_MAX_PATTERN];
+    uint8_t Mask[MIRA_KDLSYM_MAX_PATTERN];
+    uint32_t Length;
+
+    // Known offset, only used while deriving
+    uint64_t Offset;
+};
+
+struct MiraKdlsymList
+{
+    struct MiraKdlsymEntry* Entries;
+    uint32_t Count;
+    uint32_t Capacity;
+};
+
+// Zeroed entry at the end of p_List, NULL when memory runs out
+struct MiraKdlsymEntry* MiraKdlsym_AddEntry(struct MiraKdlsymList* p_List);
+void MiraKdlsym_FreeList(struct MiraKdlsymList* p_List);
+
+// `+N`, `-N` or `rip+N`, returns 0 when p_Text is none of them
+int MiraKdlsym_ParseResolve(const char* p_Text, struct MiraKdlsymEntry* p_Entry);
+
+// Offset of the symbol for a match of p_Entry at p_Match, returns 0 when it would be negative
+int MiraKdlsym_ResolveMatch(const struct MiraKdlsymEntry* p_Entry, const uint8_t* p_Image, uint64_t p_Match, uint64_t* p_Offset);
+
+// Appends the signatures (and `//` comments) of a database, p_Name is only used in messages.
+// Returns 0 or -1 on the first invalid line
+int MiraKdlsym_ReadSignatures(FILE* p_File, const char* p_Name, struct MiraKdlsymList* p_List);
+
+// Appends the `#define <name> <offset>` lines (and `//` comments) of a Kdlsym header
+int MiraKdlsym_ReadHeader(FILE* p_File, struct MiraKdlsymList* p_List);
+
+// Scans p_Image for every signature of p_List and writes the Kdlsym header for p_Platform.
+// Returns 0 when every symbol matched once, 1 when some did not and 2 on errors
+int MiraKdlsym_WriteHeader(const struct MiraKdlsymList* p_List, const uint8_t* p_Image, uint64_t p_ImageSize, const char* p_Platform, const char* p_ImageName, const char* p_DatabaseName, FILE* p_Output);
+
+// Grows a signature from the offset of every symbol of p_List (read from a header) until it
+// is unique in p_Image and writes the database. Returns 0 when every symbol got one, 1 when
+// some did not and 2 on errors
+int MiraKdlsym_WriteSignatures(struct MiraKdlsymList* p_List, const uint8_t* p_Image, uint64_t p_ImageSize, const char* p_ImageName, const char* p_HeaderName, FILE* p_Output);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,209 @@
+/*
+    KdlsymScan.c
+
+    Finds kdlsym offsets in a kernel dump from a signature database and writes them out as a
+    Utils/Kdlsym/Orbis*.hpp header, so porting to a new firmware starts from a generated table
+    instead of hundreds of hand found offsets. The dump is expected to start at the kernel base,
+    offsets in the header are file offsets.
+
+    The database has one signature per line, `#` starts a comment and lines starting with `//`
+    are copied into the header as they are (section comments):
+
+        <macro name> <resolve> <pattern>
+
+        kdlsym_addr_printf     +0      55 48 89 E5 41 57 41 56 ?? ?? 48 81 EC
+        kdlsym_addr_allproc    rip+3   48 8B 05 ?? ?? ?? ?? 48 85 C0 74 ?? 4C 8B
+
+    <resolve> is `+N` or `-N` for the symbol being N bytes after (before) the start of the match,
+    or `rip+N` for a RIP relative reference whose disp32 is at N and ends the instruction.
+
+    Symbols without a match or with more than one are reported and left out of the header as
+    comments, the exit code is 1 then. Databases are derived from a firmware with known offsets:
+    -d takes its header and dump and grows a signature from each offset until it is unique.
+    Data symbols need rip+N signatures written by hand, the bytes at their offset are not code.
+
+    Usage: KdlsymScan -s signatures.txt -p 672 [-o Orbis672.hpp] kernel.bin
+           KdlsymScan -d Orbis505.hpp [-o signatures.txt] kernel505.bin
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "KdlsymDatabase.h"
+
+static uint8_t* ReadFile(const char* p_Path, uint64_t* p_Size)
+{
+    FILE* s_File = fopen(p_Path, "rb");
+    if (s_File == NULL)
+    {
+        fprintf(stderr, "could not open (%s)\n", p_Path);
+        return NULL;
+    }
+
+    uint8_t* s_Data = NULL;
+    do
+    {
+        if (fseek(s_File, 0, SEEK_END) != 0)
+            break;
+
+        long s_Size = ftell(s_File);
+        if (s_Size <= 0 || fseek(s_File, 0, SEEK_SET) != 0)
+            break;
+
+        s_Data = malloc((size_t)s_Size);
+        if (s_Data == NULL)
+            break;
+
+        if (fread(s_Data, 1, (size_t)s_Size, s_File) != (size_t)s_Size)
+        {
+            free(s_Data);
+            s_Data = NULL;
+            break;
+        }
+
+        *p_Size = (uint64_t)s_Size;
+    } while (0);
+
+    fclose(s_File);
+
+    if (s_Data == NULL)
+        fprintf(stderr, "could not read (%s)\n", p_Path);
+
+    return s_Data;
+}
+
+static int Scan(const char* p_SignaturePath, const char* p_Platform, const char* p_OutputPath, const char* p_ImagePath)
+{
+    struct MiraKdlsymList s_List = { 0 };
+    uint8_t* s_Image = NULL;
+    FILE* s_Output = NULL;
+    int s_Ret = 2;
+
+    do
+    {
+        FILE* s_File = fopen(p_SignaturePath, "r");
+        if (s_File == NULL)
+        {
+            fprintf(stderr, "could not open (%s)\n", p_SignaturePath);
+            break;
+        }
+
+        int s_Read = MiraKdlsym_ReadSignatures(s_File, p_SignaturePath, &s_List);
+        fclose(s_File);
+        if (s_Read != 0)
+            break;
+
+        uint64_t s_ImageSize = 0;
+        s_Image = ReadFile(p_ImagePath, &s_ImageSize);
+        if (s_Image == NULL)
+            break;
+
+        s_Output = p_OutputPath == NULL ? stdout : fopen(p_OutputPath, "w");
+        if (s_Output == NULL)
+        {
+            fprintf(stderr, "could not open (%s) for writing\n", p_OutputPath);
+            break;
+        }
+
+        s_Ret = MiraKdlsym_WriteHeader(&s_List, s_Image, s_ImageSize, p_Platform, p_ImagePath, p_SignaturePath, s_Output);
+    } while (0);
+
+    if (s_Output != NULL && s_Output != stdout)
+        fclose(s_Output);
+
+    free(s_Image);
+    MiraKdlsym_FreeList(&s_List);
+
+    return s_Ret;
+}
+
+static int Derive(const char* p_HeaderPath, const char* p_OutputPath, const char* p_ImagePath)
+{
+    struct MiraKdlsymList s_List = { 0 };
+    uint8_t* s_Image = NULL;
+    FILE* s_Output = NULL;
+    int s_Ret = 2;
+
+    do
+    {
+        FILE* s_File = fopen(p_HeaderPath, "r");
+        if (s_File == NULL)
+        {
+            fprintf(stderr, "could not open (%s)\n", p_HeaderPath);
+            break;
+        }
+
+        int s_Read = MiraKdlsym_ReadHeader(s_File, &s_List);
+        fclose(s_File);
+        if (s_Read != 0)
+            break;
+
+        uint64_t s_ImageSize = 0;
+        s_Image = ReadFile(p_ImagePath, &s_ImageSize);
+        if (s_Image == NULL)
+            break;
+
+        s_Output = p_OutputPath == NULL ? stdout : fopen(p_OutputPath, "w");
+        if (s_Output == NULL)
+        {
+            fprintf(stderr, "could not open (%s) for writing\n", p_OutputPath);
+            break;
+        }
+
+        s_Ret = MiraKdlsym_WriteSignatures(&s_List, s_Image, s_ImageSize, p_ImagePath, p_HeaderPath, s_Output);
+    } while (0);
+
+    if (s_Output != NULL && s_Output != stdout)
+        fclose(s_Output);
+
+    free(s_Image);
+    MiraKdlsym_FreeList(&s_List);
+
+    return s_Ret;
+}
+
+int main(int p_ArgumentCount, char** p_Arguments)
+{
+    const char* s_SignaturePath = NULL;
+    const char* s_HeaderPath = NULL;
+    const char* s_Platform = NULL;
+    const char* s_OutputPath = NULL;
+
+    int s_Option;
+    while ((s_Option = getopt(p_ArgumentCount, p_Arguments, "s:d:p:o:")) != -1)
+    {
+        switch (s_Option)
+        {
+        case 's':
+            s_SignaturePath = optarg;
+            break;
+        case 'd':
+            s_HeaderPath = optarg;
+            break;
+        case 'p':
+            s_Platform = optarg;
+            break;
+        case 'o':
+            s_OutputPath = optarg;
+            break;
+        default:
+            s_SignaturePath = s_HeaderPath = NULL;
+            optind = p_ArgumentCount;
+            break;
+        }
+    }
+
+    const char* s_ImagePath = optind + 1 == p_ArgumentCount ? p_Arguments[optind] : NULL;
+
+    if (s_ImagePath != NULL && s_SignaturePath != NULL && s_HeaderPath == NULL && s_Platform != NULL)
+        return Scan(s_SignaturePath, s_Platform, s_OutputPath, s_ImagePath);
+
+    if (s_ImagePath != NULL && s_HeaderPath != NULL && s_SignaturePath == NULL)
+        return Derive(s_HeaderPath, s_OutputPath, s_ImagePath);
+
+    fprintf(stderr, "usage: %s -s signatures.txt -p platform [-o header] kernel.bin\n", p_Arguments[0]);
+    fprintf(stderr, "       %s -d known_header [-o signatures.txt] known_kernel.bin\n", p_Arguments[0]);
+    return 2;
+}
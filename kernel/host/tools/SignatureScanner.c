@@ -0,0 +1,333 @@
+/*
+    SignatureScanner.c
+
+    Aho-Corasick automaton over the signature anchors, expanded into a full transition table
+    so the scan loop is one table lookup per image byte.
+*/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "SignatureScanner.h"
+
+struct MiraScanner
+{
+    struct MiraSignature* Signatures;
+    uint32_t SignatureCount;
+
+    // Where the anchor starts in each signature, and how long it is
+    uint32_t* AnchorOffsets;
+    uint32_t* AnchorLengths;
+
+    // Next signature whose anchor ends in the same node, -1 terminates
+    int32_t* SignatureNext;
+
+    uint32_t NodeCount;
+
+    // NodeCount * 256 transitions, node 0 is the root. Once built every edge holds the target
+    // node shifted left by 8, so it indexes the target's row directly, and its Reports flag in
+    // bit 0, which keeps the scan loop at one load per byte
+    uint32_t* Edges;
+
+    // First signature whose anchor ends in the node, -1 when none
+    int32_t* Terminals;
+
+    // Longest proper suffix of the node that is a terminal, 0 when none
+    int32_t* DictionaryLinks;
+
+    // Non zero when the node or one of its suffixes ends an anchor
+    uint8_t* Reports;
+};
+
+// Marks a missing edge while the trie is built
+#define MIRA_SCANNER_NO_EDGE 0xFFFFFFFFu
+
+// Node numbers have to fit the edges next to the flag byte
+#define MIRA_SCANNER_MAX_NODES (1u << 24)
+
+static void FindAnchor(const struct MiraSignature* p_Signature, uint32_t* p_Offset, uint32_t* p_Length)
+{
+    uint32_t s_BestOffset = 0;
+    uint32_t s_BestLength = 0;
+
+    uint32_t l_RunStart = 0;
+    for (uint32_t l_Index = 0; l_Index <= p_Signature->Length; ++l_Index)
+    {
+        if (l_Index < p_Signature->Length && p_Signature->Mask[l_Index] == 0xFF)
+            continue;
+
+        if (l_Index - l_RunStart > s_BestLength)
+        {
+            s_BestOffset = l_RunStart;
+            s_BestLength = l_Index - l_RunStart;
+        }
+
+        l_RunStart = l_Index + 1;
+    }
+
+    if (s_BestLength > MIRA_SCANNER_MAX_ANCHOR)
+        s_BestLength = MIRA_SCANNER_MAX_ANCHOR;
+
+    *p_Offset = s_BestOffset;
+    *p_Length = s_BestLength;
+}
+
+struct MiraScanner* MiraScanner_Create(struct MiraSignature* p_Signatures, uint32_t p_Count)
+{
+    if (p_Signatures == NULL || p_Count == 0)
+        return NULL;
+
+    struct MiraScanner* s_Scanner = calloc(1, sizeof(*s_Scanner));
+    if (s_Scanner == NULL)
+        return NULL;
+
+    s_Scanner->Signatures = p_Signatures;
+    s_Scanner->SignatureCount = p_Count;
+    s_Scanner->AnchorOffsets = calloc(p_Count, sizeof(uint32_t));
+    s_Scanner->AnchorLengths = calloc(p_Count, sizeof(uint32_t));
+    s_Scanner->SignatureNext = calloc(p_Count, sizeof(int32_t));
+
+    if (s_Scanner->AnchorOffsets == NULL || s_Scanner->AnchorLengths == NULL || s_Scanner->SignatureNext == NULL)
+    {
+        MiraScanner_Destroy(s_Scanner);
+        return NULL;
+    }
+
+    // Every anchor byte is at most one node
+    uint64_t s_MaxNodes = 1;
+    for (uint32_t l_Index = 0; l_Index < p_Count; ++l_Index)
+    {
+        FindAnchor(&p_Signatures[l_Index], &s_Scanner->AnchorOffsets[l_Index], &s_Scanner->AnchorLengths[l_Index]);
+        if (s_Scanner->AnchorLengths[l_Index] == 0)
+        {
+            MiraScanner_Destroy(s_Scanner);
+            return NULL;
+        }
+
+        s_MaxNodes += s_Scanner->AnchorLengths[l_Index];
+    }
+
+    if (s_MaxNodes > MIRA_SCANNER_MAX_NODES)
+    {
+        MiraScanner_Destroy(s_Scanner);
+        return NULL;
+    }
+
+    s_Scanner->Edges = malloc(s_MaxNodes * 256 * sizeof(uint32_t));
+    s_Scanner->Terminals = malloc(s_MaxNodes * sizeof(int32_t));
+    s_Scanner->DictionaryLinks = calloc(s_MaxNodes, sizeof(int32_t));
+    s_Scanner->Reports = calloc(s_MaxNodes, sizeof(uint8_t));
+    int32_t* s_FailureLinks = calloc(s_MaxNodes, sizeof(int32_t));
+    int32_t* s_Queue = malloc(s_MaxNodes * sizeof(int32_t));
+
+    if (s_Scanner->Edges == NULL || s_Scanner->Terminals == NULL || s_Scanner->DictionaryLinks == NULL || s_Scanner->Reports == NULL || s_FailureLinks == NULL || s_Queue == NULL)
+    {
+        free(s_FailureLinks);
+        free(s_Queue);
+        MiraScanner_Destroy(s_Scanner);
+        return NULL;
+    }
+
+    memset(s_Scanner->Edges, 0xFF, s_MaxNodes * 256 * sizeof(uint32_t));
+    memset(s_Scanner->Terminals, 0xFF, s_MaxNodes * sizeof(int32_t));
+    s_Scanner->NodeCount = 1;
+
+    for (uint32_t l_Index = 0; l_Index < p_Count; ++l_Index)
+    {
+        const uint8_t* l_Anchor = p_Signatures[l_Index].Bytes + s_Scanner->AnchorOffsets[l_Index];
+
+        int32_t l_Node = 0;
+        for (uint32_t l_Byte = 0; l_Byte < s_Scanner->AnchorLengths[l_Index]; ++l_Byte)
+        {
+            uint32_t* l_Edge = &s_Scanner->Edges[(uint64_t)l_Node * 256 + l_Anchor[l_Byte]];
+            if (*l_Edge == MIRA_SCANNER_NO_EDGE)
+                *l_Edge = s_Scanner->NodeCount++;
+
+            l_Node = (int32_t)*l_Edge;
+        }
+
+        s_Scanner->SignatureNext[l_Index] = s_Scanner->Terminals[l_Node];
+        s_Scanner->Terminals[l_Node] = (int32_t)l_Index;
+    }
+
+    // Breadth first, failure links point at shorter nodes which are done by then. Missing edges
+    // become the edge of the failure node, which turns the trie into a DFA
+    uint32_t s_Head = 0;
+    uint32_t s_Tail = 0;
+    for (uint32_t l_Byte = 0; l_Byte < 256; ++l_Byte)
+    {
+        uint32_t* l_Edge = &s_Scanner->Edges[l_Byte];
+        if (*l_Edge == MIRA_SCANNER_NO_EDGE)
+        {
+            *l_Edge = 0;
+            continue;
+        }
+
+        s_FailureLinks[*l_Edge] = 0;
+        s_Queue[s_Tail++] = *l_Edge;
+    }
+
+    while (s_Head < s_Tail)
+    {
+        int32_t l_Node = s_Queue[s_Head++];
+        int32_t l_Failure = s_FailureLinks[l_Node];
+
+        s_Scanner->DictionaryLinks[l_Node] = s_Scanner->Terminals[l_Failure] >= 0 ? l_Failure : s_Scanner->DictionaryLinks[l_Failure];
+        s_Scanner->Reports[l_Node] = s_Scanner->Terminals[l_Node] >= 0 || s_Scanner->DictionaryLinks[l_Node] != 0;
+
+        for (uint32_t l_Byte = 0; l_Byte < 256; ++l_Byte)
+        {
+            uint32_t* l_Edge = &s_Scanner->Edges[(uint64_t)l_Node * 256 + l_Byte];
+            uint32_t l_FailureEdge = s_Scanner->Edges[(uint64_t)l_Failure * 256 + l_Byte];
+
+            if (*l_Edge == MIRA_SCANNER_NO_EDGE)
+            {
+                *l_Edge = l_FailureEdge;
+                continue;
+            }
+
+            s_FailureLinks[*l_Edge] = l_FailureEdge;
+            s_Queue[s_Tail++] = *l_Edge;
+        }
+    }
+
+    free(s_FailureLinks);
+    free(s_Queue);
+
+    for (uint64_t l_Index = 0; l_Index < (uint64_t)s_Scanner->NodeCount * 256; ++l_Index)
+    {
+        uint32_t l_Target = s_Scanner->Edges[l_Index];
+        s_Scanner->Edges[l_Index] = (l_Target << 8) | s_Scanner->Reports[l_Target];
+    }
+
+    return s_Scanner;
+}
+
+void MiraScanner_Destroy(struct MiraScanner* p_Scanner)
+{
+    if (p_Scanner == NULL)
+        return;
+
+    free(p_Scanner->AnchorOffsets);
+    free(p_Scanner->AnchorLengths);
+    free(p_Scanner->SignatureNext);
+    free(p_Scanner->Edges);
+    free(p_Scanner->Terminals);
+    free(p_Scanner->DictionaryLinks);
+    free(p_Scanner->Reports);
+    free(p_Scanner);
+}
+
+static void CheckCandidate(struct MiraScanner* p_Scanner, uint32_t p_Signature, const uint8_t* p_Image, uint64_t p_ImageSize, uint64_t p_AnchorEnd)
+{
+    struct MiraSignature* s_Signature = &p_Scanner->Signatures[p_Signature];
+
+    uint64_t s_AnchorStart = p_AnchorEnd - p_Scanner->AnchorLengths[p_Signature];
+    if (s_AnchorStart < p_Scanner->AnchorOffsets[p_Signature])
+        return;
+
+    uint64_t s_Start = s_AnchorStart - p_Scanner->AnchorOffsets[p_Signature];
+    if (s_Start + s_Signature->Length > p_ImageSize)
+        return;
+
+    for (uint32_t l_Index = 0; l_Index < s_Signature->Length; ++l_Index)
+    {
+        if ((p_Image[s_Start + l_Index] & s_Signature->Mask[l_Index]) != (s_Signature->Bytes[l_Index] & s_Signature->Mask[l_Index]))
+            return;
+    }
+
+    if (s_Signature->MatchCount == 0)
+        s_Signature->FirstMatch = s_Start;
+    else if (s_Signature->MatchCount == 1)
+        s_Signature->SecondMatch = s_Start;
+
+    s_Signature->MatchCount++;
+}
+
+void MiraScanner_Scan(struct MiraScanner* p_Scanner, const uint8_t* p_Image, uint64_t p_ImageSize)
+{
+    if (p_Scanner == NULL)
+        return;
+
+    for (uint32_t l_Index = 0; l_Index < p_Scanner->SignatureCount; ++l_Index)
+    {
+        p_Scanner->Signatures[l_Index].MatchCount = 0;
+        p_Scanner->Signatures[l_Index].FirstMatch = 0;
+        p_Scanner->Signatures[l_Index].SecondMatch = 0;
+    }
+
+    if (p_Image == NULL)
+        return;
+
+    const uint32_t* s_Edges = p_Scanner->Edges;
+
+    uint32_t s_Edge = 0;
+    for (uint64_t l_Position = 0; l_Position < p_ImageSize; ++l_Position)
+    {
+        s_Edge = s_Edges[(s_Edge & ~0xFFu) | p_Image[l_Position]];
+        if ((s_Edge & 1) == 0)
+            continue;
+
+        int32_t s_Node = (int32_t)(s_Edge >> 8);
+        int32_t l_Match = p_Scanner->Terminals[s_Node] >= 0 ? s_Node : p_Scanner->DictionaryLinks[s_Node];
+        for (; l_Match != 0; l_Match = p_Scanner->DictionaryLinks[l_Match])
+        {
+            for (int32_t l_Signature = p_Scanner->Terminals[l_Match]; l_Signature >= 0; l_Signature = p_Scanner->SignatureNext[l_Signature])
+                CheckCandidate(p_Scanner, (uint32_t)l_Signature, p_Image, p_ImageSize, l_Position + 1);
+        }
+    }
+}
+
+static int HexValue(char p_Character)
+{
+    if (p_Character >= '0' && p_Character <= '9')
+        return p_Character - '0';
+    if (p_Character >= 'a' && p_Character <= 'f')
+        return p_Character - 'a' + 10;
+    if (p_Character >= 'A' && p_Character <= 'F')
+        return p_Character - 'A' + 10;
+
+    return -1;
+}
+
+uint32_t MiraScanner_ParsePattern(const char* p_Pattern, uint8_t* p_Bytes, uint8_t* p_Mask, uint32_t p_MaxLength)
+{
+    if (p_Pattern == NULL || p_Bytes == NULL || p_Mask == NULL)
+        return 0;
+
+    uint32_t s_Length = 0;
+    const char* s_Cursor = p_Pattern;
+    while (*s_Cursor != '\0')
+    {
+        if (*s_Cursor == ' ' || *s_Cursor == '\t')
+        {
+            s_Cursor++;
+            continue;
+        }
+
+        if (s_Length >= p_MaxLength)
+            return 0;
+
+        // "?" and "??" are both a wildcard byte
+        if (*s_Cursor == '?')
+        {
+            s_Cursor += s_Cursor[1] == '?' ? 2 : 1;
+            p_Bytes[s_Length] = 0;
+            p_Mask[s_Length] = 0;
+            s_Length++;
+            continue;
+        }
+
+        int l_High = HexValue(s_Cursor[0]);
+        int l_Low = l_High < 0 ? -1 : HexValue(s_Cursor[1]);
+        if (l_Low < 0)
+            return 0;
+
+        p_Bytes[s_Length] = (uint8_t)((l_High << 4) | l_Low);
+        p_Mask[s_Length] = 0xFF;
+        s_Length++;
+        s_Cursor += 2;
+    }
+
+    return s_Length;
+}
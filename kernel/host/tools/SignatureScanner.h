@@ -0,0 +1,50 @@
+/*
+    SignatureScanner.h
+
+    Multi-pattern byte signature search over a kernel image, used by KdlsymScan and its
+    benchmark. Every signature contributes its longest run of fixed bytes (the anchor) to one
+    Aho-Corasick automaton, so the image is walked once no matter how many signatures there
+    are. Each anchor hit is then checked against the whole signature, wildcards included.
+
+    Plain C built against the host libc, include stdint.h or sys/types.h first.
+*/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Longest anchor taken from a signature, more fixed bytes only make the automaton bigger
+#define MIRA_SCANNER_MAX_ANCHOR 16
+
+struct MiraSignature
+{
+    const char* Name;
+
+    // Mask byte 0xFF compares the signature byte, 0x00 is a wildcard
+    const uint8_t* Bytes;
+    const uint8_t* Mask;
+    uint32_t Length;
+
+    // Filled by MiraScanner_Scan
+    uint32_t MatchCount;
+    uint64_t FirstMatch;
+    uint64_t SecondMatch;
+};
+
+struct MiraScanner;
+
+// p_Signatures has to stay alive until the scanner is destroyed, NULL when a signature has no
+// fixed bytes or memory runs out
+struct MiraScanner* MiraScanner_Create(struct MiraSignature* p_Signatures, uint32_t p_Count);
+void MiraScanner_Destroy(struct MiraScanner* p_Scanner);
+
+// Resets and fills the match fields of every signature
+void MiraScanner_Scan(struct MiraScanner* p_Scanner, const uint8_t* p_Image, uint64_t p_ImageSize);
+
+// Parses "48 8B ?? 05" style patterns, returns the length or 0 when the pattern is invalid
+uint32_t MiraScanner_ParsePattern(const char* p_Pattern, uint8_t* p_Bytes, uint8_t* p_Mask, uint32_t p_MaxLength);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2,11 +2,18 @@
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
 
 #include <Boot/Patches.hpp>
+#include <Utils/Kernel.hpp>
 
 using namespace Mira::Boot;
 
+uint64_t Patches::m_Applied[Patches_MaxKernelPatches / 64];
+uint32_t Patches::m_PatchCount = 0;
+
 void Patches::install_prePatches()
 {
+	// Every patch of the firmware goes in while write protection is off this once
+	cpu_disable_wp();
+
 	switch (MIRA_PLATFORM)
 	{
 		case MIRA_PLATFORM_ORBIS_BSD_176:
@@ -49,4 +56,58 @@ void Patches::install_prePatches()
 		default:
 			break;
 	}
+
+	cpu_enable_wp();
+}
+
+void Patches::ApplyKernelPatches(const KernelPatch* p_Patches, uint32_t p_Count)
+{
+	memset(m_Applied, 0, sizeof(m_Applied));
+	m_PatchCount = 0;
+
+	// You must assign the kernel base pointer before anything is done
+	if (!gKernelBase || p_Patches == nullptr)
+		return;
+
+	if (p_Count > Patches_MaxKernelPatches)
+		p_Count = Patches_MaxKernelPatches;
+
+	m_PatchCount = p_Count;
+
+	for (uint32_t l_Index = 0; l_Index < p_Count; ++l_Index)
+	{
+		auto& l_Patch = p_Patches[l_Index];
+		auto l_Address = &gKernelBase[l_Patch.Offset];
+
+		// Already in place when mira is loaded again without a reboot
+		if (memcmp(l_Address, l_Patch.Replacement, l_Patch.Size) != 0)
+		{
+			if (l_Patch.Expected != nullptr && memcmp(l_Address, l_Patch.Expected, l_Patch.Size) != 0)
+				continue;
+
+			memcpy(l_Address, l_Patch.Replacement, l_Patch.Size);
+		}
+
+		m_Applied[l_Index / 64] |= (1ULL << (l_Index % 64));
+	}
+}
+
+uint32_t Patches::GetAppliedCount()
+{
+	uint32_t s_Count = 0;
+	for (uint32_t l_Index = 0; l_Index < m_PatchCount; ++l_Index)
+	{
+		if (IsPatchApplied(l_Index))
+			s_Count++;
+	}
+
+	return s_Count;
+}
+
+bool Patches::IsPatchApplied(uint32_t p_Index)
+{
+	if (p_Index >= m_PatchCount)
+		return false;
+
+	return (m_Applied[p_Index / 64] & (1ULL << (p_Index % 64))) != 0;
 }
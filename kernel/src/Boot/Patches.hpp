@@ -6,8 +6,41 @@ namespace Mira
 {
     namespace Boot
     {
+        enum
+        {
+            // Patches a firmware table can hold, the results are kept as a bitmap of this many bits
+            Patches_MaxKernelPatches = 128,
+        };
+
+        struct KernelPatch
+        {
+            // From gKernelBase
+            uint32_t Offset;
+            uint32_t Size;
+            const char* Replacement;
+
+            // Bytes that have to be there before patching, nullptr when they are not known. No
+            // firmware table has any yet, they need to be taken from a dump of that kernel
+            const char* Expected;
+        };
+
+        /*
+            Patches
+
+            Kernel patches applied at boot. Each firmware has a constant table of patches that
+            ApplyKernelPatches writes in order, all of them inside the one write protection
+            disabled window of install_prePatches. Verification is driven by the tables: a patch is
+            skipped when its expected bytes are not there, and none is checked while the tables
+            leave Expected unset, which they all do for now. One whose replacement is already in
+            place is left alone. Which patches
+            of the table are in place is kept as a bitmap that can be queried after boot.
+        */
         class Patches
         {
+        private:
+            static uint64_t m_Applied[Patches_MaxKernelPatches / 64];
+            static uint32_t m_PatchCount;
+
         public:
             static void install_prePatches();
             static void install_prerunPatches_176();
@@ -22,6 +55,20 @@ namespace Mira
             static void install_prerunPatches_672();
             // static void install_prerunPatches_SteamLink(); // got both versions booting off the same code
             static void install_prerunPatches_SteamLink2();
+
+            // Patches in the table of this firmware
+            static uint32_t GetPatchCount() { return m_PatchCount; }
+            static uint32_t GetAppliedCount();
+
+            // Index into the firmware table
+            static bool IsPatchApplied(uint32_t p_Index);
+
+            // Bit n is set when patch n of the firmware table is in place
+            static const uint64_t* GetAppliedBitmap() { return m_Applied; }
+
+        private:
+            // Expects write protection to be off
+            static void ApplyKernelPatches(const KernelPatch* p_Patches, uint32_t p_Count);
         };
     }
 }
@@ -9,105 +9,49 @@ using namespace Mira::Boot;
 	Please, please, please!
 	Keep patches consistent with the used patch style for readability.
 */
-void Patches::install_prerunPatches_176() 
-{
 #if MIRA_PLATFORM == MIRA_PLATFORM_ORBIS_BSD_176
-	// You must assign the kernel base pointer before anything is done
-	if (!gKernelBase)
-		return;
-
-	// Use "kmem" for all patches
-	uint8_t *kmem;
-
-    // Enable UART
-	kmem = (uint8_t *)&gKernelBase[0x011242F6]; // 5.00 0x019ECEB0
-	kmem[0] = 0x00;
-
-    // Verbose Panics
-	kmem = (uint8_t *)&gKernelBase[0x00415AD3];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x65;
-	kmem[6] = 0x8B;
-	kmem[7] = 0x34;
+static const KernelPatch s_KernelPatches[] =
+{
+	// Enable UART
+	{ 0x011242F6, 1, "\x00" }, // 5.00 0x019ECEB0
+
+	// Verbose Panics
+	{ 0x00415AD3, 8, "\x90\x90\x90\x90\x90\x65\x8B\x34" },
 
 	//Allow system level debugging
-	kmem = (uint8_t *)&gKernelBase[0x003F5180];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-	kmem[6] = 0x90;
-	kmem[7] = 0x90;
+	{ 0x003F5180, 8, "\xB8\x01\x00\x00\x00\xC3\x90\x90" },
 
 	//Allow coredump
-	kmem = (uint8_t *)&gKernelBase[0x003F51A0];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-	kmem[6] = 0x90;
-	kmem[7] = 0x90;
-	
+	{ 0x003F51A0, 8, "\xB8\x01\x00\x00\x00\xC3\x90\x90" },
+
 	// Enable rwx mapping
-	kmem = (uint8_t *)&gKernelBase[0x003AB305];
-	kmem[0] = 0x07;
+	{ 0x003AB305, 1, "\x07" },
 
 	// Patch copyin/copyout to allow userland + kernel addresses in both params
-	kmem = (uint8_t *)&gKernelBase[0x00413CEE];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x00413CEE, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x00413C6E];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x00413C6E, 2, "\x90\x90" },
 
 	// Enable MAP_SELF
-	kmem = (uint8_t *)&gKernelBase[0x003F5200];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-	
-	kmem = (uint8_t *)&gKernelBase[0x003F5210];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-	
-	kmem = (uint8_t *)&gKernelBase[0x003B6873];
-	kmem[0] = 0x31;
-	kmem[1] = 0xC0;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
+	{ 0x003F5200, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x003F5210, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x003B6873, 5, "\x31\xC0\x90\x90\x90" },
 
 	// Patch copyinstr
-	kmem = (uint8_t *)&gKernelBase[0x0041403A];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x0041403A, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x0041406A];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x0041406A, 2, "\x90\x90" },
 
 	// setlogin patch (for autolaunch check)
-	kmem = (uint8_t *)&gKernelBase[0x002300A7];
-	kmem[0] = 0x48;
-	kmem[1] = 0x31;
-	kmem[2] = 0xC0;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
+	{ 0x002300A7, 5, "\x48\x31\xC0\x90\x90" },
+};
+#endif
+
+void Patches::install_prerunPatches_176()
+{
+#if MIRA_PLATFORM == MIRA_PLATFORM_ORBIS_BSD_176
+	ApplyKernelPatches(s_KernelPatches, ARRAYSIZE(s_KernelPatches));
 #endif
-}
\ No newline at end of file
+}
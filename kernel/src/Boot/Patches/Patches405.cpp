@@ -9,193 +9,90 @@
 	Please, please, please!
 	Keep patches consistent with the used patch style for readability.
 */
-void Mira::Boot::Patches::install_prerunPatches_405()
-{
 #if MIRA_PLATFORM == MIRA_PLATFORM_ORBIS_BSD_405
-	// You must assign the kernel base pointer before anything is done
-	if (!gKernelBase)
-		return;
-
-	// Use "kmem" for all patches
-	uint8_t *kmem;
-
+static const Mira::Boot::KernelPatch s_KernelPatches[] =
+{
 	// Enable UART
-	kmem = (uint8_t *)&gKernelBase[0x0186B0A0];
-	kmem[0] = 0x00;
+	{ 0x0186B0A0, 1, "\x00" },
 
 	// Verbose Panics
-	kmem = (uint8_t *)&gKernelBase[0x000EC81A];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
+	{ 0x000EC81A, 5, "\x90\x90\x90\x90\x90" },
 
 	// sceSblACMgrIsAllowedSystemLevelDebugging
-	kmem = (uint8_t *)&gKernelBase[0x0035FE40];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-	kmem = (uint8_t *)&gKernelBase[0x00360570];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-	kmem = (uint8_t *)&gKernelBase[0x00360590];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
+	{ 0x0035FE40, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x00360570, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x00360590, 6, "\xB8\x01\x00\x00\x00\xC3" },
 
 	// Enable rwx mapping
-	kmem = (uint8_t *)&gKernelBase[0x0036958D];
-	kmem[0] = 0x07;
+	{ 0x0036958D, 1, "\x07" },
 
-	kmem = (uint8_t *)&gKernelBase[0x003695A5];
-	kmem[0] = 0x07;
+	{ 0x003695A5, 1, "\x07" },
 
 	// Patch copyin/copyout to allow userland + kernel addresses in both params
-	kmem = (uint8_t *)&gKernelBase[0x00286E21];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x00286E21, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x00286DA1];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x00286DA1, 2, "\x90\x90" },
 
 	// Enable MAP_SELF
-	kmem = (uint8_t *)&gKernelBase[0x003605F0];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-	kmem = (uint8_t *)&gKernelBase[0x00360600];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-	kmem = (uint8_t *)&gKernelBase[0x0031EE37];
-	kmem[0] = 0x31;
-	kmem[1] = 0xC0;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
+	{ 0x003605F0, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x00360600, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x0031EE37, 5, "\x31\xC0\x90\x90\x90" },
 
 	// Patch copyinstr
-	kmem = (uint8_t *)&gKernelBase[0x0028718D];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x0028718D, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x002871BD];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x002871BD, 2, "\x90\x90" },
 
 	// ptrace patches
-	kmem = (uint8_t *)&gKernelBase[0x000AC2F1];
-	kmem[0] = 0xEB;
+	{ 0x000AC2F1, 1, "\xEB" },
 
 	// second ptrace patch
-	kmem = (uint8_t *)&gKernelBase[0x000AC612];
-	kmem[0] = 0xE9;
-	kmem[1] = 0x08;
-	kmem[2] = 0x01;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
+	{ 0x000AC612, 5, "\xE9\x08\x01\x00\x00" },
 
 	// setlogin patch (for autolaunch check)
-	kmem = (uint8_t *)&gKernelBase[0x0008822C];
-	kmem[0] = 0x48;
-	kmem[1] = 0x31;
-	kmem[2] = 0xC0;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
+	{ 0x0008822C, 5, "\x48\x31\xC0\x90\x90" },
 
 	// Patch to remove vm_fault: fault on nofault entry, addr %llx
-	kmem = (uint8_t *)&gKernelBase[0x000C6991];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
+	{ 0x000C6991, 6, "\x90\x90\x90\x90\x90\x90" },
 
 	// patch mprotect to allow RWX (mprotect) mapping 4.05
-	kmem = (uint8_t *)&gKernelBase[0x004423E9];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
+	{ 0x004423E9, 6, "\x90\x90\x90\x90\x90\x90" },
 
 	// flatz disable pfs signature check
-	kmem = (uint8_t *)&gKernelBase[0x0068E990];
-	kmem[0] = 0x31;
-	kmem[1] = 0xC0;
-	kmem[2] = 0xC3;
+	{ 0x0068E990, 3, "\x31\xC0\xC3" },
 
 	// flatz enable debug RIFs
-	kmem = (uint8_t *)&gKernelBase[0x00620B20];
-	kmem[0] = 0xB0;
-	kmem[1] = 0x01;
-	kmem[2] = 0xC3;
+	{ 0x00620B20, 3, "\xB0\x01\xC3" },
 
-	kmem = (uint8_t *)&gKernelBase[0x00620B40];
-	kmem[0] = 0xB0;
-	kmem[1] = 0x01;
-	kmem[2] = 0xC3;
+	{ 0x00620B40, 3, "\xB0\x01\xC3" },
 
 	// Enable *all* debugging logs (in vprintf)
-	kmem = (uint8_t *)&gKernelBase[0x00347665];
-	kmem[0] = 0xEB;
-	kmem[1] = 0x13;
+	{ 0x00347665, 2, "\xEB\x13" },
 
 	// Enable mount for unprivileged user
-	kmem = (uint8_t *)&gKernelBase[0x00201556];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
+	{ 0x00201556, 6, "\x90\x90\x90\x90\x90\x90" },
 
 	// patch suword_lwpid
 	// has a check to see if child_tid/parent_tid is in kernel memory, and it in so patch it
-	kmem = (uint8_t *)&gKernelBase[0x00287074];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x00287074, 2, "\x90\x90" },
 
 	// Patch debug setting errors
-	kmem = (uint8_t *)&gKernelBase[0x004CECB7];
-	kmem[0] = 0x00;
-	kmem[1] = 0x00;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-
-	kmem = (uint8_t *)&gKernelBase[0x004CFB9B];
-	kmem[0] = 0x00;
-	kmem[1] = 0x00;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
+	{ 0x004CECB7, 4, "\x00\x00\x00\x00" },
+
+	{ 0x004CFB9B, 4, "\x00\x00\x00\x00" },
 
 	// prtinf hook patches
-	kmem = (uint8_t *)&gKernelBase[0x0034766E];
-	kmem[0] = 0xEB;
+	{ 0x0034766E, 1, "\xEB" },
+};
+#endif
 
+void Mira::Boot::Patches::install_prerunPatches_405()
+{
+#if MIRA_PLATFORM == MIRA_PLATFORM_ORBIS_BSD_405
+	ApplyKernelPatches(s_KernelPatches, ARRAYSIZE(s_KernelPatches));
 #endif
 }
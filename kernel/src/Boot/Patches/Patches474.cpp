@@ -7,204 +7,96 @@
 	Please, please, please!
 	Keep patches consistent with the used patch style for readability.
 */
-void Mira::Boot::Patches::install_prerunPatches_474()
-{
 #if MIRA_PLATFORM == MIRA_PLATFORM_ORBIS_BSD_474
-	// You must assign the kernel base pointer before anything is done
-	if (!gKernelBase)
-		return;
-
-	// Use "kmem" for all patches
-	uint8_t *kmem;
-
+static const Mira::Boot::KernelPatch s_KernelPatches[] =
+{
 	// Enable UART
-	kmem = (uint8_t *)&gKernelBase[0x0199FC18];
-	kmem[0] = 0x00;
+	{ 0x0199FC18, 1, "\x00" },
 
 	// Verbose Panics
-	kmem = (uint8_t *)&gKernelBase[0x003DCC77];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
+	{ 0x003DCC77, 5, "\x90\x90\x90\x90\x90" },
 
 	// sceSblACMgrIsAllowedSystemLevelDebugging
-	kmem = (uint8_t *)&gKernelBase[0x00169060];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-	kmem = (uint8_t *)&gKernelBase[0x00169790];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-	kmem = (uint8_t *)&gKernelBase[0x001697B0];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
+	{ 0x00169060, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x00169790, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x001697B0, 6, "\xB8\x01\x00\x00\x00\xC3" },
 
 	// Enable rwx mapping
-	kmem = (uint8_t *)&gKernelBase[0x0016DFEC];
-	kmem[0] = 0x07;
+	{ 0x0016DFEC, 1, "\x07" },
 
-	kmem = (uint8_t *)&gKernelBase[0x0016E002];
-	kmem[0] = 0x07;
+	{ 0x0016E002, 1, "\x07" },
 
 	// Patch copyin/copyout to allow userland + kernel addresses in both params
-	kmem = (uint8_t *)&gKernelBase[0x00149F77];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x00149F77, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x00149E92];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x00149E92, 2, "\x90\x90" },
 
 	// Enable MAP_SELF
-	kmem = (uint8_t *)&gKernelBase[0x00169810];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-	kmem = (uint8_t *)&gKernelBase[0x00169820];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-	kmem = (uint8_t *)&gKernelBase[0x00143277];
-	kmem[0] = 0x31;
-	kmem[1] = 0xC0;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
+	{ 0x00169810, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x00169820, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x00143277, 5, "\x31\xC0\x90\x90\x90" },
 
 	// Patch copyinstr
-	kmem = (uint8_t *)&gKernelBase[0x0014A3E3];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x0014A3E3, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x0014A413];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x0014A413, 2, "\x90\x90" },
 
 	// Patch memcpy stack
-	kmem = (uint8_t *)&gKernelBase[0x00149D4D];
-	kmem[0] = 0xEB;
+	{ 0x00149D4D, 1, "\xEB" },
 
 	// ptrace patches
-	kmem = (uint8_t *)&gKernelBase[0x0017C54E];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
+	{ 0x0017C54E, 6, "\x90\x90\x90\x90\x90\x90" },
 
 	// setlogin patch (for autolaunch check)
-	kmem = (uint8_t *)&gKernelBase[0x0011622C];
-	kmem[0] = 0x48;
-	kmem[1] = 0x31;
-	kmem[2] = 0xC0;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
+	{ 0x0011622C, 5, "\x48\x31\xC0\x90\x90" },
 
 	// Patch to remove vm_fault: fault on nofault entry, addr %llx
-	kmem = (uint8_t *)&gKernelBase[0x002A160E];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
+	{ 0x002A160E, 6, "\x90\x90\x90\x90\x90\x90" },
 
 	// patch mprotect to allow RWX (mprotect) mapping 4.74
-	kmem = (uint8_t *)&gKernelBase[0x00397878];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
+	{ 0x00397878, 6, "\x90\x90\x90\x90\x90\x90" },
 
 	// flatz disable pfs signature check
-	kmem = (uint8_t *)&gKernelBase[0x006A2DF0];
-	kmem[0] = 0x31;
-	kmem[1] = 0xC0;
-	kmem[2] = 0xC3;
+	{ 0x006A2DF0, 3, "\x31\xC0\xC3" },
 
 	// flatz enable debug RIFs
-	kmem = (uint8_t *)&gKernelBase[0x00630B10];
-	kmem[0] = 0xB0;
-	kmem[1] = 0x01;
-	kmem[2] = 0xC3;
+	{ 0x00630B10, 3, "\xB0\x01\xC3" },
 
-	kmem = (uint8_t *)&gKernelBase[0x00630B30];
-	kmem[0] = 0xB0;
-	kmem[1] = 0x01;
-	kmem[2] = 0xC3;
+	{ 0x00630B30, 3, "\xB0\x01\xC3" },
 
 	// Enable *all* debugging logs (in vprintf)
 	// Patch by: SiSTRo (ported by kiwidog)
-	kmem = (uint8_t *)&gKernelBase[0x0001801A];
-	kmem[0] = 0xEB;
-	kmem[1] = 0x39;
+	{ 0x0001801A, 2, "\xEB\x39" },
 
 	// Enable mount for unprivileged user
-	kmem = (uint8_t *)&gKernelBase[0x000D9AE3];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
+	{ 0x000D9AE3, 6, "\x90\x90\x90\x90\x90\x90" },
 
 	// patch suword_lwpid
 	// has a check to see if child_tid/parent_tid is in kernel memory, and it in so patch it
 	// Patch by: JOGolden
-	kmem = (uint8_t *)&gKernelBase[0x0014A222];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x0014A222, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x0014A231];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x0014A231, 2, "\x90\x90" },
 
 	// Patch debug setting errors
-	kmem = (uint8_t *)&gKernelBase[0x004D8777];
-	kmem[0] = 0x00;
-	kmem[1] = 0x00;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-
-	kmem = (uint8_t *)&gKernelBase[0x004D9601];
-	kmem[0] = 0x00;
-	kmem[1] = 0x00;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
+	{ 0x004D8777, 4, "\x00\x00\x00\x00" },
+
+	{ 0x004D9601, 4, "\x00\x00\x00\x00" },
 
 	// prtinf hook patches
-	kmem = (uint8_t *)&gKernelBase[0x00018026];
-	kmem[0] = 0xEB;
-	kmem[1] = 0x2D;
+	{ 0x00018026, 2, "\xEB\x2D" },
 
-	kmem = (uint8_t *)&gKernelBase[0x00018049];
-	kmem[0] = 0xEB;
+	{ 0x00018049, 1, "\xEB" },
+};
+#endif
 
+void Mira::Boot::Patches::install_prerunPatches_474()
+{
+#if MIRA_PLATFORM == MIRA_PLATFORM_ORBIS_BSD_474
+	ApplyKernelPatches(s_KernelPatches, ARRAYSIZE(s_KernelPatches));
 #endif
 }
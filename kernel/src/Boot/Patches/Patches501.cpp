@@ -7,217 +7,102 @@
 	Please, please, please!
 	Keep patches consistent with the used patch style for readability.
 */
-void Mira::Boot::Patches::install_prerunPatches_501()
-{
 #if MIRA_PLATFORM == MIRA_PLATFORM_ORBIS_BSD_501
-	// You must assign the kernel base pointer before anything is done
-	if (!gKernelBase)
-		return;
-
-	// Use "kmem" for all patches
-	uint8_t *kmem;
-
+static const Mira::Boot::KernelPatch s_KernelPatches[] =
+{
 	// Enable UART
-	kmem = (uint8_t *)&gKernelBase[0x019ECEB0];
-	kmem[0] = 0x00;
+	{ 0x019ECEB0, 1, "\x00" },
 
 	// Verbose Panics
-	kmem = (uint8_t *)&gKernelBase[0x00171517];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
+	{ 0x00171517, 5, "\x90\x90\x90\x90\x90" },
 
 	// sceSblACMgrIsAllowedSystemLevelDebugging
-	kmem = (uint8_t *)&gKernelBase[0x00010FC0];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-	kmem = (uint8_t *)&gKernelBase[0x00011730];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-	kmem = (uint8_t *)&gKernelBase[0x00011750];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
+	{ 0x00010FC0, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x00011730, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x00011750, 6, "\xB8\x01\x00\x00\x00\xC3" },
 
 	// Enable rwx mapping
-	kmem = (uint8_t *)&gKernelBase[0x000FCC38];
-	kmem[0] = 0x07;
+	{ 0x000FCC38, 1, "\x07" },
 
-	kmem = (uint8_t *)&gKernelBase[0x000FCC46];
-	kmem[0] = 0x07;
+	{ 0x000FCC46, 1, "\x07" },
 
 	// Patch copyin/copyout to allow userland + kernel addresses in both params
-	kmem = (uint8_t *)&gKernelBase[0x001EA657];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x001EA657, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x001EA572];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x001EA572, 2, "\x90\x90" },
 
 	// Enable MAP_SELF
-	kmem = (uint8_t *)&gKernelBase[0x000117B0];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-	kmem = (uint8_t *)&gKernelBase[0x000117C0];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-	kmem = (uint8_t *)&gKernelBase[0x0013EF2F];
-	kmem[0] = 0x31;
-	kmem[1] = 0xC0;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
+	{ 0x000117B0, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x000117C0, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x0013EF2F, 5, "\x31\xC0\x90\x90\x90" },
 
 	// Patch copyinstr
-	kmem = (uint8_t *)&gKernelBase[0x001EAA83];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x001EAA83, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x001EAAB3];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x001EAAB3, 2, "\x90\x90" },
 
 	// Patch memcpy stack
-	kmem = (uint8_t *)&gKernelBase[0x001EA42D];
-	kmem[0] = 0xEB;
+	{ 0x001EA42D, 1, "\xEB" },
 
 	// ptrace patches
-	kmem = (uint8_t *)&gKernelBase[0x0030D61A];
-	kmem[0] = 0xEB;
+	{ 0x0030D61A, 1, "\xEB" },
 
 	// second ptrace patch
-	kmem = (uint8_t *)&gKernelBase[0x0030DA71];
-	kmem[0] = 0xE9;
-	kmem[1] = 0xD0;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
+	{ 0x0030DA71, 5, "\xE9\xD0\x00\x00\x00" },
 
 	// setlogin patch (for autolaunch check)
-	kmem = (uint8_t *)&gKernelBase[0x0005775C];
-	kmem[0] = 0x48;
-	kmem[1] = 0x31;
-	kmem[2] = 0xC0;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
+	{ 0x0005775C, 5, "\x48\x31\xC0\x90\x90" },
 
 	// Patch to remove vm_fault: fault on nofault entry, addr %llx
-	kmem = (uint8_t *)&gKernelBase[0x002A4BE3];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
+	{ 0x002A4BE3, 6, "\x90\x90\x90\x90\x90\x90" },
 
 	// patch mprotect to allow RWX (mprotect) mapping 5.01
-	kmem = (uint8_t *)&gKernelBase[0x001A3AF8];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
+	{ 0x001A3AF8, 6, "\x90\x90\x90\x90\x90\x90" },
 
 	// flatz disable pfs signature check
-	kmem = (uint8_t *)&gKernelBase[0x006A2320];
-	kmem[0] = 0x31;
-	kmem[1] = 0xC0;
-	kmem[2] = 0xC3;
+	{ 0x006A2320, 3, "\x31\xC0\xC3" },
 
 	// flatz enable debug RIFs
-	kmem = (uint8_t *)&gKernelBase[0x0064AED0];
-	kmem[0] = 0xB0;
-	kmem[1] = 0x01;
-	kmem[2] = 0xC3;
+	{ 0x0064AED0, 3, "\xB0\x01\xC3" },
 
-	kmem = (uint8_t *)&gKernelBase[0x0064AEF0];
-	kmem[0] = 0xB0;
-	kmem[1] = 0x01;
-	kmem[2] = 0xC3;
+	{ 0x0064AEF0, 3, "\xB0\x01\xC3" },
 
 	// Enable *all* debugging logs (in vprintf)
 	// Patch by: SiSTRo (ported by kiwidog)
-	kmem = (uint8_t *)&gKernelBase[0x00435D5A];
-	kmem[0] = 0xEB;
-	kmem[1] = 0x38;
+	{ 0x00435D5A, 2, "\xEB\x38" },
 
 	// flatz allow mangled symbol in dynlib_do_dlsym
-	kmem = (uint8_t *)&gKernelBase[0x002AFB47];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
+	{ 0x002AFB47, 6, "\x90\x90\x90\x90\x90\x90" },
 
 	// Enable mount for unprivileged user
-	kmem = (uint8_t *)&gKernelBase[0x001DEBFE];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
+	{ 0x001DEBFE, 6, "\x90\x90\x90\x90\x90\x90" },
 
 	// patch suword_lwpid
 	// has a check to see if child_tid/parent_tid is in kernel memory, and it in so patch it
 	// Patch by: JOGolden
-	kmem = (uint8_t *)&gKernelBase[0x001EA8C2];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x001EA8C2, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x001EA8D1];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x001EA8D1, 2, "\x90\x90" },
 
 	// Patch debug setting errors
-	kmem = (uint8_t *)&gKernelBase[0x004F8C78];
-	kmem[0] = 0x00;
-	kmem[1] = 0x00;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-
-	kmem = (uint8_t *)&gKernelBase[0x004F9D8C];
-	kmem[0] = 0x00;
-	kmem[1] = 0x00;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
+	{ 0x004F8C78, 4, "\x00\x00\x00\x00" },
+
+	{ 0x004F9D8C, 4, "\x00\x00\x00\x00" },
 
 	// prtinf hook patches
-	kmem = (uint8_t *)&gKernelBase[0x00435D66];
-	kmem[0] = 0xEB;
-	kmem[1] = 0x1E;
+	{ 0x00435D66, 2, "\xEB\x1E" },
 
-	kmem = (uint8_t *)&gKernelBase[0x00435D84];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x00435D84, 2, "\x90\x90" },
+};
+#endif
 
+void Mira::Boot::Patches::install_prerunPatches_501()
+{
+#if MIRA_PLATFORM == MIRA_PLATFORM_ORBIS_BSD_501
+	ApplyKernelPatches(s_KernelPatches, ARRAYSIZE(s_KernelPatches));
 #endif
 }
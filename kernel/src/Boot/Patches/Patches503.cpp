@@ -7,217 +7,102 @@
 	Please, please, please!
 	Keep patches consistent with the used patch style for readability.
 */
-void Mira::Boot::Patches::install_prerunPatches_503()
-{
 #if MIRA_PLATFORM == MIRA_PLATFORM_ORBIS_BSD_503
-	// You must assign the kernel base pointer before anything is done
-	if (!gKernelBase)
-		return;
-
-	// Use "kmem" for all patches
-	uint8_t *kmem;
-
+static const Mira::Boot::KernelPatch s_KernelPatches[] =
+{
 	// Enable UART
-	kmem = (uint8_t *)&gKernelBase[0x019ECEB0];
-	kmem[0] = 0x00;
+	{ 0x019ECEB0, 1, "\x00" },
 
 	// Verbose Panics
-	kmem = (uint8_t *)&gKernelBase[0x00171627];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
+	{ 0x00171627, 5, "\x90\x90\x90\x90\x90" },
 
 	// sceSblACMgrIsAllowedSystemLevelDebugging
-	kmem = (uint8_t *)&gKernelBase[0x00010FC0];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-	kmem = (uint8_t *)&gKernelBase[0x00011730];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-	kmem = (uint8_t *)&gKernelBase[0x00011750];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
+	{ 0x00010FC0, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x00011730, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x00011750, 6, "\xB8\x01\x00\x00\x00\xC3" },
 
 	// Enable rwx mapping
-	kmem = (uint8_t *)&gKernelBase[0x000FCD48];
-	kmem[0] = 0x07;
+	{ 0x000FCD48, 1, "\x07" },
 
-	kmem = (uint8_t *)&gKernelBase[0x000FCD56];
-	kmem[0] = 0x07;
+	{ 0x000FCD56, 1, "\x07" },
 
 	// Patch copyin/copyout to allow userland + kernel addresses in both params
-	kmem = (uint8_t *)&gKernelBase[0x001EA767];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x001EA767, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x001EA682];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x001EA682, 2, "\x90\x90" },
 
 	// Enable MAP_SELF
-	kmem = (uint8_t *)&gKernelBase[0x000117B0];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-	kmem = (uint8_t *)&gKernelBase[0x000117C0];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-	kmem = (uint8_t *)&gKernelBase[0x0013F03F];
-	kmem[0] = 0x31;
-	kmem[1] = 0xC0;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
+	{ 0x000117B0, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x000117C0, 6, "\xB8\x01\x00\x00\x00\xC3" },
+
+	{ 0x0013F03F, 5, "\x31\xC0\x90\x90\x90" },
 
 	// Patch copyinstr
-	kmem = (uint8_t *)&gKernelBase[0x001EAB93];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x001EAB93, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x001EABC3];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x001EABC3, 2, "\x90\x90" },
 
 	// Patch memcpy stack
-	kmem = (uint8_t *)&gKernelBase[0x001EA53D];
-	kmem[0] = 0xEB;
+	{ 0x001EA53D, 1, "\xEB" },
 
 	// ptrace patches
-	kmem = (uint8_t *)&gKernelBase[0x0030D9AA];
-	kmem[0] = 0xEB;
+	{ 0x0030D9AA, 1, "\xEB" },
 
 	// second ptrace patch
-	kmem = (uint8_t *)&gKernelBase[0x0030DE01];
-	kmem[0] = 0xE9;
-	kmem[1] = 0xD0;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
+	{ 0x0030DE01, 5, "\xE9\xD0\x00\x00\x00" },
 
 	// setlogin patch (for autolaunch check)
-	kmem = (uint8_t *)&gKernelBase[0x0005775C];
-	kmem[0] = 0x48;
-	kmem[1] = 0x31;
-	kmem[2] = 0xC0;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
+	{ 0x0005775C, 5, "\x48\x31\xC0\x90\x90" },
 
 	// Patch to remove vm_fault: fault on nofault entry, addr %llx
-	kmem = (uint8_t *)&gKernelBase[0x002A4EB3];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
+	{ 0x002A4EB3, 6, "\x90\x90\x90\x90\x90\x90" },
 
 	// patch mprotect to allow RWX (mprotect) mapping 5.03
-	kmem = (uint8_t *)&gKernelBase[0x001A3C08];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
+	{ 0x001A3C08, 6, "\x90\x90\x90\x90\x90\x90" },
 
 	// flatz disable pfs signature check
-	kmem = (uint8_t *)&gKernelBase[0x006A26C0];
-	kmem[0] = 0x31;
-	kmem[1] = 0xC0;
-	kmem[2] = 0xC3;
+	{ 0x006A26C0, 3, "\x31\xC0\xC3" },
 
 	// flatz enable debug RIFs
-	kmem = (uint8_t *)&gKernelBase[0x0064B270];
-	kmem[0] = 0xB0;
-	kmem[1] = 0x01;
-	kmem[2] = 0xC3;
+	{ 0x0064B270, 3, "\xB0\x01\xC3" },
 
-	kmem = (uint8_t *)&gKernelBase[0x0064B290];
-	kmem[0] = 0xB0;
-	kmem[1] = 0x01;
-	kmem[2] = 0xC3;
+	{ 0x0064B290, 3, "\xB0\x01\xC3" },
 
 	// Enable *all* debugging logs (in vprintf)
 	// Patch by: SiSTRo
-	kmem = (uint8_t *)&gKernelBase[0x004360EA];
-	kmem[0] = 0xEB;
-	kmem[1] = 0x38;
+	{ 0x004360EA, 2, "\xEB\x38" },
 
 	// flatz allow mangled symbol in dynlib_do_dlsym
-	kmem = (uint8_t *)&gKernelBase[0x002AF877];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
+	{ 0x002AF877, 6, "\x90\x90\x90\x90\x90\x90" },
 
 	// Enable mount for unprivileged user
-	kmem = (uint8_t *)&gKernelBase[0x001DEAEE];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
+	{ 0x001DEAEE, 6, "\x90\x90\x90\x90\x90\x90" },
 
 	// patch suword_lwpid
 	// has a check to see if child_tid/parent_tid is in kernel memory, and it in so patch it
 	// Patch by: JOGolden
-	kmem = (uint8_t *)&gKernelBase[0x001EA9D2];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x001EA9D2, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x001EA9E1];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x001EA9E1, 2, "\x90\x90" },
 
 	// Patch debug setting errors
-	kmem = (uint8_t *)&gKernelBase[0x004F9008];
-	kmem[0] = 0x00;
-	kmem[1] = 0x00;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-
-	kmem = (uint8_t *)&gKernelBase[0x004FA11C];
-	kmem[0] = 0x00;
-	kmem[1] = 0x00;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
+	{ 0x004F9008, 4, "\x00\x00\x00\x00" },
+
+	{ 0x004FA11C, 4, "\x00\x00\x00\x00" },
 
 	// prtinf hook patches
-	kmem = (uint8_t *)&gKernelBase[0x004360F6];
-	kmem[0] = 0xEB;
-	kmem[1] = 0x1E;
+	{ 0x004360F6, 2, "\xEB\x1E" },
 
-	kmem = (uint8_t *)&gKernelBase[0x00436114];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x00436114, 2, "\x90\x90" },
+};
+#endif
 
+void Mira::Boot::Patches::install_prerunPatches_503()
+{
+#if MIRA_PLATFORM == MIRA_PLATFORM_ORBIS_BSD_503
+	ApplyKernelPatches(s_KernelPatches, ARRAYSIZE(s_KernelPatches));
 #endif
 }
@@ -9,138 +9,73 @@
 	Keep patches consistent with the used patch style for readability.
 	thx: Fire30
 */
-void Mira::Boot::Patches::install_prerunPatches_620()
-{
 #if MIRA_PLATFORM == MIRA_PLATFORM_ORBIS_BSD_620
-	// You must assign the kernel base pointer before anything is done
-	if (!gKernelBase)
-		return;
-
-	// Use "kmem" for all patches
-	uint8_t *kmem;
-
+static const Mira::Boot::KernelPatch s_KernelPatches[] =
+{
 	// Enable rwx mapping
-	kmem = (uint8_t *)&gKernelBase[0x002704E8];
-	kmem[0] = 0x07;
+	{ 0x002704E8, 1, "\x07" },
+
+	{ 0x002704F6, 1, "\x07" },
 
-	kmem = (uint8_t *)&gKernelBase[0x002704F6];
-	kmem[0] = 0x07;
-	
 	//enable UART
 	//*(char *)(kernel_base + 0x01570338) = 0;
-	kmem = (uint8_t *)&gKernelBase[0x01570338];
-	kmem[0] = 0x00;
-	
+	{ 0x01570338, 1, "\x00" },
+
 	// Patches: sceSblACMgrHasMmapSelfCapability
-	kmem = (uint8_t *)&gKernelBase[0x004594B0];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
+	{ 0x004594B0, 6, "\xB8\x01\x00\x00\x00\xC3" },
 
 	// Patches: sceSblACMgrIsAllowedToMmapSelf
-	kmem = (uint8_t *)&gKernelBase[0x004594C0];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
-
-
+	{ 0x004594C0, 6, "\xB8\x01\x00\x00\x00\xC3" },
 
-        // Patches: flatz ddebug_menu_error_patch2 6.20
-	kmem = (uint8_t *)&gKernelBase[0x0050382c];
-	kmem[0] = 0x00;
-        kmem[1] = 0x00;
-        kmem[2] = 0x00;
-        kmem[3] = 0x00;
+	// Patches: flatz ddebug_menu_error_patch2 6.20
+	{ 0x0050382C, 4, "\x00\x00\x00\x00" },
 
-        // Patches: flatz ddebug_menu_error_patch1 6.20
-	kmem = (uint8_t *)&gKernelBase[0x0050256e];
-	kmem[0] = 0x00;
-        kmem[1] = 0x00;
-        kmem[2] = 0x00;
-        kmem[3] = 0x00;
+	// Patches: flatz ddebug_menu_error_patch1 6.20
+	{ 0x0050256E, 4, "\x00\x00\x00\x00" },
 
-         /* Huge thanks to Chendo for the corrected offsets */
+	/* Huge thanks to Chendo for the corrected offsets */
 
-        // Patches: flatz disable pfs signature check 6.20
-	kmem = (uint8_t *)&gKernelBase[0x006a3c10];
-	kmem[0] = 0x31;
-	kmem[1] = 0xC0;
-	kmem[2] = 0xC3;
-        kmem[3] = 0x90;
+	// Patches: flatz disable pfs signature check 6.20
+	{ 0x006A3C10, 4, "\x31\xC0\xC3\x90" },
 
+	// Patches: flatz enable debug RIFs pt1 6.20
+	{ 0x00667DC0, 4, "\xB0\x01\xC3\x90" },
 
-        // Patches: flatz enable debug RIFs pt1 6.20
-	kmem = (uint8_t *)&gKernelBase[0x00667dc0];
-	kmem[0] = 0xB0;
-	kmem[1] = 0x01;
-	kmem[2] = 0xC3;
-        kmem[3] = 0x90;
-
-
-
-        // Patches: flatz enable debug RIFs pt2 6.20
-	kmem = (uint8_t *)&gKernelBase[0x00667df0];
-	kmem[0] = 0xB0;
-	kmem[1] = 0x01;
-	kmem[2] = 0xC3;
-        kmem[3] = 0x90;
-	
+	// Patches: flatz enable debug RIFs pt2 6.20
+	{ 0x00667DF0, 4, "\xB0\x01\xC3\x90" },
 
 	// Patch copyin/copyout to allow userland + kernel addresses in both params
 	// copyin
-	kmem = (uint8_t *)&gKernelBase[0x00114947];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x00114947, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x00114953];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
+	{ 0x00114953, 3, "\x90\x90\x90" },
 
 	// copyout
-	kmem = (uint8_t *)&gKernelBase[0x00114852];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x00114852, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x0011485E];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
+	{ 0x0011485E, 3, "\x90\x90\x90" },
 
 	// Enable MAP_SELF
 	// TODO: Find MAP_SELF patches
 
 	// Patch copyinstr
-	kmem = (uint8_t *)&gKernelBase[0x00114DF3];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x00114DF3, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x00114DFF];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
+	{ 0x00114DFF, 3, "\x90\x90\x90" },
 
 	// Patch memcpy stack
-	kmem = (uint8_t *)&gKernelBase[0x0011470D];
-	kmem[0] = 0xEB;
+	{ 0x0011470D, 1, "\xEB" },
 
 	// ptrace patches
-	kmem = (uint8_t *)&gKernelBase[0x0013F234];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
-
-	kmem = (uint8_t*)&gKernelBase[0x001149A7];
-	kmem[0] = 0x41;
-	kmem[1] = 0x41;
+	{ 0x0013F234, 6, "\x90\x90\x90\x90\x90\x90" },
+
+	{ 0x001149A7, 2, "\x41\x41" },
+};
+#endif
+
+void Mira::Boot::Patches::install_prerunPatches_620()
+{
+#if MIRA_PLATFORM == MIRA_PLATFORM_ORBIS_BSD_620
+	ApplyKernelPatches(s_KernelPatches, ARRAYSIZE(s_KernelPatches));
 #endif
 }
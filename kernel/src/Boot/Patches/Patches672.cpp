@@ -3,159 +3,93 @@
 
 #include <Boot/Patches.hpp>
 
-void Mira::Boot::Patches::install_prerunPatches_672()
-{
 #if MIRA_PLATFORM==MIRA_PLATFORM_ORBIS_BSD_672
-	// You must assign the kernel base pointer before anything is done
-	if (!gKernelBase)
-		return;
-
-	// Use "kmem" for all patches
-	uint8_t *kmem;
-
+static const Mira::Boot::KernelPatch s_KernelPatches[] =
+{
 	// Patch dynlib_dlsym
-	kmem = (uint8_t*)&gKernelBase[0x1D895A];
-	kmem[0] = 0xE9;
-	kmem[1] = 0xC7;
-	kmem[2] = 0x01;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
+	{ 0x001D895A, 5, "\xE9\xC7\x01\x00\x00" },
 
 	// Patch a function called by dynlib_dlsym
-	kmem = (uint8_t*)&gKernelBase[0x0041A2D0];
-	kmem[0] = 0x31; // xor eax, eax
-	kmem[1] = 0xC0;
-	kmem[2] = 0xC3;	// ret
+	{ 0x0041A2D0, 3, "\x31\xC0\xC3" }, // xor eax, eax; ret
 
 	// Patch sys_mmap
-	kmem = (uint8_t*)&gKernelBase[0x000AB57A];
-	kmem[0] = 0x37; // mov     [rbp+var_61], 33h ; '3'
-	kmem[3] = 0x37; // mov     sil, 33h ; '3'
+	{ 0x000AB57A, 1, "\x37" }, // mov     [rbp+var_61], 33h ; '3'
+	{ 0x000AB57D, 1, "\x37" }, // mov     sil, 33h ; '3'
 
 	// patch sys_setuid
-	kmem = (uint8_t*)&gKernelBase[0x0010BED0]; // call    priv_check_cred; overwrite with mov eax, 0
-	kmem[0] = 0xB8; // mov eax, 0
-	kmem[1] = 0x00;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
+	{ 0x0010BED0, 5, "\xB8\x00\x00\x00\x00" }, // call    priv_check_cred; overwrite with mov eax, 0
 
 	// patch sys_mprotect
-	kmem = (uint8_t*)&gKernelBase[0x00451DB8]; // jnz     loc_FFFFFFFF82652426; nop it out
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
-	kmem[5] = 0x90;
+	{ 0x00451DB8, 6, "\x90\x90\x90\x90\x90\x90" }, // jnz     loc_FFFFFFFF82652426; nop it out
 
 	// Enable rwx mapping in kmem_alloc
-	kmem = (uint8_t *)&gKernelBase[0x002507F5];
-	kmem[0] = 0x07; // set maxprot to RWX
+	{ 0x002507F5, 1, "\x07" }, // set maxprot to RWX
 
-	kmem = (uint8_t *)&gKernelBase[0x00250803];
-	kmem[0] = 0x07; // set maxprot to RWX
+	{ 0x00250803, 1, "\x07" }, // set maxprot to RWX
 
 	// Patch copyin/copyout to allow userland + kernel addresses in both params
 	// copyin
-	kmem = (uint8_t *)&gKernelBase[0x003C17F7];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x003C17F7, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x003C1803];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
+	{ 0x003C1803, 3, "\x90\x90\x90" },
 
 	// copyout
-	kmem = (uint8_t *)&gKernelBase[0x003C1702];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x003C1702, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x003C170E];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
+	{ 0x003C170E, 3, "\x90\x90\x90" },
 
 	// Enable MAP_SELF
 
 	// Patches: sceSblACMgrHasMmapSelfCapability
-	kmem = (uint8_t *)&gKernelBase[0x00233C40];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
+	{ 0x00233C40, 6, "\xB8\x01\x00\x00\x00\xC3" },
 
 	// Patches: sceSblACMgrIsAllowedToMmapSelf
-	kmem = (uint8_t *)&gKernelBase[0x00233C50];
-	kmem[0] = 0xB8;
-	kmem[1] = 0x01;
-	kmem[2] = 0x00;
-	kmem[3] = 0x00;
-	kmem[4] = 0x00;
-	kmem[5] = 0xC3;
+	{ 0x00233C50, 6, "\xB8\x01\x00\x00\x00\xC3" },
 
 	// Patches: call    sceSblAuthMgrIsLoadable in vm_mmap2 (right above the only call to allowed to mmap self)
-	kmem = (uint8_t *)&gKernelBase[0x000AD2E4]; // xor eax, eax; nop; nop;
-	kmem[0] = 0x31;
-	kmem[1] = 0xC0;
-	kmem[2] = 0x90;
-	kmem[3] = 0x90;
-	kmem[4] = 0x90;
+	{ 0x000AD2E4, 5, "\x31\xC0\x90\x90\x90" }, // xor eax, eax; nop; nop;
 
 	// Patch copyinstr
-	kmem = (uint8_t *)&gKernelBase[0x003C1CA3];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
+	{ 0x003C1CA3, 2, "\x90\x90" },
 
-	kmem = (uint8_t *)&gKernelBase[0x003C1CAF];
-	kmem[0] = 0x90;
-	kmem[1] = 0x90;
-	kmem[2] = 0x90;
+	{ 0x003C1CAF, 3, "\x90\x90\x90" },
 
 	// Patch memcpy stack
-	kmem = (uint8_t *)&gKernelBase[0x003C15BD];
-	kmem[0] = 0xEB;
+	{ 0x003C15BD, 1, "\xEB" },
 
 	// ptrace patches
-	kmem = (uint8_t *)&gKernelBase[0x0010F879];
-	kmem[0] = 0xEB;
+	{ 0x0010F879, 1, "\xEB" },
 
 	// Enable debug rif's
-	kmem = (uint8_t*)&gKernelBase[0x66AEB0];
-	kmem[0] = 0xB0;
-	kmem[1] = 0x01;
-	kmem[2] = 0xC3;
-	kmem[3] = 0x90;
+	{ 0x0066AEB0, 4, "\xB0\x01\xC3\x90" },
 
 	// Enable debug rifs 2
-	kmem = (uint8_t*)&gKernelBase[0x66AEE0];
-	kmem[0] = 0xB0;
-	kmem[1] = 0x01;
-	kmem[2] = 0xC3;
-	kmem[3] = 0x90;
+	{ 0x0066AEE0, 4, "\xB0\x01\xC3\x90" },
 
 	// Disable pfs checks
-	kmem = (uint8_t*)&gKernelBase[0x6A8EB0];
-	kmem[0] = 0x31;
-	kmem[1] = 0xC0;
-	kmem[2] = 0xC3;
-	kmem[3] = 0x90;
+	{ 0x006A8EB0, 4, "\x31\xC0\xC3\x90" },
+
+	// Enable *all* debugging logs (in vprintf)
+	// Patch by: SiSTRo
+	{ 0x00123367, 2, "\xEB\x3B" }, // jmp +0x3D
+};
+#endif
 
-	kmem = (uint8_t*)kdlsym(global_settings_base);
+void Mira::Boot::Patches::install_prerunPatches_672()
+{
+#if MIRA_PLATFORM==MIRA_PLATFORM_ORBIS_BSD_672
+	// You must assign the kernel base pointer before anything is done
+	if (!gKernelBase)
+		return;
+
+	ApplyKernelPatches(s_KernelPatches, ARRAYSIZE(s_KernelPatches));
+
+	// Debug settings are flags in the global settings, not code, so they are not part of the table
+	uint8_t* kmem = (uint8_t*)kdlsym(global_settings_base);
 	kmem[0x36] |= 0x14;
 	kmem[0x59] |= 0x01; // sceSblRcMgrIsAllowULDebugger
 	kmem[0x59] |= 0x02; // sceSblRcMgrIsAllowSLDebugger
 	kmem[0x5A] |= 0x01;
 	kmem[0x78] |= 0x01;
-
-	// Enable *all* debugging logs (in vprintf)
-	// Patch by: SiSTRo
-	kmem = (uint8_t*)&gKernelBase[0x00123367];
-	kmem[0] = 0xEB; // jmp +0x3D
-	kmem[1] = 0x3B;
-
 #endif
 }
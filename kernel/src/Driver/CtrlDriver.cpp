@@ -42,11 +42,10 @@ using namespace Mira::Driver;
 void* orig_ioctl;
 
 CtrlDriver::CtrlDriver() :
-    m_processStartHandler(nullptr),
+    m_ProcessStartSubscription(-1),
     m_DeviceSw { 0 },
     m_Device(nullptr)
 {
-    auto eventhandler_register = (eventhandler_tag(*)(struct eventhandler_list *list, const char *name, void *func, void *arg, int priority))kdlsym(eventhandler_register);
     auto make_dev_p = (int(*)(int _flags, struct cdev **_cdev, struct cdevsw *_devsw, struct ucred *_cr, uid_t _uid, gid_t _gid, int _mode, const char *_fmt, ...))kdlsym(make_dev_p);
 
     // Set up our device driver information
@@ -80,13 +79,19 @@ CtrlDriver::CtrlDriver() :
         return;
     }
 
-    m_processStartHandler = EVENTHANDLER_REGISTER(process_exec, reinterpret_cast<void*>(OnProcessStart), nullptr, EVENTHANDLER_PRI_ANY);
+    // Only sandboxed processes have a devfs that hides the device, anything else can already see it
+    auto s_ProcessEvents = Mira::Framework::GetFramework()->GetProcessEvents();
+    if (s_ProcessEvents != nullptr)
+    {
+        Mira::OrbisOS::ProcessEventFilter s_Filter = { Mira::OrbisOS::ProcessEventFilter_Sandboxed, "", "" };
+        m_ProcessStartSubscription = s_ProcessEvents->Subscribe(Mira::OrbisOS::ProcessEvent_Start, s_Filter, OnProcessStart, nullptr);
+    }
 }
 
-void CtrlDriver::OnProcessStart(void *arg, struct proc *p)
+void CtrlDriver::OnProcessStart(Mira::OrbisOS::ProcessInfo* p_Info, void* p_Argument)
 {
     auto snprintf = (int(*)(char *str, size_t size, const char *format, ...))kdlsym(snprintf);
-    struct thread* s_ProcessThread = FIRST_THREAD_IN_PROC(p);
+    struct thread* s_ProcessThread = p_Info->Thread;
 
     // Add rules for mira to allow process to open & see it
     struct devfs_rule s_Dr;
@@ -125,6 +130,7 @@ void CtrlDriver::OnProcessStart(void *arg, struct proc *p)
     int32_t s_ErrorIoctl = kioctl_t(s_DevFS, DEVFSIO_RAPPLY, (char*)&s_Dr, s_ProcessThread);
     if (s_ErrorIoctl < 0) {
         WriteLog(LL_Error, "unable to apply devfs rule add request (%d).", s_ErrorIoctl);
+        kclose_t(s_DevFS, s_ProcessThread);
         return;
     }
 
@@ -134,15 +140,13 @@ void CtrlDriver::OnProcessStart(void *arg, struct proc *p)
 
 CtrlDriver::~CtrlDriver()
 {
-    auto eventhandler_deregister = (void(*)(struct eventhandler_list* a, struct eventhandler_entry* b))kdlsym(eventhandler_deregister);
-    auto eventhandler_find_list = (struct eventhandler_list * (*)(const char *name))kdlsym(eventhandler_find_list);
-
     WriteLog(LL_Debug, "destroying driver");
 
-    // Disable the eventhandler
-    if (m_processStartHandler) {
-        EVENTHANDLER_DEREGISTER(process_exec, m_processStartHandler);
-        m_processStartHandler = nullptr;
+    // Stop applying the devfs rule
+    auto s_ProcessEvents = Mira::Framework::GetFramework()->GetProcessEvents();
+    if (s_ProcessEvents != nullptr && m_ProcessStartSubscription >= 0) {
+        s_ProcessEvents->Unsubscribe(m_ProcessStartSubscription);
+        m_ProcessStartSubscription = -1;
     }
 
     // Destroy the device driver
@@ -310,6 +314,8 @@ int32_t CtrlDriver::OnMiraMountInSandbox(struct cdev* p_Device, u_long p_Command
 
     auto snprintf = (int(*)(char *str, size_t size, const char *format, ...))kdlsym(snprintf);
     auto vn_fullpath = (int(*)(struct thread *td, struct vnode *vp, char **retbuf, char **freebuf))kdlsym(vn_fullpath);
+    auto free = (void(*)(void* addr, struct malloc_type* type))kdlsym(free);
+    auto M_TEMP = (struct malloc_type*)kdlsym(M_TEMP);
     //auto strstr = (char *(*)(const char *haystack, const char *needle) )kdlsym(strstr);
 
 
@@ -378,7 +384,7 @@ int32_t CtrlDriver::OnMiraMountInSandbox(struct cdev* p_Device, u_long p_Command
         WriteLog(LL_Error, "could not get the sandbox path.");
 
         if (s_FreePath != nullptr)
-            delete s_FreePath;
+            free(s_FreePath, M_TEMP);
         
         return -1;
     }
@@ -465,7 +471,7 @@ int32_t CtrlDriver::OnMiraMountInSandbox(struct cdev* p_Device, u_long p_Command
 
     // Cleanup the freepath
     if (s_FreePath != nullptr)
-        delete s_FreePath;
+        free(s_FreePath, M_TEMP);
 
     return s_Result;
 }
@@ -526,7 +532,7 @@ bool CtrlDriver::GetProcessInfo(int32_t p_ProcessId, MiraProcessInformation*& p_
         thread_lock(s_CurrentThread);
 
         // Allocate a new entry
-        auto l_Info = new MiraProcessInformation::ThreadResult
+        auto l_Info = new (Utils::MemoryTag_Driver) MiraProcessInformation::ThreadResult
         {
             .ThreadId = s_CurrentThread->td_tid,
             .ErrNo = s_CurrentThread->td_errno,
@@ -564,7 +570,7 @@ bool CtrlDriver::GetProcessInfo(int32_t p_ProcessId, MiraProcessInformation*& p_
         }
 
         auto s_TotalSize = ( sizeof(MiraProcessInformation) + (sizeof(MiraProcessInformation::ThreadResult) * s_Count) );
-        auto s_Output = new uint8_t[s_TotalSize];
+        auto s_Output = new (Utils::MemoryTag_Driver) uint8_t[s_TotalSize];
         if (s_Output == nullptr)
         {
             WriteLog(LL_Error, "could not allocate (0x%x) bytes.", s_TotalSize);
@@ -653,7 +659,7 @@ bool CtrlDriver::GetProcessList(MiraProcessList*& p_List)
     }
 
     auto s_OutputSize = sizeof(MiraProcessList) + (sizeof(int32_t) * s_Count);
-    auto s_Buffer = new uint8_t[s_OutputSize];
+    auto s_Buffer = new (Utils::MemoryTag_Driver) uint8_t[s_OutputSize];
     if (s_Buffer == nullptr)
     {
         WriteLog(LL_Error, "could not allocate output buffer (%d).", s_OutputSize);
@@ -852,7 +858,7 @@ bool CtrlDriver::GetThreadCredentials(int32_t p_ProcessId, int32_t p_ThreadId, M
                 }
 
                 // Allocate new credentials
-                s_Credentials = new MiraThreadCredentials;
+                s_Credentials = new (Utils::MemoryTag_Driver) MiraThreadCredentials;
                 if (s_Credentials == nullptr)
                 {
                     WriteLog(LL_Error, "could not allocate new credentials.");
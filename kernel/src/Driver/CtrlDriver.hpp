@@ -5,6 +5,7 @@
 #include <sys/sysent.h>
 #include <Utils/_Syscall.hpp>
 #include <Utils/Kernel.hpp>
+#include <OrbisOS/ProcessEvents.hpp>
 
 #include <Plugins/Substitute/Substitute.hpp>
 
@@ -175,7 +176,7 @@ namespace Mira
         class CtrlDriver
         {
         private:
-            eventhandler_entry* m_processStartHandler;
+            int32_t m_ProcessStartSubscription;
             struct cdevsw m_DeviceSw;
             struct cdev* m_Device;
 
@@ -188,7 +189,7 @@ namespace Mira
             static int32_t OnIoctl(struct cdev* p_Device, u_long p_Command, caddr_t p_Data, int32_t p_FFlag, struct thread* p_Thread);
         
         protected:
-            static void OnProcessStart(void *arg, struct proc *p);
+            static void OnProcessStart(Mira::OrbisOS::ProcessInfo* p_Info, void* p_Argument);
 
             // Callback functions
             static int32_t OnMiraGetProcInformation(struct cdev* p_Device, u_long p_Command, caddr_t p_Data, int32_t p_FFlag, struct thread* p_Thread);
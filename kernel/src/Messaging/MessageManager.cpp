@@ -220,7 +220,7 @@ void MessageManager::SendResponse(Rpc::Connection* p_Connection, const RpcTransp
 
     // Allocate enough space for size + message data
     auto s_TotalSize = sizeof(uint64_t) + s_SerializedSize;
-    auto s_SerializedData = new uint8_t[s_TotalSize];
+    auto s_SerializedData = new (Utils::MemoryTag_Messaging) uint8_t[s_TotalSize];
     if (s_SerializedData == nullptr)
     {
         WriteLog(LL_Error, "could not allocate (%x).", s_SerializedSize);
@@ -33,7 +33,8 @@ Connection::Connection(Rpc::Server* p_Server, uint32_t p_ClientId, int32_t p_Soc
     m_Running(false),
     m_Thread(nullptr),
     m_Address{0},
-    m_Server(p_Server)
+    m_Server(p_Server),
+    m_Arena(Utils::MemoryTag_Messaging)
 {
     memcpy(&m_Address, &p_Address, sizeof(m_Address));
 
@@ -128,7 +129,7 @@ void Connection::ConnectionThread(void* p_Connection)
         return;
     }
 
-    auto s_Buffer = new uint8_t[MaxBufferSize];
+    auto s_Buffer = new (Utils::MemoryTag_Messaging) uint8_t[MaxBufferSize];
     if (s_Buffer == nullptr)
     {
         WriteLog(LL_Error, "could not allocate maximum buffer length.");
@@ -182,7 +183,8 @@ void Connection::ConnectionThread(void* p_Connection)
             break;
         }
 
-        RpcTransport* s_Transport = rpc_transport__unpack(nullptr, s_IncomingMessageSize, s_Buffer);
+        // Everything unpacked here lives in the arena and goes away with the reset at the end of the request
+        RpcTransport* s_Transport = rpc_transport__unpack(s_Connection->m_Arena.GetProtobufAllocator(), s_IncomingMessageSize, s_Buffer);
         if (s_Transport == nullptr)
         {
             WriteLog(LL_Error, "error unpacking incoming message");
@@ -203,7 +205,6 @@ void Connection::ConnectionThread(void* p_Connection)
         if (s_Header->magic != 2)
         {
             WriteLog(LL_Error, "incorrect magic got(%d) wanted (%d).", s_Header->magic, 2);
-            rpc_transport__free_unpacked(s_Transport, nullptr);
             memset(s_Buffer, 0, MaxBufferSize);
             break;
         }
@@ -213,7 +214,6 @@ void Connection::ConnectionThread(void* p_Connection)
         if (s_Category < RPC_CATEGORY__NONE || s_Category >= RPC_CATEGORY__MAX)
         {
             WriteLog(LL_Error, "invalid category (%d).", s_Category);
-            rpc_transport__free_unpacked(s_Transport, nullptr);
             memset(s_Buffer, 0, MaxBufferSize);
             break;
         }
@@ -222,7 +222,6 @@ void Connection::ConnectionThread(void* p_Connection)
         if (!s_Header->isrequest)
         {
             WriteLog(LL_Error, "attempted to handle outgoing message, fix ya code");
-            rpc_transport__free_unpacked(s_Transport, nullptr);
             memset(s_Buffer, 0, MaxBufferSize);
             break;
         }
@@ -231,17 +230,14 @@ void Connection::ConnectionThread(void* p_Connection)
         if (s_Transport->data.len > MaxBufferSize)
         {
             WriteLog(LL_Error, "transport data does not have enough data, wanted (%d), have (%d).", s_Transport->data.len, MaxBufferSize);
-            rpc_transport__free_unpacked(s_Transport, nullptr);
             memset(s_Buffer, 0, MaxBufferSize);
             break;
         }
 
         s_MessageManager->OnRequest(s_Connection, const_cast<const RpcTransport*>(s_Transport));
 
-        WriteLog(LL_Error, "here");
-
-        // Free the protobuf
-        rpc_transport__free_unpacked(s_Transport, nullptr);
+        // Release the transport and any scratch memory the handler used
+        s_Connection->m_Arena.Reset();
 
         // Zero out the header for use next iteration
         memset(s_Buffer, 0, MaxBufferSize);
@@ -252,6 +248,8 @@ void Connection::ConnectionThread(void* p_Connection)
     memset(s_Buffer, 0, MaxBufferSize);
     delete [] s_Buffer;
 
+    s_Connection->m_Arena.Destroy();
+
     WriteLog(LL_Error, "why did we get here (%d)", s_Connection->m_Running);
 
     // Cleans up resources
@@ -1,5 +1,7 @@
 #pragma once
 #include <Utils/Vector.hpp>
+#include <Utils/ObjectPool.hpp>
+#include <Utils/Arena.hpp>
 
 extern "C"
 {
@@ -41,7 +43,12 @@ namespace Mira
 
                 struct mtx m_Mutex;
 
+                // Scratch memory for the request currently being handled, reset after every request
+                Utils::Arena m_Arena;
+
             public:
+                MIRA_POOLED_OBJECT(Connection)
+
                 Connection(Rpc::Server* p_Server, uint32_t p_ClientId, int32_t p_Socket, struct sockaddr_in& p_Address);
                 virtual ~Connection();
 
@@ -59,6 +66,9 @@ namespace Mira
                 void** Internal_GetThread() { return &m_Thread; }
                 void* GetConnectionThread() { return m_Thread; }
 
+                // Only valid for the duration of the current request, handlers must not hold on to it
+                Utils::Arena* GetArena() { return &m_Arena; }
+
                 static void ConnectionThread(void* p_Connection);
             };
         }
@@ -53,7 +53,16 @@ bool Server::OnLoad()
 bool Server::OnUnload()
 {
     WriteLog(LL_Error, "unloading rpc server");
-    return Teardown();
+    if (!Teardown())
+        return false;
+
+    // Connections are only ever allocated by this server, their slabs go back once the last one is freed
+    if (GetUsedConnectionCount() == 0)
+        Mira::Utils::TypedObjectPool<Rpc::Connection>::s_Pool.Destroy();
+    else
+        WriteLog(LL_Warn, "connections still open, keeping their pool");
+
+    return true;
 }
 
 bool Server::OnSuspend()
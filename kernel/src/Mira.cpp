@@ -25,6 +25,8 @@
 #include <Messaging/Rpc/Server.hpp>
 
 #include <OrbisOS/Utilities.hpp>
+#include <OrbisOS/ProcessEvents.hpp>
+#include <OrbisOS/SblMapIndex.hpp>
 
 ///
 /// Utilities
@@ -35,6 +37,7 @@
 #include <Utils/SysWrappers.hpp>
 #include <Utils/Types.hpp>
 #include <Utils/Hook.hpp>
+#include <Utils/HookManager.hpp>
 #include <OrbisOS/Utilities.hpp>
 
 //
@@ -64,7 +67,7 @@ Mira::Framework* Mira::Framework::m_Instance = nullptr;
 Mira::Framework* Mira::Framework::GetFramework()
 {
 	if (m_Instance == nullptr)
-		m_Instance = new Mira::Framework();
+		m_Instance = new (Mira::Utils::MemoryTag_Framework) Mira::Framework();
 
 	return m_Instance;
 }
@@ -77,6 +80,9 @@ Mira::Framework::Framework() :
 	m_ShutdownTag(nullptr),
 	m_PluginManager(nullptr),
 	m_MessageManager(nullptr),
+	m_HookManager(nullptr),
+	m_ProcessEvents(nullptr),
+	m_SblMapIndex(nullptr),
 	m_CtrlDriver(nullptr)
 {
 
@@ -95,12 +101,8 @@ extern "C" void mira_entry(void* args)
 	// Fill the kernel base address
 	gKernelBase = (uint8_t*)kernelRdmsr(0xC0000082) - kdlsym_addr_Xfast_syscall;
 
-	cpu_disable_wp();
-
 	Mira::Boot::Patches::install_prePatches();
 
-	cpu_enable_wp();
-
     auto kthread_exit = (void(*)(void))kdlsym(kthread_exit);
 	//auto kproc_exit = (void(*)(int ecode))kdlsym(kproc_exit);
 	auto vmspace_alloc = (struct vmspace* (*)(vm_offset_t min, vm_offset_t max))kdlsym(vmspace_alloc);
@@ -110,6 +112,7 @@ extern "C" void mira_entry(void* args)
 
     // Let'em know we made it
 	printf("[+] mira has reached stage 2\n");
+	printf("[+] kernel patches: %u/%u in place\n", Mira::Boot::Patches::GetAppliedCount(), Mira::Boot::Patches::GetPatchCount());
 
     // These are the initialization parameters from the loader
     Mira::Boot::InitParams* initParams = static_cast<Mira::Boot::InitParams*>(args);
@@ -249,16 +252,43 @@ bool Mira::Framework::Initialize()
 
 	// Initialize message manager
 	WriteLog(LL_Debug, "Initializing the message manager");
-	m_MessageManager = new Mira::Messaging::MessageManager();
+	m_MessageManager = new (Mira::Utils::MemoryTag_Messaging) Mira::Messaging::MessageManager();
 	if (m_MessageManager == nullptr)
 	{
 		WriteLog(LL_Error, "could not allocate message manager.");
 		return false;
 	}
 
+	// Initialize hook manager, plugins stage their hooks with it while loading
+	WriteLog(LL_Debug, "Initializing the hook manager");
+	m_HookManager = new (Mira::Utils::MemoryTag_Hooks) Mira::Utils::HookManager();
+	if (m_HookManager == nullptr)
+	{
+		WriteLog(LL_Error, "could not allocate hook manager.");
+		return false;
+	}
+
+	// Initialize process events, plugins and the driver subscribe to it while loading
+	WriteLog(LL_Debug, "Initializing process events");
+	m_ProcessEvents = new (Mira::Utils::MemoryTag_Framework) Mira::OrbisOS::ProcessEvents();
+	if (m_ProcessEvents == nullptr)
+	{
+		WriteLog(LL_Error, "could not allocate process events.");
+		return false;
+	}
+
+	// Initialize the sbl map index, its hooks are installed together with the plugin ones
+	WriteLog(LL_Debug, "Initializing the sbl map index");
+	m_SblMapIndex = new (Mira::Utils::MemoryTag_Framework) Mira::OrbisOS::SblMapIndex();
+	if (m_SblMapIndex == nullptr)
+	{
+		WriteLog(LL_Error, "could not allocate sbl map index.");
+		return false;
+	}
+
 	// Initialize plugin manager
 	WriteLog(LL_Debug, "Initializing the plugin manager");
-	m_PluginManager = new Mira::Plugins::PluginManager();
+	m_PluginManager = new (Mira::Utils::MemoryTag_Plugins) Mira::Plugins::PluginManager();
 	if (m_PluginManager == nullptr)
 	{
 		WriteLog(LL_Error, "could not allocate plugin manager.");
@@ -273,6 +303,11 @@ bool Mira::Framework::Initialize()
 		return false;
 	}
 
+	// Install every hook the plugins staged at once
+	WriteLog(LL_Debug, "Installing (%d) hooks", m_HookManager->GetHookCount());
+	if (!m_HookManager->Commit())
+		WriteLog(LL_Error, "could not install all hooks");
+
 	// Install eventhandler's
 	WriteLog(LL_Debug, "Installing event handlers");
 	if (!InstallEventHandlers())
@@ -283,7 +318,7 @@ bool Mira::Framework::Initialize()
 
 	// Install device driver
 	WriteLog(LL_Warn, "Initializing the /dev/mira control driver");
-	m_CtrlDriver = new Mira::Driver::CtrlDriver();
+	m_CtrlDriver = new (Mira::Utils::MemoryTag_Driver) Mira::Driver::CtrlDriver();
 	if (m_CtrlDriver == nullptr)
 	{
 		WriteLog(LL_Error, "could not allocate control driver.");
@@ -297,6 +332,7 @@ bool Mira::Framework::Initialize()
   struct proc* ui_proc = Mira::OrbisOS::Utilities::FindProcessByName("SceShellUI");
   if (ui_proc) {
       Mira::OrbisOS::Utilities::KillProcess(ui_proc);
+      Mira::OrbisOS::Utilities::ReleaseProcess(ui_proc);
   } else {
       WriteLog(LL_Error, "Unable to find SceShellUI Process !");
   }
@@ -306,6 +342,10 @@ bool Mira::Framework::Initialize()
 
 bool Mira::Framework::Terminate()
 {
+	// Remove every hook at once before the plugins that own them go away
+	if (m_HookManager && !m_HookManager->DisableAll())
+		WriteLog(LL_Error, "could not disable all hooks");
+
 	// Unload the plugin manager
 	if (m_PluginManager && !m_PluginManager->OnUnload())
 		WriteLog(LL_Error, "could not unload plugin manager");
@@ -314,6 +354,14 @@ bool Mira::Framework::Terminate()
 	delete m_PluginManager;
 	m_PluginManager = nullptr;
 
+	// Free the sbl map index, this unregisters its hooks so it goes before the hook manager
+	delete m_SblMapIndex;
+	m_SblMapIndex = nullptr;
+
+	// Free the hook manager
+	delete m_HookManager;
+	m_HookManager = nullptr;
+
 	// Remove all eventhandlers
 	if (!RemoveEventHandlers())
 		WriteLog(LL_Error, "could not remove event handlers");
@@ -325,6 +373,13 @@ bool Mira::Framework::Terminate()
 		m_CtrlDriver = nullptr;
 	}
 
+	// Free process events, everything that subscribed is gone by now
+	delete m_ProcessEvents;
+	m_ProcessEvents = nullptr;
+
+	// Every hook was owned by something freed above, hand the pooled hook slabs back
+	Utils::TypedObjectPool<Utils::Hook>::s_Pool.Destroy();
+
 	// Update our running state, to allow the proc to terminate
 	m_InitParams.isRunning = false;
 
@@ -366,6 +421,8 @@ struct thread* Mira::Framework::GetSyscoreThread()
 	s_MainThread = FIRST_THREAD_IN_PROC(s_Process);
 	_mtx_unlock_flags(&s_Process->p_mtx, 0);
 
+	OrbisOS::Utilities::ReleaseProcess(s_Process);
+
 	return s_MainThread;
 }
 
@@ -386,6 +443,8 @@ struct thread* Mira::Framework::GetShellcoreThread()
 	s_MainThread = FIRST_THREAD_IN_PROC(s_Process);
 	_mtx_unlock_flags(&s_Process->p_mtx, 0);
 
+	OrbisOS::Utilities::ReleaseProcess(s_Process);
+
 	return s_MainThread;
 }
 
@@ -441,6 +500,15 @@ void Mira::Framework::OnMiraSuspend(void* __unused p_Reserved)
 
 	WriteLog(LL_Warn, "SUPSEND SUSPEND SUSPEND");
 
+	// Pull every hook in one window, plugins only have to unregister theirs after this
+	auto s_HookManager = GetFramework()->GetHookManager();
+	if (s_HookManager && !s_HookManager->DisableAll())
+		WriteLog(LL_Error, "could not disable all hooks");
+
+	auto s_SblMapIndex = GetFramework()->GetSblMapIndex();
+	if (s_SblMapIndex)
+		s_SblMapIndex->OnSuspend();
+
 	auto s_PluginManager = GetFramework()->m_PluginManager;
 	if (s_PluginManager)
 		s_PluginManager->OnSuspend();
@@ -457,6 +525,15 @@ void Mira::Framework::OnMiraResume(void* __unused p_Reserved)
 	auto s_PluginManager = GetFramework()->GetPluginManager();
 	if (s_PluginManager)
 		s_PluginManager->OnResume();
+
+	auto s_SblMapIndex = GetFramework()->GetSblMapIndex();
+	if (s_SblMapIndex)
+		s_SblMapIndex->OnResume();
+
+	// Reinstall everything the plugins staged while resuming
+	auto s_HookManager = GetFramework()->GetHookManager();
+	if (s_HookManager && !s_HookManager->Commit())
+		WriteLog(LL_Error, "could not install all hooks");
 }
 
 void Mira::Framework::OnMiraShutdown(void* __unused p_Reserved)
@@ -21,6 +21,8 @@ namespace Mira
     namespace OrbisOS
     {
         class ThreadManager;
+        class ProcessEvents;
+        class SblMapIndex;
     }
 
     namespace Driver
@@ -46,6 +48,7 @@ namespace Mira
     namespace Utils
     {
         class Hook;
+        class HookManager;
     }
 
     class Framework
@@ -61,6 +64,9 @@ namespace Mira
 
         Mira::Plugins::PluginManager* m_PluginManager;
         Mira::Messaging::MessageManager* m_MessageManager;
+        Mira::Utils::HookManager* m_HookManager;
+        Mira::OrbisOS::ProcessEvents* m_ProcessEvents;
+        Mira::OrbisOS::SblMapIndex* m_SblMapIndex;
 
         Mira::Driver::CtrlDriver* m_CtrlDriver;
 
@@ -83,6 +89,9 @@ namespace Mira
 
         Mira::Plugins::PluginManager* GetPluginManager() { return m_PluginManager; }
         Mira::Messaging::MessageManager* GetMessageManager() { return m_MessageManager; }
+        Mira::Utils::HookManager* GetHookManager() { return m_HookManager; }
+        Mira::OrbisOS::ProcessEvents* GetProcessEvents() { return m_ProcessEvents; }
+        Mira::OrbisOS::SblMapIndex* GetSblMapIndex() { return m_SblMapIndex; }
 
         struct thread* GetMainThread();
         struct thread* GetSyscoreThread();
@@ -0,0 +1,157 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "GpuVaIndex.hpp"
+#include <Utils/Kernel.hpp>
+#include <Utils/New.hpp>
+
+using namespace Mira::OrbisOS;
+
+GpuVaIndex::GpuVaIndex() :
+    m_Mappings(nullptr),
+    m_Count(0),
+    m_Capacity(0)
+{
+}
+
+GpuVaIndex::~GpuVaIndex()
+{
+    if (m_Mappings != nullptr)
+        delete [] m_Mappings;
+
+    m_Mappings = nullptr;
+    m_Count = 0;
+    m_Capacity = 0;
+}
+
+bool GpuVaIndex::Insert(uint64_t p_GpuVa, uint64_t p_Size, uint64_t p_Descriptor, SblMapListEntry* p_Entry)
+{
+    if (p_GpuVa == 0 || p_Entry == nullptr)
+        return false;
+
+    auto s_Index = LowerBound(p_GpuVa);
+    if (s_Index < m_Count && m_Mappings[s_Index].GpuVa == p_GpuVa)
+    {
+        auto& s_Mapping = m_Mappings[s_Index];
+        s_Mapping.Size = p_Size;
+        s_Mapping.Descriptor = p_Descriptor;
+        s_Mapping.Entry = p_Entry;
+        return true;
+    }
+
+    if (m_Count == m_Capacity && !Grow())
+        return false;
+
+    // New mappings usually land at the end, the GPU VA allocator hands them out going up
+    if (s_Index < m_Count)
+        memmove(&m_Mappings[s_Index + 1], &m_Mappings[s_Index], (m_Count - s_Index) * sizeof(GpuVaMapping));
+
+    auto& s_Mapping = m_Mappings[s_Index];
+    s_Mapping.GpuVa = p_GpuVa;
+    s_Mapping.Size = p_Size;
+    s_Mapping.Descriptor = p_Descriptor;
+    s_Mapping.Entry = p_Entry;
+    m_Count++;
+
+    return true;
+}
+
+SblMapListEntry* GpuVaIndex::Find(uint64_t p_GpuVa) const
+{
+    auto s_Index = LowerBound(p_GpuVa);
+    if (s_Index >= m_Count || m_Mappings[s_Index].GpuVa != p_GpuVa)
+        return nullptr;
+
+    return m_Mappings[s_Index].Entry;
+}
+
+SblMapListEntry* GpuVaIndex::FindContaining(uint64_t p_GpuVa) const
+{
+    auto s_Index = LowerBound(p_GpuVa);
+    if (s_Index < m_Count && m_Mappings[s_Index].GpuVa == p_GpuVa)
+        return m_Mappings[s_Index].Entry;
+
+    // Otherwise the only candidate is the mapping starting right before it
+    if (s_Index == 0)
+        return nullptr;
+
+    auto& s_Mapping = m_Mappings[s_Index - 1];
+    if (p_GpuVa - s_Mapping.GpuVa >= s_Mapping.Size)
+        return nullptr;
+
+    return s_Mapping.Entry;
+}
+
+bool GpuVaIndex::Remove(uint64_t p_GpuVa)
+{
+    auto s_Index = LowerBound(p_GpuVa);
+    if (s_Index >= m_Count || m_Mappings[s_Index].GpuVa != p_GpuVa)
+        return false;
+
+    RemoveAt(s_Index);
+    return true;
+}
+
+bool GpuVaIndex::RemoveDescriptor(uint64_t p_Descriptor)
+{
+    // Not sorted by descriptor, but unmapping shifts the tail anyway
+    for (uint32_t l_Index = 0; l_Index < m_Count; ++l_Index)
+    {
+        if (m_Mappings[l_Index].Descriptor != p_Descriptor)
+            continue;
+
+        RemoveAt(l_Index);
+        return true;
+    }
+
+    return false;
+}
+
+void GpuVaIndex::Clear()
+{
+    m_Count = 0;
+}
+
+uint32_t GpuVaIndex::LowerBound(uint64_t p_GpuVa) const
+{
+    uint32_t s_Low = 0;
+    uint32_t s_High = m_Count;
+    while (s_Low < s_High)
+    {
+        auto l_Middle = s_Low + ((s_High - s_Low) / 2);
+        if (m_Mappings[l_Middle].GpuVa < p_GpuVa)
+            s_Low = l_Middle + 1;
+        else
+            s_High = l_Middle;
+    }
+
+    return s_Low;
+}
+
+void GpuVaIndex::RemoveAt(uint32_t p_Index)
+{
+    if (p_Index + 1 < m_Count)
+        memmove(&m_Mappings[p_Index], &m_Mappings[p_Index + 1], (m_Count - p_Index - 1) * sizeof(GpuVaMapping));
+
+    m_Count--;
+}
+
+bool GpuVaIndex::Grow()
+{
+    auto s_Capacity = m_Capacity == 0 ? static_cast<uint32_t>(GpuVaIndex_InitialCapacity) : m_Capacity * 2;
+
+    auto s_Mappings = new (Utils::MemoryTag_Framework) GpuVaMapping[s_Capacity];
+    if (s_Mappings == nullptr)
+        return false;
+
+    if (m_Mappings != nullptr)
+    {
+        memcpy(s_Mappings, m_Mappings, m_Count * sizeof(GpuVaMapping));
+        delete [] m_Mappings;
+    }
+
+    m_Mappings = s_Mappings;
+    m_Capacity = s_Capacity;
+
+    return true;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <Utils/Types.hpp>
+#include <OrbisOS/FakeStructs.hpp>
+
+namespace Mira
+{
+    namespace OrbisOS
+    {
+        enum
+        {
+            // Mappings the index starts with, the SBL rarely has more than a few dozen at once
+            GpuVaIndex_InitialCapacity = 32,
+        };
+
+        struct GpuVaMapping
+        {
+            uint64_t GpuVa;
+            uint64_t Size;
+
+            // gpu_desc handed out by sceSblDriverMapPages, what sceSblDriverUnmapPages is called with
+            uint64_t Descriptor;
+
+            SblMapListEntry* Entry;
+        };
+
+        /*
+            GpuVaIndex
+
+            GPU VA -> mapped page list index, kept as an array sorted by GPU VA so a lookup is a
+            binary search instead of a walk over gpu_va_page_list. Mappings handed out by the SBL
+            never overlap, inserting one whose start is already indexed replaces it.
+
+            Not locked, the owner serializes every call. Growing allocates with M_NOWAIT, when it
+            fails the mapping is simply not indexed and Insert returns false.
+        */
+        class GpuVaIndex
+        {
+        private:
+            GpuVaMapping* m_Mappings;
+            uint32_t m_Count;
+            uint32_t m_Capacity;
+
+        public:
+            GpuVaIndex();
+            ~GpuVaIndex();
+
+            bool Insert(uint64_t p_GpuVa, uint64_t p_Size, uint64_t p_Descriptor, SblMapListEntry* p_Entry);
+
+            // Mapping starting exactly at p_GpuVa, this is what mailbox messages reference
+            SblMapListEntry* Find(uint64_t p_GpuVa) const;
+
+            // Mapping whose range holds p_GpuVa
+            SblMapListEntry* FindContaining(uint64_t p_GpuVa) const;
+
+            bool Remove(uint64_t p_GpuVa);
+            bool RemoveDescriptor(uint64_t p_Descriptor);
+
+            void Clear();
+
+            uint32_t GetCount() const { return m_Count; }
+
+        private:
+            // Index of the first mapping starting at or after p_GpuVa
+            uint32_t LowerBound(uint64_t p_GpuVa) const;
+
+            void RemoveAt(uint32_t p_Index);
+            bool Grow();
+        };
+    }
+}
@@ -0,0 +1,365 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "PatchSet.hpp"
+#include "Utilities.hpp"
+#include <Utils/Logger.hpp>
+
+extern "C"
+{
+    #include <sys/errno.h>
+    #include <sys/mman.h>
+};
+
+using namespace Mira::OrbisOS;
+
+PatchSet::PatchSet(const char* p_Name, const PatchSetEntry* p_Entries, uint32_t p_Count, PatchSetRecord* p_Record) :
+    m_Name(p_Name),
+    m_Entries(p_Entries),
+    m_Count(p_Entries == nullptr ? 0 : p_Count),
+    m_Record(p_Record)
+{
+    Reset();
+}
+
+void PatchSet::Reset()
+{
+    memset(m_Addresses, 0, sizeof(m_Addresses));
+    memset(m_Original, 0, sizeof(m_Original));
+    memset(m_Status, 0, sizeof(m_Status));
+}
+
+int32_t PatchSet::Apply(struct ::proc* p_Process)
+{
+    if (p_Process == nullptr)
+        return -EINVAL;
+
+    if (m_Count == 0)
+        return 0;
+
+    // Patched processes have just exec'd, a copy of their map would never be reused. Only the
+    // text of each module is needed, which a filtered query copies without an allocation
+    ProcVmMapEntry s_Map[PatchSet_MaxModules];
+    size_t s_MapCount = 0;
+
+    auto s_Ret = QueryModules(p_Process, s_Map, &s_MapCount);
+    if (s_Ret < 0)
+        return s_Ret;
+
+    return Apply(p_Process, s_Map, s_MapCount);
+}
+
+int32_t PatchSet::QueryModules(struct ::proc* p_Process, ProcVmMapEntry* p_Map, size_t* p_MapCount)
+{
+    *p_MapCount = 0;
+
+    uint32_t s_ModuleCount = 0;
+    for (uint32_t l_Index = 0; l_Index < m_Count && l_Index < PatchSet_MaxPatches; ++l_Index)
+    {
+        auto l_Module = m_Entries[l_Index].Module;
+
+        auto l_Queried = false;
+        for (uint32_t l_Previous = 0; l_Previous < l_Index && !l_Queried; ++l_Previous)
+            l_Queried = IsSameModule(m_Entries[l_Previous].Module, l_Module);
+
+        if (l_Queried)
+            continue;
+
+        if (s_ModuleCount++ >= PatchSet_MaxModules)
+        {
+            WriteLog(LL_Error, "%s: too many modules, (%d) supported.", m_Name, PatchSet_MaxModules);
+            return -E2BIG;
+        }
+
+        size_t l_Found = 0;
+        auto l_Ret = Utilities::QueryProcessVmMap(p_Process, GetModuleFilter(l_Module), &p_Map[*p_MapCount], 1, &l_Found);
+        if (l_Ret < 0)
+        {
+            WriteLog(LL_Error, "%s: could not query vm map (%d).", m_Name, l_Ret);
+            return l_Ret;
+        }
+
+        // A module that is not mapped is reported per patch by Resolve
+        if (l_Found > 0)
+            (*p_MapCount)++;
+    }
+
+    return 0;
+}
+
+int32_t PatchSet::Apply(struct ::proc* p_Process, const ProcVmMapEntry* p_Map, size_t p_MapCount)
+{
+    Reset();
+
+    if (m_Count > PatchSet_MaxPatches)
+    {
+        WriteLog(LL_Error, "%s: too many patches (%u).", m_Name, m_Count);
+        return -E2BIG;
+    }
+
+    for (uint32_t l_Index = 0; l_Index < m_Count; ++l_Index)
+    {
+        auto& l_Entry = m_Entries[l_Index];
+        if (l_Entry.Replacement == nullptr || l_Entry.Size == 0 || l_Entry.Size > PatchSet_MaxPatchSize)
+        {
+            WriteLog(LL_Error, "%s: invalid patch (%s).", m_Name, l_Entry.Name);
+            return -EINVAL;
+        }
+    }
+
+    int32_t s_Ret = 0;
+    do
+    {
+        if (!Resolve(p_Map, p_MapCount))
+        {
+            s_Ret = -ENOENT;
+            break;
+        }
+
+        // Read and check everything before the first write
+        for (uint32_t l_Index = 0; l_Index < m_Count; ++l_Index)
+        {
+            auto& l_Entry = m_Entries[l_Index];
+
+            auto l_Ret = Utilities::ProcessReadWriteMemory(p_Process, reinterpret_cast<void*>(m_Addresses[l_Index]), l_Entry.Size, m_Original[l_Index], nullptr, false);
+            if (l_Ret < 0)
+            {
+                m_Status[l_Index] = PatchStatus::ReadFailed;
+                if (s_Ret == 0)
+                    s_Ret = l_Ret;
+                continue;
+            }
+
+            m_Status[l_Index] = Verify(l_Entry, m_Original[l_Index], GetRecorded(l_Index));
+            if (m_Status[l_Index] == PatchStatus::Mismatch && s_Ret == 0)
+                s_Ret = -EILSEQ;
+        }
+
+        if (s_Ret < 0)
+            break;
+
+        for (uint32_t l_Index = 0; l_Index < m_Count; ++l_Index)
+        {
+            if (m_Status[l_Index] != PatchStatus::Pending)
+                continue;
+
+            auto& l_Entry = m_Entries[l_Index];
+
+            auto l_Ret = Utilities::ProcessReadWriteMemory(p_Process, reinterpret_cast<void*>(m_Addresses[l_Index]), l_Entry.Size, const_cast<uint8_t*>(l_Entry.Replacement), nullptr, true);
+            if (l_Ret < 0)
+            {
+                m_Status[l_Index] = PatchStatus::WriteFailed;
+                Rollback(p_Process, l_Index);
+                s_Ret = l_Ret;
+                break;
+            }
+
+            m_Status[l_Index] = PatchStatus::Applied;
+        }
+
+        if (s_Ret == 0)
+            Record();
+    } while (false);
+
+    LogResults();
+
+    return s_Ret;
+}
+
+bool PatchSet::Resolve(const ProcVmMapEntry* p_Map, size_t p_MapCount)
+{
+    if (m_Count > PatchSet_MaxPatches)
+        return false;
+
+    auto s_Resolved = true;
+    for (uint32_t l_Index = 0; l_Index < m_Count; ++l_Index)
+    {
+        auto& l_Entry = m_Entries[l_Index];
+
+        // Patches of one module are usually next to each other in the table
+        uint64_t l_Start = 0;
+        if (l_Index > 0 && m_Addresses[l_Index - 1] != 0 && m_Entries[l_Index - 1].Module == l_Entry.Module)
+            l_Start = m_Addresses[l_Index - 1] - m_Entries[l_Index - 1].Offset;
+        else
+            l_Start = FindModule(p_Map, p_MapCount, l_Entry.Module);
+
+        if (l_Start == 0)
+        {
+            m_Addresses[l_Index] = 0;
+            m_Status[l_Index] = PatchStatus::ModuleNotFound;
+            s_Resolved = false;
+            continue;
+        }
+
+        m_Addresses[l_Index] = l_Start + l_Entry.Offset;
+    }
+
+    return s_Resolved;
+}
+
+PatchStatus PatchSet::Verify(const PatchSetEntry& p_Entry, const uint8_t* p_Current, const uint8_t* p_Recorded)
+{
+    if (p_Current == nullptr || p_Entry.Replacement == nullptr)
+        return PatchStatus::Mismatch;
+
+    if (memcmp(p_Current, p_Entry.Replacement, p_Entry.Size) == 0)
+        return PatchStatus::AlreadyApplied;
+
+    auto s_Expected = p_Entry.Expected != nullptr ? p_Entry.Expected : p_Recorded;
+    if (s_Expected != nullptr && memcmp(p_Current, s_Expected, p_Entry.Size) != 0)
+        return PatchStatus::Mismatch;
+
+    return PatchStatus::Pending;
+}
+
+const uint8_t* PatchSet::GetRecorded(uint32_t p_Index) const
+{
+    if (m_Record == nullptr || p_Index >= PatchSet_MaxPatches)
+        return nullptr;
+
+    if ((m_Record->RecordedMask & (1U << p_Index)) == 0)
+        return nullptr;
+
+    return m_Record->Bytes[p_Index];
+}
+
+void PatchSet::Record()
+{
+    if (m_Record == nullptr)
+        return;
+
+    for (uint32_t l_Index = 0; l_Index < m_Count; ++l_Index)
+    {
+        // Tables with expected bytes already have what a record would hold
+        if (m_Status[l_Index] != PatchStatus::Applied || m_Entries[l_Index].Expected != nullptr)
+            continue;
+
+        if ((m_Record->RecordedMask & (1U << l_Index)) != 0)
+            continue;
+
+        memcpy(m_Record->Bytes[l_Index], m_Original[l_Index], m_Entries[l_Index].Size);
+        m_Record->RecordedMask |= (1U << l_Index);
+    }
+}
+
+uint64_t PatchSet::FindModule(const ProcVmMapEntry* p_Map, size_t p_MapCount, const char* p_Module)
+{
+    if (p_Map == nullptr)
+        return 0;
+
+    auto s_ModuleLength = p_Module == nullptr ? 0 : strlen(p_Module);
+    if (s_ModuleLength > sizeof(p_Map->name))
+        return 0;
+
+    for (size_t l_Index = 0; l_Index < p_MapCount; ++l_Index)
+    {
+        auto& l_Map = p_Map[l_Index];
+
+        if (p_Module == nullptr)
+        {
+            if (l_Map.prot == (PROT_READ | PROT_EXEC))
+                return l_Map.start;
+
+            continue;
+        }
+
+        if (l_Map.prot >= (PROT_READ | PROT_EXEC) && memcmp(l_Map.name, p_Module, s_ModuleLength) == 0)
+            return l_Map.start;
+    }
+
+    return 0;
+}
+
+VmMapFilter PatchSet::GetModuleFilter(const char* p_Module)
+{
+    if (p_Module == nullptr)
+        return VmMapQuery::Protected(PROT_READ | PROT_EXEC);
+
+    // FindModule takes prot >= r-x, text is the first of those with both bits
+    auto s_Filter = VmMapQuery::Named(p_Module);
+    s_Filter.Prot = PROT_READ | PROT_EXEC;
+    s_Filter.ProtMask = PROT_READ | PROT_EXEC;
+    return s_Filter;
+}
+
+bool PatchSet::IsSameModule(const char* p_Module, const char* p_Other)
+{
+    if (p_Module == nullptr || p_Other == nullptr)
+        return p_Module == p_Other;
+
+    return strcmp(p_Module, p_Other) == 0;
+}
+
+uint32_t PatchSet::GetAppliedMask() const
+{
+    uint32_t s_Mask = 0;
+    for (uint32_t l_Index = 0; l_Index < m_Count && l_Index < PatchSet_MaxPatches; ++l_Index)
+    {
+        if (m_Status[l_Index] == PatchStatus::Applied || m_Status[l_Index] == PatchStatus::AlreadyApplied)
+            s_Mask |= (1U << l_Index);
+    }
+
+    return s_Mask;
+}
+
+const char* PatchSet::GetStatusName(PatchStatus p_Status)
+{
+    switch (p_Status)
+    {
+    case PatchStatus::Pending:
+        return "pending";
+    case PatchStatus::Applied:
+        return "applied";
+    case PatchStatus::AlreadyApplied:
+        return "already applied";
+    case PatchStatus::ModuleNotFound:
+        return "module not found";
+    case PatchStatus::Mismatch:
+        return "unexpected bytes";
+    case PatchStatus::ReadFailed:
+        return "read failed";
+    case PatchStatus::WriteFailed:
+        return "write failed";
+    case PatchStatus::RolledBack:
+        return "rolled back";
+    }
+
+    return "unknown";
+}
+
+void PatchSet::Rollback(struct ::proc* p_Process, uint32_t p_Count)
+{
+    for (uint32_t l_Index = 0; l_Index < p_Count; ++l_Index)
+    {
+        if (m_Status[l_Index] != PatchStatus::Applied)
+            continue;
+
+        auto l_Ret = Utilities::ProcessReadWriteMemory(p_Process, reinterpret_cast<void*>(m_Addresses[l_Index]), m_Entries[l_Index].Size, m_Original[l_Index], nullptr, true);
+        if (l_Ret < 0)
+        {
+            // Nothing more can be done about this one, it stays reported as applied
+            WriteLog(LL_Error, "%s: could not roll back %s (%d).", m_Name, m_Entries[l_Index].Name, l_Ret);
+            continue;
+        }
+
+        m_Status[l_Index] = PatchStatus::RolledBack;
+    }
+}
+
+void PatchSet::LogResults() const
+{
+    uint32_t s_Applied = 0;
+    for (uint32_t l_Index = 0; l_Index < m_Count; ++l_Index)
+    {
+        auto l_Status = m_Status[l_Index];
+        if (l_Status == PatchStatus::Applied || l_Status == PatchStatus::AlreadyApplied)
+        {
+            s_Applied++;
+            continue;
+        }
+
+        WriteLog(LL_Error, "%s: %s (%p) %s", m_Name, m_Entries[l_Index].Name, m_Addresses[l_Index], GetStatusName(l_Status));
+    }
+
+    WriteLog(s_Applied == m_Count ? LL_Debug : LL_Error, "%s: %u/%u patches in place (mask %x)", m_Name, s_Applied, m_Count, GetAppliedMask());
+}
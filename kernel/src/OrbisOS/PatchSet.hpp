@@ -0,0 +1,162 @@
+#pragma once
+#include <Utils/Types.hpp>
+#include <Utils/Kernel.hpp>
+#include <OrbisOS/VmMapQuery.hpp>
+
+struct proc;
+
+namespace Mira
+{
+    namespace OrbisOS
+    {
+        enum
+        {
+            // Patches one set can hold, the applied patches are reported as a mask of this many bits
+            PatchSet_MaxPatches = 32,
+
+            // Largest single patch, the original bytes are kept for a rollback
+            PatchSet_MaxPatchSize = 16,
+
+            // Different modules one set can patch, each is looked up in the vm map once
+            PatchSet_MaxModules = 4,
+        };
+
+        enum class PatchStatus : uint8_t
+        {
+            // Not looked at, or not written because another patch of the set failed
+            Pending,
+
+            Applied,
+
+            // The replacement bytes were already there, a resume or restart of the process
+            AlreadyApplied,
+
+            ModuleNotFound,
+
+            // Neither the expected nor the replacement bytes are at the patch address
+            Mismatch,
+
+            ReadFailed,
+            WriteFailed,
+
+            // Written, then restored because a later write of the set failed
+            RolledBack,
+        };
+
+        struct PatchSetEntry
+        {
+            const char* Name;
+
+            // Prefix of the vm map entry name of the module, the first mapping with prot >= r-x is patched.
+            // nullptr is the first mapping that is exactly r-x, the text of the main executable
+            const char* Module;
+
+            uint64_t Offset;
+
+            // Bytes that have to be at the patch address, nullptr when they are not known (the bytes
+            // found there the first time are recorded then, see PatchSetRecord)
+            const uint8_t* Expected;
+            const uint8_t* Replacement;
+
+            uint32_t Size;
+        };
+
+        /*
+            PatchSetRecord
+
+            The bytes a set overwrote the first time it went in, kept by the caller across applies
+            (a function static next to the table). A patch without expected bytes is verified
+            against them on every later apply, so a process that changed under the patch is left
+            alone instead of being written blindly. Only a set applied in full is recorded, and
+            patches that were already in place have nothing to record.
+        */
+        struct PatchSetRecord
+        {
+            // Bit n is set once patch n is recorded
+            uint32_t RecordedMask;
+            uint8_t Bytes[PatchSet_MaxPatches][PatchSet_MaxPatchSize];
+        };
+
+        /*
+            PatchSet
+
+            A table of process patches applied as a unit. One filtered query of the vm map per module
+            of the table finds its text, all patch addresses are read and verified before the first write,
+            and nothing is written unless every patch checks out. A write failing half way through
+            restores the bytes of the patches already written, so a process is never left half
+            patched.
+
+            Patches whose replacement is already in place count as applied, applying the same set
+            again after a resume is harmless. Patches the table has no expected bytes for are checked
+            against a PatchSetRecord when the caller keeps one. The status of every patch is kept for
+            reporting.
+
+            Resolve and Verify only look at the data they are given and build for the host too.
+        */
+        class PatchSet
+        {
+        private:
+            const char* m_Name;
+            const PatchSetEntry* m_Entries;
+            uint32_t m_Count;
+
+            uint64_t m_Addresses[PatchSet_MaxPatches];
+            uint8_t m_Original[PatchSet_MaxPatches][PatchSet_MaxPatchSize];
+            PatchStatus m_Status[PatchSet_MaxPatches];
+
+            // Bytes recorded by earlier applies of the table, nullptr when the caller keeps none
+            PatchSetRecord* m_Record;
+
+        public:
+            PatchSet(const char* p_Name, const PatchSetEntry* p_Entries, uint32_t p_Count, PatchSetRecord* p_Record = nullptr);
+
+            // Resolves the addresses and applies the whole set, 0 or a negative errno
+            int32_t Apply(struct ::proc* p_Process);
+
+            // Same with the vm map of p_Process already at hand
+            int32_t Apply(struct ::proc* p_Process, const ProcVmMapEntry* p_Map, size_t p_MapCount);
+
+            // Works out every patch address from p_Map, false when a module is not mapped
+            bool Resolve(const ProcVmMapEntry* p_Map, size_t p_MapCount);
+
+            // What to do with a patch whose address currently holds p_Current: Pending to write it,
+            // AlreadyApplied or Mismatch. p_Recorded stands in for the expected bytes the entry lacks
+            static PatchStatus Verify(const PatchSetEntry& p_Entry, const uint8_t* p_Current, const uint8_t* p_Recorded = nullptr);
+
+            // Text start of p_Module (see PatchSetEntry::Module), 0 when it is not mapped
+            static uint64_t FindModule(const ProcVmMapEntry* p_Map, size_t p_MapCount, const char* p_Module);
+
+            // Map entries FindModule could pick for p_Module, so a query returns its text and little else
+            static VmMapFilter GetModuleFilter(const char* p_Module);
+
+            const char* GetName() const { return m_Name; }
+            uint32_t GetCount() const { return m_Count; }
+
+            PatchStatus GetStatus(uint32_t p_Index) const { return p_Index < m_Count && p_Index < PatchSet_MaxPatches ? m_Status[p_Index] : PatchStatus::Pending; }
+            uint64_t GetAddress(uint32_t p_Index) const { return p_Index < m_Count && p_Index < PatchSet_MaxPatches ? m_Addresses[p_Index] : 0; }
+
+            // Bit n is set when patch n is in place, Applied or AlreadyApplied
+            uint32_t GetAppliedMask() const;
+
+            static const char* GetStatusName(PatchStatus p_Status);
+
+        private:
+            void Reset();
+
+            // Text entry of every module of the table, as many entries as modules that are mapped
+            int32_t QueryModules(struct ::proc* p_Process, ProcVmMapEntry* p_Map, size_t* p_MapCount);
+            static bool IsSameModule(const char* p_Module, const char* p_Other);
+
+            // Recorded bytes of patch p_Index, nullptr when there are none
+            const uint8_t* GetRecorded(uint32_t p_Index) const;
+
+            // Keeps the bytes every patch written by this apply replaced
+            void Record();
+
+            // Writes the saved bytes back over every patch written so far
+            void Rollback(struct ::proc* p_Process, uint32_t p_Count);
+
+            void LogResults() const;
+        };
+    }
+}
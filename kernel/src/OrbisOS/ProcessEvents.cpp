@@ -0,0 +1,445 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "ProcessEvents.hpp"
+#include <Mira.hpp>
+#include <Utils/Kdlsym.hpp>
+#include <Utils/Kernel.hpp>
+#include <Utils/Logger.hpp>
+
+extern "C"
+{
+    #include <sys/eventhandler.h>
+    #include <sys/lock.h>
+    #include <sys/mutex.h>
+    #include <sys/systm.h>
+    #include <sys/proc.h>
+    #include <sys/filedesc.h>
+    #include <sys/malloc.h>
+};
+
+using namespace Mira::OrbisOS;
+
+ProcessInfo::ProcessInfo(struct proc* p_Process) :
+    Process(p_Process),
+    Thread(nullptr),
+    ProcessId(-1),
+    Sandboxed(false),
+    m_SandboxPathResolved(false),
+    m_SandboxPath(nullptr),
+    m_SandboxFreePath(nullptr)
+{
+    memset(TitleId, 0, sizeof(TitleId));
+    memset(Name, 0, sizeof(Name));
+
+    if (p_Process == nullptr)
+        return;
+
+    Thread = FIRST_THREAD_IN_PROC(p_Process);
+    ProcessId = p_Process->p_pid;
+
+    // Not null terminated when it uses all of its bytes
+    auto s_TitleId = (const char*)((uint64_t)p_Process + 0x390);
+    for (auto l_Index = 0; l_Index < ProcessEvents_TitleIdLength - 1 && s_TitleId[l_Index] != '\0'; ++l_Index)
+        TitleId[l_Index] = s_TitleId[l_Index];
+
+    static_assert(sizeof(Name) >= sizeof(p_Process->p_comm), "process name does not fit");
+    memcpy(Name, p_Process->p_comm, sizeof(p_Process->p_comm));
+    Name[sizeof(Name) - 1] = '\0';
+
+    auto s_RootVnode = *(struct vnode**)kdlsym(rootvnode);
+    auto s_Descriptors = p_Process->p_fd;
+    Sandboxed = s_Descriptors != nullptr && s_Descriptors->fd_jdir != nullptr && s_Descriptors->fd_jdir != s_RootVnode;
+}
+
+ProcessInfo::~ProcessInfo()
+{
+    auto free = (void(*)(void* addr, struct malloc_type* type))kdlsym(free);
+    auto M_TEMP = (struct malloc_type*)kdlsym(M_TEMP);
+
+    if (m_SandboxFreePath != nullptr)
+        free(m_SandboxFreePath, M_TEMP);
+
+    m_SandboxFreePath = nullptr;
+    m_SandboxPath = nullptr;
+}
+
+const char* ProcessInfo::GetSandboxPath()
+{
+    auto vn_fullpath = (int(*)(struct thread *td, struct vnode *vp, char **retbuf, char **freebuf))kdlsym(vn_fullpath);
+
+    if (m_SandboxPathResolved)
+        return m_SandboxPath;
+
+    m_SandboxPathResolved = true;
+
+    if (!Sandboxed)
+        return nullptr;
+
+    // Resolved from Mira's own thread, which is not jailed, to get the path from the real root
+    auto s_MainThread = Mira::Framework::GetFramework()->GetMainThread();
+    if (s_MainThread == nullptr)
+    {
+        WriteLog(LL_Error, "[%s] could not get main thread to resolve the sandbox path.", TitleId);
+        return nullptr;
+    }
+
+    auto s_Ret = vn_fullpath(s_MainThread, Process->p_fd->fd_jdir, &m_SandboxPath, &m_SandboxFreePath);
+    if (s_Ret != 0)
+    {
+        WriteLog(LL_Error, "[%s] could not resolve the sandbox path (%d).", TitleId, s_Ret);
+        m_SandboxPath = nullptr;
+    }
+
+    return m_SandboxPath;
+}
+
+ProcessEvents::ProcessEvents() :
+    m_ForkTag(nullptr),
+    m_ExecEndTag(nullptr),
+    m_ExitTag(nullptr)
+{
+    auto sx_init_flags = (void(*)(struct sx* sx, const char* description, int opts))kdlsym(_sx_init_flags);
+    auto eventhandler_register = (eventhandler_tag(*)(struct eventhandler_list *list, const char *name, void *func, void *arg, int priority))kdlsym(eventhandler_register);
+
+    memset(m_Subscribers, 0, sizeof(m_Subscribers));
+    memset(m_SubscriberCount, 0, sizeof(m_SubscriberCount));
+
+    sx_init_flags(&m_Lock, "MiraProcEvents", 0);
+    sx_init_flags(&m_IndexLock, "MiraProcIndex", 0);
+
+    m_ForkTag = EVENTHANDLER_REGISTER(process_fork, reinterpret_cast<void*>(OnProcessFork), this, EVENTHANDLER_PRI_ANY);
+    m_ExecEndTag = EVENTHANDLER_REGISTER(process_exec_end, reinterpret_cast<void*>(OnProcessExecEnd), this, EVENTHANDLER_PRI_ANY);
+    m_ExitTag = EVENTHANDLER_REGISTER(process_exit, reinterpret_cast<void*>(OnProcessExit), this, EVENTHANDLER_PRI_ANY);
+
+    // After registering, a process forked in between is found twice and indexed once
+    PopulateIndex();
+}
+
+ProcessEvents::~ProcessEvents()
+{
+    auto eventhandler_deregister = (void(*)(struct eventhandler_list* a, struct eventhandler_entry* b))kdlsym(eventhandler_deregister);
+    auto eventhandler_find_list = (struct eventhandler_list * (*)(const char *name))kdlsym(eventhandler_find_list);
+
+    if (m_ForkTag) {
+        EVENTHANDLER_DEREGISTER(process_fork, m_ForkTag);
+        m_ForkTag = nullptr;
+    }
+
+    if (m_ExecEndTag) {
+        EVENTHANDLER_DEREGISTER(process_exec_end, m_ExecEndTag);
+        m_ExecEndTag = nullptr;
+    }
+
+    if (m_ExitTag) {
+        EVENTHANDLER_DEREGISTER(process_exit, m_ExitTag);
+        m_ExitTag = nullptr;
+    }
+
+    // Deregistering does not wait for handlers that are still running, it only marks them dead
+    WaitForHandlers("process_fork");
+    WaitForHandlers("process_exec_end");
+    WaitForHandlers("process_exit");
+
+    // Nothing can take the locks anymore
+    DestroyLock(&m_IndexLock);
+    DestroyLock(&m_Lock);
+}
+
+void ProcessEvents::WaitForHandlers(const char* p_ListName)
+{
+    auto eventhandler_find_list = (struct eventhandler_list * (*)(const char *name))kdlsym(eventhandler_find_list);
+    auto _mtx_lock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_unlock_flags);
+    auto pause = (int(*)(const char *wmesg, int timo))kdlsym(pause);
+
+    // Returned locked. el_runcount covers every invoke of the list, including one that picked
+    // our entry before it was marked dead and has not called it yet
+    auto s_List = eventhandler_find_list(p_ListName);
+    if (s_List == nullptr)
+        return;
+
+    // Invoke does not wake anyone when it finishes, check again every tick
+    while (s_List->el_runcount != 0)
+    {
+        EHL_UNLOCK(s_List);
+        pause("MiraEvhDrain", 1);
+        EHL_LOCK(s_List);
+    }
+
+    EHL_UNLOCK(s_List);
+}
+
+void ProcessEvents::DestroyLock(struct sx* p_Lock)
+{
+    // sx_destroy has no kdlsym, this is all it does without WITNESS and INVARIANTS
+    p_Lock->sx_lock = SX_LOCK_DESTROYED;
+    p_Lock->lock_object.lo_flags &= ~LO_INITIALIZED;
+}
+
+int32_t ProcessEvents::Subscribe(ProcessEventType p_Type, const ProcessEventFilter& p_Filter, ProcessEventCallback p_Callback, void* p_Argument)
+{
+    auto __sx_xlock = (int (*)(struct sx *sx, int opts, const char* file, int line))kdlsym(_sx_xlock);
+    auto __sx_xunlock = (int (*)(struct sx *sx, const char* file, int line))kdlsym(_sx_xunlock);
+
+    if (p_Type >= ProcessEvent_Max || p_Callback == nullptr)
+        return -1;
+
+    int32_t s_SubscriptionId = -1;
+
+    __sx_xlock(&m_Lock, 0, __FILE__, __LINE__);
+    for (auto l_Index = 0; l_Index < ProcessEvents_MaxSubscribers; ++l_Index)
+    {
+        auto& l_Subscriber = m_Subscribers[l_Index];
+        if (l_Subscriber.Used)
+            continue;
+
+        l_Subscriber.Used = true;
+        l_Subscriber.Type = p_Type;
+        l_Subscriber.Filter = p_Filter;
+        l_Subscriber.Callback = p_Callback;
+        l_Subscriber.Argument = p_Argument;
+
+        // Filters are compared as strings, make sure they end
+        l_Subscriber.Filter.TitleId[sizeof(l_Subscriber.Filter.TitleId) - 1] = '\0';
+        l_Subscriber.Filter.Name[sizeof(l_Subscriber.Filter.Name) - 1] = '\0';
+
+        m_SubscriberCount[p_Type]++;
+        s_SubscriptionId = l_Index;
+        break;
+    }
+    __sx_xunlock(&m_Lock, __FILE__, __LINE__);
+
+    if (s_SubscriptionId < 0)
+        WriteLog(LL_Error, "no free process event subscriber, (%d) in use.", ProcessEvents_MaxSubscribers);
+
+    return s_SubscriptionId;
+}
+
+void ProcessEvents::Unsubscribe(int32_t p_SubscriptionId)
+{
+    auto __sx_xlock = (int (*)(struct sx *sx, int opts, const char* file, int line))kdlsym(_sx_xlock);
+    auto __sx_xunlock = (int (*)(struct sx *sx, const char* file, int line))kdlsym(_sx_xunlock);
+
+    if (p_SubscriptionId < 0 || p_SubscriptionId >= ProcessEvents_MaxSubscribers)
+        return;
+
+    // Waits for callbacks that are still running
+    __sx_xlock(&m_Lock, 0, __FILE__, __LINE__);
+
+    auto& s_Subscriber = m_Subscribers[p_SubscriptionId];
+    if (s_Subscriber.Used)
+    {
+        m_SubscriberCount[s_Subscriber.Type]--;
+        memset(&s_Subscriber, 0, sizeof(s_Subscriber));
+    }
+
+    __sx_xunlock(&m_Lock, __FILE__, __LINE__);
+}
+
+void ProcessEvents::Dispatch(ProcessEventType p_Type, struct proc* p_Process)
+{
+    auto __sx_slock = (int (*)(struct sx *sx, int opts, const char* file, int line))kdlsym(_sx_slock);
+    auto __sx_sunlock = (void (*)(struct sx *sx, const char* file, int line))kdlsym(_sx_sunlock);
+
+    if (p_Process == nullptr)
+        return;
+
+    // Most of the time nobody is listening, skip building the info
+    if (m_SubscriberCount[p_Type] == 0)
+        return;
+
+    ProcessInfo s_Info(p_Process);
+
+    __sx_slock(&m_Lock, 0, __FILE__, __LINE__);
+    for (auto l_Index = 0; l_Index < ProcessEvents_MaxSubscribers; ++l_Index)
+    {
+        auto& l_Subscriber = m_Subscribers[l_Index];
+        if (!l_Subscriber.Used || l_Subscriber.Type != p_Type)
+            continue;
+
+        if (!Matches(l_Subscriber.Filter, s_Info))
+            continue;
+
+        l_Subscriber.Callback(&s_Info, l_Subscriber.Argument);
+    }
+    __sx_sunlock(&m_Lock, __FILE__, __LINE__);
+}
+
+bool ProcessEvents::Matches(const ProcessEventFilter& p_Filter, const ProcessInfo& p_Info)
+{
+    if ((p_Filter.Flags & ProcessEventFilter_HasTitleId) && p_Info.TitleId[0] == '\0')
+        return false;
+
+    if ((p_Filter.Flags & ProcessEventFilter_Sandboxed) && !p_Info.Sandboxed)
+        return false;
+
+    // Prefix match, "NPXS20001" is one title and "CUSA" every retail one
+    for (auto l_Index = 0; p_Filter.TitleId[l_Index] != '\0'; ++l_Index)
+    {
+        if (p_Info.TitleId[l_Index] != p_Filter.TitleId[l_Index])
+            return false;
+    }
+
+    if (p_Filter.Name[0] != '\0' && strcmp(p_Filter.Name, p_Info.Name) != 0)
+        return false;
+
+    return true;
+}
+
+void ProcessEvents::OnProcessFork(void* p_Argument, struct proc* p_Parent, struct proc* p_Child, int p_Flags)
+{
+    auto __sx_xlock = (int (*)(struct sx *sx, int opts, const char* file, int line))kdlsym(_sx_xlock);
+    auto __sx_xunlock = (int (*)(struct sx *sx, const char* file, int line))kdlsym(_sx_xunlock);
+
+    auto s_ProcessEvents = static_cast<ProcessEvents*>(p_Argument);
+    if (s_ProcessEvents == nullptr || p_Child == nullptr)
+        return;
+
+    // Still named after its parent until it execs, the parent has to stay the one found
+    __sx_xlock(&s_ProcessEvents->m_IndexLock, 0, __FILE__, __LINE__);
+    s_ProcessEvents->m_Index.Insert(p_Child, p_Child->p_pid, p_Child->p_comm, false);
+    __sx_xunlock(&s_ProcessEvents->m_IndexLock, __FILE__, __LINE__);
+}
+
+void ProcessEvents::OnProcessExecEnd(void* p_Argument, struct proc* p_Process)
+{
+    auto __sx_xlock = (int (*)(struct sx *sx, int opts, const char* file, int line))kdlsym(_sx_xlock);
+    auto __sx_xunlock = (int (*)(struct sx *sx, const char* file, int line))kdlsym(_sx_xunlock);
+
+    auto s_ProcessEvents = static_cast<ProcessEvents*>(p_Argument);
+    if (s_ProcessEvents == nullptr || p_Process == nullptr)
+        return;
+
+    // Renamed before the subscribers run, so they can already look the new image up
+    __sx_xlock(&s_ProcessEvents->m_IndexLock, 0, __FILE__, __LINE__);
+    s_ProcessEvents->m_Index.Insert(p_Process, p_Process->p_pid, p_Process->p_comm, true);
+    __sx_xunlock(&s_ProcessEvents->m_IndexLock, __FILE__, __LINE__);
+
+    s_ProcessEvents->Dispatch(ProcessEvent_Start, p_Process);
+}
+
+void ProcessEvents::OnProcessExit(void* p_Argument, struct proc* p_Process)
+{
+    auto __sx_xlock = (int (*)(struct sx *sx, int opts, const char* file, int line))kdlsym(_sx_xlock);
+    auto __sx_xunlock = (int (*)(struct sx *sx, const char* file, int line))kdlsym(_sx_xunlock);
+
+    auto s_ProcessEvents = static_cast<ProcessEvents*>(p_Argument);
+    if (s_ProcessEvents == nullptr || p_Process == nullptr)
+        return;
+
+    s_ProcessEvents->Dispatch(ProcessEvent_Exit, p_Process);
+
+    // P_WEXIT is set and every hold is gone by now, nobody can get it from the index anymore
+    __sx_xlock(&s_ProcessEvents->m_IndexLock, 0, __FILE__, __LINE__);
+    s_ProcessEvents->m_Index.Remove(p_Process, p_Process->p_pid);
+    __sx_xunlock(&s_ProcessEvents->m_IndexLock, __FILE__, __LINE__);
+}
+
+struct proc* ProcessEvents::HoldProcessByName(const char* p_Name)
+{
+    auto __sx_slock = (int (*)(struct sx *sx, int opts, const char* file, int line))kdlsym(_sx_slock);
+    auto __sx_sunlock = (void (*)(struct sx *sx, const char* file, int line))kdlsym(_sx_sunlock);
+
+    if (p_Name == nullptr)
+        return nullptr;
+
+    // An exiting process keeps its entry until process_exit, try the others with the same name
+    struct proc* s_Process = nullptr;
+
+    __sx_slock(&m_IndexLock, 0, __FILE__, __LINE__);
+    for (auto l_Process = m_Index.FindByName(p_Name); l_Process != nullptr && s_Process == nullptr; l_Process = m_Index.FindByName(p_Name, l_Process))
+        s_Process = HoldProcess(l_Process);
+    __sx_sunlock(&m_IndexLock, __FILE__, __LINE__);
+
+    return s_Process;
+}
+
+struct proc* ProcessEvents::HoldProcessById(int32_t p_ProcessId)
+{
+    auto __sx_slock = (int (*)(struct sx *sx, int opts, const char* file, int line))kdlsym(_sx_slock);
+    auto __sx_sunlock = (void (*)(struct sx *sx, const char* file, int line))kdlsym(_sx_sunlock);
+
+    __sx_slock(&m_IndexLock, 0, __FILE__, __LINE__);
+    auto s_Process = HoldProcess(m_Index.FindById(p_ProcessId));
+    __sx_sunlock(&m_IndexLock, __FILE__, __LINE__);
+
+    return s_Process;
+}
+
+bool ProcessEvents::IsIndexComplete()
+{
+    auto __sx_slock = (int (*)(struct sx *sx, int opts, const char* file, int line))kdlsym(_sx_slock);
+    auto __sx_sunlock = (void (*)(struct sx *sx, const char* file, int line))kdlsym(_sx_sunlock);
+
+    __sx_slock(&m_IndexLock, 0, __FILE__, __LINE__);
+    auto s_Complete = m_Index.IsComplete();
+    __sx_sunlock(&m_IndexLock, __FILE__, __LINE__);
+
+    return s_Complete;
+}
+
+struct proc* ProcessEvents::HoldProcess(struct proc* p_Process)
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_unlock_flags);
+    auto faultin = (void(*)(struct proc *p))kdlsym(faultin);
+
+    if (p_Process == nullptr)
+        return nullptr;
+
+    // Indexed processes are only freed after process_exit took them out, which waits for the
+    // index lock the caller holds
+    PROC_LOCK(p_Process);
+    if (p_Process->p_flag & P_WEXIT)
+    {
+        PROC_UNLOCK(p_Process);
+        return nullptr;
+    }
+
+    _PHOLD(p_Process);
+    PROC_UNLOCK(p_Process);
+
+    return p_Process;
+}
+
+void ProcessEvents::PopulateIndex()
+{
+    auto __sx_xlock = (int (*)(struct sx *sx, int opts, const char* file, int line))kdlsym(_sx_xlock);
+    auto __sx_xunlock = (int (*)(struct sx *sx, const char* file, int line))kdlsym(_sx_xunlock);
+    auto __sx_slock = (int (*)(struct sx *sx, int opts, const char* file, int line))kdlsym(_sx_slock);
+    auto __sx_sunlock = (void (*)(struct sx *sx, const char* file, int line))kdlsym(_sx_sunlock);
+    auto _mtx_lock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_unlock_flags);
+
+    auto s_AllProcLock = (struct sx*)kdlsym(allproc_lock);
+    auto allproc = (struct proclist*)*(uint64_t*)kdlsym(allproc);
+
+    // The index lock is held over the walk, a process that starts exiting after it was checked
+    // here removes itself only once it is indexed
+    __sx_xlock(&m_IndexLock, 0, __FILE__, __LINE__);
+    __sx_slock(s_AllProcLock, 0, __FILE__, __LINE__);
+
+    struct proc* s_Process = nullptr;
+    FOREACH_PROC_IN_SYSTEM(s_Process)
+    {
+        PROC_LOCK(s_Process);
+
+        // Newest first, appending keeps the newest of the same name in front like the walk did
+        if ((s_Process->p_flag & P_WEXIT) == 0)
+            m_Index.Insert(s_Process, s_Process->p_pid, s_Process->p_comm, false);
+
+        PROC_UNLOCK(s_Process);
+    }
+
+    __sx_sunlock(s_AllProcLock, __FILE__, __LINE__);
+
+    auto s_Count = m_Index.GetCount();
+    auto s_Complete = m_Index.IsComplete();
+    __sx_xunlock(&m_IndexLock, __FILE__, __LINE__);
+
+    if (!s_Complete)
+        WriteLog(LL_Error, "process index is full, (%d) processes indexed.", s_Count);
+    else
+        WriteLog(LL_Debug, "process index built, (%d) processes.", s_Count);
+}
@@ -0,0 +1,171 @@
+#pragma once
+#include <Utils/Types.hpp>
+#include <OrbisOS/ProcessIndex.hpp>
+
+extern "C"
+{
+    #include <sys/param.h>
+    #include <sys/lock.h>
+    #include <sys/sx.h>
+};
+
+struct proc;
+struct thread;
+struct eventhandler_entry;
+
+namespace Mira
+{
+    namespace OrbisOS
+    {
+        enum
+        {
+            // Most callbacks that can be subscribed at once, over every event type
+            ProcessEvents_MaxSubscribers = 16,
+
+            // CUSAXXXXX and the terminator, rounded up
+            ProcessEvents_TitleIdLength = 16,
+
+            // Same as sizeof(p_comm)
+            ProcessEvents_NameLength = 32,
+        };
+
+        enum ProcessEventType
+        {
+            // process_exec_end, the new image is mapped but has not run yet
+            ProcessEvent_Start,
+
+            // process_exit, the process is still there but its threads are gone
+            ProcessEvent_Exit,
+
+            ProcessEvent_Max
+        };
+
+        enum ProcessEventFilterFlags
+        {
+            ProcessEventFilter_None = 0,
+
+            // Only processes that have a title id (apps, games, shell ui...)
+            ProcessEventFilter_HasTitleId = 1 << 0,
+
+            // Only processes that are jailed in a sandbox
+            ProcessEventFilter_Sandboxed = 1 << 1,
+        };
+
+        struct ProcessEventFilter
+        {
+            // ProcessEventFilter_*
+            uint32_t Flags;
+
+            // Title ids starting with this, empty matches every process
+            char TitleId[ProcessEvents_TitleIdLength];
+
+            // p_comm equal to this, empty matches every process
+            char Name[ProcessEvents_NameLength];
+        };
+
+        /*
+            ProcessInfo
+
+            What is known about the process an event is for, gathered once per event and shared
+            by every subscriber. The sandbox path needs vn_fullpath and is only resolved when the
+            first subscriber asks for it.
+        */
+        class ProcessInfo
+        {
+        public:
+            struct proc* Process;
+            struct thread* Thread;
+            int32_t ProcessId;
+
+            // Empty when the process has none
+            char TitleId[ProcessEvents_TitleIdLength];
+            char Name[ProcessEvents_NameLength];
+
+            bool Sandboxed;
+
+        private:
+            bool m_SandboxPathResolved;
+            char* m_SandboxPath;
+            char* m_SandboxFreePath;
+
+        public:
+            ProcessInfo(struct proc* p_Process);
+            ~ProcessInfo();
+
+            // Full path of the sandbox root, nullptr if the process is not sandboxed or it could not be resolved
+            const char* GetSandboxPath();
+        };
+
+        typedef void(*ProcessEventCallback)(ProcessInfo* p_Info, void* p_Argument);
+
+        /*
+            ProcessEvents
+
+            Single owner of Mira's process_exec_end and process_exit eventhandlers. Each event
+            builds one ProcessInfo and hands it to the subscribers whose filter matches, so a
+            plugin that only cares about one title does not run, and does not look anything up,
+            for every other process that starts.
+
+            Callbacks run in the context of the process the event is for, with the subscriber list
+            locked shared, they may sleep but must not subscribe or unsubscribe.
+
+            The same events, plus process_fork, keep a ProcessIndex of every process up to date
+            (filled from allproc once at load). Lookups return the process held with PHOLD, which
+            keeps exit from tearing it down until the caller is done and releases it with PRELE.
+        */
+        class ProcessEvents
+        {
+        private:
+            struct Subscriber
+            {
+                bool Used;
+                ProcessEventType Type;
+                ProcessEventFilter Filter;
+                ProcessEventCallback Callback;
+                void* Argument;
+            };
+
+            Subscriber m_Subscribers[ProcessEvents_MaxSubscribers];
+            uint32_t m_SubscriberCount[ProcessEvent_Max];
+
+            struct sx m_Lock;
+
+            // Taken before allproc_lock when both are needed
+            ProcessIndex m_Index;
+            struct sx m_IndexLock;
+
+            eventhandler_entry* m_ForkTag;
+            eventhandler_entry* m_ExecEndTag;
+            eventhandler_entry* m_ExitTag;
+
+        public:
+            ProcessEvents();
+            ~ProcessEvents();
+
+            // Returns the subscription id to Unsubscribe with, or -1
+            int32_t Subscribe(ProcessEventType p_Type, const ProcessEventFilter& p_Filter, ProcessEventCallback p_Callback, void* p_Argument);
+            void Unsubscribe(int32_t p_SubscriptionId);
+
+            // Held processes, nullptr when not indexed or already exiting
+            struct proc* HoldProcessByName(const char* p_Name);
+            struct proc* HoldProcessById(int32_t p_ProcessId);
+
+            // False when a process did not fit the index, a miss has to be confirmed with allproc
+            bool IsIndexComplete();
+
+        private:
+            void Dispatch(ProcessEventType p_Type, struct proc* p_Process);
+
+            void PopulateIndex();
+            static struct proc* HoldProcess(struct proc* p_Process);
+            static void DestroyLock(struct sx* p_Lock);
+            static void WaitForHandlers(const char* p_ListName);
+
+            static bool Matches(const ProcessEventFilter& p_Filter, const ProcessInfo& p_Info);
+
+            static void OnProcessFork(void* p_Argument, struct proc* p_Parent, struct proc* p_Child, int p_Flags);
+            static void OnProcessExecEnd(void* p_Argument, struct proc* p_Process);
+            static void OnProcessExit(void* p_Argument, struct proc* p_Process);
+        };
+    }
+}
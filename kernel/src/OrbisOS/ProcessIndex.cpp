@@ -0,0 +1,191 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "ProcessIndex.hpp"
+#include <Utils/Kernel.hpp>
+
+using namespace Mira::OrbisOS;
+
+static_assert(ProcessIndex_MaxProcesses < 0x7FFF, "entries are linked with int16_t");
+static_assert((ProcessIndex_BucketCount & (ProcessIndex_BucketCount - 1)) == 0, "bucket count has to be a power of two");
+
+ProcessIndex::ProcessIndex()
+{
+    Clear();
+}
+
+void ProcessIndex::Clear()
+{
+    memset(m_Entries, 0, sizeof(m_Entries));
+    memset(m_IdBuckets, 0xFF, sizeof(m_IdBuckets));
+    memset(m_NameBuckets, 0xFF, sizeof(m_NameBuckets));
+
+    for (auto l_Index = 0; l_Index < ProcessIndex_MaxProcesses; ++l_Index)
+    {
+        m_Entries[l_Index].NextById = static_cast<int16_t>(l_Index + 1 < ProcessIndex_MaxProcesses ? l_Index + 1 : -1);
+        m_Entries[l_Index].NextByName = -1;
+    }
+
+    m_FreeList = 0;
+    m_Count = 0;
+    m_Overflowed = false;
+}
+
+bool ProcessIndex::Insert(struct proc* p_Process, int32_t p_ProcessId, const char* p_Name, bool p_First)
+{
+    if (p_Process == nullptr || p_Name == nullptr)
+        return false;
+
+    auto s_Index = FindEntry(p_Process, p_ProcessId);
+    if (s_Index >= 0)
+    {
+        UnlinkName(s_Index);
+        LinkName(s_Index, p_Name, p_First);
+        return true;
+    }
+
+    if (m_FreeList < 0)
+    {
+        m_Overflowed = true;
+        return false;
+    }
+
+    s_Index = m_FreeList;
+    auto& s_Entry = m_Entries[s_Index];
+    m_FreeList = s_Entry.NextById;
+
+    s_Entry.Process = p_Process;
+    s_Entry.ProcessId = p_ProcessId;
+
+    auto s_Bucket = GetIdBucket(p_ProcessId);
+    s_Entry.NextById = m_IdBuckets[s_Bucket];
+    m_IdBuckets[s_Bucket] = s_Index;
+
+    LinkName(s_Index, p_Name, p_First);
+
+    m_Count++;
+    return true;
+}
+
+bool ProcessIndex::Remove(struct proc* p_Process, int32_t p_ProcessId)
+{
+    auto s_Bucket = GetIdBucket(p_ProcessId);
+
+    auto s_Link = &m_IdBuckets[s_Bucket];
+    while (*s_Link >= 0)
+    {
+        auto& l_Entry = m_Entries[*s_Link];
+        if (l_Entry.Process == p_Process && l_Entry.ProcessId == p_ProcessId)
+            break;
+
+        s_Link = &l_Entry.NextById;
+    }
+
+    if (*s_Link < 0)
+        return false;
+
+    auto s_Index = *s_Link;
+    auto& s_Entry = m_Entries[s_Index];
+    *s_Link = s_Entry.NextById;
+
+    UnlinkName(s_Index);
+
+    memset(&s_Entry, 0, sizeof(s_Entry));
+    s_Entry.NextByName = -1;
+    s_Entry.NextById = m_FreeList;
+    m_FreeList = s_Index;
+
+    m_Count--;
+    return true;
+}
+
+struct proc* ProcessIndex::FindById(int32_t p_ProcessId) const
+{
+    for (auto l_Index = m_IdBuckets[GetIdBucket(p_ProcessId)]; l_Index >= 0; l_Index = m_Entries[l_Index].NextById)
+    {
+        if (m_Entries[l_Index].ProcessId == p_ProcessId)
+            return m_Entries[l_Index].Process;
+    }
+
+    return nullptr;
+}
+
+struct proc* ProcessIndex::FindByName(const char* p_Name, struct proc* p_After) const
+{
+    if (p_Name == nullptr)
+        return nullptr;
+
+    auto s_Hash = HashName(p_Name);
+    auto s_Passed = p_After == nullptr;
+    for (auto l_Index = m_NameBuckets[GetNameBucket(s_Hash)]; l_Index >= 0; l_Index = m_Entries[l_Index].NextByName)
+    {
+        auto& l_Entry = m_Entries[l_Index];
+        if (l_Entry.NameHash != s_Hash || strcmp(l_Entry.Name, p_Name) != 0)
+            continue;
+
+        if (s_Passed)
+            return l_Entry.Process;
+
+        s_Passed = l_Entry.Process == p_After;
+    }
+
+    return nullptr;
+}
+
+int16_t ProcessIndex::FindEntry(struct proc* p_Process, int32_t p_ProcessId) const
+{
+    for (auto l_Index = m_IdBuckets[GetIdBucket(p_ProcessId)]; l_Index >= 0; l_Index = m_Entries[l_Index].NextById)
+    {
+        if (m_Entries[l_Index].Process == p_Process && m_Entries[l_Index].ProcessId == p_ProcessId)
+            return l_Index;
+    }
+
+    return -1;
+}
+
+void ProcessIndex::LinkName(int16_t p_Index, const char* p_Name, bool p_First)
+{
+    auto& s_Entry = m_Entries[p_Index];
+
+    // p_comm is not null terminated when it uses all of its bytes
+    memset(s_Entry.Name, 0, sizeof(s_Entry.Name));
+    for (auto l_Index = 0; l_Index < ProcessIndex_NameLength - 1 && p_Name[l_Index] != '\0'; ++l_Index)
+        s_Entry.Name[l_Index] = p_Name[l_Index];
+
+    s_Entry.NameHash = HashName(s_Entry.Name);
+
+    auto s_Link = &m_NameBuckets[GetNameBucket(s_Entry.NameHash)];
+    if (!p_First)
+    {
+        while (*s_Link >= 0)
+            s_Link = &m_Entries[*s_Link].NextByName;
+    }
+
+    s_Entry.NextByName = *s_Link;
+    *s_Link = p_Index;
+}
+
+void ProcessIndex::UnlinkName(int16_t p_Index)
+{
+    auto s_Link = &m_NameBuckets[GetNameBucket(m_Entries[p_Index].NameHash)];
+    while (*s_Link >= 0 && *s_Link != p_Index)
+        s_Link = &m_Entries[*s_Link].NextByName;
+
+    if (*s_Link == p_Index)
+        *s_Link = m_Entries[p_Index].NextByName;
+
+    m_Entries[p_Index].NextByName = -1;
+}
+
+uint32_t ProcessIndex::HashName(const char* p_Name)
+{
+    // FNV-1a, names differ mostly in their last characters (SceShellCore, SceShellUI)
+    uint32_t s_Hash = 0x811C9DC5;
+    for (auto l_Index = 0; l_Index < ProcessIndex_NameLength - 1 && p_Name[l_Index] != '\0'; ++l_Index)
+    {
+        s_Hash ^= static_cast<uint8_t>(p_Name[l_Index]);
+        s_Hash *= 0x01000193;
+    }
+
+    return s_Hash;
+}
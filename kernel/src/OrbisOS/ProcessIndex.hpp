@@ -0,0 +1,90 @@
+#pragma once
+#include <Utils/Types.hpp>
+
+struct proc;
+
+namespace Mira
+{
+    namespace OrbisOS
+    {
+        enum
+        {
+            // A booted console runs well under a hundred processes, games and their helpers included
+            ProcessIndex_MaxProcesses = 512,
+
+            // Power of two, both the pid and the name tables use it
+            ProcessIndex_BucketCount = 256,
+
+            // Same as sizeof(p_comm)
+            ProcessIndex_NameLength = 32,
+        };
+
+        /*
+            ProcessIndex
+
+            pid -> proc and name -> proc index, so finding SceShellCore is a hash probe instead of
+            a walk over allproc with a strcmp per process. Entries are chained per bucket. Among
+            processes with the same name a lookup returns the first one in the chain: an exec puts
+            its process in front, a fork child still carrying its parent's name goes behind. The
+            others are found by passing the previous result back in.
+
+            Only pointers are stored, the process is never touched. Not locked, the owner
+            serializes every call and keeps the processes alive while they are indexed. When the
+            index is full a process is simply not indexed, IsComplete tells a miss can not be
+            trusted from then on.
+        */
+        class ProcessIndex
+        {
+        private:
+            struct Entry
+            {
+                struct proc* Process;
+                int32_t ProcessId;
+                uint32_t NameHash;
+
+                // Next entry in the same bucket, -1 ends the chain. NextById also links free entries
+                int16_t NextById;
+                int16_t NextByName;
+
+                char Name[ProcessIndex_NameLength];
+            };
+
+            Entry m_Entries[ProcessIndex_MaxProcesses];
+            int16_t m_IdBuckets[ProcessIndex_BucketCount];
+            int16_t m_NameBuckets[ProcessIndex_BucketCount];
+
+            int16_t m_FreeList;
+            uint32_t m_Count;
+            bool m_Overflowed;
+
+        public:
+            ProcessIndex();
+
+            // Indexes the process, or updates the name when it is indexed already. p_First puts it in
+            // front of the processes with the same name, otherwise it goes behind them
+            bool Insert(struct proc* p_Process, int32_t p_ProcessId, const char* p_Name, bool p_First);
+            bool Remove(struct proc* p_Process, int32_t p_ProcessId);
+
+            struct proc* FindById(int32_t p_ProcessId) const;
+            // First process named p_Name after p_After in the chain, or the first one when p_After is nullptr
+            struct proc* FindByName(const char* p_Name, struct proc* p_After = nullptr) const;
+
+            void Clear();
+
+            uint32_t GetCount() const { return m_Count; }
+
+            // False once a process could not be indexed, only hits are reliable then
+            bool IsComplete() const { return !m_Overflowed; }
+
+        private:
+            int16_t FindEntry(struct proc* p_Process, int32_t p_ProcessId) const;
+
+            void LinkName(int16_t p_Index, const char* p_Name, bool p_First);
+            void UnlinkName(int16_t p_Index);
+
+            static uint32_t HashName(const char* p_Name);
+            static uint32_t GetIdBucket(int32_t p_ProcessId) { return static_cast<uint32_t>(p_ProcessId) & (ProcessIndex_BucketCount - 1); }
+            static uint32_t GetNameBucket(uint32_t p_NameHash) { return p_NameHash & (ProcessIndex_BucketCount - 1); }
+        };
+    }
+}
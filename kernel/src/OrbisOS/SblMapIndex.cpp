@@ -0,0 +1,262 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "SblMapIndex.hpp"
+#include <Mira.hpp>
+#include <Utils/Kdlsym.hpp>
+#include <Utils/Logger.hpp>
+#include <Utils/Hook.hpp>
+#include <Utils/HookManager.hpp>
+
+using namespace Mira::OrbisOS;
+
+typedef int(*SceSblDriverMapPages_t)(uint64_t* gpu_paddr, void* cpu_vaddr, uint32_t npages, uint64_t flags, uint64_t unk, uint64_t* gpu_desc);
+typedef int(*SceSblDriverUnmapPages_t)(uint64_t gpu_desc);
+
+// Set while the hooks exist, the hooks still reach the originals when the framework has no index
+static SceSblDriverMapPages_t s_MapPagesTrampoline = nullptr;
+static SceSblDriverUnmapPages_t s_UnmapPagesTrampoline = nullptr;
+
+SblMapIndex::SblMapIndex() :
+    m_MapPagesHook(nullptr),
+    m_UnmapPagesHook(nullptr)
+{
+    auto mtx_init = (void(*)(struct mtx *m, const char *name, const char *type, int opts))kdlsym(mtx_init);
+
+    mtx_init(&m_Mutex, "MiraSblMap", nullptr, MTX_DEF);
+
+#if defined(kdlsym_addr_sceSblDriverMapPages) && defined(kdlsym_addr_sceSblDriverUnmapPages)
+    m_MapPagesHook = new Utils::Hook(kdlsym(sceSblDriverMapPages), reinterpret_cast<void*>(OnSceSblDriverMapPages));
+    m_UnmapPagesHook = new Utils::Hook(kdlsym(sceSblDriverUnmapPages), reinterpret_cast<void*>(OnSceSblDriverUnmapPages));
+
+    // Both are needed, an index that sees maps but not unmaps would hand out freed entries
+    if (m_MapPagesHook == nullptr || m_UnmapPagesHook == nullptr ||
+        m_MapPagesHook->GetTrampolineFunctionAddress(nullptr) == nullptr || m_UnmapPagesHook->GetTrampolineFunctionAddress(nullptr) == nullptr)
+    {
+        WriteLog(LL_Error, "could not create the sbl map hooks, gpu va lookups will walk the list.");
+
+        delete m_MapPagesHook;
+        m_MapPagesHook = nullptr;
+
+        delete m_UnmapPagesHook;
+        m_UnmapPagesHook = nullptr;
+    }
+    else
+    {
+        s_MapPagesTrampoline = reinterpret_cast<SceSblDriverMapPages_t>(m_MapPagesHook->GetTrampolineFunctionAddress(nullptr));
+        s_UnmapPagesTrampoline = reinterpret_cast<SceSblDriverUnmapPages_t>(m_UnmapPagesHook->GetTrampolineFunctionAddress(nullptr));
+    }
+
+    StageHooks();
+#else
+    WriteLog(LL_Warn, "sceSblDriverMapPages is not resolved on this platform, gpu va lookups will walk the list.");
+#endif
+}
+
+SblMapIndex::~SblMapIndex()
+{
+    auto mtx_destroy = (void(*)(struct mtx *))kdlsym(mtx_destroy);
+
+    auto s_HookManager = Mira::Framework::GetFramework()->GetHookManager();
+
+    // Unmaps first, so nothing is left indexed that could not be removed anymore
+    Utils::Hook* s_Hooks[] = { m_MapPagesHook, m_UnmapPagesHook };
+    for (auto l_Hook : s_Hooks)
+    {
+        if (l_Hook == nullptr)
+            continue;
+
+        if (s_HookManager != nullptr)
+            s_HookManager->Unregister(l_Hook);
+        else if (l_Hook->IsEnabled())
+            l_Hook->Disable();
+
+        delete l_Hook;
+    }
+
+    s_MapPagesTrampoline = nullptr;
+    s_UnmapPagesTrampoline = nullptr;
+
+    m_MapPagesHook = nullptr;
+    m_UnmapPagesHook = nullptr;
+
+    Clear();
+
+    mtx_destroy(&m_Mutex);
+}
+
+SblMapListEntry* SblMapIndex::Find(uint64_t p_GpuVa)
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    if (p_GpuVa == 0)
+    {
+        WriteLog(LL_Error, "invalid gpu va");
+        return nullptr;
+    }
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    auto s_Entry = m_Index.Find(p_GpuVa);
+    _mtx_unlock_flags(&m_Mutex, 0);
+
+    if (s_Entry != nullptr)
+        return s_Entry;
+
+    // Mapped before the hooks went in
+    return WalkPageList(p_GpuVa);
+}
+
+void SblMapIndex::OnSuspend()
+{
+    Clear();
+}
+
+void SblMapIndex::OnResume()
+{
+    StageHooks();
+}
+
+SblMapListEntry* SblMapIndex::FindMappedPageList(uint64_t p_GpuVa)
+{
+    auto s_Framework = Mira::Framework::GetFramework();
+    auto s_Index = s_Framework != nullptr ? s_Framework->GetSblMapIndex() : nullptr;
+    if (s_Index != nullptr)
+        return s_Index->Find(p_GpuVa);
+
+    if (p_GpuVa == 0)
+    {
+        WriteLog(LL_Error, "invalid gpu va");
+        return nullptr;
+    }
+
+    return WalkPageList(p_GpuVa);
+}
+
+SblMapListEntry* SblMapIndex::WalkPageList(uint64_t p_GpuVa)
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_unlock_flags);
+    auto s_SblDrvMsgMtx = (struct mtx*)kdlsym(sbl_drv_msg_mtx);
+
+    SblMapListEntry* s_FinalEntry = nullptr;
+
+    // Lock before we iterate this list, because other paths can absolutely use it concurrently
+    _mtx_lock_flags(s_SblDrvMsgMtx, 0, __FILE__, __LINE__);
+
+    SblMapListEntry* s_Entry = *(SblMapListEntry**)kdlsym(gpu_va_page_list);
+    while (s_Entry)
+    {
+        if (s_Entry->gpuVa == p_GpuVa)
+        {
+            s_FinalEntry = s_Entry;
+            break;
+        }
+
+        s_Entry = s_Entry->next;
+    }
+
+    _mtx_unlock_flags(s_SblDrvMsgMtx, 0, __FILE__, __LINE__);
+    return s_FinalEntry;
+}
+
+SblMapListEntry* SblMapIndex::FindNewEntry(uint64_t p_GpuVa)
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_unlock_flags);
+    auto s_SblDrvMsgMtx = (struct mtx*)kdlsym(sbl_drv_msg_mtx);
+
+    _mtx_lock_flags(s_SblDrvMsgMtx, 0, __FILE__, __LINE__);
+    auto s_Head = *(SblMapListEntry**)kdlsym(gpu_va_page_list);
+    auto s_Entry = s_Head != nullptr && s_Head->gpuVa == p_GpuVa ? s_Head : nullptr;
+    _mtx_unlock_flags(s_SblDrvMsgMtx, 0, __FILE__, __LINE__);
+
+    // Another map got in between, look for it
+    if (s_Entry == nullptr)
+        s_Entry = WalkPageList(p_GpuVa);
+
+    return s_Entry;
+}
+
+void SblMapIndex::StageHooks()
+{
+    if (m_MapPagesHook == nullptr || m_UnmapPagesHook == nullptr)
+        return;
+
+    // Installed by the framework together with every other staged hook
+    auto s_HookManager = Mira::Framework::GetFramework()->GetHookManager();
+    if (s_HookManager == nullptr)
+    {
+        WriteLog(LL_Error, "could not get the hook manager, gpu va lookups will walk the list.");
+        return;
+    }
+
+    if (!s_HookManager->StageEnable(m_UnmapPagesHook) || !s_HookManager->StageEnable(m_MapPagesHook))
+        WriteLog(LL_Error, "could not stage the sbl map hooks");
+}
+
+void SblMapIndex::Clear()
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    m_Index.Clear();
+    _mtx_unlock_flags(&m_Mutex, 0);
+}
+
+int SblMapIndex::OnSceSblDriverMapPages(uint64_t* p_GpuPhysicalAddress, void* p_CpuVirtualAddress, uint32_t p_PageCount, uint64_t p_Flags, uint64_t p_Unknown, uint64_t* p_GpuDescriptor)
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    // Only unset once the hooks are gone, nothing can get here then
+    auto sceSblDriverMapPages = s_MapPagesTrampoline;
+    if (sceSblDriverMapPages == nullptr)
+        return -1;
+
+    auto s_Ret = sceSblDriverMapPages(p_GpuPhysicalAddress, p_CpuVirtualAddress, p_PageCount, p_Flags, p_Unknown, p_GpuDescriptor);
+    if (s_Ret != 0 || p_GpuPhysicalAddress == nullptr || p_GpuDescriptor == nullptr)
+        return s_Ret;
+
+    // While the framework is being set up or torn down there is nothing to index into
+    auto s_Framework = Mira::Framework::GetFramework();
+    auto s_Index = s_Framework != nullptr ? s_Framework->GetSblMapIndex() : nullptr;
+    if (s_Index == nullptr)
+        return s_Ret;
+
+    auto s_GpuVa = *p_GpuPhysicalAddress;
+    auto s_Entry = FindNewEntry(s_GpuVa);
+    if (s_Entry == nullptr)
+        return s_Ret;
+
+    _mtx_lock_flags(&s_Index->m_Mutex, 0);
+    if (!s_Index->m_Index.Insert(s_GpuVa, static_cast<uint64_t>(s_Entry->numPages) * PAGE_SIZE, *p_GpuDescriptor, s_Entry))
+        WriteLog(LL_Warn, "could not index gpu va (%p), lookups will walk the list.", reinterpret_cast<void*>(s_GpuVa));
+    _mtx_unlock_flags(&s_Index->m_Mutex, 0);
+
+    return s_Ret;
+}
+
+int SblMapIndex::OnSceSblDriverUnmapPages(uint64_t p_GpuDescriptor)
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    // Only unset once the hooks are gone, nothing can get here then
+    auto sceSblDriverUnmapPages = s_UnmapPagesTrampoline;
+    if (sceSblDriverUnmapPages == nullptr)
+        return -1;
+
+    // Out of the index before the entry is freed, a lookup racing this one walks the list instead
+    auto s_Framework = Mira::Framework::GetFramework();
+    auto s_Index = s_Framework != nullptr ? s_Framework->GetSblMapIndex() : nullptr;
+    if (s_Index != nullptr)
+    {
+        _mtx_lock_flags(&s_Index->m_Mutex, 0);
+        s_Index->m_Index.RemoveDescriptor(p_GpuDescriptor);
+        _mtx_unlock_flags(&s_Index->m_Mutex, 0);
+    }
+
+    return sceSblDriverUnmapPages(p_GpuDescriptor);
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <Utils/Types.hpp>
+#include <OrbisOS/GpuVaIndex.hpp>
+
+extern "C"
+{
+    #include <sys/param.h>
+    #include <sys/lock.h>
+    #include <sys/mutex.h>
+};
+
+namespace Mira
+{
+    namespace Utils
+    {
+        class Hook;
+    }
+
+    namespace OrbisOS
+    {
+        /*
+            SblMapIndex
+
+            Shared GPU VA -> SblMapListEntry lookup for the SBL mailbox hooks of FakeSelf and
+            FakePkg. Every message they handle resolves one to three GPU VAs, walking
+            gpu_va_page_list under sbl_drv_msg_mtx each time and contending with every other
+            mailbox user while doing so.
+
+            Where sceSblDriverMapPages and sceSblDriverUnmapPages are resolved, both are hooked to
+            keep a GpuVaIndex in sync and a lookup is a binary search under a mutex of its own.
+            Mappings the index does not know about (made before Mira was loaded, while suspended,
+            or on platforms without those symbols) are still found by walking the list, those
+            results are not indexed as nothing would remove them again.
+
+            The index is authoritative for what it holds: entries are only unlinked from
+            gpu_va_page_list by sceSblDriverUnmapPages, whose callers in the kernel all enter
+            through the hooked function, and everything indexed is dropped while the hooks are
+            pulled (suspend, unload). A hit is returned without touching the list.
+
+            The hooks fall through to the original functions while the framework has no index, the
+            trampolines are kept for as long as the hooks exist.
+        */
+        class SblMapIndex
+        {
+        private:
+            GpuVaIndex m_Index;
+            struct mtx m_Mutex;
+
+            Utils::Hook* m_MapPagesHook;
+            Utils::Hook* m_UnmapPagesHook;
+
+        public:
+            SblMapIndex();
+            ~SblMapIndex();
+
+            SblMapListEntry* Find(uint64_t p_GpuVa);
+
+            // Hooks are pulled by the framework while suspended, nothing indexed can be trusted afterwards
+            void OnSuspend();
+            void OnResume();
+
+            // Uses the framework's index when there is one, walks the list otherwise
+            static SblMapListEntry* FindMappedPageList(uint64_t p_GpuVa);
+
+            static SblMapListEntry* WalkPageList(uint64_t p_GpuVa);
+
+        private:
+            // Entry of a mapping that was just made, newest mappings are linked at the head
+            static SblMapListEntry* FindNewEntry(uint64_t p_GpuVa);
+
+            void StageHooks();
+            void Clear();
+
+            static int OnSceSblDriverMapPages(uint64_t* p_GpuPhysicalAddress, void* p_CpuVirtualAddress, uint32_t p_PageCount, uint64_t p_Flags, uint64_t p_Unknown, uint64_t* p_GpuDescriptor);
+            static int OnSceSblDriverUnmapPages(uint64_t p_GpuDescriptor);
+        };
+    }
+}
@@ -134,7 +134,7 @@ SelfDecrypt::SelfDecrypt(const char* p_FilePath) :
 
     // Allocate new self entries
     auto s_EntriesSize = m_Self.header.num_entries * sizeof(self_entry_t);
-    auto s_Entries = new self_entry_t[m_Self.header.num_entries];
+    auto s_Entries = new (Utils::MemoryTag_SelfDecrypt) self_entry_t[m_Self.header.num_entries];
     if (s_Entries == nullptr)
     {
         memset(&m_Self.header, 0, sizeof(m_Self.header));
@@ -156,7 +156,7 @@ SelfDecrypt::SelfDecrypt(const char* p_FilePath) :
     }
 
     // Copy the contents
-    auto s_Contents = new uint8_t[s_FileSize];
+    auto s_Contents = new (Utils::MemoryTag_SelfDecrypt) uint8_t[s_FileSize];
     if (s_Contents == nullptr)
     {
         delete [] s_Entries;
@@ -198,7 +198,7 @@ SelfDecrypt::SelfDecrypt(const char* p_FilePath) :
         return;
     }
 
-    char* s_FileName = new char[s_FileNameLength];
+    char* s_FileName = new (Utils::MemoryTag_SelfDecrypt) char[s_FileNameLength];
     if (s_FileName == nullptr)
     {
         delete [] s_Contents;
@@ -264,7 +264,7 @@ bool SelfDecrypt::VerifyHeader()
     _sceSblAuthMgrSmFinalize(m_Self.ctx);
 
     size_t s_HeaderDataSize = ALIGN_PAGE(m_Self.header.header_size + m_Self.header.meta_size);
-    uint8_t* s_HeaderData = new uint8_t[s_HeaderDataSize];
+    uint8_t* s_HeaderData = new (Utils::MemoryTag_SelfDecrypt) uint8_t[s_HeaderDataSize];
     if (s_HeaderData == nullptr)
     {
         ReleaseContext();
@@ -290,7 +290,7 @@ bool SelfDecrypt::VerifyHeader()
     }
 
     size_t s_AuthInfoSize = ALIGN_PAGE(SELF_AUTH_INFO_SIZE);
-    auto s_AuthInfo = new uint8_t[s_AuthInfoSize];
+    auto s_AuthInfo = new (Utils::MemoryTag_SelfDecrypt) uint8_t[s_AuthInfoSize];
     if (s_AuthInfo == nullptr)
     {
         s_Ret = sceSblDriverUnmapPages(s_HeaderDataMapDesc);
@@ -483,7 +483,7 @@ bool SelfDecrypt::DecryptSegment(uint8_t* p_InputData, size_t p_InputDataLength,
 
     // Create the segment data and copy it over
     s_SegmentDataSize = ALIGN_PAGE(p_InputDataLength);
-    s_SegmentData = new uint8_t[s_SegmentDataSize];
+    s_SegmentData = new (Utils::MemoryTag_SelfDecrypt) uint8_t[s_SegmentDataSize];
     if (s_SegmentData == nullptr)
     {
         WriteLog(LL_Error, "could not allocate segment data");
@@ -494,7 +494,7 @@ bool SelfDecrypt::DecryptSegment(uint8_t* p_InputData, size_t p_InputDataLength,
     
     // Create a new chunk table buffer
     
-    s_ChunkTable = new uint8_t[c_ChunkTableSize];
+    s_ChunkTable = new (Utils::MemoryTag_SelfDecrypt) uint8_t[c_ChunkTableSize];
     if (s_ChunkTable == nullptr)
     {
         WriteLog(LL_Error, "could not allocate chunk table");
@@ -636,7 +636,7 @@ bool SelfDecrypt::DecryptBlock(uint8_t* p_BlobData, uint64_t p_BlobSize, self_bl
 
     // Get the input data size and allocate new buffers
     s_InputSize = ALIGN_PAGE(p_BlobSize);
-    s_InputData = new uint8_t[s_InputSize];
+    s_InputData = new (Utils::MemoryTag_SelfDecrypt) uint8_t[s_InputSize];
     if (s_InputData == nullptr)
     {
         WriteLog(LL_Error, "could not allocate input data of size (%llx).", s_InputSize);
@@ -652,7 +652,7 @@ bool SelfDecrypt::DecryptBlock(uint8_t* p_BlobData, uint64_t p_BlobSize, self_bl
     }
 
     s_OutputSize = ALIGN_PAGE(p_BlobSize);
-    s_OutputData = new uint8_t[s_OutputSize];
+    s_OutputData = new (Utils::MemoryTag_SelfDecrypt) uint8_t[s_OutputSize];
     if (s_OutputData == nullptr)
     {
         WriteLog(LL_Error, "could not allocate output data of size (%llx).", s_OutputData);
@@ -7,6 +7,7 @@
 #include <Utils/Kdlsym.hpp>
 #include <Utils/Logger.hpp>
 #include <Plugins/Substitute/Substitute.hpp>
+#include <OrbisOS/ProcessEvents.hpp>
 
 #include <Mira.hpp>
 
@@ -151,15 +152,25 @@ struct proc* Utilities::FindProcessByName(const char* p_Name)
 	auto _sx_sunlock = (void(*)(struct sx *sx, const char *file, int line))kdlsym(_sx_sunlock);
 	auto _mtx_unlock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_unlock_flags);
 	auto _mtx_lock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_lock_flags);
+	auto faultin = (void(*)(struct proc *p))kdlsym(faultin);
+
+	if (!p_Name)
+		return NULL;
+
+	// Kept up to date from process events, allproc is only walked when it could not index everything
+	auto s_ProcessEvents = Mira::Framework::GetFramework()->GetProcessEvents();
+	if (s_ProcessEvents != nullptr)
+	{
+		auto s_Process = s_ProcessEvents->HoldProcessByName(p_Name);
+		if (s_Process != nullptr || s_ProcessEvents->IsIndexComplete())
+			return s_Process;
+	}
 
 	struct sx* allproclock = (struct sx*)kdlsym(allproc_lock);
 	struct proclist* allproc = (struct proclist*)*(uint64_t*)kdlsym(allproc);
 
 	struct proc* s_FoundProc = nullptr;
 
-	if (!p_Name)
-		return NULL;
-
 	_sx_slock(allproclock, 0, __FILE__, __LINE__);
 
 	do
@@ -170,7 +181,8 @@ struct proc* Utilities::FindProcessByName(const char* p_Name)
 		{
 			PROC_LOCK(s_Proc);
 
-			if (strcmp(s_Proc->p_comm, p_Name) == 0) {
+			if (strcmp(s_Proc->p_comm, p_Name) == 0 && !(s_Proc->p_flag & P_WEXIT)) {
+				_PHOLD(s_Proc);
 				s_FoundProc = s_Proc;
 				PROC_UNLOCK(s_Proc);
 				break;
@@ -185,120 +197,120 @@ struct proc* Utilities::FindProcessByName(const char* p_Name)
 	return s_FoundProc;
 }
 
+void Utilities::ReleaseProcess(struct ::proc* p_Process)
+{
+	auto _mtx_unlock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_unlock_flags);
+	auto _mtx_lock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_lock_flags);
+	auto wakeup = (void(*)(void*))kdlsym(wakeup);
+
+	if (p_Process == nullptr)
+		return;
+
+	PRELE(p_Process);
+}
+
 
-// Credits: flatz
-int Utilities::GetProcessVmMap(struct ::proc* p_Process, ProcVmMapEntry** p_Entries, size_t* p_NumEntries) 
+// Holds the process and takes a reference on its vmspace, nullptr when it is exiting
+static struct vmspace* AcquireProcessVmSpace(struct ::proc* p_Process)
 {
 	auto _mtx_unlock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_unlock_flags);
 	auto _mtx_lock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_lock_flags);
 	auto vmspace_acquire_ref = (struct vmspace* (*)(struct proc *))kdlsym(vmspace_acquire_ref);
-	auto vmspace_free = (void(*)(struct vmspace *))kdlsym(vmspace_free);
 	auto wakeup = (void(*)(void*))kdlsym(wakeup);
-	auto _vm_map_lock_read = (void(*)(vm_map_t map, const char *file, int line))kdlsym(_vm_map_lock_read);
-	auto _vm_map_unlock_read = (void(*)(vm_map_t map, const char *file, int line))kdlsym(_vm_map_unlock_read);
 	auto faultin = (void(*)(struct proc *p))kdlsym(faultin);
 
-	struct vmspace* vm = nullptr;
-	ProcVmMapEntry* info = nullptr;
-	vm_map_t map = nullptr;
-	vm_map_entry_t entry = nullptr;
-	size_t n, i = 0;
-	int ret = 0;
-    size_t allocSize = 0;// n * sizeof(*info);
-
-	if (!p_Process) {
-		ret = EINVAL;
-		goto error;
-	}
-	if (!p_Entries) {
-		ret = EINVAL;
-		goto error;
-	}
-	if (!p_NumEntries) {
-		ret = EINVAL;
-		goto error;
-	}
-
 	PROC_LOCK(p_Process);
 	if (p_Process->p_flag & P_WEXIT) {
 		PROC_UNLOCK(p_Process);
-		ret = ESRCH;
-		goto error;
+		return nullptr;
 	}
 	_PHOLD(p_Process);
 	PROC_UNLOCK(p_Process);
 
-	vm = vmspace_acquire_ref(p_Process);
-	if (!vm) {
+	auto s_VmSpace = vmspace_acquire_ref(p_Process);
+	if (s_VmSpace == nullptr)
 		PRELE(p_Process);
-		ret = ESRCH;
-		goto error;
-	}
-	map = &vm->vm_map;
 
-	vm_map_lock_read(map);
-	for (entry = map->header.next, n = 0; entry != &map->header; entry = entry->next) {
-		if (entry->eflags & MAP_ENTRY_IS_SUB_MAP)
-			continue;
-		++n;
-	}
-	if (n == 0)
-		goto done;
-	
-    allocSize = n * sizeof(*info);
-	info = (ProcVmMapEntry*)new uint8_t[allocSize];
-	if (!info) {
-		vm_map_unlock_read(map);
-		vmspace_free(vm);
+	return s_VmSpace;
+}
 
-		PRELE(p_Process);
+static void ReleaseProcessVmSpace(struct ::proc* p_Process, struct vmspace* p_VmSpace)
+{
+	auto _mtx_unlock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_unlock_flags);
+	auto _mtx_lock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_lock_flags);
+	auto vmspace_free = (void(*)(struct vmspace *))kdlsym(vmspace_free);
+	auto wakeup = (void(*)(void*))kdlsym(wakeup);
 
-		ret = ENOMEM;
-		goto error;
-	}
-	memset(info, 0, n * sizeof(*info));
-	for (entry = map->header.next, i = 0; entry != &map->header; entry = entry->next) {
-		if (entry->eflags & MAP_ENTRY_IS_SUB_MAP)
-			continue;
-
-		info[i].start = entry->start;
-		info[i].end = entry->end;
-		info[i].offset = entry->offset;
-		memcpy(info[i].name, entry->name, sizeof(info[i].name));
-
-		info[i].prot = 0;
-		if (entry->protection & VM_PROT_READ)
-			info[i].prot |= PROT_CPU_READ;
-		if (entry->protection & VM_PROT_WRITE)
-			info[i].prot |= PROT_CPU_WRITE;
-		if (entry->protection & VM_PROT_EXECUTE)
-			info[i].prot |= PROT_CPU_EXEC;
-		if (entry->protection & VM_PROT_GPU_READ)
-			info[i].prot |= PROT_GPU_READ;
-		if (entry->protection & VM_PROT_GPU_WRITE)
-			info[i].prot |= PROT_GPU_WRITE;
-
-		++i;
-	}
+	vmspace_free(p_VmSpace);
+	PRELE(p_Process);
+}
+
+// Credits: flatz
+int Utilities::GetProcessVmMap(struct ::proc* p_Process, ProcVmMapEntry** p_Entries, size_t* p_NumEntries) 
+{
+	auto _vm_map_lock_read = (void(*)(vm_map_t map, const char *file, int line))kdlsym(_vm_map_lock_read);
+	auto _vm_map_unlock_read = (void(*)(vm_map_t map, const char *file, int line))kdlsym(_vm_map_unlock_read);
+
+	if (!p_Process || !p_Entries || !p_NumEntries)
+		return EINVAL;
+
+	auto s_VmSpace = AcquireProcessVmSpace(p_Process);
+	if (!s_VmSpace)
+		return ESRCH;
 
-done:
+	vm_map_t map = &s_VmSpace->vm_map;
+	ProcVmMapEntry* info = nullptr;
+	size_t n = 0;
+
+	// nentries counts sub maps as well, which are skipped, so one walk fills the array
+	vm_map_lock_read(map);
+	if (map->nentries > 0) {
+		info = new ProcVmMapEntry[map->nentries];
+		if (info)
+			n = VmMapQuery::Collect(map, nullptr, info, map->nentries);
+	}
+	auto s_Allocated = map->nentries <= 0 || info != nullptr;
 	vm_map_unlock_read(map);
-	vmspace_free(vm);
 
-	PRELE(p_Process);
+	ReleaseProcessVmSpace(p_Process, s_VmSpace);
+
+	if (!s_Allocated)
+		return ENOMEM;
+
+	if (n == 0 && info) {
+		delete [] info;
+		info = nullptr;
+	}
 
 	*p_NumEntries = n;
 	*p_Entries = info;
 
-	info = NULL;
-	ret = 0;
+	return 0;
+}
 
-error:
-	if (info)
-        delete [] info;
-		//kfree(info, allocSize);
+int Utilities::QueryProcessVmMap(struct ::proc* p_Process, const VmMapFilter& p_Filter, ProcVmMapEntry* p_Entries, size_t p_MaxEntries, size_t* p_Count)
+{
+	auto _vm_map_lock_read = (void(*)(vm_map_t map, const char *file, int line))kdlsym(_vm_map_lock_read);
+	auto _vm_map_unlock_read = (void(*)(vm_map_t map, const char *file, int line))kdlsym(_vm_map_unlock_read);
+
+	if (p_Process == nullptr || p_Count == nullptr || (p_Entries == nullptr && p_MaxEntries != 0))
+		return -EINVAL;
+
+	*p_Count = 0;
+
+	auto s_VmSpace = AcquireProcessVmSpace(p_Process);
+	if (s_VmSpace == nullptr)
+		return -ESRCH;
 
-	return ret;
+	vm_map_t s_Map = &s_VmSpace->vm_map;
+
+	vm_map_lock_read(s_Map);
+	*p_Count = VmMapQuery::Collect(s_Map, &p_Filter, p_Entries, p_MaxEntries);
+	vm_map_unlock_read(s_Map);
+
+	ReleaseProcessVmSpace(p_Process, s_VmSpace);
+
+	return 0;
 }
 
 // Allow / Disallow to write on a executable
@@ -310,47 +322,26 @@ int Utilities::ExecutableWriteProtection(struct proc* p, bool write_allowed) {
         return -1;
     }
 
-    // Get the start text address of my process
-    uint64_t s_TextStart = 0;
-    uint64_t s_TextSize = 0;
-    ProcVmMapEntry* s_Entries = nullptr;
+    // Get the start text address of my process, the first read and execute only entry
+    ProcVmMapEntry s_TextEntry;
     size_t s_NumEntries = 0;
-    auto s_Ret = Utilities::GetProcessVmMap(p, &s_Entries, &s_NumEntries);
+    auto s_Ret = Utilities::QueryProcessVmMap(p, VmMapQuery::Protected(PROT_READ | PROT_EXEC), &s_TextEntry, 1, &s_NumEntries);
     if (s_Ret < 0)
     {
-        WriteLog(LL_Error, "[%d] Could not get the VM Map.", p->p_pid);
+        WriteLog(LL_Error, "[%d] Could not get the VM Map (%d).", p->p_pid, s_Ret);
         return -2;
     }
 
-    if (s_Entries == nullptr || s_NumEntries == 0)
+    if (s_NumEntries == 0)
     {
-        WriteLog(LL_Error, "[%d] Invalid entries (%p) or numEntries (%d)", p->p_pid, s_Entries, s_NumEntries);
-        return -3;
-    }
-
-    for (auto i = 0; i < s_NumEntries; ++i)
-    {
-        if (s_Entries[i].prot == (PROT_READ | PROT_EXEC))
-        {
-            s_TextStart = (uint64_t)s_Entries[i].start;
-            s_TextSize = ((uint64_t)s_Entries[i].end - (uint64_t)s_Entries[i].start);
-            break;
-        }
-    }
-
-    if (s_TextStart == 0 || s_TextSize)
-    {
-        WriteLog(LL_Error, "[%d] Could not find text start or size for this process !", p->p_pid);
         WriteLog(LL_Error, "[%d] Could not find text start or size for this process !", p->p_pid);
-
-	    // Free the s_Entries
-	    delete [] s_Entries;
-	    s_Entries = nullptr;
         return -4;
-    } else {
-        WriteLog(LL_Info, "[%d] text pointer: %p !", p->p_pid, s_TextStart);
     }
 
+    uint64_t s_TextStart = (uint64_t)s_TextEntry.start;
+    uint64_t s_TextSize = ((uint64_t)s_TextEntry.end - (uint64_t)s_TextEntry.start);
+    WriteLog(LL_Info, "[%d] text pointer: %p !", p->p_pid, s_TextStart);
+
     if (write_allowed) {
     	s_Ret = kmprotect_t((void*)s_TextStart, s_TextSize, (PROT_READ | PROT_WRITE | PROT_EXEC), s_ProcessThread);
     	if (s_Ret < 0) {
@@ -363,9 +354,6 @@ int Utilities::ExecutableWriteProtection(struct proc* p, bool write_allowed) {
     	}
     }
 
-    // Free the s_Entries
-    delete [] s_Entries;
-    s_Entries = nullptr;
     return 0;
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <Utils/Types.hpp>
 #include <Utils/Kernel.hpp>
+#include <OrbisOS/VmMapQuery.hpp>
 
 struct proc;
 struct thread;
@@ -43,10 +44,17 @@ namespace Mira
 
             static void HookFunctionCall(uint8_t* p_HookTrampoline, void* p_Function, void* p_Address);
             static uint64_t PtraceIO(int32_t p_ProcessId, int32_t p_Operation, void* p_DestAddress, void* p_ToReadWriteAddress, size_t p_ToReadWriteSize);
+            // The process is held (PHOLD), give it back with ReleaseProcess once done with it
             static struct ::proc* FindProcessByName(const char* name);
+            static void ReleaseProcess(struct ::proc* p_Process);
             static int ExecutableWriteProtection(struct proc* p, bool write_allowed);
             static int ProcessReadWriteMemory(struct ::proc* p_Process, void* p_DestAddress, size_t p_Size, void* p_ToReadWriteAddress, size_t* p_ReadWriteSize, bool p_Write);
             static int GetProcessVmMap(struct ::proc* p_Process, ProcVmMapEntry** p_Entries, size_t* p_NumEntries);
+
+            // Entries matching p_Filter, from one walk with the map read locked. p_Count gets every
+            // match, more than p_MaxEntries when the buffer was too small. 0 or a negative errno
+            static int QueryProcessVmMap(struct ::proc* p_Process, const VmMapFilter& p_Filter, ProcVmMapEntry* p_Entries, size_t p_MaxEntries, size_t* p_Count);
+
             static int MountNullFS(char* where, char* what, int flags);
             static int CreatePOSIXThread(struct proc* p, void* entrypoint);
             static int LoadPRXModule(struct proc* p, const char* prx_path);
@@ -0,0 +1,105 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "VmMapQuery.hpp"
+
+extern "C"
+{
+    #include <sys/param.h>
+    #include <sys/lock.h>
+    #include <sys/mutex.h>
+    #include <vm/vm.h>
+    #include <vm/pmap.h>
+    #include <vm/vm_map.h>
+};
+
+using namespace Mira::OrbisOS;
+
+size_t VmMapQuery::Collect(struct vm_map* p_Map, const VmMapFilter* p_Filter, ProcVmMapEntry* p_Entries, size_t p_MaxEntries)
+{
+    if (p_Map == nullptr)
+        return 0;
+
+    size_t s_Matches = 0;
+    for (auto l_MapEntry = p_Map->header.next; l_MapEntry != &p_Map->header; l_MapEntry = l_MapEntry->next)
+    {
+        if (l_MapEntry->eflags & MAP_ENTRY_IS_SUB_MAP)
+            continue;
+
+        // Entries are sorted by address, nothing after the range can match
+        if (p_Filter != nullptr && p_Filter->End != 0 && l_MapEntry->start >= p_Filter->End)
+            break;
+
+        ProcVmMapEntry l_Entry;
+        FillEntry(l_Entry, l_MapEntry);
+
+        if (!Matches(p_Filter, l_Entry))
+            continue;
+
+        if (s_Matches < p_MaxEntries && p_Entries != nullptr)
+            p_Entries[s_Matches] = l_Entry;
+
+        s_Matches++;
+    }
+
+    return s_Matches;
+}
+
+bool VmMapQuery::Matches(const VmMapFilter* p_Filter, const ProcVmMapEntry& p_Entry)
+{
+    if (p_Filter == nullptr)
+        return true;
+
+    if (p_Filter->End != 0 && (p_Entry.end <= p_Filter->Start || p_Entry.start >= p_Filter->End))
+        return false;
+
+    if ((p_Entry.prot & p_Filter->ProtMask) != p_Filter->Prot)
+        return false;
+
+    if (p_Filter->Name != nullptr)
+    {
+        // Map entry names are not null terminated when they use all of their bytes
+        for (size_t l_Index = 0; p_Filter->Name[l_Index] != '\0'; ++l_Index)
+        {
+            if (l_Index >= sizeof(p_Entry.name) || p_Entry.name[l_Index] != p_Filter->Name[l_Index])
+                return false;
+        }
+    }
+
+    return true;
+}
+
+void VmMapQuery::FillEntry(ProcVmMapEntry& p_Entry, const struct vm_map_entry* p_MapEntry)
+{
+    p_Entry.start = p_MapEntry->start;
+    p_Entry.end = p_MapEntry->end;
+    p_Entry.offset = p_MapEntry->offset;
+    memcpy(p_Entry.name, p_MapEntry->name, sizeof(p_Entry.name));
+
+    p_Entry.prot = 0;
+    if (p_MapEntry->protection & VM_PROT_READ)
+        p_Entry.prot |= PROT_CPU_READ;
+    if (p_MapEntry->protection & VM_PROT_WRITE)
+        p_Entry.prot |= PROT_CPU_WRITE;
+    if (p_MapEntry->protection & VM_PROT_EXECUTE)
+        p_Entry.prot |= PROT_CPU_EXEC;
+    if (p_MapEntry->protection & VM_PROT_GPU_READ)
+        p_Entry.prot |= PROT_GPU_READ;
+    if (p_MapEntry->protection & VM_PROT_GPU_WRITE)
+        p_Entry.prot |= PROT_GPU_WRITE;
+}
+
+VmMapFilter VmMapQuery::Containing(uint64_t p_Address)
+{
+    return { p_Address, p_Address + 1, nullptr, 0, 0 };
+}
+
+VmMapFilter VmMapQuery::Named(const char* p_Name)
+{
+    return { 0, 0, p_Name, 0, 0 };
+}
+
+VmMapFilter VmMapQuery::Protected(uint16_t p_Prot)
+{
+    return { 0, 0, nullptr, p_Prot, static_cast<uint16_t>(PROT_CPU_READ | PROT_CPU_WRITE | PROT_CPU_EXEC | PROT_GPU_READ | PROT_GPU_WRITE) };
+}
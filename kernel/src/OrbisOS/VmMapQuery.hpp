@@ -0,0 +1,48 @@
+#pragma once
+#include <Utils/Types.hpp>
+#include <Utils/Kernel.hpp>
+
+struct vm_map;
+struct vm_map_entry;
+
+namespace Mira
+{
+    namespace OrbisOS
+    {
+        struct VmMapFilter
+        {
+            // Entries overlapping [Start, End), End 0 for every address
+            uint64_t Start;
+            uint64_t End;
+
+            // Entries whose name starts with this, nullptr for every name
+            const char* Name;
+
+            // Entries with (prot & ProtMask) == Prot, PROT_CPU_* and PROT_GPU_* bits
+            uint16_t Prot;
+            uint16_t ProtMask;
+        };
+
+        /*
+            VmMapQuery
+
+            Walks the entries of a vm_map the caller has locked, at most once and stopping at the
+            end of the filter's range, and writes the matching ones out as ProcVmMapEntry.
+            Utilities takes the locks and references around it.
+        */
+        class VmMapQuery
+        {
+        public:
+            // Returns every match, which is more than p_MaxEntries when the buffer was too small
+            static size_t Collect(struct vm_map* p_Map, const VmMapFilter* p_Filter, ProcVmMapEntry* p_Entries, size_t p_MaxEntries);
+
+            static bool Matches(const VmMapFilter* p_Filter, const ProcVmMapEntry& p_Entry);
+            static void FillEntry(ProcVmMapEntry& p_Entry, const struct vm_map_entry* p_MapEntry);
+
+            // Entry containing p_Address, entries of one module, first entry with exactly p_Prot
+            static VmMapFilter Containing(uint64_t p_Address);
+            static VmMapFilter Named(const char* p_Name);
+            static VmMapFilter Protected(uint16_t p_Prot);
+        };
+    }
+}
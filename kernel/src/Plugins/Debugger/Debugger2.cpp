@@ -3,6 +3,7 @@
 
 #include "Debugger2.hpp"
 #include <Utils/Kdlsym.hpp>
+#include <Utils/HookManager.hpp>
 
 using namespace Mira::Plugins;
 
@@ -44,10 +45,13 @@ bool Debugger2::OnLoad()
     WriteLog(LL_Info, "creating trap_fatal hook");
     m_TrapFatalHook = new Utils::Hook(kdlsym(trap_fatal), reinterpret_cast<void*>(OnTrapFatal));
     
-    if (m_TrapFatalHook != nullptr)
+    // Installed by the framework together with every other staged hook
+    auto s_HookManager = Mira::Framework::GetFramework()->GetHookManager();
+    if (m_TrapFatalHook != nullptr && s_HookManager != nullptr)
     {
-        WriteLog(LL_Info, "enabling trap_fatal hook");
-        m_TrapFatalHook->Enable();
+        WriteLog(LL_Info, "staging trap_fatal hook");
+        if (!s_HookManager->StageEnable(m_TrapFatalHook))
+            WriteLog(LL_Error, "could not stage trap_fatal hook");
     }
 #endif
     return true;
@@ -59,7 +63,10 @@ bool Debugger2::OnUnload()
     WriteLog(LL_Info, "deleting trap fatal hook");
 	if (m_TrapFatalHook != nullptr)
     {
-        if (m_TrapFatalHook->IsEnabled())
+        auto s_HookManager = Mira::Framework::GetFramework()->GetHookManager();
+        if (s_HookManager != nullptr)
+            s_HookManager->Unregister(m_TrapFatalHook);
+        else if (m_TrapFatalHook->IsEnabled())
             m_TrapFatalHook->Disable();
         
         delete m_TrapFatalHook;
@@ -3,6 +3,7 @@
 
 #include "Debugger2.hpp"
 #include <Utils/Kdlsym.hpp>
+#include <Utils/HookStats.hpp>
 #include <Mira.hpp>
 
 extern "C"
@@ -50,6 +51,8 @@ bool Debugger2::IsStackSpace(void* p_Address)
 
 void Debugger2::OnTrapFatal(struct trapframe* frame, vm_offset_t eva)
 {
+	MIRA_HOOK_STATS_SCOPE(Utils::HookStatsId_TrapFatal);
+
 	int code, ss;
 	u_int type;
 	long esp;
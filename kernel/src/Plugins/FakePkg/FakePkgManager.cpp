@@ -14,11 +14,15 @@
 #include <Utils/_Syscall.hpp>
 #include <Utils/Logger.hpp>
 #include <Utils/SysWrappers.hpp>
+#include <Utils/HookStats.hpp>
 #include <Boot/Config.hpp>
 
 #include <OrbisOS/Utilities.hpp>
+#include <OrbisOS/PatchSet.hpp>
+#include <OrbisOS/SblMapIndex.hpp>
 
 #include <Mira.hpp>
+#include <Plugins/PluginManager.hpp>
 #include <Boot/Config.hpp>
 
 extern "C"
@@ -113,7 +117,9 @@ FakePkgManager::FakePkgManager() :
     m_NpdrmDecryptRifNewHook(nullptr),
     m_SceSblDriverSendMsgHook(nullptr),
     m_SceSblKeymgrInvalidateKey(nullptr),
-    m_SceSblPfsSetKeysHook(nullptr)
+    m_SceSblPfsSetKeysHook(nullptr),
+    m_ProcessStartSubscription(-1),
+    m_resumeEvent(nullptr)
 {
     auto sv = (struct sysentvec*)kdlsym(self_orbis_sysvec);
     struct sysent* sysents = sv->sv_table;
@@ -143,7 +149,6 @@ bool FakePkgManager::ShellCorePatch()
 {
     WriteLog(LL_Debug, "patching SceShellCore");
 
-
     struct ::proc* s_Process = Utilities::FindProcessByName("SceShellCore");
     if (s_Process == nullptr)
     {
@@ -151,144 +156,36 @@ bool FakePkgManager::ShellCorePatch()
         return false;
     }
 
-    ProcVmMapEntry* s_Entries = nullptr;
-    size_t s_NumEntries = 0;
-    auto s_Ret = Utilities::GetProcessVmMap(s_Process, &s_Entries, &s_NumEntries);
-    if (s_Ret < 0)
-    {
-        WriteLog(LL_Error, "could not get vm map");
-        return false;
-    }
-
-    if (s_Entries == nullptr || s_NumEntries == 0)
-    {
-        WriteLog(LL_Error, "invalid entries (%p) or numEntries (%d)", s_Entries, s_NumEntries);
-        return false;
-    }
-
-    uint8_t* s_TextStart = nullptr;
-    for (auto i = 0; i < s_NumEntries; ++i)
-    {
-        if (s_Entries[i].prot == (PROT_READ | PROT_EXEC))
-        {
-            s_TextStart = (uint8_t*)s_Entries[i].start;
-            break;
-        }
-    }
-
-    if (s_TextStart == nullptr)
-    {
-        WriteLog(LL_Error, "could not find SceShellCore text start");
-        return false;
-    }
-
-    WriteLog(LL_Debug, "SceShellCore .text: (%p)", s_TextStart);
-
-    // Free the entries we got returned
-    delete [] s_Entries;
-    s_Entries = nullptr;
-
-    uint8_t xor__eax_eax[5] = { 0x31, 0xC0, 0x90, 0x90, 0x90 };
-
-    /*
-    s_Ret = kptrace_t(PT_ATTACH, s_Process->p_pid, 0, 0, s_MainThread);
-    if (s_Ret < 0)
-    {
-        WriteLog(LL_Error, "could not attach to shellcore");
-        return false;
-    }
-
-    int32_t s_Status = 0;
-    s_Ret = kwait4_t(s_Process->p_pid, &s_Status, WUNTRACED, nullptr, s_MainThread);
-    WriteLog(LL_Debug, "wait4 returned (%d)", s_Ret);*/
-
-    s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_TextStart + ssc_sceKernelIsGenuineCEX_patchA), sizeof(xor__eax_eax), xor__eax_eax, nullptr, true);
-    if (s_Ret < 0)
-    {
-        WriteLog(LL_Error, "ssc_sceKernelIsGenuineCEX_patchA");
-        return false;
-    }
+    static const uint8_t xor__eax_eax[5] = { 0x31, 0xC0, 0x90, 0x90, 0x90 };
 
-    s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_TextStart + ssc_sceKernelIsGenuineCEX_patchB), sizeof(xor__eax_eax), xor__eax_eax, nullptr, true);
-    if (s_Ret < 0)
-    {
-        WriteLog(LL_Error, "ssc_sceKernelIsGenuineCEX_patchB");
-        return false;
-    }
-    
-    s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_TextStart + ssc_sceKernelIsGenuineCEX_patchC), sizeof(xor__eax_eax), xor__eax_eax, nullptr, true);
-    if (s_Ret < 0)
-    {
-        WriteLog(LL_Error, "ssc_sceKernelIsGenuineCEX_patchC");
-        return false;
-    }
-    
-    s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_TextStart + ssc_sceKernelIsGenuineCEX_patchD), sizeof(xor__eax_eax), xor__eax_eax, nullptr, true);
-    if (s_Ret < 0)
-    {
-        WriteLog(LL_Error, "ssc_sceKernelIsGenuineCEX_patchD");
-        return false;
-    }
-    
-    s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_TextStart + ssc_nidf_libSceDipsw_patchA), sizeof(xor__eax_eax), xor__eax_eax, nullptr, true);
-    if (s_Ret < 0)
-    {
-        WriteLog(LL_Error, "ssc_nidf_libSceDipsw_patchA");
-        return false;
-    }
-    
-    s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_TextStart + ssc_nidf_libSceDipsw_patchB), sizeof(xor__eax_eax), xor__eax_eax, nullptr, true);
-    if (s_Ret < 0)
+    static const PatchSetEntry s_Patches[] =
     {
-        WriteLog(LL_Error, "ssc_nidf_libSceDipsw_patchB");
-        return false;
-    }
-    
-    s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_TextStart + ssc_nidf_libSceDipsw_patchC), sizeof(xor__eax_eax), xor__eax_eax, nullptr, true);
-    if (s_Ret < 0)
-    {
-        WriteLog(LL_Error, "ssc_nidf_libSceDipsw_patchC");
-        return false;
-    }
-    
-    s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_TextStart + ssc_nidf_libSceDipsw_patchD), sizeof(xor__eax_eax), xor__eax_eax, nullptr, true);
-    if (s_Ret < 0)
-    {
-        WriteLog(LL_Error, "ssc_nidf_libSceDipsw_patchD");
-        return false;
-    }
-
+        { "ssc_sceKernelIsGenuineCEX_patchA", nullptr, ssc_sceKernelIsGenuineCEX_patchA, nullptr, xor__eax_eax, sizeof(xor__eax_eax) },
+        { "ssc_sceKernelIsGenuineCEX_patchB", nullptr, ssc_sceKernelIsGenuineCEX_patchB, nullptr, xor__eax_eax, sizeof(xor__eax_eax) },
+        { "ssc_sceKernelIsGenuineCEX_patchC", nullptr, ssc_sceKernelIsGenuineCEX_patchC, nullptr, xor__eax_eax, sizeof(xor__eax_eax) },
+        { "ssc_sceKernelIsGenuineCEX_patchD", nullptr, ssc_sceKernelIsGenuineCEX_patchD, nullptr, xor__eax_eax, sizeof(xor__eax_eax) },
+        { "ssc_nidf_libSceDipsw_patchA", nullptr, ssc_nidf_libSceDipsw_patchA, nullptr, xor__eax_eax, sizeof(xor__eax_eax) },
+        { "ssc_nidf_libSceDipsw_patchB", nullptr, ssc_nidf_libSceDipsw_patchB, nullptr, xor__eax_eax, sizeof(xor__eax_eax) },
+        { "ssc_nidf_libSceDipsw_patchC", nullptr, ssc_nidf_libSceDipsw_patchC, nullptr, xor__eax_eax, sizeof(xor__eax_eax) },
+        { "ssc_nidf_libSceDipsw_patchD", nullptr, ssc_nidf_libSceDipsw_patchD, nullptr, xor__eax_eax, sizeof(xor__eax_eax) },
 #if MIRA_PLATFORM==MIRA_PLATFORM_ORBIS_BSD_505
-	s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_TextStart + ssc_enable_fakepkg_patch), 8, (void*)"\xE9\x96\x00\x00\x00\x90\x90\x90", nullptr, true);
-	if (s_Ret < 0)
-	{
-		WriteLog(LL_Error, "ssc_enable_fakepkg_patch");
-		return false;
-	}
+        { "ssc_enable_fakepkg_patch", nullptr, ssc_enable_fakepkg_patch, nullptr, reinterpret_cast<const uint8_t*>("\xE9\x96\x00\x00\x00\x90\x90\x90"), 8 },
 #endif
+        { "ssc_fake_to_free_patch", nullptr, ssc_fake_to_free_patch, nullptr, reinterpret_cast<const uint8_t*>("free"), 4 },
+    };
 
-    s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_TextStart + ssc_fake_to_free_patch), 4, (void*)"free", nullptr, true);
+    // What the patches replaced the first time, later applies expect it
+    static PatchSetRecord s_Record;
+
+    PatchSet s_PatchSet("SceShellCore", s_Patches, ARRAYSIZE(s_Patches), &s_Record);
+    auto s_Ret = s_PatchSet.Apply(s_Process);
+    Utilities::ReleaseProcess(s_Process);
     if (s_Ret < 0)
     {
-        WriteLog(LL_Error, "ssc_fake_to_free_patch");
+        WriteLog(LL_Error, "could not patch SceShellCore");
         return false;
     }
 
-    /*Utilities::PtraceIO(s_Process->p_pid, PIOD_WRITE_I, (void*)(s_TextStart + SHELLCORE_ENABLE_DEBUG_PKG_PATCH_1_1_OFFSET), xor__eax_eax, sizeof(xor__eax_eax));
-    Utilities::PtraceIO(s_Process->p_pid, PIOD_WRITE_I, (void*)(s_TextStart + SHELLCORE_ENABLE_DEBUG_PKG_PATCH_1_2_OFFSET), xor__eax_eax, sizeof(xor__eax_eax));
-    Utilities::PtraceIO(s_Process->p_pid, PIOD_WRITE_I, (void*)(s_TextStart + SHELLCORE_ENABLE_DEBUG_PKG_PATCH_1_3_OFFSET), xor__eax_eax, sizeof(xor__eax_eax));
-    Utilities::PtraceIO(s_Process->p_pid, PIOD_WRITE_I, (void*)(s_TextStart + SHELLCORE_ENABLE_DEBUG_PKG_PATCH_1_4_OFFSET), xor__eax_eax, sizeof(xor__eax_eax));
-    Utilities::PtraceIO(s_Process->p_pid, PIOD_WRITE_I, (void*)(s_TextStart + SHELLCORE_ENABLE_DEBUG_PKG_PATCH_2_1_OFFSET), xor__eax_eax, sizeof(xor__eax_eax));
-    Utilities::PtraceIO(s_Process->p_pid, PIOD_WRITE_I, (void*)(s_TextStart + SHELLCORE_ENABLE_DEBUG_PKG_PATCH_2_2_OFFSET), xor__eax_eax, sizeof(xor__eax_eax));
-    Utilities::PtraceIO(s_Process->p_pid, PIOD_WRITE_I, (void*)(s_TextStart + SHELLCORE_ENABLE_DEBUG_PKG_PATCH_2_3_OFFSET), xor__eax_eax, sizeof(xor__eax_eax));
-    Utilities::PtraceIO(s_Process->p_pid, PIOD_WRITE_I, (void*)(s_TextStart + SHELLCORE_ENABLE_DEBUG_PKG_PATCH_2_4_OFFSET), xor__eax_eax, sizeof(xor__eax_eax));
-    Utilities::PtraceIO(s_Process->p_pid, PIOD_WRITE_I, (void*)(s_TextStart + SHELLCORE_USE_FREE_PREFIX_INSTEAD_OF_FAKE_OFFSET), (void*)"free", 4);
-    if (kptrace_t(PT_DETACH, s_Process->p_pid, (caddr_t)SIGCONT, 0, s_MainThread) < 0)
-    {
-        WriteLog(LL_Error, "could not detach from shellcore");
-        return false;
-    }*/
-
     WriteLog(LL_Debug, "SceShellCore successfully patched");
 
     return true;
@@ -296,6 +193,11 @@ bool FakePkgManager::ShellCorePatch()
 
 bool FakePkgManager::ShellUIPatch()
 {
+    // TODO: Fix all fw suport; I don't feel like fixing 1.76 support atm -kd
+    #if MIRA_PLATFORM <= MIRA_PLATFORM_ORBIS_BSD_176 || MIRA_PLATFORM > MIRA_PLATFORM_ORBIS_BSD_505 && MIRA_PLATFORM!=MIRA_PLATFORM_ORBIS_BSD_620 
+    return true;
+    #else
+
     WriteLog(LL_Debug, "patching SceShellUI");
 
     struct ::proc* s_Process = Utilities::FindProcessByName("SceShellUI");
@@ -305,68 +207,30 @@ bool FakePkgManager::ShellUIPatch()
         return false;
     }
 
-    ProcVmMapEntry* s_Entries = nullptr;
-    size_t s_NumEntries = 0;
-    auto s_Ret = Utilities::GetProcessVmMap(s_Process, &s_Entries, &s_NumEntries);
-    if (s_Ret < 0)
-    {
-        WriteLog(LL_Error, "could not get vm map");
-        return false;
-    }
-
-    if (s_Entries == nullptr || s_NumEntries == 0)
-    {
-        WriteLog(LL_Error, "invalid entries (%p) or numEntries (%d)", s_Entries, s_NumEntries);
-        return false;
-    }
+    static const uint8_t mov__eax_1__ret[6] = { 0xB8, 0x01, 0x00, 0x00, 0x00, 0xC3 };
 
-    uint8_t* s_LibKernelTextStart = nullptr;
-    for (auto i = 0; i < s_NumEntries; ++i)
+    static const PatchSetEntry s_Patches[] =
     {
-        if (!memcmp(s_Entries[i].name, "libkernel_sys.sprx", 18) && s_Entries[i].prot >= (PROT_READ | PROT_EXEC))
-        {
-            s_LibKernelTextStart = (uint8_t*)s_Entries[i].start;
-            break;
-        }
-    }
-
-    if (s_LibKernelTextStart == nullptr)
-    {
-        WriteLog(LL_Error, "could not find SceShellUI libkernel_sys.sprx text start");
-        return false;
-    }
-
-    WriteLog(LL_Debug, "SceShellUI libkernel_sys.sprx .text: (%p)", s_LibKernelTextStart);
-
-    // Free the entries we got returned
-    delete [] s_Entries;
-    s_Entries = nullptr;
-
-    // TODO: Fix all fw suport; I don't feel like fixing 1.76 support atm -kd
-    #if MIRA_PLATFORM <= MIRA_PLATFORM_ORBIS_BSD_176 || MIRA_PLATFORM > MIRA_PLATFORM_ORBIS_BSD_505 && MIRA_PLATFORM!=MIRA_PLATFORM_ORBIS_BSD_620 
-    #else
+        { "ssu_sceSblRcMgrIsAllowDebugMenuForSettings_patch", "libkernel_sys.sprx", ssu_sceSblRcMgrIsAllowDebugMenuForSettings_patch, nullptr, mov__eax_1__ret, sizeof(mov__eax_1__ret) },
+        { "ssu_sceSblRcMgrIsStoreMode_patch", "libkernel_sys.sprx", ssu_sceSblRcMgrIsStoreMode_patch, nullptr, mov__eax_1__ret, sizeof(mov__eax_1__ret) },
+    };
 
-    uint8_t mov__eax_1__ret[6] = { 0xB8, 0x01, 0x00, 0x00, 0x00, 0xC3 };
+    // SceShellUI is patched again on every restart and resume, each time against what the first run found
+    static PatchSetRecord s_Record;
 
-    s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_LibKernelTextStart + ssu_sceSblRcMgrIsAllowDebugMenuForSettings_patch), sizeof(mov__eax_1__ret), mov__eax_1__ret, nullptr, true);
+    PatchSet s_PatchSet("SceShellUI", s_Patches, ARRAYSIZE(s_Patches), &s_Record);
+    auto s_Ret = s_PatchSet.Apply(s_Process);
+    Utilities::ReleaseProcess(s_Process);
     if (s_Ret < 0)
     {
-        WriteLog(LL_Error, "ssu_sceSblRcMgrIsAllowDebugMenuForSettings_patch");
+        WriteLog(LL_Error, "could not patch SceShellUI");
         return false;
     }
 
-    s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_LibKernelTextStart + ssu_sceSblRcMgrIsStoreMode_patch), sizeof(mov__eax_1__ret), mov__eax_1__ret, nullptr, true);
-    if (s_Ret < 0)
-    {
-        WriteLog(LL_Error, "ssu_sceSblRcMgrIsStoreMode_patch");
-        return false;
-    }
-
-    #endif
-
     WriteLog(LL_Debug, "SceShellUI successfully patched");
 
     return true;
+    #endif
 }
 
 void FakePkgManager::ResumeEvent()
@@ -376,19 +240,10 @@ void FakePkgManager::ResumeEvent()
     return;
 }
 
-void FakePkgManager::ProcessStartEvent(void *arg, struct ::proc *p)
+void FakePkgManager::ProcessStartEvent(Mira::OrbisOS::ProcessInfo* p_Info, void* p_Argument)
 {
-    auto strncmp = (int(*)(const char *, const char *, size_t))kdlsym(strncmp);
-
-    if (!p)
-        return;
-
-    char* s_TitleId = (char*)((uint64_t)p + 0x390);
-    if (strncmp(s_TitleId, "NPXS20001", 9) == 0) {
-        ShellUIPatch();
-    }
-
-    return;
+    // Only subscribed for SceShellUI (NPXS20001)
+    ShellUIPatch();
 }
 
 bool FakePkgManager::OnLoad()
@@ -406,9 +261,16 @@ bool FakePkgManager::OnLoad()
     // Initialize the event handlers
     auto eventhandler_register = (eventhandler_tag(*)(struct eventhandler_list *list, const char *name, void *func, void *arg, int priority))kdlsym(eventhandler_register);
 
-    m_processStartEvent = eventhandler_register(NULL, "process_exec_end", reinterpret_cast<void*>(FakePkgManager::ProcessStartEvent), NULL, EVENTHANDLER_PRI_LAST);
     m_resumeEvent = eventhandler_register(NULL, "system_resume_phase4", reinterpret_cast<void*>(FakePkgManager::ResumeEvent), NULL, EVENTHANDLER_PRI_LAST);
 
+    // Patch SceShellUI again every time it restarts
+    auto s_ProcessEvents = Mira::Framework::GetFramework()->GetProcessEvents();
+    if (s_ProcessEvents != nullptr)
+    {
+        Mira::OrbisOS::ProcessEventFilter s_Filter = { Mira::OrbisOS::ProcessEventFilter_None, "NPXS20001", "" };
+        m_ProcessStartSubscription = s_ProcessEvents->Subscribe(Mira::OrbisOS::ProcessEvent_Start, s_Filter, FakePkgManager::ProcessStartEvent, nullptr);
+    }
+
     return true;
 }
 
@@ -417,21 +279,46 @@ bool FakePkgManager::OnUnload()
     auto eventhandler_deregister = (void(*)(struct eventhandler_list* a, struct eventhandler_entry* b))kdlsym(eventhandler_deregister);
     auto eventhandler_find_list = (struct eventhandler_list * (*)(const char *name))kdlsym(eventhandler_find_list);
 
-    if (m_processStartEvent) {
-        EVENTHANDLER_DEREGISTER(process_exec_end, m_processStartEvent);
-        m_processStartEvent = nullptr;
+    auto s_ProcessEvents = Mira::Framework::GetFramework()->GetProcessEvents();
+    if (s_ProcessEvents != nullptr && m_ProcessStartSubscription >= 0) {
+        s_ProcessEvents->Unsubscribe(m_ProcessStartSubscription);
+        m_ProcessStartSubscription = -1;
     }
 
     if (m_resumeEvent) {
-        EVENTHANDLER_DEREGISTER(process_exit, m_resumeEvent);
+        EVENTHANDLER_DEREGISTER(system_resume_phase4, m_resumeEvent);
         m_resumeEvent = nullptr;
     }
 
+    WriteLog(LL_Debug, "pfs key cache (%llu) hits (%llu) misses", m_PfsKeys.GetHits(), m_PfsKeys.GetMisses());
+    m_PfsKeys.Clear();
+
     return true;
 }
 
+PfsKeyCache* FakePkgManager::GetPfsKeyCache()
+{
+    auto s_Framework = Mira::Framework::GetFramework();
+    if (s_Framework == nullptr)
+        return nullptr;
+
+    auto s_PluginManager = s_Framework->GetPluginManager();
+    if (s_PluginManager == nullptr)
+        return nullptr;
+
+    auto s_FakePkgManager = static_cast<FakePkgManager*>(s_PluginManager->GetFakePkgManager());
+    if (s_FakePkgManager == nullptr)
+        return nullptr;
+
+    return s_FakePkgManager->GetPfsKeys();
+}
+
 bool FakePkgManager::OnSuspend()
 {
+    // Nothing derived from a package key is kept across rest mode
+    WriteLog(LL_Debug, "pfs key cache (%llu) hits (%llu) misses", m_PfsKeys.GetHits(), m_PfsKeys.GetMisses());
+    m_PfsKeys.Clear();
+
     return true;
 }
 
@@ -495,35 +382,8 @@ int FakePkgManager::DecryptNpdrmDebugRif(uint32_t p_Type, uint8_t* p_Data)
 
 SblMapListEntry* FakePkgManager::SceSblDriverFindMappedPageListByGpuVa(vm_offset_t p_GpuVa)
 {
-    if (p_GpuVa == 0)
-    {
-        WriteLog(LL_Error, "invalid gpu va");
-        return nullptr;
-    }
-
-    auto _mtx_lock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_lock_flags);
-    auto _mtx_unlock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_unlock_flags);
-    auto s_SblDrvMsgMtx = (struct mtx*)kdlsym(sbl_drv_msg_mtx);
-
-    SblMapListEntry* s_Entry = *(SblMapListEntry**)kdlsym(gpu_va_page_list);
-    SblMapListEntry* s_FinalEntry = nullptr;
-
-    // Lock before we iterate this list, because other paths can absolutely use it concurrently
-    _mtx_lock_flags(s_SblDrvMsgMtx, 0, __FILE__, __LINE__);
-
-    while (s_Entry)
-    {
-        if (s_Entry->gpuVa == p_GpuVa)
-        {
-            s_FinalEntry = s_Entry;
-            break;
-        }
-
-        s_Entry = s_Entry->next;
-    }
-
-    _mtx_unlock_flags(s_SblDrvMsgMtx, 0, __FILE__, __LINE__);
-    return s_FinalEntry;
+    // Shared with the other mailbox hooks, indexed instead of walking gpu_va_page_list every time
+    return SblMapIndex::FindMappedPageList(p_GpuVa);
 }
 
 vm_offset_t FakePkgManager::SceSblDriverGpuVaToCpuVa(vm_offset_t p_GpuVa, size_t* p_NumPageGroups)
@@ -541,6 +401,8 @@ vm_offset_t FakePkgManager::SceSblDriverGpuVaToCpuVa(vm_offset_t p_GpuVa, size_t
 
 int FakePkgManager::OnSceSblDriverSendMsg(SblMsg* p_Message, size_t p_Size) __attribute__ ((optnone))
 {
+    MIRA_HOOK_STATS_SCOPE(Utils::HookStatsId_SceSblDriverSendMsg);
+
     auto sceSblDriverSendMsg = (int (*)(SblMsg* msg, size_t size))kdlsym(sceSblDriverSendMsg);
     if (p_Message->hdr.cmd != SBL_MSG_CCP)
         return sceSblDriverSendMsg(p_Message, p_Size);
@@ -568,6 +430,8 @@ int FakePkgManager::OnSceSblDriverSendMsg(SblMsg* p_Message, size_t p_Size) __at
 
 int FakePkgManager::OnSceSblPfsSetKeys(uint32_t* ekh, uint32_t* skh, uint8_t* eekpfs, Ekc* eekc, uint32_t pubkey_ver, uint32_t key_ver, PfsHeader* hdr, size_t hdr_size, uint32_t type, uint32_t finalized, uint32_t is_disc)
 {
+    MIRA_HOOK_STATS_SCOPE(Utils::HookStatsId_SceSblPfsSetKeys);
+
     auto sceSblPfsSetKeys = (int(*)(uint32_t* p_Ekh, uint32_t* p_Skh, uint8_t* p_Eekpfs, Ekc* p_Eekc, unsigned int p_PubkeyVer, unsigned int p_KeyVer, PfsHeader* p_Header, size_t p_HeaderSize, unsigned int p_Type, unsigned int p_Finalized, unsigned int p_IsDisc))kdlsym(sceSblPfsSetKeys);
     auto RsaesPkcs1v15Dec2048CRT = (int (*)(RsaBuffer* out, RsaBuffer* in, RsaKey* key))kdlsym(RsaesPkcs1v15Dec2048CRT);
     auto fpu_kern_enter = (int(*)(struct thread *td, struct fpu_kern_ctx *ctx, u_int flags))kdlsym(fpu_kern_enter);
@@ -590,8 +454,17 @@ int FakePkgManager::OnSceSblPfsSetKeys(uint32_t* ekh, uint32_t* skh, uint8_t* ee
     uint8_t iv[16];
     SblKeyDesc enc_key_desc;
     SblKeyDesc sign_key_desc;
+    uint8_t enc_key[PfsKeyCache_KeySize];
+    uint8_t sign_key[PfsKeyCache_KeySize];
+    PfsKeyCache* s_KeyCache = nullptr;
     int32_t ret, orig_ret = 0;
 
+    memset(ekpfs, 0, sizeof(ekpfs));
+    memset(enc_key, 0, sizeof(enc_key));
+    memset(sign_key, 0, sizeof(sign_key));
+    memset(&enc_key_desc, 0, sizeof(enc_key_desc));
+    memset(&sign_key_desc, 0, sizeof(sign_key_desc));
+
     ret = orig_ret = sceSblPfsSetKeys(ekh, skh, eekpfs, eekc, pubkey_ver, key_ver, hdr, hdr_size, type, finalized, is_disc);
 	
 	if (ret) {
@@ -603,78 +476,73 @@ int FakePkgManager::OnSceSblPfsSetKeys(uint32_t* ekh, uint32_t* skh, uint8_t* ee
 				goto err;
 			}
 		} else {
-			memset(&in_data, 0, sizeof(in_data));
-			in_data.ptr = eekpfs;
-			in_data.size = EEKPFS_SIZE;
-
-			memset(&out_data, 0, sizeof(out_data));
-			out_data.ptr = ekpfs;
-			out_data.size = EKPFS_SIZE;
-
-			memset(&key, 0, sizeof(key));
-			key.p = (uint8_t*)g_ypkg_p;
-			key.q = (uint8_t*)g_ypkg_q;
-			key.dmp1 = (uint8_t*)g_ypkg_dmp1;
-			key.dmq1 = (uint8_t*)g_ypkg_dmq1;
-			key.iqmp = (uint8_t*)g_ypkg_iqmp;
-
 			td = curthread;
 
-			fpu_kern_enter(td, fpu_kern_ctx, 0);
-			{
-				ret = RsaesPkcs1v15Dec2048CRT(&out_data, &in_data, &key);
-			}
-			fpu_kern_leave(td, fpu_kern_ctx);
-
-			if (ret) {
-				ret = orig_ret;
-				goto err;
-			}
-
-			A_sx_xlock_hard(sbl_pfs_sx,0);
-			{
-				memset(&enc_key_desc, 0, sizeof(enc_key_desc));
+			// Mounting a package that was mounted before skips the RSA unwrap and the key derivation
+			s_KeyCache = GetPfsKeyCache();
+			if (s_KeyCache == nullptr || !s_KeyCache->Find(eekpfs, hdr->cryptSeed, enc_key, sign_key)) {
+				memset(&in_data, 0, sizeof(in_data));
+				in_data.ptr = eekpfs;
+				in_data.size = EEKPFS_SIZE;
+
+				memset(&out_data, 0, sizeof(out_data));
+				out_data.ptr = ekpfs;
+				out_data.size = EKPFS_SIZE;
+
+				memset(&key, 0, sizeof(key));
+				key.p = (uint8_t*)g_ypkg_p;
+				key.q = (uint8_t*)g_ypkg_q;
+				key.dmp1 = (uint8_t*)g_ypkg_dmp1;
+				key.dmq1 = (uint8_t*)g_ypkg_dmq1;
+				key.iqmp = (uint8_t*)g_ypkg_iqmp;
+
+				fpu_kern_enter(td, fpu_kern_ctx, 0);
 				{
-					enc_key_desc.Pfs.obfuscatedKeyId = PFS_FAKE_OBF_KEY_ID;
-					enc_key_desc.Pfs.keySize = sizeof(enc_key_desc.Pfs.escrowedKey);
-
-					GenPfsEncKey(ekpfs, hdr->cryptSeed, enc_key_desc.Pfs.escrowedKey);
-
-					fpu_kern_enter(td, fpu_kern_ctx, 0);
-					{
-						memset(iv, 0, sizeof(iv));
-						ret = AesCbcCfb128Encrypt(enc_key_desc.Pfs.escrowedKey, enc_key_desc.Pfs.escrowedKey, sizeof(enc_key_desc.Pfs.escrowedKey), g_FakeKeySeed, sizeof(g_FakeKeySeed) * 8, iv);
-					}
-					fpu_kern_leave(td, fpu_kern_ctx);
+					ret = RsaesPkcs1v15Dec2048CRT(&out_data, &in_data, &key);
 				}
+				fpu_kern_leave(td, fpu_kern_ctx);
+
 				if (ret) {
-                    WriteLog(LL_Error, "AesCbcCfb128Encrypt returned (%d)", ret);
-					A_sx_xunlock_hard(sbl_pfs_sx);
 					ret = orig_ret;
 					goto err;
 				}
 
-				memset(&sign_key_desc, 0, sizeof(sign_key_desc));
-				{
-					sign_key_desc.Pfs.obfuscatedKeyId = PFS_FAKE_OBF_KEY_ID;
-					sign_key_desc.Pfs.keySize = sizeof(sign_key_desc.Pfs.escrowedKey);
+				GenPfsEncKey(ekpfs, hdr->cryptSeed, enc_key);
+				GenPfsSignKey(ekpfs, hdr->cryptSeed, sign_key);
 
-					GenPfsSignKey(ekpfs, hdr->cryptSeed, sign_key_desc.Pfs.escrowedKey);
-
-					fpu_kern_enter(td, fpu_kern_ctx, 0);
-					{
+				fpu_kern_enter(td, fpu_kern_ctx, 0);
+				{
+					memset(iv, 0, sizeof(iv));
+					ret = AesCbcCfb128Encrypt(enc_key, enc_key, sizeof(enc_key), g_FakeKeySeed, sizeof(g_FakeKeySeed) * 8, iv);
+					if (!ret) {
 						memset(iv, 0, sizeof(iv));
-						ret = AesCbcCfb128Encrypt(sign_key_desc.Pfs.escrowedKey, sign_key_desc.Pfs.escrowedKey, sizeof(sign_key_desc.Pfs.escrowedKey), g_FakeKeySeed, sizeof(g_FakeKeySeed) * 8, iv);
+						ret = AesCbcCfb128Encrypt(sign_key, sign_key, sizeof(sign_key), g_FakeKeySeed, sizeof(g_FakeKeySeed) * 8, iv);
 					}
-					fpu_kern_leave(td, fpu_kern_ctx);
 				}
+				fpu_kern_leave(td, fpu_kern_ctx);
+
 				if (ret) {
                     WriteLog(LL_Error, "AesCbcCfb128Encrypt returned (%d).", ret);
-					A_sx_xunlock_hard(sbl_pfs_sx);
 					ret = orig_ret;
 					goto err;
 				}
 
+				if (s_KeyCache != nullptr)
+					s_KeyCache->Add(eekpfs, hdr->cryptSeed, enc_key, sign_key);
+			}
+
+			A_sx_xlock_hard(sbl_pfs_sx,0);
+			{
+				memset(&enc_key_desc, 0, sizeof(enc_key_desc));
+				enc_key_desc.Pfs.obfuscatedKeyId = PFS_FAKE_OBF_KEY_ID;
+				enc_key_desc.Pfs.keySize = sizeof(enc_key_desc.Pfs.escrowedKey);
+				memcpy(enc_key_desc.Pfs.escrowedKey, enc_key, sizeof(enc_key_desc.Pfs.escrowedKey));
+
+				memset(&sign_key_desc, 0, sizeof(sign_key_desc));
+				sign_key_desc.Pfs.obfuscatedKeyId = PFS_FAKE_OBF_KEY_ID;
+				sign_key_desc.Pfs.keySize = sizeof(sign_key_desc.Pfs.escrowedKey);
+				memcpy(sign_key_desc.Pfs.escrowedKey, sign_key, sizeof(sign_key_desc.Pfs.escrowedKey));
+
 				ret = sceSblKeymgrSetKeyForPfs(&enc_key_desc, ekh);
 				if (ret) {
 					if (*ekh != 0xFFFFFFFF)
@@ -701,6 +569,13 @@ int FakePkgManager::OnSceSblPfsSetKeys(uint32_t* ekh, uint32_t* skh, uint8_t* ee
 	}
 
 err:
+	// Keys only stay around in the cache
+	memset(ekpfs, 0, sizeof(ekpfs));
+	memset(enc_key, 0, sizeof(enc_key));
+	memset(sign_key, 0, sizeof(sign_key));
+	memset(&enc_key_desc, 0, sizeof(enc_key_desc));
+	memset(&sign_key_desc, 0, sizeof(sign_key_desc));
+
 	return ret;
 
     /*
@@ -836,6 +711,8 @@ err:
 
 int FakePkgManager::OnNpdrmDecryptIsolatedRif(KeymgrPayload* p_Payload)
 {
+    MIRA_HOOK_STATS_SCOPE(Utils::HookStatsId_NpdrmDecryptIsolatedRif);
+
     auto sceSblKeymgrSmCallfunc = (int (*)(KeymgrPayload* payload))kdlsym(sceSblKeymgrSmCallfunc);
 
     // it's SM request, thus we have the GPU address here, so we need to convert it to the CPU address
@@ -859,6 +736,8 @@ int FakePkgManager::OnNpdrmDecryptIsolatedRif(KeymgrPayload* p_Payload)
 
 int FakePkgManager::OnNpdrmDecryptRifNew(KeymgrPayload* p_Payload)
 {
+    MIRA_HOOK_STATS_SCOPE(Utils::HookStatsId_NpdrmDecryptRifNew);
+
     auto sceSblKeymgrSmCallfunc = (int (*)(KeymgrPayload* payload))kdlsym(sceSblKeymgrSmCallfunc);
 
     // it's SM request, thus we have the GPU address here, so we need to convert it to the CPU address 
@@ -927,6 +806,8 @@ SblKeyRbtreeEntry* FakePkgManager::sceSblKeymgrGetKey(unsigned int p_Handle)
 
 int FakePkgManager::OnSceSblKeymgrInvalidateKeySxXlock(struct sx* p_Sx, int p_Opts, const char* p_File, int p_Line) 
 {
+    MIRA_HOOK_STATS_SCOPE(Utils::HookStatsId_SceSblKeymgrInvalidateKey);
+
     //WriteLog(LL_Debug, "OnSceSblKeymgrInvalidateKeySxXlock");
     auto sceSblKeymgrSetKeyStorage = (int (*)(uint64_t key_gpu_va, unsigned int key_size, uint32_t key_id, uint32_t key_handle))kdlsym(sceSblKeymgrSetKeyStorage);
     auto sblKeymgrKeySlots = (_SblKeySlotQueue *)kdlsym(sbl_keymgr_key_slots);
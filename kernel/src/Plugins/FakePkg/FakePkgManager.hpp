@@ -11,6 +11,9 @@
 #include <Utils/Hook.hpp>
 
 #include <OrbisOS/FakeStructs.hpp>
+#include <OrbisOS/ProcessEvents.hpp>
+
+#include "PfsKeyCache.hpp"
 
 extern "C"
 {
@@ -31,9 +34,12 @@ namespace Mira
             Utils::Hook* m_SceSblKeymgrInvalidateKey;
             Utils::Hook* m_SceSblPfsSetKeysHook;
 
-            eventhandler_entry* m_processStartEvent;
+            int32_t m_ProcessStartSubscription;
             eventhandler_entry* m_resumeEvent;
 
+            // Keys of fake packages that were already mounted
+            PfsKeyCache m_PfsKeys;
+
             static const uint8_t g_ypkg_p[0x80];
             static const uint8_t g_ypkg_q[0x80];
             static const uint8_t g_ypkg_dmp1[0x80];
@@ -52,7 +58,11 @@ namespace Mira
             virtual bool OnSuspend() override;
             virtual bool OnResume() override;
 
+            PfsKeyCache* GetPfsKeys() { return &m_PfsKeys; }
+
         private:
+            static PfsKeyCache* GetPfsKeyCache();
+
             // Helper functions
             static void GenPfsCryptoKey(uint8_t* p_EncryptionKeyPFS, uint8_t p_Seed[OrbisOS::PFS_SEED_SIZE], uint32_t p_Index, uint8_t p_Key[OrbisOS::PFS_FINAL_KEY_SIZE]);
             static void GenPfsEncKey(uint8_t* p_EncryptionKeyPFS, uint8_t p_Seed[OrbisOS::PFS_SEED_SIZE], uint8_t p_Key[OrbisOS::PFS_FINAL_KEY_SIZE]);
@@ -75,7 +85,7 @@ namespace Mira
             static bool ShellCorePatch();
             static bool ShellUIPatch();
             static void ResumeEvent();
-            static void ProcessStartEvent(void *arg, struct ::proc *p);
+            static void ProcessStartEvent(Mira::OrbisOS::ProcessInfo* p_Info, void* p_Argument);
 
             };
     }
@@ -0,0 +1,146 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "PfsKeyCache.hpp"
+#include <Utils/Kdlsym.hpp>
+#include <Utils/Kernel.hpp>
+
+using namespace Mira::Plugins;
+
+PfsKeyCache::PfsKeyCache() :
+    m_UseCounter(0),
+    m_Hits(0),
+    m_Misses(0)
+{
+    auto mtx_init = (void(*)(struct mtx *m, const char *name, const char *type, int opts))kdlsym(mtx_init);
+
+    memset(m_Entries, 0, sizeof(m_Entries));
+
+    mtx_init(&m_Mutex, "FakePkgKeys", nullptr, MTX_DEF);
+}
+
+PfsKeyCache::~PfsKeyCache()
+{
+    auto mtx_destroy = (void(*)(struct mtx *))kdlsym(mtx_destroy);
+
+    Clear();
+
+    mtx_destroy(&m_Mutex);
+}
+
+bool PfsKeyCache::Find(const uint8_t* p_Eekpfs, const uint8_t* p_Seed, uint8_t* p_OutEncryptionKey, uint8_t* p_OutSigningKey)
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    if (p_Eekpfs == nullptr || p_Seed == nullptr || p_OutEncryptionKey == nullptr || p_OutSigningKey == nullptr)
+        return false;
+
+    auto s_Hash = Hash(p_Eekpfs, p_Seed);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    auto s_Index = FindIndex(s_Hash, p_Eekpfs, p_Seed);
+    if (s_Index >= 0)
+    {
+        auto& s_Entry = m_Entries[s_Index];
+        s_Entry.LastUse = ++m_UseCounter;
+        memcpy(p_OutEncryptionKey, s_Entry.EncryptionKey, sizeof(s_Entry.EncryptionKey));
+        memcpy(p_OutSigningKey, s_Entry.SigningKey, sizeof(s_Entry.SigningKey));
+        m_Hits++;
+    }
+    else
+        m_Misses++;
+    _mtx_unlock_flags(&m_Mutex, 0);
+
+    return s_Index >= 0;
+}
+
+void PfsKeyCache::Add(const uint8_t* p_Eekpfs, const uint8_t* p_Seed, const uint8_t* p_EncryptionKey, const uint8_t* p_SigningKey)
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    if (p_Eekpfs == nullptr || p_Seed == nullptr || p_EncryptionKey == nullptr || p_SigningKey == nullptr)
+        return;
+
+    auto s_Hash = Hash(p_Eekpfs, p_Seed);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    do
+    {
+        // Another mount of the same package may have added it while this one was deriving
+        if (FindIndex(s_Hash, p_Eekpfs, p_Seed) >= 0)
+            break;
+
+        // Take a free slot, or evict the least recently used one
+        uint32_t s_Slot = 0;
+        for (uint32_t l_Index = 0; l_Index < PfsKeyCache_EntryCount; ++l_Index)
+        {
+            if (!m_Entries[l_Index].Used)
+            {
+                s_Slot = l_Index;
+                break;
+            }
+
+            if (m_Entries[l_Index].LastUse < m_Entries[s_Slot].LastUse)
+                s_Slot = l_Index;
+        }
+
+        auto& s_Entry = m_Entries[s_Slot];
+        s_Entry.Used = true;
+        s_Entry.Hash = s_Hash;
+        s_Entry.LastUse = ++m_UseCounter;
+        memcpy(s_Entry.Eekpfs, p_Eekpfs, sizeof(s_Entry.Eekpfs));
+        memcpy(s_Entry.Seed, p_Seed, sizeof(s_Entry.Seed));
+        memcpy(s_Entry.EncryptionKey, p_EncryptionKey, sizeof(s_Entry.EncryptionKey));
+        memcpy(s_Entry.SigningKey, p_SigningKey, sizeof(s_Entry.SigningKey));
+    } while (false);
+    _mtx_unlock_flags(&m_Mutex, 0);
+}
+
+void PfsKeyCache::Clear()
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    memset(m_Entries, 0, sizeof(m_Entries));
+    m_UseCounter = 0;
+    _mtx_unlock_flags(&m_Mutex, 0);
+}
+
+int32_t PfsKeyCache::FindIndex(uint64_t p_Hash, const uint8_t* p_Eekpfs, const uint8_t* p_Seed)
+{
+    for (uint32_t l_Index = 0; l_Index < PfsKeyCache_EntryCount; ++l_Index)
+    {
+        auto& l_Entry = m_Entries[l_Index];
+        if (!l_Entry.Used || l_Entry.Hash != p_Hash)
+            continue;
+
+        if (memcmp(l_Entry.Eekpfs, p_Eekpfs, sizeof(l_Entry.Eekpfs)) != 0 || memcmp(l_Entry.Seed, p_Seed, sizeof(l_Entry.Seed)) != 0)
+            continue;
+
+        return static_cast<int32_t>(l_Index);
+    }
+
+    return -1;
+}
+
+uint64_t PfsKeyCache::Hash(const uint8_t* p_Eekpfs, const uint8_t* p_Seed)
+{
+    // FNV-1a, same as Utils::StringHash but over the raw bytes
+    uint64_t s_Hash = 0xCBF29CE484222325ULL;
+    for (uint32_t l_Index = 0; l_Index < OrbisOS::EEKPFS_SIZE; ++l_Index)
+    {
+        s_Hash ^= p_Eekpfs[l_Index];
+        s_Hash *= 0x100000001B3ULL;
+    }
+
+    for (uint32_t l_Index = 0; l_Index < OrbisOS::PFS_SEED_SIZE; ++l_Index)
+    {
+        s_Hash ^= p_Seed[l_Index];
+        s_Hash *= 0x100000001B3ULL;
+    }
+
+    return s_Hash;
+}
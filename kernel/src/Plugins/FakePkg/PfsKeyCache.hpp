@@ -0,0 +1,81 @@
+#pragma once
+#include <Utils/Types.hpp>
+#include <OrbisOS/FakeStructs.hpp>
+
+extern "C"
+{
+    #include <sys/param.h>
+    #include <sys/lock.h>
+    #include <sys/mutex.h>
+};
+
+namespace Mira
+{
+    namespace Plugins
+    {
+        enum
+        {
+            // Packages remembered at once, the least recently mounted one is evicted
+            PfsKeyCache_EntryCount = 16,
+
+            // Size of the escrowed key of a SblKeyDesc
+            PfsKeyCache_KeySize = 0x20,
+        };
+
+        /*
+            PfsKeyCache
+
+            Keys of fake packages that were mounted before. Mounting one takes an RSA-2048 unwrap of
+            the EEKPFS, two HMAC-SHA256 derivations and two AES passes, and the same package is
+            mounted again on every launch, patch and save mount. Entries are keyed by a hash of the
+            EEKPFS and the crypt seed and hold the finished escrowed keys, ready for
+            sceSblKeymgrSetKeyForPfs. The EEKPFS and seed are compared in full on every hit.
+
+            Everything is zeroed by Clear, which the plugin calls when suspending and unloading.
+        */
+        class PfsKeyCache
+        {
+        private:
+            struct Entry
+            {
+                bool Used;
+                uint64_t Hash;
+                uint64_t LastUse;
+
+                uint8_t Eekpfs[OrbisOS::EEKPFS_SIZE];
+                uint8_t Seed[OrbisOS::PFS_SEED_SIZE];
+
+                uint8_t EncryptionKey[PfsKeyCache_KeySize];
+                uint8_t SigningKey[PfsKeyCache_KeySize];
+            };
+
+            Entry m_Entries[PfsKeyCache_EntryCount];
+            uint64_t m_UseCounter;
+
+            uint64_t m_Hits;
+            uint64_t m_Misses;
+
+            struct mtx m_Mutex;
+
+        public:
+            PfsKeyCache();
+            ~PfsKeyCache();
+
+            // Copies the cached keys of p_Eekpfs (EEKPFS_SIZE) and p_Seed (PFS_SEED_SIZE) out, counts a hit or a miss
+            bool Find(const uint8_t* p_Eekpfs, const uint8_t* p_Seed, uint8_t* p_OutEncryptionKey, uint8_t* p_OutSigningKey);
+
+            void Add(const uint8_t* p_Eekpfs, const uint8_t* p_Seed, const uint8_t* p_EncryptionKey, const uint8_t* p_SigningKey);
+
+            // Zeroes every entry, the hit and miss counters are kept
+            void Clear();
+
+            uint64_t GetHits() const { return m_Hits; }
+            uint64_t GetMisses() const { return m_Misses; }
+
+        private:
+            int32_t FindIndex(uint64_t p_Hash, const uint8_t* p_Eekpfs, const uint8_t* p_Seed);
+
+            static uint64_t Hash(const uint8_t* p_Eekpfs, const uint8_t* p_Seed);
+        };
+    }
+}
@@ -13,12 +13,14 @@
 #include <Utils/Kernel.hpp>
 #include <Utils/Kdlsym.hpp>
 #include <Utils/Logger.hpp>
+#include <Utils/HookStats.hpp>
 
 #include <Mira.hpp>
 #include <Boot/Config.hpp>
 #include <Plugins/PluginManager.hpp>
 
 #include <OrbisOS/Utilities.hpp>
+#include <OrbisOS/SblMapIndex.hpp>
 
 extern "C"
 {
@@ -123,6 +125,8 @@ FakeSelfManager::~FakeSelfManager()
 
 int FakeSelfManager::OnSceSblAuthMgrIsLoadable2(SelfContext* p_Context, SelfAuthInfo* p_OldAuthInfo, int32_t p_PathId, SelfAuthInfo* p_NewAuthInfo)
 {
+    MIRA_HOOK_STATS_SCOPE(Utils::HookStatsId_SceSblAuthMgrIsLoadable2);
+
     auto sceSblAuthMgrIsLoadable2 = (int(*)(SelfContext* p_Context, SelfAuthInfo* p_OldAuthInfo, int32_t p_PathId, SelfAuthInfo* p_NewAuthInfo))kdlsym(sceSblAuthMgrIsLoadable2);
 
     if (p_Context == nullptr)
@@ -183,7 +187,7 @@ int FakeSelfManager::AuthSelfHeader(SelfContext* p_Context)
         auto s_NewTotalHeaderSize = s_Header->headerSize + s_Header->metaSize;
 
         // Allocate some memory to hold our header size
-        auto s_Temp = new uint8_t[s_NewTotalHeaderSize];
+        auto s_Temp = new (Utils::MemoryTag_FakeSelf) uint8_t[s_NewTotalHeaderSize];
         if (s_Temp == nullptr)
         {
             WriteLog(LL_Error, "could not allocate new total header size (%x).", s_NewTotalHeaderSize);
@@ -218,6 +222,8 @@ int FakeSelfManager::AuthSelfHeader(SelfContext* p_Context)
 
 int FakeSelfManager::OnSceSblAuthMgrVerifyHeader(SelfContext* p_Context)
 {
+    MIRA_HOOK_STATS_SCOPE(Utils::HookStatsId_SceSblAuthMgrVerifyHeader);
+
     auto _sceSblAuthMgrSmStart = (void(*)(void**))kdlsym(_sceSblAuthMgrSmStart);
 
     void* s_Temp = nullptr;
@@ -228,35 +234,8 @@ int FakeSelfManager::OnSceSblAuthMgrVerifyHeader(SelfContext* p_Context)
 
 SblMapListEntry* FakeSelfManager::SceSblDriverFindMappedPageListByGpuVa(vm_offset_t p_GpuVa)
 {
-    if (p_GpuVa == 0)
-    {
-        WriteLog(LL_Error, "invalid gpu va");
-        return nullptr;
-    }
-
-    auto _mtx_lock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_lock_flags);
-    auto _mtx_unlock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_unlock_flags);
-    auto s_SblDrvMsgMtx = (struct mtx*)kdlsym(sbl_drv_msg_mtx);
-
-    SblMapListEntry* s_Entry = *(SblMapListEntry**)kdlsym(gpu_va_page_list);
-    SblMapListEntry* s_FinalEntry = nullptr;
-
-    // Lock before we iterate this list, because other paths can absolutely use it concurrently
-    _mtx_lock_flags(s_SblDrvMsgMtx, 0, __FILE__, __LINE__);
-
-    while (s_Entry)
-    {
-        if (s_Entry->gpuVa == p_GpuVa)
-        {
-            s_FinalEntry = s_Entry;
-            break;
-        }
-
-        s_Entry = s_Entry->next;
-    }
-
-    _mtx_unlock_flags(s_SblDrvMsgMtx, 0, __FILE__, __LINE__);
-    return s_FinalEntry;
+    // Shared with the other mailbox hooks, indexed instead of walking gpu_va_page_list every time
+    return SblMapIndex::FindMappedPageList(p_GpuVa);
 }
 
 vm_offset_t FakeSelfManager::SceSblDriverGpuVaToCpuVa(vm_offset_t p_GpuVa, size_t* p_NumPageGroups)
@@ -428,6 +407,8 @@ int FakeSelfManager::SceSblAuthMgrGetSelfAuthInfoFake(SelfContext* p_Context, Se
 
 int FakeSelfManager::SceSblAuthMgrSmLoadSelfSegment_Mailbox(uint64_t p_ServiceId, void* p_Request, void* p_Response)
 {
+    MIRA_HOOK_STATS_SCOPE(Utils::HookStatsId_SceSblAuthMgrSmLoadSelfSegment);
+
     auto sceSblServiceMailbox = (int(*)(uint32_t p_ServiceId, void* p_Request, void* p_Response))kdlsym(sceSblServiceMailbox);
 
 	// self_context is first param of caller. 0x08 = sizeof(struct self_context*)
@@ -460,6 +441,8 @@ int FakeSelfManager::SceSblAuthMgrSmLoadSelfSegment_Mailbox(uint64_t p_ServiceId
 
 int FakeSelfManager::SceSblAuthMgrSmLoadSelfBlock_Mailbox(uint64_t p_ServiceId, uint8_t* p_Request, void* p_Response)
 {
+    MIRA_HOOK_STATS_SCOPE(Utils::HookStatsId_SceSblAuthMgrSmLoadSelfBlock);
+
     // self_context is first param of caller. 0x08 = sizeof(struct self_context*)
     uint8_t* frame = (uint8_t*)__builtin_frame_address(1);
     SelfContext* p_Context = *(SelfContext**)(frame - 0x08);
@@ -6,6 +6,7 @@
 #include <Utils/SysWrappers.hpp>
 #include <Utils/SelfHeader.hpp>
 #include <Utils/Kdlsym.hpp>
+#include <Utils/Arena.hpp>
 
 #include <Messaging/MessageManager.hpp>
 
@@ -16,6 +17,8 @@
 
 #include "FileManagerMessages.hpp"
 #include "FileManagerSelf.hpp"
+#include "SelfDecryptPlan.hpp"
+#include "PathFilter.hpp"
 
 #include <sys/dirent.h>
 #include <sys/stat.h>
@@ -25,6 +28,7 @@
 #include <sys/mman.h>
 #include <sys/filedesc.h>
 #include <sys/file.h>
+#include <sys/time.h>
 
 extern "C"
 {
@@ -57,6 +61,7 @@ bool FileManager::OnLoad()
     //Mira::Framework::GetFramework()->GetMessageManager()->RegisterCallback(RPC_CATEGORY__FILE, FileManager_RmDir, OnRmDir);
     Mira::Framework::GetFramework()->GetMessageManager()->RegisterCallback(RPC_CATEGORY__FILE, FileManager_Unlink, OnUnlink);
     Mira::Framework::GetFramework()->GetMessageManager()->RegisterCallback(RPC_CATEGORY__FILE, FileManager_DecryptSelf, OnDecryptSelf);
+    Mira::Framework::GetFramework()->GetMessageManager()->RegisterCallback(RPC_CATEGORY__FILE, FileManager_DecryptSelfBatch, OnDecryptSelfBatch);
     
     return true;
 }
@@ -74,6 +79,7 @@ bool FileManager::OnUnload()
     //Mira::Framework::GetFramework()->GetMessageManager()->UnregisterCallback(RPC_CATEGORY__FILE, FileManager_RmDir, OnRmDir);
     Mira::Framework::GetFramework()->GetMessageManager()->UnregisterCallback(RPC_CATEGORY__FILE, FileManager_Unlink, OnUnlink);
     Mira::Framework::GetFramework()->GetMessageManager()->UnregisterCallback(RPC_CATEGORY__FILE, FileManager_DecryptSelf, OnDecryptSelf);
+    Mira::Framework::GetFramework()->GetMessageManager()->UnregisterCallback(RPC_CATEGORY__FILE, FileManager_DecryptSelfBatch, OnDecryptSelfBatch);
     return true;
 }
 
@@ -169,7 +175,10 @@ void FileManager::OnRead(Messaging::Rpc::Connection* p_Connection, const RpcTran
         return;
     }
 
-    FmReadRequest* s_Request = fm_read_request__unpack(nullptr, p_Message->data.len, p_Message->data.data);
+    // All scratch memory comes from the connection arena, it is released after this request
+    auto s_Arena = p_Connection->GetArena();
+
+    FmReadRequest* s_Request = fm_read_request__unpack(s_Arena->GetProtobufAllocator(), p_Message->data.len, p_Message->data.data);
     if (s_Request == nullptr)
     {
         WriteLog(LL_Error, "could not unpack request");
@@ -178,25 +187,18 @@ void FileManager::OnRead(Messaging::Rpc::Connection* p_Connection, const RpcTran
     }
 
     auto s_DataSize = s_Request->size;
-    uint8_t* s_Data = new uint8_t[s_DataSize];
+    auto s_Data = s_Arena->Allocate<uint8_t>(s_DataSize);
     if (s_Data == nullptr)
     {
         WriteLog(LL_Error, "could not allocate (%x) bytes", s_DataSize);
         Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOMEM);
-        fm_read_request__free_unpacked(s_Request, nullptr);
         return;
     }
-    memset(s_Data, 0, s_DataSize);
 
     auto s_Ret = kread_t(s_Request->handle, s_Data, s_DataSize, s_IoThread);
-
-    fm_read_request__free_unpacked(s_Request, nullptr);
-    s_Request = nullptr;
-
     if (s_Ret <= 0)
     {
         WriteLog(LL_Error, "read returned (%d)", s_Ret);
-        delete [] s_Data;
         Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, s_Ret);
         return;
     }
@@ -209,36 +211,27 @@ void FileManager::OnRead(Messaging::Rpc::Connection* p_Connection, const RpcTran
     if (s_PackedSize <= 0)
     {
         WriteLog(LL_Error, "could not get packed size");
-        delete [] s_Data;
         Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -EIO);
         return;
     }
 
-    auto s_PackedData = new uint8_t[s_PackedSize];
+    auto s_PackedData = s_Arena->Allocate<uint8_t>(s_PackedSize);
     if (s_PackedData == nullptr)
     {
         WriteLog(LL_Error, "could not allocated packed data (%llx)", s_PackedSize);
-        delete [] s_Data;
         Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOMEM);
         return;
     }
-    memset(s_PackedData, 0, s_PackedSize);
 
     auto s_PackedRet = fm_read_response__pack(&s_Response, s_PackedData);
     if (s_PackedRet != s_PackedSize)
     {
         WriteLog(LL_Error, "packed ret (%llx) != packed size (%llx)", s_PackedRet, s_PackedSize);
-        delete [] s_PackedData;
-        delete [] s_Data;
         Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOMEM);
         return;
     }
 
     Mira::Framework::GetFramework()->GetMessageManager()->SendResponse(p_Connection, RPC_CATEGORY__FILE, FileManager_Read, 0, s_PackedData, s_PackedSize);
-
-    // Free the allocated data for packing
-    delete [] s_PackedData;
-    delete [] s_Data;
 }
 
 void FileManager::OnGetDents(Messaging::Rpc::Connection* p_Connection, const RpcTransport* p_Message)
@@ -257,7 +250,10 @@ void FileManager::OnGetDents(Messaging::Rpc::Connection* p_Connection, const Rpc
         return;
     }
 
-    FmGetDentsRequest* s_Request = fm_get_dents_request__unpack(nullptr, p_Message->data.len, p_Message->data.data);
+    // All scratch memory comes from the connection arena, it is released after this request
+    auto s_Arena = p_Connection->GetArena();
+
+    FmGetDentsRequest* s_Request = fm_get_dents_request__unpack(s_Arena->GetProtobufAllocator(), p_Message->data.len, p_Message->data.data);
     if (s_Request == nullptr)
     {
         WriteLog(LL_Error, "could not unpack request");
@@ -265,21 +261,9 @@ void FileManager::OnGetDents(Messaging::Rpc::Connection* p_Connection, const Rpc
         return;
     }
 
-    auto s_DirectoryHandle = kopen_t(s_Request->path, 0x0000 | 0x00020000, 0777, s_IoThread);
-    if (s_DirectoryHandle < 0)
-    {
-		WriteLog(LL_Error, "could not open directory (%s) (%d).", s_Request->path, s_DirectoryHandle);
-        fm_get_dents_request__free_unpacked(s_Request, nullptr);
-        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, s_DirectoryHandle);
-        return;
-    }
-
     uint64_t s_DentCount = GetDentCount(s_Request->path);
     //WriteLog(LL_Info, "dentCount: (%lld)", s_DentCount);
 
-    fm_get_dents_request__free_unpacked(s_Request, nullptr);
-    s_Request = nullptr;
-
     // Protect against zero-size deref
     if (s_DentCount == 0)
     {
@@ -288,17 +272,28 @@ void FileManager::OnGetDents(Messaging::Rpc::Connection* p_Connection, const Rpc
         return;
     }
 
-    FmDent* s_Dents[s_DentCount];
-    memset(s_Dents, 0, sizeof(s_Dents));
+    // Large directories would blow the kernel stack if this was a stack array
+    auto s_Dents = s_Arena->Allocate<FmDent*>(s_DentCount);
+    if (s_Dents == nullptr)
+    {
+        WriteLog(LL_Error, "could not allocate dent list (%lld)", s_DentCount);
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOMEM);
+        return;
+    }
 
-    uint64_t s_CurrentDentIndex = 0;
+    auto s_DirectoryHandle = kopen_t(s_Request->path, 0x0000 | 0x00020000, 0777, s_IoThread);
+    if (s_DirectoryHandle < 0)
+    {
+		WriteLog(LL_Error, "could not open directory (%s) (%d).", s_Request->path, s_DirectoryHandle);
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, s_DirectoryHandle);
+        return;
+    }
 
-    //WriteLog(LL_Info, "dents: (%p)", s_Dents);
+    uint64_t s_CurrentDentIndex = 0;
 
     // Switch this to use stack
     char s_Buffer[0x1000] = { 0 };
     memset(s_Buffer, 0, sizeof(s_Buffer));
-    //WriteLog(LL_Debug, "here");
 
     int32_t s_ReadCount = 0;
     for (;;)
@@ -319,32 +314,27 @@ void FileManager::OnGetDents(Messaging::Rpc::Connection* p_Connection, const Rpc
 
             auto l_Dent = (struct dirent*)(s_Buffer + l_Pos);
 
-            auto l_FmDent = new FmDent();
+            auto l_FmDent = s_Arena->Allocate<FmDent>();
             if (l_FmDent == nullptr)
             {
                 WriteLog(LL_Error, "could not allocate fmdent");
                 break;
             }
-            memset(l_FmDent, 0, sizeof(*l_FmDent));
 
             // Initialize dent
             *l_FmDent = FM_DENT__INIT;
             l_FmDent->fileno = l_Dent->d_fileno;
             l_FmDent->type = l_Dent->d_type;
-            l_FmDent->name = new char[l_Dent->d_namlen + 1];
+            l_FmDent->name = s_Arena->Duplicate(l_Dent->d_name, l_Dent->d_namlen);
             if (l_FmDent->name == nullptr)
             {
                 WriteLog(LL_Error, "could not allocate memory for name");
                 break;
             }
-            memset(l_FmDent->name, 0, l_Dent->d_namlen + 1);
-            memcpy(l_FmDent->name, l_Dent->d_name, l_Dent->d_namlen);
 
             //WriteLog(LL_Info, "dent: (%d) (%s)", s_CurrentDentIndex, l_FmDent->name);
 
             s_Dents[s_CurrentDentIndex] = l_FmDent;
-
-            //WriteLog(LL_Debug, "s_CurrentDentIndex: %lld", s_CurrentDentIndex);
             s_CurrentDentIndex++;
 
             l_Pos += l_Dent->d_reclen;
@@ -352,103 +342,36 @@ void FileManager::OnGetDents(Messaging::Rpc::Connection* p_Connection, const Rpc
     }
     kclose_t(s_DirectoryHandle, s_IoThread);
 
-    //WriteLog(LL_Debug, "here");
+    // Only send the dents that were filled in, the directory may have changed since it was counted
     FmGetDentsResponse s_Response = FM_GET_DENTS_RESPONSE__INIT;
-    s_Response.n_dents = s_DentCount;
+    s_Response.n_dents = s_CurrentDentIndex;
     s_Response.dents = s_Dents;
 
-    //WriteLog(LL_Debug, "here");
     auto s_PackedSize = fm_get_dents_response__get_packed_size(&s_Response);
-    //WriteLog(LL_Debug, "packedSize: %lld", s_PackedSize);
     if (s_PackedSize <= 0)
     {
         WriteLog(LL_Error, "could not get packed size");
-
-         // Free all of the allocated names
-        for (auto i = 0; i < s_DentCount; ++i)
-        {
-            if (s_Dents[i] == nullptr)
-                continue;
-                
-            if (s_Dents[i]->name != nullptr)
-                delete [] s_Dents[i]->name;
-            
-            s_Dents[i]->name = nullptr;
-
-            delete s_Dents[i];
-            s_Dents[i] = nullptr;
-        }
         Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOMEM);
         return;
     }
 
-    auto s_Data = new uint8_t[s_PackedSize];
-    //WriteLog(LL_Debug, "data: (%p) size: %lld", s_Data, s_PackedSize);
+    auto s_Data = s_Arena->Allocate<uint8_t>(s_PackedSize);
     if (s_Data == nullptr)
     {
-        WriteLog(LL_Error, "could not allocate (%llx)", s_Data);
-
-         // Free all of the allocated names
-        for (auto i = 0; i < s_DentCount; ++i)
-        {
-            if (s_Dents[i] == nullptr)
-                continue;
-
-            if (s_Dents[i]->name != nullptr)
-                delete [] s_Dents[i]->name;
-            
-            s_Dents[i]->name = nullptr;
-
-            delete s_Dents[i];
-            s_Dents[i] = nullptr;
-        }
+        WriteLog(LL_Error, "could not allocate (%llx)", s_PackedSize);
         Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOMEM);
         return;
     }
 
     auto s_Ret = fm_get_dents_response__pack(&s_Response, s_Data);
-    //WriteLog(LL_Debug, "pack result (%lld)", s_Ret);
     if (s_Ret != s_PackedSize)
     {
         WriteLog(LL_Error, "could not pack");
-
-         // Free all of the allocated names
-        for (auto i = 0; i < s_DentCount; ++i)
-        {
-            if (s_Dents[i] == nullptr)
-                continue;
-                
-            if (s_Dents[i]->name != nullptr)
-                delete [] s_Dents[i]->name;
-            
-            s_Dents[i]->name = nullptr;
-
-            delete s_Dents[i];
-            s_Dents[i] = nullptr;
-        }
-        delete [] s_Data;
         Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOMEM);
         return;
     }
 
     Mira::Framework::GetFramework()->GetMessageManager()->SendResponse(p_Connection, RPC_CATEGORY__FILE, FileManager_GetDents, 0, s_Data, s_PackedSize);
-
-    // Free all of the allocated names
-    for (auto i = 0; i < s_DentCount; ++i)
-    {
-        if (s_Dents[i] == nullptr)
-            continue;
-            
-        if (s_Dents[i]->name != nullptr)
-            delete [] s_Dents[i]->name;
-        
-        s_Dents[i]->name = nullptr;
-
-        delete s_Dents[i];
-        s_Dents[i] = nullptr;
-    }
-
-    delete [] s_Data;
 }
 
 uint64_t FileManager::GetDentCount(const char* p_Path)
@@ -509,7 +432,10 @@ void FileManager::OnStat(Messaging::Rpc::Connection* p_Connection, const RpcTran
         return;
     }
 
-    FmStatRequest* s_Request = fm_stat_request__unpack(nullptr, p_Message->data.len, p_Message->data.data);
+    // All scratch memory comes from the connection arena, it is released after this request
+    auto s_Arena = p_Connection->GetArena();
+
+    FmStatRequest* s_Request = fm_stat_request__unpack(s_Arena->GetProtobufAllocator(), p_Message->data.len, p_Message->data.data);
     if (s_Request == nullptr)
     {
         WriteLog(LL_Error, "could not unpack request");
@@ -525,7 +451,6 @@ void FileManager::OnStat(Messaging::Rpc::Connection* p_Connection, const RpcTran
         if (s_Request->path == nullptr)
         {
             WriteLog(LL_Error, "invalid path length");
-            fm_stat_request__free_unpacked(s_Request, nullptr);
             Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOENT);
             return;
         }
@@ -534,7 +459,6 @@ void FileManager::OnStat(Messaging::Rpc::Connection* p_Connection, const RpcTran
         if (s_Ret < 0)
         {
             WriteLog(LL_Error, "could not stat (%s), returned (%d).", s_Request->path, s_Ret);
-            fm_stat_request__free_unpacked(s_Request, nullptr);
             Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, s_Ret);
             return;
         }
@@ -545,16 +469,11 @@ void FileManager::OnStat(Messaging::Rpc::Connection* p_Connection, const RpcTran
         if (s_Ret < 0)
         {
             WriteLog(LL_Error, "could not stat (%s), returned (%d).", s_Request->path, s_Ret);
-            fm_stat_request__free_unpacked(s_Request, nullptr);
             Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, s_Ret);
             return;
         }
     }
 
-    // Free the unpacked
-    fm_stat_request__free_unpacked(s_Request, nullptr);
-    s_Request = nullptr;
-    
     // Send a success response back
     FmStatResponse s_Response = FM_STAT_RESPONSE__INIT;
     s_Response.st_dev = s_Stat.st_dev;
@@ -601,27 +520,23 @@ void FileManager::OnStat(Messaging::Rpc::Connection* p_Connection, const RpcTran
         return;
     }
 
-    auto s_ResponseData = new uint8_t[s_ResponseSize];
+    auto s_ResponseData = s_Arena->Allocate<uint8_t>(s_ResponseSize);
     if (s_ResponseData == nullptr)
     {
         WriteLog(LL_Error, "could not allocate (%llx)", s_ResponseSize);
         Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOMEM);
         return;
     }
-    memset(s_ResponseData, 0, s_ResponseSize);
 
     auto s_Ret = fm_stat_response__pack(&s_Response, s_ResponseData);
     if (s_Ret != s_ResponseSize)
     {
         WriteLog(LL_Error, "could not pack (%lld) != (%lld)", s_Ret, s_ResponseSize);
         Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOMEM);
-        delete [] s_ResponseData;
         return;
     }
 
     Mira::Framework::GetFramework()->GetMessageManager()->SendResponse(p_Connection, RPC_CATEGORY__FILE, FileManager_Stat, 0, s_ResponseData, s_ResponseSize);
-
-    delete [] s_ResponseData;
 }
 
 void FileManager::OnUnlink(Messaging::Rpc::Connection* p_Connection, const RpcTransport* p_Message)
@@ -681,357 +596,630 @@ bool IsPhOverlapping(Elf64_Phdr* p_ProgramHeader, int p_ProgramHeaderIndex, Elf6
     return false;
 }
 
-void FileManager::OnDecryptSelf(Messaging::Rpc::Connection* p_Connection, const RpcTransport* p_Message)
+struct DecryptSelfResponseContext
 {
-	auto s_SyscoreThread = Mira::Framework::GetFramework()->GetSyscoreThread();
-	if (s_SyscoreThread == nullptr)
-	{
-		WriteLog(LL_Error, "could not get io thread.");
-		return;
-	}
-    WriteLog(LL_Debug, "syscoreThread: %p", s_SyscoreThread);/*
+    Mira::Messaging::Rpc::Connection* Connection;
+    uint8_t* PackedData;
+    uint64_t PackedSize;
 
-    // Root and escape our thread
-	if (s_MainThread->td_ucred)
-	{
-		WriteLog(LL_Info, "escaping thread");
-
-		s_MainThread->td_ucred->cr_rgid = 0;
-		s_MainThread->td_ucred->cr_svgid = 0;
-		
-		s_MainThread->td_ucred->cr_uid = 0;
-		s_MainThread->td_ucred->cr_ruid = 0;
+    // Only set for the empty chunk that ends the stream
+    uint32_t SkippedSegments;
+};
 
-        s_MainThread->td_ucred->cr_groups[0] = 0;
+static bool SendDecryptSelfChunk(void* p_Context, uint64_t p_Offset, const uint8_t* p_Data, uint32_t p_Size, uint64_t p_ElfSize)
+{
+    auto s_Context = static_cast<DecryptSelfResponseContext*>(p_Context);
 
-		if (s_MainThread->td_ucred->cr_prison)
-			s_MainThread->td_ucred->cr_prison = *(struct prison**)kdlsym(prison0);
+    FmDecryptSelfResponse s_Response = FM_DECRYPT_SELF_RESPONSE__INIT;
+    s_Response.data.data = const_cast<uint8_t*>(p_Data);
+    s_Response.data.len = p_Size;
+    s_Response.offset = p_Offset;
+    s_Response.elfsize = p_ElfSize;
+    s_Response.skippedsegments = s_Context->SkippedSegments;
 
-		if (s_MainThread->td_proc->p_fd)
-			s_MainThread->td_proc->p_fd->fd_rdir = s_MainThread->td_proc->p_fd->fd_jdir = *(struct vnode**)kdlsym(rootvnode);
-		
-		// Set our auth id as debugger
-		s_MainThread->td_ucred->cr_sceAuthID = SceAuthenticationId::SceSysCore;
+    auto s_PackedSize = fm_decrypt_self_response__get_packed_size(&s_Response);
+    if (s_PackedSize == 0 || s_PackedSize > s_Context->PackedSize)
+    {
+        WriteLog(LL_Error, "packed size (%llx) does not fit (%llx)", s_PackedSize, s_Context->PackedSize);
+        return false;
+    }
 
-		// make system credentials
-		s_MainThread->td_ucred->cr_sceCaps[0] = SceCapabilites::Max;
-		s_MainThread->td_ucred->cr_sceCaps[1] = SceCapabilites::Max;
+    auto s_PackedRet = fm_decrypt_self_response__pack(&s_Response, s_Context->PackedData);
+    if (s_PackedRet != s_PackedSize)
+    {
+        WriteLog(LL_Error, "packed ret (%llx) != packed size (%llx)", s_PackedRet, s_PackedSize);
+        return false;
+    }
 
-		WriteLog(LL_Debug, "credentials rooted for main proc");
-	}
+    Mira::Framework::GetFramework()->GetMessageManager()->SendResponse(s_Context->Connection, RPC_CATEGORY__FILE, FileManager_DecryptSelf, 0, s_Context->PackedData, s_PackedSize);
+    return true;
+}
 
-    if (curthread->td_ucred)
+void FileManager::OnDecryptSelf(Messaging::Rpc::Connection* p_Connection, const RpcTransport* p_Message)
+{
+	auto s_IoThread = Mira::Framework::GetFramework()->GetSyscoreThread();
+	if (s_IoThread == nullptr)
 	{
-		WriteLog(LL_Info, "escaping thread");
-
-		curthread->td_ucred->cr_rgid = 0;
-		curthread->td_ucred->cr_svgid = 0;
-		
-		curthread->td_ucred->cr_uid = 0;
-		curthread->td_ucred->cr_ruid = 0;
-
-        curthread->td_ucred->cr_groups[0] = 0;
-
-		if (curthread->td_ucred->cr_prison)
-			curthread->td_ucred->cr_prison = *(struct prison**)kdlsym(prison0);
-
-		if (curthread->td_proc->p_fd)
-			curthread->td_proc->p_fd->fd_rdir = s_MainThread->td_proc->p_fd->fd_jdir = *(struct vnode**)kdlsym(rootvnode);
-		
-		// Set our auth id as debugger
-		curthread->td_ucred->cr_sceAuthID = SceAuthenticationId::SceSysCore;
-
-		// make system credentials
-		curthread->td_ucred->cr_sceCaps[0] = SceCapabilites::Max;
-		curthread->td_ucred->cr_sceCaps[1] = SceCapabilites::Max;
-
-		WriteLog(LL_Debug, "credentials rooted for current thread");
+		WriteLog(LL_Error, "could not get io thread.");
+		return;
 	}
 
-    // Validate our buffers
-    if (p_Message.Buffer == nullptr || p_Message.Header.payloadLength < sizeof(DecryptSelfRequest))
+    if (p_Message->data.data == nullptr || p_Message->data.len <= 0)
     {
         WriteLog(LL_Error, "invalid message");
         Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOMEM);
         return;
     }
 
-    // Do some sanity checking
-    auto s_Request = reinterpret_cast<const DecryptSelfRequest*>(p_Message.Buffer);
-    if (s_Request->PathLength >= ARRAYSIZE(s_Request->Path))
+    // All scratch memory comes from the connection arena, it is released after this request
+    auto s_Arena = p_Connection->GetArena();
+
+    FmDecryptSelfRequest* s_Request = fm_decrypt_self_request__unpack(s_Arena->GetProtobufAllocator(), p_Message->data.len, p_Message->data.data);
+    if (s_Request == nullptr)
     {
-        WriteLog(LL_Error, "invalid path length");
-        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -E2BIG);
+        WriteLog(LL_Error, "could not unpack request");
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOMEM);
         return;
     }
-    WriteLog(LL_Debug, "request: %p, pathLength: %d", s_Request, s_Request->PathLength);
 
-    // Open the SELF file for reading
-    auto s_SelfHandle = kopen_t(s_Request->Path, O_RDONLY, 0777, s_MainThread);
-    WriteLog(LL_Debug, "selfHandle: %d", s_SelfHandle);
+    // One chunk is packed at a time, a window of data plus the field headers
+    DecryptSelfResponseContext s_Context =
+    {
+        .Connection = p_Connection,
+        .PackedData = nullptr,
+        .PackedSize = SelfDecryptPlan_WindowSize + 0x40,
+        .SkippedSegments = 0
+    };
+
+    s_Context.PackedData = s_Arena->Allocate<uint8_t>(s_Context.PackedSize);
+    if (s_Context.PackedData == nullptr)
+    {
+        WriteLog(LL_Error, "could not allocate packed data (%llx)", s_Context.PackedSize);
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOMEM);
+        return;
+    }
+
+    auto s_SelfHandle = kopen_t(s_Request->path, O_RDONLY, 0, s_IoThread);
     if (s_SelfHandle < 0)
     {
-        WriteLog(LL_Error, "could not open self (%s) err: (%d).", s_Request->Path, s_SelfHandle);
+        WriteLog(LL_Error, "could not open self (%s) (%d).", s_Request->path, s_SelfHandle);
         Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, s_SelfHandle);
         return;
     }
 
-    size_t s_ElfDataSize = 0;
+    uint64_t s_ElfSize = 0;
+    uint32_t s_SkippedSegments = 0;
+    auto s_Ret = DecryptSelfStream(s_SelfHandle, SendDecryptSelfChunk, &s_Context, &s_ElfSize, &s_SkippedSegments);
 
-    auto s_ElfData = DecryptSelfFd(s_SelfHandle, &s_ElfDataSize);
-    if (s_ElfData == nullptr || s_ElfDataSize == 0)
+    kclose_t(s_SelfHandle, s_IoThread);
+
+    if (s_Ret < 0)
     {
-        WriteLog(LL_Error, "could not decrypt self");
-        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOEXEC);
+        WriteLog(LL_Error, "could not decrypt self (%s) (%d).", s_Request->path, s_Ret);
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, s_Ret);
         return;
     }
 
-    WriteLog(LL_Debug, "here");
-    RpcTransport s_Message;
-    memset(&s_Message, 0, sizeof(s_Message));
+    if (s_SkippedSegments != 0)
+        WriteLog(LL_Warn, "decrypted self (%s) is missing (%u) segments.", s_Request->path, s_SkippedSegments);
+
+    // An empty chunk at the end of the output tells the client it has everything, and what it is missing
+    s_Context.SkippedSegments = s_SkippedSegments;
+    SendDecryptSelfChunk(&s_Context, s_ElfSize, nullptr, 0, s_ElfSize);
+}
+
+int32_t FileManager::DecryptSelfStream(int p_SelfFd, SelfDecryptChunkCallback p_Callback, void* p_Context, uint64_t* p_OutElfSize, uint32_t* p_OutSkippedSegments)
+{
+	auto s_IoThread = Mira::Framework::GetFramework()->GetSyscoreThread();
+	if (s_IoThread == nullptr)
+	{
+		WriteLog(LL_Error, "could not get io thread.");
+		return -EIO;
+	}
+
+    if (p_Callback == nullptr)
+        return -EINVAL;
 
-    WriteLog(LL_Debug, "here");
-    DecryptSelfResponse s_Payload;
-    memset(&s_Payload, 0, sizeof(s_Payload));
+    if (p_OutSkippedSegments != nullptr)
+        *p_OutSkippedSegments = 0;
 
-    WriteLog(LL_Debug, "here");
-    auto s_ChunkCount = s_ElfDataSize / MaxBufferLength;
-    auto s_LeftoverCount = s_ElfDataSize % MaxBufferLength;
+    struct stat s_Stat;
+    memset(&s_Stat, 0, sizeof(s_Stat));
 
-    WriteLog(LL_Debug, "ChunkCount: %lld Leftover: %lld", s_ChunkCount, s_LeftoverCount);
-    auto s_TotalIndex = 0;
-    size_t s_TotalOffset = 0;
-    for (auto l_ChunkIndex = 0; l_ChunkIndex < s_ChunkCount; ++l_ChunkIndex)
+    auto s_Ret = kfstat_t(p_SelfFd, &s_Stat, s_IoThread);
+    if (s_Ret < 0)
     {
-        s_Payload.Index = s_TotalIndex;
-        s_Payload.Offset = s_TotalOffset;
-        s_Payload.Length = MaxBufferLength;
-        memcpy(s_Payload.Data, &s_ElfData[s_TotalOffset], s_Payload.Length);
+        WriteLog(LL_Error, "could not stat self (%d).", s_Ret);
+        return s_Ret;
+    }
 
-        s_Message.Header = 
-        {
-            .magic = RpcTransportHeaderMagic,
-            .category = RPC_CATEGORY__FILE,
-            .isRequest = false,
-            .errorType = static_cast<uint64_t>(0),
-            .payloadLength = sizeof(s_Payload),
-            .padding = 0
-        };
-        s_Message.Buffer = (const uint8_t*)&s_Payload;
-
-        Mira::Framework::GetFramework()->GetMessageManager()->SendResponse(p_Connection, s_Message);
-
-        s_TotalIndex++;
-        s_TotalOffset += MaxBufferLength;
+    if (s_Stat.st_size <= 0)
+    {
+        WriteLog(LL_Error, "invalid self size (%lld).", s_Stat.st_size);
+        return -ENOEXEC;
     }
 
-    if (s_LeftoverCount > 0)
+    uint64_t s_FileSize = static_cast<uint64_t>(s_Stat.st_size);
+
+    // Only the headers are read, growing the buffer until the plan has all of them
+    SelfDecryptPlan s_Plan;
+    uint8_t* s_Header = nullptr;
+    uint64_t s_HeaderSize = MIN(static_cast<uint64_t>(SelfDecryptPlan_InitialHeaderSize), s_FileSize);
+    auto s_Status = SelfDecryptPlan::Status::NeedMoreData;
+    while (s_Status == SelfDecryptPlan::Status::NeedMoreData)
     {
-        WriteLog(LL_Debug, "here");
-        s_Payload.Index = s_TotalIndex;
-        s_Payload.Offset = s_TotalOffset;
-        s_Payload.Length = s_LeftoverCount;
-        WriteLog(LL_Debug, "here");
-        memcpy(s_Payload.Data, &s_ElfData[s_TotalOffset], s_Payload.Length);
-
-        WriteLog(LL_Debug, "here");
-        s_Message.Header = 
+        delete [] s_Header;
+        s_Header = new (Utils::MemoryTag_FileManager) uint8_t[s_HeaderSize];
+        if (s_Header == nullptr)
+        {
+            WriteLog(LL_Error, "could not allocate header (%llx).", s_HeaderSize);
+            return -ENOMEM;
+        }
+
+        auto l_Read = kpread_t(p_SelfFd, s_Header, s_HeaderSize, 0, s_IoThread);
+        if (l_Read != static_cast<ssize_t>(s_HeaderSize))
         {
-            .magic = RpcTransportHeaderMagic,
-            .category = RPC_CATEGORY__FILE,
-            .isRequest = false,
-            .errorType = static_cast<uint64_t>(0),
-            .payloadLength = sizeof(s_Payload),
-            .padding = 0
-        };
-        s_Message.Buffer = (const uint8_t*)&s_Payload;
-
-        WriteLog(LL_Debug, "here");
-
-        Mira::Framework::GetFramework()->GetMessageManager()->SendResponse(p_Connection, s_Message);
-
-        s_TotalIndex++;
-        s_TotalOffset += MaxBufferLength;
-        WriteLog(LL_Debug, "wrote leftover, total bytes: %lld", s_TotalOffset);
+            WriteLog(LL_Error, "could not read header (%lld).", l_Read);
+            delete [] s_Header;
+            return l_Read < 0 ? static_cast<int32_t>(l_Read) : -EIO;
+        }
+
+        s_Status = s_Plan.Parse(s_Header, s_HeaderSize, s_FileSize);
+        s_HeaderSize = s_Plan.GetRequiredSize();
     }
 
-    // Send "complete" message
-    s_Payload.Index = __UINT64_MAX__;
-    s_Payload.Offset = 0;
-    s_Payload.Length = 0;
-    WriteLog(LL_Debug, "here");
-    s_Message.Header = 
+    if (s_Status != SelfDecryptPlan::Status::Ok)
     {
-        .magic = RpcTransportHeaderMagic,
-        .category = RPC_CATEGORY__FILE,
-        .isRequest = false,
-        .errorType = static_cast<uint64_t>(0),
-        .payloadLength = sizeof(s_Payload),
-        .padding = 0
-    };
-    s_Message.Buffer = (const uint8_t*)&s_Payload;
+        WriteLog(LL_Error, "not a self or elf.");
+        delete [] s_Header;
+        return -ENOEXEC;
+    }
+
+    if (p_OutElfSize != nullptr)
+        *p_OutElfSize = s_Plan.GetElfSize();
 
-    delete[] s_ElfData;
-    WriteLog(LL_Debug, "here");
+    s_Ret = 0;
+    do
+    {
+        // Plain ELFs are sent as they are, one window at a time
+        if (!s_Plan.IsSelf())
+        {
+            delete [] s_Header;
+            s_Header = new (Utils::MemoryTag_FileManager) uint8_t[SelfDecryptPlan_WindowSize];
+            if (s_Header == nullptr)
+            {
+                WriteLog(LL_Error, "could not allocate window.");
+                s_Ret = -ENOMEM;
+                break;
+            }
+
+            for (uint64_t l_Offset = 0; l_Offset < s_FileSize; l_Offset += SelfDecryptPlan_WindowSize)
+            {
+                auto l_Size = MIN(static_cast<uint64_t>(SelfDecryptPlan_WindowSize), s_FileSize - l_Offset);
+                auto l_Read = kpread_t(p_SelfFd, s_Header, l_Size, l_Offset, s_IoThread);
+                if (l_Read != static_cast<ssize_t>(l_Size))
+                {
+                    WriteLog(LL_Error, "could not read elf at (%llx) (%lld).", l_Offset, l_Read);
+                    s_Ret = l_Read < 0 ? static_cast<int32_t>(l_Read) : -EIO;
+                    break;
+                }
+
+                if (!p_Callback(p_Context, l_Offset, s_Header, static_cast<uint32_t>(l_Size), s_FileSize))
+                {
+                    s_Ret = -ECANCELED;
+                    break;
+                }
+            }
+            break;
+        }
+
+        // ELF header and program headers, with the section headers already cleared by the plan
+        if (!p_Callback(p_Context, 0, s_Header + s_Plan.GetElfOffset(), static_cast<uint32_t>(s_Plan.GetHeaderSize()), s_Plan.GetElfSize()))
+        {
+            s_Ret = -ECANCELED;
+            break;
+        }
+
+        delete [] s_Header;
+        s_Header = nullptr;
+
+        // Every segment is decrypted by mapping it with MAP_SELF, only one mapping is alive at a time
+        for (uint32_t l_Index = 0; l_Index < s_Plan.GetSegmentCount(); ++l_Index)
+        {
+            auto l_Segment = s_Plan.GetSegment(l_Index);
 
-    Mira::Framework::GetFramework()->GetMessageManager()->SendResponse(p_Connection, s_Message);
-    WriteLog(LL_Error, "self decryption complete");*/
+            auto l_Mapping = kmmap_t(nullptr, l_Segment->Size, PROT_READ, MAP_SHARED | MAP_SELF | MAP_PREFAULT_READ, p_SelfFd, (((uint64_t)l_Segment->ProgramHeaderIndex) << 32), s_IoThread);
+            if (l_Mapping == MAP_FAILED || (int64_t)l_Mapping < 0)
+            {
+                // mmap sometimes returns ENOMEM for a segment, the range is left zeroed like it always was
+                WriteLog(LL_Error, "could not map segment (%d) (%lld).", l_Segment->ProgramHeaderIndex, (int64_t)l_Mapping);
+                if (p_OutSkippedSegments != nullptr)
+                    (*p_OutSkippedSegments)++;
+
+                continue;
+            }
+
+            for (uint64_t l_Offset = 0; l_Offset < l_Segment->Size; l_Offset += SelfDecryptPlan_WindowSize)
+            {
+                auto l_Size = MIN(static_cast<uint64_t>(SelfDecryptPlan_WindowSize), l_Segment->Size - l_Offset);
+                if (!p_Callback(p_Context, l_Segment->Offset + l_Offset, reinterpret_cast<const uint8_t*>(l_Mapping) + l_Offset, static_cast<uint32_t>(l_Size), s_Plan.GetElfSize()))
+                {
+                    s_Ret = -ECANCELED;
+                    break;
+                }
+            }
+
+            kmunmap_t(l_Mapping, l_Segment->Size, s_IoThread);
+
+            if (s_Ret < 0)
+                break;
+        }
+    } while (false);
+
+    delete [] s_Header;
+
+    return s_Ret;
 }
 
-uint8_t* FileManager::DecryptSelfFd(int p_SelfFd, size_t* p_OutElfSize)
+struct DecryptSelfBatchContext
 {
-	auto s_IoThread = Mira::Framework::GetFramework()->GetSyscoreThread();
-	if (s_IoThread == nullptr)
-	{
-		WriteLog(LL_Error, "could not get io thread.");
-		return nullptr;
-	}
+    Mira::Messaging::Rpc::Connection* Connection;
+    struct thread* IoThread;
+    Mira::Utils::Arena* Arena;
+
+    uint8_t* PackedData;
+    uint64_t PackedSize;
+
+    const char* Filter;
+
+    // Root the request walks, outputs mirror the tree below it. Empty when streaming
+    const char* RootPath;
+    uint64_t RootPathLength;
+    const char* OutputPath;
+
+    // MaxPathLength bytes each, reused for every file so the arena only grows with the directories
+    char* FilePath;
+    char* FileOutputPath;
+
+    uint32_t FileIndex;
+    uint32_t FailedCount;
+
+    // Output of the current file, -1 when streaming
+    int OutputHandle;
+};
+
+struct DecryptSelfBatchDirectory
+{
+    DecryptSelfBatchDirectory* Next;
+    char* Path;
+};
 
-    size_t s_Offset = klseek_t(p_SelfFd, 0, SEEK_END, s_IoThread);
-    if (s_Offset <= 0)
+static bool SendDecryptSelfBatchResponse(DecryptSelfBatchContext* p_Context, const FmDecryptSelfBatchResponse* p_Response)
+{
+    auto s_PackedSize = fm_decrypt_self_batch_response__get_packed_size(p_Response);
+    if (s_PackedSize == 0 || s_PackedSize > p_Context->PackedSize)
     {
-        WriteLog(LL_Error, "invalid offset (%lld).", s_Offset);
-        return nullptr;
+        WriteLog(LL_Error, "packed size (%llx) does not fit (%llx)", s_PackedSize, p_Context->PackedSize);
+        return false;
+    }
+
+    auto s_PackedRet = fm_decrypt_self_batch_response__pack(p_Response, p_Context->PackedData);
+    if (s_PackedRet != s_PackedSize)
+    {
+        WriteLog(LL_Error, "packed ret (%llx) != packed size (%llx)", s_PackedRet, s_PackedSize);
+        return false;
     }
 
-    size_t s_SelfSize = s_Offset;
+    Mira::Framework::GetFramework()->GetMessageManager()->SendResponse(p_Context->Connection, RPC_CATEGORY__FILE, FileManager_DecryptSelfBatch, 0, p_Context->PackedData, s_PackedSize);
+    return true;
+}
 
-    // This is unsigned, will never be < 0
-    s_Offset = klseek_t(p_SelfFd, 0, SEEK_SET, s_IoThread);
+static bool OnDecryptSelfBatchChunk(void* p_Context, uint64_t p_Offset, const uint8_t* p_Data, uint32_t p_Size, uint64_t p_ElfSize)
+{
+    auto s_Context = static_cast<DecryptSelfBatchContext*>(p_Context);
 
-    auto s_SelfData = new uint8_t[s_SelfSize];
-    if (s_SelfData == nullptr)
+    if (s_Context->OutputHandle < 0)
     {
-        WriteLog(LL_Error, "could not allocate self data (%llx).", s_SelfSize);
-        return nullptr;
+        FmDecryptSelfBatchResponse s_Response = FM_DECRYPT_SELF_BATCH_RESPONSE__INIT;
+        s_Response.fileindex = s_Context->FileIndex;
+        s_Response.data.data = const_cast<uint8_t*>(p_Data);
+        s_Response.data.len = p_Size;
+        s_Response.offset = p_Offset;
+        s_Response.elfsize = p_ElfSize;
+
+        return SendDecryptSelfBatchResponse(s_Context, &s_Response);
     }
-    memset(s_SelfData, 0, s_SelfSize);
 
-    s_Offset = kread_t(p_SelfFd, s_SelfData, s_SelfSize, s_IoThread);
-    if (s_Offset != s_SelfSize)
+    auto s_Seek = klseek_t(s_Context->OutputHandle, p_Offset, SEEK_SET, s_Context->IoThread);
+    if (s_Seek < 0)
     {
-        // Free our allocated buffer
-        delete[] s_SelfData;
+        WriteLog(LL_Error, "could not seek output to (%llx) (%lld).", p_Offset, s_Seek);
+        return false;
+    }
 
-        WriteLog(LL_Error, "could not read all of the self data (%lld).", s_Offset);
-        return nullptr;
+    auto s_Written = kwrite_t(s_Context->OutputHandle, p_Data, p_Size, s_Context->IoThread);
+    if (s_Written != static_cast<ssize_t>(p_Size))
+    {
+        WriteLog(LL_Error, "could not write output at (%llx) (%lld).", p_Offset, s_Written);
+        return false;
     }
 
-    return DecryptSelf(s_SelfData, s_SelfSize, p_SelfFd, p_OutElfSize);
+    return true;
 }
 
-uint8_t* FileManager::DecryptSelf(uint8_t* p_SelfData, size_t p_SelfSize, int p_SelfFd, size_t* p_OutElfSize)
+void FileManager::OnDecryptSelfBatch(Messaging::Rpc::Connection* p_Connection, const RpcTransport* p_Message)
 {
 	auto s_IoThread = Mira::Framework::GetFramework()->GetSyscoreThread();
 	if (s_IoThread == nullptr)
 	{
 		WriteLog(LL_Error, "could not get io thread.");
-		return nullptr;
+		return;
 	}
 
-    if (p_SelfData == nullptr ||
-        p_OutElfSize == nullptr)
+    if (p_Message->data.data == nullptr || p_Message->data.len <= 0)
     {
-        WriteLog(LL_Error, "invalid self data or out elf size");
-        return nullptr;
+        WriteLog(LL_Error, "invalid message");
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOMEM);
+        return;
     }
 
-    size_t s_EhdrOffset = 0;
-    auto s_Ehdr = reinterpret_cast<Elf64_Ehdr*>(p_SelfData);
-    
-    if (IsValidElf(s_Ehdr))
-    {
-        auto s_ElfData = new uint8_t[p_SelfSize];
-        if (s_ElfData == nullptr)
-        {
-            WriteLog(LL_Error, "could not allocate elf data");
-            return nullptr;
-        }
-
-        memcpy(s_ElfData, p_SelfData, p_SelfSize);
+    // All scratch memory comes from the connection arena, it is released after this request
+    auto s_Arena = p_Connection->GetArena();
 
-        *p_OutElfSize = p_SelfSize;
-
-        return s_ElfData;
+    FmDecryptSelfBatchRequest* s_Request = fm_decrypt_self_batch_request__unpack(s_Arena->GetProtobufAllocator(), p_Message->data.len, p_Message->data.data);
+    if (s_Request == nullptr)
+    {
+        WriteLog(LL_Error, "could not unpack request");
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOMEM);
+        return;
     }
-    else
+
+    auto s_RootPathLength = strlen(s_Request->path);
+    if (s_RootPathLength == 0 || s_RootPathLength >= MaxPathLength)
     {
-        // Handle SELF decryption
-        auto s_SelfHeader = reinterpret_cast<self_header_t*>(p_SelfData);
-        s_EhdrOffset += sizeof(*s_SelfHeader);
-        s_EhdrOffset += sizeof(self_entry_t) * s_SelfHeader->num_entries;
-        s_Ehdr = reinterpret_cast<Elf64_Ehdr*>(&p_SelfData[s_EhdrOffset]);
+        WriteLog(LL_Error, "invalid path length (%llu)", s_RootPathLength);
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -EINVAL);
+        return;
     }
 
-    uint8_t* s_ElfBase = reinterpret_cast<uint8_t*>(s_Ehdr);
-    if (!IsValidElf(s_Ehdr))
+    // Outputs written under the root would be walked again and mirrored into themselves
+    if (s_Request->outputpath[0] != '\0' && PathFilter::IsAtOrBelow(s_Request->outputpath, s_Request->path))
     {
-        WriteLog(LL_Error, "could not find ELF header in self");
-        return nullptr;
+        WriteLog(LL_Error, "output path (%s) is inside (%s)", s_Request->outputpath, s_Request->path);
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -EINVAL);
+        return;
     }
 
-    s_Ehdr->e_shoff = 0;
-    s_Ehdr->e_shnum = 0;
-    size_t s_ElfSize = s_Ehdr->e_phoff + (s_Ehdr->e_phnum * s_Ehdr->e_phentsize) + (s_Ehdr->e_shnum * s_Ehdr->e_shentsize);
+    // A single response carries either a window of data or a file status with its path
+    DecryptSelfBatchContext s_Context =
+    {
+        .Connection = p_Connection,
+        .IoThread = s_IoThread,
+        .Arena = s_Arena,
+        .PackedData = nullptr,
+        .PackedSize = SelfDecryptPlan_WindowSize + MaxPathLength + 0x40,
+        .Filter = s_Request->filter[0] != '\0' ? s_Request->filter : DecryptSelfBatch_DefaultFilter,
+        .RootPath = s_Request->path,
+        .RootPathLength = s_RootPathLength,
+        .OutputPath = s_Request->outputpath,
+        .FilePath = nullptr,
+        .FileOutputPath = nullptr,
+        .FileIndex = 0,
+        .FailedCount = 0,
+        .OutputHandle = -1
+    };
 
-    // Parse PHDRs
-    auto s_Phdr = reinterpret_cast<Elf64_Phdr*>(&s_ElfBase[s_Ehdr->e_phoff]);
-    for (auto i = 0; i < s_Ehdr->e_phnum; ++i)
+    s_Context.PackedData = s_Arena->Allocate<uint8_t>(s_Context.PackedSize);
+    s_Context.FilePath = s_Arena->Allocate<char>(MaxPathLength);
+    s_Context.FileOutputPath = s_Arena->Allocate<char>(MaxPathLength);
+    auto s_DentBuffer = s_Arena->Allocate<char>(DecryptSelfBatch_DentBufferSize);
+    auto s_Pending = s_Arena->Allocate<DecryptSelfBatchDirectory>();
+    if (s_Context.PackedData == nullptr || s_Context.FilePath == nullptr || s_Context.FileOutputPath == nullptr || s_DentBuffer == nullptr || s_Pending == nullptr)
     {
-        switch (s_Phdr[i].p_type)
-        {
-        case PT_LOAD:
-        case PT_SCE_DYNLIBDATA:
-        case PT_DYNAMIC:
-            s_ElfSize = MAX(s_ElfSize, s_Phdr[i].p_offset + s_Phdr[i].p_filesz);
-            break;
-        }
+        WriteLog(LL_Error, "could not allocate batch state");
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOMEM);
+        return;
     }
 
-    *p_OutElfSize = s_ElfSize;
-    auto s_ElfData = new uint8_t[s_ElfSize];
-    if (s_ElfData == nullptr)
+    // Directories still to be walked, depth first without recursing on the kernel stack
+    s_Pending->Next = nullptr;
+    s_Pending->Path = s_Arena->Duplicate(s_Request->path, s_RootPathLength);
+    if (s_Pending->Path == nullptr)
     {
-        WriteLog(LL_Error, "could not allocate raw elf data.");
-        return false;
+        WriteLog(LL_Error, "could not allocate root path");
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__FILE, -ENOMEM);
+        return;
     }
-    memset(s_ElfData, 0, s_ElfSize);
 
-    // Copy over the elf header
-    for (auto i = 0; i < s_Ehdr->e_ehsize; ++i)
-        s_ElfData[i] = s_ElfBase[i];
-    
-    // Copy over all program headers
-    for (auto l_PhIndex = 0; l_PhIndex < s_Ehdr->e_phnum; ++l_PhIndex)
+    while (s_Pending != nullptr)
     {
-        for (auto l_PhEntIndex = 0; l_PhEntIndex < s_Ehdr->e_phentsize; ++l_PhEntIndex)
+        auto l_Directory = s_Pending;
+        s_Pending = s_Pending->Next;
+
+        auto l_DirectoryHandle = kopen_t(l_Directory->Path, O_RDONLY | O_DIRECTORY, 0, s_IoThread);
+        if (l_DirectoryHandle < 0)
         {
-            auto l_Offset = s_Ehdr->e_phoff + (l_PhIndex * s_Ehdr->e_phentsize) + l_PhEntIndex;
-            s_ElfData[l_Offset] = s_ElfBase[l_Offset];
+            WriteLog(LL_Error, "could not open directory (%s) (%d).", l_Directory->Path, l_DirectoryHandle);
+            continue;
         }
 
-        if (s_Phdr[l_PhIndex].p_type == PT_LOAD ||
-            s_Phdr[l_PhIndex].p_type == PT_SCE_DYNLIBDATA)
+        auto l_DirectoryLength = strlen(l_Directory->Path);
+
+        for (;;)
         {
-            klseek_t(p_SelfFd, 0, SEEK_SET, s_IoThread);
-            auto l_ElfSegment = kmmap_t(nullptr, s_Phdr[l_PhIndex].p_filesz, PROT_READ, MAP_SHARED | MAP_SELF | MAP_PREFAULT_READ, p_SelfFd, (((uint64_t)l_PhIndex) << 32), s_IoThread);
-            
-            WriteLog(LL_Warn, "%p = mmap(%p, 0x%llx, %d, %d, %d, %llx, %p)", l_ElfSegment, nullptr, s_Phdr[l_PhIndex].p_filesz, PROT_READ, MAP_PRIVATE | MAP_SELF, p_SelfFd, (((uint64_t)l_PhIndex) << 32), s_IoThread);
-            if (l_ElfSegment != MAP_FAILED || l_ElfSegment == nullptr)
+            auto l_ReadCount = kgetdents_t(l_DirectoryHandle, s_DentBuffer, DecryptSelfBatch_DentBufferSize, s_IoThread);
+            if (l_ReadCount <= 0)
+                break;
+
+            for (auto l_Pos = 0; l_Pos < l_ReadCount;)
             {
-                // For some strange reason mmap will return ENOMEM for no fucking reason
-                if (l_ElfSegment == (caddr_t)(-ENOMEM))
+                auto l_Dent = (struct dirent*)(s_DentBuffer + l_Pos);
+                l_Pos += l_Dent->d_reclen;
+
+                if (l_Dent->d_reclen == 0)
+                    break;
+
+                if (l_Dent->d_type != DT_DIR && l_Dent->d_type != DT_REG)
+                    continue;
+
+                if (l_Dent->d_type == DT_DIR && (!strcmp(l_Dent->d_name, ".") || !strcmp(l_Dent->d_name, "..")))
+                    continue;
+
+                if (l_Dent->d_type == DT_REG && !PathFilter::Matches(s_Context.Filter, l_Dent->d_name))
+                    continue;
+
+                // <directory>/<name>
+                auto l_PathLength = l_DirectoryLength + 1 + l_Dent->d_namlen;
+                if (l_PathLength >= MaxPathLength)
                 {
-                    WriteLog(LL_Error, "mmap returned (%lld).", l_ElfSegment);
+                    WriteLog(LL_Error, "path too long in (%s).", l_Directory->Path);
                     continue;
                 }
 
-                for (auto l_FileIndex = 0; l_FileIndex < s_Phdr[l_PhIndex].p_filesz; ++l_FileIndex)
-                    s_ElfData[s_Phdr[l_PhIndex].p_offset + l_FileIndex] = l_ElfSegment[l_FileIndex];
+                auto l_Path = s_Context.FilePath;
+                memcpy(l_Path, l_Directory->Path, l_DirectoryLength);
+                l_Path[l_DirectoryLength] = '/';
+                memcpy(l_Path + l_DirectoryLength + 1, l_Dent->d_name, l_Dent->d_namlen);
+                l_Path[l_PathLength] = '\0';
+
+                if (l_Dent->d_type == DT_REG)
+                {
+                    DecryptSelfBatchFile(&s_Context, l_Path);
+                    continue;
+                }
+
+                // Only directories waiting to be walked keep their path
+                auto l_Child = s_Arena->Allocate<DecryptSelfBatchDirectory>();
+                if (l_Child != nullptr)
+                    l_Child->Path = s_Arena->Duplicate(l_Path, l_PathLength);
+
+                if (l_Child == nullptr || l_Child->Path == nullptr)
+                {
+                    WriteLog(LL_Error, "could not allocate directory (%s).", l_Path);
+                    continue;
+                }
+
+                l_Child->Next = s_Pending;
+                s_Pending = l_Child;
             }
-            kmunmap_t(l_ElfSegment, s_Phdr[l_PhIndex].p_filesz, s_IoThread);
         }
+
+        kclose_t(l_DirectoryHandle, s_IoThread);
     }
 
-    return s_ElfData;
-}
\ No newline at end of file
+    FmDecryptSelfBatchResponse s_Response = FM_DECRYPT_SELF_BATCH_RESPONSE__INIT;
+    s_Response.done = true;
+    s_Response.fileindex = s_Context.FileIndex;
+    s_Response.failedcount = s_Context.FailedCount;
+    SendDecryptSelfBatchResponse(&s_Context, &s_Response);
+
+    WriteLog(LL_Info, "decrypted (%u) files under (%s), (%u) failed.", s_Context.FileIndex, s_Request->path, s_Context.FailedCount);
+}
+
+// Nanoseconds since boot, 0 when the clock could not be read
+static uint64_t GetMonotonicTime(struct thread* p_Thread)
+{
+    struct timespec s_Time;
+    memset(&s_Time, 0, sizeof(s_Time));
+
+    if (kclock_gettime_t(CLOCK_MONOTONIC, &s_Time, p_Thread) < 0)
+        return 0;
+
+    return static_cast<uint64_t>(s_Time.tv_sec) * 1000000000ull + static_cast<uint64_t>(s_Time.tv_nsec);
+}
+
+void FileManager::DecryptSelfBatchFile(void* p_Context, char* p_Path)
+{
+    auto s_Context = static_cast<DecryptSelfBatchContext*>(p_Context);
+    auto s_IoThread = s_Context->IoThread;
+
+    // Relative to the root of the request, this is what the client sees and what the output mirrors
+    auto s_RelativePath = p_Path + s_Context->RootPathLength;
+
+    auto s_Start = GetMonotonicTime(s_IoThread);
+    uint64_t s_ElfSize = 0;
+    uint32_t s_SkippedSegments = 0;
+    int32_t s_Ret = 0;
+
+    do
+    {
+        auto s_SelfHandle = kopen_t(p_Path, O_RDONLY, 0, s_IoThread);
+        if (s_SelfHandle < 0)
+        {
+            s_Ret = s_SelfHandle;
+            break;
+        }
+
+        if (s_Context->OutputPath[0] != '\0')
+        {
+            auto s_OutputPathLength = strlen(s_Context->OutputPath);
+            auto s_RelativePathLength = strlen(s_RelativePath);
+            if (s_OutputPathLength + s_RelativePathLength >= MaxPathLength)
+            {
+                kclose_t(s_SelfHandle, s_IoThread);
+                s_Ret = -ENAMETOOLONG;
+                break;
+            }
+
+            auto s_OutputPath = s_Context->FileOutputPath;
+            memcpy(s_OutputPath, s_Context->OutputPath, s_OutputPathLength);
+            memcpy(s_OutputPath + s_OutputPathLength, s_RelativePath, s_RelativePathLength);
+            s_OutputPath[s_OutputPathLength + s_RelativePathLength] = '\0';
+
+            // Create the mirrored directories, the ones that exist already just fail
+            for (auto l_Separator = s_OutputPath + 1; *l_Separator != '\0'; ++l_Separator)
+            {
+                if (*l_Separator != '/')
+                    continue;
+
+                *l_Separator = '\0';
+                kmkdir_t(s_OutputPath, 0777, s_IoThread);
+                *l_Separator = '/';
+            }
+
+            s_Context->OutputHandle = kopen_t(s_OutputPath, O_WRONLY | O_CREAT | O_TRUNC, 0777, s_IoThread);
+            if (s_Context->OutputHandle < 0)
+            {
+                WriteLog(LL_Error, "could not open output (%s) (%d).", s_OutputPath, s_Context->OutputHandle);
+                s_Ret = s_Context->OutputHandle;
+                s_Context->OutputHandle = -1;
+                kclose_t(s_SelfHandle, s_IoThread);
+                break;
+            }
+        }
+
+        s_Ret = DecryptSelfStream(s_SelfHandle, OnDecryptSelfBatchChunk, s_Context, &s_ElfSize, &s_SkippedSegments);
+
+        if (s_Context->OutputHandle >= 0)
+        {
+            // Ranges no segment covers were never written, size the output like the ELF
+            if (s_Ret == 0)
+                kftruncate_t(s_Context->OutputHandle, s_ElfSize, s_IoThread);
+
+            kclose_t(s_Context->OutputHandle, s_IoThread);
+            s_Context->OutputHandle = -1;
+        }
+
+        kclose_t(s_SelfHandle, s_IoThread);
+    } while (false);
+
+    FmDecryptSelfBatchResponse s_Response = FM_DECRYPT_SELF_BATCH_RESPONSE__INIT;
+    s_Response.fileindex = s_Context->FileIndex;
+    s_Response.path = s_RelativePath;
+    s_Response.elfsize = s_ElfSize;
+    s_Response.complete = true;
+    s_Response.error = s_Ret;
+    s_Response.durationns = GetMonotonicTime(s_IoThread) - s_Start;
+    s_Response.skippedsegments = s_SkippedSegments;
+    SendDecryptSelfBatchResponse(s_Context, &s_Response);
+
+    if (s_Ret < 0)
+    {
+        WriteLog(LL_Error, "could not decrypt (%s) (%d).", p_Path, s_Ret);
+        s_Context->FailedCount++;
+    }
+    else if (s_SkippedSegments != 0)
+        WriteLog(LL_Warn, "decrypted (%s) is missing (%u) segments.", p_Path, s_SkippedSegments);
+
+    s_Context->FileIndex++;
+}
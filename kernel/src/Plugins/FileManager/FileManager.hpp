@@ -23,6 +23,18 @@ namespace Mira
     {
         namespace FileManagerExtent
         {
+            enum
+            {
+                // getdents buffer used while walking a tree for a batch decrypt
+                DecryptSelfBatch_DentBufferSize = 0x1000,
+            };
+
+            // Files a batch decrypt picks up when the request has no filter
+            static constexpr const char* DecryptSelfBatch_DefaultFilter = "eboot.bin|*.sprx|*.prx|*.self";
+
+            // Receives a chunk of decrypted output at p_Offset of a p_ElfSize byte ELF, returning false stops decryption
+            typedef bool(*SelfDecryptChunkCallback)(void* p_Context, uint64_t p_Offset, const uint8_t* p_Data, uint32_t p_Size, uint64_t p_ElfSize);
+
             class FileManager : public Mira::Utils::IModule
             {
             public:
@@ -47,10 +59,19 @@ namespace Mira
                 static void OnRmDir(Messaging::Rpc::Connection* p_Connection, const RpcTransport* p_Message);
                 static void OnUnlink(Messaging::Rpc::Connection* p_Connection, const RpcTransport* p_Message);
                 static void OnDecryptSelf(Messaging::Rpc::Connection* p_Connection, const RpcTransport* p_Message);
+                static void OnDecryptSelfBatch(Messaging::Rpc::Connection* p_Connection, const RpcTransport* p_Message);
+
+                // Decrypts one file of a batch and reports its status, p_Context is the batch state
+                static void DecryptSelfBatchFile(void* p_Context, char* p_Path);
 
-                static uint8_t* DecryptSelfFd(int p_SelfFd, size_t* p_OutElfSize);
-                static uint8_t* DecryptSelf(uint8_t* p_SelfData, size_t p_SelfSize, int p_SelfFd, size_t* p_OutElfSize);
+            public:
+                // Decrypts a SELF (or passes a plain ELF through) without reading the whole file, only the headers
+                // and one MAP_SELF mapped segment are held at a time. The output is handed to p_Callback in chunks
+                // of up to SelfDecryptPlan_WindowSize bytes, ordered by offset. Returns 0 or a negative errno.
+                // Segments that could not be mapped are left out (zeroes in the output) and counted in p_OutSkippedSegments
+                static int32_t DecryptSelfStream(int p_SelfFd, SelfDecryptChunkCallback p_Callback, void* p_Context, uint64_t* p_OutElfSize = nullptr, uint32_t* p_OutSkippedSegments = nullptr);
 
+            private:
                 static bool IsValidElf(Elf64_Ehdr* p_Header)
                 {
                     if (p_Header == nullptr) return false;
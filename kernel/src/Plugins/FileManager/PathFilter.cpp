@@ -0,0 +1,98 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "PathFilter.hpp"
+#include <Utils/Kernel.hpp>
+
+using namespace Mira::Plugins::FileManagerExtent;
+
+bool PathFilter::Matches(const char* p_Filter, const char* p_Name)
+{
+    if (p_Filter == nullptr || p_Name == nullptr)
+        return false;
+
+    auto s_Pattern = p_Filter;
+    for (;;)
+    {
+        auto l_End = s_Pattern;
+        while (*l_End != '\0' && *l_End != PathFilter_Separator)
+            ++l_End;
+
+        auto l_Length = static_cast<uint32_t>(l_End - s_Pattern);
+        if (l_Length > 0 && MatchGlob(s_Pattern, l_Length, p_Name))
+            return true;
+
+        if (*l_End == '\0')
+            return false;
+
+        s_Pattern = l_End + 1;
+    }
+}
+
+bool PathFilter::MatchGlob(const char* p_Pattern, uint32_t p_PatternLength, const char* p_Name)
+{
+    if (p_Pattern == nullptr || p_Name == nullptr)
+        return false;
+
+    uint32_t s_PatternIndex = 0;
+    auto s_Name = p_Name;
+
+    // Where to resume after the last '*' when the characters following it stop matching
+    uint32_t s_StarIndex = p_PatternLength;
+    const char* s_StarName = nullptr;
+
+    while (*s_Name != '\0')
+    {
+        if (s_PatternIndex < p_PatternLength)
+        {
+            auto l_Char = p_Pattern[s_PatternIndex];
+            if (l_Char == '*')
+            {
+                s_StarIndex = s_PatternIndex++;
+                s_StarName = s_Name;
+                continue;
+            }
+
+            if (l_Char == '?' || ToLower(l_Char) == ToLower(*s_Name))
+            {
+                ++s_PatternIndex;
+                ++s_Name;
+                continue;
+            }
+        }
+
+        // Let the last '*' swallow one more character and try again
+        if (s_StarName == nullptr)
+            return false;
+
+        s_PatternIndex = s_StarIndex + 1;
+        s_Name = ++s_StarName;
+    }
+
+    // Trailing stars match the empty rest of the name
+    while (s_PatternIndex < p_PatternLength && p_Pattern[s_PatternIndex] == '*')
+        ++s_PatternIndex;
+
+    return s_PatternIndex == p_PatternLength;
+}
+
+bool PathFilter::IsAtOrBelow(const char* p_Path, const char* p_Root)
+{
+    if (p_Path == nullptr || p_Root == nullptr || p_Root[0] == '\0')
+        return false;
+
+    // "/data/" and "/data" are the same root, "/" leaves nothing to compare and covers every absolute path
+    auto s_RootLength = strlen(p_Root);
+    while (s_RootLength > 0 && p_Root[s_RootLength - 1] == '/')
+        --s_RootLength;
+
+    if (strlen(p_Path) < s_RootLength || memcmp(p_Path, p_Root, s_RootLength) != 0)
+        return false;
+
+    // "/data/dump" is below "/data", "/database" is not
+    auto s_Next = p_Path[s_RootLength];
+    if (s_RootLength == 0)
+        return s_Next == '/';
+
+    return s_Next == '\0' || s_Next == '/';
+}
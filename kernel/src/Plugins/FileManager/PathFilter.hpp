@@ -0,0 +1,41 @@
+#pragma once
+#include <Utils/Types.hpp>
+
+namespace Mira
+{
+    namespace Plugins
+    {
+        namespace FileManagerExtent
+        {
+            enum
+            {
+                // Separates the globs of a filter, "eboot.bin|*.sprx"
+                PathFilter_Separator = '|',
+            };
+
+            /*
+                PathFilter
+
+                Matches file names against a filter of '|' separated globs. '*' matches any run of
+                characters and '?' a single one, ASCII letters compare without case since dumps mix
+                EBOOT.BIN and eboot.bin.
+            */
+            class PathFilter
+            {
+            public:
+                // True when p_Name matches any glob of p_Filter, an empty filter matches nothing
+                static bool Matches(const char* p_Filter, const char* p_Name);
+
+                // p_Pattern does not have to be null terminated
+                static bool MatchGlob(const char* p_Pattern, uint32_t p_PatternLength, const char* p_Name);
+
+                // True when p_Path is p_Root or lies below it, compared whole component by whole
+                // component. Neither is resolved, ".." and links are taken as they are written
+                static bool IsAtOrBelow(const char* p_Path, const char* p_Root);
+
+            private:
+                static char ToLower(char p_Char) { return (p_Char >= 'A' && p_Char <= 'Z') ? static_cast<char>(p_Char - 'A' + 'a') : p_Char; }
+            };
+        }
+    }
+}
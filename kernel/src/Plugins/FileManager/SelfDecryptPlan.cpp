@@ -0,0 +1,136 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "SelfDecryptPlan.hpp"
+#include "FileManagerSelf.hpp"
+#include <Utils/Kernel.hpp>
+
+#include <sys/param.h>
+#include <sys/elf64.h>
+
+using namespace Mira::Plugins::FileManagerExtent;
+
+SelfDecryptPlan::SelfDecryptPlan()
+{
+    Reset();
+}
+
+void SelfDecryptPlan::Reset()
+{
+    m_IsSelf = false;
+    m_RequiredSize = 0;
+    m_ElfOffset = 0;
+    m_HeaderSize = 0;
+    m_ElfSize = 0;
+    m_SegmentCount = 0;
+
+    memset(m_Segments, 0, sizeof(m_Segments));
+}
+
+SelfDecryptPlan::Status SelfDecryptPlan::Parse(uint8_t* p_Data, uint64_t p_DataSize, uint64_t p_FileSize)
+{
+    Reset();
+
+    if (p_Data == nullptr || p_DataSize > p_FileSize)
+        return Status::Invalid;
+
+    auto s_Status = Require(SELFMAG, p_DataSize, p_FileSize);
+    if (s_Status != Status::Ok)
+        return s_Status;
+
+    // Plain ELFs go out unchanged
+    if (IS_ELF(*reinterpret_cast<const Elf64_Ehdr*>(p_Data)))
+    {
+        m_ElfSize = p_FileSize;
+        return Status::Ok;
+    }
+
+    s_Status = Require(sizeof(self_header_t), p_DataSize, p_FileSize);
+    if (s_Status != Status::Ok)
+        return s_Status;
+
+    auto s_SelfHeader = reinterpret_cast<const self_header_t*>(p_Data);
+    if (s_SelfHeader->magic != SelfDecryptPlan_SelfMagic)
+        return Status::Invalid;
+
+    // The ELF header follows the SELF header and its entries
+    auto s_ElfOffset = sizeof(self_header_t) + (sizeof(self_entry_t) * static_cast<uint64_t>(s_SelfHeader->num_entries));
+    s_Status = Require(s_ElfOffset + sizeof(Elf64_Ehdr), p_DataSize, p_FileSize);
+    if (s_Status != Status::Ok)
+        return s_Status;
+
+    auto s_Ehdr = reinterpret_cast<Elf64_Ehdr*>(p_Data + s_ElfOffset);
+    if (!IS_ELF(*s_Ehdr) || s_Ehdr->e_ident[EI_CLASS] != ELFCLASS64)
+        return Status::Invalid;
+
+    if (s_Ehdr->e_phentsize != sizeof(Elf64_Phdr) || s_Ehdr->e_phnum > SelfDecryptPlan_MaxProgramHeaders)
+        return Status::Invalid;
+
+    if (s_Ehdr->e_phoff < sizeof(Elf64_Ehdr) || s_Ehdr->e_phoff > SelfDecryptPlan_MaxHeaderSize)
+        return Status::Invalid;
+
+    // The header chunk is the ELF header through the last program header
+    auto s_HeaderSize = s_Ehdr->e_phoff + (sizeof(Elf64_Phdr) * static_cast<uint64_t>(s_Ehdr->e_phnum));
+    s_Status = Require(s_ElfOffset + s_HeaderSize, p_DataSize, p_FileSize);
+    if (s_Status != Status::Ok)
+        return s_Status;
+
+    auto s_Phdrs = reinterpret_cast<const Elf64_Phdr*>(reinterpret_cast<const uint8_t*>(s_Ehdr) + s_Ehdr->e_phoff);
+
+    uint64_t s_ElfSize = s_HeaderSize;
+    uint32_t s_SegmentCount = 0;
+    for (uint32_t l_Index = 0; l_Index < s_Ehdr->e_phnum; ++l_Index)
+    {
+        auto l_Phdr = &s_Phdrs[l_Index];
+        if (l_Phdr->p_type != PT_LOAD && l_Phdr->p_type != PT_SCE_DYNLIBDATA && l_Phdr->p_type != PT_DYNAMIC)
+            continue;
+
+        auto l_End = l_Phdr->p_offset + l_Phdr->p_filesz;
+        if (l_End < l_Phdr->p_offset)
+            return Status::Invalid;
+
+        s_ElfSize = MAX(s_ElfSize, l_End);
+
+        // PT_DYNAMIC lives inside one of the others, only the size has to account for it
+        if (l_Phdr->p_type == PT_DYNAMIC || l_Phdr->p_filesz == 0)
+            continue;
+
+        // Insert sorted by output offset so the chunks come out in order
+        auto l_Slot = s_SegmentCount++;
+        while (l_Slot > 0 && m_Segments[l_Slot - 1].Offset > l_Phdr->p_offset)
+        {
+            m_Segments[l_Slot] = m_Segments[l_Slot - 1];
+            --l_Slot;
+        }
+
+        m_Segments[l_Slot].ProgramHeaderIndex = l_Index;
+        m_Segments[l_Slot].Offset = l_Phdr->p_offset;
+        m_Segments[l_Slot].Size = l_Phdr->p_filesz;
+    }
+
+    // Section headers are not decrypted, do not point at them. Padding between the ELF header
+    // and the program headers is not carried over either
+    s_Ehdr->e_shoff = 0;
+    s_Ehdr->e_shnum = 0;
+    memset(reinterpret_cast<uint8_t*>(s_Ehdr) + sizeof(Elf64_Ehdr), 0, s_Ehdr->e_phoff - sizeof(Elf64_Ehdr));
+
+    m_IsSelf = true;
+    m_ElfOffset = s_ElfOffset;
+    m_HeaderSize = s_HeaderSize;
+    m_ElfSize = s_ElfSize;
+    m_SegmentCount = s_SegmentCount;
+
+    return Status::Ok;
+}
+
+SelfDecryptPlan::Status SelfDecryptPlan::Require(uint64_t p_Size, uint64_t p_DataSize, uint64_t p_FileSize)
+{
+    if (p_Size <= p_DataSize)
+        return Status::Ok;
+
+    if (p_Size > p_FileSize || p_Size > SelfDecryptPlan_MaxHeaderSize)
+        return Status::Invalid;
+
+    m_RequiredSize = p_Size;
+    return Status::NeedMoreData;
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <Utils/Types.hpp>
+
+namespace Mira
+{
+    namespace Plugins
+    {
+        namespace FileManagerExtent
+        {
+            enum
+            {
+                // First header read of a file, the SELF header, entries, ELF header and program headers of nearly every SELF fit
+                SelfDecryptPlan_InitialHeaderSize = 0x1000,
+
+                // Anything needing more header bytes than this is rejected
+                SelfDecryptPlan_MaxHeaderSize = 0x10000,
+
+                // Program headers accepted, SELFs out in the wild have around a dozen
+                SelfDecryptPlan_MaxProgramHeaders = 64,
+
+                // Size of every chunk handed out while decrypting
+                SelfDecryptPlan_WindowSize = 0x10000,
+
+                // "\x4F\x15\x3D\x1D"
+                SelfDecryptPlan_SelfMagic = 0x1D3D154F,
+            };
+
+            struct SelfDecryptSegment
+            {
+                // Program header index, which is also what MAP_SELF takes in the upper 32 bits of the offset
+                uint32_t ProgramHeaderIndex;
+
+                // Where the decrypted segment goes in the output ELF
+                uint64_t Offset;
+                uint64_t Size;
+            };
+
+            /*
+                SelfDecryptPlan
+
+                Works out what decrypting a SELF takes from its headers alone, so the file never has
+                to be read in full: the ELF header and program headers that start the output, and the
+                segments that have to be mapped with MAP_SELF, sorted by output offset.
+
+                Parse is given the first bytes of the file and asks for more (NeedMoreData with
+                GetRequiredSize) until the SELF header, its entries, the ELF header and all of the
+                program headers are there. Plain ELFs are recognized too, those are copied as is.
+
+                This does no io and keeps no pointers, so it builds for the host as well.
+            */
+            class SelfDecryptPlan
+            {
+            public:
+                enum class Status : uint8_t
+                {
+                    Ok,
+                    NeedMoreData,
+                    Invalid
+                };
+
+            private:
+                bool m_IsSelf;
+
+                // Bytes of the file Parse needs to finish
+                uint64_t m_RequiredSize;
+
+                // Where the ELF header starts in the file, and how many bytes of it go out as the header chunk
+                uint64_t m_ElfOffset;
+                uint64_t m_HeaderSize;
+
+                uint64_t m_ElfSize;
+
+                SelfDecryptSegment m_Segments[SelfDecryptPlan_MaxProgramHeaders];
+                uint32_t m_SegmentCount;
+
+            public:
+                SelfDecryptPlan();
+
+                // p_Data holds the first p_DataSize bytes of a p_FileSize byte file. On Ok the ELF header in
+                // p_Data has its section headers cleared, since those are not part of the output
+                Status Parse(uint8_t* p_Data, uint64_t p_DataSize, uint64_t p_FileSize);
+
+                void Reset();
+
+                bool IsSelf() const { return m_IsSelf; }
+
+                uint64_t GetRequiredSize() const { return m_RequiredSize; }
+
+                uint64_t GetElfOffset() const { return m_ElfOffset; }
+                uint64_t GetHeaderSize() const { return m_HeaderSize; }
+
+                // Size of the whole output, ranges not covered by the header or a segment are zero
+                uint64_t GetElfSize() const { return m_ElfSize; }
+
+                uint32_t GetSegmentCount() const { return m_SegmentCount; }
+                const SelfDecryptSegment* GetSegment(uint32_t p_Index) const { return p_Index < m_SegmentCount ? &m_Segments[p_Index] : nullptr; }
+
+            private:
+                // Ok when the first p_Size bytes are in p_Data, NeedMoreData when they can still be read, Invalid otherwise
+                Status Require(uint64_t p_Size, uint64_t p_DataSize, uint64_t p_FileSize);
+            };
+        }
+    }
+}
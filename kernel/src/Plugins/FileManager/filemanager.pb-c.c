@@ -817,6 +817,96 @@ void   fm_decrypt_self_response__free_unpacked
   assert(message->base.descriptor == &fm_decrypt_self_response__descriptor);
   protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
 }
+void   fm_decrypt_self_batch_request__init
+                     (FmDecryptSelfBatchRequest         *message)
+{
+  static const FmDecryptSelfBatchRequest init_value = FM_DECRYPT_SELF_BATCH_REQUEST__INIT;
+  *message = init_value;
+}
+size_t fm_decrypt_self_batch_request__get_packed_size
+                     (const FmDecryptSelfBatchRequest *message)
+{
+  assert(message->base.descriptor == &fm_decrypt_self_batch_request__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t fm_decrypt_self_batch_request__pack
+                     (const FmDecryptSelfBatchRequest *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &fm_decrypt_self_batch_request__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t fm_decrypt_self_batch_request__pack_to_buffer
+                     (const FmDecryptSelfBatchRequest *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &fm_decrypt_self_batch_request__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+FmDecryptSelfBatchRequest *
+       fm_decrypt_self_batch_request__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (FmDecryptSelfBatchRequest *)
+     protobuf_c_message_unpack (&fm_decrypt_self_batch_request__descriptor,
+                                allocator, len, data);
+}
+void   fm_decrypt_self_batch_request__free_unpacked
+                     (FmDecryptSelfBatchRequest *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &fm_decrypt_self_batch_request__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   fm_decrypt_self_batch_response__init
+                     (FmDecryptSelfBatchResponse         *message)
+{
+  static const FmDecryptSelfBatchResponse init_value = FM_DECRYPT_SELF_BATCH_RESPONSE__INIT;
+  *message = init_value;
+}
+size_t fm_decrypt_self_batch_response__get_packed_size
+                     (const FmDecryptSelfBatchResponse *message)
+{
+  assert(message->base.descriptor == &fm_decrypt_self_batch_response__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t fm_decrypt_self_batch_response__pack
+                     (const FmDecryptSelfBatchResponse *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &fm_decrypt_self_batch_response__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t fm_decrypt_self_batch_response__pack_to_buffer
+                     (const FmDecryptSelfBatchResponse *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &fm_decrypt_self_batch_response__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+FmDecryptSelfBatchResponse *
+       fm_decrypt_self_batch_response__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (FmDecryptSelfBatchResponse *)
+     protobuf_c_message_unpack (&fm_decrypt_self_batch_response__descriptor,
+                                allocator, len, data);
+}
+void   fm_decrypt_self_batch_response__free_unpacked
+                     (FmDecryptSelfBatchResponse *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &fm_decrypt_self_batch_response__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
 static const ProtobufCFieldDescriptor fm_echo_request__field_descriptors[1] =
 {
   {
@@ -1814,7 +1904,7 @@ const ProtobufCMessageDescriptor fm_decrypt_self_request__descriptor =
   (ProtobufCMessageInit) fm_decrypt_self_request__init,
   NULL,NULL,NULL    /* reserved[123] */
 };
-static const ProtobufCFieldDescriptor fm_decrypt_self_response__field_descriptors[1] =
+static const ProtobufCFieldDescriptor fm_decrypt_self_response__field_descriptors[4] =
 {
   {
     "data",
@@ -1828,14 +1918,53 @@ static const ProtobufCFieldDescriptor fm_decrypt_self_response__field_descriptor
     0,             /* flags */
     0,NULL,NULL    /* reserved1,reserved2, etc */
   },
+  {
+    "offset",
+    2,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfResponse, offset),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "elfSize",
+    3,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfResponse, elfsize),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "skippedSegments",
+    4,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfResponse, skippedsegments),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
 };
 static const unsigned fm_decrypt_self_response__field_indices_by_name[] = {
   0,   /* field[0] = data */
+  2,   /* field[2] = elfSize */
+  1,   /* field[1] = offset */
+  3,   /* field[3] = skippedSegments */
 };
 static const ProtobufCIntRange fm_decrypt_self_response__number_ranges[1 + 1] =
 {
   { 1, 0 },
-  { 0, 1 }
+  { 0, 4 }
 };
 const ProtobufCMessageDescriptor fm_decrypt_self_response__descriptor =
 {
@@ -1845,10 +1974,242 @@ const ProtobufCMessageDescriptor fm_decrypt_self_response__descriptor =
   "FmDecryptSelfResponse",
   "",
   sizeof(FmDecryptSelfResponse),
-  1,
+  4,
   fm_decrypt_self_response__field_descriptors,
   fm_decrypt_self_response__field_indices_by_name,
   1,  fm_decrypt_self_response__number_ranges,
   (ProtobufCMessageInit) fm_decrypt_self_response__init,
   NULL,NULL,NULL    /* reserved[123] */
 };
+static const ProtobufCFieldDescriptor fm_decrypt_self_batch_request__field_descriptors[3] =
+{
+  {
+    "path",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_STRING,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfBatchRequest, path),
+    NULL,
+    &protobuf_c_empty_string,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "filter",
+    2,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_STRING,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfBatchRequest, filter),
+    NULL,
+    &protobuf_c_empty_string,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "outputPath",
+    3,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_STRING,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfBatchRequest, outputpath),
+    NULL,
+    &protobuf_c_empty_string,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned fm_decrypt_self_batch_request__field_indices_by_name[] = {
+  1,   /* field[1] = filter */
+  2,   /* field[2] = outputPath */
+  0,   /* field[0] = path */
+};
+static const ProtobufCIntRange fm_decrypt_self_batch_request__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 3 }
+};
+const ProtobufCMessageDescriptor fm_decrypt_self_batch_request__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "FmDecryptSelfBatchRequest",
+  "FmDecryptSelfBatchRequest",
+  "FmDecryptSelfBatchRequest",
+  "",
+  sizeof(FmDecryptSelfBatchRequest),
+  3,
+  fm_decrypt_self_batch_request__field_descriptors,
+  fm_decrypt_self_batch_request__field_indices_by_name,
+  1,  fm_decrypt_self_batch_request__number_ranges,
+  (ProtobufCMessageInit) fm_decrypt_self_batch_request__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor fm_decrypt_self_batch_response__field_descriptors[11] =
+{
+  {
+    "fileIndex",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfBatchResponse, fileindex),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "path",
+    2,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_STRING,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfBatchResponse, path),
+    NULL,
+    &protobuf_c_empty_string,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "data",
+    3,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_BYTES,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfBatchResponse, data),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "offset",
+    4,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfBatchResponse, offset),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "elfSize",
+    5,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfBatchResponse, elfsize),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "complete",
+    6,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_BOOL,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfBatchResponse, complete),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "error",
+    7,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_INT32,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfBatchResponse, error),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "durationNs",
+    8,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfBatchResponse, durationns),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "done",
+    9,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_BOOL,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfBatchResponse, done),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "failedCount",
+    10,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfBatchResponse, failedcount),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "skippedSegments",
+    11,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(FmDecryptSelfBatchResponse, skippedsegments),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned fm_decrypt_self_batch_response__field_indices_by_name[] = {
+  5,   /* field[5] = complete */
+  2,   /* field[2] = data */
+  8,   /* field[8] = done */
+  7,   /* field[7] = durationNs */
+  4,   /* field[4] = elfSize */
+  6,   /* field[6] = error */
+  9,   /* field[9] = failedCount */
+  0,   /* field[0] = fileIndex */
+  3,   /* field[3] = offset */
+  1,   /* field[1] = path */
+  10,   /* field[10] = skippedSegments */
+};
+static const ProtobufCIntRange fm_decrypt_self_batch_response__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 11 }
+};
+const ProtobufCMessageDescriptor fm_decrypt_self_batch_response__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "FmDecryptSelfBatchResponse",
+  "FmDecryptSelfBatchResponse",
+  "FmDecryptSelfBatchResponse",
+  "",
+  sizeof(FmDecryptSelfBatchResponse),
+  11,
+  fm_decrypt_self_batch_response__field_descriptors,
+  fm_decrypt_self_batch_response__field_indices_by_name,
+  1,  fm_decrypt_self_batch_response__number_ranges,
+  (ProtobufCMessageInit) fm_decrypt_self_batch_response__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
@@ -33,6 +33,8 @@ typedef struct _FmRmdirRequest FmRmdirRequest;
 typedef struct _FmUnlinkRequest FmUnlinkRequest;
 typedef struct _FmDecryptSelfRequest FmDecryptSelfRequest;
 typedef struct _FmDecryptSelfResponse FmDecryptSelfResponse;
+typedef struct _FmDecryptSelfBatchRequest FmDecryptSelfBatchRequest;
+typedef struct _FmDecryptSelfBatchResponse FmDecryptSelfBatchResponse;
 
 
 /* --- enums --- */
@@ -242,10 +244,45 @@ struct  _FmDecryptSelfResponse
 {
   ProtobufCMessage base;
   ProtobufCBinaryData data;
+  uint64_t offset;
+  uint64_t elfsize;
+  uint32_t skippedsegments;
 };
 #define FM_DECRYPT_SELF_RESPONSE__INIT \
  { PROTOBUF_C_MESSAGE_INIT (&fm_decrypt_self_response__descriptor) \
-    , {0,NULL} }
+    , {0,NULL}, 0, 0, 0 }
+
+
+struct  _FmDecryptSelfBatchRequest
+{
+  ProtobufCMessage base;
+  char *path;
+  char *filter;
+  char *outputpath;
+};
+#define FM_DECRYPT_SELF_BATCH_REQUEST__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&fm_decrypt_self_batch_request__descriptor) \
+    , (char *)protobuf_c_empty_string, (char *)protobuf_c_empty_string, (char *)protobuf_c_empty_string }
+
+
+struct  _FmDecryptSelfBatchResponse
+{
+  ProtobufCMessage base;
+  uint32_t fileindex;
+  char *path;
+  ProtobufCBinaryData data;
+  uint64_t offset;
+  uint64_t elfsize;
+  protobuf_c_boolean complete;
+  int32_t error;
+  uint64_t durationns;
+  protobuf_c_boolean done;
+  uint32_t failedcount;
+  uint32_t skippedsegments;
+};
+#define FM_DECRYPT_SELF_BATCH_RESPONSE__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&fm_decrypt_self_batch_response__descriptor) \
+    , 0, (char *)protobuf_c_empty_string, {0,NULL}, 0, 0, 0, 0, 0, 0, 0, 0 }
 
 
 /* FmEchoRequest methods */
@@ -590,6 +627,44 @@ FmDecryptSelfResponse *
 void   fm_decrypt_self_response__free_unpacked
                      (FmDecryptSelfResponse *message,
                       ProtobufCAllocator *allocator);
+/* FmDecryptSelfBatchRequest methods */
+void   fm_decrypt_self_batch_request__init
+                     (FmDecryptSelfBatchRequest         *message);
+size_t fm_decrypt_self_batch_request__get_packed_size
+                     (const FmDecryptSelfBatchRequest   *message);
+size_t fm_decrypt_self_batch_request__pack
+                     (const FmDecryptSelfBatchRequest   *message,
+                      uint8_t             *out);
+size_t fm_decrypt_self_batch_request__pack_to_buffer
+                     (const FmDecryptSelfBatchRequest   *message,
+                      ProtobufCBuffer     *buffer);
+FmDecryptSelfBatchRequest *
+       fm_decrypt_self_batch_request__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   fm_decrypt_self_batch_request__free_unpacked
+                     (FmDecryptSelfBatchRequest *message,
+                      ProtobufCAllocator *allocator);
+/* FmDecryptSelfBatchResponse methods */
+void   fm_decrypt_self_batch_response__init
+                     (FmDecryptSelfBatchResponse         *message);
+size_t fm_decrypt_self_batch_response__get_packed_size
+                     (const FmDecryptSelfBatchResponse   *message);
+size_t fm_decrypt_self_batch_response__pack
+                     (const FmDecryptSelfBatchResponse   *message,
+                      uint8_t             *out);
+size_t fm_decrypt_self_batch_response__pack_to_buffer
+                     (const FmDecryptSelfBatchResponse   *message,
+                      ProtobufCBuffer     *buffer);
+FmDecryptSelfBatchResponse *
+       fm_decrypt_self_batch_response__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   fm_decrypt_self_batch_response__free_unpacked
+                     (FmDecryptSelfBatchResponse *message,
+                      ProtobufCAllocator *allocator);
 /* --- per-message closures --- */
 
 typedef void (*FmEchoRequest_Closure)
@@ -646,6 +721,12 @@ typedef void (*FmDecryptSelfRequest_Closure)
 typedef void (*FmDecryptSelfResponse_Closure)
                  (const FmDecryptSelfResponse *message,
                   void *closure_data);
+typedef void (*FmDecryptSelfBatchRequest_Closure)
+                 (const FmDecryptSelfBatchRequest *message,
+                  void *closure_data);
+typedef void (*FmDecryptSelfBatchResponse_Closure)
+                 (const FmDecryptSelfBatchResponse *message,
+                  void *closure_data);
 
 /* --- services --- */
 
@@ -670,6 +751,8 @@ extern const ProtobufCMessageDescriptor fm_rmdir_request__descriptor;
 extern const ProtobufCMessageDescriptor fm_unlink_request__descriptor;
 extern const ProtobufCMessageDescriptor fm_decrypt_self_request__descriptor;
 extern const ProtobufCMessageDescriptor fm_decrypt_self_response__descriptor;
+extern const ProtobufCMessageDescriptor fm_decrypt_self_batch_request__descriptor;
+extern const ProtobufCMessageDescriptor fm_decrypt_self_batch_response__descriptor;
 
 PROTOBUF_C__END_DECLS
 
@@ -7,6 +7,7 @@
 
 #include <Mira.hpp>
 #include <OrbisOS/Utilities.hpp>
+#include <OrbisOS/PatchSet.hpp>
 
 extern "C"
 {
@@ -17,7 +18,9 @@ extern "C"
 using namespace Mira::Plugins;
 using namespace Mira::OrbisOS;
 
-MorpheusEnabler::MorpheusEnabler()
+MorpheusEnabler::MorpheusEnabler() :
+    m_ProcessStartSubscription(-1),
+    m_resumeEvent(nullptr)
 {
 
 }
@@ -27,19 +30,10 @@ MorpheusEnabler::~MorpheusEnabler()
 
 }
 
-void MorpheusEnabler::ProcessStartEvent(void *arg, struct ::proc *p)
+void MorpheusEnabler::ProcessStartEvent(ProcessInfo* p_Info, void* p_Argument)
 {
-    auto strncmp = (int(*)(const char *, const char *, size_t))kdlsym(strncmp);
-
-    if (!p)
-        return;
-
-    char* s_TitleId = (char*)((uint64_t)p + 0x390);
-    if (strncmp(s_TitleId, "NPXS20001", 9) == 0) {
-        DoPatch();
-    }
-
-    return;
+    // Only subscribed for SceShellUI (NPXS20001)
+    DoPatch();
 }
 
 void MorpheusEnabler::ResumeEvent()
@@ -60,49 +54,18 @@ bool MorpheusEnabler::DoPatch()
 		return false;
 	}
 
-	ProcVmMapEntry* s_Entries = nullptr;
-	size_t s_NumEntries = 0;
-	auto s_Ret = Utilities::GetProcessVmMap(s_Process, &s_Entries, &s_NumEntries);
-	if (s_Ret < 0)
+	static const PatchSetEntry s_Patches[] =
 	{
-		WriteLog(LL_Error, "could not get vm map");
-		return false;
-	}
+		{ "ssc_enable_vr", nullptr, ssc_enable_vr, nullptr, reinterpret_cast<const uint8_t*>("\x31\xC0\xC3"), 3 },
+	};
 
-	if (s_Entries == nullptr || s_NumEntries == 0)
-	{
-		WriteLog(LL_Error, "invalid entries (%p) or numEntries (%d)", s_Entries, s_NumEntries);
-		return false;
-	}
+	static PatchSetRecord s_Record;
 
-	uint8_t* s_TextStart = nullptr;
-	for (auto i = 0; i < s_NumEntries; ++i)
-	{
-		if (s_Entries[i].prot == (PROT_READ | PROT_EXEC))
-		{
-			s_TextStart = (uint8_t*)s_Entries[i].start;
-			break;
-		}
-	}
-
-	if (s_TextStart == nullptr)
-	{
-		WriteLog(LL_Error, "could not find SceShellCore text start");
-		return false;
-	}
-
-	WriteLog(LL_Debug, "SceShellCore .text: (%p)", s_TextStart);
-
-	// Free the entries we got returned
-	delete [] s_Entries;
-	s_Entries = nullptr;
-
-	s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_TextStart + ssc_enable_vr), 3, (void*)"\x31\xC0\xC3", nullptr, true);
+	PatchSet s_PatchSet("SceShellCore", s_Patches, ARRAYSIZE(s_Patches), &s_Record);
+	auto s_Ret = s_PatchSet.Apply(s_Process);
+	Utilities::ReleaseProcess(s_Process);
 	if (s_Ret < 0)
-	{
-			WriteLog(LL_Error, "ssc_enable_vr");
-			return false;
-	}
+		return false;
 
 	return true;
 }
@@ -119,9 +82,15 @@ bool MorpheusEnabler::OnLoad()
     // Initialize the event handlers
     auto eventhandler_register = (eventhandler_tag(*)(struct eventhandler_list *list, const char *name, void *func, void *arg, int priority))kdlsym(eventhandler_register);
 
-    m_processStartEvent = eventhandler_register(NULL, "process_exec_end", reinterpret_cast<void*>(MorpheusEnabler::ProcessStartEvent), NULL, EVENTHANDLER_PRI_LAST);
     m_resumeEvent = eventhandler_register(NULL, "system_resume_phase4", reinterpret_cast<void*>(MorpheusEnabler::ResumeEvent), NULL, EVENTHANDLER_PRI_LAST);
 
+    auto s_ProcessEvents = Mira::Framework::GetFramework()->GetProcessEvents();
+    if (s_ProcessEvents != nullptr)
+    {
+        ProcessEventFilter s_Filter = { ProcessEventFilter_None, "NPXS20001", "" };
+        m_ProcessStartSubscription = s_ProcessEvents->Subscribe(ProcessEvent_Start, s_Filter, MorpheusEnabler::ProcessStartEvent, nullptr);
+    }
+
 	return DoPatch();
 }
 
@@ -130,13 +99,14 @@ bool MorpheusEnabler::OnUnload()
     auto eventhandler_deregister = (void(*)(struct eventhandler_list* a, struct eventhandler_entry* b))kdlsym(eventhandler_deregister);
     auto eventhandler_find_list = (struct eventhandler_list * (*)(const char *name))kdlsym(eventhandler_find_list);
 
-    if (m_processStartEvent) {
-        EVENTHANDLER_DEREGISTER(process_exec_end, m_processStartEvent);
-        m_processStartEvent = nullptr;
+    auto s_ProcessEvents = Mira::Framework::GetFramework()->GetProcessEvents();
+    if (s_ProcessEvents != nullptr && m_ProcessStartSubscription >= 0) {
+        s_ProcessEvents->Unsubscribe(m_ProcessStartSubscription);
+        m_ProcessStartSubscription = -1;
     }
 
     if (m_resumeEvent) {
-        EVENTHANDLER_DEREGISTER(process_exit, m_resumeEvent);
+        EVENTHANDLER_DEREGISTER(system_resume_phase4, m_resumeEvent);
         m_resumeEvent = nullptr;
     }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <Utils/IModule.hpp>
 #include <Utils/Types.hpp>
+#include <OrbisOS/ProcessEvents.hpp>
 
 extern "C"
 {
@@ -14,7 +15,7 @@ namespace Mira
 				class MorpheusEnabler : public Mira::Utils::IModule
 				{
 				private:
-			            eventhandler_entry* m_processStartEvent;
+			            int32_t m_ProcessStartSubscription;
 			            eventhandler_entry* m_resumeEvent;
 			    private:
 			    		static bool DoPatch();
@@ -28,7 +29,7 @@ namespace Mira
 						virtual bool OnSuspend() override;
 						virtual bool OnResume() override;
 				protected:
-						static void ProcessStartEvent(void *arg, struct ::proc *p);
+						static void ProcessStartEvent(Mira::OrbisOS::ProcessInfo* p_Info, void* p_Argument);
 						static void ResumeEvent();
 				};
 		}
@@ -7,6 +7,7 @@
 #include <Plugins/Debugger/Debugger2.hpp>
 #include <Plugins/LogServer/LogManager.hpp>
 #include <Plugins/FileManager/FileManager.hpp>
+#include <Plugins/SystemManager/SystemManager.hpp>
 #include <Plugins/FakeSelf/FakeSelfManager.hpp>
 #include <Plugins/FakePkg/FakePkgManager.hpp>
 #include <Plugins/Substitute/Substitute.hpp>
@@ -31,6 +32,7 @@ PluginManager::PluginManager() :
 	m_Logger(nullptr),
     m_Debugger(nullptr),
     m_FileManager(nullptr),
+    m_SystemManager(nullptr),
     m_FakeSelfManager(nullptr),
     m_FakePkgManager(nullptr),
     m_EmuRegistry(nullptr),
@@ -57,7 +59,7 @@ bool PluginManager::OnLoad()
     do
     {
         // Initialize debugger
-        m_Debugger = new Mira::Plugins::Debugger2();
+        m_Debugger = new (Utils::MemoryTag_Debugger) Mira::Plugins::Debugger2();
         if (m_Debugger == nullptr)
         {
             WriteLog(LL_Error, "could not allocate debugger.");
@@ -77,7 +79,7 @@ bool PluginManager::OnLoad()
             WriteLog(LL_Error, "could not load syscall guard.");*/
 
         // Initialize Logger
-        m_Logger = new Mira::Plugins::LogManagerExtent::LogManager();
+        m_Logger = new (Utils::MemoryTag_Plugins) Mira::Plugins::LogManagerExtent::LogManager();
         if (m_Logger == nullptr)
         {
             WriteLog(LL_Error, "could not allocate log manager.");
@@ -87,7 +89,7 @@ bool PluginManager::OnLoad()
             WriteLog(LL_Error, "could not load logmanager");
 
         // Initialize file manager
-        m_FileManager = new Mira::Plugins::FileManagerExtent::FileManager();
+        m_FileManager = new (Utils::MemoryTag_FileManager) Mira::Plugins::FileManagerExtent::FileManager();
         if (m_FileManager == nullptr)
         {
             WriteLog(LL_Error, "could not allocate file manager.");
@@ -95,8 +97,17 @@ bool PluginManager::OnLoad()
             break;
         }
 
+        // Initialize system manager
+        m_SystemManager = new (Utils::MemoryTag_Plugins) Mira::Plugins::SystemManagerExtent::SystemManager();
+        if (m_SystemManager == nullptr)
+        {
+            WriteLog(LL_Error, "could not allocate system manager.");
+            s_Success = false;
+            break;
+        }
+
         // Initialize the fself manager
-        m_FakeSelfManager = new Mira::Plugins::FakeSelfManager();
+        m_FakeSelfManager = new (Utils::MemoryTag_FakeSelf) Mira::Plugins::FakeSelfManager();
         if (m_FakeSelfManager == nullptr)
         {
             WriteLog(LL_Error, "could not allocate fake self manager.");
@@ -105,7 +116,7 @@ bool PluginManager::OnLoad()
         }
 
         // Initialize the fpkg manager
-        m_FakePkgManager = new Mira::Plugins::FakePkgManager();
+        m_FakePkgManager = new (Utils::MemoryTag_FakePkg) Mira::Plugins::FakePkgManager();
         if (m_FakePkgManager == nullptr)
         {
             WriteLog(LL_Error, "could not allocate fake pkg manager.");
@@ -114,7 +125,7 @@ bool PluginManager::OnLoad()
         }
 
         // Initialize Substitute
-        m_Substitute = new Mira::Plugins::Substitute();
+        m_Substitute = new (Utils::MemoryTag_Substitute) Mira::Plugins::Substitute();
         if (m_Substitute == nullptr)
         {
             WriteLog(LL_Error, "could not allocate substitute.");
@@ -123,7 +134,7 @@ bool PluginManager::OnLoad()
         }
 
         // Initialize BrowserActivator
-        m_BrowserActivator = new Mira::Plugins::BrowserActivator();
+        m_BrowserActivator = new (Utils::MemoryTag_Plugins) Mira::Plugins::BrowserActivator();
         if (m_BrowserActivator == nullptr)
         {
             WriteLog(LL_Error, "could not allocate browser activator.");
@@ -132,7 +143,7 @@ bool PluginManager::OnLoad()
         }
 
         // Initialize MorpheusEnabler
-        m_MorpheusEnabler = new Mira::Plugins::MorpheusEnabler();
+        m_MorpheusEnabler = new (Utils::MemoryTag_Plugins) Mira::Plugins::MorpheusEnabler();
         if (m_MorpheusEnabler == nullptr)
         {
             WriteLog(LL_Error, "could not allocate morpheus enabler.");
@@ -141,7 +152,7 @@ bool PluginManager::OnLoad()
         }
 
         // Initialize RemotePlayEnabler
-        m_RemotePlayEnabler = new Mira::Plugins::RemotePlayEnabler();
+        m_RemotePlayEnabler = new (Utils::MemoryTag_Plugins) Mira::Plugins::RemotePlayEnabler();
         if (m_RemotePlayEnabler == nullptr)
         {
             WriteLog(LL_Error, "could not allocate remote play enabler.");
@@ -150,7 +161,7 @@ bool PluginManager::OnLoad()
         }
 
         // Initialize TTYRedirector
-        m_TTYRedirector = new Mira::Plugins::TTYRedirector();
+        m_TTYRedirector = new (Utils::MemoryTag_Plugins) Mira::Plugins::TTYRedirector();
         if (m_TTYRedirector == nullptr)
         {
             WriteLog(LL_Error, "could not allocate tty redirector.");
@@ -171,6 +182,12 @@ bool PluginManager::OnLoad()
             WriteLog(LL_Error, "could not load filemanager");
     }
 
+    if (m_SystemManager)
+    {
+        if (!m_SystemManager->OnLoad())
+            WriteLog(LL_Error, "could not load system manager");
+    }
+
     if (m_FakeSelfManager)
     {
         if (!m_FakeSelfManager->OnLoad())
@@ -271,6 +288,18 @@ bool PluginManager::OnUnload()
         m_FileManager = nullptr;
     }
 
+    // Delete the system manager
+    if (m_SystemManager)
+    {
+        WriteLog(LL_Debug, "unloading system manager");
+
+        if (!m_SystemManager->OnUnload())
+            WriteLog(LL_Error, "system manager could not unload");
+
+        delete m_SystemManager;
+        m_SystemManager = nullptr;
+    }
+
     // Delete the fake self manager
     if (m_FakeSelfManager)
     {
@@ -441,6 +470,12 @@ bool PluginManager::OnSuspend()
             WriteLog(LL_Error, "fake self manager suspend failed");
     }
 
+    if (m_FakePkgManager)
+    {
+        if (!m_FakePkgManager->OnSuspend())
+            WriteLog(LL_Error, "fake pkg manager suspend failed");
+    }
+
     if (m_EmuRegistry)
     {
         if (!m_EmuRegistry->OnSuspend())
@@ -528,6 +563,13 @@ bool PluginManager::OnResume()
             WriteLog(LL_Error, "emuRegistry resume failed");
     }
 
+    WriteLog(LL_Debug, "resuming fake pkg manager");
+    if (m_FakePkgManager)
+    {
+        if (!m_FakePkgManager->OnResume())
+            WriteLog(LL_Error, "fake pkg manager resume failed");
+    }
+
     WriteLog(LL_Debug, "resuming substitute");
     if (m_Substitute)
     {
@@ -29,6 +29,7 @@ namespace Mira
             Mira::Utils::IModule* m_Logger;
             Mira::Utils::IModule* m_Debugger;
             Mira::Utils::IModule* m_FileManager;
+            Mira::Utils::IModule* m_SystemManager;
             Mira::Utils::IModule* m_FakeSelfManager;
             Mira::Utils::IModule* m_FakePkgManager;
             Mira::Utils::IModule* m_EmuRegistry;
@@ -42,6 +43,7 @@ namespace Mira
         public:
             Mira::Utils::IModule* GetDebugger() { return m_Debugger; }
             Mira::Utils::IModule* GetFakeSelfManager() { return m_FakeSelfManager; }
+            Mira::Utils::IModule* GetFakePkgManager() { return m_FakePkgManager; }
             Mira::Utils::IModule* GetEmulatedRegistry() { return m_EmuRegistry; }
             Mira::Utils::IModule* GetSubstitute() { return m_Substitute; }
             Mira::Utils::IModule* GetBrowserActivator() { return m_BrowserActivator; }
@@ -6,6 +6,7 @@
 #include <Utils/Logger.hpp>
 
 #include <OrbisOS/Utilities.hpp>
+#include <OrbisOS/PatchSet.hpp>
 
 using namespace Mira::Plugins;
 using namespace Mira::OrbisOS;
@@ -29,108 +30,56 @@ bool RemotePlayEnabler::ShellUIPatch()
 {
 	WriteLog(LL_Debug, "patching SceShellUI");
 
-	struct ::proc* s_Process = Utilities::FindProcessByName("SceShellUI");
-	if (s_Process == nullptr)
-	{
-		WriteLog(LL_Error, "could not find SceShellUI");
-		return false;
-	}
-
-	ProcVmMapEntry* s_Entries = nullptr;
-	size_t s_NumEntries = 0;
-	auto s_Ret = Utilities::GetProcessVmMap(s_Process, &s_Entries, &s_NumEntries);
-	if (s_Ret < 0)
-	{
-		WriteLog(LL_Error, "could not get vm map");
-		return false;
-	}
-
-	if (s_Entries == nullptr || s_NumEntries == 0)
-	{
-		WriteLog(LL_Error, "invalid entries (%p) or numEntries (%d)", s_Entries, s_NumEntries);
-		return false;
-	}
-
-	uint8_t* s_ShellUITextStart = nullptr;
-	for (auto i = 0; i < s_NumEntries; ++i)
-	{
-		if (!memcmp(s_Entries[i].name, "executable", 10) && s_Entries[i].prot >= (PROT_READ | PROT_EXEC))
-		{
-			s_ShellUITextStart = (uint8_t*)s_Entries[i].start;
-			break;
-		}
-	}
-
-	if (s_ShellUITextStart == nullptr)
-	{
-		WriteLog(LL_Error, "could not find SceShellUI text start");
-		return false;
-	}
-
-	WriteLog(LL_Debug, "SceShellUI .text: (%p)", s_ShellUITextStart);
-
-	uint8_t* s_ShellUIAppTextStart = nullptr;
-	for (auto i = 0; i < s_NumEntries; ++i)
-	{
 #if MIRA_PLATFORM < MIRA_PLATFORM_ORBIS_BSD_500
-		if (!memcmp(s_Entries[i].name, "libSceVsh_aot.sprx", 18) && s_Entries[i].prot >= (PROT_READ | PROT_EXEC))
-		{
-			s_ShellUIAppTextStart = (uint8_t*)s_Entries[i].start;
-			break;
-		}
+	// `/system_ex/app/NPXS20001/libSceVsh_aot.sprx`
+	static const char* s_AppModule = "libSceVsh_aot.sprx";
 #else
-		if (!memcmp(s_Entries[i].name, "app.exe.sprx", 10) && s_Entries[i].prot >= (PROT_READ | PROT_EXEC))
-		{
-			s_ShellUIAppTextStart = (uint8_t*)s_Entries[i].start;
-			break;
-		}
+	// `/system_ex/app/NPXS20001/psm/Application/app.exe.sprx`
+	static const char* s_AppModule = "app.exe.sprx";
 #endif
-	}
-
-	if (s_ShellUIAppTextStart == nullptr)
-	{
-		WriteLog(LL_Error, "could not find SceShellUI App text start");
-		return false;
-	}
-
-	WriteLog(LL_Debug, "SceShellUI App .text: (%p)", s_ShellUIAppTextStart);
-
-	// Free the entries we got returned
-	delete [] s_Entries;
-	s_Entries = nullptr;
-
-	// `/system_ex/app/NPXS20001/eboot.bin`
-	s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_ShellUITextStart + ssu_CreateUserForIDU_patch), 4, (void*)"\x48\x31\xC0\xC3", nullptr, true);
-	if (s_Ret < 0)
-	{
-		WriteLog(LL_Error, "ssu_CreateUserForIDU_patch");
-		return false;
-	}
 
 #if MIRA_PLATFORM == MIRA_PLATFORM_ORBIS_BSD_405
-	// `/system_ex/app/NPXS20001/libSceVsh_aot.sprx`
-	s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_ShellUIAppTextStart + ssu_remote_play_menu_patch), 5, (void*)"\xE9\x64\x02\x00\x00", nullptr, true);
+	static const char* s_RemotePlayMenuPatch = "\xE9\x64\x02\x00\x00";
 #elif MIRA_PLATFORM >= MIRA_PLATFORM_ORBIS_BSD_455 && MIRA_PLATFORM <= MIRA_PLATFORM_ORBIS_BSD_474
-	// `/system_ex/app/NPXS20001/libSceVsh_aot.sprx`
-	s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_ShellUIAppTextStart + ssu_remote_play_menu_patch), 5, (void*)"\xE9\x22\x02\x00\x00", nullptr, true);
+	static const char* s_RemotePlayMenuPatch = "\xE9\x22\x02\x00\x00";
 #elif MIRA_PLATFORM >= MIRA_PLATFORM_ORBIS_BSD_500 && MIRA_PLATFORM <= MIRA_PLATFORM_ORBIS_BSD_507
-	// `/system_ex/app/NPXS20001/psm/Application/app.exe.sprx`
-	s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_ShellUIAppTextStart + ssu_remote_play_menu_patch), 5, (void*)"\xE9\x82\x02\x00\x00", nullptr, true);
+	static const char* s_RemotePlayMenuPatch = "\xE9\x82\x02\x00\x00";
 #elif MIRA_PLATFORM == MIRA_PLATFORM_ORBIS_BSD_620
-	// `/system_ex/app/NPXS20001/psm/Application/app.exe.sprx`
-	s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_ShellUIAppTextStart + ssu_remote_play_menu_patch), 5, (void*)"\xE9\xB8\x02\x00\x00", nullptr, true);
+	static const char* s_RemotePlayMenuPatch = "\xE9\xB8\x02\x00\x00";
 #elif MIRA_PLATFORM == MIRA_PLATFORM_ORBIS_BSD_672
-	// `/system_ex/app/NPXS20001/psm/Application/app.exe.sprx`
-	s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_ShellUIAppTextStart + ssu_remote_play_menu_patch), 5, (void*)"\xE9\xBA\x02\x00\x00", nullptr, true);
+	static const char* s_RemotePlayMenuPatch = "\xE9\xBA\x02\x00\x00";
 #else
-	s_Ret = -1;
+	static const char* s_RemotePlayMenuPatch = nullptr;
 #endif
-	if (s_Ret < 0)
+
+	if (s_RemotePlayMenuPatch == nullptr)
 	{
 		WriteLog(LL_Error, "ssu_remote_play_menu_patch");
 		return false;
 	}
 
+	struct ::proc* s_Process = Utilities::FindProcessByName("SceShellUI");
+	if (s_Process == nullptr)
+	{
+		WriteLog(LL_Error, "could not find SceShellUI");
+		return false;
+	}
+
+	const PatchSetEntry s_Patches[] =
+	{
+		// `/system_ex/app/NPXS20001/eboot.bin`
+		{ "ssu_CreateUserForIDU_patch", "executable", ssu_CreateUserForIDU_patch, nullptr, reinterpret_cast<const uint8_t*>("\x48\x31\xC0\xC3"), 4 },
+		{ "ssu_remote_play_menu_patch", s_AppModule, ssu_remote_play_menu_patch, nullptr, reinterpret_cast<const uint8_t*>(s_RemotePlayMenuPatch), 5 },
+	};
+
+	static PatchSetRecord s_Record;
+
+	PatchSet s_PatchSet("SceShellUI", s_Patches, ARRAYSIZE(s_Patches), &s_Record);
+	auto s_Ret = s_PatchSet.Apply(s_Process);
+	Utilities::ReleaseProcess(s_Process);
+	if (s_Ret < 0)
+		return false;
+
 	WriteLog(LL_Debug, "SceShellUI successfully patched");
 
 	return true;
@@ -147,58 +96,20 @@ bool RemotePlayEnabler::RemotePlayPatch()
 		return false;
 	}
 
-	ProcVmMapEntry* s_Entries = nullptr;
-	size_t s_NumEntries = 0;
-	auto s_Ret = Utilities::GetProcessVmMap(s_Process, &s_Entries, &s_NumEntries);
-	if (s_Ret < 0)
-	{
-		WriteLog(LL_Error, "could not get vm map");
-		return false;
-	}
-
-	if (s_Entries == nullptr || s_NumEntries == 0)
-	{
-		WriteLog(LL_Error, "invalid entries (%p) or numEntries (%d)", s_Entries, s_NumEntries);
-		return false;
-	}
-
-	uint8_t* s_RemotePlayTextStart = nullptr;
-	for (auto i = 0; i < s_NumEntries; ++i)
-	{
-		if (!memcmp(s_Entries[i].name, "executable", 10) && s_Entries[i].prot >= (PROT_READ | PROT_EXEC))
-		{
-			s_RemotePlayTextStart = (uint8_t*)s_Entries[i].start;
-			break;
-		}
-	}
-
-	if (s_RemotePlayTextStart == nullptr)
-	{
-		WriteLog(LL_Error, "could not find SceRemotePlay text start");
-		return false;
-	}
-
-	WriteLog(LL_Debug, "SceRemotePlay .text: (%p)", s_RemotePlayTextStart);
-
-	// Free the entries we got returned
-	delete [] s_Entries;
-	s_Entries = nullptr;
-
 	// `/system/vsh/app/NPXS21006/eboot.bin`
-	s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_RemotePlayTextStart + srp_enabler_patchA), 1, (void*)"\x01", nullptr, true);
-	if (s_Ret < 0)
+	static const PatchSetEntry s_Patches[] =
 	{
-		WriteLog(LL_Error, "srp_enabler_patchA");
-		return false;
-	}
+		{ "srp_enabler_patchA", "executable", srp_enabler_patchA, nullptr, reinterpret_cast<const uint8_t*>("\x01"), 1 },
+		{ "srp_enabler_patchB", "executable", srp_enabler_patchB, nullptr, reinterpret_cast<const uint8_t*>("\xEB\x1E"), 2 },
+	};
 
-	// `/system/vsh/app/NPXS21006/eboot.bin`
-	s_Ret = Utilities::ProcessReadWriteMemory(s_Process, (void*)(s_RemotePlayTextStart + srp_enabler_patchB), 2, (void*)"\xEB\x1E", nullptr, true);
+	static PatchSetRecord s_Record;
+
+	PatchSet s_PatchSet("SceRemotePlay", s_Patches, ARRAYSIZE(s_Patches), &s_Record);
+	auto s_Ret = s_PatchSet.Apply(s_Process);
+	Utilities::ReleaseProcess(s_Process);
 	if (s_Ret < 0)
-	{
-		WriteLog(LL_Error, "srp_enabler_patchB");
 		return false;
-	}
 
 	WriteLog(LL_Debug, "SceRemotePlay successfully patched");
 
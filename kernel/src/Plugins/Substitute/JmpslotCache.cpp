@@ -0,0 +1,248 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "JmpslotCache.hpp"
+#include <Utils/Kdlsym.hpp>
+#include <Utils/Kernel.hpp>
+#include <Utils/Logger.hpp>
+
+using namespace Mira::Plugins;
+
+JmpslotCache::JmpslotCache() :
+    m_Processes(Utils::MemoryTag_Substitute)
+{
+    auto mtx_init = (void(*)(struct mtx *m, const char *name, const char *type, int opts))kdlsym(mtx_init);
+
+    mtx_init(&m_Mutex, "SubJmpslot", nullptr, MTX_DEF);
+}
+
+JmpslotCache::~JmpslotCache()
+{
+    auto mtx_destroy = (void(*)(struct mtx *))kdlsym(mtx_destroy);
+
+    Clear();
+
+    mtx_destroy(&m_Mutex);
+}
+
+uint64_t JmpslotCache::Find(struct proc* p_Process, uint64_t p_DynlibObject, const char* p_Nid)
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    NidKey s_Key;
+    if (p_Process == nullptr || p_DynlibObject == 0 || !GetKey(p_Nid, s_Key))
+        return 0;
+
+    uint64_t s_RelocBase = 0, s_Relocations = 0, s_RelocationsSize = 0;
+    if (!GetRelocations(p_DynlibObject, s_RelocBase, s_Relocations, s_RelocationsSize))
+        return 0;
+
+    uint64_t s_Address = 0;
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    do
+    {
+        ProcessIndex* s_Process = nullptr;
+        auto s_ProcessEntry = m_Processes.Find(p_Process);
+        if (s_ProcessEntry != nullptr)
+            s_Process = *s_ProcessEntry;
+        else
+        {
+            s_Process = new (Utils::MemoryTag_Substitute) ProcessIndex();
+            if (s_Process == nullptr)
+                break;
+
+            if (!m_Processes.Insert(p_Process, s_Process))
+            {
+                delete s_Process;
+                break;
+            }
+        }
+
+        ModuleIndex* s_Module = nullptr;
+        auto s_ModuleEntry = s_Process->Modules.Find(p_DynlibObject);
+        if (s_ModuleEntry != nullptr)
+        {
+            s_Module = *s_ModuleEntry;
+
+            // Another object got loaded where the indexed one used to be
+            if (s_Module->RelocBase != s_RelocBase || s_Module->Relocations != s_Relocations || s_Module->RelocationsSize != s_RelocationsSize)
+            {
+                s_Process->Modules.Remove(p_DynlibObject);
+                delete s_Module;
+                s_Module = nullptr;
+            }
+        }
+
+        if (s_Module == nullptr)
+        {
+            s_Module = Build(p_DynlibObject);
+            if (s_Module == nullptr)
+                break;
+
+            if (!s_Process->Modules.Insert(p_DynlibObject, s_Module))
+            {
+                delete s_Module;
+                break;
+            }
+        }
+
+        auto s_Jmpslot = s_Module->Jmpslots.Find(s_Key);
+        if (s_Jmpslot != nullptr)
+            s_Address = *s_Jmpslot;
+    } while (false);
+    _mtx_unlock_flags(&m_Mutex, 0);
+
+    return s_Address;
+}
+
+void JmpslotCache::RemoveProcess(struct proc* p_Process)
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    if (p_Process == nullptr)
+        return;
+
+    _mtx_lock_flags(&m_Mutex, 0);
+
+    auto s_ProcessEntry = m_Processes.Find(p_Process);
+    if (s_ProcessEntry != nullptr)
+    {
+        auto s_Process = *s_ProcessEntry;
+        m_Processes.Remove(p_Process);
+        DestroyProcess(s_Process);
+    }
+
+    _mtx_unlock_flags(&m_Mutex, 0);
+}
+
+void JmpslotCache::Clear()
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+
+    m_Processes.ForEach([](struct proc* const&, ProcessIndex*& p_Process)
+    {
+        DestroyProcess(p_Process);
+        return true;
+    });
+    m_Processes.Clear();
+
+    _mtx_unlock_flags(&m_Mutex, 0);
+}
+
+bool JmpslotCache::GetKey(const char* p_Nid, NidKey& p_OutKey)
+{
+    if (p_Nid == nullptr || p_Nid[0] == '\0')
+        return false;
+
+    // Same as comparing the first 11 characters with strncmp, shorter strings are zero padded
+    uint8_t s_Bytes[sizeof(NidKey)] = { 0 };
+    for (auto l_Index = 0; l_Index < JmpslotCache_NidLength && p_Nid[l_Index] != '\0'; ++l_Index)
+        s_Bytes[l_Index] = static_cast<uint8_t>(p_Nid[l_Index]);
+
+    memcpy(&p_OutKey, s_Bytes, sizeof(p_OutKey));
+    return true;
+}
+
+bool JmpslotCache::GetRelocations(uint64_t p_DynlibObject, uint64_t& p_OutRelocBase, uint64_t& p_OutRelocations, uint64_t& p_OutRelocationsSize)
+{
+    // Get the main relocbase address, for calculation after
+    p_OutRelocBase = *(uint64_t*)(p_DynlibObject + 0x70);
+
+    uint64_t s_UnkObj = *(uint64_t*)(p_DynlibObject + 0x150);
+    if (s_UnkObj == 0)
+        return false;
+
+    p_OutRelocationsSize = *(uint64_t*)(s_UnkObj + 0x50);
+    p_OutRelocations = *(uint64_t*)(s_UnkObj + 0x48);
+
+    // Idk what is it ^^', check it anyway, conform to Sony kernel
+    return p_OutRelocations != 0 && p_OutRelocationsSize != 0;
+}
+
+JmpslotCache::ModuleIndex* JmpslotCache::Build(uint64_t p_DynlibObject)
+{
+    uint64_t s_RelocBase = 0, s_Relocations = 0, s_RelocationsSize = 0;
+    if (!GetRelocations(p_DynlibObject, s_RelocBase, s_Relocations, s_RelocationsSize))
+    {
+        WriteLog(LL_Error, "dynlib object (%p) has no relocations.", (void*)p_DynlibObject);
+        return nullptr;
+    }
+
+    uint64_t s_UnkObj = *(uint64_t*)(p_DynlibObject + 0x150);
+    uint64_t s_StringTable = *(uint64_t*)(s_UnkObj + 0x38);
+    uint64_t s_SymbolTable = *(uint64_t*)(s_UnkObj + 0x28);
+    uint64_t s_SymbolTableSize = *(uint64_t*)(s_UnkObj + 0x30);
+    uint64_t s_StringTableSize = *(uint64_t*)(s_UnkObj + 0x40);
+
+    auto s_Module = new (Utils::MemoryTag_Substitute) ModuleIndex();
+    if (s_Module == nullptr)
+        return nullptr;
+
+    s_Module->RelocBase = s_RelocBase;
+    s_Module->Relocations = s_Relocations;
+    s_Module->RelocationsSize = s_RelocationsSize;
+
+    // Elf64_Rela, one per 0x18 bytes
+    if (!s_Module->Jmpslots.Reserve(static_cast<uint32_t>(s_RelocationsSize / 0x18)))
+    {
+        delete s_Module;
+        return nullptr;
+    }
+
+    uint32_t s_Skipped = 0;
+    for (uint64_t l_Current = s_Relocations; l_Current < s_Relocations + s_RelocationsSize; l_Current += 0x18)
+    {
+        // r_info >> 32 is the symbol index, Elf64_Sym is 24 bytes and starts with st_name
+        uint64_t l_SymbolOffset = ((*(uint64_t*)(l_Current + 0x8)) >> 32) * 24;
+
+        uint64_t l_NameOffset = 0;
+        if (l_SymbolOffset < s_SymbolTableSize)
+            l_NameOffset = (uint64_t)(*(uint32_t*)(s_SymbolTable + l_SymbolOffset));
+
+        if (l_NameOffset >= s_StringTableSize)
+        {
+            s_Skipped++;
+            continue;
+        }
+
+        NidKey l_Key;
+        if (!GetKey((const char*)(s_StringTable + l_NameOffset), l_Key))
+            continue;
+
+        // The linear search this replaces stopped at the first match, keep that one
+        if (s_Module->Jmpslots.Contains(l_Key))
+            continue;
+
+        uint64_t l_Offset = *(uint64_t*)(l_Current);
+        if (!s_Module->Jmpslots.Insert(l_Key, s_RelocBase + l_Offset))
+        {
+            delete s_Module;
+            return nullptr;
+        }
+    }
+
+    if (s_Skipped > 0)
+        WriteLog(LL_Warn, "dynlib object (%p) skipped (%d) relocations with invalid names.", (void*)p_DynlibObject, s_Skipped);
+
+    return s_Module;
+}
+
+void JmpslotCache::DestroyProcess(ProcessIndex* p_Process)
+{
+    if (p_Process == nullptr)
+        return;
+
+    p_Process->Modules.ForEach([](const uint64_t&, ModuleIndex*& p_Module)
+    {
+        delete p_Module;
+        return true;
+    });
+
+    delete p_Process;
+}
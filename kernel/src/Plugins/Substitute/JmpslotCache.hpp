@@ -0,0 +1,96 @@
+#pragma once
+#include <Utils/Types.hpp>
+#include <Utils/HashMap.hpp>
+
+extern "C"
+{
+    #include <sys/param.h>
+    #include <sys/lock.h>
+    #include <sys/mutex.h>
+};
+
+struct proc;
+
+namespace Mira
+{
+    namespace Plugins
+    {
+        enum
+        {
+            // NIDs are 11 base64 characters, the rest of the symbol name is "#library#module"
+            JmpslotCache_NidLength = 11,
+        };
+
+        /*
+            JmpslotCache
+
+            NID -> jmpslot address index for the dynlib objects of a process. The first lookup
+            against an object walks its relocation table once and indexes every import, after that
+            resolving an IAT hook is a single hash lookup instead of a strncmp per relocation.
+
+            Indexes are dropped when the process exits. An object that was unloaded (and possibly
+            replaced by another one at the same address) is detected by comparing its relocation
+            base and table against the ones the index was built from.
+
+            Lookups must be done with the dynlib bind lock of the process held, the index itself
+            is guarded by its own mutex which is always taken after that lock.
+        */
+        class JmpslotCache
+        {
+        private:
+            struct NidKey
+            {
+                uint64_t Low;
+                uint64_t High;
+
+                bool operator==(const NidKey& p_Other) const { return Low == p_Other.Low && High == p_Other.High; }
+            };
+
+            struct NidKeyHash
+            {
+                uint64_t operator()(const NidKey& p_Key) const { return Utils::HashMix64(p_Key.Low ^ Utils::HashMix64(p_Key.High)); }
+            };
+
+            struct ModuleIndex
+            {
+                uint64_t RelocBase;
+                uint64_t Relocations;
+                uint64_t RelocationsSize;
+
+                // NID -> relocbase + r_offset
+                Utils::HashMap<NidKey, uint64_t, NidKeyHash> Jmpslots;
+
+                ModuleIndex() : RelocBase(0), Relocations(0), RelocationsSize(0), Jmpslots(Utils::MemoryTag_Substitute) { }
+            };
+
+            struct ProcessIndex
+            {
+                // dynlib object -> index
+                Utils::HashMap<uint64_t, ModuleIndex*> Modules;
+
+                ProcessIndex() : Modules(Utils::MemoryTag_Substitute) { }
+            };
+
+            Utils::HashMap<struct proc*, ProcessIndex*> m_Processes;
+            struct mtx m_Mutex;
+
+        public:
+            JmpslotCache();
+            ~JmpslotCache();
+
+            // Returns the jmpslot address importing p_Nid in p_DynlibObject, or 0
+            uint64_t Find(struct proc* p_Process, uint64_t p_DynlibObject, const char* p_Nid);
+
+            // Drops every index built for p_Process
+            void RemoveProcess(struct proc* p_Process);
+
+            void Clear();
+
+        private:
+            static bool GetKey(const char* p_Nid, NidKey& p_OutKey);
+            static bool GetRelocations(uint64_t p_DynlibObject, uint64_t& p_OutRelocBase, uint64_t& p_OutRelocations, uint64_t& p_OutRelocationsSize);
+            static ModuleIndex* Build(uint64_t p_DynlibObject);
+            static void DestroyProcess(ProcessIndex* p_Process);
+        };
+    }
+}
@@ -0,0 +1,183 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "NidDatabase.hpp"
+#include <Utils/Kdlsym.hpp>
+#include <Utils/Kernel.hpp>
+#include <Utils/HashMap.hpp>
+
+using namespace Mira::Plugins;
+
+#include "NidDatabaseTable.hpp"
+
+NidDatabase::NidDatabase() :
+    m_CacheCount(0),
+    m_UseCounter(0)
+{
+    auto mtx_init = (void(*)(struct mtx *m, const char *name, const char *type, int opts))kdlsym(mtx_init);
+
+    memset(m_Cache, 0, sizeof(m_Cache));
+
+    mtx_init(&m_Mutex, "SubNidCache", nullptr, MTX_DEF);
+}
+
+NidDatabase::~NidDatabase()
+{
+    auto mtx_destroy = (void(*)(struct mtx *))kdlsym(mtx_destroy);
+
+    mtx_destroy(&m_Mutex);
+}
+
+bool NidDatabase::GetNid(const char* p_Name, char* p_OutNid)
+{
+    auto name_to_nids = (void(*)(const char *name, const char *nids_out))kdlsym(name_to_nids);
+
+    if (p_Name == nullptr || p_Name[0] == '\0' || p_OutNid == nullptr)
+        return false;
+
+    auto s_TableNid = FindInTable(p_Name);
+    if (s_TableNid != nullptr)
+    {
+        memcpy(p_OutNid, s_TableNid, NidDatabase_NidSize);
+        return true;
+    }
+
+    auto s_NameHash = Utils::StringHash()(p_Name);
+    if (FindInCache(p_Name, s_NameHash, p_OutNid))
+        return true;
+
+    // name_to_nids writes the 11 characters without touching the rest
+    char s_Nid[NidDatabase_NidSize + 1] = { 0 };
+    name_to_nids(p_Name, s_Nid);
+    s_Nid[NidDatabase_NidSize - 1] = '\0';
+
+    AddToCache(p_Name, s_NameHash, s_Nid);
+
+    memcpy(p_OutNid, s_Nid, NidDatabase_NidSize);
+    return true;
+}
+
+const char* NidDatabase::FindInTable(const char* p_Name)
+{
+    if (p_Name == nullptr)
+        return nullptr;
+
+    int32_t s_Low = 0;
+    int32_t s_High = static_cast<int32_t>(ARRAYSIZE(s_NidTableEntries)) - 1;
+    while (s_Low <= s_High)
+    {
+        auto l_Middle = s_Low + ((s_High - s_Low) / 2);
+        auto& l_Entry = s_NidTableEntries[l_Middle];
+
+        auto l_Result = Compare(p_Name, &s_NidTableNames[l_Entry.NameOffset]);
+        if (l_Result == 0)
+            return l_Entry.Nid;
+
+        if (l_Result < 0)
+            s_High = l_Middle - 1;
+        else
+            s_Low = l_Middle + 1;
+    }
+
+    return nullptr;
+}
+
+void NidDatabase::ClearCache()
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    memset(m_Cache, 0, sizeof(m_Cache));
+    m_CacheCount = 0;
+    m_UseCounter = 0;
+    _mtx_unlock_flags(&m_Mutex, 0);
+}
+
+bool NidDatabase::FindInCache(const char* p_Name, uint64_t p_NameHash, char* p_OutNid)
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    bool s_Found = false;
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    for (uint32_t l_Index = 0; l_Index < m_CacheCount; ++l_Index)
+    {
+        auto& l_Entry = m_Cache[l_Index];
+        if (l_Entry.NameHash != p_NameHash || Compare(l_Entry.Name, p_Name) != 0)
+            continue;
+
+        l_Entry.LastUse = ++m_UseCounter;
+        memcpy(p_OutNid, l_Entry.Nid, NidDatabase_NidSize);
+        s_Found = true;
+        break;
+    }
+    _mtx_unlock_flags(&m_Mutex, 0);
+
+    return s_Found;
+}
+
+void NidDatabase::AddToCache(const char* p_Name, uint64_t p_NameHash, const char* p_Nid)
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    uint32_t s_NameLength = 0;
+    while (p_Name[s_NameLength] != '\0')
+    {
+        if (++s_NameLength > NidDatabase_MaxCachedNameLength)
+            return;
+    }
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    do
+    {
+        // Another thread may have added it while this one was hashing
+        bool s_Exists = false;
+        for (uint32_t l_Index = 0; l_Index < m_CacheCount; ++l_Index)
+        {
+            if (m_Cache[l_Index].NameHash == p_NameHash && Compare(m_Cache[l_Index].Name, p_Name) == 0)
+            {
+                s_Exists = true;
+                break;
+            }
+        }
+
+        if (s_Exists)
+            break;
+
+        // Take a free slot, or evict the least recently used one
+        uint32_t s_Slot = m_CacheCount;
+        if (m_CacheCount < NidDatabase_CacheCount)
+            m_CacheCount++;
+        else
+        {
+            s_Slot = 0;
+            for (uint32_t l_Index = 1; l_Index < NidDatabase_CacheCount; ++l_Index)
+            {
+                if (m_Cache[l_Index].LastUse < m_Cache[s_Slot].LastUse)
+                    s_Slot = l_Index;
+            }
+        }
+
+        auto& s_Entry = m_Cache[s_Slot];
+        s_Entry.NameHash = p_NameHash;
+        s_Entry.LastUse = ++m_UseCounter;
+        memcpy(s_Entry.Name, p_Name, s_NameLength + 1);
+        memcpy(s_Entry.Nid, p_Nid, NidDatabase_NidSize);
+    } while (false);
+    _mtx_unlock_flags(&m_Mutex, 0);
+}
+
+int32_t NidDatabase::Compare(const char* p_Left, const char* p_Right)
+{
+    // Byte order, same as the generator sorts in
+    while (*p_Left != '\0' && *p_Left == *p_Right)
+    {
+        ++p_Left;
+        ++p_Right;
+    }
+
+    return static_cast<int32_t>(static_cast<uint8_t>(*p_Left)) - static_cast<int32_t>(static_cast<uint8_t>(*p_Right));
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <Utils/Types.hpp>
+
+extern "C"
+{
+    #include <sys/param.h>
+    #include <sys/lock.h>
+    #include <sys/mutex.h>
+};
+
+namespace Mira
+{
+    namespace Plugins
+    {
+        enum
+        {
+            // 11 base64 characters and the terminator
+            NidDatabase_NidSize = 12,
+
+            // Names resolved with name_to_nids that are kept around
+            NidDatabase_CacheCount = 64,
+
+            // Longer names are resolved every time instead of being cached
+            NidDatabase_MaxCachedNameLength = 63,
+        };
+
+        /*
+            NidDatabase
+
+            Name -> NID lookup for the name based Substitute hooks. Names listed in NidSymbols.txt are
+            binary searched in a table generated by scripts/generate_nid_table.py, anything else is
+            hashed by the kernel's name_to_nids once and then kept in a small LRU cache.
+        */
+        class NidDatabase
+        {
+        public:
+            struct TableEntry
+            {
+                uint32_t NameOffset;
+                char Nid[NidDatabase_NidSize];
+            };
+
+        private:
+            struct CacheEntry
+            {
+                uint64_t NameHash;
+                uint64_t LastUse;
+                char Name[NidDatabase_MaxCachedNameLength + 1];
+                char Nid[NidDatabase_NidSize];
+            };
+
+            CacheEntry m_Cache[NidDatabase_CacheCount];
+            uint32_t m_CacheCount;
+            uint64_t m_UseCounter;
+
+            struct mtx m_Mutex;
+
+        public:
+            NidDatabase();
+            ~NidDatabase();
+
+            // Writes the null terminated NID of p_Name to p_OutNid, which must hold NidDatabase_NidSize bytes
+            bool GetNid(const char* p_Name, char* p_OutNid);
+
+            // Returns the NID of p_Name from the generated table, or nullptr if it is not in there
+            static const char* FindInTable(const char* p_Name);
+
+            void ClearCache();
+
+        private:
+            bool FindInCache(const char* p_Name, uint64_t p_NameHash, char* p_OutNid);
+            void AddToCache(const char* p_Name, uint64_t p_NameHash, const char* p_Nid);
+
+            static int32_t Compare(const char* p_Left, const char* p_Right);
+        };
+    }
+}
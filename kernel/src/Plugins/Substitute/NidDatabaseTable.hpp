@@ -0,0 +1,891 @@
+// Generated by scripts/generate_nid_table.py from NidSymbols.txt, do not edit
+#pragma once
+
+static const char s_NidTableNames[] =
+    "_ZdaPv\0"
+    "_ZdlPv\0"
+    "_Znam\0"
+    "_Znwm\0"
+    "__cxa_atexit\0"
+    "__cxa_finalize\0"
+    "__cxa_guard_abort\0"
+    "__cxa_guard_acquire\0"
+    "__cxa_guard_release\0"
+    "__cxa_pure_virtual\0"
+    "__error\0"
+    "__stack_chk_fail\0"
+    "__stack_chk_guard\0"
+    "__tls_get_addr\0"
+    "_exit\0"
+    "_init_env\0"
+    "_start\0"
+    "abort\0"
+    "abs\0"
+    "accept\0"
+    "access\0"
+    "acos\0"
+    "acosf\0"
+    "aligned_alloc\0"
+    "asctime\0"
+    "asin\0"
+    "asinf\0"
+    "atan\0"
+    "atan2\0"
+    "atan2f\0"
+    "atanf\0"
+    "atexit\0"
+    "atof\0"
+    "atoi\0"
+    "atol\0"
+    "atoll\0"
+    "bind\0"
+    "bsearch\0"
+    "calloc\0"
+    "cbrt\0"
+    "cbrtf\0"
+    "ceil\0"
+    "ceilf\0"
+    "chdir\0"
+    "clearerr\0"
+    "clock\0"
+    "clock_gettime\0"
+    "close\0"
+    "connect\0"
+    "copysign\0"
+    "copysignf\0"
+    "cos\0"
+    "cosf\0"
+    "cosh\0"
+    "ctime\0"
+    "difftime\0"
+    "div\0"
+    "dup\0"
+    "dup2\0"
+    "exit\0"
+    "exp\0"
+    "exp2\0"
+    "exp2f\0"
+    "expf\0"
+    "fabs\0"
+    "fabsf\0"
+    "fclose\0"
+    "fcntl\0"
+    "feof\0"
+    "ferror\0"
+    "fflush\0"
+    "fgetc\0"
+    "fgetpos\0"
+    "fgets\0"
+    "floor\0"
+    "floorf\0"
+    "fmax\0"
+    "fmaxf\0"
+    "fmin\0"
+    "fminf\0"
+    "fmod\0"
+    "fmodf\0"
+    "fopen\0"
+    "fprintf\0"
+    "fputc\0"
+    "fputs\0"
+    "fread\0"
+    "free\0"
+    "freopen\0"
+    "frexp\0"
+    "fscanf\0"
+    "fseek\0"
+    "fsetpos\0"
+    "fstat\0"
+    "ftell\0"
+    "fwrite\0"
+    "getc\0"
+    "getchar\0"
+    "getcwd\0"
+    "getenv\0"
+    "getpagesize\0"
+    "getpid\0"
+    "getppid\0"
+    "getsockopt\0"
+    "gettimeofday\0"
+    "gmtime\0"
+    "gmtime_r\0"
+    "hypot\0"
+    "hypotf\0"
+    "ioctl\0"
+    "isalnum\0"
+    "isalpha\0"
+    "iscntrl\0"
+    "isdigit\0"
+    "isgraph\0"
+    "islower\0"
+    "isprint\0"
+    "ispunct\0"
+    "isspace\0"
+    "isupper\0"
+    "isxdigit\0"
+    "kevent\0"
+    "kqueue\0"
+    "labs\0"
+    "ldexp\0"
+    "ldiv\0"
+    "listen\0"
+    "llabs\0"
+    "llround\0"
+    "localtime\0"
+    "localtime_r\0"
+    "log\0"
+    "log10\0"
+    "log10f\0"
+    "log2\0"
+    "log2f\0"
+    "logf\0"
+    "longjmp\0"
+    "lround\0"
+    "lroundf\0"
+    "lseek\0"
+    "malloc\0"
+    "malloc_usable_size\0"
+    "mblen\0"
+    "mbstowcs\0"
+    "mbtowc\0"
+    "memalign\0"
+    "memchr\0"
+    "memcmp\0"
+    "memcpy\0"
+    "memmove\0"
+    "memset\0"
+    "mkdir\0"
+    "mktime\0"
+    "mmap\0"
+    "modf\0"
+    "modff\0"
+    "module_start\0"
+    "module_stop\0"
+    "mprotect\0"
+    "munmap\0"
+    "nanosleep\0"
+    "nearbyint\0"
+    "open\0"
+    "perror\0"
+    "pipe\0"
+    "poll\0"
+    "posix_memalign\0"
+    "pow\0"
+    "powf\0"
+    "printf\0"
+    "pthread_attr_destroy\0"
+    "pthread_attr_getstacksize\0"
+    "pthread_attr_init\0"
+    "pthread_attr_setdetachstate\0"
+    "pthread_attr_setstacksize\0"
+    "pthread_cond_broadcast\0"
+    "pthread_cond_destroy\0"
+    "pthread_cond_init\0"
+    "pthread_cond_signal\0"
+    "pthread_cond_timedwait\0"
+    "pthread_cond_wait\0"
+    "pthread_create\0"
+    "pthread_detach\0"
+    "pthread_equal\0"
+    "pthread_exit\0"
+    "pthread_getspecific\0"
+    "pthread_getthreadid_np\0"
+    "pthread_join\0"
+    "pthread_key_create\0"
+    "pthread_key_delete\0"
+    "pthread_mutex_destroy\0"
+    "pthread_mutex_init\0"
+    "pthread_mutex_lock\0"
+    "pthread_mutex_trylock\0"
+    "pthread_mutex_unlock\0"
+    "pthread_mutexattr_destroy\0"
+    "pthread_mutexattr_init\0"
+    "pthread_mutexattr_settype\0"
+    "pthread_once\0"
+    "pthread_rwlock_destroy\0"
+    "pthread_rwlock_init\0"
+    "pthread_rwlock_rdlock\0"
+    "pthread_rwlock_unlock\0"
+    "pthread_rwlock_wrlock\0"
+    "pthread_self\0"
+    "pthread_setname_np\0"
+    "pthread_setspecific\0"
+    "pthread_yield\0"
+    "putc\0"
+    "putchar\0"
+    "puts\0"
+    "qsort\0"
+    "raise\0"
+    "rand\0"
+    "read\0"
+    "realloc\0"
+    "recv\0"
+    "recvfrom\0"
+    "remove\0"
+    "rename\0"
+    "rewind\0"
+    "rint\0"
+    "rintf\0"
+    "rmdir\0"
+    "round\0"
+    "roundf\0"
+    "scanf\0"
+    "sceKernelAddUserEvent\0"
+    "sceKernelAllocateDirectMemory\0"
+    "sceKernelChmod\0"
+    "sceKernelClearEventFlag\0"
+    "sceKernelClockGettime\0"
+    "sceKernelClose\0"
+    "sceKernelCreateEqueue\0"
+    "sceKernelCreateEventFlag\0"
+    "sceKernelCreateSema\0"
+    "sceKernelDebugOutText\0"
+    "sceKernelDeleteEqueue\0"
+    "sceKernelDeleteEventFlag\0"
+    "sceKernelDeleteSema\0"
+    "sceKernelDlsym\0"
+    "sceKernelFstat\0"
+    "sceKernelFsync\0"
+    "sceKernelFtruncate\0"
+    "sceKernelGetCompiledSdkVersion\0"
+    "sceKernelGetCpumode\0"
+    "sceKernelGetCurrentCpu\0"
+    "sceKernelGetDirectMemorySize\0"
+    "sceKernelGetModuleInfo\0"
+    "sceKernelGetModuleInfoFromAddr\0"
+    "sceKernelGetModuleList\0"
+    "sceKernelGetProcParam\0"
+    "sceKernelGetProcessTime\0"
+    "sceKernelGetProcessTimeCounter\0"
+    "sceKernelGetProcessTimeCounterFrequency\0"
+    "sceKernelGetSystemSwVersion\0"
+    "sceKernelGetTscFrequency\0"
+    "sceKernelGetdents\0"
+    "sceKernelGetdirentries\0"
+    "sceKernelGettimeofday\0"
+    "sceKernelIsNeoMode\0"
+    "sceKernelLoadStartModule\0"
+    "sceKernelLseek\0"
+    "sceKernelMapDirectMemory\0"
+    "sceKernelMapFlexibleMemory\0"
+    "sceKernelMapNamedDirectMemory\0"
+    "sceKernelMapNamedFlexibleMemory\0"
+    "sceKernelMkdir\0"
+    "sceKernelMmap\0"
+    "sceKernelMprotect\0"
+    "sceKernelMunmap\0"
+    "sceKernelNanosleep\0"
+    "sceKernelOpen\0"
+    "sceKernelPollSema\0"
+    "sceKernelPread\0"
+    "sceKernelPwrite\0"
+    "sceKernelQueryMemoryProtection\0"
+    "sceKernelRead\0"
+    "sceKernelReadTsc\0"
+    "sceKernelReleaseDirectMemory\0"
+    "sceKernelReleaseFlexibleMemory\0"
+    "sceKernelRename\0"
+    "sceKernelRmdir\0"
+    "sceKernelSetEventFlag\0"
+    "sceKernelSignalSema\0"
+    "sceKernelSleep\0"
+    "sceKernelStat\0"
+    "sceKernelStopUnloadModule\0"
+    "sceKernelTriggerUserEvent\0"
+    "sceKernelTruncate\0"
+    "sceKernelUnlink\0"
+    "sceKernelUsleep\0"
+    "sceKernelVirtualQuery\0"
+    "sceKernelWaitEqueue\0"
+    "sceKernelWaitEventFlag\0"
+    "sceKernelWaitSema\0"
+    "sceKernelWrite\0"
+    "scePthreadAttrDestroy\0"
+    "scePthreadAttrGet\0"
+    "scePthreadAttrGetstacksize\0"
+    "scePthreadAttrInit\0"
+    "scePthreadAttrSetaffinity\0"
+    "scePthreadAttrSetdetachstate\0"
+    "scePthreadAttrSetinheritsched\0"
+    "scePthreadAttrSetschedparam\0"
+    "scePthreadAttrSetstacksize\0"
+    "scePthreadCancel\0"
+    "scePthreadCondBroadcast\0"
+    "scePthreadCondDestroy\0"
+    "scePthreadCondInit\0"
+    "scePthreadCondSignal\0"
+    "scePthreadCondTimedwait\0"
+    "scePthreadCondWait\0"
+    "scePthreadCondattrDestroy\0"
+    "scePthreadCondattrInit\0"
+    "scePthreadCreate\0"
+    "scePthreadDetach\0"
+    "scePthreadEqual\0"
+    "scePthreadExit\0"
+    "scePthreadGetaffinity\0"
+    "scePthreadGetprio\0"
+    "scePthreadGetspecific\0"
+    "scePthreadGetthreadid\0"
+    "scePthreadJoin\0"
+    "scePthreadKeyCreate\0"
+    "scePthreadKeyDelete\0"
+    "scePthreadMutexDestroy\0"
+    "scePthreadMutexInit\0"
+    "scePthreadMutexLock\0"
+    "scePthreadMutexTimedlock\0"
+    "scePthreadMutexTrylock\0"
+    "scePthreadMutexUnlock\0"
+    "scePthreadMutexattrDestroy\0"
+    "scePthreadMutexattrInit\0"
+    "scePthreadMutexattrSetprotocol\0"
+    "scePthreadMutexattrSettype\0"
+    "scePthreadOnce\0"
+    "scePthreadRename\0"
+    "scePthreadRwlockDestroy\0"
+    "scePthreadRwlockInit\0"
+    "scePthreadRwlockRdlock\0"
+    "scePthreadRwlockUnlock\0"
+    "scePthreadRwlockWrlock\0"
+    "scePthreadSelf\0"
+    "scePthreadSetaffinity\0"
+    "scePthreadSetprio\0"
+    "scePthreadSetspecific\0"
+    "scePthreadYield\0"
+    "sceSysmoduleIsLoaded\0"
+    "sceSysmoduleLoadModule\0"
+    "sceSysmoduleLoadModuleInternal\0"
+    "sceSysmoduleLoadModuleInternalWithArg\0"
+    "sceSysmodulePreloadModuleForLibkernel\0"
+    "sceSysmoduleUnloadModule\0"
+    "sceSysmoduleUnloadModuleInternal\0"
+    "select\0"
+    "send\0"
+    "sendto\0"
+    "setbuf\0"
+    "setjmp\0"
+    "setsockopt\0"
+    "setvbuf\0"
+    "shutdown\0"
+    "signal\0"
+    "sin\0"
+    "sinf\0"
+    "sinh\0"
+    "sleep\0"
+    "snprintf\0"
+    "socket\0"
+    "sprintf\0"
+    "sqrt\0"
+    "sqrtf\0"
+    "srand\0"
+    "sscanf\0"
+    "stat\0"
+    "strcasecmp\0"
+    "strcat\0"
+    "strchr\0"
+    "strcmp\0"
+    "strcoll\0"
+    "strcpy\0"
+    "strcspn\0"
+    "strdup\0"
+    "strerror\0"
+    "strerror_r\0"
+    "strftime\0"
+    "strlen\0"
+    "strncasecmp\0"
+    "strncat\0"
+    "strncmp\0"
+    "strncpy\0"
+    "strndup\0"
+    "strnlen\0"
+    "strpbrk\0"
+    "strrchr\0"
+    "strspn\0"
+    "strstr\0"
+    "strtod\0"
+    "strtof\0"
+    "strtok\0"
+    "strtok_r\0"
+    "strtol\0"
+    "strtoll\0"
+    "strtoul\0"
+    "strtoull\0"
+    "strxfrm\0"
+    "sysctl\0"
+    "sysctlbyname\0"
+    "system\0"
+    "tan\0"
+    "tanf\0"
+    "tanh\0"
+    "time\0"
+    "tmpfile\0"
+    "tmpnam\0"
+    "tolower\0"
+    "toupper\0"
+    "trunc\0"
+    "truncf\0"
+    "ungetc\0"
+    "unlink\0"
+    "usleep\0"
+    "vfprintf\0"
+    "vprintf\0"
+    "vsnprintf\0"
+    "vsprintf\0"
+    "vsscanf\0"
+    "wcscat\0"
+    "wcschr\0"
+    "wcscmp\0"
+    "wcscpy\0"
+    "wcslen\0"
+    "wcsncmp\0"
+    "wcsncpy\0"
+    "wcstombs\0"
+    "wctomb\0"
+    "wmemcpy\0"
+    "wmemset\0"
+    "write\0"
+;
+
+static const NidDatabase::TableEntry s_NidTableEntries[] =
+{
+    { 0x00000, "MLWl90SFWNE" }, // _ZdaPv
+    { 0x00007, "z+P+xCnWLBk" }, // _ZdlPv
+    { 0x0000E, "hdm0YfMa7TQ" }, // _Znam
+    { 0x00014, "fJnpuVVBbKk" }, // _Znwm
+    { 0x0001A, "tsvEmnenz48" }, // __cxa_atexit
+    { 0x00027, "H2e8t5ScQGc" }, // __cxa_finalize
+    { 0x00036, "2emaaluWzUw" }, // __cxa_guard_abort
+    { 0x00048, "3GPpjQdAMTw" }, // __cxa_guard_acquire
+    { 0x0005C, "9rAeANT2tyE" }, // __cxa_guard_release
+    { 0x00070, "zr094EQ39Ww" }, // __cxa_pure_virtual
+    { 0x00083, "9BcDykPmo1I" }, // __error
+    { 0x0008B, "Ou3iL1abvng" }, // __stack_chk_fail
+    { 0x0009C, "f7uOxY9mM1U" }, // __stack_chk_guard
+    { 0x000AE, "vNe1w4diLCs" }, // __tls_get_addr
+    { 0x000BD, "6Z83sYWFlA8" }, // _exit
+    { 0x000C3, "bzQExy189ZI" }, // _init_env
+    { 0x000CD, "u--QHVc2dGI" }, // _start
+    { 0x000D4, "L1SBTkC+Cvw" }, // abort
+    { 0x000DA, "Ye20uNnlglA" }, // abs
+    { 0x000DE, "3e+4Iv7IJ8U" }, // accept
+    { 0x000E5, "8vE6Z6VEYyk" }, // access
+    { 0x000EC, "JBcgYuW8lPU" }, // acos
+    { 0x000F1, "QI-x0SL8jhw" }, // acosf
+    { 0x000F7, "2Btkg8k24Zg" }, // aligned_alloc
+    { 0x00105, "jT3xiGpA3B4" }, // asctime
+    { 0x0010D, "7Ly52zaL44Q" }, // asin
+    { 0x00112, "GZWjF-YIFFk" }, // asinf
+    { 0x00118, "OXmauLdQ8kY" }, // atan
+    { 0x0011D, "HUbZmOnT-Dg" }, // atan2
+    { 0x00123, "EH-x713A99c" }, // atan2f
+    { 0x0012A, "weDug8QD-lE" }, // atanf
+    { 0x00130, "8G2LB+A3rzg" }, // atexit
+    { 0x00137, "SRI6S9B+-a4" }, // atof
+    { 0x0013C, "fPxypibz2MY" }, // atoi
+    { 0x00141, "+my9jdHCMIQ" }, // atol
+    { 0x00146, "fLcU5G6Qrjs" }, // atoll
+    { 0x0014C, "KuOmgKoqCdY" }, // bind
+    { 0x00151, "NesIgTmfF0Q" }, // bsearch
+    { 0x00159, "2X5agFjKxMc" }, // calloc
+    { 0x00160, "5ZkEP3Rq7As" }, // cbrt
+    { 0x00165, "GlelR9EEeck" }, // cbrtf
+    { 0x0016B, "gacfOmO8hNs" }, // ceil
+    { 0x00170, "GAUuLKGhsCw" }, // ceilf
+    { 0x00176, "6mMQ1MSPW-Q" }, // chdir
+    { 0x0017C, "St9nbxSoezk" }, // clearerr
+    { 0x00185, "QZP6I9ZZxpE" }, // clock
+    { 0x0018B, "lLMT9vJAck0" }, // clock_gettime
+    { 0x00199, "bY-PO6JhzhQ" }, // close
+    { 0x0019F, "XVL8So3QJUk" }, // connect
+    { 0x001A7, "BEFy1ZFv8Fw" }, // copysign
+    { 0x001B0, "x-04iOzl1xs" }, // copysignf
+    { 0x001BA, "2WE3BTYVwKM" }, // cos
+    { 0x001BE, "-P6FNMzk2Kc" }, // cosf
+    { 0x001C3, "m7iLTaO9RMs" }, // cosh
+    { 0x001C8, "0uAUs3hYuG4" }, // ctime
+    { 0x001CE, "-VVn74ZyhEs" }, // difftime
+    { 0x001D7, "2gbcltk3swE" }, // div
+    { 0x001DB, "iiQjzvfWDq0" }, // dup
+    { 0x001DF, "wdUufa9g-D8" }, // dup2
+    { 0x001E4, "uMei1W9uyNo" }, // exit
+    { 0x001E9, "NVadfnzQhHQ" }, // exp
+    { 0x001ED, "dnaeGXbjP6E" }, // exp2
+    { 0x001F2, "wuAQt-j+p4o" }, // exp2f
+    { 0x001F8, "8zsu04XNsZ4" }, // expf
+    { 0x001FD, "388LcMWHRCA" }, // fabs
+    { 0x00202, "fmT2cjPoWBs" }, // fabsf
+    { 0x00208, "uodLYyUip20" }, // fclose
+    { 0x0020F, "8nY19bKoiZk" }, // fcntl
+    { 0x00215, "LxcEU+ICu8U" }, // feof
+    { 0x0021A, "AHxyhN96dy4" }, // ferror
+    { 0x00221, "MUjC4lbHrK4" }, // fflush
+    { 0x00228, "AEuF3F2f8TA" }, // fgetc
+    { 0x0022E, "SHlt7EhOtqA" }, // fgetpos
+    { 0x00236, "KdP-nULpuGw" }, // fgets
+    { 0x0023C, "mpcTgMzhUY8" }, // floor
+    { 0x00242, "mKhVDmYciWA" }, // floorf
+    { 0x00249, "fiOgmWkP+Xc" }, // fmax
+    { 0x0024E, "Lyx2DzUL7Lc" }, // fmaxf
+    { 0x00254, "iU0z6SdUNbI" }, // fmin
+    { 0x00259, "uVRcM2yFdP4" }, // fminf
+    { 0x0025F, "pKwslsMUmSk" }, // fmod
+    { 0x00264, "88Vv-AzHVj8" }, // fmodf
+    { 0x0026A, "xeYO4u7uyJ0" }, // fopen
+    { 0x00270, "fffwELXNVFA" }, // fprintf
+    { 0x00278, "aZK8lNei-Qw" }, // fputc
+    { 0x0027E, "QrZZdJ8XsX0" }, // fputs
+    { 0x00284, "lbB+UlZqVG0" }, // fread
+    { 0x0028A, "tIhsqj0qsFE" }, // free
+    { 0x0028F, "gkWgn0p1AfU" }, // freopen
+    { 0x00297, "kA-TdiOCsaY" }, // frexp
+    { 0x0029D, "npLpPTaSuHg" }, // fscanf
+    { 0x002A4, "rQFVBXp-Cxg" }, // fseek
+    { 0x002AA, "7PkSz+qnTto" }, // fsetpos
+    { 0x002B2, "mqQMh1zPPT8" }, // fstat
+    { 0x002B8, "Qazy8LmXTvw" }, // ftell
+    { 0x002BE, "MpxhMh8QFro" }, // fwrite
+    { 0x002C5, "8Q60JLJ6Rv4" }, // getc
+    { 0x002CA, "L3XZiuKqZUM" }, // getchar
+    { 0x002D2, "DYivN1nO-JQ" }, // getcwd
+    { 0x002D9, "smbQukfxYJM" }, // getenv
+    { 0x002E0, "k+AXqu2-eBc" }, // getpagesize
+    { 0x002EC, "HoLVWNanBBc" }, // getpid
+    { 0x002F3, "e6ovBo9ZvJc" }, // getppid
+    { 0x002FB, "6O8EwYOgH9Y" }, // getsockopt
+    { 0x00306, "n88vx3C5nW8" }, // gettimeofday
+    { 0x00313, "1mecP7RgI2A" }, // gmtime
+    { 0x0031A, "IJ3uNKef29s" }, // gmtime_r
+    { 0x00323, "YFoOw5GkkK0" }, // hypot
+    { 0x00329, "iz2shAGFIxc" }, // hypotf
+    { 0x00330, "PfccT7qURYE" }, // ioctl
+    { 0x00336, "4uJJNi+C9wk" }, // isalnum
+    { 0x0033E, "+xU0WKT8mDc" }, // isalpha
+    { 0x00346, "akpGErA1zdg" }, // iscntrl
+    { 0x0034E, "JWBr5N8zyNE" }, // isdigit
+    { 0x00356, "rrgxakQtvc0" }, // isgraph
+    { 0x0035E, "KqYTqtSfGos" }, // islower
+    { 0x00366, "eGkOpTojJl4" }, // isprint
+    { 0x0036E, "I6Z-684E2C4" }, // ispunct
+    { 0x00376, "wazw2x2m3DQ" }, // isspace
+    { 0x0037E, "GcFKlTJEMkI" }, // isupper
+    { 0x00386, "srzSVSbKn7M" }, // isxdigit
+    { 0x0038F, "RW-GEfpnsqg" }, // kevent
+    { 0x00396, "nh2IFMgKTv8" }, // kqueue
+    { 0x0039D, "xzZiQgReRGE" }, // labs
+    { 0x003A2, "JrwFIMzKNr0" }, // ldexp
+    { 0x003A8, "gfP0im5Z3g0" }, // ldiv
+    { 0x003AD, "pxnCmagrtao" }, // listen
+    { 0x003B4, "rHRr+131ATY" }, // llabs
+    { 0x003BA, "w-BvXF4O6xo" }, // llround
+    { 0x003C2, "efhK-YSUYYQ" }, // localtime
+    { 0x003CC, "Vwp2xkMeMKA" }, // localtime_r
+    { 0x003D8, "rtV7-jWC6Yg" }, // log
+    { 0x003DC, "WuMbPBKN1TU" }, // log10
+    { 0x003E2, "lhpd6Wk6ccs" }, // log10f
+    { 0x003E9, "Y5DhuDKGlnQ" }, // log2
+    { 0x003EE, "hsi9drzHR2k" }, // log2f
+    { 0x003F4, "RQXLbdT2lc4" }, // logf
+    { 0x003F9, "lKEN2IebgJ0" }, // longjmp
+    { 0x00401, "J3XuGS-cC0Q" }, // lround
+    { 0x00408, "C6gWCWJKM+U" }, // lroundf
+    { 0x00410, "Oy6IpwgtYOk" }, // lseek
+    { 0x00416, "gQX+4GDQjpM" }, // malloc
+    { 0x0041D, "NDcSfcYZRC8" }, // malloc_usable_size
+    { 0x00430, "hew0fReI2H0" }, // mblen
+    { 0x00436, "VUzjXknPPBs" }, // mbstowcs
+    { 0x0043F, "6eU9xX9oEdQ" }, // mbtowc
+    { 0x00446, "Ujf3KzMvRmI" }, // memalign
+    { 0x0044F, "8u8lPzUEq+U" }, // memchr
+    { 0x00456, "DfivPArhucg" }, // memcmp
+    { 0x0045D, "Q3VBxCXhUHs" }, // memcpy
+    { 0x00464, "+P6FRGH4LfA" }, // memmove
+    { 0x0046C, "8zTFvBIAIN8" }, // memset
+    { 0x00473, "JGMio+21L4c" }, // mkdir
+    { 0x00479, "n7AepwR0s34" }, // mktime
+    { 0x00480, "BPE9s9vQQXo" }, // mmap
+    { 0x00485, "0WMHDb5Dt94" }, // modf
+    { 0x0048A, "3+UPM-9E6xY" }, // modff
+    { 0x00490, "BaOKcng8g88" }, // module_start
+    { 0x0049D, "KpDMrPHvt3Q" }, // module_stop
+    { 0x004A9, "YQOfxL4QfeU" }, // mprotect
+    { 0x004B2, "UqDGjXA5yUM" }, // munmap
+    { 0x004B9, "yS8U2TGCe1A" }, // nanosleep
+    { 0x004C3, "cJLTwtKGXJk" }, // nearbyint
+    { 0x004CD, "wuCroIGjt2g" }, // open
+    { 0x004D2, "EMutwaQ34Jo" }, // perror
+    { 0x004D9, "-Jp7F+pXxNg" }, // pipe
+    { 0x004DE, "ku7D4q1Y9PI" }, // poll
+    { 0x004E3, "cVSk9y8URbc" }, // posix_memalign
+    { 0x004F2, "9LCjpWyQ5Zc" }, // pow
+    { 0x004F6, "1D0H2KNjshE" }, // powf
+    { 0x004FB, "hcuQgD53UxM" }, // printf
+    { 0x00502, "zHchY8ft5pk" }, // pthread_attr_destroy
+    { 0x00517, "0qOtCR-ZHck" }, // pthread_attr_getstacksize
+    { 0x00531, "wtkt-teR1so" }, // pthread_attr_init
+    { 0x00543, "E+tyo3lp5Lw" }, // pthread_attr_setdetachstate
+    { 0x0055F, "2Q0z6rnBrTE" }, // pthread_attr_setstacksize
+    { 0x00579, "mkx2fVhNMsg" }, // pthread_cond_broadcast
+    { 0x00590, "RXXqi4CtF8w" }, // pthread_cond_destroy
+    { 0x005A5, "0TyVk4MSLt0" }, // pthread_cond_init
+    { 0x005B7, "2MOy+rUfuhQ" }, // pthread_cond_signal
+    { 0x005CB, "27bAgiJmOh0" }, // pthread_cond_timedwait
+    { 0x005E2, "Op8TBGY5KHg" }, // pthread_cond_wait
+    { 0x005F4, "OxhIB8LB-PQ" }, // pthread_create
+    { 0x00603, "+U1R4WtXvoc" }, // pthread_detach
+    { 0x00612, "7Xl257M4VNI" }, // pthread_equal
+    { 0x00620, "FJrT5LuUBAU" }, // pthread_exit
+    { 0x0062D, "0-KXaS70xy4" }, // pthread_getspecific
+    { 0x00641, "3eqs37G74-s" }, // pthread_getthreadid_np
+    { 0x00658, "h9CcP3J0oVM" }, // pthread_join
+    { 0x00665, "mqULNdimTn0" }, // pthread_key_create
+    { 0x00678, "6BpEZuDT7YI" }, // pthread_key_delete
+    { 0x0068B, "ltCfaGr2JGE" }, // pthread_mutex_destroy
+    { 0x006A1, "ttHNfU+qDBU" }, // pthread_mutex_init
+    { 0x006B4, "7H0iTOciTLo" }, // pthread_mutex_lock
+    { 0x006C7, "K-jXhbt2gn4" }, // pthread_mutex_trylock
+    { 0x006DD, "2Z+PpY6CaJg" }, // pthread_mutex_unlock
+    { 0x006F2, "HF7lK46xzjY" }, // pthread_mutexattr_destroy
+    { 0x0070C, "dQHWEsJtoE4" }, // pthread_mutexattr_init
+    { 0x00723, "mDmgMOGVUqg" }, // pthread_mutexattr_settype
+    { 0x0073D, "Z4QosVuAsA0" }, // pthread_once
+    { 0x0074A, "1471ajPzxh0" }, // pthread_rwlock_destroy
+    { 0x00761, "ytQULN-nhL4" }, // pthread_rwlock_init
+    { 0x00775, "iGjsr1WAtI0" }, // pthread_rwlock_rdlock
+    { 0x0078B, "EgmLo6EWgso" }, // pthread_rwlock_unlock
+    { 0x007A1, "sIlRvQqsN2Y" }, // pthread_rwlock_wrlock
+    { 0x007B7, "EotR8a3ASf4" }, // pthread_self
+    { 0x007C4, "cB4rMoKU4UI" }, // pthread_setname_np
+    { 0x007D7, "WrOLvHU0yQM" }, // pthread_setspecific
+    { 0x007EB, "B5GmVDKwpn0" }, // pthread_yield
+    { 0x007F9, "tLB5+4TEOK0" }, // putc
+    { 0x007FE, "m5wN+SwZOR4" }, // putchar
+    { 0x00806, "YQ0navp+YIc" }, // puts
+    { 0x0080B, "AEJdIVZTEmo" }, // qsort
+    { 0x00811, "0t0-MxQNwK4" }, // raise
+    { 0x00817, "cpCOXWMgha0" }, // rand
+    { 0x0081C, "AqBioC2vF3I" }, // read
+    { 0x00821, "Y7aJ1uydPMo" }, // realloc
+    { 0x00829, "Ez8xjo9UF4E" }, // recv
+    { 0x0082E, "lUk6wrGXyMw" }, // recvfrom
+    { 0x00837, "MZO7FXyAPU8" }, // remove
+    { 0x0083E, "NN01qLRhiqU" }, // rename
+    { 0x00845, "3QIPIh-GDjw" }, // rewind
+    { 0x0084C, "LxGIYYKwKYc" }, // rint
+    { 0x00851, "q5WzucyVSkM" }, // rintf
+    { 0x00857, "c7ZnT7V1B98" }, // rmdir
+    { 0x0085D, "nlaojL9hDtA" }, // round
+    { 0x00863, "DDHG1a6+3q0" }, // roundf
+    { 0x0086A, "7XEv6NnznWw" }, // scanf
+    { 0x00870, "4R6-OvI2cEA" }, // sceKernelAddUserEvent
+    { 0x00886, "rTXw65xmLIA" }, // sceKernelAllocateDirectMemory
+    { 0x008A4, "fgIsQ10xYVA" }, // sceKernelChmod
+    { 0x008B3, "7uhBFWRAS60" }, // sceKernelClearEventFlag
+    { 0x008CB, "QBi7HCK03hw" }, // sceKernelClockGettime
+    { 0x008E1, "UK2Tl2DWUns" }, // sceKernelClose
+    { 0x008F0, "D0OdFMjp46I" }, // sceKernelCreateEqueue
+    { 0x00906, "BpFoboUJoZU" }, // sceKernelCreateEventFlag
+    { 0x0091F, "188x57JYp0g" }, // sceKernelCreateSema
+    { 0x00933, "9JYNqN6jAKI" }, // sceKernelDebugOutText
+    { 0x00949, "jpFjmgAC5AE" }, // sceKernelDeleteEqueue
+    { 0x0095F, "8mql9OcQnd4" }, // sceKernelDeleteEventFlag
+    { 0x00978, "R1Jvn8bSCW8" }, // sceKernelDeleteSema
+    { 0x0098C, "LwG8g3niqwA" }, // sceKernelDlsym
+    { 0x0099B, "kBwCPsYX-m4" }, // sceKernelFstat
+    { 0x009AA, "fTx66l5iWIA" }, // sceKernelFsync
+    { 0x009B9, "VW3TVZiM4-E" }, // sceKernelFtruncate
+    { 0x009CC, "WB66evu8bsU" }, // sceKernelGetCompiledSdkVersion
+    { 0x009EB, "VOx8NGmHXTs" }, // sceKernelGetCpumode
+    { 0x009FF, "g0VTBxfJyu0" }, // sceKernelGetCurrentCpu
+    { 0x00A16, "pO96TwzOm5E" }, // sceKernelGetDirectMemorySize
+    { 0x00A33, "kUpgrXIrz7Q" }, // sceKernelGetModuleInfo
+    { 0x00A4A, "f7KBOafysXo" }, // sceKernelGetModuleInfoFromAddr
+    { 0x00A69, "IuxnUuXk6Bg" }, // sceKernelGetModuleList
+    { 0x00A80, "959qrazPIrg" }, // sceKernelGetProcParam
+    { 0x00A96, "4J2sUJmuHZQ" }, // sceKernelGetProcessTime
+    { 0x00AAE, "fgxnMeTNUtY" }, // sceKernelGetProcessTimeCounter
+    { 0x00ACD, "BNowx2l588E" }, // sceKernelGetProcessTimeCounterFrequency
+    { 0x00AF5, "Mv1zUObHvXI" }, // sceKernelGetSystemSwVersion
+    { 0x00B11, "1j3S3n-tTW4" }, // sceKernelGetTscFrequency
+    { 0x00B2A, "j2AIqSqJP0w" }, // sceKernelGetdents
+    { 0x00B3C, "taRWhTJFTgE" }, // sceKernelGetdirentries
+    { 0x00B53, "ejekcaNQNq0" }, // sceKernelGettimeofday
+    { 0x00B69, "WslcK1FQcGI" }, // sceKernelIsNeoMode
+    { 0x00B7C, "wzvqT4UqKX8" }, // sceKernelLoadStartModule
+    { 0x00B95, "oib76F-12fk" }, // sceKernelLseek
+    { 0x00BA4, "L-Q3LEjIbgA" }, // sceKernelMapDirectMemory
+    { 0x00BBD, "IWIBBdTHit4" }, // sceKernelMapFlexibleMemory
+    { 0x00BD8, "NcaWUxfMNIQ" }, // sceKernelMapNamedDirectMemory
+    { 0x00BF6, "mL8NDH86iQI" }, // sceKernelMapNamedFlexibleMemory
+    { 0x00C16, "1-LFLmRFxxM" }, // sceKernelMkdir
+    { 0x00C25, "PGhQHd-dzv8" }, // sceKernelMmap
+    { 0x00C33, "vSMAm3cxYTY" }, // sceKernelMprotect
+    { 0x00C45, "cQke9UuBQOk" }, // sceKernelMunmap
+    { 0x00C55, "QvsZxomvUHs" }, // sceKernelNanosleep
+    { 0x00C68, "1G3lF1Gg1k8" }, // sceKernelOpen
+    { 0x00C76, "12wOHk8ywb0" }, // sceKernelPollSema
+    { 0x00C88, "+r3rMFwItV4" }, // sceKernelPread
+    { 0x00C97, "nKWi-N2HBV4" }, // sceKernelPwrite
+    { 0x00CA7, "WFcfL2lzido" }, // sceKernelQueryMemoryProtection
+    { 0x00CC6, "Cg4srZ6TKbU" }, // sceKernelRead
+    { 0x00CD4, "-2IRUCO--PM" }, // sceKernelReadTsc
+    { 0x00CE5, "MBuItvba6z8" }, // sceKernelReleaseDirectMemory
+    { 0x00D02, "teiItL2boFw" }, // sceKernelReleaseFlexibleMemory
+    { 0x00D21, "52NcYU9+lEo" }, // sceKernelRename
+    { 0x00D31, "naInUjYt3so" }, // sceKernelRmdir
+    { 0x00D40, "IOnSvHzqu6A" }, // sceKernelSetEventFlag
+    { 0x00D56, "4czppHBiriw" }, // sceKernelSignalSema
+    { 0x00D6A, "-ZR+hG7aDHw" }, // sceKernelSleep
+    { 0x00D79, "eV9wAD2riIA" }, // sceKernelStat
+    { 0x00D87, "QKd0qM58Qes" }, // sceKernelStopUnloadModule
+    { 0x00DA1, "F6e0kwo4cnk" }, // sceKernelTriggerUserEvent
+    { 0x00DBB, "WlyEA-sLDf0" }, // sceKernelTruncate
+    { 0x00DCD, "AUXVxWeJU-A" }, // sceKernelUnlink
+    { 0x00DDD, "1jfXLRVzisc" }, // sceKernelUsleep
+    { 0x00DED, "rVjRvHJ0X6c" }, // sceKernelVirtualQuery
+    { 0x00E03, "fzyMKs9kim0" }, // sceKernelWaitEqueue
+    { 0x00E17, "JTvBflhYazQ" }, // sceKernelWaitEventFlag
+    { 0x00E2E, "Zxa0VhQVTsk" }, // sceKernelWaitSema
+    { 0x00E40, "4wSze92BhLI" }, // sceKernelWrite
+    { 0x00E4F, "62KCwEMmzcM" }, // scePthreadAttrDestroy
+    { 0x00E65, "x1X76arYMxU" }, // scePthreadAttrGet
+    { 0x00E77, "-fA+7ZlGDQs" }, // scePthreadAttrGetstacksize
+    { 0x00E92, "nsYoNRywwNg" }, // scePthreadAttrInit
+    { 0x00EA5, "3qxgM4ezETA" }, // scePthreadAttrSetaffinity
+    { 0x00EBF, "-Wreprtu0Qs" }, // scePthreadAttrSetdetachstate
+    { 0x00EDC, "eXbUSpEaTsA" }, // scePthreadAttrSetinheritsched
+    { 0x00EFA, "DzES9hQF4f4" }, // scePthreadAttrSetschedparam
+    { 0x00F16, "UTXzJbWhhTE" }, // scePthreadAttrSetstacksize
+    { 0x00F31, "qBDmpCyGssE" }, // scePthreadCancel
+    { 0x00F42, "JGgj7Uvrl+A" }, // scePthreadCondBroadcast
+    { 0x00F5A, "g+PZd2hiacg" }, // scePthreadCondDestroy
+    { 0x00F70, "2Tb92quprl0" }, // scePthreadCondInit
+    { 0x00F83, "kDh-NfxgMtE" }, // scePthreadCondSignal
+    { 0x00F98, "BmMjYxmew1w" }, // scePthreadCondTimedwait
+    { 0x00FB0, "WKAXJ4XBPQ4" }, // scePthreadCondWait
+    { 0x00FC3, "waPcxYiR3WA" }, // scePthreadCondattrDestroy
+    { 0x00FDD, "m5-2bsNfv7s" }, // scePthreadCondattrInit
+    { 0x00FF4, "6UgtwV+0zb4" }, // scePthreadCreate
+    { 0x01005, "4qGrR6eoP9Y" }, // scePthreadDetach
+    { 0x01016, "3PtV6p3QNX4" }, // scePthreadEqual
+    { 0x01026, "3kg7rT0NQIs" }, // scePthreadExit
+    { 0x01035, "rcrVFJsQWRY" }, // scePthreadGetaffinity
+    { 0x0104B, "1tKyG7RlMJo" }, // scePthreadGetprio
+    { 0x0105D, "eoht7mQOCmo" }, // scePthreadGetspecific
+    { 0x01073, "EI-5-jlq2dE" }, // scePthreadGetthreadid
+    { 0x01089, "onNY9Byn-W8" }, // scePthreadJoin
+    { 0x01098, "geDaqgH9lTg" }, // scePthreadKeyCreate
+    { 0x010AC, "PrdHuuDekhY" }, // scePthreadKeyDelete
+    { 0x010C0, "2Of0f+3mhhE" }, // scePthreadMutexDestroy
+    { 0x010D7, "cmo1RIYva9o" }, // scePthreadMutexInit
+    { 0x010EB, "9UK1vLZQft4" }, // scePthreadMutexLock
+    { 0x010FF, "IafI2PxcPnQ" }, // scePthreadMutexTimedlock
+    { 0x01118, "upoVrzMHFeE" }, // scePthreadMutexTrylock
+    { 0x0112F, "tn3VlD0hG60" }, // scePthreadMutexUnlock
+    { 0x01145, "smWEktiyyG0" }, // scePthreadMutexattrDestroy
+    { 0x01160, "F8bUHwAG284" }, // scePthreadMutexattrInit
+    { 0x01178, "1FGvU0i9saQ" }, // scePthreadMutexattrSetprotocol
+    { 0x01197, "iMp8QpE+XO4" }, // scePthreadMutexattrSettype
+    { 0x011B2, "14bOACANTBo" }, // scePthreadOnce
+    { 0x011C1, "GBUY7ywdULE" }, // scePthreadRename
+    { 0x011D2, "BB+kb08Tl9A" }, // scePthreadRwlockDestroy
+    { 0x011EA, "6ULAa0fq4jA" }, // scePthreadRwlockInit
+    { 0x011FF, "Ox9i0c7L5w0" }, // scePthreadRwlockRdlock
+    { 0x01216, "+L98PIbGttk" }, // scePthreadRwlockUnlock
+    { 0x0122D, "mqdNorrB+gI" }, // scePthreadRwlockWrlock
+    { 0x01244, "aI+OeCz8xrQ" }, // scePthreadSelf
+    { 0x01253, "bt3CTBKmGyI" }, // scePthreadSetaffinity
+    { 0x01269, "W0Hpm2X0uPE" }, // scePthreadSetprio
+    { 0x0127B, "+BzXYkqYeLE" }, // scePthreadSetspecific
+    { 0x01291, "T72hz6ffq08" }, // scePthreadYield
+    { 0x012A1, "fMP5NHUOaMk" }, // sceSysmoduleIsLoaded
+    { 0x012B6, "g8cM39EUZ6o" }, // sceSysmoduleLoadModule
+    { 0x012CD, "39iV5E1HoCk" }, // sceSysmoduleLoadModuleInternal
+    { 0x012EC, "hHrGoGoNf+s" }, // sceSysmoduleLoadModuleInternalWithArg
+    { 0x01312, "DOO+zuW1lrE" }, // sceSysmodulePreloadModuleForLibkernel
+    { 0x01338, "eR2bZFAAU0Q" }, // sceSysmoduleUnloadModule
+    { 0x01351, "vXZhrtJxkGc" }, // sceSysmoduleUnloadModuleInternal
+    { 0x01372, "T8fER+tIGgk" }, // select
+    { 0x01379, "fZOeZIOEmLw" }, // send
+    { 0x0137E, "oBr313PppNE" }, // sendto
+    { 0x01385, "vZMcAfsA31I" }, // setbuf
+    { 0x0138C, "gNQ1V2vfXDE" }, // setjmp
+    { 0x01393, "fFxGkxF2bVo" }, // setsockopt
+    { 0x0139E, "QMFyLoqNxIg" }, // setvbuf
+    { 0x013A6, "TUuiYS2kE8s" }, // shutdown
+    { 0x013AF, "VADc3MNQ3cM" }, // signal
+    { 0x013B6, "H8ya2H00jbI" }, // sin
+    { 0x013BA, "Q4rRL34CEeE" }, // sinf
+    { 0x013BF, "ZjtRqSMJwdw" }, // sinh
+    { 0x013C4, "0wu33hunNdE" }, // sleep
+    { 0x013CA, "eLdDw6l0-bU" }, // snprintf
+    { 0x013D3, "TU-d9PfIHPM" }, // socket
+    { 0x013DA, "tcVi5SivF7Q" }, // sprintf
+    { 0x013E2, "MXRNWnosNlM" }, // sqrt
+    { 0x013E7, "Q+xU11-h0xQ" }, // sqrtf
+    { 0x013ED, "VPbJwTCgME0" }, // srand
+    { 0x013F3, "1Pk0qZQGeWo" }, // sscanf
+    { 0x013FA, "E6ao34wPw+U" }, // stat
+    { 0x013FF, "AV6ipCNa4Rw" }, // strcasecmp
+    { 0x0140A, "Ls4tzzhimqQ" }, // strcat
+    { 0x01411, "ob5xAW4ln-0" }, // strchr
+    { 0x01418, "Ovb2dSJOAuE" }, // strcmp
+    { 0x0141F, "gjbmYpP-XJQ" }, // strcoll
+    { 0x01427, "kiZSXIWd9vg" }, // strcpy
+    { 0x0142E, "q0F6yS-rCms" }, // strcspn
+    { 0x01436, "g7zzzLDYGw0" }, // strdup
+    { 0x0143D, "RIa6GnWp+iU" }, // strerror
+    { 0x01446, "RBcs3uut1TA" }, // strerror_r
+    { 0x01451, "Av3zjWi64Kw" }, // strftime
+    { 0x0145A, "j4ViWNHEgww" }, // strlen
+    { 0x01461, "pXvbDfchu6k" }, // strncasecmp
+    { 0x0146D, "kHg45qPC6f0" }, // strncat
+    { 0x01475, "aesyjrHVWy4" }, // strncmp
+    { 0x0147D, "6sJWiWSRuqk" }, // strncpy
+    { 0x01485, "XGnuIBmEmyk" }, // strndup
+    { 0x0148D, "5jNubw4vlAA" }, // strnlen
+    { 0x01495, "kDZvoVssCgQ" }, // strpbrk
+    { 0x0149D, "9yDWMxEFdJU" }, // strrchr
+    { 0x014A5, "-kU6bB4M-+k" }, // strspn
+    { 0x014AC, "viiwFMaNamA" }, // strstr
+    { 0x014B3, "2vDqwBlpF-o" }, // strtod
+    { 0x014BA, "xENtRue8dpI" }, // strtof
+    { 0x014C1, "oVkZ8W8-Q8A" }, // strtok
+    { 0x014C8, "enqPGLfmVNU" }, // strtok_r
+    { 0x014D1, "mXlxhmLNMPg" }, // strtol
+    { 0x014D8, "VOBg+iNwB-4" }, // strtoll
+    { 0x014E0, "QxmSHBCuKTk" }, // strtoul
+    { 0x014E8, "5OqszGpy7Mg" }, // strtoull
+    { 0x014F1, "zogPrkd46DY" }, // strxfrm
+    { 0x014F9, "DFmMT80xcNI" }, // sysctl
+    { 0x01500, "MhC53TKmjVA" }, // sysctlbyname
+    { 0x0150D, "Jc6E7N+dHz0" }, // system
+    { 0x01514, "T7uyNqP7vQA" }, // tan
+    { 0x01518, "ZE6RNL+eLbk" }, // tanf
+    { 0x0151D, "JM4EBvWT9rc" }, // tanh
+    { 0x01522, "wLlFkwG9UcQ" }, // time
+    { 0x01527, "s5DYjL8TwPQ" }, // tmpfile
+    { 0x0152F, "jHEKeMm3Ye8" }, // tmpnam
+    { 0x01536, "PqF+kHW-2WQ" }, // tolower
+    { 0x0153E, "TYE4irxSmko" }, // toupper
+    { 0x01546, "a4gLGspPEDM" }, // trunc
+    { 0x0154C, "Vo8rvWtZw3g" }, // truncf
+    { 0x01553, "-LFO7jhD5CE" }, // ungetc
+    { 0x0155A, "VAzswvTOCzI" }, // unlink
+    { 0x01561, "QcteRwbsnV0" }, // usleep
+    { 0x01568, "pDBDcY6uLSA" }, // vfprintf
+    { 0x01571, "GMpvxPFW924" }, // vprintf
+    { 0x01579, "Q2V+iqvjgC0" }, // vsnprintf
+    { 0x01583, "jbz9I9vkqkk" }, // vsprintf
+    { 0x0158C, "UTrpOVLcoOA" }, // vsscanf
+    { 0x01594, "KZm8HUIX2Rw" }, // wcscat
+    { 0x0159B, "Ezzq78ZgHPs" }, // wcschr
+    { 0x015A2, "pNtJdE3x49E" }, // wcscmp
+    { 0x015A9, "FM5NPnLqBc8" }, // wcscpy
+    { 0x015B0, "WkkeywLJcgU" }, // wcslen
+    { 0x015B7, "E8wCoUEbfzk" }, // wcsncmp
+    { 0x015BF, "0nV21JjYCH8" }, // wcsncpy
+    { 0x015C7, "v7S7LhP2OJc" }, // wcstombs
+    { 0x015D0, "7PxmvOEX3oc" }, // wctomb
+    { 0x015D7, "fL3O02ypZFE" }, // wmemcpy
+    { 0x015DF, "Al8MZJh-4hM" }, // wmemset
+    { 0x015E7, "FN4gaPmuFV8" }, // write
+};
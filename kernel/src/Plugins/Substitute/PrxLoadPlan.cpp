@@ -0,0 +1,529 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "PrxLoadPlan.hpp"
+#include <Utils/Kdlsym.hpp>
+#include <Utils/Kernel.hpp>
+#include <Utils/Logger.hpp>
+#include <Utils/SysWrappers.hpp>
+
+extern "C"
+{
+    #include <fcntl.h>
+    #include <sys/dirent.h>
+    #include <sys/stat.h>
+    #include <sys/syslimits.h>
+};
+
+using namespace Mira::Plugins;
+
+PrxLoadPlanCache::PrxLoadPlanCache() :
+    m_Plans(Utils::MemoryTag_Substitute)
+{
+    auto mtx_init = (void(*)(struct mtx *m, const char *name, const char *type, int opts))kdlsym(mtx_init);
+
+    mtx_init(&m_Mutex, "SubLoadPlan", nullptr, MTX_DEF);
+}
+
+PrxLoadPlanCache::~PrxLoadPlanCache()
+{
+    auto mtx_destroy = (void(*)(struct mtx *))kdlsym(mtx_destroy);
+
+    Clear();
+
+    mtx_destroy(&m_Mutex);
+}
+
+PrxLoadPlan* PrxLoadPlanCache::Get(struct thread* p_Thread, const char* p_TitleId, const char* p_FolderPath)
+{
+    if (p_Thread == nullptr || p_TitleId == nullptr || p_TitleId[0] == '\0' || p_FolderPath == nullptr)
+        return nullptr;
+
+    if (strlen(p_TitleId) >= PrxLoadPlan_TitleIdLength)
+        return nullptr;
+
+    PrxLoadPlanKey s_Key;
+    if (!GetKey(p_Thread, p_FolderPath, s_Key))
+        return nullptr;
+
+    auto s_Plan = Find(p_TitleId, s_Key);
+    if (s_Plan != nullptr)
+        return s_Plan;
+
+    // Reading the folder can sleep, it is built without holding the mutex
+    s_Plan = Build(p_Thread, p_TitleId, p_FolderPath, s_Key);
+    if (s_Plan == nullptr)
+        return nullptr;
+
+    Store(s_Plan);
+    return s_Plan;
+}
+
+void PrxLoadPlanCache::Clear()
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+
+    m_Plans.ForEach([](const char* const&, PrxLoadPlan*& p_Plan)
+    {
+        Destroy(p_Plan);
+        return true;
+    });
+    m_Plans.Clear();
+
+    _mtx_unlock_flags(&m_Mutex, 0);
+}
+
+void PrxLoadPlanCache::Destroy(PrxLoadPlan* p_Plan)
+{
+    if (p_Plan == nullptr)
+        return;
+
+    if (p_Plan->Names != nullptr)
+        delete [] p_Plan->Names;
+
+    delete p_Plan;
+}
+
+PrxLoadPlan* PrxLoadPlanCache::Find(const char* p_TitleId, const PrxLoadPlanKey& p_Key)
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    PrxLoadPlan* s_Plan = nullptr;
+
+    _mtx_lock_flags(&m_Mutex, 0);
+
+    auto s_Entry = m_Plans.Find(p_TitleId);
+    if (s_Entry != nullptr && (*s_Entry)->Key == p_Key)
+        s_Plan = Clone(*s_Entry);
+
+    _mtx_unlock_flags(&m_Mutex, 0);
+
+    return s_Plan;
+}
+
+void PrxLoadPlanCache::Store(const PrxLoadPlan* p_Plan)
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    auto s_Plan = Clone(p_Plan);
+    if (s_Plan == nullptr)
+        return;
+
+    _mtx_lock_flags(&m_Mutex, 0);
+
+    // The key points into the old plan, it has to leave the map before being freed
+    auto s_Entry = m_Plans.Find(s_Plan->TitleId);
+    if (s_Entry != nullptr)
+    {
+        auto s_OldPlan = *s_Entry;
+        m_Plans.Remove(s_Plan->TitleId);
+        Destroy(s_OldPlan);
+    }
+
+    if (!m_Plans.Insert(s_Plan->TitleId, s_Plan))
+        Destroy(s_Plan);
+
+    _mtx_unlock_flags(&m_Mutex, 0);
+}
+
+bool PrxLoadPlanCache::GetKey(struct thread* p_Thread, const char* p_FolderPath, PrxLoadPlanKey& p_OutKey)
+{
+    auto snprintf = (int(*)(char *str, size_t size, const char *format, ...))kdlsym(snprintf);
+
+    memset(&p_OutKey, 0, sizeof(p_OutKey));
+
+    char s_Path[PATH_MAX];
+    snprintf(s_Path, sizeof(s_Path), "%s", p_FolderPath);
+
+    struct stat s_Stat;
+    memset(&s_Stat, 0, sizeof(s_Stat));
+    if (kstat_t(s_Path, &s_Stat, p_Thread) < 0)
+        return false;
+
+    p_OutKey.DirectoryInode = s_Stat.st_ino;
+    p_OutKey.DirectoryModified = s_Stat.st_mtim.tv_sec;
+    p_OutKey.DirectoryModifiedNsec = s_Stat.st_mtim.tv_nsec;
+
+    // Editing the manifest in place does not touch the folder, it is part of the key on its own
+    snprintf(s_Path, sizeof(s_Path), "%s%s", p_FolderPath, PrxLoadPlan::ManifestName);
+
+    memset(&s_Stat, 0, sizeof(s_Stat));
+    if (kstat_t(s_Path, &s_Stat, p_Thread) < 0)
+        return true;
+
+    p_OutKey.ManifestInode = s_Stat.st_ino;
+    p_OutKey.ManifestModified = s_Stat.st_mtim.tv_sec;
+    p_OutKey.ManifestModifiedNsec = s_Stat.st_mtim.tv_nsec;
+    p_OutKey.ManifestSize = s_Stat.st_size;
+    return true;
+}
+
+PrxLoadPlan* PrxLoadPlanCache::Build(struct thread* p_Thread, const char* p_TitleId, const char* p_FolderPath, const PrxLoadPlanKey& p_Key)
+{
+    auto s_Modules = new (Utils::MemoryTag_Substitute) BuildModule[PrxLoadPlan_MaxModules];
+    if (s_Modules == nullptr)
+        return nullptr;
+
+    PrxLoadPlan* s_Plan = nullptr;
+    do
+    {
+        auto s_ModuleCount = ReadModules(p_Thread, p_TitleId, p_FolderPath, s_Modules);
+
+        auto s_Manifest = ReadManifest(p_Thread, p_FolderPath);
+        if (s_Manifest != nullptr)
+        {
+            ApplyManifest(p_TitleId, s_Manifest, s_Modules, s_ModuleCount);
+            delete [] s_Manifest;
+        }
+
+        // Listed modules in manifest order, then the rest which are already sorted by name
+        uint32_t s_Order[PrxLoadPlan_MaxModules];
+        uint32_t s_OrderCount = 0;
+        uint32_t s_ListedCount = 0;
+        uint32_t s_NamesSize = 0;
+
+        for (uint32_t l_Index = 0; l_Index < s_ModuleCount; ++l_Index)
+        {
+            if (s_Modules[l_Index].ManifestOrder >= 0)
+                s_ListedCount++;
+        }
+
+        for (uint32_t l_Index = 0; l_Index < s_ModuleCount; ++l_Index)
+        {
+            auto& l_Module = s_Modules[l_Index];
+            if (l_Module.Enabled)
+                s_NamesSize += strlen(l_Module.Name) + 1;
+
+            // ApplyManifest hands out orders 0, 1, 2... to the listed modules
+            if (l_Module.ManifestOrder >= 0)
+                s_Order[l_Module.ManifestOrder] = l_Index;
+            else
+                s_Order[s_ListedCount + s_OrderCount++] = l_Index;
+        }
+
+        s_Plan = new (Utils::MemoryTag_Substitute) PrxLoadPlan();
+        if (s_Plan == nullptr)
+            break;
+
+        memset(s_Plan, 0, sizeof(*s_Plan));
+        memcpy(s_Plan->TitleId, p_TitleId, strlen(p_TitleId) + 1);
+        s_Plan->Key = p_Key;
+
+        if (s_NamesSize > 0)
+        {
+            s_Plan->Names = new (Utils::MemoryTag_Substitute) char[s_NamesSize];
+            if (s_Plan->Names == nullptr)
+            {
+                Destroy(s_Plan);
+                s_Plan = nullptr;
+                break;
+            }
+        }
+
+        // Take the first module in order whose dependencies are all loaded, until none is left
+        bool s_Cycle = false;
+        for (;;)
+        {
+            int32_t s_Next = -1;
+            uint32_t s_Remaining = 0;
+            for (uint32_t l_Position = 0; l_Position < s_ModuleCount; ++l_Position)
+            {
+                auto& l_Module = s_Modules[s_Order[l_Position]];
+                if (!l_Module.Enabled || l_Module.Emitted)
+                    continue;
+
+                s_Remaining++;
+
+                bool l_Ready = true;
+                for (uint32_t l_Dependency = 0; l_Dependency < l_Module.DependencyCount; ++l_Dependency)
+                {
+                    auto& l_Other = s_Modules[l_Module.Dependencies[l_Dependency]];
+                    if (l_Other.Enabled && !l_Other.Emitted)
+                    {
+                        l_Ready = false;
+                        break;
+                    }
+                }
+
+                // Once a cycle was found whatever is left loads in plain order
+                if (l_Ready || s_Cycle)
+                {
+                    s_Next = static_cast<int32_t>(s_Order[l_Position]);
+                    break;
+                }
+            }
+
+            if (s_Remaining == 0)
+                break;
+
+            if (s_Next < 0)
+            {
+                WriteLog(LL_Warn, "[%s] %s has a dependency cycle, loading the remaining modules in order.", p_TitleId, PrxLoadPlan::ManifestName);
+                s_Cycle = true;
+                continue;
+            }
+
+            auto& s_Module = s_Modules[s_Next];
+            auto s_Length = strlen(s_Module.Name) + 1;
+            memcpy(s_Plan->Names + s_Plan->NamesSize, s_Module.Name, s_Length);
+            s_Plan->NamesSize += s_Length;
+            s_Plan->ModuleCount++;
+            s_Module.Emitted = true;
+        }
+
+        WriteLog(LL_Info, "[%s] built load plan, (%d) of (%d) modules enabled.", p_TitleId, s_Plan->ModuleCount, s_ModuleCount);
+    } while (false);
+
+    delete [] s_Modules;
+
+    return s_Plan;
+}
+
+PrxLoadPlan* PrxLoadPlanCache::Clone(const PrxLoadPlan* p_Plan)
+{
+    if (p_Plan == nullptr)
+        return nullptr;
+
+    auto s_Plan = new (Utils::MemoryTag_Substitute) PrxLoadPlan();
+    if (s_Plan == nullptr)
+        return nullptr;
+
+    memcpy(s_Plan, p_Plan, sizeof(*s_Plan));
+    s_Plan->Names = nullptr;
+
+    if (p_Plan->NamesSize > 0)
+    {
+        s_Plan->Names = new (Utils::MemoryTag_Substitute) char[p_Plan->NamesSize];
+        if (s_Plan->Names == nullptr)
+        {
+            delete s_Plan;
+            return nullptr;
+        }
+
+        memcpy(s_Plan->Names, p_Plan->Names, p_Plan->NamesSize);
+    }
+
+    return s_Plan;
+}
+
+uint32_t PrxLoadPlanCache::ReadModules(struct thread* p_Thread, const char* p_TitleId, const char* p_FolderPath, BuildModule* p_Modules)
+{
+    uint32_t s_ModuleCount = 0;
+
+    auto s_DirectoryHandle = kopen_t(p_FolderPath, O_RDONLY | O_DIRECTORY, 0777, p_Thread);
+    if (s_DirectoryHandle < 0)
+    {
+        WriteLog(LL_Error, "[%s] could not open (%s) (%d).", p_TitleId, p_FolderPath, s_DirectoryHandle);
+        return 0;
+    }
+
+    char s_Buffer[0x1000];
+    for (;;)
+    {
+        memset(s_Buffer, 0, sizeof(s_Buffer));
+        auto s_ReadCount = kgetdents_t(s_DirectoryHandle, s_Buffer, sizeof(s_Buffer), p_Thread);
+        if (s_ReadCount <= 0)
+            break;
+
+        for (auto l_Pos = 0; l_Pos < s_ReadCount;)
+        {
+            auto l_Dent = (struct dirent*)(s_Buffer + l_Pos);
+            l_Pos += l_Dent->d_reclen;
+
+            if (l_Dent->d_reclen == 0)
+                break;
+
+            // Only names ending with .sprx, "name.sprx.bak" stays out
+            uint32_t l_NameLength = l_Dent->d_namlen;
+            if (l_NameLength <= 5 || l_NameLength > PrxLoadPlan_MaxNameLength || strcmp(l_Dent->d_name + l_NameLength - 5, ".sprx") != 0)
+                continue;
+
+            if (s_ModuleCount >= PrxLoadPlan_MaxModules)
+            {
+                WriteLog(LL_Warn, "[%s] more than (%d) modules, skipping (%s).", p_TitleId, PrxLoadPlan_MaxModules, l_Dent->d_name);
+                continue;
+            }
+
+            // Insertion sort, directory order depends on the filesystem
+            uint32_t l_Insert = s_ModuleCount;
+            while (l_Insert > 0 && strcmp(p_Modules[l_Insert - 1].Name, l_Dent->d_name) > 0)
+            {
+                p_Modules[l_Insert] = p_Modules[l_Insert - 1];
+                l_Insert--;
+            }
+
+            auto& l_Module = p_Modules[l_Insert];
+            memset(&l_Module, 0, sizeof(l_Module));
+            memcpy(l_Module.Name, l_Dent->d_name, l_NameLength);
+            l_Module.Enabled = true;
+            l_Module.ManifestOrder = -1;
+
+            s_ModuleCount++;
+        }
+    }
+
+    kclose_t(s_DirectoryHandle, p_Thread);
+
+    return s_ModuleCount;
+}
+
+char* PrxLoadPlanCache::ReadManifest(struct thread* p_Thread, const char* p_FolderPath)
+{
+    auto snprintf = (int(*)(char *str, size_t size, const char *format, ...))kdlsym(snprintf);
+
+    char s_Path[PATH_MAX];
+    snprintf(s_Path, sizeof(s_Path), "%s%s", p_FolderPath, PrxLoadPlan::ManifestName);
+
+    auto s_Handle = kopen_t(s_Path, O_RDONLY, 0, p_Thread);
+    if (s_Handle < 0)
+        return nullptr;
+
+    auto s_Manifest = new (Utils::MemoryTag_Substitute) char[PrxLoadPlan_MaxManifestSize];
+    if (s_Manifest == nullptr)
+    {
+        kclose_t(s_Handle, p_Thread);
+        return nullptr;
+    }
+
+    size_t s_Size = 0;
+    while (s_Size < PrxLoadPlan_MaxManifestSize - 1)
+    {
+        auto l_ReadCount = kread_t(s_Handle, s_Manifest + s_Size, PrxLoadPlan_MaxManifestSize - 1 - s_Size, p_Thread);
+        if (l_ReadCount <= 0)
+            break;
+
+        s_Size += l_ReadCount;
+    }
+    s_Manifest[s_Size] = '\0';
+
+    kclose_t(s_Handle, p_Thread);
+
+    return s_Manifest;
+}
+
+void PrxLoadPlanCache::ApplyManifest(const char* p_TitleId, char* p_Manifest, BuildModule* p_Modules, uint32_t p_ModuleCount)
+{
+    int32_t s_Order = 0;
+    uint32_t s_LineNumber = 0;
+
+    auto s_Line = p_Manifest;
+    while (*s_Line != '\0')
+    {
+        auto l_End = s_Line;
+        while (*l_End != '\0' && *l_End != '\n')
+            ++l_End;
+
+        auto l_Next = (*l_End != '\0') ? l_End + 1 : l_End;
+        *l_End = '\0';
+
+        ApplyManifestLine(p_TitleId, s_Line, ++s_LineNumber, s_Order, p_Modules, p_ModuleCount);
+
+        s_Line = l_Next;
+    }
+}
+
+void PrxLoadPlanCache::ApplyManifestLine(const char* p_TitleId, char* p_Line, uint32_t p_LineNumber, int32_t& p_Order, BuildModule* p_Modules, uint32_t p_ModuleCount)
+{
+    // Everything after the ':' are dependencies
+    char* s_Dependencies = nullptr;
+    for (auto l_Position = p_Line; *l_Position != '\0'; ++l_Position)
+    {
+        if (*l_Position == '#')
+        {
+            *l_Position = '\0';
+            break;
+        }
+
+        if (*l_Position == ':' && s_Dependencies == nullptr)
+        {
+            *l_Position = '\0';
+            s_Dependencies = l_Position + 1;
+        }
+    }
+
+    auto s_Position = p_Line;
+    auto s_Name = NextToken(s_Position);
+    if (s_Name == nullptr)
+        return;
+
+    bool s_Enabled = true;
+    if (s_Name[0] == '-')
+    {
+        s_Enabled = false;
+        s_Name++;
+    }
+
+    auto s_Index = FindModule(p_Modules, p_ModuleCount, s_Name);
+    if (s_Index < 0)
+    {
+        WriteLog(LL_Warn, "[%s] %s:%d: (%s) is not in the folder.", p_TitleId, PrxLoadPlan::ManifestName, p_LineNumber, s_Name);
+        return;
+    }
+
+    auto& s_Module = p_Modules[s_Index];
+    if (s_Module.ManifestOrder >= 0)
+    {
+        WriteLog(LL_Warn, "[%s] %s:%d: (%s) is already listed.", p_TitleId, PrxLoadPlan::ManifestName, p_LineNumber, s_Name);
+        return;
+    }
+
+    s_Module.ManifestOrder = p_Order++;
+    s_Module.Enabled = s_Enabled;
+
+    if (s_Dependencies == nullptr)
+        return;
+
+    for (auto l_Dependency = NextToken(s_Dependencies); l_Dependency != nullptr; l_Dependency = NextToken(s_Dependencies))
+    {
+        auto l_Index = FindModule(p_Modules, p_ModuleCount, l_Dependency);
+        if (l_Index < 0 || l_Index == s_Index)
+        {
+            WriteLog(LL_Warn, "[%s] %s:%d: ignoring dependency (%s).", p_TitleId, PrxLoadPlan::ManifestName, p_LineNumber, l_Dependency);
+            continue;
+        }
+
+        if (s_Module.DependencyCount >= PrxLoadPlan_MaxDependencies)
+        {
+            WriteLog(LL_Warn, "[%s] %s:%d: more than (%d) dependencies.", p_TitleId, PrxLoadPlan::ManifestName, p_LineNumber, PrxLoadPlan_MaxDependencies);
+            break;
+        }
+
+        s_Module.Dependencies[s_Module.DependencyCount++] = static_cast<uint32_t>(l_Index);
+    }
+}
+
+int32_t PrxLoadPlanCache::FindModule(const BuildModule* p_Modules, uint32_t p_ModuleCount, const char* p_Name)
+{
+    for (uint32_t l_Index = 0; l_Index < p_ModuleCount; ++l_Index)
+    {
+        if (strcmp(p_Modules[l_Index].Name, p_Name) == 0)
+            return static_cast<int32_t>(l_Index);
+    }
+
+    return -1;
+}
+
+char* PrxLoadPlanCache::NextToken(char*& p_Position)
+{
+    auto s_IsSeparator = [](char p_Char) { return p_Char == ' ' || p_Char == '\t' || p_Char == '\r' || p_Char == ','; };
+
+    while (*p_Position != '\0' && s_IsSeparator(*p_Position))
+        ++p_Position;
+
+    if (*p_Position == '\0')
+        return nullptr;
+
+    auto s_Token = p_Position;
+    while (*p_Position != '\0' && !s_IsSeparator(*p_Position))
+        ++p_Position;
+
+    if (*p_Position != '\0')
+        *p_Position++ = '\0';
+
+    return s_Token;
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include <Utils/Types.hpp>
+#include <Utils/HashMap.hpp>
+
+extern "C"
+{
+    #include <sys/param.h>
+    #include <sys/lock.h>
+    #include <sys/mutex.h>
+};
+
+struct thread;
+
+namespace Mira
+{
+    namespace Plugins
+    {
+        enum
+        {
+            // Modules past this are ignored with a warning
+            PrxLoadPlan_MaxModules = 64,
+
+            // Same as MAXNAMLEN, longest name a dirent can hold
+            PrxLoadPlan_MaxNameLength = 255,
+
+            // Dependencies a single manifest line can declare
+            PrxLoadPlan_MaxDependencies = 8,
+
+            // Larger manifests are truncated
+            PrxLoadPlan_MaxManifestSize = 0x2000,
+
+            // CUSAXXXXX and the terminator, rounded up
+            PrxLoadPlan_TitleIdLength = 16,
+        };
+
+        struct PrxLoadPlanKey
+        {
+            uint64_t DirectoryInode;
+            int64_t DirectoryModified;
+            int64_t DirectoryModifiedNsec;
+
+            // All zero when the folder has no manifest
+            uint64_t ManifestInode;
+            int64_t ManifestModified;
+            int64_t ManifestModifiedNsec;
+            int64_t ManifestSize;
+
+            bool operator==(const PrxLoadPlanKey& p_Other) const
+            {
+                return DirectoryInode == p_Other.DirectoryInode && DirectoryModified == p_Other.DirectoryModified && DirectoryModifiedNsec == p_Other.DirectoryModifiedNsec &&
+                    ManifestInode == p_Other.ManifestInode && ManifestModified == p_Other.ManifestModified && ManifestModifiedNsec == p_Other.ManifestModifiedNsec &&
+                    ManifestSize == p_Other.ManifestSize;
+            }
+        };
+
+        struct PrxLoadPlan
+        {
+            static constexpr const char* ManifestName = "substitute.txt";
+
+            char TitleId[PrxLoadPlan_TitleIdLength];
+            PrxLoadPlanKey Key;
+
+            // Null separated module file names, in load order
+            uint32_t ModuleCount;
+            uint32_t NamesSize;
+            char* Names;
+        };
+
+        /*
+            PrxLoadPlanCache
+
+            Remembers which modules of a title's substitute folder get loaded and in which order,
+            so launching the title again does not have to read the directory and the manifest
+            every time. A plan is reused for as long as the inode and modification time of the
+            folder and of its manifest stay the same, adding, removing or renaming a module or
+            editing the manifest rebuilds it on the next launch.
+
+            The optional manifest (PrxLoadPlan::ManifestName) lists one module per line:
+
+                # comment
+                base.sprx
+                -broken.sprx
+                plugin.sprx: base.sprx other.sprx
+
+            Listed modules load in the order they are listed, a leading '-' disables a module and
+            the names after ':' are loaded before it. Modules found in the folder but missing
+            from the manifest load afterwards sorted by name. Without a manifest every module
+            loads sorted by name.
+        */
+        class PrxLoadPlanCache
+        {
+        private:
+            struct BuildModule
+            {
+                char Name[PrxLoadPlan_MaxNameLength + 1];
+                bool Enabled;
+                bool Emitted;
+
+                // Position in the manifest, -1 when the manifest does not list it
+                int32_t ManifestOrder;
+
+                // Indexes of the modules that load before this one
+                uint32_t DependencyCount;
+                uint32_t Dependencies[PrxLoadPlan_MaxDependencies];
+            };
+
+            // Keyed by the TitleId of the plan itself
+            Utils::HashMap<const char*, PrxLoadPlan*, Utils::StringHash, Utils::StringEqualTo> m_Plans;
+            struct mtx m_Mutex;
+
+        public:
+            PrxLoadPlanCache();
+            ~PrxLoadPlanCache();
+
+            // Returns the plan for the folder p_FolderPath (ending with '/') of p_TitleId, building and caching
+            // it if the cached one is missing or stale. The caller owns the result and frees it with Destroy
+            PrxLoadPlan* Get(struct thread* p_Thread, const char* p_TitleId, const char* p_FolderPath);
+
+            void Clear();
+
+            static void Destroy(PrxLoadPlan* p_Plan);
+
+        private:
+            PrxLoadPlan* Find(const char* p_TitleId, const PrxLoadPlanKey& p_Key);
+            void Store(const PrxLoadPlan* p_Plan);
+
+            static bool GetKey(struct thread* p_Thread, const char* p_FolderPath, PrxLoadPlanKey& p_OutKey);
+            static PrxLoadPlan* Build(struct thread* p_Thread, const char* p_TitleId, const char* p_FolderPath, const PrxLoadPlanKey& p_Key);
+            static PrxLoadPlan* Clone(const PrxLoadPlan* p_Plan);
+
+            static uint32_t ReadModules(struct thread* p_Thread, const char* p_TitleId, const char* p_FolderPath, BuildModule* p_Modules);
+            static char* ReadManifest(struct thread* p_Thread, const char* p_FolderPath);
+            static void ApplyManifest(const char* p_TitleId, char* p_Manifest, BuildModule* p_Modules, uint32_t p_ModuleCount);
+            static void ApplyManifestLine(const char* p_TitleId, char* p_Line, uint32_t p_LineNumber, int32_t& p_Order, BuildModule* p_Modules, uint32_t p_ModuleCount);
+            static int32_t FindModule(const BuildModule* p_Modules, uint32_t p_ModuleCount, const char* p_Name);
+            static char* NextToken(char*& p_Position);
+        };
+    }
+}
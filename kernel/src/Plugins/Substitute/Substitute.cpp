@@ -7,6 +7,7 @@
 #include <Utils/Kernel.hpp>
 #include <Utils/SysWrappers.hpp>
 #include <Utils/Hook.hpp>
+#include <Utils/HookStats.hpp>
 #include <OrbisOS/Utilities.hpp>
 
 #include <Mira.hpp>
@@ -48,11 +49,11 @@ using namespace Mira::OrbisOS;
 
 // Substitute : Constructor
 Substitute::Substitute() :
-    m_processStartHandler(nullptr),
-    m_processEndHandler(nullptr)
+    m_ProcessStartSubscription(-1),
+    m_ProcessExitSubscription(-1),
+    m_ProcessHooks(Utils::MemoryTag_Substitute),
+    m_MountedProcesses("SubProcs", Utils::MemoryTag_Substitute)
 {
-    // Cleanup hooks memory space
-    memset(hooks, 0, sizeof(SubstituteHook) * SUBSTITUTE_MAX_HOOKS);
 }
 
 // Substitute : Destructor
@@ -65,25 +66,33 @@ bool Substitute::OnLoad()
 {
     auto sv = (struct sysentvec*)kdlsym(self_orbis_sysvec);
     struct sysent* sysents = sv->sv_table;
-    auto eventhandler_register = (eventhandler_tag(*)(struct eventhandler_list *list, const char *name, void *func, void *arg, int priority))kdlsym(eventhandler_register);   
     auto mtx_init = (void(*)(struct mtx *m, const char *name, const char *type, int opts))kdlsym(mtx_init);
     WriteLog(LL_Info, "Loading Substitute ...");
  
-    // Substitute mount / unmount
-    m_processStartHandler = EVENTHANDLER_REGISTER(process_exec_end, reinterpret_cast<void*>(OnProcessStart), nullptr, EVENTHANDLER_PRI_ANY);
-    m_processEndHandler = EVENTHANDLER_REGISTER(process_exit, reinterpret_cast<void*>(OnProcessExit), nullptr, EVENTHANDLER_PRI_ANY);
+    mtx_init(&hook_mtx, "Substitute Hook Lock", NULL, MTX_DEF);
+
+    // Substitute mount / unmount, only titles get a folder mounted but hooks can be in any process
+    auto process_events = Mira::Framework::GetFramework()->GetProcessEvents();
+    if (!process_events) {
+        WriteLog(LL_Error, "Process events are not available.");
+        return false;
+    }
+
+    Mira::OrbisOS::ProcessEventFilter start_filter = { Mira::OrbisOS::ProcessEventFilter_HasTitleId | Mira::OrbisOS::ProcessEventFilter_Sandboxed, "", "" };
+    Mira::OrbisOS::ProcessEventFilter exit_filter = { Mira::OrbisOS::ProcessEventFilter_None, "", "" };
+    m_ProcessStartSubscription = process_events->Subscribe(Mira::OrbisOS::ProcessEvent_Start, start_filter, OnProcessStart, this);
+    m_ProcessExitSubscription = process_events->Subscribe(Mira::OrbisOS::ProcessEvent_Exit, exit_filter, OnProcessExit, this);
 
     // Substitute syscall hook (PRX Loader)
     sys_dynlib_dlsym_p = (void*)sysents[SYS_DYNLIB_DLSYM].sy_call;
     sysents[SYS_DYNLIB_DLSYM].sy_call = (sy_call_t*)Sys_dynlib_dlsym_hook;
 
-    mtx_init(&hook_mtx, "Substitute SPIN Lock", NULL, MTX_SPIN);
-
     // Print substitute ioctl command
     WriteLog(LL_Debug, "IOCTL Command:");
     WriteLog(LL_Debug, "SUBSTITUTE_HOOK_IAT: 0x%08x", SUBSTITUTE_HOOK_IAT);
     WriteLog(LL_Debug, "SUBSTITUTE_HOOK_JMP: 0x%08x", SUBSTITUTE_HOOK_JMP);
     WriteLog(LL_Debug, "SUBSTITUTE_HOOK_STATE: 0x%08x", SUBSTITUTE_HOOK_STATE);
+    WriteLog(LL_Debug, "SUBSTITUTE_HOOK_BATCH: 0x%08x", SUBSTITUTE_HOOK_BATCH);
 
     return true;
 }
@@ -93,20 +102,19 @@ bool Substitute::OnUnload()
 {
     auto sv = (struct sysentvec*)kdlsym(self_orbis_sysvec);
     struct sysent* sysents = sv->sv_table;
-    auto eventhandler_deregister = (void(*)(struct eventhandler_list* a, struct eventhandler_entry* b))kdlsym(eventhandler_deregister);
-    auto eventhandler_find_list = (struct eventhandler_list * (*)(const char *name))kdlsym(eventhandler_find_list);
 
     WriteLog(LL_Error, "Unloading Substitute ...");
 
     // Cleanup substitute mount / unmount
-    if (m_processStartHandler) {
-        EVENTHANDLER_DEREGISTER(process_exec_end, m_processStartHandler);
-        m_processStartHandler = nullptr;
+    auto process_events = Mira::Framework::GetFramework()->GetProcessEvents();
+    if (process_events && m_ProcessStartSubscription >= 0) {
+        process_events->Unsubscribe(m_ProcessStartSubscription);
+        m_ProcessStartSubscription = -1;
     }
 
-    if (m_processEndHandler) {
-        EVENTHANDLER_DEREGISTER(process_exit, m_processEndHandler);
-        m_processStartHandler = nullptr;
+    if (process_events && m_ProcessExitSubscription >= 0) {
+        process_events->Unsubscribe(m_ProcessExitSubscription);
+        m_ProcessExitSubscription = -1;
     }
 
     // Cleanup substitute hook (PRX Loader)
@@ -116,6 +124,9 @@ bool Substitute::OnUnload()
     }
 
     CleanupAllHook();
+    m_JmpslotCache.Clear();
+    m_LoadPlans.Clear();
+    m_MountedProcesses.Clear();
     return true;
 }
 
@@ -155,62 +166,144 @@ Substitute* Substitute::GetPlugin()
 // HOOK MEMORY SYSTEM (Kernel Side) //
 //////////////////////////////////////////
 
+// Substitute : Return the hook table of a process, create it if needed (MUTEX NEEDED)
+SubstituteProcessHooks* Substitute::GetProcessHooks(struct proc* p, bool create) {
+    if (!p)
+        return nullptr;
+
+    auto process_hooks = m_ProcessHooks.Find(p);
+    if (process_hooks)
+        return *process_hooks;
+
+    if (!create)
+        return nullptr;
+
+    SubstituteProcessHooks* new_process_hooks = new (Utils::MemoryTag_Substitute) SubstituteProcessHooks();
+    if (!new_process_hooks) {
+        WriteLog(LL_Error, "Unable to allocate the hook table !");
+        return nullptr;
+    }
+
+    if (!m_ProcessHooks.Insert(p, new_process_hooks)) {
+        WriteLog(LL_Error, "Unable to track the hook table !");
+        delete new_process_hooks;
+        return nullptr;
+    }
+
+    return new_process_hooks;
+}
+
 // Substitute : Return hook struct by this id (MUTEX NEEDED)
-SubstituteHook* Substitute::GetHookByID(int hook_id) {
+SubstituteHook* Substitute::GetHookByID(struct proc* p, int hook_id) {
     // Check if the hook_id is in the specs
-    if (hook_id < 0 || hook_id > SUBSTITUTE_MAX_HOOKS) {
+    if (hook_id < 0) {
         WriteLog(LL_Error, "Invalid hook id ! (%d)", hook_id);
         return nullptr;
     }
 
-    // If the hook is empty, it's an invalid hook !
-    SubstituteHook empty;
-    memset(&empty, 0, sizeof(SubstituteHook));
-    if (memcmp(&hooks[hook_id], &empty, sizeof(SubstituteHook)) == 0) {
+    SubstituteProcessHooks* process_hooks = GetProcessHooks(p, false);
+    if (!process_hooks)
+        return nullptr;
+
+    auto hook = process_hooks->hooks.Find(hook_id);
+    if (!hook)
         return nullptr;
-    }
 
-    // Return the address
-    return &hooks[hook_id];
+    return *hook;
 }
 
-// Substitute : Allocate a new hook to the list (MUTEX NEEDED)
-SubstituteHook* Substitute::AllocateHook(int* hook_id) {
+// Substitute : Allocate a new hook to the process table (MUTEX NEEDED)
+SubstituteHook* Substitute::AllocateHook(struct proc* p, int* hook_id) {
     if (!hook_id) {
         WriteLog(LL_Error, "Invalid argument !");
         return nullptr;
     }
 
-    SubstituteHook empty;
-    memset(&empty, 0, sizeof(SubstituteHook));
+    *hook_id = -1;
 
-    for (int i = 0; i < SUBSTITUTE_MAX_HOOKS; i++) {
-        if (memcmp(&hooks[i], &empty, sizeof(SubstituteHook)) == 0) {
-            *hook_id = i;
-            return &hooks[i];
-        }
+    SubstituteProcessHooks* process_hooks = GetProcessHooks(p, true);
+    if (!process_hooks)
+        return nullptr;
+
+    // Ids are never reused while the process is alive
+    if (process_hooks->next_hook_id < 0) {
+        WriteLog(LL_Error, "No more hook id available !");
+        return nullptr;
     }
 
-    *hook_id = -1;
-    return nullptr;
+    SubstituteHook* hook = new (Utils::MemoryTag_Substitute) SubstituteHook();
+    if (!hook)
+        return nullptr;
+
+    memset(hook, 0, sizeof(SubstituteHook));
+    hook->process = p;
+
+    int new_hook_id = process_hooks->next_hook_id;
+    if (!process_hooks->hooks.Insert(new_hook_id, hook)) {
+        delete hook;
+        return nullptr;
+    }
+
+    process_hooks->next_hook_id++;
+
+    *hook_id = new_hook_id;
+    return hook;
 }
 
-// Substitute : Free a hook from the list (MUTEX NEEDED)
-void Substitute::FreeHook(int hook_id) {
-    SubstituteHook* hook = GetHookByID(hook_id);
+// Substitute : Free the hook memory
+void Substitute::DestroyHook(SubstituteHook* hook) {
+    if (!hook)
+        return;
+
+    // Free the chain list
+    if (hook->hook_type == HOOKTYPE_IAT && hook->iat.uap_chains)
+        delete [] hook->iat.uap_chains;
 
-    if (hook) {
-        // Free the chain list
-        if (hook->hook_type == HOOKTYPE_IAT && hook->iat.uap_chains) {
-            delete (hook->iat.uap_chains);
-        }
+    if (hook->hook_type == HOOKTYPE_JMP && hook->jmp.backupData)
+        delete [] hook->jmp.backupData;
+
+    delete hook;
+}
+
+// Substitute : Free every hook of a process table and the table itself
+void Substitute::DestroyProcessHooks(SubstituteProcessHooks* process_hooks) {
+    if (!process_hooks)
+        return;
+
+    process_hooks->hooks.ForEach([](const int32_t&, SubstituteHook*& hook)
+    {
+        DestroyHook(hook);
+        return true;
+    });
 
-        // Set to 0, now everything is available
-        memset(hook, 0, sizeof(SubstituteHook));
-        WriteLog(LL_Info, "The hook %i have been deleted.", hook_id);
+    delete process_hooks;
+}
+
+// Substitute : Free a hook from the process table (MUTEX NEEDED)
+void Substitute::FreeHook(struct proc* p, int hook_id) {
+    SubstituteProcessHooks* process_hooks = GetProcessHooks(p, false);
+    if (!process_hooks)
+        return;
+
+    auto entry = process_hooks->hooks.Find(hook_id);
+    if (!entry)
+        return;
+
+    SubstituteHook* hook = *entry;
+    process_hooks->hooks.Remove(hook_id);
+
+    if (hook->hook_type == HOOKTYPE_IAT)
+        process_hooks->jmpslots.Remove((uint64_t)hook->iat.jmpslot_address);
+
+    DestroyHook(hook);
+
+    // Nothing left for this process, don't keep an empty table around until it exits
+    if (process_hooks->hooks.IsEmpty()) {
+        m_ProcessHooks.Remove(p);
+        delete process_hooks;
     }
 
-    return;
+    WriteLog(LL_Info, "The hook %i have been deleted.", hook_id);
 }
 
 
@@ -222,40 +315,64 @@ void Substitute::FreeHook(int hook_id) {
 bool Substitute::FindJmpslotSimilarity(struct proc* p, void* jmpslot_addr, int* hook_id) {
     if (!hook_id) {
         WriteLog(LL_Error, "Invalid argument !");
-        *hook_id = -1;
         return false;
     }
 
-    SubstituteHook empty;
-    memset(&empty, 0, sizeof(SubstituteHook));
+    *hook_id = -1;
+
+    SubstituteProcessHooks* process_hooks = GetProcessHooks(p, false);
+    if (!process_hooks)
+        return false;
 
-    for (int i = 0; i < SUBSTITUTE_MAX_HOOKS; i++) {
-        // If empty, don't continue, just break instead of do all the list
-        if (memcmp(&hooks[i], &empty, sizeof(SubstituteHook)) == 0) {
-            break;
+    auto jmpslot_hook_id = process_hooks->jmpslots.Find((uint64_t)jmpslot_addr);
+    if (!jmpslot_hook_id)
+        return false;
+
+    *hook_id = *jmpslot_hook_id;
+    return true;
+}
+
+// Substitute : Add a chain at the end of the hook chain list, grow it if needed (MUTEX NEEDED)
+bool Substitute::AppendChain(SubstituteHook* hook, uint64_t chain) {
+    if (!hook || !chain) {
+        WriteLog(LL_Error, "Invalid argument !");
+        return false;
+    }
+
+    if (hook->iat.chain_count == hook->iat.chain_capacity) {
+        uint32_t new_capacity = hook->iat.chain_capacity ? (hook->iat.chain_capacity * 2) : SUBSTITUTE_INITIAL_CHAINS;
+
+        uint64_t* new_chains = new (Utils::MemoryTag_Substitute) uint64_t[new_capacity];
+        if (!new_chains) {
+            WriteLog(LL_Error, "Unable to grow the chain list (%d) !", new_capacity);
+            return false;
         }
 
-        if (hooks[i].hook_type == HOOKTYPE_IAT) {
-            if (hooks[i].process == p && hooks[i].iat.jmpslot_address == jmpslot_addr) {
-                *hook_id = i;
-                return true;
-            }
+        memset(new_chains, 0, sizeof(uint64_t) * new_capacity);
+
+        if (hook->iat.uap_chains) {
+            memcpy(new_chains, hook->iat.uap_chains, sizeof(uint64_t) * hook->iat.chain_count);
+            delete [] hook->iat.uap_chains;
         }
+
+        hook->iat.uap_chains = new_chains;
+        hook->iat.chain_capacity = new_capacity;
     }
 
-    *hook_id = -1;
-    return false;
+    hook->iat.uap_chains[hook->iat.chain_count] = chain;
+    hook->iat.chain_count++;
+    return true;
 }
 
 // Substitute : Find position by chains address
-int Substitute::FindPositionByChain(uint64_t* chains, uint64_t chain) {
-    if (!chains) {
+int Substitute::FindPositionByChain(SubstituteHook* hook, uint64_t chain) {
+    if (!hook || !hook->iat.uap_chains) {
         WriteLog(LL_Error, "Invalid argument !");
         return -1;
     }
 
-    for (int i = 0; i < SUBSTITUTE_MAX_CHAINS; i++) {
-        if (chains[i] == chain) {
+    for (uint32_t i = 0; i < hook->iat.chain_count; i++) {
+        if (hook->iat.uap_chains[i] == chain) {
             return i;
         }
     }
@@ -264,32 +381,21 @@ int Substitute::FindPositionByChain(uint64_t* chains, uint64_t chain) {
 }
 
 // Substitute : Get UAP Address of last occurence of a chains (MUTEX NEEDED)
-void* Substitute::FindLastChainOccurence(uint64_t* chains, int* position) {
-    if (!chains || !position) {
+void* Substitute::FindLastChainOccurence(SubstituteHook* hook, int* position) {
+    if (!hook || !hook->iat.uap_chains || !position) {
         WriteLog(LL_Error, "Invalid argument !");
         return nullptr;
     }
 
-    for (int i = 0; i < SUBSTITUTE_MAX_CHAINS; i++) {
-        if (chains[i] == 0) {
-
-            if ( (i-1) < 0 )
-                return nullptr;
-            *position = (i-1);
-            return (void*)chains[i-1];
-        }
-    }
+    if (hook->iat.chain_count == 0)
+        return nullptr;
 
-    return nullptr;
+    *position = (hook->iat.chain_count - 1);
+    return (void*)hook->iat.uap_chains[hook->iat.chain_count - 1];
 }
 
 // Substitute : Hook the function in the process (With Import Address Table)
 int Substitute::HookIAT(struct proc* p, struct substitute_hook_uat* chain, const char* module_name, const char* name, int32_t flags, void* hook_function) {
-    auto _mtx_lock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_lock_flags);
-    auto _mtx_unlock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_unlock_flags);
-
-    int r_error = 0;
-
     if (!p || !name || !hook_function || !chain) {
         WriteLog(LL_Error, "One of the parameter is incorrect !");
         WriteLog(LL_Error, "p: %p", p);
@@ -300,13 +406,38 @@ int Substitute::HookIAT(struct proc* p, struct substitute_hook_uat* chain, const
         return SUBSTITUTE_BAD_ARGS;
     }
 
+    struct sx* dynlib_bind_lock = LockDynlib(p);
+    if (!dynlib_bind_lock)
+        return SUBSTITUTE_INVALID;
+
     // Get the jmpslot offset for this nids (Work like an id for detect if hook already present)
-    void* jmpslot_address = (void*)FindJmpslotAddress(p, module_name, name, flags);
+    void* jmpslot_address = (void*)FindJmpslotAddressLocked(p, module_name, name, flags);
+
+    // Only needed if nothing hooked this jmpslot yet, but resolve it under the same lock
+    void* original_function = nullptr;
+    if (jmpslot_address)
+        original_function = FindOriginalAddressLocked(p, name, flags);
+
+    UnlockDynlib(dynlib_bind_lock);
+
     if (!jmpslot_address) {
         WriteLog(LL_Error, "Unable to find the jmpslot address !");
         return SUBSTITUTE_INVALID;
     }
 
+    return InstallIAT(p, chain, jmpslot_address, original_function, hook_function);
+}
+
+// Substitute : Hook an already resolved jmpslot, or chain on the hook already there
+int Substitute::InstallIAT(struct proc* p, struct substitute_hook_uat* chain, void* jmpslot_address, void* original_function, void* hook_function) {
+    auto _mtx_lock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_unlock_flags);
+
+    int r_error = 0;
+
+    if (!p || !chain || !jmpslot_address || !hook_function)
+        return SUBSTITUTE_BAD_ARGS;
+
     _mtx_lock_flags(&hook_mtx, 0, __FILE__, __LINE__);
 
     // Find if something is similar for this process
@@ -315,7 +446,7 @@ int Substitute::HookIAT(struct proc* p, struct substitute_hook_uat* chain, const
     if (FindJmpslotSimilarity(p, jmpslot_address, &hook_id)) {
         // Similarity : Rebuild the hook chain for handle new hook of same function/process
         WriteLog(LL_Info, "Similarity : Rebuild the hook chain");
-        SubstituteHook* hook = GetHookByID(hook_id);
+        SubstituteHook* hook = GetHookByID(p, hook_id);
 
         if (!hook) {
             WriteLog(LL_Error, "Unable to get the hook !");
@@ -332,16 +463,15 @@ int Substitute::HookIAT(struct proc* p, struct substitute_hook_uat* chain, const
 
         // Find lasted chain uap position and address
         int last_chain_position = -1;
-        void* last_chain_addr = FindLastChainOccurence(hook->iat.uap_chains, &last_chain_position);
+        void* last_chain_addr = FindLastChainOccurence(hook, &last_chain_position);
         if (!last_chain_addr || last_chain_position < 0) {
             WriteLog(LL_Error, "Unable to get the lasted chain address.");
             _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
             return SUBSTITUTE_INVALID;
         }
 
-        // Determinate if we have space for write
-        if ( (last_chain_position + 1) > SUBSTITUTE_MAX_CHAINS ) {
-            WriteLog(LL_Error, "SUBSTITUTE_MAX_CHAINS reached !");
+        // Make room for the new chain before touching the process
+        if (!AppendChain(hook, (uint64_t)chain)) {
             _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
             
             return SUBSTITUTE_NOMEM;
@@ -351,6 +481,7 @@ int Substitute::HookIAT(struct proc* p, struct substitute_hook_uat* chain, const
         r_error = proc_rw_mem(p, chain, sizeof(struct substitute_hook_uat), &current_chain, nullptr, true);
         if (r_error != 0) {
             WriteLog(LL_Error, "Unable to write chains structure: (%i)", r_error);
+            hook->iat.chain_count--;
             _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
             
             return SUBSTITUTE_INVALID;
@@ -361,6 +492,7 @@ int Substitute::HookIAT(struct proc* p, struct substitute_hook_uat* chain, const
         r_error = proc_rw_mem(p, last_chain_addr, sizeof(struct substitute_hook_uat), &last_chain, nullptr, false);
         if (r_error != 0) {
             WriteLog(LL_Error, "Unable to read the last chain: (%d)", r_error);
+            hook->iat.chain_count--;
             _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
             
             return SUBSTITUTE_INVALID;
@@ -373,19 +505,16 @@ int Substitute::HookIAT(struct proc* p, struct substitute_hook_uat* chain, const
         r_error = proc_rw_mem(p, last_chain_addr, sizeof(struct substitute_hook_uat), &last_chain, nullptr, true);
         if (r_error != 0) {
             WriteLog(LL_Error, "Unable to write chains structure: (%i)", r_error);
+            hook->iat.chain_count--;
             _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
             
             return SUBSTITUTE_INVALID;
         }
-
-        // Write the new chain address into the chain structure
-        hook->iat.uap_chains[(last_chain_position + 1)] = (uint64_t)chain;
     } else {
         // No similarity : Build a new hook block
         WriteLog(LL_Info, "No similarity : Build a new hook block ...");
 
-        // Get the original value for this jmpslot
-        void* original_function = FindOriginalAddress(p, name, flags);
+        // The original value for this jmpslot
         if (!original_function) {
             WriteLog(LL_Error, "Unable to get the original value from the jmpslot !");
             _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
@@ -394,16 +523,24 @@ int Substitute::HookIAT(struct proc* p, struct substitute_hook_uat* chain, const
         }
 
         hook_id = -1;
-        SubstituteHook* new_hook = AllocateHook(&hook_id);
+        SubstituteHook* new_hook = AllocateHook(p, &hook_id);
         if (!new_hook || hook_id < 0) {
             WriteLog(LL_Error, "Unable to allocate new hook (%p => %d) !", new_hook, hook_id);
             _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
             return SUBSTITUTE_NOMEM;
         }
 
+        // Set default value
+        new_hook->hook_type = HOOKTYPE_IAT;
+        new_hook->iat.jmpslot_address = jmpslot_address;
+        new_hook->iat.original_function = original_function;
+
         // Initialize chains
-        uint64_t* chains = new uint64_t[SUBSTITUTE_MAX_CHAINS];
-        memset(chains, 0, sizeof(uint64_t) * SUBSTITUTE_MAX_CHAINS);
+        if (!AppendChain(new_hook, (uint64_t)chain)) {
+            FreeHook(p, hook_id);
+            _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
+            return SUBSTITUTE_NOMEM;
+        }
 
         // Setup uat values
         struct substitute_hook_uat setup;
@@ -416,33 +553,25 @@ int Substitute::HookIAT(struct proc* p, struct substitute_hook_uat* chain, const
         r_error = proc_rw_mem(p, chain, sizeof(struct substitute_hook_uat), &setup, nullptr, true);
         if (r_error != 0) {
             WriteLog(LL_Error, "Unable to write chains structure: (%i)", r_error);
+            FreeHook(p, hook_id);
             _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
-            
-            // Free memory
-            delete [] chains;
             return SUBSTITUTE_INVALID;
         }
 
-        // Write the first chains address
-        chains[0] = (uint64_t)chain;
-
-        // Set default value
-        new_hook->process = p;
-        new_hook->hook_type = HOOKTYPE_IAT;
-        new_hook->iat.uap_chains = chains;
-        new_hook->iat.jmpslot_address = jmpslot_address;
-        new_hook->iat.original_function = original_function;
-
         // Enable first hook !
         // Overwrite the jmpslot slot address
         r_error = proc_rw_mem(p, jmpslot_address, sizeof(void*), &hook_function, nullptr, true);
         if (r_error != 0) {
             WriteLog(LL_Error, "Unable to write to the jmpslot address: (%d)", r_error);
+            FreeHook(p, hook_id);
             _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
-            
-            delete[] chains;
             return SUBSTITUTE_INVALID;
         }
+
+        // Next hooks on this jmpslot get chained to this one
+        SubstituteProcessHooks* process_hooks = GetProcessHooks(p, false);
+        if (!process_hooks || !process_hooks->jmpslots.Insert((uint64_t)jmpslot_address, hook_id))
+            WriteLog(LL_Error, "Unable to index the jmpslot (%p), next hooks will not be chained !", jmpslot_address);
     }
 
     _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
@@ -476,7 +605,7 @@ int Substitute::HookJmp(struct proc* p, void* original_address, void* hook_funct
     }
 
     // Malloc data for the backup data
-    char* backupData = new char[backupSize];
+    char* backupData = new (Utils::MemoryTag_Substitute) char[backupSize];
     if (!backupData) {
         WriteLog(LL_Error, "Unable to allocate memory for backup");
         return SUBSTITUTE_NOMEM;
@@ -494,15 +623,15 @@ int Substitute::HookJmp(struct proc* p, void* original_address, void* hook_funct
     _mtx_lock_flags(&hook_mtx, 0, __FILE__, __LINE__);
 
     int hook_id = -7;
-    SubstituteHook* new_hook = AllocateHook(&hook_id);
+    SubstituteHook* new_hook = AllocateHook(p, &hook_id);
     if (!new_hook || hook_id < 0) {
         WriteLog(LL_Error, "Unable to allocate new hook (%p => %d) !", new_hook, hook_id);
         _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
+        delete[] (backupData);
         return SUBSTITUTE_NOMEM;
     }
 
     // Set default value
-    new_hook->process = p;
     new_hook->hook_type = HOOKTYPE_JMP;
     new_hook->jmp.jmpto = hook_function;
     new_hook->jmp.orig_addr = original_address;
@@ -516,6 +645,107 @@ int Substitute::HookJmp(struct proc* p, void* original_address, void* hook_funct
     return hook_id;
 }
 
+// Substitute : Create multiple hooks, every jmpslot is resolved under a single dynlib lock
+int Substitute::HookBatch(struct proc* p, struct substitute_hook_batch_entry* entries, int count) {
+    if (!p || !entries || count <= 0)
+        return SUBSTITUTE_BAD_ARGS;
+
+    // Kernel copies of the resolved addresses, only used by IAT entries
+    void** jmpslots = new (Utils::MemoryTag_Substitute) void*[count * 2];
+    if (!jmpslots)
+        return SUBSTITUTE_NOMEM;
+
+    void** originals = jmpslots + count;
+    memset(jmpslots, 0, sizeof(void*) * count * 2);
+
+    // Resolve pass
+    bool has_iat = false;
+    for (int i = 0; i < count; i++) {
+        if (entries[i].hook_type == HOOKTYPE_IAT) {
+            has_iat = true;
+            break;
+        }
+    }
+
+    if (has_iat) {
+        struct sx* dynlib_bind_lock = LockDynlib(p);
+
+        for (int i = 0; i < count && dynlib_bind_lock; i++) {
+            struct substitute_hook_batch_entry* entry = &entries[i];
+            if (entry->hook_type != HOOKTYPE_IAT)
+                continue;
+
+            // Userland strings, make sure they end somewhere
+            entry->name[SUBSTITUTE_MAX_NAME - 1] = '\0';
+            entry->module_name[SUBSTITUTE_MAX_NAME - 1] = '\0';
+
+            jmpslots[i] = (void*)FindJmpslotAddressLocked(p, entry->module_name, entry->name, entry->flags);
+            if (jmpslots[i])
+                originals[i] = FindOriginalAddressLocked(p, entry->name, entry->flags);
+        }
+
+        if (dynlib_bind_lock)
+            UnlockDynlib(dynlib_bind_lock);
+    }
+
+    // Write pass
+    int created = 0;
+    for (int i = 0; i < count; i++) {
+        struct substitute_hook_batch_entry* entry = &entries[i];
+        int ret = SUBSTITUTE_BAD_ARGS;
+
+        switch (entry->hook_type) {
+            case HOOKTYPE_IAT: {
+                if (!entry->chain || !entry->hook_function) {
+                    ret = SUBSTITUTE_BAD_ARGS;
+                    break;
+                }
+
+                if (!jmpslots[i]) {
+                    WriteLog(LL_Error, "Unable to find the jmpslot address for %s !", entry->name);
+                    ret = SUBSTITUTE_INVALID;
+                    break;
+                }
+
+                ret = InstallIAT(p, entry->chain, jmpslots[i], originals[i], entry->hook_function);
+                break;
+            }
+
+            case HOOKTYPE_JMP: {
+                ret = HookJmp(p, entry->original_function, entry->hook_function);
+                if (ret >= 0 && entry->enable) {
+                    int hook_id = ret;
+                    int r_error = EnableHook(p, hook_id);
+                    if (r_error != SUBSTITUTE_OK) {
+                        Unhook(p, hook_id, nullptr);
+                        ret = SUBSTITUTE_BADLOGIC;
+                    }
+                }
+
+                break;
+            }
+
+            default: {
+                WriteLog(LL_Error, "Invalid type of hook was detected.");
+                break;
+            }
+        }
+
+        if (ret >= 0) {
+            entry->hook_id = ret;
+            entry->result = SUBSTITUTE_OK;
+            created++;
+        } else {
+            entry->hook_id = -1;
+            entry->result = ret;
+        }
+    }
+
+    delete [] jmpslots;
+
+    return created;
+}
+
 // Substitute : Disable the hook
 int Substitute::DisableHook(struct proc* p, int hook_id) {
     auto _mtx_lock_flags = (void(*)(struct mtx *m, int opts, const char *file, int line))kdlsym(_mtx_lock_flags);
@@ -525,7 +755,7 @@ int Substitute::DisableHook(struct proc* p, int hook_id) {
     
     _mtx_lock_flags(&hook_mtx, 0, __FILE__, __LINE__);
 
-    SubstituteHook* hook = GetHookByID(hook_id);
+    SubstituteHook* hook = GetHookByID(p, hook_id);
     if (!hook) {
         WriteLog(LL_Error, "The hook %i is not found !.", hook_id);
         _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
@@ -587,7 +817,7 @@ int Substitute::EnableHook(struct proc* p, int hook_id) {
 
     _mtx_lock_flags(&hook_mtx, 0, __FILE__, __LINE__);
 
-    SubstituteHook* hook = GetHookByID(hook_id);
+    SubstituteHook* hook = GetHookByID(p, hook_id);
     if (!hook) {
         _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
         return -1;
@@ -656,7 +886,7 @@ int Substitute::Unhook(struct proc* p, int hook_id, struct substitute_hook_uat*
 
     _mtx_lock_flags(&hook_mtx, 0, __FILE__, __LINE__);
 
-    SubstituteHook* hook = GetHookByID(hook_id);
+    SubstituteHook* hook = GetHookByID(p, hook_id);
     if (!hook) {
         WriteLog(LL_Error, "The hook %i is not found !.", hook_id);
         _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
@@ -683,7 +913,7 @@ int Substitute::Unhook(struct proc* p, int hook_id, struct substitute_hook_uat*
             }
 
             // I get the current position on the chain
-            int chain_position = FindPositionByChain(hook->iat.uap_chains, (uint64_t)chain);
+            int chain_position = FindPositionByChain(hook, (uint64_t)chain);
             if (chain_position < 0) {
                 WriteLog(LL_Error, "Unable to get the current chain position: (%d)", chain_position);
                 _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
@@ -705,7 +935,7 @@ int Substitute::Unhook(struct proc* p, int hook_id, struct substitute_hook_uat*
                 }
 
                 uint64_t next_addr = 0;
-                if ( (chain_position+1) < SUBSTITUTE_MAX_CHAINS ) {
+                if ( (uint32_t)(chain_position+1) < hook->iat.chain_count ) {
                     next_addr = hook->iat.uap_chains[chain_position+1];
                 }
 
@@ -715,7 +945,9 @@ int Substitute::Unhook(struct proc* p, int hook_id, struct substitute_hook_uat*
 
                 // Get the next function chain
                 struct substitute_hook_uat next;
-                void* next_addr = (void*)hook->iat.uap_chains[1];
+                void* next_addr = nullptr;
+                if (hook->iat.chain_count > 1)
+                    next_addr = (void*)hook->iat.uap_chains[1];
 
                 // Read the next chain
                 r_error = proc_rw_mem(p, next_addr, sizeof(struct substitute_hook_uat), &next, nullptr, false);
@@ -740,18 +972,16 @@ int Substitute::Unhook(struct proc* p, int hook_id, struct substitute_hook_uat*
             }
 
             // Update the chains table !
-            for (int i = chain_position; i < SUBSTITUTE_MAX_CHAINS; i++) {
-                if (hook->iat.uap_chains[i] == 0)
-                    break;
+            for (uint32_t i = chain_position; (i+1) < hook->iat.chain_count; i++)
+                hook->iat.uap_chains[i] = hook->iat.uap_chains[i+1];
 
-                if ( (i+1) < SUBSTITUTE_MAX_CHAINS)
-                    hook->iat.uap_chains[i] = hook->iat.uap_chains[i+1];
-            }
+            hook->iat.chain_count--;
+            hook->iat.uap_chains[hook->iat.chain_count] = 0;
         }
 
         case HOOKTYPE_JMP: {
             // Simply free the space :)
-            FreeHook(hook_id);
+            FreeHook(p, hook_id);
         }
     }
 
@@ -771,9 +1001,12 @@ void Substitute::CleanupAllHook() {
 
     _mtx_lock_flags(&hook_mtx, 0, __FILE__, __LINE__);
 
-    for (int i = 0; i < SUBSTITUTE_MAX_HOOKS; i++) {
-        FreeHook(i);
-    }
+    m_ProcessHooks.ForEach([](struct proc* const&, SubstituteProcessHooks*& process_hooks)
+    {
+        DestroyProcessHooks(process_hooks);
+        return true;
+    });
+    m_ProcessHooks.Clear();
 
     _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
 }
@@ -792,11 +1025,10 @@ void Substitute::CleanupProcessHook(struct proc* p) {
 
     _mtx_lock_flags(&hook_mtx, 0, __FILE__, __LINE__);
 
-    for (int i = 0; i < SUBSTITUTE_MAX_HOOKS; i++) {
-        SubstituteHook* hook = GetHookByID(i);
-        if (hook && hook->process == p) {
-            FreeHook(i);
-        }
+    SubstituteProcessHooks* process_hooks = GetProcessHooks(p, false);
+    if (process_hooks) {
+        m_ProcessHooks.Remove(p);
+        DestroyProcessHooks(process_hooks);
     }
 
     _mtx_unlock_flags(&hook_mtx, 0, __FILE__, __LINE__);
@@ -806,62 +1038,102 @@ void Substitute::CleanupProcessHook(struct proc* p) {
 // IAT HOOK UTILITY
 //////////////////////////
 
-// Substitute : Find original function address by this name (or nids)
-void* Substitute::FindOriginalAddress(struct proc* p, const char* name, int32_t flags)
+// Substitute : Lock the dynlib objects of the process, nullptr if it is not dynamic linkable
+struct sx* Substitute::LockDynlib(struct proc* p)
 {
     auto A_sx_xlock_hard = (int (*)(struct sx *sx, int opts))kdlsym(_sx_xlock);
+
+    if (!p)
+        return nullptr;
+
+    if (!p->p_dynlib) {
+        char* s_TitleId = (char*)((uint64_t)p + 0x390);
+        WriteLog(LL_Error, "[%s] The process is not Dynamic Linkable", s_TitleId);
+        return nullptr;
+    }
+
+    // Lock dynlib object (Note: Locking will panic kernel sometime)
+    struct sx* dynlib_bind_lock = (struct sx*)((uint64_t)p->p_dynlib + 0x70);
+    A_sx_xlock_hard(dynlib_bind_lock, 0);
+
+    return dynlib_bind_lock;
+}
+
+// Substitute : Unlock the dynlib objects locked by LockDynlib
+void Substitute::UnlockDynlib(struct sx* dynlib_bind_lock)
+{
     auto A_sx_xunlock_hard = (int (*)(struct sx *sx))kdlsym(_sx_xunlock);
 
+    if (dynlib_bind_lock)
+        A_sx_xunlock_hard(dynlib_bind_lock);
+}
+
+// Substitute : Find original function address by this name (or nids)
+void* Substitute::FindOriginalAddress(struct proc* p, const char* name, int32_t flags)
+{
+    struct sx* dynlib_bind_lock = LockDynlib(p);
+    if (!dynlib_bind_lock)
+        return nullptr;
+
+    void* addr = FindOriginalAddressLocked(p, name, flags);
+
+    UnlockDynlib(dynlib_bind_lock);
+
+    return addr;
+}
+
+// Substitute : Find original function address by this name (or nids) (DYNLIB LOCK NEEDED)
+void* Substitute::FindOriginalAddressLocked(struct proc* p, const char* name, int32_t flags)
+{
     auto dynlib_do_dlsym = (void*(*)(void* dl, void* obj, const char* name, const char* libname, unsigned int flags))kdlsym(dynlib_do_dlsym);
 
     char* s_TitleId = (char*)((uint64_t)p + 0x390);
     void* addr = nullptr;
 
-    if (p->p_dynlib) {
-        // Lock dynlib object
-        struct sx* dynlib_bind_lock = (struct sx*)((uint64_t)p->p_dynlib + 0x70);
-        A_sx_xlock_hard(dynlib_bind_lock, 0);
+    // Look the name up once instead of letting dynlib_do_dlsym hash it for every object
+    char nids[NidDatabase_NidSize] = { 0 };
+    if ( !(flags & SUBSTITUTE_IAT_NIDS) ) {
+        if (!m_NidDatabase.GetNid(name, nids))
+            return nullptr;
 
-        uint64_t main_dylib_obj = *(uint64_t*)((uint64_t)p->p_dynlib + 0x10);
+        name = nids;
+        flags |= SUBSTITUTE_IAT_NIDS;
+    }
 
-        if (main_dylib_obj) {
-            // Search in all library
-            int total = 0;
-            uint64_t dynlib_obj = main_dylib_obj;
-            for (;;) {
-                total++;
+    uint64_t main_dylib_obj = *(uint64_t*)((uint64_t)p->p_dynlib + 0x10);
 
-                /*
-                char* lib_name = (char*)(*(uint64_t*)(dynlib_obj + 8));
-                void* relocbase = (void*)(*(uint64_t*)(dynlib_obj + 0x70));
-                uint64_t handle = *(uint64_t*)(dynlib_obj + 0x28);
+    if (main_dylib_obj) {
+        // Search in all library
+        int total = 0;
+        uint64_t dynlib_obj = main_dylib_obj;
+        for (;;) {
+            total++;
 
-                WriteLog(LL_Info, "[%s] search(%i): %p lib_name: %s handle: 0x%lx relocbase: %p ...", s_TitleId, total, (void*)dynlib_obj, lib_name, handle, relocbase);
-                */
+            /*
+            char* lib_name = (char*)(*(uint64_t*)(dynlib_obj + 8));
+            void* relocbase = (void*)(*(uint64_t*)(dynlib_obj + 0x70));
+            uint64_t handle = *(uint64_t*)(dynlib_obj + 0x28);
 
-                // Doing a dlsym with nids or name
-                if ( (flags & SUBSTITUTE_IAT_NIDS) ) {
-                    addr = dynlib_do_dlsym((void*)p->p_dynlib, (void*)dynlib_obj, name, NULL, 0x1); // name = nids
-                } else {
-                    addr = dynlib_do_dlsym((void*)p->p_dynlib, (void*)dynlib_obj, name, NULL, 0x0); // use name (dynlib_do_dlsym will calculate later)
-                }
+            WriteLog(LL_Info, "[%s] search(%i): %p lib_name: %s handle: 0x%lx relocbase: %p ...", s_TitleId, total, (void*)dynlib_obj, lib_name, handle, relocbase);
+            */
 
-                if (addr) {
-                    break;
-                }
+            // Doing a dlsym with nids or name
+            if ( (flags & SUBSTITUTE_IAT_NIDS) ) {
+                addr = dynlib_do_dlsym((void*)p->p_dynlib, (void*)dynlib_obj, name, NULL, 0x1); // name = nids
+            } else {
+                addr = dynlib_do_dlsym((void*)p->p_dynlib, (void*)dynlib_obj, name, NULL, 0x0); // use name (dynlib_do_dlsym will calculate later)
+            }
 
-                dynlib_obj = *(uint64_t*)(dynlib_obj);
-                if (!dynlib_obj)
-                    break;
+            if (addr) {
+                break;
             }
-        } else {
-            WriteLog(LL_Error, "[%s] Unable to find main object !", s_TitleId);
-        }
 
-        // Unlock dynlib object
-        A_sx_xunlock_hard(dynlib_bind_lock);
+            dynlib_obj = *(uint64_t*)(dynlib_obj);
+            if (!dynlib_obj)
+                break;
+        }
     } else {
-        WriteLog(LL_Error, "[%s] The process is not Dynamic Linkable", s_TitleId);
+        WriteLog(LL_Error, "[%s] Unable to find main object !", s_TitleId);
     }
 
     return addr;
@@ -869,12 +1141,27 @@ void* Substitute::FindOriginalAddress(struct proc* p, const char* name, int32_t
 
 // Substitute : Find pre-offset from the name or nids
 uint64_t Substitute::FindJmpslotAddress(struct proc* p, const char* module_name, const char* name, int32_t flags) {
-    auto A_sx_xlock_hard = (int (*)(struct sx *sx, int opts))kdlsym(_sx_xlock);
-    auto A_sx_xunlock_hard = (int (*)(struct sx *sx))kdlsym(_sx_xunlock);
+    if (!name || !p) {
+        WriteLog(LL_Error, "Invalid argument.");
+        return 0;   
+    }
+
+    struct sx* dynlib_bind_lock = LockDynlib(p);
+    if (!dynlib_bind_lock)
+        return 0;
+
+    uint64_t nids_offset_found = FindJmpslotAddressLocked(p, module_name, name, flags);
+
+    UnlockDynlib(dynlib_bind_lock);
+
+    return nids_offset_found;
+}
+
+// Substitute : Find pre-offset from the name or nids (DYNLIB LOCK NEEDED)
+uint64_t Substitute::FindJmpslotAddressLocked(struct proc* p, const char* module_name, const char* name, int32_t flags) {
     auto strncmp = (int(*)(const char *, const char *, size_t))kdlsym(strncmp);
     auto strstr = (char *(*)(const char *haystack, const char *needle) )kdlsym(strstr);
     auto snprintf = (int(*)(char *str, size_t size, const char *format, ...))kdlsym(snprintf);
-    auto name_to_nids = (void(*)(const char *name, const char *nids_out))kdlsym(name_to_nids);
 
     if (!name || !p) {
         WriteLog(LL_Error, "Invalid argument.");
@@ -889,107 +1176,42 @@ uint64_t Substitute::FindJmpslotAddress(struct proc* p, const char* module_name,
     if ( (flags & SUBSTITUTE_IAT_NIDS) ) {
         snprintf(nids, sizeof(nids), "%s", name); // nids = name
     } else {
-        name_to_nids(name, nids); // nids calculated by name
+        m_NidDatabase.GetNid(name, nids); // nids calculated by name
     }
 
     uint64_t nids_offset_found = 0;
 
-    if (p->p_dynlib) {
-        // Lock dynlib object (Note: Locking will panic kernel sometime)
-        struct sx* dynlib_bind_lock = (struct sx*)((uint64_t)p->p_dynlib + 0x70);
-        A_sx_xlock_hard(dynlib_bind_lock, 0);
+    uint64_t main_dylib_obj = *(uint64_t*)((uint64_t)p->p_dynlib + 0x10);
 
-        uint64_t main_dylib_obj = *(uint64_t*)((uint64_t)p->p_dynlib + 0x10);
+    if (main_dylib_obj) {
+        // Search in all library
+        uint64_t dynlib_obj = main_dylib_obj;
 
-        if (main_dylib_obj) {
-            // Search in all library
-            uint64_t dynlib_obj = main_dylib_obj;
-
-            // Check if we not are in the main executable
-            if (strncmp(module_name, SUBSTITUTE_MAIN_MODULE, SUBSTITUTE_MAX_NAME) != 0) {
-                for (;;) {
-                    char* lib_name = (char*)(*(uint64_t*)(dynlib_obj + 8));
-
-                    // If the libname (a path) containt the module name, it's the good object, break it
-                    if (lib_name && strstr(lib_name, module_name)) {
-                        break;
-                    }
+        // Check if we not are in the main executable
+        if (strncmp(module_name, SUBSTITUTE_MAIN_MODULE, SUBSTITUTE_MAX_NAME) != 0) {
+            for (;;) {
+                char* lib_name = (char*)(*(uint64_t*)(dynlib_obj + 8));
 
-                    dynlib_obj = *(uint64_t*)(dynlib_obj);
-                    if (!dynlib_obj) {
-                        WriteLog(LL_Error, "Unable to find the library.");
-                        return 0; // Library not found
-                    }
+                // If the libname (a path) containt the module name, it's the good object, break it
+                if (lib_name && strstr(lib_name, module_name)) {
+                    break;
                 }
-            }
 
-            // Get the main relocbase address, for calculation after
-            uint64_t relocbase = (uint64_t)(*(uint64_t*)(dynlib_obj + 0x70));
-
-            uint64_t unk_obj = *(uint64_t*)(dynlib_obj + 0x150);
-            if (unk_obj) {
-                uint64_t string_table = *(uint64_t*)(unk_obj + 0x38);
-
-                uint64_t unk_obj_size_in_unk_obj = *(uint64_t*)(unk_obj + 0x50);
-                uint64_t unk_obj_in_obj = *(uint64_t*)(unk_obj + 0x48);
-
-                // Idk what is it ^^', check it anyway, conform to Sony kernel
-                if (unk_obj_in_obj && unk_obj_size_in_unk_obj) {
-                    uint64_t current = unk_obj_in_obj;
-                    uint64_t end_addr = unk_obj_in_obj + unk_obj_size_in_unk_obj;
-                    while(current < end_addr) 
-                    {
-                        uint64_t value_of_rcx = (*(uint64_t*)(current + 0x8)) >> 32;
-                        uint64_t value_of_rdx = value_of_rcx * 24;
-
-                        uint64_t nids_offset = 0;
-                        if (*(uint64_t*)(unk_obj + 0x30) <= value_of_rdx) {
-                            nids_offset = 0;
-                        } else {
-                            uint64_t nids_offset_ptr = *(uint64_t*)(unk_obj + 0x28) + value_of_rdx;
-                            nids_offset = (uint64_t)(*(uint32_t*)(nids_offset_ptr));
-                        }
-
-                        uint64_t nids_ptr_validation = *(uint64_t*)(unk_obj + 0x40);
-                        if (nids_ptr_validation <= nids_offset) {
-                             WriteLog(LL_Error, "[%s] (%p <= %p) : Error", s_TitleId, (void*)nids_ptr_validation, (void*)nids_offset);
-                        } else {
-                            nids_offset += string_table;
-
-                            /* uint64_t r_info = *(uint64_t*)(current + 0x8); */
-
-                            uint64_t r_offset = *(uint64_t*)(current);
-
-                            char* nids_f = (char*)nids_offset;
-
-                            // If the nids_offset is a valid address
-                            if (nids_f) {
-                                // Check if it's the good nids
-                                if (strncmp(nids_f, nids, 11) == 0) {
-                                    nids_offset_found = relocbase + r_offset;
-                                    break;
-                                }
-                            }
-                        }
-
-                        current += 0x18;
-                    }
-                } else {
-                    WriteLog(LL_Error, "[%s] Not conform to Sony code.", s_TitleId);
-                    WriteLog(LL_Error, "[%s] unk_obj_in_obj: %p", s_TitleId, (void*)unk_obj_in_obj);
-                    WriteLog(LL_Error, "[%s] unk_obj_size_in_unk_obj: %p", s_TitleId, (void*)unk_obj_size_in_unk_obj);
+                dynlib_obj = *(uint64_t*)(dynlib_obj);
+                if (!dynlib_obj) {
+                    break;
                 }
-            } else {
-                WriteLog(LL_Error, "[%s] Unable to find unk object !", s_TitleId);
             }
-        } else {
-            WriteLog(LL_Error, "[%s] Unable to find main object !", s_TitleId);
         }
 
-        // Unlock dynlib object
-        A_sx_xunlock_hard(dynlib_bind_lock);
+        if (dynlib_obj) {
+            // The relocation table is indexed the first time the object is used
+            nids_offset_found = m_JmpslotCache.Find(p, dynlib_obj, nids);
+        } else {
+            WriteLog(LL_Error, "Unable to find the library.");
+        }
     } else {
-        WriteLog(LL_Error, "[%s] The process is not Dynamic Linkable", s_TitleId);
+        WriteLog(LL_Error, "[%s] Unable to find main object !", s_TitleId);
     }
 
     return nids_offset_found;
@@ -1004,7 +1226,6 @@ uint64_t Substitute::FindJmpslotAddress(struct proc* p, const char* module_name,
 void Substitute::LoadAllPrx(struct thread* td, const char* folder_path)
 {
     auto snprintf = (int(*)(char *str, size_t size, const char *format, ...))kdlsym(snprintf);
-    auto strstr = (char *(*)(const char *haystack, const char *needle) )kdlsym(strstr);
 
     // Check for arguments
     if (!td || !folder_path) {
@@ -1014,94 +1235,64 @@ void Substitute::LoadAllPrx(struct thread* td, const char* folder_path)
 
     char* s_TitleId = (char*)((uint64_t)td->td_proc + 0x390);
 
-    // Opening substitute folder
-    auto s_DirectoryHandle = kopen_t(folder_path, O_RDONLY | O_DIRECTORY, 0777, td);
-    if (s_DirectoryHandle > 0)
-    {
-        // Reading folder and search for sprx ...
-        uint64_t s_DentCount = 0;
-        char s_Buffer[0x1000] = { 0 };
-        memset(s_Buffer, 0, sizeof(s_Buffer));
-        int32_t s_ReadCount = 0;
-        for (;;)
-        {
-            memset(s_Buffer, 0, sizeof(s_Buffer));
-            s_ReadCount = kgetdents_t(s_DirectoryHandle, s_Buffer, sizeof(s_Buffer), td);
-            if (s_ReadCount <= 0)
-                break;
-                        
-            for (auto l_Pos = 0; l_Pos < s_ReadCount;)
-            {
-                auto l_Dent = (struct dirent*)(s_Buffer + l_Pos);
-                s_DentCount++;
-
-                // Check if the sprx is legit
-                if (strstr(l_Dent->d_name, ".sprx")) {
-                    // Generating relative path
-                    char s_RelativeSprxPath[PATH_MAX];
-                    snprintf(s_RelativeSprxPath, PATH_MAX, "%s%s", folder_path, l_Dent->d_name);
-
-                    // Create relative path for the load
-                    WriteLog(LL_Info, "[%s] Loading  %s ...", s_TitleId, s_RelativeSprxPath);
-                    Utilities::LoadPRXModule(td->td_proc, s_RelativeSprxPath);
-                    WriteLog(LL_Info, "Loading PRX Done !");
-                }
+    // Get the load order, only reads the folder when it changed since the last launch
+    auto s_Plan = m_LoadPlans.Get(td, s_TitleId, folder_path);
+    if (!s_Plan) {
+        WriteLog(LL_Error, "[%s] Could not get the load plan of %s", s_TitleId, folder_path);
+        return;
+    }
 
-                l_Pos += l_Dent->d_reclen;
-            }
-        }
+    const char* s_ModuleName = s_Plan->Names;
+    for (uint32_t i = 0; i < s_Plan->ModuleCount; i++) {
+        // Generating relative path
+        char s_RelativeSprxPath[PATH_MAX];
+        snprintf(s_RelativeSprxPath, PATH_MAX, "%s%s", folder_path, s_ModuleName);
 
-        // Closing substitute folder
-        kclose_t(s_DirectoryHandle, td);
+        // Create relative path for the load
+        WriteLog(LL_Info, "[%s] Loading  %s ...", s_TitleId, s_RelativeSprxPath);
+        Utilities::LoadPRXModule(td->td_proc, s_RelativeSprxPath);
+        WriteLog(LL_Info, "Loading PRX Done !");
 
-        // TODO: It's impossible to cleanup because page is needed after !
-        //WriteLog(LL_Info, "[%s] cleanup payload (fake result: %p)...", s_TitleId, (void*)uap->result);
-        //kmunmap_t(uap->result, 0x8000, td);
+        s_ModuleName += strlen(s_ModuleName) + 1;
     }
+
+    PrxLoadPlanCache::Destroy(s_Plan);
+
+    // TODO: It's impossible to cleanup because page is needed after !
+    //WriteLog(LL_Info, "[%s] cleanup payload (fake result: %p)...", s_TitleId, (void*)uap->result);
+    //kmunmap_t(uap->result, 0x8000, td);
 }
 
 // Substitute : Mount Substitute folder and prepare prx for load
-void Substitute::OnProcessStart(void *arg, struct proc *p)
+void Substitute::OnProcessStart(Mira::OrbisOS::ProcessInfo* info, void* arg)
 {
-    if (!p)
+    Substitute* substitute = static_cast<Substitute*>(arg);
+    if (!info || !substitute)
         return;
 
     auto snprintf = (int(*)(char *str, size_t size, const char *format, ...))kdlsym(snprintf);
-    auto vn_fullpath = (int(*)(struct thread *td, struct vnode *vp, char **retbuf, char **freebuf))kdlsym(vn_fullpath);
-
-    struct thread* s_ProcessThread = FIRST_THREAD_IN_PROC(p);
-    char* s_TitleId = (char*)((uint64_t)p + 0x390);
 
-    // Check if it's a valid process
-    if ( !s_TitleId || s_TitleId[0] == 0 )
-        return;
+    struct proc* p = info->Process;
+    const char* s_TitleId = info->TitleId;
 
     char s_SprxDirPath[PATH_MAX];
     snprintf(s_SprxDirPath, PATH_MAX, "/data/mira/substitute/%s/", s_TitleId);
 
     // Getting needed thread
     auto s_MainThread = Mira::Framework::GetFramework()->GetMainThread();
-    if (s_MainThread == nullptr || s_ProcessThread == nullptr)
+    if (s_MainThread == nullptr || info->Thread == nullptr)
     {
         WriteLog(LL_Error, "[%s] Could not get main or process thread", s_TitleId);
         WriteLog(LL_Error, "[%s] Main thread: %p", s_TitleId, s_MainThread);
-        WriteLog(LL_Error, "[%s] Process thread: %p", s_TitleId, s_ProcessThread);
+        WriteLog(LL_Error, "[%s] Process thread: %p", s_TitleId, info->Thread);
 
         return;
     }
 
     // Getting jailed path for the process
-    struct filedesc* fd = p->p_fd;
-
-    char* s_SandboxPath = nullptr;
-    char* s_Freepath = nullptr;
-    vn_fullpath(s_MainThread, fd->fd_jdir, &s_SandboxPath, &s_Freepath);
-
-    if (s_SandboxPath == nullptr) {
-        if (s_Freepath)
-            delete (s_Freepath);
+    const char* s_SandboxPath = info->GetSandboxPath();
+    if (s_SandboxPath == nullptr)
         return;
-    }
 
     // Get ucred and filedesc of current thread
     struct ucred* curthread_cred = curthread->td_proc->p_ucred;
@@ -1147,6 +1338,7 @@ void Substitute::OnProcessStart(void *arg, struct proc *p)
         WriteLog(LL_Error, "[%s] could not create the directory for mount (%s) (%d).", s_TitleId, s_substituteFullMountPath, ret);
         
         // Restore fd and cred
+        kclose_t(s_DirectoryHandle, s_MainThread);
         *curthread_fd = orig_curthread_fd;
         *curthread_cred = orig_curthread_cred;
         return;
@@ -1157,14 +1349,17 @@ void Substitute::OnProcessStart(void *arg, struct proc *p)
     if (ret < 0) {
         krmdir_t(s_substituteFullMountPath, s_MainThread);
         WriteLog(LL_Error, "[%s] could not mount folder (%s => %s) (%d).", s_TitleId, s_RealSprxFolderPath, s_substituteFullMountPath, ret);
+
+        // Restore fd and cred
+        kclose_t(s_DirectoryHandle, s_MainThread);
+        *curthread_fd = orig_curthread_fd;
+        *curthread_cred = orig_curthread_cred;
         return;
     }
 
-    // Cleanup
-    if (s_Freepath)
-        delete (s_Freepath);
-
-    s_SandboxPath = nullptr;
+    // Let Sys_dynlib_dlsym_hook and OnProcessExit know without having to look at the sandbox again
+    if (!substitute->m_MountedProcesses.Insert(p->p_pid, true))
+        WriteLog(LL_Error, "[%s] could not track process (%d), prx will not be loaded.", s_TitleId, p->p_pid);
 
     // Closing substitute folder
     kclose_t(s_DirectoryHandle, s_MainThread);
@@ -1175,64 +1370,45 @@ void Substitute::OnProcessStart(void *arg, struct proc *p)
     return;
 }
 
-// Substitute : Unmount Substitute folder
-void Substitute::OnProcessExit(void *arg, struct proc *p) {
-    if (!p)
+// Substitute : Unmount Substitute folder and cleanup hooks of the process
+void Substitute::OnProcessExit(Mira::OrbisOS::ProcessInfo* info, void* arg) {
+    Substitute* substitute = static_cast<Substitute*>(arg);
+    if (!info || !substitute)
         return;
 
     int ret = 0;
 
     // Get process information
-    struct thread* s_ProcessThread = FIRST_THREAD_IN_PROC(p);
-    char* s_TitleId = (char*)((uint64_t)p + 0x390);
-
-    Substitute* substitute = GetPlugin();
+    struct proc* p = info->Process;
+    const char* s_TitleId = info->TitleId;
 
-    auto snprintf = (int(*)(char *str, size_t size, const char *format, ...))kdlsym(snprintf);
-    auto vn_fullpath = (int(*)(struct thread *td, struct vnode *vp, char **retbuf, char **freebuf))kdlsym(vn_fullpath);
+    // The process' dynlib objects and hooks go away with it
+    substitute->m_JmpslotCache.RemoveProcess(p);
+    substitute->CleanupProcessHook(p);
 
-    // Check if it's a valid process
-    if ( !s_TitleId || s_TitleId[0] == 0 )
+    // Nothing got mounted for processes OnProcessStart did not track
+    if (!substitute->m_MountedProcesses.Remove(p->p_pid))
         return;
 
+    auto snprintf = (int(*)(char *str, size_t size, const char *format, ...))kdlsym(snprintf);
+
     // Getting needed thread
     auto s_MainThread = Mira::Framework::GetFramework()->GetMainThread();
-    if (s_MainThread == nullptr || s_ProcessThread == nullptr)
+    if (s_MainThread == nullptr)
     {
-        WriteLog(LL_Error, "[%s] Could not get main or process thread", s_TitleId);
-        WriteLog(LL_Error, "[%s] Main thread: %p", s_TitleId, s_MainThread);
-        WriteLog(LL_Error, "[%s] Process thread: %p", s_TitleId, s_ProcessThread);
+        WriteLog(LL_Error, "[%s] Could not get main thread", s_TitleId);
         return;
     }
 
-    // Start by cleanup hook list
-    substitute->CleanupProcessHook(p);
-
     // Getting jailed path for the process
-    struct filedesc* fd = p->p_fd;
-
-    char* s_SandboxPath = nullptr;
-    char* s_Freepath = nullptr;
-    vn_fullpath(s_MainThread, fd->fd_jdir, &s_SandboxPath, &s_Freepath);
-
-    if (s_SandboxPath == nullptr) {
-        if (s_Freepath)
-            delete (s_Freepath);
-
+    const char* s_SandboxPath = info->GetSandboxPath();
+    if (s_SandboxPath == nullptr)
         return;
-    }
 
     // Finding substitute folder
     char s_substituteFullMountPath[PATH_MAX];
     snprintf(s_substituteFullMountPath, PATH_MAX, "%s/substitute", s_SandboxPath);
 
-    auto s_DirectoryHandle = kopen_t(s_substituteFullMountPath, O_RDONLY | O_DIRECTORY, 0777, s_MainThread);
-    if (s_DirectoryHandle < 0)
-    {
-        return;
-    }
-    kclose_t(s_DirectoryHandle, s_MainThread);
-
     WriteLog(LL_Info, "[%s] Cleaning substitute ...", s_TitleId);
 
     // Unmount substitute folder if the folder exist
@@ -1248,45 +1424,40 @@ void Substitute::OnProcessExit(void *arg, struct proc *p) {
         return;
     }
 
-    if (s_Freepath)
-        delete (s_Freepath);
-
     WriteLog(LL_Info, "[%s] Substitute have been cleaned.", s_TitleId);
     return;
 }
 
 // Substitute : Load PRX from Substitute folder
 int Substitute::Sys_dynlib_dlsym_hook(struct thread* td, struct dynlib_dlsym_args* uap) {
+    MIRA_HOOK_STATS_SCOPE(Utils::HookStatsId_DynlibDlsym);
+
     Substitute* substitute = GetPlugin();
     if (!substitute) {
         WriteLog(LL_Error, "Substitute dependency is needed");
         return 1;
     }
 
-    auto snprintf = (int(*)(char *str, size_t size, const char *format, ...))kdlsym(snprintf);
     auto strncmp = (int(*)(const char *, const char *, size_t))kdlsym(strncmp);
     auto copyinstr = (int(*)(const void *uaddr, void *kaddr, size_t len, size_t *done))kdlsym(copyinstr);
     auto copyout = (int(*)(const void *kaddr, void *uaddr, size_t len))kdlsym(copyout);
-    auto vn_fullpath = (int(*)(struct thread *td, struct vnode *vp, char **retbuf, char **freebuf))kdlsym(vn_fullpath);
     auto sys_dynlib_dlsym = (int(*)(struct thread*, void*))substitute->sys_dynlib_dlsym_p;
     if (!sys_dynlib_dlsym)
         return 1;
 
-    // Call original syscall
-    int ret = sys_dynlib_dlsym(td, uap);
-    int original_td_value = td->td_retval[0];
-
     if (!td) {
         WriteLog(LL_Error, "Syscall called without thread ?");
-        return ret;
+        return 1;
     }
 
-    auto s_MainThread = Mira::Framework::GetFramework()->GetMainThread();
-    if (!s_MainThread)
-    {
-        WriteLog(LL_Error, "Unable to got Mira thread");
+    // Call original syscall
+    int ret = sys_dynlib_dlsym(td, uap);
+    int original_td_value = td->td_retval[0];
+
+    // Only processes that got the substitute folder mounted at start go further, that is the case
+    // for almost none of the dlsym calls so keep this before anything else
+    if (!substitute->m_MountedProcesses.Contains(td->td_proc->p_pid))
         return ret;
-    }
 
     char* s_TitleId = (char*)((uint64_t)td->td_proc + 0x390);
 
@@ -1296,34 +1467,6 @@ int Substitute::Sys_dynlib_dlsym_hook(struct thread* td, struct dynlib_dlsym_arg
         return ret;
     }
 
-    // Check if substitute folder exist on this process
-    struct filedesc* fd = td->td_proc->p_fd;
-
-    char* s_SandboxPath = nullptr;
-    char* s_Freepath = nullptr;
-    vn_fullpath(s_MainThread, fd->fd_jdir, &s_SandboxPath, &s_Freepath);
-
-    if (s_SandboxPath == nullptr) {
-        if (s_Freepath)
-            delete (s_Freepath);
-
-        td->td_retval[0] = original_td_value;
-        return ret;
-    }
-
-    // Finding substitute folder, if not exist simply doesn't continue the execution flow
-    char s_substituteFullMountPath[PATH_MAX];
-    snprintf(s_substituteFullMountPath, PATH_MAX, "%s/substitute", s_SandboxPath);
-
-    auto s_DirectoryHandle = kopen_t(s_substituteFullMountPath, O_RDONLY | O_DIRECTORY, 0777, s_MainThread);
-    if (s_DirectoryHandle < 0)
-    {
-        kclose_t(s_DirectoryHandle, s_MainThread);
-        td->td_retval[0] = original_td_value;
-        return ret;
-    }
-    kclose_t(s_DirectoryHandle, s_MainThread);
-
     char name[50]; // Todo: Find max name character !
     size_t done;
     copyinstr(uap->name, name, sizeof(name), &done);
@@ -1518,6 +1661,55 @@ int Substitute::OnIoctl_StateHook(struct thread* td, struct substitute_state_hoo
     return 0;
 }
 
+// Substitute (IOCTL) : Create multiple hooks at once
+int Substitute::OnIoctl_HookBatch(struct thread* td, struct substitute_hook_batch* uap) {
+    auto copyin = (int(*)(const void* uaddr, void* kaddr, size_t len))kdlsym(copyin);
+    auto copyout = (int(*)(const void *kaddr, void *uaddr, size_t len))kdlsym(copyout);
+
+    if (!td || !uap) {
+        WriteLog(LL_Error, "Invalid argument !");        
+        return EINVAL;
+    }
+
+    uap->result = SUBSTITUTE_BAD_ARGS;
+
+    Substitute* substitute = GetPlugin();
+    if (!substitute) {
+        WriteLog(LL_Error, "Unable to got substitute object !");
+        return 0;
+    }
+
+    if (!uap->entries || uap->count <= 0 || uap->count > SUBSTITUTE_MAX_BATCH) {
+        WriteLog(LL_Error, "Invalid batch (%p, %d) !", uap->entries, uap->count);
+        return 0;
+    }
+
+    size_t entries_size = sizeof(struct substitute_hook_batch_entry) * uap->count;
+    auto entries = new (Utils::MemoryTag_Substitute) struct substitute_hook_batch_entry[uap->count];
+    if (!entries) {
+        uap->result = SUBSTITUTE_NOMEM;
+        return 0;
+    }
+
+    int r_error = copyin(uap->entries, entries, entries_size);
+    if (r_error != 0) {
+        WriteLog(LL_Error, "Unable to copyin the batch (%d) !", r_error);
+        delete [] entries;
+        return r_error;
+    }
+
+    uap->result = substitute->HookBatch(td->td_proc, entries, uap->count);
+    WriteLog(LL_Info, "Batch created %d/%d hooks", uap->result, uap->count);
+
+    // Give back the hook id and result of every entry
+    r_error = copyout(entries, uap->entries, entries_size);
+    if (r_error != 0)
+        WriteLog(LL_Error, "Unable to copyout the batch results (%d) !", r_error);
+
+    delete [] entries;
+    return r_error;
+}
+
 // Substitute (IOCTL) : Main drive (See CtrlDriver in /src/Driver/)
 int32_t Substitute::OnIoctl(struct cdev* p_Device, u_long p_Command, caddr_t p_Data, int32_t p_FFlag, struct thread* p_Thread)
 {
@@ -1534,6 +1726,10 @@ int32_t Substitute::OnIoctl(struct cdev* p_Device, u_long p_Command, caddr_t p_D
             return Substitute::OnIoctl_StateHook(p_Thread, (struct substitute_state_hook*)p_Data);
         }
 
+        case SUBSTITUTE_HOOK_BATCH: {
+            return Substitute::OnIoctl_HookBatch(p_Thread, (struct substitute_hook_batch*)p_Data);
+        }
+
         default: {
             WriteLog(LL_Debug, "unknown command: (0x%llx).", p_Command);
             break;
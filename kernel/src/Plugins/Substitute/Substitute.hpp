@@ -2,7 +2,13 @@
 #include <Utils/IModule.hpp>
 #include <Utils/Types.hpp>
 #include <Utils/Hook.hpp>
+#include <Utils/HashMap.hpp>
+#include <Utils/ConcurrentHashMap.hpp>
 #include <Driver/CtrlDriver.hpp>
+#include "JmpslotCache.hpp"
+#include "NidDatabase.hpp"
+#include "PrxLoadPlan.hpp"
+#include <OrbisOS/ProcessEvents.hpp>
 
 extern "C"
 {
@@ -15,6 +21,7 @@ extern "C"
 
 struct proc;
 struct mtx;
+struct sx;
 
 struct dynlib_dlsym_args {
     int id;
@@ -38,8 +45,8 @@ struct entrypointhook_header {
 #define SUBSTITUTE_IOCTL_BASE   'S'
 #define SUBSTITUTE_MAX_NAME 255 // Max lenght for name
 #define SUBSTITUTE_MAIN_MODULE "" // Define the main module
-#define SUBSTITUTE_MAX_HOOKS 100 // Max possible hooks (all process)
-#define SUBSTITUTE_MAX_CHAINS 50 // Max possible function in chains
+#define SUBSTITUTE_INITIAL_CHAINS 4 // Chain slots allocated with a new IAT hook, grows when needed
+#define SUBSTITUTE_MAX_BATCH 128 // Max hooks in a single SUBSTITUTE_HOOK_BATCH
 
 /////////////////////////////////////////
 // Enumeration
@@ -86,6 +93,8 @@ struct SubstituteIAT {
     void* jmpslot_address; 
     void* original_function;
     uint64_t* uap_chains;
+    uint32_t chain_count;
+    uint32_t chain_capacity;
 };
 
 struct SubstituteHook {
@@ -95,6 +104,24 @@ struct SubstituteHook {
     struct SubstituteIAT iat;
 };
 
+// Every hook of a single process, hook ids are only unique within their process
+struct SubstituteProcessHooks {
+    // hook id -> hook
+    Mira::Utils::HashMap<int32_t, SubstituteHook*> hooks;
+
+    // jmpslot address -> id of the IAT hook chaining on it
+    Mira::Utils::HashMap<uint64_t, int32_t> jmpslots;
+
+    int32_t next_hook_id;
+
+    SubstituteProcessHooks() :
+        hooks(Mira::Utils::MemoryTag_Substitute),
+        jmpslots(Mira::Utils::MemoryTag_Substitute),
+        next_hook_id(0)
+    {
+    }
+};
+
 /////////////////////////////////////////
 // IOCTL Wrapper
 /////////////////////////////////////////
@@ -121,6 +148,25 @@ struct substitute_hook_jmp {
     void* hook_function;
 };
 
+struct substitute_hook_batch_entry {
+    int hook_type; // HOOKTYPE_IAT or HOOKTYPE_JMP
+    int flags; // IAT: SUBSTITUTE_IAT_NAME or SUBSTITUTE_IAT_NIDS
+    int enable; // JMP: enable the hook right after creating it
+    char name[SUBSTITUTE_MAX_NAME];
+    char module_name[SUBSTITUTE_MAX_NAME];
+    void* original_function; // JMP only
+    void* hook_function;
+    struct substitute_hook_uat* chain; // IAT only
+    int hook_id; // Out: id of the new hook, -1 on error
+    int result; // Out: SUBSTITUTE_OK or a SubstituteError
+};
+
+struct substitute_hook_batch {
+    struct substitute_hook_batch_entry* entries;
+    int count;
+    int result; // Out: amount of hooks created
+};
+
 /////////////////////////////////////////
 // Userland structure Information & Chain
 /////////////////////////////////////////
@@ -139,6 +185,7 @@ struct substitute_hook_uat {
 #define SUBSTITUTE_HOOK_IAT _IOC(IOC_INOUT, SUBSTITUTE_IOCTL_BASE, 1, sizeof(struct substitute_hook_iat))
 #define SUBSTITUTE_HOOK_JMP _IOC(IOC_INOUT, SUBSTITUTE_IOCTL_BASE, 2, sizeof(struct substitute_hook_jmp))
 #define SUBSTITUTE_HOOK_STATE _IOC(IOC_INOUT, SUBSTITUTE_IOCTL_BASE, 3, sizeof(struct substitute_state_hook))
+#define SUBSTITUTE_HOOK_BATCH _IOC(IOC_INOUT, SUBSTITUTE_IOCTL_BASE, 4, sizeof(struct substitute_hook_batch))
 
 /////////////////////////////////////////
 // Class Definition
@@ -152,12 +199,24 @@ namespace Mira
         {
         private:
             // Start / Stop process
-            eventhandler_entry* m_processStartHandler;
-            eventhandler_entry* m_processEndHandler;
+            int32_t m_ProcessStartSubscription;
+            int32_t m_ProcessExitSubscription;
 
             // Hook management
             struct mtx hook_mtx;
-            SubstituteHook hooks[SUBSTITUTE_MAX_HOOKS];
+            Utils::HashMap<struct proc*, SubstituteProcessHooks*> m_ProcessHooks;
+
+            // NID -> jmpslot index of every dynlib object IAT hooks were resolved against
+            JmpslotCache m_JmpslotCache;
+
+            // Name -> NID for name based hooks
+            NidDatabase m_NidDatabase;
+
+            // Title -> order the modules of its substitute folder get loaded in
+            PrxLoadPlanCache m_LoadPlans;
+
+            // pid -> substitute folder got mounted in the sandbox by OnProcessStart
+            Utils::ConcurrentHashMap<int32_t, bool> m_MountedProcesses;
 
         public:
             // Syscall hook (Original pointer)
@@ -174,14 +233,18 @@ namespace Mira
             static Substitute* GetPlugin();
 
             // Hook memory utility
-            SubstituteHook* GetHookByID(int hook_id);
-            SubstituteHook* AllocateHook(int* hook_id);
-            void FreeHook(int hook_id);
+            SubstituteProcessHooks* GetProcessHooks(struct proc* p, bool create);
+            SubstituteHook* GetHookByID(struct proc* p, int hook_id);
+            SubstituteHook* AllocateHook(struct proc* p, int* hook_id);
+            void FreeHook(struct proc* p, int hook_id);
+            static void DestroyHook(SubstituteHook* hook);
+            static void DestroyProcessHooks(SubstituteProcessHooks* process_hooks);
             
             // Chain Utility
             bool  FindJmpslotSimilarity(struct proc* p, void* jmpslot_addr, int* hook_id);
-            int   FindPositionByChain(uint64_t* chains, uint64_t chain);
-            void* FindLastChainOccurence(uint64_t* chains, int* position);
+            bool  AppendChain(SubstituteHook* hook, uint64_t chain);
+            int   FindPositionByChain(SubstituteHook* hook, uint64_t chain);
+            void* FindLastChainOccurence(SubstituteHook* hook, int* position);
 
             // Hook mechanics
             int DisableHook(struct proc* p, int hook_id);
@@ -189,12 +252,18 @@ namespace Mira
             int Unhook(struct proc* p, int hook_id, struct substitute_hook_uat* chain);
             int HookJmp(struct proc* p, void* original_address, void* hook_function);
             int HookIAT(struct proc* p, struct substitute_hook_uat* chain, const char* module_name, const char* name, int32_t flags, void* hook_function);
+            int InstallIAT(struct proc* p, struct substitute_hook_uat* chain, void* jmpslot_address, void* original_function, void* hook_function);
+            int HookBatch(struct proc* p, struct substitute_hook_batch_entry* entries, int count);
             void CleanupProcessHook(struct proc* p);
             void CleanupAllHook();
 
             // SCE Module Utility
+            static struct sx* LockDynlib(struct proc* p);
+            static void       UnlockDynlib(struct sx* dynlib_bind_lock);
             uint64_t FindJmpslotAddress(struct proc* p, const char* module_name, const char* name, int32_t flags);
+            uint64_t FindJmpslotAddressLocked(struct proc* p, const char* module_name, const char* name, int32_t flags);
             void*    FindOriginalAddress(struct proc* p, const char* name, int32_t flags);
+            void*    FindOriginalAddressLocked(struct proc* p, const char* name, int32_t flags);
 
             // Utility
             void     LoadAllPrx(struct thread* td, const char* folder_path);
@@ -203,13 +272,14 @@ namespace Mira
             static int OnIoctl_HookIAT(struct thread* td, struct substitute_hook_iat* uap);
             static int OnIoctl_HookJMP(struct thread* td, struct substitute_hook_jmp* uap);
             static int OnIoctl_StateHook(struct thread* td, struct substitute_state_hook* uap);
+            static int OnIoctl_HookBatch(struct thread* td, struct substitute_hook_batch* uap);
             static int OnIoctl(struct cdev* p_Device, u_long p_Command, caddr_t p_Data, int32_t p_FFlag, struct thread* p_Thread);
 
         protected:
             // Event to trigger
             static int Sys_dynlib_dlsym_hook(struct thread* td, struct dynlib_dlsym_args* uap);
-            static void OnProcessStart(void *arg, struct proc *p);
-            static void OnProcessExit(void *arg, struct proc *p);
+            static void OnProcessStart(Mira::OrbisOS::ProcessInfo* info, void* arg);
+            static void OnProcessExit(Mira::OrbisOS::ProcessInfo* info, void* arg);
         };
     }
 }
@@ -0,0 +1,235 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "SystemManager.hpp"
+#include <Utils/Kernel.hpp>
+#include <Utils/Kdlsym.hpp>
+#include <Utils/MemoryTracker.hpp>
+#include <Utils/HookStats.hpp>
+
+#include <Messaging/MessageManager.hpp>
+#include <Messaging/Rpc/Connection.hpp>
+
+#include <Mira.hpp>
+#include <Plugins/PluginManager.hpp>
+#include <Plugins/FakePkg/FakePkgManager.hpp>
+#include <Plugins/FakeSelf/FakeSelfManager.hpp>
+
+#include "SystemManagerMessages.hpp"
+
+extern "C"
+{
+    #include <sys/errno.h>
+    #include "system.pb-c.h"
+    #include <Messaging/Rpc/rpc.pb-c.h>
+};
+
+using namespace Mira::Plugins;
+using namespace Mira::Plugins::SystemManagerExtent;
+
+SystemManager::SystemManager()
+{
+}
+
+SystemManager::~SystemManager()
+{
+}
+
+bool SystemManager::OnLoad()
+{
+    Mira::Framework::GetFramework()->GetMessageManager()->RegisterCallback(RPC_CATEGORY__SYSTEM, SystemManager_GetMemoryStats, OnGetMemoryStats);
+    Mira::Framework::GetFramework()->GetMessageManager()->RegisterCallback(RPC_CATEGORY__SYSTEM, SystemManager_GetHookStats, OnGetHookStats);
+    Mira::Framework::GetFramework()->GetMessageManager()->RegisterCallback(RPC_CATEGORY__SYSTEM, SystemManager_GetCacheStats, OnGetCacheStats);
+
+    return true;
+}
+
+bool SystemManager::OnUnload()
+{
+    Mira::Framework::GetFramework()->GetMessageManager()->UnregisterCallback(RPC_CATEGORY__SYSTEM, SystemManager_GetMemoryStats, OnGetMemoryStats);
+    Mira::Framework::GetFramework()->GetMessageManager()->UnregisterCallback(RPC_CATEGORY__SYSTEM, SystemManager_GetHookStats, OnGetHookStats);
+    Mira::Framework::GetFramework()->GetMessageManager()->UnregisterCallback(RPC_CATEGORY__SYSTEM, SystemManager_GetCacheStats, OnGetCacheStats);
+
+    return true;
+}
+
+void SystemManager::OnGetMemoryStats(Messaging::Rpc::Connection* p_Connection, const RpcTransport* p_Message)
+{
+    SysMemoryTagStats s_TagStats[Utils::MemoryTag_Max];
+    SysMemoryTagStats* s_TagStatsList[Utils::MemoryTag_Max];
+
+    // Everything lives on the stack so asking for stats does not show up in them
+    for (auto l_TagIndex = 0; l_TagIndex < Utils::MemoryTag_Max; ++l_TagIndex)
+    {
+        auto l_Tag = static_cast<Utils::MemoryTag>(l_TagIndex);
+
+        Utils::MemoryTagStats l_Stats;
+        Utils::MemoryTracker::GetStats(l_Tag, l_Stats);
+
+        auto& l_Entry = s_TagStats[l_TagIndex];
+        sys_memory_tag_stats__init(&l_Entry);
+        l_Entry.tag = l_TagIndex;
+        l_Entry.name = const_cast<char*>(Utils::MemoryTracker::GetTagName(l_Tag));
+        l_Entry.livebytes = l_Stats.LiveBytes;
+        l_Entry.liveallocations = l_Stats.LiveAllocations;
+        l_Entry.totalallocations = l_Stats.TotalAllocations;
+        l_Entry.totalfrees = l_Stats.TotalFrees;
+        l_Entry.highwaterbytes = l_Stats.HighWaterBytes;
+
+        s_TagStatsList[l_TagIndex] = &l_Entry;
+    }
+
+    SysGetMemoryStatsResponse s_Response = SYS_GET_MEMORY_STATS_RESPONSE__INIT;
+    s_Response.n_tags = Utils::MemoryTag_Max;
+    s_Response.tags = s_TagStatsList;
+
+    auto s_ResponseSize = sys_get_memory_stats_response__get_packed_size(&s_Response);
+
+    // Worst case is ~64 bytes per tag, this is bounded by MemoryTag_Max
+    uint8_t s_ResponseData[0x800];
+    if (s_ResponseSize > sizeof(s_ResponseData))
+    {
+        WriteLog(LL_Error, "memory stats response too large (%llx).", s_ResponseSize);
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__SYSTEM, -ENOMEM);
+        return;
+    }
+
+    auto s_PackedSize = sys_get_memory_stats_response__pack(&s_Response, s_ResponseData);
+    if (s_PackedSize != s_ResponseSize)
+    {
+        WriteLog(LL_Error, "could not pack (%lld) != (%lld)", s_PackedSize, s_ResponseSize);
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__SYSTEM, -ENOMEM);
+        return;
+    }
+
+    Mira::Framework::GetFramework()->GetMessageManager()->SendResponse(p_Connection, RPC_CATEGORY__SYSTEM, SystemManager_GetMemoryStats, 0, s_ResponseData, s_ResponseSize);
+}
+
+void SystemManager::OnGetHookStats(Messaging::Rpc::Connection* p_Connection, const RpcTransport* p_Message)
+{
+    // ~300 bytes per hook once packed, keep all of it off of the kernel stack
+    auto s_Arena = p_Connection->GetArena();
+
+    SysGetHookStatsResponse s_Response = SYS_GET_HOOK_STATS_RESPONSE__INIT;
+    s_Response.enabled = Utils::HookStats::IsEnabled();
+    s_Response.firstbucketshift = Utils::HookStats_FirstBucketShift;
+
+    // Without MIRA_HOOK_STATS there is nothing to report besides that
+    if (s_Response.enabled)
+    {
+        auto s_Snapshots = s_Arena->Allocate<Utils::HookStatsSnapshot>(Utils::HookStatsId_Max);
+        auto s_HookStats = s_Arena->Allocate<SysHookStats>(Utils::HookStatsId_Max);
+        auto s_HookStatsList = s_Arena->Allocate<SysHookStats*>(Utils::HookStatsId_Max);
+        if (s_Snapshots == nullptr || s_HookStats == nullptr || s_HookStatsList == nullptr)
+        {
+            Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__SYSTEM, -ENOMEM);
+            return;
+        }
+
+        for (auto l_Index = 0; l_Index < Utils::HookStatsId_Max; ++l_Index)
+        {
+            auto l_Id = static_cast<Utils::HookStatsId>(l_Index);
+            auto& l_Snapshot = s_Snapshots[l_Index];
+            Utils::HookStats::GetStats(l_Id, l_Snapshot);
+
+            auto& l_Entry = s_HookStats[l_Index];
+            sys_hook_stats__init(&l_Entry);
+            l_Entry.id = l_Index;
+            l_Entry.name = const_cast<char*>(Utils::HookStats::GetName(l_Id));
+            l_Entry.calls = l_Snapshot.Calls;
+            l_Entry.totalcycles = l_Snapshot.TotalCycles;
+            l_Entry.maxcycles = l_Snapshot.MaxCycles;
+            l_Entry.n_cpucalls = Utils::HookStats_MaxCpus;
+            l_Entry.cpucalls = l_Snapshot.CpuCalls;
+            l_Entry.n_buckets = Utils::HookStats_BucketCount;
+            l_Entry.buckets = l_Snapshot.Buckets;
+
+            s_HookStatsList[l_Index] = &l_Entry;
+        }
+
+        s_Response.n_hooks = Utils::HookStatsId_Max;
+        s_Response.hooks = s_HookStatsList;
+    }
+
+    auto s_ResponseSize = sys_get_hook_stats_response__get_packed_size(&s_Response);
+    auto s_ResponseData = s_Arena->Allocate<uint8_t>(s_ResponseSize);
+    if (s_ResponseData == nullptr)
+    {
+        WriteLog(LL_Error, "could not allocate hook stats response (%llx).", s_ResponseSize);
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__SYSTEM, -ENOMEM);
+        return;
+    }
+
+    auto s_PackedSize = sys_get_hook_stats_response__pack(&s_Response, s_ResponseData);
+    if (s_PackedSize != s_ResponseSize)
+    {
+        WriteLog(LL_Error, "could not pack (%lld) != (%lld)", s_PackedSize, s_ResponseSize);
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__SYSTEM, -ENOMEM);
+        return;
+    }
+
+    Mira::Framework::GetFramework()->GetMessageManager()->SendResponse(p_Connection, RPC_CATEGORY__SYSTEM, SystemManager_GetHookStats, 0, s_ResponseData, s_ResponseSize);
+}
+
+void SystemManager::OnGetCacheStats(Messaging::Rpc::Connection* p_Connection, const RpcTransport* p_Message)
+{
+    SysCacheStats s_CacheStats[SystemManager_MaxCaches];
+    SysCacheStats* s_CacheStatsList[SystemManager_MaxCaches];
+    uint32_t s_CacheCount = 0;
+
+    // Plugins that are disabled have no cache to report
+    auto s_PluginManager = Mira::Framework::GetFramework()->GetPluginManager();
+    auto s_FakePkgManager = s_PluginManager != nullptr ? static_cast<FakePkgManager*>(s_PluginManager->GetFakePkgManager()) : nullptr;
+    auto s_FakeSelfManager = s_PluginManager != nullptr ? static_cast<FakeSelfManager*>(s_PluginManager->GetFakeSelfManager()) : nullptr;
+
+    if (s_FakePkgManager != nullptr)
+    {
+        auto s_PfsKeys = s_FakePkgManager->GetPfsKeys();
+
+        auto& s_Entry = s_CacheStats[s_CacheCount];
+        sys_cache_stats__init(&s_Entry);
+        s_Entry.name = const_cast<char*>("fakepkg/pfs_keys");
+        s_Entry.hits = s_PfsKeys->GetHits();
+        s_Entry.misses = s_PfsKeys->GetMisses();
+
+        s_CacheStatsList[s_CacheCount++] = &s_Entry;
+    }
+
+    if (s_FakeSelfManager != nullptr)
+    {
+        auto s_AuthInfos = s_FakeSelfManager->GetAuthInfos();
+
+        auto& s_Entry = s_CacheStats[s_CacheCount];
+        sys_cache_stats__init(&s_Entry);
+        s_Entry.name = const_cast<char*>("fakeself/auth_infos");
+        s_Entry.hits = s_AuthInfos->GetHits();
+        s_Entry.misses = s_AuthInfos->GetMisses();
+
+        s_CacheStatsList[s_CacheCount++] = &s_Entry;
+    }
+
+    SysGetCacheStatsResponse s_Response = SYS_GET_CACHE_STATS_RESPONSE__INIT;
+    s_Response.n_caches = s_CacheCount;
+    s_Response.caches = s_CacheStatsList;
+
+    auto s_ResponseSize = sys_get_cache_stats_response__get_packed_size(&s_Response);
+
+    // A name and two counters per cache, bounded by SystemManager_MaxCaches
+    uint8_t s_ResponseData[0x100];
+    if (s_ResponseSize > sizeof(s_ResponseData))
+    {
+        WriteLog(LL_Error, "cache stats response too large (%llx).", s_ResponseSize);
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__SYSTEM, -ENOMEM);
+        return;
+    }
+
+    auto s_PackedSize = sys_get_cache_stats_response__pack(&s_Response, s_ResponseData);
+    if (s_PackedSize != s_ResponseSize)
+    {
+        WriteLog(LL_Error, "could not pack (%lld) != (%lld)", s_PackedSize, s_ResponseSize);
+        Mira::Framework::GetFramework()->GetMessageManager()->SendErrorResponse(p_Connection, RPC_CATEGORY__SYSTEM, -ENOMEM);
+        return;
+    }
+
+    Mira::Framework::GetFramework()->GetMessageManager()->SendResponse(p_Connection, RPC_CATEGORY__SYSTEM, SystemManager_GetCacheStats, 0, s_ResponseData, s_ResponseSize);
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <Utils/IModule.hpp>
+#include <Utils/Types.hpp>
+
+extern "C"
+{
+    #include <Messaging/Rpc/rpc.pb-c.h>
+};
+
+namespace Mira
+{
+    namespace Messaging
+    {
+        namespace Rpc
+        {
+            class Connection;
+        }
+    }
+
+    namespace Plugins
+    {
+        enum
+        {
+            // Caches with hit and miss counters, the PFS key cache and the fake SELF auth info cache
+            SystemManager_MaxCaches = 2,
+        };
+
+        namespace SystemManagerExtent
+        {
+            class SystemManager : public Mira::Utils::IModule
+            {
+            public:
+                SystemManager();
+                virtual ~SystemManager();
+
+                virtual bool OnLoad() override;
+                virtual bool OnUnload() override;
+
+                virtual const char* GetName() override { return "SystemManager"; }
+                virtual const char* GetDescription() override { return "mira framework diagnostics"; }
+
+            private:
+                static void OnGetMemoryStats(Messaging::Rpc::Connection* p_Connection, const RpcTransport* p_Message);
+                static void OnGetHookStats(Messaging::Rpc::Connection* p_Connection, const RpcTransport* p_Message);
+                static void OnGetCacheStats(Messaging::Rpc::Connection* p_Connection, const RpcTransport* p_Message);
+            };
+        }
+    }
+}
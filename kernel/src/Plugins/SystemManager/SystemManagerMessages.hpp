@@ -0,0 +1,18 @@
+#pragma once
+#include <Utils/Types.hpp>
+
+namespace Mira
+{
+    namespace Plugins
+    {
+        namespace SystemManagerExtent
+        {
+            typedef enum _Commands
+            {
+                SystemManager_GetMemoryStats = 0x3B1E6A5D,
+                SystemManager_GetHookStats = 0x6E0C91F4,
+                SystemManager_GetCacheStats = 0x1D47B83A,
+            } Commands;
+        }
+    }
+}
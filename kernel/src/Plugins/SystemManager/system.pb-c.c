@@ -0,0 +1,715 @@
+/* Generated by the protocol buffer compiler.  DO NOT EDIT! */
+/* Generated from: external/system.proto */
+
+/* Do not generate deprecated warnings for self */
+#ifndef PROTOBUF_C__NO_DEPRECATED
+#define PROTOBUF_C__NO_DEPRECATED
+#endif
+
+#include "system.pb-c.h"
+void   sys_memory_tag_stats__init
+                     (SysMemoryTagStats         *message)
+{
+  static const SysMemoryTagStats init_value = SYS_MEMORY_TAG_STATS__INIT;
+  *message = init_value;
+}
+size_t sys_memory_tag_stats__get_packed_size
+                     (const SysMemoryTagStats *message)
+{
+  assert(message->base.descriptor == &sys_memory_tag_stats__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t sys_memory_tag_stats__pack
+                     (const SysMemoryTagStats *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &sys_memory_tag_stats__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t sys_memory_tag_stats__pack_to_buffer
+                     (const SysMemoryTagStats *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &sys_memory_tag_stats__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+SysMemoryTagStats *
+       sys_memory_tag_stats__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (SysMemoryTagStats *)
+     protobuf_c_message_unpack (&sys_memory_tag_stats__descriptor,
+                                allocator, len, data);
+}
+void   sys_memory_tag_stats__free_unpacked
+                     (SysMemoryTagStats *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &sys_memory_tag_stats__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   sys_get_memory_stats_response__init
+                     (SysGetMemoryStatsResponse         *message)
+{
+  static const SysGetMemoryStatsResponse init_value = SYS_GET_MEMORY_STATS_RESPONSE__INIT;
+  *message = init_value;
+}
+size_t sys_get_memory_stats_response__get_packed_size
+                     (const SysGetMemoryStatsResponse *message)
+{
+  assert(message->base.descriptor == &sys_get_memory_stats_response__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t sys_get_memory_stats_response__pack
+                     (const SysGetMemoryStatsResponse *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &sys_get_memory_stats_response__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t sys_get_memory_stats_response__pack_to_buffer
+                     (const SysGetMemoryStatsResponse *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &sys_get_memory_stats_response__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+SysGetMemoryStatsResponse *
+       sys_get_memory_stats_response__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (SysGetMemoryStatsResponse *)
+     protobuf_c_message_unpack (&sys_get_memory_stats_response__descriptor,
+                                allocator, len, data);
+}
+void   sys_get_memory_stats_response__free_unpacked
+                     (SysGetMemoryStatsResponse *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &sys_get_memory_stats_response__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   sys_hook_stats__init
+                     (SysHookStats         *message)
+{
+  static const SysHookStats init_value = SYS_HOOK_STATS__INIT;
+  *message = init_value;
+}
+size_t sys_hook_stats__get_packed_size
+                     (const SysHookStats *message)
+{
+  assert(message->base.descriptor == &sys_hook_stats__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t sys_hook_stats__pack
+                     (const SysHookStats *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &sys_hook_stats__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t sys_hook_stats__pack_to_buffer
+                     (const SysHookStats *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &sys_hook_stats__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+SysHookStats *
+       sys_hook_stats__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (SysHookStats *)
+     protobuf_c_message_unpack (&sys_hook_stats__descriptor,
+                                allocator, len, data);
+}
+void   sys_hook_stats__free_unpacked
+                     (SysHookStats *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &sys_hook_stats__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   sys_get_hook_stats_response__init
+                     (SysGetHookStatsResponse         *message)
+{
+  static const SysGetHookStatsResponse init_value = SYS_GET_HOOK_STATS_RESPONSE__INIT;
+  *message = init_value;
+}
+size_t sys_get_hook_stats_response__get_packed_size
+                     (const SysGetHookStatsResponse *message)
+{
+  assert(message->base.descriptor == &sys_get_hook_stats_response__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t sys_get_hook_stats_response__pack
+                     (const SysGetHookStatsResponse *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &sys_get_hook_stats_response__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t sys_get_hook_stats_response__pack_to_buffer
+                     (const SysGetHookStatsResponse *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &sys_get_hook_stats_response__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+SysGetHookStatsResponse *
+       sys_get_hook_stats_response__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (SysGetHookStatsResponse *)
+     protobuf_c_message_unpack (&sys_get_hook_stats_response__descriptor,
+                                allocator, len, data);
+}
+void   sys_get_hook_stats_response__free_unpacked
+                     (SysGetHookStatsResponse *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &sys_get_hook_stats_response__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   sys_cache_stats__init
+                     (SysCacheStats         *message)
+{
+  static const SysCacheStats init_value = SYS_CACHE_STATS__INIT;
+  *message = init_value;
+}
+size_t sys_cache_stats__get_packed_size
+                     (const SysCacheStats *message)
+{
+  assert(message->base.descriptor == &sys_cache_stats__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t sys_cache_stats__pack
+                     (const SysCacheStats *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &sys_cache_stats__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t sys_cache_stats__pack_to_buffer
+                     (const SysCacheStats *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &sys_cache_stats__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+SysCacheStats *
+       sys_cache_stats__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (SysCacheStats *)
+     protobuf_c_message_unpack (&sys_cache_stats__descriptor,
+                                allocator, len, data);
+}
+void   sys_cache_stats__free_unpacked
+                     (SysCacheStats *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &sys_cache_stats__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   sys_get_cache_stats_response__init
+                     (SysGetCacheStatsResponse         *message)
+{
+  static const SysGetCacheStatsResponse init_value = SYS_GET_CACHE_STATS_RESPONSE__INIT;
+  *message = init_value;
+}
+size_t sys_get_cache_stats_response__get_packed_size
+                     (const SysGetCacheStatsResponse *message)
+{
+  assert(message->base.descriptor == &sys_get_cache_stats_response__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t sys_get_cache_stats_response__pack
+                     (const SysGetCacheStatsResponse *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &sys_get_cache_stats_response__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t sys_get_cache_stats_response__pack_to_buffer
+                     (const SysGetCacheStatsResponse *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &sys_get_cache_stats_response__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+SysGetCacheStatsResponse *
+       sys_get_cache_stats_response__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (SysGetCacheStatsResponse *)
+     protobuf_c_message_unpack (&sys_get_cache_stats_response__descriptor,
+                                allocator, len, data);
+}
+void   sys_get_cache_stats_response__free_unpacked
+                     (SysGetCacheStatsResponse *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &sys_get_cache_stats_response__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+static const ProtobufCFieldDescriptor sys_memory_tag_stats__field_descriptors[7] =
+{
+  {
+    "tag",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(SysMemoryTagStats, tag),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "name",
+    2,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_STRING,
+    0,   /* quantifier_offset */
+    offsetof(SysMemoryTagStats, name),
+    NULL,
+    &protobuf_c_empty_string,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "liveBytes",
+    3,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_INT64,
+    0,   /* quantifier_offset */
+    offsetof(SysMemoryTagStats, livebytes),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "liveAllocations",
+    4,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_INT64,
+    0,   /* quantifier_offset */
+    offsetof(SysMemoryTagStats, liveallocations),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "totalAllocations",
+    5,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(SysMemoryTagStats, totalallocations),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "totalFrees",
+    6,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(SysMemoryTagStats, totalfrees),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "highWaterBytes",
+    7,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(SysMemoryTagStats, highwaterbytes),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned sys_memory_tag_stats__field_indices_by_name[] = {
+  6,   /* field[6] = highWaterBytes */
+  3,   /* field[3] = liveAllocations */
+  2,   /* field[2] = liveBytes */
+  1,   /* field[1] = name */
+  0,   /* field[0] = tag */
+  4,   /* field[4] = totalAllocations */
+  5,   /* field[5] = totalFrees */
+};
+static const ProtobufCIntRange sys_memory_tag_stats__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 7 }
+};
+const ProtobufCMessageDescriptor sys_memory_tag_stats__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "SysMemoryTagStats",
+  "SysMemoryTagStats",
+  "SysMemoryTagStats",
+  "",
+  sizeof(SysMemoryTagStats),
+  7,
+  sys_memory_tag_stats__field_descriptors,
+  sys_memory_tag_stats__field_indices_by_name,
+  1,  sys_memory_tag_stats__number_ranges,
+  (ProtobufCMessageInit) sys_memory_tag_stats__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor sys_get_memory_stats_response__field_descriptors[1] =
+{
+  {
+    "tags",
+    1,
+    PROTOBUF_C_LABEL_REPEATED,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(SysGetMemoryStatsResponse, n_tags),
+    offsetof(SysGetMemoryStatsResponse, tags),
+    &sys_memory_tag_stats__descriptor,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned sys_get_memory_stats_response__field_indices_by_name[] = {
+  0,   /* field[0] = tags */
+};
+static const ProtobufCIntRange sys_get_memory_stats_response__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 1 }
+};
+const ProtobufCMessageDescriptor sys_get_memory_stats_response__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "SysGetMemoryStatsResponse",
+  "SysGetMemoryStatsResponse",
+  "SysGetMemoryStatsResponse",
+  "",
+  sizeof(SysGetMemoryStatsResponse),
+  1,
+  sys_get_memory_stats_response__field_descriptors,
+  sys_get_memory_stats_response__field_indices_by_name,
+  1,  sys_get_memory_stats_response__number_ranges,
+  (ProtobufCMessageInit) sys_get_memory_stats_response__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor sys_hook_stats__field_descriptors[7] =
+{
+  {
+    "id",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(SysHookStats, id),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "name",
+    2,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_STRING,
+    0,   /* quantifier_offset */
+    offsetof(SysHookStats, name),
+    NULL,
+    &protobuf_c_empty_string,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "calls",
+    3,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(SysHookStats, calls),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "totalCycles",
+    4,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(SysHookStats, totalcycles),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "maxCycles",
+    5,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(SysHookStats, maxcycles),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "cpuCalls",
+    6,
+    PROTOBUF_C_LABEL_REPEATED,
+    PROTOBUF_C_TYPE_UINT64,
+    offsetof(SysHookStats, n_cpucalls),
+    offsetof(SysHookStats, cpucalls),
+    NULL,
+    NULL,
+    0 | PROTOBUF_C_FIELD_FLAG_PACKED,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "buckets",
+    7,
+    PROTOBUF_C_LABEL_REPEATED,
+    PROTOBUF_C_TYPE_UINT64,
+    offsetof(SysHookStats, n_buckets),
+    offsetof(SysHookStats, buckets),
+    NULL,
+    NULL,
+    0 | PROTOBUF_C_FIELD_FLAG_PACKED,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned sys_hook_stats__field_indices_by_name[] = {
+  6,   /* field[6] = buckets */
+  2,   /* field[2] = calls */
+  5,   /* field[5] = cpuCalls */
+  0,   /* field[0] = id */
+  4,   /* field[4] = maxCycles */
+  1,   /* field[1] = name */
+  3,   /* field[3] = totalCycles */
+};
+static const ProtobufCIntRange sys_hook_stats__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 7 }
+};
+const ProtobufCMessageDescriptor sys_hook_stats__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "SysHookStats",
+  "SysHookStats",
+  "SysHookStats",
+  "",
+  sizeof(SysHookStats),
+  7,
+  sys_hook_stats__field_descriptors,
+  sys_hook_stats__field_indices_by_name,
+  1,  sys_hook_stats__number_ranges,
+  (ProtobufCMessageInit) sys_hook_stats__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor sys_get_hook_stats_response__field_descriptors[3] =
+{
+  {
+    "enabled",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_BOOL,
+    0,   /* quantifier_offset */
+    offsetof(SysGetHookStatsResponse, enabled),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "firstBucketShift",
+    2,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(SysGetHookStatsResponse, firstbucketshift),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "hooks",
+    3,
+    PROTOBUF_C_LABEL_REPEATED,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(SysGetHookStatsResponse, n_hooks),
+    offsetof(SysGetHookStatsResponse, hooks),
+    &sys_hook_stats__descriptor,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned sys_get_hook_stats_response__field_indices_by_name[] = {
+  0,   /* field[0] = enabled */
+  1,   /* field[1] = firstBucketShift */
+  2,   /* field[2] = hooks */
+};
+static const ProtobufCIntRange sys_get_hook_stats_response__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 3 }
+};
+const ProtobufCMessageDescriptor sys_get_hook_stats_response__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "SysGetHookStatsResponse",
+  "SysGetHookStatsResponse",
+  "SysGetHookStatsResponse",
+  "",
+  sizeof(SysGetHookStatsResponse),
+  3,
+  sys_get_hook_stats_response__field_descriptors,
+  sys_get_hook_stats_response__field_indices_by_name,
+  1,  sys_get_hook_stats_response__number_ranges,
+  (ProtobufCMessageInit) sys_get_hook_stats_response__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor sys_cache_stats__field_descriptors[3] =
+{
+  {
+    "name",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_STRING,
+    0,   /* quantifier_offset */
+    offsetof(SysCacheStats, name),
+    NULL,
+    &protobuf_c_empty_string,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "hits",
+    2,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(SysCacheStats, hits),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "misses",
+    3,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT64,
+    0,   /* quantifier_offset */
+    offsetof(SysCacheStats, misses),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned sys_cache_stats__field_indices_by_name[] = {
+  1,   /* field[1] = hits */
+  2,   /* field[2] = misses */
+  0,   /* field[0] = name */
+};
+static const ProtobufCIntRange sys_cache_stats__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 3 }
+};
+const ProtobufCMessageDescriptor sys_cache_stats__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "SysCacheStats",
+  "SysCacheStats",
+  "SysCacheStats",
+  "",
+  sizeof(SysCacheStats),
+  3,
+  sys_cache_stats__field_descriptors,
+  sys_cache_stats__field_indices_by_name,
+  1,  sys_cache_stats__number_ranges,
+  (ProtobufCMessageInit) sys_cache_stats__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor sys_get_cache_stats_response__field_descriptors[1] =
+{
+  {
+    "caches",
+    1,
+    PROTOBUF_C_LABEL_REPEATED,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(SysGetCacheStatsResponse, n_caches),   /* quantifier_offset */
+    offsetof(SysGetCacheStatsResponse, caches),
+    &sys_cache_stats__descriptor,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned sys_get_cache_stats_response__field_indices_by_name[] = {
+  0,   /* field[0] = caches */
+};
+static const ProtobufCIntRange sys_get_cache_stats_response__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 1 }
+};
+const ProtobufCMessageDescriptor sys_get_cache_stats_response__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "SysGetCacheStatsResponse",
+  "SysGetCacheStatsResponse",
+  "SysGetCacheStatsResponse",
+  "",
+  sizeof(SysGetCacheStatsResponse),
+  1,
+  sys_get_cache_stats_response__field_descriptors,
+  sys_get_cache_stats_response__field_indices_by_name,
+  1,  sys_get_cache_stats_response__number_ranges,
+  (ProtobufCMessageInit) sys_get_cache_stats_response__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
@@ -0,0 +1,262 @@
+/* Generated by the protocol buffer compiler.  DO NOT EDIT! */
+/* Generated from: external/system.proto */
+
+#ifndef PROTOBUF_C_external_2fsystem_2eproto__INCLUDED
+#define PROTOBUF_C_external_2fsystem_2eproto__INCLUDED
+
+#include <protobuf-c/protobuf-c.h>
+
+PROTOBUF_C__BEGIN_DECLS
+
+#if PROTOBUF_C_VERSION_NUMBER < 1003000
+# error This file was generated by a newer version of protoc-c which is incompatible with your libprotobuf-c headers. Please update your headers.
+#elif 1003001 < PROTOBUF_C_MIN_COMPILER_VERSION
+# error This file was generated by an older version of protoc-c which is incompatible with your libprotobuf-c headers. Please regenerate this file with a newer version of protoc-c.
+#endif
+
+
+typedef struct _SysMemoryTagStats SysMemoryTagStats;
+typedef struct _SysGetMemoryStatsResponse SysGetMemoryStatsResponse;
+typedef struct _SysHookStats SysHookStats;
+typedef struct _SysGetHookStatsResponse SysGetHookStatsResponse;
+typedef struct _SysCacheStats SysCacheStats;
+typedef struct _SysGetCacheStatsResponse SysGetCacheStatsResponse;
+
+
+/* --- enums --- */
+
+
+/* --- messages --- */
+
+struct  _SysMemoryTagStats
+{
+  ProtobufCMessage base;
+  uint32_t tag;
+  char *name;
+  int64_t livebytes;
+  int64_t liveallocations;
+  uint64_t totalallocations;
+  uint64_t totalfrees;
+  uint64_t highwaterbytes;
+};
+#define SYS_MEMORY_TAG_STATS__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&sys_memory_tag_stats__descriptor) \
+    , 0, (char *)protobuf_c_empty_string, 0, 0, 0, 0, 0 }
+
+
+struct  _SysGetMemoryStatsResponse
+{
+  ProtobufCMessage base;
+  size_t n_tags;
+  SysMemoryTagStats **tags;
+};
+#define SYS_GET_MEMORY_STATS_RESPONSE__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&sys_get_memory_stats_response__descriptor) \
+    , 0,NULL }
+
+
+struct  _SysHookStats
+{
+  ProtobufCMessage base;
+  uint32_t id;
+  char *name;
+  uint64_t calls;
+  uint64_t totalcycles;
+  uint64_t maxcycles;
+  size_t n_cpucalls;
+  uint64_t *cpucalls;
+  size_t n_buckets;
+  uint64_t *buckets;
+};
+#define SYS_HOOK_STATS__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&sys_hook_stats__descriptor) \
+    , 0, (char *)protobuf_c_empty_string, 0, 0, 0, 0,NULL, 0,NULL }
+
+
+struct  _SysGetHookStatsResponse
+{
+  ProtobufCMessage base;
+  protobuf_c_boolean enabled;
+  uint32_t firstbucketshift;
+  size_t n_hooks;
+  SysHookStats **hooks;
+};
+#define SYS_GET_HOOK_STATS_RESPONSE__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&sys_get_hook_stats_response__descriptor) \
+    , 0, 0, 0,NULL }
+
+
+struct  _SysCacheStats
+{
+  ProtobufCMessage base;
+  char *name;
+  uint64_t hits;
+  uint64_t misses;
+};
+#define SYS_CACHE_STATS__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&sys_cache_stats__descriptor) \
+    , (char *)protobuf_c_empty_string, 0, 0 }
+
+
+struct  _SysGetCacheStatsResponse
+{
+  ProtobufCMessage base;
+  size_t n_caches;
+  SysCacheStats **caches;
+};
+#define SYS_GET_CACHE_STATS_RESPONSE__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&sys_get_cache_stats_response__descriptor) \
+    , 0,NULL }
+
+
+/* SysMemoryTagStats methods */
+void   sys_memory_tag_stats__init
+                     (SysMemoryTagStats         *message);
+size_t sys_memory_tag_stats__get_packed_size
+                     (const SysMemoryTagStats   *message);
+size_t sys_memory_tag_stats__pack
+                     (const SysMemoryTagStats   *message,
+                      uint8_t             *out);
+size_t sys_memory_tag_stats__pack_to_buffer
+                     (const SysMemoryTagStats   *message,
+                      ProtobufCBuffer     *buffer);
+SysMemoryTagStats *
+       sys_memory_tag_stats__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   sys_memory_tag_stats__free_unpacked
+                     (SysMemoryTagStats *message,
+                      ProtobufCAllocator *allocator);
+/* SysGetMemoryStatsResponse methods */
+void   sys_get_memory_stats_response__init
+                     (SysGetMemoryStatsResponse         *message);
+size_t sys_get_memory_stats_response__get_packed_size
+                     (const SysGetMemoryStatsResponse   *message);
+size_t sys_get_memory_stats_response__pack
+                     (const SysGetMemoryStatsResponse   *message,
+                      uint8_t             *out);
+size_t sys_get_memory_stats_response__pack_to_buffer
+                     (const SysGetMemoryStatsResponse   *message,
+                      ProtobufCBuffer     *buffer);
+SysGetMemoryStatsResponse *
+       sys_get_memory_stats_response__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   sys_get_memory_stats_response__free_unpacked
+                     (SysGetMemoryStatsResponse *message,
+                      ProtobufCAllocator *allocator);
+/* SysHookStats methods */
+void   sys_hook_stats__init
+                     (SysHookStats         *message);
+size_t sys_hook_stats__get_packed_size
+                     (const SysHookStats   *message);
+size_t sys_hook_stats__pack
+                     (const SysHookStats   *message,
+                      uint8_t             *out);
+size_t sys_hook_stats__pack_to_buffer
+                     (const SysHookStats   *message,
+                      ProtobufCBuffer     *buffer);
+SysHookStats *
+       sys_hook_stats__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   sys_hook_stats__free_unpacked
+                     (SysHookStats *message,
+                      ProtobufCAllocator *allocator);
+/* SysGetHookStatsResponse methods */
+void   sys_get_hook_stats_response__init
+                     (SysGetHookStatsResponse         *message);
+size_t sys_get_hook_stats_response__get_packed_size
+                     (const SysGetHookStatsResponse   *message);
+size_t sys_get_hook_stats_response__pack
+                     (const SysGetHookStatsResponse   *message,
+                      uint8_t             *out);
+size_t sys_get_hook_stats_response__pack_to_buffer
+                     (const SysGetHookStatsResponse   *message,
+                      ProtobufCBuffer     *buffer);
+SysGetHookStatsResponse *
+       sys_get_hook_stats_response__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   sys_get_hook_stats_response__free_unpacked
+                     (SysGetHookStatsResponse *message,
+                      ProtobufCAllocator *allocator);
+/* SysCacheStats methods */
+void   sys_cache_stats__init
+                     (SysCacheStats         *message);
+size_t sys_cache_stats__get_packed_size
+                     (const SysCacheStats   *message);
+size_t sys_cache_stats__pack
+                     (const SysCacheStats   *message,
+                      uint8_t             *out);
+size_t sys_cache_stats__pack_to_buffer
+                     (const SysCacheStats   *message,
+                      ProtobufCBuffer     *buffer);
+SysCacheStats *
+       sys_cache_stats__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   sys_cache_stats__free_unpacked
+                     (SysCacheStats *message,
+                      ProtobufCAllocator *allocator);
+/* SysGetCacheStatsResponse methods */
+void   sys_get_cache_stats_response__init
+                     (SysGetCacheStatsResponse         *message);
+size_t sys_get_cache_stats_response__get_packed_size
+                     (const SysGetCacheStatsResponse   *message);
+size_t sys_get_cache_stats_response__pack
+                     (const SysGetCacheStatsResponse   *message,
+                      uint8_t             *out);
+size_t sys_get_cache_stats_response__pack_to_buffer
+                     (const SysGetCacheStatsResponse   *message,
+                      ProtobufCBuffer     *buffer);
+SysGetCacheStatsResponse *
+       sys_get_cache_stats_response__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   sys_get_cache_stats_response__free_unpacked
+                     (SysGetCacheStatsResponse *message,
+                      ProtobufCAllocator *allocator);
+/* --- per-message closures --- */
+
+typedef void (*SysMemoryTagStats_Closure)
+                 (const SysMemoryTagStats *message,
+                  void *closure_data);
+typedef void (*SysGetMemoryStatsResponse_Closure)
+                 (const SysGetMemoryStatsResponse *message,
+                  void *closure_data);
+typedef void (*SysHookStats_Closure)
+                 (const SysHookStats *message,
+                  void *closure_data);
+typedef void (*SysGetHookStatsResponse_Closure)
+                 (const SysGetHookStatsResponse *message,
+                  void *closure_data);
+typedef void (*SysCacheStats_Closure)
+                 (const SysCacheStats *message,
+                  void *closure_data);
+typedef void (*SysGetCacheStatsResponse_Closure)
+                 (const SysGetCacheStatsResponse *message,
+                  void *closure_data);
+
+/* --- services --- */
+
+
+/* --- descriptors --- */
+
+extern const ProtobufCMessageDescriptor sys_memory_tag_stats__descriptor;
+extern const ProtobufCMessageDescriptor sys_get_memory_stats_response__descriptor;
+extern const ProtobufCMessageDescriptor sys_hook_stats__descriptor;
+extern const ProtobufCMessageDescriptor sys_get_hook_stats_response__descriptor;
+extern const ProtobufCMessageDescriptor sys_cache_stats__descriptor;
+extern const ProtobufCMessageDescriptor sys_get_cache_stats_response__descriptor;
+
+PROTOBUF_C__END_DECLS
+
+
+#endif  /* PROTOBUF_C_external_2fsystem_2eproto__INCLUDED */
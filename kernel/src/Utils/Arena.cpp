@@ -0,0 +1,133 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "Arena.hpp"
+#include <Utils/Kdlsym.hpp>
+#include <Utils/Kernel.hpp>
+#include <Utils/Logger.hpp>
+
+using namespace Mira::Utils;
+
+Arena::Arena(MemoryTag p_Tag, uint64_t p_ChunkSize) :
+    m_Chunks(nullptr),
+    m_ChunkSize(p_ChunkSize),
+    m_Tag(p_Tag),
+    m_ProtobufAllocator{ ProtobufAlloc, ProtobufFree, this }
+{
+
+}
+
+Arena::~Arena()
+{
+    Destroy();
+}
+
+Arena::Chunk* Arena::AllocateChunk(uint64_t p_MinimumSize)
+{
+    auto s_Size = sizeof(Chunk) + p_MinimumSize;
+    if (s_Size < m_ChunkSize)
+        s_Size = m_ChunkSize;
+
+    auto s_Chunk = static_cast<Chunk*>(MemoryTracker::Allocate(s_Size, m_Tag));
+    if (s_Chunk == nullptr)
+    {
+        WriteLog(LL_Error, "could not allocate arena chunk (%llx).", s_Size);
+        return nullptr;
+    }
+
+    s_Chunk->Size = s_Size;
+    s_Chunk->Offset = sizeof(Chunk);
+    s_Chunk->Next = m_Chunks;
+    m_Chunks = s_Chunk;
+
+    return s_Chunk;
+}
+
+void* Arena::Allocate(uint64_t p_Size)
+{
+    if (p_Size == 0)
+        return nullptr;
+
+    auto s_AlignedSize = (p_Size + (Arena_Alignment - 1)) & ~static_cast<uint64_t>(Arena_Alignment - 1);
+
+    // Only the head chunk is ever bumped, older chunks are full
+    auto s_Chunk = m_Chunks;
+    if (s_Chunk == nullptr || (s_Chunk->Size - s_Chunk->Offset) < s_AlignedSize)
+    {
+        s_Chunk = AllocateChunk(s_AlignedSize);
+        if (s_Chunk == nullptr)
+            return nullptr;
+    }
+
+    auto s_Data = reinterpret_cast<uint8_t*>(s_Chunk) + s_Chunk->Offset;
+    s_Chunk->Offset += s_AlignedSize;
+
+    memset(s_Data, 0, s_AlignedSize);
+
+    return s_Data;
+}
+
+char* Arena::Duplicate(const char* p_String, uint64_t p_Length)
+{
+    auto s_String = static_cast<char*>(Allocate(p_Length + 1));
+    if (s_String == nullptr)
+        return nullptr;
+
+    if (p_String != nullptr && p_Length > 0)
+        memcpy(s_String, p_String, p_Length);
+
+    return s_String;
+}
+
+void Arena::Reset()
+{
+    if (m_Chunks == nullptr)
+        return;
+
+    // Keep the oldest chunk, it is the one every request starts in
+    auto s_Chunk = m_Chunks;
+    while (s_Chunk->Next != nullptr)
+    {
+        auto l_Next = s_Chunk->Next;
+        MemoryTracker::Free(s_Chunk);
+        s_Chunk = l_Next;
+    }
+
+    // Don't hold on to an oversized chunk from a single large request
+    if (s_Chunk->Size > m_ChunkSize)
+    {
+        MemoryTracker::Free(s_Chunk);
+        m_Chunks = nullptr;
+        return;
+    }
+
+    s_Chunk->Offset = sizeof(Chunk);
+    m_Chunks = s_Chunk;
+}
+
+void Arena::Destroy()
+{
+    auto s_Chunk = m_Chunks;
+    while (s_Chunk != nullptr)
+    {
+        auto l_Next = s_Chunk->Next;
+        MemoryTracker::Free(s_Chunk);
+        s_Chunk = l_Next;
+    }
+
+    m_Chunks = nullptr;
+}
+
+void* Arena::ProtobufAlloc(void* p_AllocatorData, size_t p_Size)
+{
+    auto s_Arena = static_cast<Arena*>(p_AllocatorData);
+    if (s_Arena == nullptr)
+        return nullptr;
+
+    return s_Arena->Allocate(p_Size);
+}
+
+void Arena::ProtobufFree(void* p_AllocatorData, void* p_Pointer)
+{
+    // Memory is released all at once on Reset()
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <Utils/Types.hpp>
+#include <Utils/MemoryTracker.hpp>
+
+extern "C"
+{
+    #include <protobuf-c/protobuf-c.h>
+};
+
+namespace Mira
+{
+    namespace Utils
+    {
+        enum
+        {
+            // Default size of each chunk, requests larger than this get a chunk of their own
+            Arena_DefaultChunkSize = 0x4000,
+
+            // Alignment of every allocation handed out
+            Arena_Alignment = 0x10,
+        };
+
+        /*
+            Arena
+
+            Bump allocator for short lived scratch memory. Individual allocations are never freed,
+            everything is released at once by Reset(). The first chunk is kept across resets so
+            steady state requests do not touch malloc at all.
+
+            This is not thread safe, each owner (ex: an rpc connection) gets its own.
+        */
+        class Arena
+        {
+        private:
+            struct Chunk
+            {
+                Chunk* Next;
+                uint64_t Size;
+                uint64_t Offset;
+                uint64_t Reserved;
+            };
+
+            Chunk* m_Chunks;
+            uint64_t m_ChunkSize;
+            MemoryTag m_Tag;
+
+            ProtobufCAllocator m_ProtobufAllocator;
+
+        public:
+            Arena(MemoryTag p_Tag = MemoryTag_Default, uint64_t p_ChunkSize = Arena_DefaultChunkSize);
+            ~Arena();
+
+            // Returns zeroed memory that lives until the next Reset(), or nullptr
+            void* Allocate(uint64_t p_Size);
+
+            template <typename T>
+            T* Allocate(uint64_t p_Count = 1)
+            {
+                return static_cast<T*>(Allocate(sizeof(T) * p_Count));
+            }
+
+            // Copies a string into the arena, the result is always null terminated
+            char* Duplicate(const char* p_String, uint64_t p_Length);
+
+            // Releases all allocations, keeps the first chunk around for reuse
+            void Reset();
+
+            // Releases all allocations and every chunk
+            void Destroy();
+
+            // Allocator that can be passed to any protobuf-c unpack/free_unpacked function
+            ProtobufCAllocator* GetProtobufAllocator() { return &m_ProtobufAllocator; }
+
+        private:
+            Chunk* AllocateChunk(uint64_t p_MinimumSize);
+
+            static void* ProtobufAlloc(void* p_AllocatorData, size_t p_Size);
+            static void ProtobufFree(void* p_AllocatorData, void* p_Pointer);
+        };
+    }
+}
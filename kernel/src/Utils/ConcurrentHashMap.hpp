@@ -0,0 +1,211 @@
+#pragma once
+#include <Utils/HashMap.hpp>
+#include <Utils/Kdlsym.hpp>
+
+extern "C"
+{
+    #include <sys/param.h>
+    #include <sys/lock.h>
+    #include <sys/mutex.h>
+}
+
+namespace Mira
+{
+    namespace Utils
+    {
+        /*
+            ConcurrentHashMap
+
+            HashMap split into TStripeCount independently locked stripes, a key always lives in the
+            stripe picked by the upper bits of its hash. Lookups copy the value out since the entry can
+            move as soon as the stripe lock is dropped, use Update() to modify a value in place.
+
+            Callbacks run with the stripe lock held (MTX_DEF), they must not sleep or call back into the map.
+        */
+        template <typename K, typename V, typename THash = Hash<K>, typename TEqual = EqualTo<K>, uint32_t TStripeCount = 16>
+        class ConcurrentHashMap
+        {
+        private:
+            static_assert((TStripeCount & (TStripeCount - 1)) == 0, "stripe count must be a power of 2");
+
+            struct Stripe
+            {
+                struct mtx Mutex;
+                HashMap<K, V, THash, TEqual> Map;
+            };
+
+            Stripe m_Stripes[TStripeCount];
+            THash m_Hasher;
+
+        public:
+            explicit ConcurrentHashMap(const char* p_Name, MemoryTag p_Tag = MemoryTag_Default) :
+                m_Hasher()
+            {
+                auto mtx_init = (void(*)(struct mtx *m, const char *name, const char *type, int opts))kdlsym(mtx_init);
+
+                for (uint32_t l_Index = 0; l_Index < TStripeCount; ++l_Index)
+                {
+                    mtx_init(&m_Stripes[l_Index].Mutex, p_Name, nullptr, MTX_DEF);
+                    m_Stripes[l_Index].Map.SetTag(p_Tag);
+                }
+            }
+
+            ~ConcurrentHashMap()
+            {
+                auto mtx_destroy = (void(*)(struct mtx* mutex))kdlsym(mtx_destroy);
+
+                Clear();
+
+                for (uint32_t l_Index = 0; l_Index < TStripeCount; ++l_Index)
+                    mtx_destroy(&m_Stripes[l_Index].Mutex);
+            }
+
+            ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+            ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+            bool Insert(const K& p_Key, const V& p_Value)
+            {
+                auto& s_Stripe = GetStripe(p_Key);
+
+                Lock(s_Stripe);
+                auto s_Success = s_Stripe.Map.Insert(p_Key, p_Value);
+                Unlock(s_Stripe);
+
+                return s_Success;
+            }
+
+            // Copies the value into p_OutValue if the key exists
+            bool Find(const K& p_Key, V& p_OutValue)
+            {
+                auto& s_Stripe = GetStripe(p_Key);
+
+                Lock(s_Stripe);
+                auto s_Value = s_Stripe.Map.Find(p_Key);
+                if (s_Value != nullptr)
+                    p_OutValue = *s_Value;
+                Unlock(s_Stripe);
+
+                return s_Value != nullptr;
+            }
+
+            bool Contains(const K& p_Key)
+            {
+                auto& s_Stripe = GetStripe(p_Key);
+
+                Lock(s_Stripe);
+                auto s_Found = s_Stripe.Map.Contains(p_Key);
+                Unlock(s_Stripe);
+
+                return s_Found;
+            }
+
+            // Calls p_Callback(V&) with the stripe locked, returns false if the key does not exist
+            template <typename TCallback>
+            bool Update(const K& p_Key, TCallback p_Callback)
+            {
+                auto& s_Stripe = GetStripe(p_Key);
+
+                Lock(s_Stripe);
+                auto s_Value = s_Stripe.Map.Find(p_Key);
+                if (s_Value != nullptr)
+                    p_Callback(*s_Value);
+                Unlock(s_Stripe);
+
+                return s_Value != nullptr;
+            }
+
+            bool Remove(const K& p_Key)
+            {
+                auto& s_Stripe = GetStripe(p_Key);
+
+                Lock(s_Stripe);
+                auto s_Removed = s_Stripe.Map.Remove(p_Key);
+                Unlock(s_Stripe);
+
+                return s_Removed;
+            }
+
+            // Visits one stripe at a time, p_Callback(const K&, V&) returns false to stop
+            template <typename TCallback>
+            void ForEach(TCallback p_Callback)
+            {
+                bool s_Continue = true;
+                for (uint32_t l_Index = 0; l_Index < TStripeCount && s_Continue; ++l_Index)
+                {
+                    auto& l_Stripe = m_Stripes[l_Index];
+
+                    Lock(l_Stripe);
+                    l_Stripe.Map.ForEach([&](const K& p_Key, V& p_Value)
+                    {
+                        s_Continue = p_Callback(p_Key, p_Value);
+                        return s_Continue;
+                    });
+                    Unlock(l_Stripe);
+                }
+            }
+
+            template <typename TPredicate>
+            uint32_t RemoveIf(TPredicate p_Predicate)
+            {
+                uint32_t s_Removed = 0;
+                for (uint32_t l_Index = 0; l_Index < TStripeCount; ++l_Index)
+                {
+                    auto& l_Stripe = m_Stripes[l_Index];
+
+                    Lock(l_Stripe);
+                    s_Removed += l_Stripe.Map.RemoveIf(p_Predicate);
+                    Unlock(l_Stripe);
+                }
+
+                return s_Removed;
+            }
+
+            // Not a snapshot, stripes are counted one after the other
+            uint32_t Size()
+            {
+                uint32_t s_Size = 0;
+                for (uint32_t l_Index = 0; l_Index < TStripeCount; ++l_Index)
+                {
+                    auto& l_Stripe = m_Stripes[l_Index];
+
+                    Lock(l_Stripe);
+                    s_Size += l_Stripe.Map.Size();
+                    Unlock(l_Stripe);
+                }
+
+                return s_Size;
+            }
+
+            void Clear()
+            {
+                for (uint32_t l_Index = 0; l_Index < TStripeCount; ++l_Index)
+                {
+                    auto& l_Stripe = m_Stripes[l_Index];
+
+                    Lock(l_Stripe);
+                    l_Stripe.Map.Clear();
+                    Unlock(l_Stripe);
+                }
+            }
+
+        private:
+            Stripe& GetStripe(const K& p_Key)
+            {
+                // The stripe map re-hashes with the low bits, so use the high ones here
+                return m_Stripes[(m_Hasher(p_Key) >> 48) & (TStripeCount - 1)];
+            }
+
+            static void Lock(Stripe& p_Stripe)
+            {
+                auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+                _mtx_lock_flags(&p_Stripe.Mutex, 0);
+            }
+
+            static void Unlock(Stripe& p_Stripe)
+            {
+                auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+                _mtx_unlock_flags(&p_Stripe.Mutex, 0);
+            }
+        };
+    }
+}
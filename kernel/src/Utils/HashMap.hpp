@@ -0,0 +1,432 @@
+#pragma once
+#include <Utils/Types.hpp>
+#include <Utils/New.hpp>
+
+namespace Mira
+{
+    namespace Utils
+    {
+        template <typename T> struct RemoveReference { typedef T Type; };
+        template <typename T> struct RemoveReference<T&> { typedef T Type; };
+        template <typename T> struct RemoveReference<T&&> { typedef T Type; };
+
+        template <typename T>
+        inline typename RemoveReference<T>::Type&& Move(T&& p_Value)
+        {
+            return static_cast<typename RemoveReference<T>::Type&&>(p_Value);
+        }
+
+        // splitmix64 finalizer, spreads sequential keys (pids, ids, addresses) across the whole table
+        inline uint64_t HashMix64(uint64_t p_Value)
+        {
+            p_Value ^= p_Value >> 30;
+            p_Value *= 0xBF58476D1CE4E5B9ULL;
+            p_Value ^= p_Value >> 27;
+            p_Value *= 0x94D049BB133111EBULL;
+            p_Value ^= p_Value >> 31;
+            return p_Value;
+        }
+
+        /*
+            Default hasher, works for integers and enums
+        */
+        template <typename T>
+        struct Hash
+        {
+            uint64_t operator()(const T& p_Value) const { return HashMix64(static_cast<uint64_t>(p_Value)); }
+        };
+
+        template <typename T>
+        struct Hash<T*>
+        {
+            uint64_t operator()(T* p_Value) const { return HashMix64(reinterpret_cast<uint64_t>(p_Value)); }
+        };
+
+        template <typename T>
+        struct EqualTo
+        {
+            bool operator()(const T& p_Left, const T& p_Right) const { return p_Left == p_Right; }
+        };
+
+        /*
+            FNV-1a over a null terminated string, the map does not copy the string so the
+            caller has to keep it alive for as long as it is a key
+        */
+        struct StringHash
+        {
+            uint64_t operator()(const char* p_Value) const
+            {
+                uint64_t s_Hash = 0xCBF29CE484222325ULL;
+                if (p_Value == nullptr)
+                    return s_Hash;
+
+                for (; *p_Value != '\0'; ++p_Value)
+                {
+                    s_Hash ^= static_cast<uint8_t>(*p_Value);
+                    s_Hash *= 0x100000001B3ULL;
+                }
+
+                return s_Hash;
+            }
+        };
+
+        struct StringEqualTo
+        {
+            bool operator()(const char* p_Left, const char* p_Right) const
+            {
+                if (p_Left == p_Right)
+                    return true;
+
+                if (p_Left == nullptr || p_Right == nullptr)
+                    return false;
+
+                while (*p_Left != '\0' && *p_Left == *p_Right)
+                {
+                    ++p_Left;
+                    ++p_Right;
+                }
+
+                return *p_Left == *p_Right;
+            }
+        };
+
+        /*
+            HashMap
+
+            Open addressing hash map using Robin Hood probing with backward shift deletion.
+
+            Slots are raw storage, keys and values are only constructed when something is inserted
+            into them, so neither needs a default constructor. There are no exceptions, any call
+            that may allocate returns false when it could not.
+
+            Pointers returned by Find() are invalidated by the next Insert() or Remove().
+
+            This is not thread safe, see ConcurrentHashMap for a locked version.
+        */
+        template <typename K, typename V, typename THash = Hash<K>, typename TEqual = EqualTo<K>>
+        class HashMap
+        {
+        private:
+            enum
+            {
+                MinimumCapacity = 8,
+
+                // Grow when the map would be more than 7/8 full
+                MaxLoadNumerator = 7,
+                MaxLoadDenominator = 8,
+            };
+
+            struct Slot
+            {
+                K Key;
+                V Value;
+            };
+
+            // Distance of 0 means the slot is empty, otherwise it is the probe distance + 1
+            struct SlotInfo
+            {
+                uint32_t Distance;
+                uint32_t Hash;
+            };
+
+            SlotInfo* m_Info;
+            Slot* m_Slots;
+            uint32_t m_Capacity;
+            uint32_t m_Size;
+            MemoryTag m_Tag;
+
+            THash m_Hasher;
+            TEqual m_Equal;
+
+        public:
+            explicit HashMap(MemoryTag p_Tag = MemoryTag_Default) :
+                m_Info(nullptr),
+                m_Slots(nullptr),
+                m_Capacity(0),
+                m_Size(0),
+                m_Tag(p_Tag),
+                m_Hasher(),
+                m_Equal()
+            {
+
+            }
+
+            ~HashMap()
+            {
+                Clear();
+                FreeStorage(m_Info, m_Slots);
+
+                m_Info = nullptr;
+                m_Slots = nullptr;
+                m_Capacity = 0;
+            }
+
+            HashMap(const HashMap&) = delete;
+            HashMap& operator=(const HashMap&) = delete;
+
+            // Only valid while the map has no storage yet
+            void SetTag(MemoryTag p_Tag) { m_Tag = p_Tag; }
+
+            uint32_t Size() const { return m_Size; }
+            uint32_t Capacity() const { return m_Capacity; }
+            bool IsEmpty() const { return m_Size == 0; }
+
+            // Makes sure p_Count entries fit without another allocation
+            bool Reserve(uint32_t p_Count)
+            {
+                uint32_t s_Capacity = m_Capacity < MinimumCapacity ? MinimumCapacity : m_Capacity;
+                while (static_cast<uint64_t>(p_Count) * MaxLoadDenominator > static_cast<uint64_t>(s_Capacity) * MaxLoadNumerator)
+                    s_Capacity *= 2;
+
+                if (s_Capacity == m_Capacity)
+                    return true;
+
+                return Rehash(s_Capacity);
+            }
+
+            // Inserts or replaces the value for p_Key
+            bool Insert(const K& p_Key, const V& p_Value)
+            {
+                auto s_Hash = HashKey(p_Key);
+
+                auto s_Existing = FindIndex(p_Key, s_Hash);
+                if (s_Existing >= 0)
+                {
+                    m_Slots[s_Existing].Value = p_Value;
+                    return true;
+                }
+
+                if (!Reserve(m_Size + 1))
+                    return false;
+
+                InsertNew(K(p_Key), V(p_Value), s_Hash);
+                return true;
+            }
+
+            V* Find(const K& p_Key)
+            {
+                auto s_Index = FindIndex(p_Key, HashKey(p_Key));
+                if (s_Index < 0)
+                    return nullptr;
+
+                return &m_Slots[s_Index].Value;
+            }
+
+            const V* Find(const K& p_Key) const
+            {
+                return const_cast<HashMap*>(this)->Find(p_Key);
+            }
+
+            bool Contains(const K& p_Key) const
+            {
+                return Find(p_Key) != nullptr;
+            }
+
+            bool Remove(const K& p_Key)
+            {
+                auto s_Index = FindIndex(p_Key, HashKey(p_Key));
+                if (s_Index < 0)
+                    return false;
+
+                RemoveAt(static_cast<uint32_t>(s_Index));
+                return true;
+            }
+
+            // p_Callback(const K&, V&) returns false to stop iterating
+            template <typename TCallback>
+            void ForEach(TCallback p_Callback)
+            {
+                for (uint32_t l_Index = 0; l_Index < m_Capacity; ++l_Index)
+                {
+                    if (m_Info[l_Index].Distance == 0)
+                        continue;
+
+                    if (!p_Callback(static_cast<const K&>(m_Slots[l_Index].Key), m_Slots[l_Index].Value))
+                        break;
+                }
+            }
+
+            // Removes every entry where p_Predicate(const K&, V&) returns true, returns the removed count
+            template <typename TPredicate>
+            uint32_t RemoveIf(TPredicate p_Predicate)
+            {
+                uint32_t s_Removed = 0;
+                uint32_t l_Index = 0;
+                while (l_Index < m_Capacity)
+                {
+                    if (m_Info[l_Index].Distance == 0 || !p_Predicate(static_cast<const K&>(m_Slots[l_Index].Key), m_Slots[l_Index].Value))
+                    {
+                        ++l_Index;
+                        continue;
+                    }
+
+                    // Backward shift can pull an entry from past the end of the table into this slot,
+                    // that entry was already visited so it is fine to check it again
+                    RemoveAt(l_Index);
+                    ++s_Removed;
+                }
+
+                return s_Removed;
+            }
+
+            // Destroys all entries but keeps the storage around
+            void Clear()
+            {
+                for (uint32_t l_Index = 0; l_Index < m_Capacity; ++l_Index)
+                {
+                    if (m_Info[l_Index].Distance == 0)
+                        continue;
+
+                    m_Slots[l_Index].~Slot();
+                    m_Info[l_Index].Distance = 0;
+                }
+
+                m_Size = 0;
+            }
+
+        private:
+            uint32_t HashKey(const K& p_Key) const
+            {
+                auto s_Hash = m_Hasher(p_Key);
+                return static_cast<uint32_t>(s_Hash ^ (s_Hash >> 32));
+            }
+
+            int64_t FindIndex(const K& p_Key, uint32_t p_Hash) const
+            {
+                if (m_Size == 0)
+                    return -1;
+
+                auto s_Mask = m_Capacity - 1;
+                auto l_Index = p_Hash & s_Mask;
+                for (uint32_t l_Distance = 0; ; ++l_Distance, l_Index = (l_Index + 1) & s_Mask)
+                {
+                    auto& l_Info = m_Info[l_Index];
+
+                    // Anything we are looking for would have displaced an entry closer to its home
+                    if (l_Info.Distance == 0 || (l_Info.Distance - 1) < l_Distance)
+                        return -1;
+
+                    if (l_Info.Hash == p_Hash && m_Equal(m_Slots[l_Index].Key, p_Key))
+                        return l_Index;
+                }
+            }
+
+            // The key must not already be in the map and there must be room for it
+            void InsertNew(K&& p_Key, V&& p_Value, uint32_t p_Hash)
+            {
+                auto s_Mask = m_Capacity - 1;
+                auto l_Index = p_Hash & s_Mask;
+                uint32_t l_Distance = 0;
+
+                for (;;)
+                {
+                    auto& l_Info = m_Info[l_Index];
+                    if (l_Info.Distance == 0)
+                    {
+                        new (&m_Slots[l_Index]) Slot{ Move(p_Key), Move(p_Value) };
+                        l_Info.Distance = l_Distance + 1;
+                        l_Info.Hash = p_Hash;
+                        ++m_Size;
+                        return;
+                    }
+
+                    // Take the slot from anything that is closer to home than we are, then keep going with it
+                    if ((l_Info.Distance - 1) < l_Distance)
+                    {
+                        auto& l_Slot = m_Slots[l_Index];
+
+                        K l_Key(Move(l_Slot.Key));
+                        l_Slot.Key = Move(p_Key);
+                        p_Key = Move(l_Key);
+
+                        V l_Value(Move(l_Slot.Value));
+                        l_Slot.Value = Move(p_Value);
+                        p_Value = Move(l_Value);
+
+                        auto l_SwappedDistance = l_Info.Distance - 1;
+                        auto l_SwappedHash = l_Info.Hash;
+                        l_Info.Distance = l_Distance + 1;
+                        l_Info.Hash = p_Hash;
+
+                        l_Distance = l_SwappedDistance;
+                        p_Hash = l_SwappedHash;
+                    }
+
+                    ++l_Distance;
+                    l_Index = (l_Index + 1) & s_Mask;
+                }
+            }
+
+            void RemoveAt(uint32_t p_Index)
+            {
+                auto s_Mask = m_Capacity - 1;
+
+                m_Slots[p_Index].~Slot();
+
+                // Shift everything after us back by one until we hit an empty slot or an entry at home
+                auto l_Index = p_Index;
+                auto l_Next = (l_Index + 1) & s_Mask;
+                while (m_Info[l_Next].Distance > 1)
+                {
+                    new (&m_Slots[l_Index]) Slot{ Move(m_Slots[l_Next].Key), Move(m_Slots[l_Next].Value) };
+                    m_Slots[l_Next].~Slot();
+
+                    m_Info[l_Index].Distance = m_Info[l_Next].Distance - 1;
+                    m_Info[l_Index].Hash = m_Info[l_Next].Hash;
+
+                    l_Index = l_Next;
+                    l_Next = (l_Next + 1) & s_Mask;
+                }
+
+                m_Info[l_Index].Distance = 0;
+                --m_Size;
+            }
+
+            bool Rehash(uint32_t p_Capacity)
+            {
+                // Tracked allocations come back zeroed, so every slot starts out empty
+                auto s_Info = static_cast<SlotInfo*>(MemoryTracker::Allocate(sizeof(SlotInfo) * p_Capacity, m_Tag));
+                if (s_Info == nullptr)
+                    return false;
+
+                auto s_Slots = static_cast<Slot*>(MemoryTracker::Allocate(sizeof(Slot) * p_Capacity, m_Tag));
+                if (s_Slots == nullptr)
+                {
+                    MemoryTracker::Free(s_Info);
+                    return false;
+                }
+
+                auto s_OldInfo = m_Info;
+                auto s_OldSlots = m_Slots;
+                auto s_OldCapacity = m_Capacity;
+
+                m_Info = s_Info;
+                m_Slots = s_Slots;
+                m_Capacity = p_Capacity;
+                m_Size = 0;
+
+                for (uint32_t l_Index = 0; l_Index < s_OldCapacity; ++l_Index)
+                {
+                    if (s_OldInfo[l_Index].Distance == 0)
+                        continue;
+
+                    auto& l_Slot = s_OldSlots[l_Index];
+                    InsertNew(Move(l_Slot.Key), Move(l_Slot.Value), s_OldInfo[l_Index].Hash);
+                    l_Slot.~Slot();
+                }
+
+                FreeStorage(s_OldInfo, s_OldSlots);
+                return true;
+            }
+
+            static void FreeStorage(SlotInfo* p_Info, Slot* p_Slots)
+            {
+                if (p_Info != nullptr)
+                    MemoryTracker::Free(p_Info);
+
+                if (p_Slots != nullptr)
+                    MemoryTracker::Free(p_Slots);
+            }
+        };
+    }
+}
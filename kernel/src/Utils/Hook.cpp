@@ -2,6 +2,7 @@
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
 
 #include "Hook.hpp"
+#include "HookRelocator.hpp"
 #include <Utils/Kdlsym.hpp>
 #include <Utils/Kernel.hpp>
 #include <Utils/Logger.hpp>
@@ -9,13 +10,15 @@
 extern "C"
 {
     #include <sys/mman.h>
-    #include <hde64/hde64.h>
 };
 
 using namespace Mira::Utils;
 
 #define HOOK_LENGTH	14
 
+// How far past the overwritten bytes to look for branches back into them
+#define HOOK_BRANCH_SCAN_LENGTH 0x80
+
 Hook::Hook() :
     m_TargetAddress(nullptr),
     m_HookAddress(nullptr),
@@ -31,6 +34,8 @@ Hook::Hook() :
 Hook::Hook(void* p_TargetAddress, void* p_HookAddress) :
     m_TargetAddress(p_TargetAddress),
     m_HookAddress(p_HookAddress),
+    m_TrampolineAddress(nullptr),
+    m_TrampolineSize(0),
     m_BackupData(nullptr),
     m_BackupLength(0),
     m_Enabled(false)
@@ -45,7 +50,14 @@ Hook::Hook(void* p_TargetAddress, void* p_HookAddress) :
         return;
     }
 
-    uint8_t* s_BackupData = new uint8_t[s_BackupDataLength];
+    // A loop jumping back into the overwritten bytes would land in the middle of our jmp
+    if (HookRelocator::IsBranchIntoRange(static_cast<const uint8_t*>(p_TargetAddress), reinterpret_cast<uint64_t>(p_TargetAddress), s_BackupDataLength, HOOK_BRANCH_SCAN_LENGTH))
+    {
+        WriteLog(LL_Error, "(%p) branches back into the first (%x) bytes, not hooking.", p_TargetAddress, s_BackupDataLength);
+        return;
+    }
+
+    uint8_t* s_BackupData = new (MemoryTag_Hooks) uint8_t[s_BackupDataLength];
     if (s_BackupData == nullptr)
     {
         WriteLog(LL_Error, "could not allocate space for backup data.");
@@ -94,35 +106,24 @@ bool Hook::Enable()
     if (m_Enabled)
         return false;
     
-    // TODO: Enable the hook
     if (m_HookAddress == nullptr || m_TargetAddress == nullptr)
         return false;
+
+    // Without the backup the hook could never be removed again
+    if (m_BackupData == nullptr || m_BackupLength == 0)
+        return false;
     
     auto critical_enter = (void(*)(void))kdlsym(critical_enter);
 	auto critical_exit = (void(*)(void))kdlsym(critical_exit);
 
-	uint8_t jumpBuffer[] = {
-		0xFF, 0x25, 0x00, 0x00, 0x00, 0x00,				// # jmp    QWORD PTR [rip+0x0]
-		0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,	// # DQ: AbsoluteAddress
-	}; // Shit takes 14 bytes
-
-	uint64_t* jumpBufferAddress = (uint64_t*)(jumpBuffer + 6);
-
-	// Assign the address
-	*jumpBufferAddress = (uint64_t)m_HookAddress;
-
 	// Change permissions and apply the hook
 	critical_enter();
 	cpu_disable_wp();
-	memcpy(m_TargetAddress, jumpBuffer, sizeof(jumpBuffer));
+	auto s_Result = WritePatch(true);
 	cpu_enable_wp();
 	critical_exit();
 
-    // Set the enabled flag
-    m_Enabled = true;
-
-    // Return successfully
-    return true;
+    return s_Result;
 }
 
 bool Hook::Disable()
@@ -140,17 +141,50 @@ bool Hook::Disable()
     auto critical_enter = (void(*)(void))kdlsym(critical_enter);
 	auto critical_exit = (void(*)(void))kdlsym(critical_exit);
 
-	// Change permissions and apply the hook
+	// Change permissions and restore the original bytes
 	critical_enter();
 	cpu_disable_wp();
-	memcpy(m_TargetAddress, m_BackupData, m_BackupLength);
+	auto s_Result = WritePatch(false);
 	cpu_enable_wp();
 	critical_exit();
 
-    // Set the disabled flag
-    m_Enabled = false;
+    return s_Result;
+}
+
+/*
+    Writes the jmp to the hook (or the original bytes) over the target and updates the enabled flag
+    Write protection has to be off already, this is shared between Enable/Disable and HookManager
+*/
+bool Hook::WritePatch(bool p_Enable)
+{
+    if (m_Enabled == p_Enable)
+        return false;
+
+    if (m_HookAddress == nullptr || m_TargetAddress == nullptr)
+        return false;
+
+    if (m_BackupData == nullptr || m_BackupLength == 0)
+        return false;
+
+    if (p_Enable)
+    {
+        uint8_t jumpBuffer[] = {
+            0xFF, 0x25, 0x00, 0x00, 0x00, 0x00,				// # jmp    QWORD PTR [rip+0x0]
+            0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,	// # DQ: AbsoluteAddress
+        }; // Shit takes 14 bytes
+
+        uint64_t* jumpBufferAddress = (uint64_t*)(jumpBuffer + 6);
+
+        // Assign the address
+        *jumpBufferAddress = (uint64_t)m_HookAddress;
+
+        memcpy(m_TargetAddress, jumpBuffer, sizeof(jumpBuffer));
+    }
+    else
+        memcpy(m_TargetAddress, m_BackupData, m_BackupLength);
+
+    m_Enabled = p_Enable;
 
-    // Return successfully
     return true;
 }
 
@@ -180,24 +214,13 @@ void* Hook::GetTrampolineFunctionAddress(uint32_t* p_OutSize)
 */
 int32_t Hook::GetMinimumHookSize(void* p_Target)
 {
-    hde64s hs;
-
-	uint32_t hookSize = HOOK_LENGTH;
-	uint32_t totalLength = 0;
-
-	
-	while (totalLength < hookSize)
-	{
-		uint32_t length = hde64_disasm(p_Target, &hs);
-		if (hs.flags & F_ERROR)
-			return -1;
-
-		totalLength += length;
-	}
-
-	return totalLength;
+    return HookRelocator::GetMinimumLength(static_cast<const uint8_t*>(p_Target), HOOK_LENGTH);
 }
 
+/*
+    The trampoline runs the relocated preamble then jumps to the rest of the original function,
+    so the original can be called while the hook stays in place
+*/
 uint8_t* Hook::CreateTrampoline(uint32_t* p_OutTrampolineSize)
 {
     if (m_TargetAddress == nullptr || m_HookAddress == nullptr)
@@ -206,43 +229,30 @@ uint8_t* Hook::CreateTrampoline(uint32_t* p_OutTrampolineSize)
     if (m_BackupLength <= 0 || m_BackupData == nullptr)
         return nullptr;
 
-    auto s_TrampolineSize = m_BackupLength + HOOK_LENGTH + sizeof(uint8_t); // NOP;
-    auto s_Trampoline = static_cast<uint8_t*>(k_malloc(s_TrampolineSize));//new uint8_t[s_TrampolineSize];
+    auto s_TargetAddress = reinterpret_cast<uint64_t>(m_TargetAddress);
+
+    // Where the trampoline ends up is not known yet, size it for the worst case
+    auto s_MaximumSize = HookRelocator::GetMaximumSize(m_BackupData, s_TargetAddress, m_BackupLength);
+    if (s_MaximumSize <= 0)
+    {
+        WriteLog(LL_Error, "could not relocate the preamble of (%p).", m_TargetAddress);
+        return nullptr;
+    }
+
+    auto s_Trampoline = static_cast<uint8_t*>(k_malloc(s_MaximumSize));
     if (s_Trampoline == nullptr)
         return nullptr;
 
-    WriteLog(LL_Debug, "trampoline: %p (%x)", s_Trampoline, s_TrampolineSize);
-    WriteLog(LL_Debug, "backup (%p) backupLen (%x)", m_BackupData, m_BackupLength);
-    
     // TODO: Set correct prot on this, unless we always expect rwx (bad assumption)
-    memcpy(s_Trampoline, m_BackupData, m_BackupLength);
-
-    // Set up the jmp hook (bless, no registers clobbered bitches)
-    uint8_t jumpBuffer[] = {
-		0xFF, 0x25, 0x00, 0x00, 0x00, 0x00,				// # jmp    QWORD PTR [rip+0x0]
-		0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,	// # DQ: AbsoluteAddress
-	}; // Shit takes 14 bytes
-
-	uint64_t* jumpBufferAddress = (uint64_t*)(jumpBuffer + 6);
-
-    // Calculate and set the midfunction address
-    uint64_t s_Midfunctionoffset = m_BackupLength - 1;
-    WriteLog(LL_Debug, "midfunctionOffset: %x, backupLength %x", s_Midfunctionoffset, m_BackupLength);
-    uint64_t s_TargetMidFunctionAddress = ((uint64_t)m_TargetAddress) + s_Midfunctionoffset;
-
-    WriteLog(LL_Debug, "jumpBuffer (%p) jumpBufferAddress (%p) midFunctionAddress (%p)", jumpBuffer, jumpBufferAddress, s_TargetMidFunctionAddress);
-
-    *jumpBufferAddress = s_TargetMidFunctionAddress;
-
-    // Copy the jump buffer to the end of the backup bytes in the trampoline
-    auto s_TrampolineJumpBufferAddress = (s_Trampoline + s_Midfunctionoffset);
-    WriteLog(LL_Debug, "trampolineJump (%p) byteAtLoc %x", s_TrampolineJumpBufferAddress, *s_TrampolineJumpBufferAddress);
-
-    memcpy(s_TrampolineJumpBufferAddress, jumpBuffer, sizeof(jumpBuffer));
+    auto s_TrampolineSize = HookRelocator::Relocate(m_BackupData, s_TargetAddress, m_BackupLength, s_Trampoline, reinterpret_cast<uint64_t>(s_Trampoline), s_MaximumSize);
+    if (s_TrampolineSize <= 0)
+    {
+        WriteLog(LL_Error, "could not relocate the preamble of (%p) to (%p).", m_TargetAddress, s_Trampoline);
+        k_free(s_Trampoline);
+        return nullptr;
+    }
 
-    // Set the very last byte of the trampoline to NOP
-    auto s_EndOfTrampoline = &s_Trampoline[s_TrampolineSize - 1];
-    *s_EndOfTrampoline = 0x90;
+    WriteLog(LL_Debug, "trampoline: %p (%x) backupLen (%x)", s_Trampoline, s_TrampolineSize, m_BackupLength);
 
     // Update the output size if there was one passed in
     if (p_OutTrampolineSize != nullptr)
@@ -1,12 +1,17 @@
 #pragma once
 #include <Utils/Types.hpp>
+#include <Utils/ObjectPool.hpp>
 
 namespace Mira
 {
     namespace Utils
     {
+        class HookManager;
+
         class Hook
         {
+            friend class HookManager;
+
         private:
             // Address of the target function
             void* m_TargetAddress;
@@ -26,6 +31,8 @@ namespace Mira
             bool m_Enabled;
 
         public:
+            MIRA_POOLED_OBJECT(Hook)
+
             Hook(void* p_TargetAddress, void* p_HookAddress);
             Hook();
 
@@ -44,6 +51,7 @@ namespace Mira
 
         private:
             uint8_t* CreateTrampoline(uint32_t* p_OutTrampolineSize);
+            bool WritePatch(bool p_Enable);
 
             void* k_malloc(size_t p_Size);
             void k_free(void* p_Address);
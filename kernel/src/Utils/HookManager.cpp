@@ -0,0 +1,331 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "HookManager.hpp"
+#include <Utils/Hook.hpp>
+#include <Utils/Kdlsym.hpp>
+#include <Utils/Kernel.hpp>
+#include <Utils/Logger.hpp>
+
+extern "C"
+{
+    #include <sys/pcpu.h>
+};
+
+using namespace Mira::Utils;
+
+HookManager::HookManager() :
+    m_Hooks { nullptr },
+    m_HookCount(0),
+    m_Staged { },
+    m_StagedCount(0)
+{
+    auto mtx_init = (void(*)(struct mtx *m, const char *name, const char *type, int opts))kdlsym(mtx_init);
+
+    mtx_init(&m_Mutex, "MiraHM", nullptr, MTX_DEF);
+}
+
+HookManager::~HookManager()
+{
+    auto mtx_destroy = (void(*)(struct mtx *))kdlsym(mtx_destroy);
+
+    UnregisterAll();
+
+    mtx_destroy(&m_Mutex);
+}
+
+bool HookManager::Register(Hook* p_Hook)
+{
+    if (p_Hook == nullptr)
+        return false;
+
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    bool s_Ret = false;
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    do
+    {
+        if (FindHook(p_Hook) >= 0)
+        {
+            s_Ret = true;
+            break;
+        }
+
+        if (m_HookCount >= HookManager_MaxHooks)
+        {
+            WriteLog(LL_Error, "too many hooks (%d).", m_HookCount);
+            break;
+        }
+
+        m_Hooks[m_HookCount++] = p_Hook;
+        s_Ret = true;
+    } while (false);
+    _mtx_unlock_flags(&m_Mutex, 0);
+
+    return s_Ret;
+}
+
+bool HookManager::Unregister(Hook* p_Hook)
+{
+    if (p_Hook == nullptr)
+        return false;
+
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    bool s_Ret = false;
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    do
+    {
+        auto s_Index = FindHook(p_Hook);
+        if (s_Index < 0)
+            break;
+
+        // Drop anything still staged for this hook, it would be a dangling pointer after this
+        uint32_t s_StagedCount = 0;
+        for (uint32_t l_Index = 0; l_Index < m_StagedCount; ++l_Index)
+        {
+            if (m_Staged[l_Index].Target != p_Hook)
+                m_Staged[s_StagedCount++] = m_Staged[l_Index];
+        }
+        m_StagedCount = s_StagedCount;
+
+        s_Ret = true;
+        if (p_Hook->IsEnabled())
+        {
+            // Anything else that was staged goes out in the same window
+            Stage(p_Hook, false);
+            s_Ret = CommitStaged();
+        }
+
+        // Order does not matter, move the last one into the hole
+        m_Hooks[s_Index] = m_Hooks[m_HookCount - 1];
+        m_Hooks[m_HookCount - 1] = nullptr;
+        m_HookCount--;
+    } while (false);
+    _mtx_unlock_flags(&m_Mutex, 0);
+
+    return s_Ret;
+}
+
+void HookManager::UnregisterAll()
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+
+    m_StagedCount = 0;
+    if (!StageAll(false) || !CommitStaged())
+        WriteLog(LL_Error, "could not disable all hooks.");
+
+    for (uint32_t l_Index = 0; l_Index < m_HookCount; ++l_Index)
+        m_Hooks[l_Index] = nullptr;
+
+    m_HookCount = 0;
+
+    _mtx_unlock_flags(&m_Mutex, 0);
+}
+
+bool HookManager::StageEnable(Hook* p_Hook)
+{
+    if (!Register(p_Hook))
+        return false;
+
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    auto s_Ret = Stage(p_Hook, true);
+    _mtx_unlock_flags(&m_Mutex, 0);
+
+    return s_Ret;
+}
+
+bool HookManager::StageDisable(Hook* p_Hook)
+{
+    if (!Register(p_Hook))
+        return false;
+
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    auto s_Ret = Stage(p_Hook, false);
+    _mtx_unlock_flags(&m_Mutex, 0);
+
+    return s_Ret;
+}
+
+bool HookManager::Commit()
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    auto s_Ret = CommitStaged();
+    _mtx_unlock_flags(&m_Mutex, 0);
+
+    return s_Ret;
+}
+
+void HookManager::Abort()
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    m_StagedCount = 0;
+    _mtx_unlock_flags(&m_Mutex, 0);
+}
+
+bool HookManager::EnableAll()
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    auto s_Ret = StageAll(true) && CommitStaged();
+    _mtx_unlock_flags(&m_Mutex, 0);
+
+    return s_Ret;
+}
+
+bool HookManager::DisableAll()
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    auto s_Ret = StageAll(false) && CommitStaged();
+    _mtx_unlock_flags(&m_Mutex, 0);
+
+    return s_Ret;
+}
+
+uint32_t HookManager::GetHookCount()
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    auto s_Count = m_HookCount;
+    _mtx_unlock_flags(&m_Mutex, 0);
+
+    return s_Count;
+}
+
+uint32_t HookManager::GetHooks(Hook** p_OutHooks, uint32_t p_MaxCount)
+{
+    if (p_OutHooks == nullptr)
+        return 0;
+
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+
+    uint32_t s_Count = 0;
+    for (; s_Count < m_HookCount && s_Count < p_MaxCount; ++s_Count)
+        p_OutHooks[s_Count] = m_Hooks[s_Count];
+
+    _mtx_unlock_flags(&m_Mutex, 0);
+
+    return s_Count;
+}
+
+int32_t HookManager::FindHook(Hook* p_Hook)
+{
+    for (uint32_t l_Index = 0; l_Index < m_HookCount; ++l_Index)
+    {
+        if (m_Hooks[l_Index] == p_Hook)
+            return static_cast<int32_t>(l_Index);
+    }
+
+    return -1;
+}
+
+bool HookManager::Stage(Hook* p_Hook, bool p_Enable)
+{
+    // Staging the same hook twice keeps the latest request
+    for (uint32_t l_Index = 0; l_Index < m_StagedCount; ++l_Index)
+    {
+        if (m_Staged[l_Index].Target != p_Hook)
+            continue;
+
+        m_Staged[l_Index].Enable = p_Enable;
+        return true;
+    }
+
+    // Every staged hook is tracked, so this can only fill up if the caller leaked entries
+    if (m_StagedCount >= HookManager_MaxHooks)
+        return false;
+
+    m_Staged[m_StagedCount].Target = p_Hook;
+    m_Staged[m_StagedCount].Enable = p_Enable;
+    m_StagedCount++;
+
+    return true;
+}
+
+bool HookManager::StageAll(bool p_Enable)
+{
+    for (uint32_t l_Index = 0; l_Index < m_HookCount; ++l_Index)
+    {
+        if (m_Hooks[l_Index]->IsEnabled() == p_Enable)
+            continue;
+
+        if (!Stage(m_Hooks[l_Index], p_Enable))
+            return false;
+    }
+
+    return true;
+}
+
+bool HookManager::CommitStaged()
+{
+    if (m_StagedCount == 0)
+        return true;
+
+    // Drop the writes that would not change anything before paying for the window
+    uint32_t s_StagedCount = 0;
+    for (uint32_t l_Index = 0; l_Index < m_StagedCount; ++l_Index)
+    {
+        if (m_Staged[l_Index].Target->IsEnabled() != m_Staged[l_Index].Enable)
+            m_Staged[s_StagedCount++] = m_Staged[l_Index];
+    }
+    m_StagedCount = s_StagedCount;
+
+    if (m_StagedCount == 0)
+        return true;
+
+    // Every hook is written in one window on this cpu. Other cpus are not parked, no firmware
+    // has smp_rendezvous resolved, so a target has to be one no other cpu is inside of right now
+    auto critical_enter = (void(*)(void))kdlsym(critical_enter);
+    auto critical_exit = (void(*)(void))kdlsym(critical_exit);
+
+    critical_enter();
+    cpu_disable_wp();
+    auto s_Result = WriteStaged();
+    cpu_enable_wp();
+    critical_exit();
+
+    m_StagedCount = 0;
+
+    return s_Result;
+}
+
+bool HookManager::WriteStaged()
+{
+    bool s_Ret = true;
+    for (uint32_t l_Index = 0; l_Index < m_StagedCount; ++l_Index)
+    {
+        if (!m_Staged[l_Index].Target->WritePatch(m_Staged[l_Index].Enable))
+            s_Ret = false;
+    }
+
+    return s_Ret;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <Utils/Types.hpp>
+
+extern "C"
+{
+    #include <sys/param.h>
+    #include <sys/lock.h>
+    #include <sys/mutex.h>
+}
+
+namespace Mira
+{
+    namespace Utils
+    {
+        class Hook;
+
+        enum
+        {
+            // Most hooks that can be tracked (and staged) at once
+            HookManager_MaxHooks = 64,
+        };
+
+        /*
+            HookManager
+
+            Keeps track of every Hook that Mira has installed and writes them in batches. Hooks are
+            staged with StageEnable/StageDisable and then written all at once by Commit(), inside
+            of a single write protection window instead of one per hook.
+
+            The writes happen in a critical section on the committing cpu, same as Hook::Enable does.
+            Other cpus keep running, parking them needs smp_rendezvous which is not resolved in any
+            of the Kdlsym tables.
+        */
+        class HookManager
+        {
+        private:
+            struct StagedWrite
+            {
+                Hook* Target;
+                bool Enable;
+            };
+
+            Hook* m_Hooks[HookManager_MaxHooks];
+            uint32_t m_HookCount;
+
+            StagedWrite m_Staged[HookManager_MaxHooks];
+            uint32_t m_StagedCount;
+
+            struct mtx m_Mutex;
+
+        public:
+            HookManager();
+            ~HookManager();
+
+            // Starts tracking a hook, this does not enable it
+            bool Register(Hook* p_Hook);
+
+            // Disables the hook if it is enabled and stops tracking it, the owner still deletes it
+            bool Unregister(Hook* p_Hook);
+
+            // Disables every tracked hook in one window and stops tracking all of them
+            void UnregisterAll();
+
+            // Queues a write for the next Commit(), hooks that are not tracked yet get registered
+            bool StageEnable(Hook* p_Hook);
+            bool StageDisable(Hook* p_Hook);
+
+            // Writes everything that was staged, returns false if any of the writes failed
+            bool Commit();
+
+            // Throws away everything that was staged
+            void Abort();
+
+            // Stages and commits every tracked hook
+            bool EnableAll();
+            bool DisableAll();
+
+            uint32_t GetHookCount();
+
+            // Copies up to p_MaxCount tracked hooks to p_OutHooks, returns the amount copied
+            uint32_t GetHooks(Hook** p_OutHooks, uint32_t p_MaxCount);
+
+        private:
+            int32_t FindHook(Hook* p_Hook);
+            bool Stage(Hook* p_Hook, bool p_Enable);
+            bool StageAll(bool p_Enable);
+            bool CommitStaged();
+            bool WriteStaged();
+        };
+    }
+}
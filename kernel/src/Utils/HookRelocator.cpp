@@ -0,0 +1,508 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "HookRelocator.hpp"
+#include <Utils/Kernel.hpp>
+#include <Utils/Logger.hpp>
+
+using namespace Mira::Utils;
+
+static bool FitsInt32(int64_t p_Value)
+{
+    return p_Value >= -2147483648LL && p_Value <= 2147483647LL;
+}
+
+static void WriteInt32(uint8_t* p_Destination, int32_t p_Value)
+{
+    memcpy(p_Destination, &p_Value, sizeof(p_Value));
+}
+
+static void WriteUInt64(uint8_t* p_Destination, uint64_t p_Value)
+{
+    memcpy(p_Destination, &p_Value, sizeof(p_Value));
+}
+
+// jmp qword ptr [rip+0]; dq p_Target
+static uint32_t WriteAbsoluteJump(uint8_t* p_Destination, uint64_t p_Target)
+{
+    p_Destination[0] = 0xFF;
+    p_Destination[1] = 0x25;
+    WriteInt32(p_Destination + 2, 0);
+    WriteUInt64(p_Destination + 6, p_Target);
+
+    return HookRelocator_AbsoluteJumpSize;
+}
+
+static uint32_t GetImmediateSize(const hde64s& p_Info)
+{
+    if (p_Info.flags & F_IMM64)
+        return 8;
+    if (p_Info.flags & F_IMM32)
+        return 4;
+    if (p_Info.flags & F_IMM16)
+        return 2;
+    if (p_Info.flags & F_IMM8)
+        return 1;
+
+    return 0;
+}
+
+int32_t HookRelocator::GetMinimumLength(const uint8_t* p_Code, uint32_t p_MinimumLength)
+{
+    if (p_Code == nullptr)
+        return -1;
+
+    uint32_t s_TotalLength = 0;
+    while (s_TotalLength < p_MinimumLength)
+    {
+        hde64s l_Info;
+        auto l_Length = hde64_disasm(p_Code + s_TotalLength, &l_Info);
+        if (l_Length == 0 || (l_Info.flags & F_ERROR))
+            return -1;
+
+        s_TotalLength += l_Length;
+
+        // Overwriting past a ret/jmp would clobber whatever comes after this function
+        if (s_TotalLength < p_MinimumLength && IsTerminator(l_Info))
+            return -1;
+    }
+
+    return static_cast<int32_t>(s_TotalLength);
+}
+
+bool HookRelocator::IsBranchIntoRange(const uint8_t* p_Code, uint64_t p_CodeAddress, uint32_t p_Length, uint32_t p_ScanLength)
+{
+    if (p_Code == nullptr)
+        return false;
+
+    uint32_t s_Offset = p_Length;
+    while (s_Offset < p_Length + p_ScanLength)
+    {
+        hde64s l_Info;
+        auto l_Length = hde64_disasm(p_Code + s_Offset, &l_Info);
+        if (l_Length == 0 || (l_Info.flags & F_ERROR))
+            break;
+
+        if (l_Info.flags & F_RELATIVE)
+        {
+            int64_t l_Displacement = (l_Info.flags & F_IMM8) ? static_cast<int8_t>(l_Info.imm.imm8) : static_cast<int32_t>(l_Info.imm.imm32);
+            auto l_Target = p_CodeAddress + s_Offset + l_Length + l_Displacement;
+
+            // Landing on the first byte is fine, that is where the hook jmp starts
+            if (l_Target > p_CodeAddress && l_Target < p_CodeAddress + p_Length)
+                return true;
+        }
+
+        s_Offset += l_Length;
+    }
+
+    return false;
+}
+
+int32_t HookRelocator::GetMaximumSize(const uint8_t* p_Code, uint64_t p_CodeAddress, uint32_t p_Length)
+{
+    Instruction s_Instructions[HookRelocator_MaxInstructions];
+    uint32_t s_Count = 0;
+
+    if (!Decode(p_Code, p_CodeAddress, p_Length, s_Instructions, s_Count))
+        return -1;
+
+    return Layout(s_Instructions, s_Count, p_CodeAddress, p_Length, 0, true);
+}
+
+int32_t HookRelocator::Relocate(const uint8_t* p_Code, uint64_t p_CodeAddress, uint32_t p_Length, uint8_t* p_Destination, uint64_t p_DestinationAddress, uint32_t p_DestinationSize)
+{
+    if (p_Destination == nullptr)
+        return -1;
+
+    Instruction s_Instructions[HookRelocator_MaxInstructions];
+    uint32_t s_Count = 0;
+
+    if (!Decode(p_Code, p_CodeAddress, p_Length, s_Instructions, s_Count))
+    {
+        WriteLog(LL_Error, "could not decode (%p) length (%x).", p_CodeAddress, p_Length);
+        return -1;
+    }
+
+    auto s_TotalSize = Layout(s_Instructions, s_Count, p_CodeAddress, p_Length, p_DestinationAddress, false);
+    if (s_TotalSize < 0)
+    {
+        WriteLog(LL_Error, "could not relocate (%p) to (%p).", p_CodeAddress, p_DestinationAddress);
+        return -1;
+    }
+
+    if (static_cast<uint32_t>(s_TotalSize) > p_DestinationSize)
+    {
+        WriteLog(LL_Error, "relocated size (%x) > destination size (%x).", s_TotalSize, p_DestinationSize);
+        return -1;
+    }
+
+    uint32_t s_Offset = 0;
+    for (uint32_t l_Index = 0; l_Index < s_Count; ++l_Index)
+    {
+        auto l_Written = Emit(p_Code, s_Instructions[l_Index], s_Instructions, s_Count, p_CodeAddress, p_Length, p_Destination + s_Offset, p_DestinationAddress + s_Offset);
+        if (l_Written < 0)
+            return -1;
+
+        s_Offset += l_Written;
+    }
+
+    // Continue with the rest of the original function
+    auto s_ReturnAddress = p_CodeAddress + p_Length;
+    auto s_Displacement = static_cast<int64_t>(s_ReturnAddress - (p_DestinationAddress + s_Offset + 5));
+    if (static_cast<uint32_t>(s_TotalSize) - s_Offset == 5)
+    {
+        p_Destination[s_Offset] = 0xE9;
+        WriteInt32(p_Destination + s_Offset + 1, static_cast<int32_t>(s_Displacement));
+        s_Offset += 5;
+    }
+    else
+        s_Offset += WriteAbsoluteJump(p_Destination + s_Offset, s_ReturnAddress);
+
+    return static_cast<int32_t>(s_Offset);
+}
+
+bool HookRelocator::Decode(const uint8_t* p_Code, uint64_t p_CodeAddress, uint32_t p_Length, Instruction* p_Instructions, uint32_t& p_OutCount)
+{
+    p_OutCount = 0;
+
+    if (p_Code == nullptr || p_Length == 0)
+        return false;
+
+    uint32_t s_Offset = 0;
+    while (s_Offset < p_Length)
+    {
+        if (p_OutCount >= HookRelocator_MaxInstructions)
+            return false;
+
+        auto& l_Instruction = p_Instructions[p_OutCount];
+        memset(&l_Instruction, 0, sizeof(l_Instruction));
+
+        auto l_Length = hde64_disasm(p_Code + s_Offset, &l_Instruction.Info);
+        if (l_Length == 0 || (l_Instruction.Info.flags & F_ERROR))
+            return false;
+
+        // The range has to end on an instruction boundary
+        if (s_Offset + l_Length > p_Length)
+            return false;
+
+        l_Instruction.Kind = InstructionKind_Copy;
+        l_Instruction.Offset = s_Offset;
+
+        auto& l_Info = l_Instruction.Info;
+        auto l_NextAddress = p_CodeAddress + s_Offset + l_Length;
+
+        if (l_Info.flags & F_RELATIVE)
+        {
+            // rel16 branches are not a thing in long mode
+            if (l_Info.p_66 || l_Info.p_67)
+                return false;
+
+            if (l_Info.flags & F_IMM8)
+                l_Instruction.Target = l_NextAddress + static_cast<int8_t>(l_Info.imm.imm8);
+            else if (l_Info.flags & F_IMM32)
+                l_Instruction.Target = l_NextAddress + static_cast<int32_t>(l_Info.imm.imm32);
+            else
+                return false;
+
+            if (l_Info.opcode == 0xE8)
+                l_Instruction.Kind = InstructionKind_Call;
+            else if (l_Info.opcode == 0xE9 || l_Info.opcode == 0xEB)
+                l_Instruction.Kind = InstructionKind_Jump;
+            else if ((l_Info.opcode & 0xF0) == 0x70)
+                l_Instruction.Kind = InstructionKind_ConditionalJump;
+            else if (l_Info.opcode == 0x0F && (l_Info.opcode2 & 0xF0) == 0x80)
+                l_Instruction.Kind = InstructionKind_ConditionalJump;
+            else
+                return false; // loop, loopcc, jrcxz only have a rel8 form
+        }
+        else if ((l_Info.flags & F_MODRM) && l_Info.modrm_mod == 0 && l_Info.modrm_rm == 5)
+        {
+            // [eip+disp32] with an address size override is not worth supporting
+            if (l_Info.p_67 || !(l_Info.flags & F_DISP32))
+                return false;
+
+            l_Instruction.Kind = InstructionKind_RipRelative;
+            l_Instruction.Target = l_NextAddress + static_cast<int32_t>(l_Info.disp.disp32);
+        }
+
+        s_Offset += l_Length;
+        p_OutCount++;
+    }
+
+    return true;
+}
+
+int32_t HookRelocator::Layout(Instruction* p_Instructions, uint32_t p_Count, uint64_t p_CodeAddress, uint32_t p_Length, uint64_t p_DestinationAddress, bool p_AssumeFar)
+{
+    uint32_t s_Offset = 0;
+    for (uint32_t l_Index = 0; l_Index < p_Count; ++l_Index)
+    {
+        auto& l_Instruction = p_Instructions[l_Index];
+        auto l_Length = l_Instruction.Info.len;
+        auto l_Address = p_DestinationAddress + s_Offset;
+        auto l_IsInside = l_Instruction.Target >= p_CodeAddress && l_Instruction.Target < p_CodeAddress + p_Length;
+
+        l_Instruction.RelocatedOffset = s_Offset;
+
+        switch (l_Instruction.Kind)
+        {
+        case InstructionKind_Copy:
+            l_Instruction.RelocatedSize = l_Length;
+            break;
+        case InstructionKind_RipRelative:
+        {
+            auto l_LoadSize = GetLoadSize(l_Instruction);
+            if (p_AssumeFar)
+                l_Instruction.RelocatedSize = l_LoadSize > l_Length ? l_LoadSize : l_Length;
+            else if (FitsInt32(static_cast<int64_t>(l_Instruction.Target - (l_Address + l_Length))))
+                l_Instruction.RelocatedSize = l_Length;
+            else if (l_LoadSize != 0)
+                l_Instruction.RelocatedSize = l_LoadSize;
+            else
+            {
+                WriteLog(LL_Error, "rip relative operand at (%x) out of range.", l_Instruction.Offset);
+                return -1;
+            }
+            break;
+        }
+        case InstructionKind_Jump:
+        case InstructionKind_ConditionalJump:
+        {
+            // Near forms are jmp rel32 (5) and jcc rel32 (6)
+            uint32_t l_NearSize = l_Instruction.Kind == InstructionKind_Jump ? 5 : 6;
+            uint32_t l_FarSize = l_Instruction.Kind == InstructionKind_Jump ? HookRelocator_AbsoluteJumpSize : HookRelocator_AbsoluteBranchSize;
+
+            if (l_IsInside)
+            {
+                // Has to land on one of the moved instructions
+                if (FindInstruction(p_Instructions, p_Count, p_CodeAddress, l_Instruction.Target) == nullptr)
+                {
+                    WriteLog(LL_Error, "branch at (%x) lands mid instruction.", l_Instruction.Offset);
+                    return -1;
+                }
+
+                l_Instruction.RelocatedSize = l_NearSize;
+            }
+            else if (!p_AssumeFar && FitsInt32(static_cast<int64_t>(l_Instruction.Target - (l_Address + l_NearSize))))
+                l_Instruction.RelocatedSize = l_NearSize;
+            else
+                l_Instruction.RelocatedSize = l_FarSize;
+            break;
+        }
+        case InstructionKind_Call:
+        {
+            if (l_IsInside)
+            {
+                WriteLog(LL_Error, "call at (%x) into the relocated range.", l_Instruction.Offset);
+                return -1;
+            }
+
+            if (!p_AssumeFar && FitsInt32(static_cast<int64_t>(l_Instruction.Target - (l_Address + 5))))
+                l_Instruction.RelocatedSize = 5;
+            else
+                l_Instruction.RelocatedSize = HookRelocator_AbsoluteBranchSize;
+            break;
+        }
+        }
+
+        s_Offset += l_Instruction.RelocatedSize;
+    }
+
+    // Jump back to the rest of the function
+    auto s_ReturnAddress = p_CodeAddress + p_Length;
+    if (!p_AssumeFar && FitsInt32(static_cast<int64_t>(s_ReturnAddress - (p_DestinationAddress + s_Offset + 5))))
+        s_Offset += 5;
+    else
+        s_Offset += HookRelocator_AbsoluteJumpSize;
+
+    return static_cast<int32_t>(s_Offset);
+}
+
+int32_t HookRelocator::Emit(const uint8_t* p_Code, const Instruction& p_Instruction, const Instruction* p_Instructions, uint32_t p_Count, uint64_t p_CodeAddress, uint32_t p_Length, uint8_t* p_Destination, uint64_t p_DestinationAddress)
+{
+    auto& s_Info = p_Instruction.Info;
+    auto s_Length = s_Info.len;
+    auto s_Size = p_Instruction.RelocatedSize;
+
+    switch (p_Instruction.Kind)
+    {
+    case InstructionKind_Copy:
+        memcpy(p_Destination, p_Code + p_Instruction.Offset, s_Length);
+        break;
+    case InstructionKind_RipRelative:
+    {
+        if (s_Size == s_Length && FitsInt32(static_cast<int64_t>(p_Instruction.Target - (p_DestinationAddress + s_Length))))
+        {
+            // Same instruction, disp32 re-pointed at the original target
+            memcpy(p_Destination, p_Code + p_Instruction.Offset, s_Length);
+
+            auto l_DisplacementOffset = s_Length - GetImmediateSize(s_Info) - sizeof(int32_t);
+            WriteInt32(p_Destination + l_DisplacementOffset, static_cast<int32_t>(p_Instruction.Target - (p_DestinationAddress + s_Length)));
+            break;
+        }
+
+        // movabs reg, target
+        uint32_t l_Register = s_Info.modrm_reg | (s_Info.rex_r ? 8 : 0);
+        uint32_t l_Offset = 0;
+
+        p_Destination[l_Offset++] = 0x48 | (l_Register >= 8 ? 0x01 : 0x00);
+        p_Destination[l_Offset++] = 0xB8 | (l_Register & 7);
+        WriteUInt64(p_Destination + l_Offset, p_Instruction.Target);
+        l_Offset += sizeof(uint64_t);
+
+        // lea is done, mov still has to load from it: mov reg, [reg]
+        if (s_Info.opcode == 0x8B)
+        {
+            uint8_t l_Rex = 0x40 | (s_Info.rex_w ? 0x08 : 0x00) | (l_Register >= 8 ? 0x05 : 0x00);
+            if (l_Rex != 0x40)
+                p_Destination[l_Offset++] = l_Rex;
+
+            p_Destination[l_Offset++] = 0x8B;
+
+            auto l_Low = l_Register & 7;
+            if (l_Low == 4)
+            {
+                // rsp/r12 as a base needs a sib byte
+                p_Destination[l_Offset++] = (l_Low << 3) | 4;
+                p_Destination[l_Offset++] = 0x24;
+            }
+            else if (l_Low == 5)
+            {
+                // rbp/r13 with mod 0 would be rip relative again, use [reg+0]
+                p_Destination[l_Offset++] = 0x40 | (l_Low << 3) | 5;
+                p_Destination[l_Offset++] = 0x00;
+            }
+            else
+                p_Destination[l_Offset++] = (l_Low << 3) | l_Low;
+        }
+
+        // The sizing pass may have reserved the original length, pad with nops
+        while (l_Offset < s_Size)
+            p_Destination[l_Offset++] = 0x90;
+        break;
+    }
+    case InstructionKind_Jump:
+    case InstructionKind_ConditionalJump:
+    {
+        auto l_IsConditional = p_Instruction.Kind == InstructionKind_ConditionalJump;
+        uint32_t l_Condition = (s_Info.opcode == 0x0F ? s_Info.opcode2 : s_Info.opcode) & 0x0F;
+        uint32_t l_NearSize = l_IsConditional ? 6 : 5;
+
+        auto l_Target = p_Instruction.Target;
+        auto l_Inside = FindInstruction(p_Instructions, p_Count, p_CodeAddress, l_Target);
+        if (l_Inside != nullptr)
+        {
+            // Stay inside of the relocated copy
+            l_Target = (p_DestinationAddress - p_Instruction.RelocatedOffset) + l_Inside->RelocatedOffset;
+        }
+
+        if (s_Size == l_NearSize)
+        {
+            if (l_IsConditional)
+            {
+                p_Destination[0] = 0x0F;
+                p_Destination[1] = 0x80 | l_Condition;
+            }
+            else
+                p_Destination[0] = 0xE9;
+
+            WriteInt32(p_Destination + l_NearSize - sizeof(int32_t), static_cast<int32_t>(l_Target - (p_DestinationAddress + l_NearSize)));
+            break;
+        }
+
+        if (l_IsConditional)
+        {
+            // Inverted jcc over the absolute jump
+            p_Destination[0] = 0x70 | (l_Condition ^ 1);
+            p_Destination[1] = HookRelocator_AbsoluteJumpSize;
+            WriteAbsoluteJump(p_Destination + 2, l_Target);
+        }
+        else
+            WriteAbsoluteJump(p_Destination, l_Target);
+        break;
+    }
+    case InstructionKind_Call:
+    {
+        if (s_Size == 5)
+        {
+            p_Destination[0] = 0xE8;
+            WriteInt32(p_Destination + 1, static_cast<int32_t>(p_Instruction.Target - (p_DestinationAddress + 5)));
+            break;
+        }
+
+        // call qword ptr [rip+2]; jmp +8; dq target
+        p_Destination[0] = 0xFF;
+        p_Destination[1] = 0x15;
+        WriteInt32(p_Destination + 2, 2);
+        p_Destination[6] = 0xEB;
+        p_Destination[7] = 0x08;
+        WriteUInt64(p_Destination + 8, p_Instruction.Target);
+        break;
+    }
+    }
+
+    return static_cast<int32_t>(s_Size);
+}
+
+const HookRelocator::Instruction* HookRelocator::FindInstruction(const Instruction* p_Instructions, uint32_t p_Count, uint64_t p_CodeAddress, uint64_t p_Address)
+{
+    for (uint32_t l_Index = 0; l_Index < p_Count; ++l_Index)
+    {
+        if (p_CodeAddress + p_Instructions[l_Index].Offset == p_Address)
+            return &p_Instructions[l_Index];
+    }
+
+    return nullptr;
+}
+
+bool HookRelocator::IsTerminator(const hde64s& p_Info)
+{
+    switch (p_Info.opcode)
+    {
+    case 0xC2: // ret imm16
+    case 0xC3: // ret
+    case 0xCA: // retf imm16
+    case 0xCB: // retf
+    case 0xCC: // int3, padding between functions
+    case 0xE9: // jmp rel32
+    case 0xEB: // jmp rel8
+        return true;
+    case 0xFF: // jmp r/m, jmp far m
+        return p_Info.modrm_reg == 4 || p_Info.modrm_reg == 5;
+    case 0x0F: // ud2
+        return p_Info.opcode2 == 0x0B;
+    default:
+        return false;
+    }
+}
+
+uint32_t HookRelocator::GetLoadSize(const Instruction& p_Instruction)
+{
+    auto& s_Info = p_Instruction.Info;
+
+    // Only plain (REX prefixed at most) loads into a general purpose register can be rewritten
+    if (s_Info.flags & (F_PREFIX_ANY & ~F_PREFIX_REX))
+        return 0;
+
+    // lea r64, [rip+disp32] -> movabs r64, imm64
+    if (s_Info.opcode == 0x8D)
+        return s_Info.rex_w ? 10 : 0;
+
+    // mov r32/r64, [rip+disp32] -> movabs r64, imm64; mov r32/r64, [r64]
+    if (s_Info.opcode == 0x8B)
+    {
+        uint32_t s_Register = s_Info.modrm_reg | (s_Info.rex_r ? 8 : 0);
+        uint32_t s_Size = 10 + 2;
+
+        if (s_Info.rex_w || s_Register >= 8)
+            s_Size += 1;
+
+        if ((s_Register & 7) == 4 || (s_Register & 7) == 5)
+            s_Size += 1;
+
+        return s_Size;
+    }
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <Utils/Types.hpp>
+
+extern "C"
+{
+    #include <hde64/hde64.h>
+};
+
+namespace Mira
+{
+    namespace Utils
+    {
+        enum
+        {
+            // Most instructions that can be moved at once, a 14 byte hook covers at most 14
+            HookRelocator_MaxInstructions = 16,
+
+            // jmp qword ptr [rip+0]; dq target
+            HookRelocator_AbsoluteJumpSize = 14,
+
+            // jcc/call rewritten around an absolute jump or address
+            HookRelocator_AbsoluteBranchSize = 16,
+        };
+
+        /*
+            HookRelocator
+
+            Copies the first instructions of a function somewhere else so they can still be executed
+            after they have been overwritten by a hook, then jumps back to the rest of the function.
+
+            - RIP relative operands are re-pointed at the original address, if the new location is
+              too far away for a disp32 then lea/mov loads are rewritten to use movabs
+            - rel8/rel32 jmp, jcc and call are rewritten to reach their original target, branches that
+              stay inside of the moved range are re-pointed at the moved copy
+            - loop/jrcxz and anything that cannot be expressed at the new address fail the relocation
+
+            Nothing in here touches kernel state, the source bytes and both addresses are passed in so
+            this can be exercised on plain buffers.
+        */
+        class HookRelocator
+        {
+        private:
+            enum InstructionKind
+            {
+                InstructionKind_Copy,
+                InstructionKind_RipRelative,
+                InstructionKind_Jump,
+                InstructionKind_ConditionalJump,
+                InstructionKind_Call,
+            };
+
+            struct Instruction
+            {
+                hde64s Info;
+                InstructionKind Kind;
+                uint32_t Offset;
+                uint32_t RelocatedOffset;
+                uint32_t RelocatedSize;
+                uint64_t Target;
+            };
+
+        public:
+            // Smallest length of whole instructions covering p_MinimumLength bytes, or -1 if the code
+            // can not be decoded or the function ends before that
+            static int32_t GetMinimumLength(const uint8_t* p_Code, uint32_t p_MinimumLength);
+
+            // Returns true if a relative branch within p_ScanLength bytes after the range lands inside
+            // of it (excluding the first byte), overwriting the range would break that branch
+            static bool IsBranchIntoRange(const uint8_t* p_Code, uint64_t p_CodeAddress, uint32_t p_Length, uint32_t p_ScanLength);
+
+            // Upper bound of what Relocate() writes for this range regardless of where it goes, or -1
+            static int32_t GetMaximumSize(const uint8_t* p_Code, uint64_t p_CodeAddress, uint32_t p_Length);
+
+            // Relocates p_Length bytes of p_Code (which runs at p_CodeAddress) to p_Destination (which
+            // will run at p_DestinationAddress), followed by a jump back to p_CodeAddress + p_Length
+            // Returns the amount of bytes written, or -1
+            static int32_t Relocate(const uint8_t* p_Code, uint64_t p_CodeAddress, uint32_t p_Length, uint8_t* p_Destination, uint64_t p_DestinationAddress, uint32_t p_DestinationSize);
+
+        private:
+            static bool Decode(const uint8_t* p_Code, uint64_t p_CodeAddress, uint32_t p_Length, Instruction* p_Instructions, uint32_t& p_OutCount);
+            static int32_t Layout(Instruction* p_Instructions, uint32_t p_Count, uint64_t p_CodeAddress, uint32_t p_Length, uint64_t p_DestinationAddress, bool p_AssumeFar);
+            static int32_t Emit(const uint8_t* p_Code, const Instruction& p_Instruction, const Instruction* p_Instructions, uint32_t p_Count, uint64_t p_CodeAddress, uint32_t p_Length, uint8_t* p_Destination, uint64_t p_DestinationAddress);
+
+            static const Instruction* FindInstruction(const Instruction* p_Instructions, uint32_t p_Count, uint64_t p_CodeAddress, uint64_t p_Address);
+            static bool IsTerminator(const hde64s& p_Info);
+            static uint32_t GetLoadSize(const Instruction& p_Instruction);
+        };
+    }
+}
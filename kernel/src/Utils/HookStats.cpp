@@ -0,0 +1,117 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "HookStats.hpp"
+#include <Utils/Kdlsym.hpp>
+#include <Utils/Kernel.hpp>
+
+extern "C"
+{
+    #include <sys/param.h>
+    #include <sys/pcpu.h>
+};
+
+using namespace Mira::Utils;
+
+static const char* s_HookNames[HookStatsId_Max] =
+{
+    "trap_fatal",
+    "sceSblAuthMgrVerifyHeader",
+    "sceSblAuthMgrIsLoadable2",
+    "_sceSblAuthMgrSmLoadSelfSegment",
+    "_sceSblAuthMgrSmLoadSelfBlock",
+    "npdrm_decrypt_isolated_rif",
+    "npdrm_decrypt_rif_new",
+    "sceSblPfsSetKeys",
+    "sceSblDriverSendMsg",
+    "sceSblKeymgrInvalidateKey",
+    "sys_dynlib_dlsym",
+};
+
+#if defined(MIRA_HOOK_STATS)
+typedef struct _CpuHookCounters
+{
+    uint64_t Calls;
+    uint64_t TotalCycles;
+    uint64_t MaxCycles;
+    uint64_t Buckets[HookStats_BucketCount];
+} CpuHookCounters;
+
+// Each cpu only ever writes its own row, readers sum all rows without locking
+static CpuHookCounters s_Counters[HookStats_MaxCpus][HookStatsId_Max];
+
+static inline uint32_t GetCounterCpu()
+{
+    uint32_t s_CpuId = PCPU_GET(cpuid);
+    return s_CpuId < HookStats_MaxCpus ? s_CpuId : (HookStats_MaxCpus - 1);
+}
+
+static inline uint32_t GetBucket(uint64_t p_Cycles)
+{
+    if (p_Cycles < (1ull << HookStats_FirstBucketShift))
+        return 0;
+
+    uint32_t s_Log2 = 63 - __builtin_clzll(p_Cycles);
+    uint32_t s_Bucket = s_Log2 - HookStats_FirstBucketShift + 1;
+
+    return s_Bucket < HookStats_BucketCount ? s_Bucket : (HookStats_BucketCount - 1);
+}
+#endif
+
+void HookStats::Record(HookStatsId p_Id, uint64_t p_Cycles)
+{
+#if defined(MIRA_HOOK_STATS)
+    auto critical_enter = (void(*)(void))kdlsym(critical_enter);
+    auto critical_exit = (void(*)(void))kdlsym(critical_exit);
+
+    if (p_Id >= HookStatsId_Max)
+        return;
+
+    auto s_Bucket = GetBucket(p_Cycles);
+
+    critical_enter();
+    auto& s_Counter = s_Counters[GetCounterCpu()][p_Id];
+    s_Counter.Calls++;
+    s_Counter.TotalCycles += p_Cycles;
+    if (p_Cycles > s_Counter.MaxCycles)
+        s_Counter.MaxCycles = p_Cycles;
+    s_Counter.Buckets[s_Bucket]++;
+    critical_exit();
+#endif
+}
+
+bool HookStats::GetStats(HookStatsId p_Id, HookStatsSnapshot& p_OutStats)
+{
+    memset(&p_OutStats, 0, sizeof(p_OutStats));
+
+#if defined(MIRA_HOOK_STATS)
+    if (p_Id >= HookStatsId_Max)
+        return false;
+
+    for (auto l_CpuIndex = 0; l_CpuIndex < HookStats_MaxCpus; ++l_CpuIndex)
+    {
+        auto& l_Counter = s_Counters[l_CpuIndex][p_Id];
+        p_OutStats.Calls += l_Counter.Calls;
+        p_OutStats.TotalCycles += l_Counter.TotalCycles;
+        p_OutStats.CpuCalls[l_CpuIndex] = l_Counter.Calls;
+
+        if (l_Counter.MaxCycles > p_OutStats.MaxCycles)
+            p_OutStats.MaxCycles = l_Counter.MaxCycles;
+
+        for (auto l_BucketIndex = 0; l_BucketIndex < HookStats_BucketCount; ++l_BucketIndex)
+            p_OutStats.Buckets[l_BucketIndex] += l_Counter.Buckets[l_BucketIndex];
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* HookStats::GetName(HookStatsId p_Id)
+{
+    if (p_Id >= HookStatsId_Max)
+        return "unknown";
+
+    return s_HookNames[p_Id];
+}
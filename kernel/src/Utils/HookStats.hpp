@@ -0,0 +1,115 @@
+#pragma once
+#include <Utils/Types.hpp>
+
+namespace Mira
+{
+    namespace Utils
+    {
+        /*
+            Instrumented hooks, these are reported over rpc so only append to the end of this list
+        */
+        enum HookStatsId : uint16_t
+        {
+            HookStatsId_TrapFatal,
+            HookStatsId_SceSblAuthMgrVerifyHeader,
+            HookStatsId_SceSblAuthMgrIsLoadable2,
+            HookStatsId_SceSblAuthMgrSmLoadSelfSegment,
+            HookStatsId_SceSblAuthMgrSmLoadSelfBlock,
+            HookStatsId_NpdrmDecryptIsolatedRif,
+            HookStatsId_NpdrmDecryptRifNew,
+            HookStatsId_SceSblPfsSetKeys,
+            HookStatsId_SceSblDriverSendMsg,
+            HookStatsId_SceSblKeymgrInvalidateKey,
+            HookStatsId_DynlibDlsym,
+            HookStatsId_Max
+        };
+
+        enum
+        {
+            // Must be at least the PS4 core count, calls on cpus past this are accounted to the last slot
+            HookStats_MaxCpus = 8,
+
+            // Power of two cycle buckets, the first one holds everything under 2^HookStats_FirstBucketShift
+            // cycles and the last one everything from 2^(HookStats_FirstBucketShift + 14) up
+            HookStats_BucketCount = 16,
+            HookStats_FirstBucketShift = 7,
+        };
+
+        /*
+            Snapshot of a single hook
+        */
+        typedef struct _HookStatsSnapshot
+        {
+            uint64_t Calls;
+            uint64_t TotalCycles;
+            uint64_t MaxCycles;
+            uint64_t CpuCalls[HookStats_MaxCpus];
+            uint64_t Buckets[HookStats_BucketCount];
+        } HookStatsSnapshot;
+
+        /*
+            HookStats
+
+            Call counts and rdtsc latency histograms for hook handlers. Counters are per-cpu and only
+            updated inside of a critical section, same as MemoryTracker.
+
+            This only does anything when built with MIRA_HOOK_STATS (make MIRA_HOOK_STATS=1), otherwise
+            MIRA_HOOK_STATS_SCOPE expands to nothing and no counters are allocated.
+        */
+        class HookStats
+        {
+        public:
+            static inline uint64_t ReadTimestamp()
+            {
+                uint32_t s_Low, s_High;
+                __asm__ __volatile__("rdtsc" : "=a"(s_Low), "=d"(s_High));
+
+                return (static_cast<uint64_t>(s_High) << 32) | s_Low;
+            }
+
+            static constexpr bool IsEnabled()
+            {
+#if defined(MIRA_HOOK_STATS)
+                return true;
+#else
+                return false;
+#endif
+            }
+
+            static void Record(HookStatsId p_Id, uint64_t p_Cycles);
+
+            // Sums every cpu's counters for p_Id, returns false if instrumentation is compiled out
+            static bool GetStats(HookStatsId p_Id, HookStatsSnapshot& p_OutStats);
+
+            static const char* GetName(HookStatsId p_Id);
+        };
+
+        /*
+            Times the enclosing scope, use MIRA_HOOK_STATS_SCOPE instead of this directly
+        */
+        class HookStatsScope
+        {
+        private:
+            HookStatsId m_Id;
+            uint64_t m_Start;
+
+        public:
+            explicit HookStatsScope(HookStatsId p_Id) :
+                m_Id(p_Id),
+                m_Start(HookStats::ReadTimestamp())
+            {
+            }
+
+            ~HookStatsScope()
+            {
+                HookStats::Record(m_Id, HookStats::ReadTimestamp() - m_Start);
+            }
+        };
+    }
+}
+
+#if defined(MIRA_HOOK_STATS)
+#define MIRA_HOOK_STATS_SCOPE(id) Mira::Utils::HookStatsScope s_HookStatsScope(id)
+#else
+#define MIRA_HOOK_STATS_SCOPE(id)
+#endif
@@ -0,0 +1,173 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "MemoryTracker.hpp"
+#include <Utils/Kdlsym.hpp>
+#include <Utils/Kernel.hpp>
+
+extern "C"
+{
+    #include <sys/param.h>
+    #include <sys/pcpu.h>
+    #include <sys/malloc.h>
+    #include <machine/atomic.h>
+};
+
+using namespace Mira::Utils;
+
+typedef struct _CpuTagCounters
+{
+    int64_t LiveBytes;
+    int64_t LiveAllocations;
+    uint64_t TotalAllocations;
+    uint64_t TotalFrees;
+} CpuTagCounters;
+
+// Each cpu only ever writes its own row, readers sum all rows without locking
+static CpuTagCounters s_Counters[MemoryTracker_MaxCpus][MemoryTag_Max];
+static volatile u_long s_HighWater[MemoryTag_Max];
+
+static const char* s_TagNames[MemoryTag_Max] =
+{
+    "Default",
+    "Framework",
+    "Messaging",
+    "Driver",
+    "Hooks",
+    "Pools",
+    "SelfDecrypt",
+    "FileManager",
+    "Debugger",
+    "Substitute",
+    "FakeSelf",
+    "FakePkg",
+    "Plugins",
+};
+
+static inline uint32_t GetCounterCpu()
+{
+    uint32_t s_CpuId = PCPU_GET(cpuid);
+    return s_CpuId < MemoryTracker_MaxCpus ? s_CpuId : (MemoryTracker_MaxCpus - 1);
+}
+
+void* MemoryTracker::Allocate(uint64_t p_Size, MemoryTag p_Tag)
+{
+    auto malloc = (void*(*)(unsigned long size, struct malloc_type* type, int flags))kdlsym(malloc);
+    auto M_TEMP = (struct malloc_type*)kdlsym(M_TEMP);
+    auto critical_enter = (void(*)(void))kdlsym(critical_enter);
+    auto critical_exit = (void(*)(void))kdlsym(critical_exit);
+
+    if (p_Tag >= MemoryTag_Max)
+        p_Tag = MemoryTag_Default;
+
+    auto s_Header = static_cast<AllocationHeader*>(malloc(sizeof(AllocationHeader) + p_Size, M_TEMP, M_ZERO | M_NOWAIT));
+    if (s_Header == nullptr)
+        return nullptr;
+
+    s_Header->Magic = MemoryTracker_Magic;
+    s_Header->Tag = p_Tag;
+    s_Header->Size = p_Size;
+
+    critical_enter();
+    auto& s_Counter = s_Counters[GetCounterCpu()][p_Tag];
+    s_Counter.LiveBytes += p_Size;
+    s_Counter.LiveAllocations++;
+    auto s_TotalAllocations = ++s_Counter.TotalAllocations;
+    critical_exit();
+
+    if ((s_TotalAllocations % MemoryTracker_HighWaterInterval) == 0)
+        UpdateHighWater(p_Tag);
+
+    return s_Header + 1;
+}
+
+void MemoryTracker::Free(void* p_Pointer)
+{
+    auto free = (void(*)(void* addr, struct malloc_type* type))kdlsym(free);
+    auto M_TEMP = (struct malloc_type*)kdlsym(M_TEMP);
+    auto critical_enter = (void(*)(void))kdlsym(critical_enter);
+    auto critical_exit = (void(*)(void))kdlsym(critical_exit);
+
+    if (p_Pointer == nullptr)
+        return;
+
+    // Our pointers are never page aligned because of the header, this also keeps us from
+    // reading off of the front of a page that the kernel handed out directly
+    if ((reinterpret_cast<uint64_t>(p_Pointer) & PAGE_MASK) == 0)
+    {
+        free(p_Pointer, M_TEMP);
+        return;
+    }
+
+    auto s_Header = static_cast<AllocationHeader*>(p_Pointer) - 1;
+    if (s_Header->Magic != MemoryTracker_Magic || s_Header->Tag >= MemoryTag_Max)
+    {
+        free(p_Pointer, M_TEMP);
+        return;
+    }
+
+    auto s_Tag = s_Header->Tag;
+    auto s_Size = s_Header->Size;
+
+    // Poison the magic so a double free does not get accounted twice
+    s_Header->Magic = 0;
+
+    critical_enter();
+    auto& s_Counter = s_Counters[GetCounterCpu()][s_Tag];
+    s_Counter.LiveBytes -= s_Size;
+    s_Counter.LiveAllocations--;
+    s_Counter.TotalFrees++;
+    critical_exit();
+
+    free(s_Header, M_TEMP);
+}
+
+void MemoryTracker::UpdateHighWater(MemoryTag p_Tag)
+{
+    int64_t s_LiveBytes = 0;
+    for (auto l_CpuIndex = 0; l_CpuIndex < MemoryTracker_MaxCpus; ++l_CpuIndex)
+        s_LiveBytes += s_Counters[l_CpuIndex][p_Tag].LiveBytes;
+
+    if (s_LiveBytes <= 0)
+        return;
+
+    for (;;)
+    {
+        auto l_HighWater = s_HighWater[p_Tag];
+        if (static_cast<u_long>(s_LiveBytes) <= l_HighWater)
+            break;
+
+        if (atomic_cmpset_long(&s_HighWater[p_Tag], l_HighWater, s_LiveBytes))
+            break;
+    }
+}
+
+bool MemoryTracker::GetStats(MemoryTag p_Tag, MemoryTagStats& p_OutStats)
+{
+    if (p_Tag >= MemoryTag_Max)
+        return false;
+
+    UpdateHighWater(p_Tag);
+
+    memset(&p_OutStats, 0, sizeof(p_OutStats));
+    for (auto l_CpuIndex = 0; l_CpuIndex < MemoryTracker_MaxCpus; ++l_CpuIndex)
+    {
+        auto& l_Counter = s_Counters[l_CpuIndex][p_Tag];
+        p_OutStats.LiveBytes += l_Counter.LiveBytes;
+        p_OutStats.LiveAllocations += l_Counter.LiveAllocations;
+        p_OutStats.TotalAllocations += l_Counter.TotalAllocations;
+        p_OutStats.TotalFrees += l_Counter.TotalFrees;
+    }
+
+    p_OutStats.HighWaterBytes = s_HighWater[p_Tag];
+
+    return true;
+}
+
+const char* MemoryTracker::GetTagName(MemoryTag p_Tag)
+{
+    if (p_Tag >= MemoryTag_Max)
+        return "Unknown";
+
+    return s_TagNames[p_Tag];
+}
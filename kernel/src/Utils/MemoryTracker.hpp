@@ -0,0 +1,92 @@
+#pragma once
+#include <Utils/Types.hpp>
+
+namespace Mira
+{
+    namespace Utils
+    {
+        /*
+            Subsystem tags for kernel allocations, these are reported over rpc so
+            only append to the end of this list
+        */
+        enum MemoryTag : uint16_t
+        {
+            MemoryTag_Default,
+            MemoryTag_Framework,
+            MemoryTag_Messaging,
+            MemoryTag_Driver,
+            MemoryTag_Hooks,
+            MemoryTag_Pools,
+            MemoryTag_SelfDecrypt,
+            MemoryTag_FileManager,
+            MemoryTag_Debugger,
+            MemoryTag_Substitute,
+            MemoryTag_FakeSelf,
+            MemoryTag_FakePkg,
+            MemoryTag_Plugins,
+            MemoryTag_Max
+        };
+
+        enum
+        {
+            // Must be at least the PS4 core count, allocations on cpus past this are accounted to the last slot
+            MemoryTracker_MaxCpus = 8,
+
+            // How many allocations a cpu does for a tag before it refreshes the high-water mark
+            MemoryTracker_HighWaterInterval = 64,
+
+            // "MIRA", used to tell our allocations apart from kernel allocations in delete
+            MemoryTracker_Magic = 0x4D495241,
+        };
+
+        /*
+            Snapshot of a single tag, summed across all cpus
+        */
+        typedef struct _MemoryTagStats
+        {
+            int64_t LiveBytes;
+            int64_t LiveAllocations;
+            uint64_t TotalAllocations;
+            uint64_t TotalFrees;
+            uint64_t HighWaterBytes;
+        } MemoryTagStats;
+
+        /*
+            MemoryTracker
+
+            Every tracked allocation gets a small header in front of it which stores the tag and the size
+            so free can account it back to the right subsystem. Counters are per-cpu and only updated
+            inside of a critical section so there is no atomic or lock on the allocation path.
+
+            The high-water mark is sampled every MemoryTracker_HighWaterInterval allocations and on every
+            snapshot, so it can lag the true peak slightly.
+        */
+        class MemoryTracker
+        {
+        public:
+            typedef struct _AllocationHeader
+            {
+                uint32_t Magic;
+                uint16_t Tag;
+                uint16_t Reserved;
+                uint64_t Size;
+            } AllocationHeader;
+
+            static_assert(sizeof(AllocationHeader) == 0x10, "allocation header must keep 16 byte alignment");
+
+            // Returns zeroed memory accounted to p_Tag, or nullptr
+            static void* Allocate(uint64_t p_Size, MemoryTag p_Tag);
+
+            // Frees memory from Allocate, pointers that are not ours are handed back to the kernel as M_TEMP
+            static void Free(void* p_Pointer);
+
+            // Sums every cpu's counters for p_Tag
+            static bool GetStats(MemoryTag p_Tag, MemoryTagStats& p_OutStats);
+
+            static const char* GetTagName(MemoryTag p_Tag);
+
+        private:
+            static void UpdateHighWater(MemoryTag p_Tag);
+        };
+    }
+}
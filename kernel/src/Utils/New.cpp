@@ -15,6 +15,11 @@ extern "C"
 };
 
 void * operator new(unsigned long int p_Size)
+{
+	return ::operator new(p_Size, Mira::Utils::MemoryTag_Default);
+}
+
+void * operator new(unsigned long int p_Size, Mira::Utils::MemoryTag p_Tag)
 {
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wnew-returns-null"
@@ -22,9 +27,6 @@ void * operator new(unsigned long int p_Size)
 		return nullptr;
 #pragma clang diagnostic pop
 	
-	auto malloc = (void*(*)(unsigned long size, struct malloc_type* type, int flags))kdlsym(malloc);
-	auto M_TEMP = (struct malloc_type*)kdlsym(M_TEMP);
-
 	if (p_Size >= 0x10000000)
 	{
 		auto printf = (void(*)(const char *format, ...))kdlsym(printf);
@@ -34,7 +36,7 @@ void * operator new(unsigned long int p_Size)
 			__asm__("nop");
 	}
 
-	return malloc(p_Size, M_TEMP, M_ZERO | M_NOWAIT);
+	return Mira::Utils::MemoryTracker::Allocate(p_Size, p_Tag);
 }
 
 // placement new
@@ -49,19 +51,29 @@ void * operator new[] (unsigned long int p_Size)
 	return ::operator new(p_Size);
 }
 
+void * operator new[] (unsigned long int p_Size, Mira::Utils::MemoryTag p_Tag)
+{
+	return ::operator new(p_Size, p_Tag);
+}
+
 // Delete
 void operator delete(void* p_Pointer) noexcept
 {
-	if (p_Pointer == nullptr)
-		return;
-	
-	auto free = (void(*)(void* addr, struct malloc_type* type))kdlsym(free);
-	auto M_TEMP = (struct malloc_type*)kdlsym(M_TEMP);
-
-	free(p_Pointer, M_TEMP);
+	Mira::Utils::MemoryTracker::Free(p_Pointer);
 }
 
 void operator delete[](void* p_Pointer) noexcept
 {
 	::operator delete(p_Pointer);
 }
+
+// Sized delete, the header already knows the size
+void operator delete(void* p_Pointer, unsigned long int p_Size) noexcept
+{
+	::operator delete(p_Pointer);
+}
+
+void operator delete[](void* p_Pointer, unsigned long int p_Size) noexcept
+{
+	::operator delete(p_Pointer);
+}
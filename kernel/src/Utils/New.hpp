@@ -1,5 +1,5 @@
 #pragma once
-
+#include <Utils/MemoryTracker.hpp>
 
 // new
 void * operator new(unsigned long int cbSize);
@@ -7,6 +7,12 @@ void * operator new(unsigned long int cbSize);
 // new[]
 void* operator new[](unsigned long int cbSize);
 
+// tagged new, accounts the allocation to a subsystem
+void* operator new(unsigned long int cbSize, Mira::Utils::MemoryTag tag);
+
+// tagged new[]
+void* operator new[](unsigned long int cbSize, Mira::Utils::MemoryTag tag);
+
 // placement new
 void * operator new(unsigned long int cbSize, void * pv);
 
@@ -15,3 +21,9 @@ void operator delete(void* p) noexcept;
 
 // delete[]
 void operator delete[] (void* p) noexcept;
+
+// sized delete, emitted by compilers that default to -fsized-deallocation
+void operator delete(void* p, unsigned long int cbSize) noexcept;
+
+// sized delete[]
+void operator delete[] (void* p, unsigned long int cbSize) noexcept;
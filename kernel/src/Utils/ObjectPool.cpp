@@ -0,0 +1,180 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "ObjectPool.hpp"
+#include <Utils/Kdlsym.hpp>
+#include <Utils/Kernel.hpp>
+#include <Utils/Logger.hpp>
+
+extern "C"
+{
+    #include <sys/pcpu.h>
+    #include <machine/atomic.h>
+};
+
+using namespace Mira::Utils;
+
+void ObjectPool::EnsureInitialized()
+{
+    if (m_State == State_Ready)
+        return;
+
+    // First one in initializes the mutex, everyone else waits for it to finish
+    if (atomic_cmpset_int(&m_State, State_Uninitialized, State_Initializing))
+    {
+        auto mtx_init = (void(*)(struct mtx *m, const char *name, const char *type, int opts))kdlsym(mtx_init);
+        mtx_init(&m_Mutex, m_Name, nullptr, MTX_DEF);
+
+        atomic_store_rel_int(&m_State, State_Ready);
+        return;
+    }
+
+    while (atomic_load_acq_int(&m_State) != State_Ready)
+        __asm__ __volatile__("pause");
+}
+
+bool ObjectPool::Grow()
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    // The slab header takes the first object slot so objects stay aligned, the tracker's
+    // header is taken off the top so the whole thing still fits in one malloc bucket
+    uint32_t s_ObjectCount = (ObjectPool_SlabSize - sizeof(MemoryTracker::AllocationHeader)) / m_ObjectSize;
+    if (s_ObjectCount < 2)
+        s_ObjectCount = 2;
+
+    auto s_SlabSize = s_ObjectCount * m_ObjectSize;
+    auto s_SlabData = static_cast<uint8_t*>(MemoryTracker::Allocate(s_SlabSize, m_Tag));
+    if (s_SlabData == nullptr)
+    {
+        WriteLog(LL_Error, "could not allocate slab (%x) for pool (%s).", s_SlabSize, m_Name);
+        return false;
+    }
+
+    // Link all of the objects together before taking the lock
+    FreeObject* s_First = nullptr;
+    FreeObject* s_Last = nullptr;
+    for (uint32_t i = 1; i < s_ObjectCount; ++i)
+    {
+        auto l_Object = reinterpret_cast<FreeObject*>(s_SlabData + (i * m_ObjectSize));
+        l_Object->Next = nullptr;
+
+        if (s_Last == nullptr)
+            s_First = l_Object;
+        else
+            s_Last->Next = l_Object;
+
+        s_Last = l_Object;
+    }
+
+    auto s_Slab = reinterpret_cast<Slab*>(s_SlabData);
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    s_Slab->Next = m_Slabs;
+    m_Slabs = s_Slab;
+
+    s_Last->Next = m_FreeList;
+    m_FreeList = s_First;
+    _mtx_unlock_flags(&m_Mutex, 0);
+
+    return true;
+}
+
+void* ObjectPool::Allocate()
+{
+    auto critical_enter = (void(*)(void))kdlsym(critical_enter);
+    auto critical_exit = (void(*)(void))kdlsym(critical_exit);
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    EnsureInitialized();
+
+    FreeObject* s_Object = nullptr;
+
+    // Fast path, take from this cpu's cache without any locking
+    critical_enter();
+    auto s_CpuId = PCPU_GET(cpuid);
+    if (s_CpuId < ObjectPool_MaxCpus)
+    {
+        auto& s_Cache = m_Caches[s_CpuId];
+        if (s_Cache.Count > 0)
+            s_Object = s_Cache.Objects[--s_Cache.Count];
+    }
+    critical_exit();
+
+    // Slow path, take from the shared list and grow if needed
+    while (s_Object == nullptr)
+    {
+        _mtx_lock_flags(&m_Mutex, 0);
+        s_Object = m_FreeList;
+        if (s_Object != nullptr)
+            m_FreeList = s_Object->Next;
+        _mtx_unlock_flags(&m_Mutex, 0);
+
+        if (s_Object == nullptr && !Grow())
+            return nullptr;
+    }
+
+    // Keep the same semantics as operator new (M_ZERO)
+    memset(s_Object, 0, m_ObjectSize);
+
+    return s_Object;
+}
+
+void ObjectPool::Free(void* p_Object)
+{
+    auto critical_enter = (void(*)(void))kdlsym(critical_enter);
+    auto critical_exit = (void(*)(void))kdlsym(critical_exit);
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    if (p_Object == nullptr)
+        return;
+
+    auto s_Object = static_cast<FreeObject*>(p_Object);
+
+    critical_enter();
+    auto s_CpuId = PCPU_GET(cpuid);
+    if (s_CpuId < ObjectPool_MaxCpus)
+    {
+        auto& s_Cache = m_Caches[s_CpuId];
+        if (s_Cache.Count < ObjectPool_CacheSize)
+        {
+            s_Cache.Objects[s_Cache.Count++] = s_Object;
+            s_Object = nullptr;
+        }
+    }
+    critical_exit();
+
+    if (s_Object == nullptr)
+        return;
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    s_Object->Next = m_FreeList;
+    m_FreeList = s_Object;
+    _mtx_unlock_flags(&m_Mutex, 0);
+}
+
+void ObjectPool::Destroy()
+{
+    auto _mtx_lock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_lock_flags);
+    auto _mtx_unlock_flags = (void(*)(struct mtx *mutex, int flags))kdlsym(_mtx_unlock_flags);
+
+    if (m_State != State_Ready)
+        return;
+
+    _mtx_lock_flags(&m_Mutex, 0);
+    auto s_Slab = m_Slabs;
+    m_Slabs = nullptr;
+    m_FreeList = nullptr;
+    memset(m_Caches, 0, sizeof(m_Caches));
+    _mtx_unlock_flags(&m_Mutex, 0);
+
+    while (s_Slab != nullptr)
+    {
+        auto l_Next = s_Slab->Next;
+        MemoryTracker::Free(s_Slab);
+        s_Slab = l_Next;
+    }
+}
@@ -0,0 +1,148 @@
+#pragma once
+#include <Utils/Types.hpp>
+#include <Utils/MemoryTracker.hpp>
+
+extern "C"
+{
+    #include <sys/param.h>
+    #include <sys/lock.h>
+    #include <sys/mutex.h>
+}
+
+namespace Mira
+{
+    namespace Utils
+    {
+        enum
+        {
+            // Amount of memory that is requested from malloc every time a pool runs dry
+            ObjectPool_SlabSize = 0x4000,
+
+            // The PS4 has 8 cores, cpus past this will use the shared free list
+            ObjectPool_MaxCpus = 8,
+
+            // Number of free objects each cpu keeps around before handing them back to the shared list
+            ObjectPool_CacheSize = 16,
+        };
+
+        /*
+            ObjectPool
+
+            Fixed-size object allocator that carves objects out of larger slabs instead of sending
+            every allocation to malloc(M_TEMP). Freed objects are kept on a per-cpu cache first, then
+            on a shared free list, slabs are only returned to the kernel on Destroy().
+
+            This must be constant initializable (no global constructors get ran in Mira), so the
+            mutex is set up lazily on first use.
+        */
+        class ObjectPool
+        {
+        private:
+            struct FreeObject
+            {
+                FreeObject* Next;
+            };
+
+            struct Slab
+            {
+                Slab* Next;
+            };
+
+            struct CpuCache
+            {
+                FreeObject* Objects[ObjectPool_CacheSize];
+                uint32_t Count;
+            };
+
+            enum
+            {
+                State_Uninitialized,
+                State_Initializing,
+                State_Ready
+            };
+
+            const char* m_Name;
+            uint32_t m_ObjectSize;
+            MemoryTag m_Tag;
+
+            volatile uint32_t m_State;
+            struct mtx m_Mutex;
+
+            // Protected by m_Mutex
+            Slab* m_Slabs;
+            FreeObject* m_FreeList;
+
+            // Only touched by the owning cpu inside of a critical section
+            CpuCache m_Caches[ObjectPool_MaxCpus];
+
+        public:
+            constexpr ObjectPool(const char* p_Name, uint32_t p_ObjectSize, MemoryTag p_Tag = MemoryTag_Pools) :
+                m_Name(p_Name),
+                m_ObjectSize(p_ObjectSize < sizeof(FreeObject) ? sizeof(FreeObject) : ((p_ObjectSize + 0xF) & ~0xF)),
+                m_Tag(p_Tag),
+                m_State(State_Uninitialized),
+                m_Mutex{},
+                m_Slabs(nullptr),
+                m_FreeList(nullptr),
+                m_Caches{}
+            {
+
+            }
+
+            // Returns zeroed memory of GetObjectSize() bytes, or nullptr
+            void* Allocate();
+
+            // Returns an object that was allocated from this pool
+            void Free(void* p_Object);
+
+            // Frees every slab, all objects handed out by this pool are invalid afterwards
+            void Destroy();
+
+            const char* GetName() const { return m_Name; }
+            uint32_t GetObjectSize() const { return m_ObjectSize; }
+            MemoryTag GetTag() const { return m_Tag; }
+
+        private:
+            void EnsureInitialized();
+            bool Grow();
+        };
+
+        /*
+            Per-type pool storage, one instance per T
+        */
+        template <typename T>
+        class TypedObjectPool
+        {
+        public:
+            static ObjectPool s_Pool;
+        };
+
+        template <typename T>
+        ObjectPool TypedObjectPool<T>::s_Pool("MiraPool", sizeof(T));
+    }
+}
+
+/*
+    Opts a class into pooled allocation, place inside of the class definition
+
+    Derived classes that are larger than the pooled class fall back to the global allocator,
+    sized delete is used to route them back to the correct place.
+*/
+#define MIRA_POOLED_OBJECT(p_Type) \
+    static void* operator new(unsigned long p_Size) \
+    { \
+        if (p_Size > Mira::Utils::TypedObjectPool<p_Type>::s_Pool.GetObjectSize()) \
+            return ::operator new(p_Size); \
+        return Mira::Utils::TypedObjectPool<p_Type>::s_Pool.Allocate(); \
+    } \
+    static void operator delete(void* p_Pointer, unsigned long p_Size) \
+    { \
+        if (p_Pointer == nullptr) \
+            return; \
+        if (p_Size > Mira::Utils::TypedObjectPool<p_Type>::s_Pool.GetObjectSize()) \
+        { \
+            ::operator delete(p_Pointer); \
+            return; \
+        } \
+        Mira::Utils::TypedObjectPool<p_Type>::s_Pool.Free(p_Pointer); \
+    }
@@ -1,4 +1,5 @@
 #pragma once
+#include <Utils/Kdlsym.hpp>
 
 extern "C"
 {
@@ -41,7 +42,6 @@ namespace Utils
             
             m_Head = 0;
             m_Tail = 0;
-            m_MaxSize = 0;
             m_Full = false;
 
             mtx_destroy(&m_Mutex);
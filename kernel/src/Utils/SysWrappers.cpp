@@ -464,6 +464,66 @@ ssize_t kread(int fd, void* buf, size_t count)
 	return kread_t(fd, buf, count, curthread);
 }
 
+//
+// 475: sys_pread
+//
+
+ssize_t kpread_internal(int fd, void* buf, size_t count, off_t offset, struct thread* td)
+{
+	auto sv = (struct sysentvec*)kdlsym(self_orbis_sysvec);
+	struct sysent* sysents = sv->sv_table;
+	auto sys_pread = (int(*)(struct thread*, struct pread_args*))sysents[SYS_PREAD].sy_call;
+	if (!sys_pread)
+		return -1;
+
+	int error;
+	struct pread_args uap;
+
+	// clear errors
+	td->td_retval[0] = 0;
+
+	// call syscall
+	uap.fd = fd;
+	uap.buf = buf;
+	uap.nbyte = count;
+	uap.offset = offset;
+
+	error = sys_pread(td, &uap);
+	if (error)
+		return -error;
+
+	// return bytes read
+	return td->td_retval[0];
+}
+
+ssize_t kpread_t(int fd, void* buf, size_t count, off_t offset, struct thread* td)
+{
+	ssize_t ret = -EIO;
+	int retry = 0;
+
+	for (;;)
+	{
+		ret = kpread_internal(fd, buf, count, offset, td);
+		if (ret < 0)
+		{
+			if (ret == -EINTR)
+			{
+				if (retry > MaxInterruptRetries)
+					break;
+					
+				retry++;
+				continue;
+			}
+			
+			return ret;
+		}
+
+		break;
+	}
+
+	return ret;
+}
+
 //
 // 189: sys_fstat
 //
@@ -2520,3 +2580,60 @@ int ksandbox_path_t(char* path, struct thread* td)
 
 	return ret;
 }
+
+//
+// 232: sys_clock_gettime
+//
+int kclock_gettime_internal(clockid_t clock_id, struct timespec* tp, struct thread* td)
+{
+	auto sv = (struct sysentvec*)kdlsym(self_orbis_sysvec);
+	struct sysent* sysents = sv->sv_table;
+	auto sys_clock_gettime = (int(*)(struct thread *, struct clock_gettime_args *))sysents[SYS_CLOCK_GETTIME].sy_call;
+	if (!sys_clock_gettime)
+		return -1;
+
+	int error;
+	struct clock_gettime_args uap;
+
+	// clear errors
+	td->td_retval[0] = 0;
+
+	// call syscall
+	uap.clock_id = clock_id;
+	uap.tp = tp;
+
+	error = sys_clock_gettime(td, &uap);
+	if (error)
+		return -error;
+
+	// success
+	return td->td_retval[0];
+}
+
+int kclock_gettime_t(clockid_t clock_id, struct timespec* tp, struct thread* td)
+{
+	int ret = -EIO;
+	int retry = 0;
+
+	for (;;)
+	{
+		ret = kclock_gettime_internal(clock_id, tp, td);
+		if (ret < 0)
+		{
+			if (ret == -EINTR)
+			{
+				if (retry > MaxInterruptRetries)
+					break;
+					
+				retry++;
+				continue;
+			}
+			
+			return ret;
+		}
+
+		break;
+	}
+
+	return ret;
+}
@@ -10,6 +10,7 @@ struct ucred;
 struct thread;
 struct stat;
 struct rusage;
+struct timespec;
 
 ///////////////////////////
 // Sony specific definition
@@ -92,6 +93,9 @@ extern "C"
     //extern ssize_t kread(int fd, void* buf, size_t count);
     extern ssize_t kread_t(int fd, void* buf, size_t count, struct thread* td);
 
+    // 475
+    extern ssize_t kpread_t(int fd, void* buf, size_t count, off_t offset, struct thread* td);
+
     //extern int ksend(int socket, caddr_t buf, size_t len, int flags);
     extern int ksend_t(int socket, caddr_t buf, size_t len, int flags, struct thread* td);
 
@@ -159,4 +163,6 @@ extern "C"
     extern int klinkat_t(int fd1, const char *path1, int fd2, const char *path2, int flag, struct thread* td);
 
     extern int ksandbox_path_t(char* path, struct thread* td);
+
+    extern int kclock_gettime_t(clockid_t clock_id, struct timespec* tp, struct thread* td);
 };
\ No newline at end of file
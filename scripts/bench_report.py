@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+import argparse
+import json
+import sys
+
+# Compares a MiraBench results file (kernel/host, make bench) against a baseline and exits
+# non-zero when any benchmark got slower than the allowed threshold.
+
+def loadResults(fileName):
+    with open(fileName, "r") as file:
+        data = json.load(file)
+
+    return { entry["name"]: entry["ns_per_op"] for entry in data["benchmarks"] }
+
+def main():
+    parser = argparse.ArgumentParser(description="MiraBench performance regression report")
+    parser.add_argument("baseline", help="baseline results (json)")
+    parser.add_argument("current", help="current results (json)")
+    parser.add_argument("--threshold", type=float, default=0.25, help="allowed slowdown as a fraction of the baseline (default: 0.25)")
+    parser.add_argument("--markdown", help="also write the report as a markdown table to this path")
+    args = parser.parse_args()
+
+    baseline = loadResults(args.baseline)
+    current = loadResults(args.current)
+
+    rows = [ ]
+    regressions = [ ]
+
+    for name in sorted(set(baseline) | set(current)):
+        if name not in current:
+            rows.append((name, baseline[name], None, None, "missing"))
+            continue
+
+        if name not in baseline:
+            rows.append((name, None, current[name], None, "new"))
+            continue
+
+        before = baseline[name]
+        after = current[name]
+        change = (after - before) / before if before > 0 else 0.0
+
+        status = "ok"
+        if change > args.threshold:
+            status = "REGRESSION"
+            regressions.append(name)
+        elif change < -args.threshold:
+            status = "improved"
+
+        rows.append((name, before, after, change, status))
+
+    def formatValue(value):
+        return "-" if value is None else "%.2f" % value
+
+    def formatChange(change):
+        return "-" if change is None else "%+.1f%%" % (change * 100.0)
+
+    print("%-48s %14s %14s %9s  %s" % ("benchmark", "baseline ns", "current ns", "change", "status"))
+    for name, before, after, change, status in rows:
+        print("%-48s %14s %14s %9s  %s" % (name, formatValue(before), formatValue(after), formatChange(change), status))
+
+    if args.markdown:
+        with open(args.markdown, "w") as file:
+            file.write("| benchmark | baseline ns/op | current ns/op | change | status |\n")
+            file.write("|---|---:|---:|---:|---|\n")
+            for name, before, after, change, status in rows:
+                file.write("| %s | %s | %s | %s | %s |\n" % (name, formatValue(before), formatValue(after), formatChange(change), status))
+
+    if len(regressions) > 0:
+        print("\n%d benchmark(s) regressed by more than %.0f%%: %s" % (len(regressions), args.threshold * 100.0, ", ".join(regressions)))
+        return 1
+
+    print("\nno regressions above %.0f%%" % (args.threshold * 100.0))
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -101,6 +101,8 @@ if __name__== "__main__":
                 destinationPath = os.path.join(miraDirectory, ("src/Plugins/Debugger/" + file))
             elif "filemanager" in file:
                 destinationPath = os.path.join(miraDirectory, ("src/Plugins/FileManager/" + file))
+            elif "system" in file:
+                destinationPath = os.path.join(miraDirectory, ("src/Plugins/SystemManager/" + file))
             elif "rpc" in file:
                 destinationPath = os.path.join(miraDirectory, ("src/Messaging/Rpc/" + file))
 
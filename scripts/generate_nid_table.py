@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+# Generates the name -> NID table that Substitute looks names up in before falling back to
+# the kernel's name_to_nids (see kernel/src/Plugins/Substitute/NidDatabase.hpp)
+import argparse
+import base64
+import hashlib
+import os
+import struct
+import sys
+
+# Appended to every symbol name before hashing
+NID_SUFFIX = bytes.fromhex("518D64A635DED8C1E6B039B1C3E55230")
+
+# NIDs are 11 characters, the table stores them null terminated
+NID_LENGTH = 11
+
+def nameToNid(name):
+    digest = hashlib.sha1(name.encode("ascii") + NID_SUFFIX).digest()
+
+    # The first 8 bytes of the digest as a little endian integer, encoded big endian
+    value = struct.unpack("<Q", digest[:8])[0]
+    nid = base64.b64encode(struct.pack(">Q", value), b"+-").rstrip(b"=").decode("ascii")
+
+    if len(nid) != NID_LENGTH:
+        raise ValueError("unexpected nid length for " + name)
+
+    return nid
+
+def readSymbols(fileName):
+    symbols = set()
+
+    with open(fileName, "r") as file:
+        for lineNumber, line in enumerate(file, 1):
+            line = line.strip()
+            if len(line) == 0 or line.startswith("#"):
+                continue
+
+            if any(c.isspace() or c == '"' or c == "\\" or ord(c) > 0x7E for c in line):
+                print("error: invalid symbol name on line " + str(lineNumber) + ": " + line)
+                sys.exit(1)
+
+            symbols.add(line)
+
+    # Sorted by their bytes, this is the order NidDatabase binary searches in
+    return sorted(symbols, key=lambda symbol: symbol.encode("ascii"))
+
+def formatTable(symbols, inputName):
+    names = [ ]
+    entries = [ ]
+    offset = 0
+
+    for symbol in symbols:
+        names.append('    "' + symbol + '\\0"\n')
+        entries.append('    { 0x%05X, "%s" }, // %s\n' % (offset, nameToNid(symbol), symbol))
+        offset += len(symbol) + 1
+
+    return "".join(
+        [ "// Generated by scripts/generate_nid_table.py from " + inputName + ", do not edit\n",
+          "#pragma once\n\n",
+          "static const char s_NidTableNames[] =\n" ] +
+        names +
+        [ ";\n\n",
+          "static const NidDatabase::TableEntry s_NidTableEntries[] =\n",
+          "{\n" ] +
+        entries +
+        [ "};\n" ])
+
+def writeTable(fileName, symbols, inputName):
+    with open(fileName, "w", newline="\n") as file:
+        file.write(formatTable(symbols, inputName))
+
+# Returns True if the committed table is what the symbol list generates
+def checkTable(fileName, symbols, inputName):
+    try:
+        with open(fileName, "r", newline="") as file:
+            current = file.read()
+    except OSError as error:
+        print("error: could not read " + fileName + ": " + str(error))
+        return False
+
+    if current != formatTable(symbols, inputName):
+        print("error: " + fileName + " is out of date, run scripts/generate_nid_table.py and commit it")
+        return False
+
+    print(fileName + " is up to date (" + str(len(symbols)) + " symbols)")
+    return True
+
+if __name__ == "__main__":
+    scriptDirectory = os.path.dirname(os.path.abspath(__file__))
+    substituteDirectory = os.path.join(scriptDirectory, "..", "kernel", "src", "Plugins", "Substitute")
+
+    parser = argparse.ArgumentParser(description="Generate the Substitute name to NID table")
+    parser.add_argument("--input", default=os.path.join(substituteDirectory, "NidSymbols.txt"), help="symbol list, one name per line")
+    parser.add_argument("--output", default=os.path.join(substituteDirectory, "NidDatabaseTable.hpp"), help="generated header")
+    parser.add_argument("--check", nargs="*", metavar="NAME", help="print the NID of each name, or without names check the table is up to date, and exit")
+    args = parser.parse_args()
+
+    if args.check is not None and len(args.check) != 0:
+        for name in args.check:
+            print(nameToNid(name) + " " + name)
+        sys.exit(0)
+
+    symbols = readSymbols(args.input)
+
+    if args.check is not None:
+        sys.exit(0 if checkTable(args.output, symbols, os.path.basename(args.input)) else 1)
+
+    writeTable(args.output, symbols, os.path.basename(args.input))
+
+    print("wrote " + str(len(symbols)) + " symbols to " + args.output)